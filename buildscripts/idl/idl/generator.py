@@ -157,22 +157,25 @@ class _SlowFieldUsageChecker(_FieldUsageCheckerBase):
     Check for duplicate fields, and required fields as needed.
 
     Detects duplicate extra fields.
-    Generates code with a C++ std::set to maintain a set of fields seen while parsing a BSON
-    document. The std::set has O(N lg N) lookup, and allocates memory in the heap.
+    Generates code with a C++ std::vector to maintain the list of fields seen while parsing a
+    BSON document. Command documents have few fields, so a linear scan of a vector beats the
+    allocating std::set lookup this code used to emit.
     """
 
     def __init__(self, indented_writer):
         # type: (writer.IndentedTextWriter) -> None
         super(_SlowFieldUsageChecker, self).__init__(indented_writer)
 
-        self._writer.write_line('std::set<StringData> usedFields;')
+        self._writer.write_line('std::vector<StringData> usedFields;')
+        self._writer.write_line('usedFields.reserve(8);')
 
     def add_store(self, field_name):
         # type: (unicode) -> None
-        self._writer.write_line('auto push_result = usedFields.insert(%s);' % (field_name))
-        with writer.IndentedScopedBlock(self._writer,
-                                        'if (MONGO_unlikely(push_result.second == false)) {', '}'):
+        pred = ('if (MONGO_unlikely(std::find(usedFields.begin(), usedFields.end(), %s) != ' +
+                'usedFields.end())) {') % (field_name)
+        with writer.IndentedScopedBlock(self._writer, pred, '}'):
             self._writer.write_line('ctxt.throwDuplicateField(%s);' % (field_name))
+        self._writer.write_line('usedFields.push_back(%s);' % (field_name))
 
     def add(self, field, bson_element_variable):
         # type: (ast.Field, unicode) -> None
@@ -183,7 +186,8 @@ class _SlowFieldUsageChecker(_FieldUsageCheckerBase):
         # type: () -> None
         for field in self._fields:
             if (not field.optional) and (not field.ignore) and (not field.chained):
-                pred = 'if (MONGO_unlikely(usedFields.find(%s) == usedFields.end())) {' % \
+                pred = ('if (MONGO_unlikely(std::find(usedFields.begin(), usedFields.end(), ' +
+                        '%s) == usedFields.end())) {') % \
                     (_get_field_constant_name(field))
                 with writer.IndentedScopedBlock(self._writer, pred, '}'):
                     if field.default:
@@ -1542,8 +1546,9 @@ class _CppSourceFileWriter(_CppFileWriterBase):
 
         # Generate system includes second
         header_list = [
+            'algorithm',
             'bitset',
-            'set',
+            'vector',
         ]
 
         for include in header_list:
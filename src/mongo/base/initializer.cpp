@@ -49,9 +49,32 @@ Status Initializer::executeInitializers(const InitializerContext::ArgumentVector
     if (Status::OK() != status)
         return status;
 
+    // Retain the inputs so that deferred initializers can run with the same context later.
+    _lastArgs = args;
+    _lastEnv = env;
+
+    const auto deferred = _graph.computeDeferrableNodes(sortedNodes);
+    return _executeInitializers(args, env, deferred.empty() ? nullptr : &deferred);
+}
+
+Status Initializer::executeLazyInitializers() {
+    return _executeInitializers(_lastArgs, _lastEnv, nullptr);
+}
+
+Status Initializer::_executeInitializers(const InitializerContext::ArgumentVector& args,
+                                         const InitializerContext::EnvironmentMap& env,
+                                         const stdx::unordered_set<std::string>* deferred) {
+    std::vector<std::string> sortedNodes;
+    Status status = _graph.topSort(&sortedNodes);
+    if (Status::OK() != status)
+        return status;
+
     InitializerContext context(args, env);
 
     for (size_t i = 0; i < sortedNodes.size(); ++i) {
+        if (deferred && deferred->count(sortedNodes[i]))
+            continue;
+
         InitializerDependencyNode* node = _graph.getInitializerNode(sortedNodes[i]);
 
         // If already initialized then this node is a legacy initializer without re-initialization
@@ -87,9 +110,12 @@ Status Initializer::executeDeinitializers() {
 
     DeinitializerContext context{};
 
-    // Execute deinitialization in reverse order from initialization.
+    // Execute deinitialization in reverse order from initialization. Nodes whose initialization
+    // was deferred and never demanded have nothing to undo.
     for (auto it = sortedNodes.rbegin(), end = sortedNodes.rend(); it != end; ++it) {
         InitializerDependencyNode* node = _graph.getInitializerNode(*it);
+        if (!node->isInitialized())
+            continue;
         auto const& fn = node->getDeinitializerFunction();
         if (fn) {
             try {
@@ -131,6 +157,10 @@ Status runGlobalInitializers(int argc, const char* const* argv, const char* cons
     return runGlobalInitializers(args, env);
 }
 
+Status runGlobalLazyInitializers() {
+    return getGlobalInitializer().executeLazyInitializers();
+}
+
 Status runGlobalDeinitializers() {
     return getGlobalInitializer().executeDeinitializers();
 }
@@ -62,16 +62,41 @@ public:
     /**
      * Execute the initializer process, using the given argv and environment data as input.
      *
+     * Nodes marked lazy in the dependency graph (see
+     * InitializerDependencyGraph::markNodeLazy()) are skipped, unless an eager node depends on
+     * them; run them later with executeLazyInitializers().
+     *
      * Returns Status::OK on success.  All other returns constitute initialization failures,
      * and the thing being initialized should be considered dead in the water.
      */
     Status executeInitializers(const InitializerContext::ArgumentVector& args,
                                const InitializerContext::EnvironmentMap& env);
 
+    /**
+     * Execute any initializers whose execution was deferred by the last call to
+     * executeInitializers(), reusing its argv and environment data.  Does nothing if there are
+     * no deferred initializers.  The caller is responsible for ensuring this does not run
+     * concurrently with other initialization.
+     */
+    Status executeLazyInitializers();
+
     Status executeDeinitializers();
 
 private:
+    /**
+     * Shared implementation of the initialization pass.  Skips the nodes named in 'deferred', if
+     * any.
+     */
+    Status _executeInitializers(const InitializerContext::ArgumentVector& args,
+                                const InitializerContext::EnvironmentMap& env,
+                                const stdx::unordered_set<std::string>* deferred);
+
     InitializerDependencyGraph _graph;
+
+    // Inputs of the last executeInitializers() call, retained so that deferred initializers can
+    // be executed with the same context.
+    InitializerContext::ArgumentVector _lastArgs;
+    InitializerContext::EnvironmentMap _lastEnv;
 };
 
 /**
@@ -88,6 +113,12 @@ Status runGlobalInitializers(const InitializerContext::ArgumentVector& args,
 
 Status runGlobalInitializers(int argc, const char* const* argv, const char* const* envp);
 
+/**
+ * Run any global initializers whose execution was deferred because they are marked lazy in the
+ * dependency graph.  Reuses the arguments from the last runGlobalInitializers() call.
+ */
+Status runGlobalLazyInitializers();
+
 /**
  * Same as runGlobalInitializers(), except prints a brief message to std::cerr
  * and terminates the process on failure.
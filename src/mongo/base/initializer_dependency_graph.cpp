@@ -71,6 +71,49 @@ InitializerDependencyNode* InitializerDependencyGraph::getInitializerNode(const
     return &iter->second;
 }
 
+Status InitializerDependencyGraph::markNodeLazy(const std::string& name) {
+    NodeMap::iterator iter = _nodes.find(name);
+    if (iter == _nodes.end())
+        return Status(ErrorCodes::NoSuchKey, name);
+
+    iter->second.lazy = true;
+    return Status::OK();
+}
+
+stdx::unordered_set<std::string> InitializerDependencyGraph::computeDeferrableNodes(
+    const std::vector<std::string>& sortedNames) const {
+    // Build the reverse adjacency so each node's dependents can be consulted.
+    stdx::unordered_map<std::string, std::vector<std::string>> dependents;
+    for (const auto& node : _nodes) {
+        for (const auto& prerequisite : node.second.prerequisites) {
+            dependents[prerequisite].push_back(node.first);
+        }
+    }
+
+    // Walk the topological order in reverse, so each node's dependents are classified before the
+    // node itself.
+    stdx::unordered_set<std::string> deferrable;
+    for (auto it = sortedNames.rbegin(), end = sortedNames.rend(); it != end; ++it) {
+        const auto node = _nodes.find(*it);
+        if (node == _nodes.end() || !node->second.lazy)
+            continue;
+
+        bool allDependentsDeferred = true;
+        const auto dep = dependents.find(*it);
+        if (dep != dependents.end()) {
+            for (const auto& dependent : dep->second) {
+                if (!deferrable.count(dependent)) {
+                    allDependentsDeferred = false;
+                    break;
+                }
+            }
+        }
+        if (allDependentsDeferred)
+            deferrable.insert(*it);
+    }
+    return deferrable;
+}
+
 Status InitializerDependencyGraph::topSort(std::vector<std::string>* sortedNames) const {
     /*
      * This top-sort is implemented by performing a depth-first traversal of the dependency
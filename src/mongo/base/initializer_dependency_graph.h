@@ -57,11 +57,16 @@ public:
         return deinitFn;
     }
 
+    bool isLazy() const {
+        return lazy;
+    }
+
 private:
     InitializerFunction initFn;
     DeinitializerFunction deinitFn;
     stdx::unordered_set<std::string> prerequisites;
     bool initialized{false};
+    bool lazy{false};
 };
 
 /**
@@ -111,6 +116,22 @@ public:
      */
     InitializerDependencyNode* getInitializerNode(const std::string& name);
 
+    /**
+     * Marks the node named "name" as lazy, meaning its execution may be deferred past the main
+     * initialization pass.  Returns ErrorCodes::NoSuchKey if no such node has been added, which
+     * callers marking optional subsystems may choose to ignore.
+     */
+    Status markNodeLazy(const std::string& name);
+
+    /**
+     * Given a topological order produced by topSort(), returns the names of the nodes whose
+     * execution may actually be deferred: nodes marked lazy whose dependents, transitively, are
+     * all deferred as well.  A lazy node with an eager dependent must run eagerly so that the
+     * dependent's prerequisites are satisfied.
+     */
+    stdx::unordered_set<std::string> computeDeferrableNodes(
+        const std::vector<std::string>& sortedNames) const;
+
     /**
      * Construct a topological sort of the dependency graph, and store that order into
      * "sortedNames".  Returns Status::OK() on success.
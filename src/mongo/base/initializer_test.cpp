@@ -190,5 +190,61 @@ TEST(InitializerTest, Step5Misimplemented) {
     ASSERT_EQUALS(0, globalCounts[8]);
 }
 
+TEST(InitializerTest, LazyNodesAreDeferredAndRunOnDemand) {
+    Initializer initializer;
+    CONSTRUCT_DEPENDENCY_GRAPH(initializer.getInitializerDependencyGraph(),
+                               set0,
+                               set1,
+                               set2,
+                               set3,
+                               set4,
+                               set5,
+                               set6,
+                               set7,
+                               set8);
+    // "n8" has no dependents and "n7" is depended on only by "n8", so both may be deferred.
+    ASSERT_OK(initializer.getInitializerDependencyGraph().markNodeLazy("n8"));
+    ASSERT_OK(initializer.getInitializerDependencyGraph().markNodeLazy("n7"));
+    clearCounts();
+    ASSERT_OK(initializer.executeInitializers(InitializerContext::ArgumentVector(),
+                                              InitializerContext::EnvironmentMap()));
+    for (int i = 0; i < 7; ++i)
+        ASSERT_EQUALS(1, globalCounts[i]);
+    ASSERT_EQUALS(0, globalCounts[7]);
+    ASSERT_EQUALS(0, globalCounts[8]);
+
+    ASSERT_OK(initializer.executeLazyInitializers());
+    ASSERT_EQUALS(1, globalCounts[7]);
+    ASSERT_EQUALS(1, globalCounts[8]);
+}
+
+TEST(InitializerTest, LazyNodeWithEagerDependentRunsEagerly) {
+    Initializer initializer;
+    CONSTRUCT_DEPENDENCY_GRAPH(initializer.getInitializerDependencyGraph(),
+                               set0,
+                               set1,
+                               set2,
+                               set3,
+                               set4,
+                               set5,
+                               set6,
+                               set7,
+                               set8);
+    // "n3" is a prerequisite of the eager nodes "n5" and "n7", so marking it lazy must not
+    // actually defer it.
+    ASSERT_OK(initializer.getInitializerDependencyGraph().markNodeLazy("n3"));
+    clearCounts();
+    ASSERT_OK(initializer.executeInitializers(InitializerContext::ArgumentVector(),
+                                              InitializerContext::EnvironmentMap()));
+    for (int i = 0; i < 9; ++i)
+        ASSERT_EQUALS(1, globalCounts[i]);
+}
+
+TEST(InitializerTest, MarkUnknownNodeLazy) {
+    Initializer initializer;
+    ASSERT_EQUALS(ErrorCodes::NoSuchKey,
+                  initializer.getInitializerDependencyGraph().markNodeLazy("nosuchnode"));
+}
+
 }  // namespace
 }  // namespace mongo
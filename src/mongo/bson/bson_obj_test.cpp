@@ -717,4 +717,33 @@ TEST(BSONObj, sizeChecks) {
         ErrorCodes::BSONObjectTooLarge);
 }
 
+TEST(BSONObjJsonStringBuffer, MatchesStreamOutput) {
+    // The StringBuilder-based JSON writer must produce byte-identical output to the stream
+    // implementation for every type it handles natively and via fallback.
+    BSONObjBuilder bob;
+    bob.append("int", 42);
+    bob.append("negInt", -7);
+    bob.append("long", 123456789012345LL);
+    bob.append("double", 3.14159265358979);
+    bob.append("string", "with \"quotes\" and \\slashes\\");
+    bob.appendBool("bool", true);
+    bob.appendNull("null");
+    bob.append("sub", BSON("a" << 1 << "b" << BSON_ARRAY(1 << "two" << 3.0)));
+    bob.appendOID("oid", NULL, true);
+    bob.append("date", Date_t::fromMillisSinceEpoch(1400000000000LL));
+    bob.appendTimestamp("ts", 1234567890);
+    bob.append("dec", Decimal128("1.25"));
+    BSONObj obj = bob.obj();
+
+    for (auto format : {Strict, TenGen, JS}) {
+        for (int pretty : {0, 1}) {
+            std::stringstream stream;
+            obj.jsonStringStream(format, pretty, false, stream);
+            StringBuilder buffer;
+            obj.jsonStringBuffer(format, pretty, false, buffer);
+            ASSERT_EQUALS(stream.str(), buffer.str());
+        }
+    }
+}
+
 }  // unnamed namespace
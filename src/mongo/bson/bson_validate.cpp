@@ -89,10 +89,10 @@ public:
      * reading, if it exists. Otherwise, it should be empty.
      */
     Status readCString(StringData elemName, StringData* out) {
-        const void* x = memchr(_buffer + _position, 0, _maxLength - _position);
+        const char* x = _scanForNul();
         if (!x)
             return makeError("no end of c-string", _idElem, elemName);
-        uint64_t len = static_cast<uint64_t>(static_cast<const char*>(x) - (_buffer + _position));
+        uint64_t len = static_cast<uint64_t>(x - (_buffer + _position));
 
         StringData data(_buffer + _position, len);
         _position += len + 1;
@@ -160,6 +160,39 @@ public:
     }
 
 private:
+    /**
+     * Returns a pointer to the first NUL byte at or after the current position, or NULL if the
+     * buffer contains none. Field names are overwhelmingly short, so scan the first few words
+     * inline, eight bytes at a time, before paying the call overhead of memchr for the long tail.
+     * The word-at-a-time zero-byte test compiles to branch-free vector-friendly code on both x86
+     * and ARM without any per-platform intrinsics.
+     */
+    const char* _scanForNul() const {
+        const char* p = _buffer + _position;
+        uint64_t remaining = _maxLength - _position;
+
+        uint64_t inspected = 0;
+        while (inspected + sizeof(uint64_t) <= remaining && inspected < kInlineScanLimit) {
+            uint64_t word;
+            memcpy(&word, p + inspected, sizeof(word));
+            // Bit trick: a byte of 'word' is zero iff its corresponding byte in this expression
+            // has its high bit set.
+            uint64_t zeroes = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+            if (zeroes) {
+                for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+                    if (p[inspected + i] == '\0')
+                        return p + inspected + i;
+                }
+            }
+            inspected += sizeof(uint64_t);
+        }
+
+        return static_cast<const char*>(memchr(p + inspected, 0, remaining - inspected));
+    }
+
+    // Scan up to four words inline before falling back to memchr; covers typical field names.
+    static const uint64_t kInlineScanLimit = 32;
+
     const char* _buffer;
     uint64_t _position;
     uint64_t _maxLength;
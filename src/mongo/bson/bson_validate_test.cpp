@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cstring>
+
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/db/jsobj.h"
@@ -354,4 +356,24 @@ TEST(BSONValidateBool, BoolValuesAreValidated) {
     }
 }
 
+TEST(BSONValidateFast, LongFieldNames) {
+    // Exercise both the inline word-at-a-time c-string scan and the memchr fallback.
+    for (size_t nameLen = 1; nameLen <= 100; nameLen++) {
+        const std::string name(nameLen, 'a');
+        BSONObjBuilder bob;
+        bob.append(name, 1);
+        const BSONObj obj = bob.obj();
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    }
+}
+
+TEST(BSONValidateFast, MissingCStringTerminatorDetected) {
+    BSONObj x = BSON("longfieldnamehere" << 1);
+    // Overwrite everything after the type byte, including the field name terminator and the
+    // trailing EOO, so no NUL remains in the scanned range.
+    auto writable = const_cast<char*>(x.objdata());
+    memset(writable + 5, 'x', x.objsize() - 5);
+    ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
+}
+
 }  // namespace
@@ -33,6 +33,7 @@
 
 #include <boost/functional/hash.hpp>
 #include <cmath>
+#include <cstdio>
 
 #include "mongo/base/compare_numbers.h"
 #include "mongo/base/data_cursor.h"
@@ -345,6 +346,145 @@ int compareElementStringValues(const BSONElement& leftStr, const BSONElement& ri
 
 }  // namespace
 
+void BSONElement::jsonStringBuffer(JsonStringFormat format,
+                                   bool includeFieldNames,
+                                   int pretty,
+                                   StringBuilder& s) const {
+    if (includeFieldNames)
+        s << '"' << escape(fieldName()) << "\" : ";
+    switch (type()) {
+        case mongo::String:
+        case Symbol:
+            s << '"' << escape(string(valuestr(), valuestrsize() - 1)) << '"';
+            return;
+        case NumberLong:
+            if (format == TenGen) {
+                s << "NumberLong(" << _numberLong() << ")";
+            } else {
+                s << "{ \"$numberLong\" : \"" << _numberLong() << "\" }";
+            }
+            return;
+        case NumberInt:
+            if (format == TenGen) {
+                s << "NumberInt(" << _numberInt() << ")";
+                return;
+            }
+        // fall through: non-TenGen ints print through the double path, matching
+        // jsonStringStream.
+        case NumberDouble:
+            if (number() >= -std::numeric_limits<double>::max() &&
+                number() <= std::numeric_limits<double>::max()) {
+                // Matches the stream implementation's s.precision(16).
+                char buffer[64];
+                int z = snprintf(buffer, sizeof(buffer), "%.16g", number());
+                verify(z > 0 && z < static_cast<int>(sizeof(buffer)));
+                s << StringData(buffer, z);
+            } else if (std::isnan(number())) {
+                s << "NaN";
+            } else if (std::isinf(number())) {
+                s << (number() > 0 ? "Infinity" : "-Infinity");
+            } else {
+                StringBuilder ss;
+                ss << "Number " << number() << " cannot be represented in JSON";
+                string message = ss.str();
+                massert(40758, message.c_str(), false);
+            }
+            return;
+        case mongo::Bool:
+            s << (boolean() ? "true" : "false");
+            return;
+        case jstNULL:
+            s << "null";
+            return;
+        case Undefined:
+            if (format == Strict) {
+                s << "{ \"$undefined\" : true }";
+            } else {
+                s << "undefined";
+            }
+            return;
+        case Object:
+            embeddedObject().jsonStringBuffer(format, pretty, false, s);
+            return;
+        case mongo::Array: {
+            if (embeddedObject().isEmpty()) {
+                s << "[]";
+                return;
+            }
+            s << "[ ";
+            BSONObjIterator i(embeddedObject());
+            BSONElement e = i.next();
+            if (!e.eoo()) {
+                int count = 0;
+                while (1) {
+                    if (pretty) {
+                        s << '\n';
+                        for (int x = 0; x < pretty; x++)
+                            s << "  ";
+                    }
+
+                    if (strtol(e.fieldName(), 0, 10) > count) {
+                        s << "undefined";
+                    } else {
+                        e.jsonStringBuffer(format, false, pretty ? pretty + 1 : 0, s);
+                        e = i.next();
+                    }
+                    count++;
+                    if (e.eoo())
+                        break;
+                    s << ", ";
+                }
+            }
+            s << " ]";
+            return;
+        }
+        case jstOID:
+            if (format == TenGen) {
+                s << "ObjectId( ";
+            } else {
+                s << "{ \"$oid\" : ";
+            }
+            s << '"' << __oid().toString() << '"';
+            if (format == TenGen) {
+                s << " )";
+            } else {
+                s << " }";
+            }
+            return;
+        case bsonTimestamp:
+            if (format == TenGen) {
+                s << "Timestamp( " << durationCount<Seconds>(timestampTime().toDurationSinceEpoch())
+                  << ", " << timestampInc() << " )";
+            } else {
+                s << "{ \"$timestamp\" : { \"t\" : "
+                  << durationCount<Seconds>(timestampTime().toDurationSinceEpoch())
+                  << ", \"i\" : " << timestampInc() << " } }";
+            }
+            return;
+        case mongo::Date:
+            if (format == Strict) {
+                Date_t d = date();
+                s << "{ \"$date\" : ";
+                // See jsonStringStream for why unformattable dates fall back to $numberLong.
+                if (d.isFormattable()) {
+                    s << "\"" << dateToISOStringLocal(d) << "\"";
+                } else {
+                    s << "{ \"$numberLong\" : \"" << d.toMillisSinceEpoch() << "\" }";
+                }
+                s << " }";
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    // Rarely-serialized types (decimal, bindata, regex, dbref, code, dates, min/max key) go
+    // through the stream implementation; they are not worth duplicating here.
+    std::stringstream ss;
+    jsonStringStream(format, false, pretty, ss);
+    s << ss.str();
+}
+
 int BSONElement::compareElements(const BSONElement& l,
                                  const BSONElement& r,
                                  ComparisonRulesSet rules,
@@ -538,6 +678,33 @@ int BSONElement::woCompare(const BSONElement& elem,
         if (int diff = fieldNameStringData().compare(elem.fieldNameStringData()))
             return diff;
     }
+    // Dispatch the dominant homogeneous-type pairs through the specialized comparisons rather
+    // than the generic switch; sorting and index maintenance overwhelmingly compare elements of
+    // identical scalar type.
+    if (type() == elem.type()) {
+        switch (type()) {
+            case NumberInt:
+                return compareElementsOfType<BSONType::NumberInt, BSONType::NumberInt>(*this, elem);
+            case NumberLong:
+                return compareElementsOfType<BSONType::NumberLong, BSONType::NumberLong>(*this,
+                                                                                         elem);
+            case NumberDouble:
+                return compareElementsOfType<BSONType::NumberDouble, BSONType::NumberDouble>(*this,
+                                                                                             elem);
+            case Date:
+                return compareElementsOfType<BSONType::Date, BSONType::Date>(*this, elem);
+            case bsonTimestamp:
+                return compareElementsOfType<BSONType::bsonTimestamp, BSONType::bsonTimestamp>(
+                    *this, elem);
+            case jstOID:
+                return compareElementsOfType<BSONType::jstOID, BSONType::jstOID>(*this, elem);
+            case String:
+                return compareElementsOfType<BSONType::String, BSONType::String>(
+                    *this, elem, comparator);
+            default:
+                break;
+        }
+    }
     return compareElements(*this, elem, rules, comparator);
 }
 
@@ -29,12 +29,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <string.h>  // strlen
 #include <string>
 #include <vector>
 
+#include "mongo/base/compare_numbers.h"
 #include "mongo/base/data_range.h"
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/data_view.h"
@@ -217,6 +219,16 @@ public:
                           int pretty,
                           std::stringstream& s) const;
 
+    /**
+     * Streaming variant of jsonStringStream() writing into a StringBuilder. Numeric values are
+     * emitted through the builder's ItoA-backed formatting; rarely-serialized types fall back to
+     * the stream implementation.
+     */
+    void jsonStringBuffer(JsonStringFormat format,
+                          bool includeFieldNames,
+                          int pretty,
+                          StringBuilder& s) const;
+
     operator std::string() const {
         return toString();
     }
@@ -868,4 +880,89 @@ inline BSONElement::BSONElement() {
     fieldNameSize_ = 0;
     totalSize = 1;
 }
+
+/**
+ * Value comparison specialized at compile time on the pair of BSON types being compared. Callers
+ * that statically know both element types (e.g. sort and index-maintenance loops over homogeneous
+ * keys) can use these to bypass the generic type dispatch in BSONElement::compareElements. Field
+ * names are not considered.
+ *
+ * The unspecialized template falls back to the generic dispatch, so it is always correct to call
+ * for any pair of types with equal canonical type.
+ */
+template <BSONType kLeftType, BSONType kRightType>
+inline int compareElementsOfType(const BSONElement& l,
+                                 const BSONElement& r,
+                                 const StringData::ComparatorInterface* comparator = nullptr) {
+    dassert(l.type() == kLeftType);
+    dassert(r.type() == kRightType);
+    return BSONElement::compareElements(l, r, 0, comparator);
+}
+
+template <>
+inline int compareElementsOfType<NumberInt, NumberInt>(
+    const BSONElement& l, const BSONElement& r, const StringData::ComparatorInterface*) {
+    dassert(l.type() == NumberInt && r.type() == NumberInt);
+    return compareInts(l._numberInt(), r._numberInt());
+}
+
+template <>
+inline int compareElementsOfType<NumberLong, NumberLong>(
+    const BSONElement& l, const BSONElement& r, const StringData::ComparatorInterface*) {
+    dassert(l.type() == NumberLong && r.type() == NumberLong);
+    return compareLongs(l._numberLong(), r._numberLong());
+}
+
+template <>
+inline int compareElementsOfType<NumberDouble, NumberDouble>(
+    const BSONElement& l, const BSONElement& r, const StringData::ComparatorInterface*) {
+    dassert(l.type() == NumberDouble && r.type() == NumberDouble);
+    return compareDoubles(l._numberDouble(), r._numberDouble());
+}
+
+template <>
+inline int compareElementsOfType<Date, Date>(const BSONElement& l,
+                                             const BSONElement& r,
+                                             const StringData::ComparatorInterface*) {
+    dassert(l.type() == Date && r.type() == Date);
+    const Date_t a = l.date();
+    const Date_t b = r.date();
+    if (a < b)
+        return -1;
+    return a == b ? 0 : 1;
+}
+
+template <>
+inline int compareElementsOfType<bsonTimestamp, bsonTimestamp>(
+    const BSONElement& l, const BSONElement& r, const StringData::ComparatorInterface*) {
+    dassert(l.type() == bsonTimestamp && r.type() == bsonTimestamp);
+    if (l.timestamp() < r.timestamp())
+        return -1;
+    return l.timestamp() == r.timestamp() ? 0 : 1;
+}
+
+template <>
+inline int compareElementsOfType<jstOID, jstOID>(const BSONElement& l,
+                                                 const BSONElement& r,
+                                                 const StringData::ComparatorInterface*) {
+    dassert(l.type() == jstOID && r.type() == jstOID);
+    return memcmp(l.value(), r.value(), OID::kOIDSize);
+}
+
+template <>
+inline int compareElementsOfType<String, String>(const BSONElement& l,
+                                                 const BSONElement& r,
+                                                 const StringData::ComparatorInterface* comparator) {
+    dassert(l.type() == String && r.type() == String);
+    if (comparator) {
+        return comparator->compare(l.valueStringData(), r.valueStringData());
+    }
+    // Binary compare through the sizes rather than strcoll; zeros are legal in UTF8 strings.
+    const int lsz = l.valuestrsize();
+    const int rsz = r.valuestrsize();
+    const int common = std::min(lsz, rsz);
+    if (int res = memcmp(l.valuestr(), r.valuestr(), common))
+        return res;
+    return lsz - rsz;
+}
 }
@@ -126,5 +126,57 @@ TEST(BSONElement, ExtractLargeSubObject) {
     BSONObj subObj = element.Obj();
 }
 
+TEST(BSONElement, TypedComparisonsMatchGenericDispatch) {
+    // The compile-time-specialized comparisons must agree with the generic compareElements
+    // dispatch on every ordering outcome.
+    const BSONObj values = BSON("a" << 1 << "b" << 2 << "c" << 2LL << "d" << 3.5 << "e"
+                                    << "abc"
+                                    << "f"
+                                    << "abd"
+                                    << "g" << Date_t::fromMillisSinceEpoch(5) << "h"
+                                    << Timestamp(1, 2) << "i" << OID::gen());
+    auto check = [](auto typedResult, const BSONElement& l, const BSONElement& r) {
+        const int generic = BSONElement::compareElements(l, r, 0, nullptr);
+        ASSERT_EQUALS(generic < 0, typedResult < 0);
+        ASSERT_EQUALS(generic == 0, typedResult == 0);
+    };
+    check(compareElementsOfType<NumberInt, NumberInt>(values["a"], values["b"]),
+          values["a"],
+          values["b"]);
+    check(compareElementsOfType<NumberInt, NumberInt>(values["b"], values["a"]),
+          values["b"],
+          values["a"]);
+    check(compareElementsOfType<NumberInt, NumberInt>(values["a"], values["a"]),
+          values["a"],
+          values["a"]);
+    check(compareElementsOfType<NumberLong, NumberLong>(values["c"], values["c"]),
+          values["c"],
+          values["c"]);
+    check(compareElementsOfType<NumberDouble, NumberDouble>(values["d"], values["d"]),
+          values["d"],
+          values["d"]);
+    check(compareElementsOfType<String, String>(values["e"], values["f"]),
+          values["e"],
+          values["f"]);
+    check(compareElementsOfType<Date, Date>(values["g"], values["g"]), values["g"], values["g"]);
+    check(compareElementsOfType<bsonTimestamp, bsonTimestamp>(values["h"], values["h"]),
+          values["h"],
+          values["h"]);
+    check(compareElementsOfType<jstOID, jstOID>(values["i"], values["i"]),
+          values["i"],
+          values["i"]);
+    // Mixed numeric types fall back to the generic dispatch through the primary template.
+    check(compareElementsOfType<NumberInt, NumberLong>(values["a"], values["c"]),
+          values["a"],
+          values["c"]);
+}
+
+TEST(BSONElement, WoCompareSameTypeFastPathAgreesOnMixedDocs) {
+    const BSONObj l = BSON("a" << 5);
+    const BSONObj r = BSON("a" << 5.0);
+    // Different types with equal values still compare equal through the generic path.
+    ASSERT_EQUALS(0, l["a"].woCompare(r["a"], 0, nullptr));
+}
+
 }  // namespace
 }  // namespace mongo
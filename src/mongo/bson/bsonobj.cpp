@@ -114,11 +114,43 @@ BSONObj BSONObj::getOwned() const {
 }
 
 string BSONObj::jsonString(JsonStringFormat format, int pretty, bool isArray) const {
-    std::stringstream s;
-    BSONObj::jsonStringStream(format, pretty, isArray, s);
+    StringBuilder s;
+    // JSON output runs a bit under twice the BSON size for typical documents; reserving that up
+    // front makes serialization a single allocation in the common case.
+    s.reserveBytes(objsize() * 2);
+    jsonStringBuffer(format, pretty, isArray, s);
     return s.str();
 }
 
+void BSONObj::jsonStringBuffer(JsonStringFormat format,
+                               int pretty,
+                               bool isArray,
+                               StringBuilder& s) const {
+    if (isEmpty()) {
+        s << (isArray ? "[]" : "{}");
+        return;
+    }
+    s << (isArray ? "[ " : "{ ");
+    BSONObjIterator i(*this);
+    BSONElement e = i.next();
+    if (!e.eoo())
+        while (1) {
+            e.jsonStringBuffer(format, !isArray, pretty ? pretty + 1 : 0, s);
+            e = i.next();
+            if (e.eoo())
+                break;
+            s << ",";
+            if (pretty) {
+                s << '\n';
+                for (int x = 0; x < pretty; x++)
+                    s << "  ";
+            } else {
+                s << " ";
+            }
+        }
+    s << (isArray ? " ]" : " }");
+}
+
 void BSONObj::jsonStringStream(JsonStringFormat format,
                                int pretty,
                                bool isArray,
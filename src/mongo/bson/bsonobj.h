@@ -267,6 +267,16 @@ public:
                           bool isArray,
                           std::stringstream& s) const;
 
+    /**
+     * Streaming variant of jsonStringStream() that writes into a caller-supplied StringBuilder,
+     * avoiding stringstream overhead and formatting numbers through ItoA. Callers serializing
+     * many objects should reuse one builder and reserve roughly 2x the BSON size up front.
+     */
+    void jsonStringBuffer(JsonStringFormat format,
+                          int pretty,
+                          bool isArray,
+                          StringBuilder& s) const;
+
     /** note: addFields always adds _id even if not specified */
     int addFields(BSONObj& from, std::set<std::string>& fields); /* returns n added */
 
@@ -487,6 +487,12 @@ public:
         _buf.reset(maxSize);
     }
 
+    /** Grow the underlying buffer so at least 'bytes' more output fits without reallocating. */
+    void reserveBytes(int bytes) {
+        _buf.reserveBytes(bytes);
+        _buf.claimReservedBytes(bytes);
+    }
+
     std::string str() const {
         return std::string(_buf.buf(), _buf.l);
     }
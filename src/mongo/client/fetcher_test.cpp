@@ -580,6 +580,28 @@ TEST_F(FetcherTest, FetchOneDocument) {
     ASSERT_BSONOBJ_EQ(doc, documents.front());
 }
 
+TEST_F(FetcherTest, BatchDocumentsAreSharedViewsIntoTheResponse) {
+    // Replication buffers every fetched oplog batch through these documents, so they must stay
+    // zero-copy views sharing ownership of the response object instead of per-document copies.
+    ASSERT_OK(fetcher->schedule());
+    const BSONObj doc = BSON("_id" << 1);
+    const BSONObj doc2 = BSON("_id" << 2);
+    processNetworkResponse(BSON("cursor" << BSON("id" << 0LL << "ns"
+                                                      << "db.coll"
+                                                      << "firstBatch"
+                                                      << BSON_ARRAY(doc << doc2))
+                                         << "ok"
+                                         << 1),
+                           ReadyQueueState::kEmpty,
+                           FetcherState::kInactive);
+    ASSERT_OK(status);
+    ASSERT_EQUALS(2U, documents.size());
+    ASSERT_TRUE(documents.front().isOwned());
+    ASSERT_TRUE(documents.back().isOwned());
+    ASSERT_EQUALS(static_cast<const void*>(documents.front().sharedBuffer().get()),
+                  static_cast<const void*>(documents.back().sharedBuffer().get()));
+}
+
 TEST_F(FetcherTest, SetNextActionToContinueWhenNextBatchIsNotAvailable) {
     ASSERT_OK(fetcher->schedule());
     const BSONObj doc = BSON("_id" << 1);
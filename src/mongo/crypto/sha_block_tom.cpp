@@ -40,6 +40,15 @@
 
 #include "tomcrypt.h"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MONGO_HAVE_SHA256_INTRINSICS 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace mongo {
 
 namespace {
@@ -95,6 +104,348 @@ void computeHmacImpl(const ltc_hash_descriptor* desc,
                 CRYPT_OK);
 }
 
+#ifdef MONGO_HAVE_SHA256_INTRINSICS
+
+/**
+ * SHA-256 implemented with the x86 SHA extensions. SCRAM-SHA-256 authentication is dominated by
+ * SHA-256 and HMAC-SHA-256 computation, and the SSL build gets hardware acceleration for free
+ * from the crypto library; this gives the tomcrypt fallback the same treatment. Selected at
+ * runtime via CPUID, so the software path still serves older hardware.
+ */
+
+// CPUID.(EAX=7,ECX=0):EBX bit 29 advertises the SHA extensions.
+bool supportsSHA256Instructions() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx) || eax < 7) {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return ebx & (1u << 29);
+}
+
+const bool kHaveSHA256Instructions = supportsSHA256Instructions();
+
+/**
+ * Runs 'numBlocks' 64-byte blocks of 'data' through the SHA-256 compression function,
+ * updating 'state' in place. Standard formulation of the compression function on top of the
+ * SHA-NI round and message-schedule instructions.
+ */
+__attribute__((target("sha,ssse3,sse4.1"))) void sha256Transform(uint32_t state[8],
+                                                                 const uint8_t* data,
+                                                                 size_t numBlocks) {
+    __m128i state0, state1, msg, tmp;
+    __m128i msg0, msg1, msg2, msg3;
+    __m128i abefSave, cdghSave;
+
+    // The rnds2 instruction wants the state in two registers ordered ABEF/CDGH.
+    tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    const __m128i byteSwapMask =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);           // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);     // EFGH
+    state0 = _mm_alignr_epi8(tmp, state1, 8);     // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);  // CDGH
+
+    while (numBlocks > 0) {
+        abefSave = state0;
+        cdghSave = state1;
+
+        // Rounds 0-3
+        msg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0));
+        msg0 = _mm_shuffle_epi8(msg, byteSwapMask);
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0xE9B5DBA5B5C0FBCFULL, 0x71374491428A2F98ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+        // Rounds 4-7
+        msg1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        msg1 = _mm_shuffle_epi8(msg1, byteSwapMask);
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0xAB1C5ED5923F82A4ULL, 0x59F111F13956C25BULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        // Rounds 8-11
+        msg2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+        msg2 = _mm_shuffle_epi8(msg2, byteSwapMask);
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0x550C7DC3243185BEULL, 0x12835B01D807AA98ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        // Rounds 12-15
+        msg3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+        msg3 = _mm_shuffle_epi8(msg3, byteSwapMask);
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0xC19BF1749BDC06A7ULL, 0x80DEB1FE72BE5D74ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg3, msg2, 4);
+        msg0 = _mm_add_epi32(msg0, tmp);
+        msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        // Rounds 16-19
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0x240CA1CC0FC19DC6ULL, 0xEFBE4786E49B69C1ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg0, msg3, 4);
+        msg1 = _mm_add_epi32(msg1, tmp);
+        msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+        // Rounds 20-23
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0x76F988DA5CB0A9DCULL, 0x4A7484AA2DE92C6FULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg1, msg0, 4);
+        msg2 = _mm_add_epi32(msg2, tmp);
+        msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        // Rounds 24-27
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0xBF597FC7B00327C8ULL, 0xA831C66D983E5152ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg2, msg1, 4);
+        msg3 = _mm_add_epi32(msg3, tmp);
+        msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        // Rounds 28-31
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0x1429296706CA6351ULL, 0xD5A79147C6E00BF3ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg3, msg2, 4);
+        msg0 = _mm_add_epi32(msg0, tmp);
+        msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        // Rounds 32-35
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0x53380D134D2C6DFCULL, 0x2E1B213827B70A85ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg0, msg3, 4);
+        msg1 = _mm_add_epi32(msg1, tmp);
+        msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+        // Rounds 36-39
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0x92722C8581C2C92EULL, 0x766A0ABB650A7354ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg1, msg0, 4);
+        msg2 = _mm_add_epi32(msg2, tmp);
+        msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        // Rounds 40-43
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0xC76C51A3C24B8B70ULL, 0xA81A664BA2BFE8A1ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg2, msg1, 4);
+        msg3 = _mm_add_epi32(msg3, tmp);
+        msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        // Rounds 44-47
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0x106AA070F40E3585ULL, 0xD6990624D192E819ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg3, msg2, 4);
+        msg0 = _mm_add_epi32(msg0, tmp);
+        msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        // Rounds 48-51
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0x34B0BCB52748774CULL, 0x1E376C0819A4C116ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg0, msg3, 4);
+        msg1 = _mm_add_epi32(msg1, tmp);
+        msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+        // Rounds 52-55
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0x682E6FF35B9CCA4FULL, 0x4ED8AA4A391C0CB3ULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg1, msg0, 4);
+        msg2 = _mm_add_epi32(msg2, tmp);
+        msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+        // Rounds 56-59
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0x8CC7020884C87814ULL, 0x78A5636F748F82EEULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        tmp = _mm_alignr_epi8(msg2, msg1, 4);
+        msg3 = _mm_add_epi32(msg3, tmp);
+        msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+        // Rounds 60-63
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0xC67178F2BEF9A3F7ULL, 0xA4506CEB90BEFFFAULL));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+
+        data += 64;
+        numBlocks--;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+/**
+ * Streaming SHA-256 context over the accelerated compression function, with the usual
+ * merkle-damgard buffering, padding and length encoding.
+ */
+class Sha256Context {
+public:
+    Sha256Context() {
+        static const uint32_t kInitialState[8] = {0x6A09E667,
+                                                  0xBB67AE85,
+                                                  0x3C6EF372,
+                                                  0xA54FF53A,
+                                                  0x510E527F,
+                                                  0x9B05688C,
+                                                  0x1F83D9AB,
+                                                  0x5BE0CD19};
+        memcpy(_state, kInitialState, sizeof(_state));
+    }
+
+    void update(const uint8_t* data, size_t len) {
+        _totalBytes += len;
+
+        if (_bufferLen > 0) {
+            size_t take = std::min(len, sizeof(_buffer) - _bufferLen);
+            memcpy(_buffer + _bufferLen, data, take);
+            _bufferLen += take;
+            data += take;
+            len -= take;
+            if (_bufferLen == sizeof(_buffer)) {
+                sha256Transform(_state, _buffer, 1);
+                _bufferLen = 0;
+            }
+        }
+
+        const size_t numBlocks = len / sizeof(_buffer);
+        if (numBlocks > 0) {
+            sha256Transform(_state, data, numBlocks);
+            data += numBlocks * sizeof(_buffer);
+            len -= numBlocks * sizeof(_buffer);
+        }
+
+        if (len > 0) {
+            memcpy(_buffer, data, len);
+            _bufferLen = len;
+        }
+    }
+
+    void done(uint8_t* output) {
+        const uint64_t bitLength = _totalBytes * 8;
+
+        _buffer[_bufferLen++] = 0x80;
+        if (_bufferLen > 56) {
+            memset(_buffer + _bufferLen, 0, sizeof(_buffer) - _bufferLen);
+            sha256Transform(_state, _buffer, 1);
+            _bufferLen = 0;
+        }
+        memset(_buffer + _bufferLen, 0, 56 - _bufferLen);
+        for (int i = 0; i < 8; i++) {
+            _buffer[56 + i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+        }
+        sha256Transform(_state, _buffer, 1);
+
+        for (int i = 0; i < 8; i++) {
+            output[4 * i] = static_cast<uint8_t>(_state[i] >> 24);
+            output[4 * i + 1] = static_cast<uint8_t>(_state[i] >> 16);
+            output[4 * i + 2] = static_cast<uint8_t>(_state[i] >> 8);
+            output[4 * i + 3] = static_cast<uint8_t>(_state[i]);
+        }
+    }
+
+private:
+    uint32_t _state[8];
+    uint64_t _totalBytes = 0;
+    uint8_t _buffer[64];
+    size_t _bufferLen = 0;
+};
+
+SHA256BlockTraits::HashType computeSha256WithIntrinsics(
+    std::initializer_list<ConstDataRange> input) {
+    Sha256Context context;
+    for (const auto& range : input) {
+        context.update(reinterpret_cast<const uint8_t*>(range.data()), range.length());
+    }
+    SHA256BlockTraits::HashType output;
+    context.done(output.data());
+    return output;
+}
+
+void computeHmacSha256WithIntrinsics(const uint8_t* key,
+                                     size_t keyLen,
+                                     const uint8_t* input,
+                                     size_t inputLen,
+                                     SHA256BlockTraits::HashType* const output) {
+    constexpr size_t kBlockSize = 64;
+
+    uint8_t keyBlock[kBlockSize] = {};
+    if (keyLen > kBlockSize) {
+        Sha256Context keyContext;
+        keyContext.update(key, keyLen);
+        SHA256BlockTraits::HashType keyHash;
+        keyContext.done(keyHash.data());
+        memcpy(keyBlock, keyHash.data(), keyHash.size());
+    } else {
+        memcpy(keyBlock, key, keyLen);
+    }
+
+    uint8_t pad[kBlockSize];
+    for (size_t i = 0; i < kBlockSize; i++) {
+        pad[i] = keyBlock[i] ^ 0x36;
+    }
+    Sha256Context inner;
+    inner.update(pad, sizeof(pad));
+    inner.update(input, inputLen);
+    SHA256BlockTraits::HashType innerDigest;
+    inner.done(innerDigest.data());
+
+    for (size_t i = 0; i < kBlockSize; i++) {
+        pad[i] = keyBlock[i] ^ 0x5c;
+    }
+    Sha256Context outer;
+    outer.update(pad, sizeof(pad));
+    outer.update(innerDigest.data(), innerDigest.size());
+    outer.done(output->data());
+}
+
+#endif  // MONGO_HAVE_SHA256_INTRINSICS
+
 }  // namespace
 
 SHA1BlockTraits::HashType SHA1BlockTraits::computeHash(
@@ -104,6 +455,11 @@ SHA1BlockTraits::HashType SHA1BlockTraits::computeHash(
 
 SHA256BlockTraits::HashType SHA256BlockTraits::computeHash(
     std::initializer_list<ConstDataRange> input) {
+#ifdef MONGO_HAVE_SHA256_INTRINSICS
+    if (kHaveSHA256Instructions) {
+        return computeSha256WithIntrinsics(input);
+    }
+#endif
     return computeHashImpl<SHA256BlockTraits::HashType, sha256_init, sha256_process, sha256_done>(
         input);
 }
@@ -121,6 +477,12 @@ void SHA256BlockTraits::computeHmac(const uint8_t* key,
                                     const uint8_t* input,
                                     size_t inputLen,
                                     HashType* const output) {
+    invariant(key && input);
+#ifdef MONGO_HAVE_SHA256_INTRINSICS
+    if (kHaveSHA256Instructions) {
+        return computeHmacSha256WithIntrinsics(key, keyLen, input, inputLen, output);
+    }
+#endif
     return computeHmacImpl<HashType>(&sha256_desc, key, keyLen, input, inputLen, output);
 }
 
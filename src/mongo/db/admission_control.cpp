@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/admission_control.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+AdmissionController globalAdmissionController;
+
+namespace {
+
+// Target for the 95th percentile of the time operations spend waiting for a global ticket.
+// Zero (the default) disables admission control entirely.
+MONGO_EXPORT_SERVER_PARAMETER(admissionControlTargetTicketWaitMillis, int, 0);
+
+// How long a low-priority operation is delayed before dispatch while the p95 ticket wait is
+// above target.
+MONGO_EXPORT_SERVER_PARAMETER(admissionControlBackoffMillis, int, 10);
+
+// Number of ticket waits in a full sampling window. When the window fills, all counters are
+// halved rather than reset so the estimate decays smoothly.
+const int64_t kWindowSize = 2048;
+
+// Do not act on the window until it holds at least this many samples, so a handful of slow
+// waits right after startup (or right after a halving) cannot trigger backpressure.
+const int64_t kMinWindowWaits = 100;
+
+Counter64 delayedOperations;
+ServerStatusMetricField<Counter64> displayDelayedOperations("admission.delayedOperations",
+                                                            &delayedOperations);
+
+Counter64 rejectedOperations;
+ServerStatusMetricField<Counter64> displayRejectedOperations("admission.rejectedOperations",
+                                                             &rejectedOperations);
+
+class ConcurrentOperationsMetric : public ServerStatusMetric {
+public:
+    ConcurrentOperationsMetric() : ServerStatusMetric("admission.concurrentOperations") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        BSONObjBuilder sub(b.subobjStart(_leafName));
+        sub.append("commands",
+                   globalAdmissionController.concurrentOperations(AdmissionController::kCommand));
+        sub.append("reads",
+                   globalAdmissionController.concurrentOperations(AdmissionController::kRead));
+        sub.append("writes",
+                   globalAdmissionController.concurrentOperations(AdmissionController::kWrite));
+        sub.append("other",
+                   globalAdmissionController.concurrentOperations(AdmissionController::kOther));
+    }
+} concurrentOperationsMetric;
+
+}  // namespace
+
+void AdmissionController::recordTicketWait(Milliseconds waited) {
+    const auto target = admissionControlTargetTicketWaitMillis.load();
+    if (target <= 0)
+        return;
+
+    if (waited > Milliseconds(target))
+        _waitsOverTarget.addAndFetch(1);
+    if (waited > Milliseconds(4 * static_cast<int64_t>(target)))
+        _waitsFarOverTarget.addAndFetch(1);
+
+    if (_windowWaits.addAndFetch(1) < kWindowSize)
+        return;
+
+    // The window is full; halve all counters so older samples decay. Increments racing with
+    // the halving can perturb the estimate by a sample or two, which is harmless.
+    _windowWaits.store(_windowWaits.load() / 2);
+    _waitsOverTarget.store(_waitsOverTarget.load() / 2);
+    _waitsFarOverTarget.store(_waitsFarOverTarget.load() / 2);
+}
+
+void AdmissionController::admitOperation(OperationContext* opCtx,
+                                         Category category,
+                                         bool lowPriority) {
+    _concurrent[category].addAndFetch(1);
+
+    if (!lowPriority || !_p95AboveTarget(_waitsOverTarget))
+        return;
+
+    delayedOperations.increment();
+
+    const Milliseconds backoff{std::max(0, admissionControlBackoffMillis.load())};
+    if (opCtx) {
+        opCtx->sleepFor(backoff);
+    } else {
+        sleepmillis(durationCount<Milliseconds>(backoff));
+    }
+}
+
+void AdmissionController::finishOperation(Category category) {
+    _concurrent[category].subtractAndFetch(1);
+}
+
+void AdmissionController::uassertNotSaturated() {
+    if (!_p95AboveTarget(_waitsFarOverTarget))
+        return;
+
+    rejectedOperations.increment();
+    uasserted(ErrorCodes::TemporarilyUnavailable,
+              "The server is temporarily unable to accept new operations: the 95th percentile "
+              "of recent global ticket waits is far above "
+              "admissionControlTargetTicketWaitMillis. Retry the operation after backing off.");
+}
+
+int AdmissionController::concurrentOperations(Category category) const {
+    return _concurrent[category].load();
+}
+
+bool AdmissionController::_p95AboveTarget(const AtomicInt64& overTarget) const {
+    if (admissionControlTargetTicketWaitMillis.load() <= 0)
+        return false;
+
+    const auto waits = _windowWaits.load();
+    if (waits < kMinWindowWaits)
+        return false;
+
+    // The p95 is above target exactly when more than 5% of the sampled waits are.
+    return overTarget.load() * 20 > waits;
+}
+
+}  // namespace mongo
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Sheds load before an overloaded server starts piling operations onto the global ticket
+ * holders and the lock manager. The Locker reports how long each operation waited for its
+ * ticket; when more than five percent of the recent waits exceed the configured target (that
+ * is, when the p95 ticket wait crosses it) newly arriving low-priority operations are briefly
+ * delayed before they are dispatched, and once a similar fraction of waits is far beyond the
+ * target, commands from low-priority clients are rejected with TemporarilyUnavailable so
+ * clients back off and retry instead of deepening the queues.
+ *
+ * Disabled unless admissionControlTargetTicketWaitMillis is set to a positive value.
+ */
+class AdmissionController {
+    MONGO_DISALLOW_COPYING(AdmissionController);
+
+public:
+    /**
+     * The broad kind of work an operation represents. Used to track how many operations of
+     * each kind are currently executing past admission.
+     */
+    enum Category { kCommand, kRead, kWrite, kOther, kNumCategories };
+
+    AdmissionController() = default;
+
+    /**
+     * Called by the Locker with the time an operation spent waiting for a global ticket. Does
+     * nothing when admission control is disabled.
+     */
+    void recordTicketWait(Milliseconds waited);
+
+    /**
+     * Admits an operation of 'category' for execution. When 'lowPriority' is set and the p95
+     * ticket wait is above target, sleeps for admissionControlBackoffMillis (interruptibly,
+     * when 'opCtx' is non-null) before returning. Every call must be paired with a call to
+     * finishOperation().
+     */
+    void admitOperation(OperationContext* opCtx, Category category, bool lowPriority);
+    void finishOperation(Category category);
+
+    /**
+     * Throws TemporarilyUnavailable when recent ticket waits show the server is saturated far
+     * beyond the configured target. Called for commands from low-priority clients only, from a
+     * context where the error is returned to the client as a command response.
+     */
+    void uassertNotSaturated();
+
+    /**
+     * Number of operations of 'category' currently executing past admission.
+     */
+    int concurrentOperations(Category category) const;
+
+private:
+    /**
+     * Returns true when more than five percent of the waits in the current window exceed the
+     * target ('overTarget') or four times the target ('_waitsFarOverTarget').
+     */
+    bool _p95AboveTarget(const AtomicInt64& overTarget) const;
+
+    // Sliding window over the most recent ticket waits. All counters are halved whenever the
+    // window fills up, so older samples progressively lose weight.
+    AtomicInt64 _windowWaits;
+    AtomicInt64 _waitsOverTarget;
+    AtomicInt64 _waitsFarOverTarget;
+
+    AtomicInt32 _concurrent[kNumCategories];
+};
+
+extern AdmissionController globalAdmissionController;
+
+}  // namespace mongo
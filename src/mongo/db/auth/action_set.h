@@ -65,6 +65,10 @@ public:
         return this->_actions == other._actions;
     }
 
+    size_t hash() const {
+        return std::hash<std::bitset<ActionType::NUM_ACTION_TYPES>>()(_actions);
+    }
+
     bool contains(const ActionType& action) const;
 
     // Returns true only if this ActionSet contains all the actions present in the 'other'
@@ -67,6 +67,7 @@
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -418,13 +419,9 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         return internalSecurity.user;
     }
 
-    CacheGuard guard(this, CacheGuard::fetchSynchronizationManual);
-    boost::optional<std::shared_ptr<User>> cachedUser;
-    while ((boost::none == (cachedUser = _userCache.get(userName))) &&
-           guard.otherUpdateInFetchPhase()) {
-        guard.wait();
-    }
+    stdx::unique_lock<stdx::mutex> lk(_cacheMutex);
 
+    auto cachedUser = _userCache.get(userName);
     if (cachedUser != boost::none) {
         auto ret = *cachedUser;
         fassert(16914, ret.get());
@@ -432,8 +429,39 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         return ret;
     }
 
+    auto inFlight = _inFlightUserFetches.find(userName);
+    if (inFlight != _inFlightUserFetches.end()) {
+        // Another thread is already fetching this user. Wait for its result instead of
+        // issuing a duplicate lookup against the admin database; after a failover, thousands
+        // of reconnecting clients may ask for the same few users at once.
+        auto fetch = inFlight->second;
+        while (!fetch->done) {
+            fetch->cv.wait(lk);
+        }
+        return fetch->result;
+    }
+
+    // This thread performs the fetch. Fetches of distinct users run in parallel; only callers
+    // asking for the same UserName coalesce onto this one backend request.
+    auto fetch = std::make_shared<InFlightUserFetch>();
+    fetch->startGeneration = _fetchGeneration;
+    _inFlightUserFetches[userName] = fetch;
+
     int authzVersion = _version;
-    guard.beginFetchPhase();
+    lk.unlock();
+
+    StatusWith<UserHandle> result = Status(ErrorCodes::InternalError, "user fetch did not run");
+
+    // Publish the outcome to any waiters no matter how this function exits.
+    auto publishGuard = MakeGuard([&] {
+        if (!lk.owns_lock()) {
+            lk.lock();
+        }
+        fetch->result = result;
+        fetch->done = true;
+        _inFlightUserFetches.erase(userName);
+        fetch->cv.notify_all();
+    });
 
     // Number of times to retry a user document that fetches due to transient
     // AuthSchemaIncompatible errors.  These errors should only ever occur during and shortly
@@ -443,9 +471,11 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
     std::unique_ptr<User> user;
     for (int i = 0; i < maxAcquireRetries; ++i) {
         if (authzVersion == schemaVersionInvalid) {
-            Status status = _externalState->getStoredAuthorizationVersion(opCtx, &authzVersion);
-            if (!status.isOK())
-                return status;
+            status = _externalState->getStoredAuthorizationVersion(opCtx, &authzVersion);
+            if (!status.isOK()) {
+                result = status;
+                return result;
+            }
         }
 
         switch (authzVersion) {
@@ -470,27 +500,32 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         }
         if (status.isOK())
             break;
-        if (status != ErrorCodes::AuthSchemaIncompatible)
-            return status;
+        if (status != ErrorCodes::AuthSchemaIncompatible) {
+            result = status;
+            return result;
+        }
 
         authzVersion = schemaVersionInvalid;
     }
-    if (!status.isOK())
-        return status;
-
-    guard.endFetchPhase();
+    if (!status.isOK()) {
+        result = status;
+        return result;
+    }
 
-    if (guard.isSameCacheGeneration()) {
+    lk.lock();
+    if (fetch->startGeneration == _fetchGeneration) {
         if (_version == schemaVersionInvalid)
             _version = authzVersion;
-        return _userCache.insertOrAssignAndGet(userName, std::move(user));
+        result = _userCache.insertOrAssignAndGet(userName, std::move(user));
     } else {
-        // If the cache generation changed while this thread was in fetch mode, the data
-        // associated with the user may now be invalid, so we must mark it as such.  The caller
-        // may still opt to use the information for a short while, but not indefinitely.
+        // If the cache generation changed while this thread was fetching, the data associated
+        // with the user may now be invalid, so we must mark it as such.  The caller (and any
+        // waiters) may still opt to use the information for a short while, but not
+        // indefinitely.
         user->_invalidate();
-        return UserHandle(std::move(user));
+        result = UserHandle(std::move(user));
     }
+    return result;
 }
 
 Status AuthorizationManagerImpl::_fetchUserV2(OperationContext* opCtx,
@@ -220,6 +220,24 @@ private:
 
     InvalidatingLRUCache<UserName, User, UserCacheInvalidator> _userCache;
 
+    /**
+     * State shared by concurrent acquireUser() calls for a single UserName. The first caller
+     * performs the backend fetch; the others wait on 'cv' and share 'result' rather than
+     * issuing duplicate lookups against the admin database.
+     */
+    struct InFlightUserFetch {
+        stdx::condition_variable cv;
+        bool done = false;
+        StatusWith<UserHandle> result = Status(ErrorCodes::InternalError, "user fetch pending");
+        OID startGeneration;
+    };
+
+    /**
+     * Fetches in progress for users not present in _userCache, keyed by UserName.
+     * Protected by _cacheMutex.
+     */
+    stdx::unordered_map<UserName, std::shared_ptr<InFlightUserFetch>> _inFlightUserFetches;
+
     /**
      * Current generation of cached data.  Updated every time part of the cache gets
      * invalidated.  Protected by CacheGuard.
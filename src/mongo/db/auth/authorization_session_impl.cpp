@@ -134,6 +134,7 @@ Status AuthorizationSessionImpl::addAndAuthorizeUser(OperationContext* opCtx,
     }
 
     _authenticatedUsers.add(std::move(user));
+    _privilegeCheckCache.clear();
 
     // If there are any users and roles in the impersonation data, clear it out.
     clearImpersonatedUserData();
@@ -164,6 +165,7 @@ User* AuthorizationSessionImpl::getSingleUser() {
 
 void AuthorizationSessionImpl::logoutDatabase(StringData dbname) {
     _authenticatedUsers.removeByDBName(dbname);
+    _privilegeCheckCache.clear();
     clearImpersonatedUserData();
     _buildAuthenticatedRolesVector();
 }
@@ -189,6 +191,7 @@ std::string AuthorizationSessionImpl::getAuthenticatedUserNamesToken() {
 
 void AuthorizationSessionImpl::grantInternalAuthorization() {
     _authenticatedUsers.add(internalSecurity.user);
+    _privilegeCheckCache.clear();
     _buildAuthenticatedRolesVector();
 }
 
@@ -752,6 +755,14 @@ bool AuthorizationSessionImpl::isAuthenticated() {
 
 void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx) {
     AuthorizationManager& authMan = getAuthorizationManager();
+
+    const OID cacheGeneration = authMan.getCacheGeneration();
+    if (cacheGeneration != _privilegeCheckCacheGeneration) {
+        // Privilege data changed out from under us; drop all memoized decisions.
+        _privilegeCheckCache.clear();
+        _privilegeCheckCacheGeneration = cacheGeneration;
+    }
+
     UserSet::iterator it = _authenticatedUsers.begin();
 
     while (it != _authenticatedUsers.end()) {
@@ -905,6 +916,18 @@ bool AuthorizationSessionImpl::isAuthorizedForAnyActionOnResource(const Resource
 
 
 bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privilege) {
+    PrivilegeCheckCacheKey cacheKey(privilege.getResourcePattern(), privilege.getActions());
+    auto cached = _privilegeCheckCache.find(cacheKey);
+    if (cached != _privilegeCheckCache.end()) {
+        return cached->second;
+    }
+
+    const bool authorized = _computeAuthorizedForPrivilege(privilege);
+    _privilegeCheckCache.add(cacheKey, authorized);
+    return authorized;
+}
+
+bool AuthorizationSessionImpl::_computeAuthorizedForPrivilege(const Privilege& privilege) {
     const ResourcePattern& target(privilege.getResourcePattern());
 
     ResourcePattern resourceSearchList[resourceSearchListCapacity];
@@ -41,9 +41,11 @@
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authz_session_external_state.h"
 #include "mongo/db/auth/privilege.h"
+#include "mongo/db/auth/resource_pattern.h"
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/util/lru_cache.h"
 
 namespace mongo {
 
@@ -217,14 +219,44 @@ private:
     // Checks if this connection is authorized for the given Privilege, ignoring whether or not
     // we should even be doing authorization checks in general.  Note: this may acquire a read
     // lock on the admin database (to update out-of-date user privilege information).
+    //
+    // Memoizes its decision in _privilegeCheckCache, so the steady state for a repeated check
+    // is a single hash probe rather than a privilege resolution walk.
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Performs the actual privilege resolution walk over the default privileges and the
+    // authenticated users' privileges. Only called by _isAuthorizedForPrivilege() on a
+    // _privilegeCheckCache miss.
+    bool _computeAuthorizedForPrivilege(const Privilege& privilege);
+
     std::tuple<std::vector<UserName>*, std::vector<RoleName>*> _getImpersonations() override {
         return std::make_tuple(&_impersonatedUserNames, &_impersonatedRoleNames);
     }
 
     std::unique_ptr<AuthzSessionExternalState> _externalState;
 
+    // Memoized _isAuthorizedForPrivilege() decisions for the current set of authenticated
+    // users. The cache is cleared whenever users are added to or removed from this session,
+    // and whenever the authorization manager's user cache generation moves (checked once per
+    // request in _refreshUserInfoAsNeeded()), so entries can never outlive the privilege data
+    // they were derived from. LRU-bounded so a workload probing many distinct resources
+    // cannot grow it without limit.
+    static const size_t kPrivilegeCheckCacheSize = 256;
+
+    using PrivilegeCheckCacheKey = std::pair<ResourcePattern, ActionSet>;
+
+    struct PrivilegeCheckCacheKeyHash {
+        size_t operator()(const PrivilegeCheckCacheKey& key) const {
+            return key.first.hash() ^ (key.second.hash() << 1);
+        }
+    };
+
+    LRUCache<PrivilegeCheckCacheKey, bool, PrivilegeCheckCacheKeyHash> _privilegeCheckCache{
+        kPrivilegeCheckCacheSize};
+
+    // The user cache generation _privilegeCheckCache's contents were computed against.
+    OID _privilegeCheckCacheGeneration;
+
     // A vector of impersonated UserNames and a vector of those users' RoleNames.
     // These are used in the auditing system. They are not used for authz checks.
     std::vector<UserName> _impersonatedUserNames;
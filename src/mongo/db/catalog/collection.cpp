@@ -105,6 +105,22 @@ void CappedInsertNotifier::notifyAll() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     ++_version;
     _notifier.notify_all();
+    _notifyFilteredWaiters(boost::none);
+}
+
+void CappedInsertNotifier::notifyInsert(Timestamp ts) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    ++_version;
+    _notifier.notify_all();
+    _notifyFilteredWaiters(ts);
+}
+
+void CappedInsertNotifier::_notifyFilteredWaiters(boost::optional<Timestamp> ts) {
+    auto end = ts ? _filteredWaiters.upper_bound(*ts) : _filteredWaiters.end();
+    for (auto it = _filteredWaiters.begin(); it != end; ++it) {
+        it->second->notified = true;
+        it->second->cv.notify_one();
+    }
 }
 
 void CappedInsertNotifier::waitUntil(uint64_t prevVersion, Date_t deadline) const {
@@ -116,10 +132,36 @@ void CappedInsertNotifier::waitUntil(uint64_t prevVersion, Date_t deadline) cons
     }
 }
 
+void CappedInsertNotifier::waitUntil(uint64_t prevVersion,
+                                     Date_t deadline,
+                                     boost::optional<Timestamp> minTs) const {
+    if (!minTs) {
+        waitUntil(prevVersion, deadline);
+        return;
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+    // As in the unfiltered wait, return immediately if data may already be available.
+    if (_dead || prevVersion != _version) {
+        return;
+    }
+
+    FilteredWaiter waiter;
+    auto it = _filteredWaiters.emplace(*minTs, &waiter);
+    while (!_dead && !waiter.notified) {
+        if (stdx::cv_status::timeout == waiter.cv.wait_until(lk, deadline.toSystemTimePoint())) {
+            break;
+        }
+    }
+    _filteredWaiters.erase(it);
+}
+
 void CappedInsertNotifier::kill() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _dead = true;
     _notifier.notify_all();
+    _notifyFilteredWaiters(boost::none);
 }
 
 bool CappedInsertNotifier::isDead() {
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -134,6 +135,13 @@ public:
      */
     void notifyAll();
 
+    /**
+     * Wakes up unfiltered waiters, and those waiters whose registered minimum timestamp is at or
+     * below 'ts'. Used when the timestamp of the newly visible data is known, so that waiters
+     * which cannot possibly be satisfied by it are left asleep.
+     */
+    void notifyInsert(Timestamp ts);
+
     /**
      * Waits until 'deadline', or until notifyAll() is called to indicate that new
      * data is available in the capped collection.
@@ -142,6 +150,14 @@ public:
      */
     void waitUntil(uint64_t prevVersion, Date_t deadline) const;
 
+    /**
+     * As above, but if 'minTs' is set, the wait is only interrupted by inserts at or above
+     * 'minTs' (or by notifyAll(), kill(), or the deadline). Used by waiters whose query cannot
+     * match documents below 'minTs', so that they do not participate in the thundering herd on
+     * every insert.
+     */
+    void waitUntil(uint64_t prevVersion, Date_t deadline, boost::optional<Timestamp> minTs) const;
+
     /**
      * Returns the version for use as an additional wake condition when used above.
      */
@@ -160,12 +176,29 @@ public:
     bool isDead();
 
 private:
+    // State for a waiter that only cares about inserts at or above a minimum timestamp. Each such
+    // waiter gets its own condition variable so it can be woken individually.
+    struct FilteredWaiter {
+        stdx::condition_variable cv;
+        bool notified = false;
+    };
+
+    /**
+     * Wakes the filtered waiters whose minimum timestamp is at or below 'ts'. If 'ts' is not set,
+     * wakes them all. Callers must hold '_mutex'.
+     */
+    void _notifyFilteredWaiters(boost::optional<Timestamp> ts);
+
     // Signalled when a successful insert is made into a capped collection.
     mutable stdx::condition_variable _notifier;
 
-    // Mutex used with '_notifier'. Protects access to '_version'.
+    // Mutex used with '_notifier'. Protects access to '_version' and '_filteredWaiters'.
     mutable stdx::mutex _mutex;
 
+    // Filtered waiters, ordered by their minimum timestamp so that an insert wakes exactly the
+    // prefix of waiters it can satisfy.
+    mutable std::multimap<Timestamp, FilteredWaiter*> _filteredWaiters;
+
     // A counter, incremented on insertion of new data into the capped collection.
     //
     // The condition which '_cappedNewDataNotifier' is being notified of is an increment of this
@@ -336,7 +369,7 @@ public:
 
         virtual bool haveCappedWaiters() = 0;
 
-        virtual void notifyCappedWaitersIfNeeded() = 0;
+        virtual void notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs) = 0;
 
         virtual const CollatorInterface* getDefaultCollator() const = 0;
     };
@@ -710,10 +743,11 @@ public:
     }
 
     /**
-     * Notify (capped collection) waiters of data changes, like an insert.
+     * Notify (capped collection) waiters of data changes, like an insert. If 'commitTs' is set,
+     * waiters that cannot be satisfied by data at or below that timestamp are left asleep.
      */
-    inline void notifyCappedWaitersIfNeeded() {
-        return this->_impl().notifyCappedWaitersIfNeeded();
+    inline void notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs = boost::none) {
+        return this->_impl().notifyCappedWaitersIfNeeded(commitTs);
     }
 
     /**
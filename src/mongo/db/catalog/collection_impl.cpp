@@ -153,7 +153,8 @@ CollectionImpl::CollectionImpl(Collection* _this_init,
       _details(details),
       _recordStore(recordStore),
       _dbce(dbce),
-      _needCappedLock(supportsDocLocking() && _recordStore->isCapped() && _ns.db() != "local"),
+      _needCappedLock(supportsDocLocking() && _recordStore->isCapped() && _ns.db() != "local" &&
+                      !details->getCollectionOptions(opCtx).cappedRelaxedOrder),
       _infoCache(_this_init, _ns),
       _indexCatalog(_this_init, this->getCatalogEntry()->getMaxAllowedIndexes()),
       _collator(parseCollation(opCtx, _ns, _details->getCollectionOptions(opCtx).collation)),
@@ -315,8 +316,11 @@ Status CollectionImpl::insertDocumentsForOplog(OperationContext* opCtx,
     if (!status.isOK())
         return status;
 
+    // The commit timestamp corresponds to the first entry in the batch, so notify with the last
+    // entry's timestamp to cover every document made visible by this commit.
+    const Timestamp lastTs = timestamps[nDocs - 1];
     opCtx->recoveryUnit()->onCommit(
-        [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
+        [this, lastTs](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(lastTs); });
 
     return status;
 }
@@ -367,8 +371,9 @@ Status CollectionImpl::insertDocuments(OperationContext* opCtx,
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), begin, end, fromMigrate);
 
-    opCtx->recoveryUnit()->onCommit(
-        [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
+    opCtx->recoveryUnit()->onCommit([this](boost::optional<Timestamp> commitTs) {
+        notifyCappedWaitersIfNeeded(commitTs);
+    });
 
     MONGO_FAIL_POINT_BLOCK(hangAfterCollectionInserts, extraData) {
         const BSONObj& data = extraData.getData();
@@ -449,8 +454,9 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), inserts.begin(), inserts.end(), false);
 
-    opCtx->recoveryUnit()->onCommit(
-        [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
+    opCtx->recoveryUnit()->onCommit([this](boost::optional<Timestamp> commitTs) {
+        notifyCappedWaitersIfNeeded(commitTs);
+    });
 
     return loc.getStatus();
 }
@@ -521,11 +527,16 @@ bool CollectionImpl::haveCappedWaiters() {
     return _cappedNotifier.use_count() > 1;
 }
 
-void CollectionImpl::notifyCappedWaitersIfNeeded() {
+void CollectionImpl::notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs) {
     // If there is a notifier object and another thread is waiting on it, then we notify
     // waiters of this document insert.
-    if (haveCappedWaiters())
-        _cappedNotifier->notifyAll();
+    if (haveCappedWaiters()) {
+        if (commitTs) {
+            _cappedNotifier->notifyInsert(*commitTs);
+        } else {
+            _cappedNotifier->notifyAll();
+        }
+    }
 }
 
 Status CollectionImpl::aboutToDeleteCapped(OperationContext* opCtx,
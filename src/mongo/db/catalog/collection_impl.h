@@ -346,9 +346,10 @@ public:
     bool haveCappedWaiters() final;
 
     /**
-     * Notify (capped collection) waiters of data changes, like an insert.
+     * Notify (capped collection) waiters of data changes, like an insert. If 'commitTs' is set,
+     * waiters that cannot be satisfied by data at or below that timestamp are left asleep.
      */
-    void notifyCappedWaitersIfNeeded() final;
+    void notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs) final;
 
     /**
      * Get a pointer to the collection's default collator. The pointer must not be used after this
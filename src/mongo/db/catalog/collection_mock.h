@@ -268,7 +268,7 @@ public:
         return false;
     }
 
-    void notifyCappedWaitersIfNeeded() {
+    void notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs) {
         std::abort();
     }
 
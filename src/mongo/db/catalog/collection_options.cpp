@@ -156,6 +156,12 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             if (!validMaxCappedDocs(&cappedMaxDocs))
                 return Status(ErrorCodes::BadValue,
                               "max in a capped collection has to be < 2^31 or not set");
+        } else if (fieldName == "cappedRelaxedOrder") {
+            if (!options["capped"].trueValue()) {
+                return Status(ErrorCodes::BadValue,
+                              "cappedRelaxedOrder requires a capped collection");
+            }
+            cappedRelaxedOrder = e.trueValue();
         } else if (fieldName == "$nExtents") {
             if (e.type() == Array) {
                 BSONObjIterator j(e.Obj());
@@ -286,6 +292,9 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
 
         if (cappedMaxDocs)
             builder->appendNumber("max", cappedMaxDocs);
+
+        if (cappedRelaxedOrder)
+            builder->appendBool("cappedRelaxedOrder", true);
     }
 
     if (initialNumExtents)
@@ -353,6 +362,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (cappedRelaxedOrder != other.cappedRelaxedOrder) {
+        return false;
+    }
+
     if (initialNumExtents != other.initialNumExtents) {
         return false;
     }
@@ -102,6 +102,12 @@ struct CollectionOptions {
     long long cappedSize = 0;
     long long cappedMaxDocs = 0;
 
+    // For capped collections only: opts out of the strict insert-order visibility guarantee so
+    // that inserts into the collection are not serialized. Intended for high-throughput buffer
+    // collections where exact insertion order (and, on replica sets, which documents fall off
+    // the cap first on each node) does not matter.
+    bool cappedRelaxedOrder = false;
+
     // (MMAPv1) The following 2 are mutually exclusive, can only have one set.
     long long initialNumExtents = 0;
     std::vector<long long> initialExtentSizes;
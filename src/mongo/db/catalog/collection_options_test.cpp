@@ -95,6 +95,24 @@ TEST(CollectionOptions, ErrorBadMax) {
     ASSERT_NOT_OK(CollectionOptions().parse(BSON("capped" << true << "max" << (1LL << 31))));
 }
 
+TEST(CollectionOptions, CappedRelaxedOrderRoundTrip) {
+    CollectionOptions options;
+    ASSERT_OK(options.parse(
+        fromjson("{capped: true, size: 1024, cappedRelaxedOrder: true}")));
+    ASSERT_EQUALS(options.capped, true);
+    ASSERT_EQUALS(options.cappedRelaxedOrder, true);
+
+    CollectionOptions roundTripped;
+    ASSERT_OK(roundTripped.parse(options.toBSON()));
+    ASSERT_EQUALS(roundTripped.cappedRelaxedOrder, true);
+}
+
+TEST(CollectionOptions, ErrorCappedRelaxedOrderOnNonCapped) {
+    ASSERT_NOT_OK(CollectionOptions().parse(fromjson("{cappedRelaxedOrder: true}")));
+    ASSERT_NOT_OK(
+        CollectionOptions().parse(fromjson("{capped: false, cappedRelaxedOrder: true}")));
+}
+
 TEST(CollectionOptions, CappedSizeRoundsUpForAlignment) {
     const long long kUnalignedCappedSize = 1000;
     const long long kAlignedCappedSize = 1024;
@@ -40,6 +40,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 
@@ -185,6 +186,66 @@ TEST_F(CollectionTest, CappedNotifierWaitUntilAsynchronousKill) {
     ASSERT_EQ(notifier->getVersion(), prevVersion);
 }
 
+TEST_F(CollectionTest, CappedNotifierFilteredWaiterIgnoresLowerTimestampInserts) {
+    NamespaceString nss("test.t");
+    makeCapped(nss);
+
+    AutoGetCollectionForRead acfr(_opCtx, nss);
+    Collection* col = acfr.getCollection();
+    auto notifier = col->getCappedInsertNotifier();
+    auto prevVersion = notifier->getVersion();
+
+    auto before = Date_t::now();
+    stdx::thread thread([&notifier] {
+        // This insert is below the waiter's minimum timestamp, so it must not wake it.
+        notifier->notifyInsert(Timestamp(1, 1));
+    });
+    notifier->waitUntil(prevVersion, before + Milliseconds(25), Timestamp(1, 2));
+    auto after = Date_t::now();
+    ASSERT_GTE(after - before, Milliseconds(25));
+    thread.join();
+}
+
+TEST_F(CollectionTest, CappedNotifierFilteredWaiterWokenBySatisfyingInsert) {
+    NamespaceString nss("test.t");
+    makeCapped(nss);
+
+    AutoGetCollectionForRead acfr(_opCtx, nss);
+    Collection* col = acfr.getCollection();
+    auto notifier = col->getCappedInsertNotifier();
+    auto prevVersion = notifier->getVersion();
+
+    auto before = Date_t::now();
+    stdx::thread thread([&notifier] {
+        sleepmillis(25);
+        notifier->notifyInsert(Timestamp(1, 2));
+    });
+    notifier->waitUntil(prevVersion, before + Seconds(25), Timestamp(1, 2));
+    auto after = Date_t::now();
+    ASSERT_LT(after - before, Seconds(25));
+    thread.join();
+}
+
+TEST_F(CollectionTest, CappedNotifierKillWakesFilteredWaiter) {
+    NamespaceString nss("test.t");
+    makeCapped(nss);
+
+    AutoGetCollectionForRead acfr(_opCtx, nss);
+    Collection* col = acfr.getCollection();
+    auto notifier = col->getCappedInsertNotifier();
+    auto prevVersion = notifier->getVersion();
+
+    auto before = Date_t::now();
+    stdx::thread thread([&notifier] {
+        sleepmillis(25);
+        notifier->kill();
+    });
+    notifier->waitUntil(prevVersion, before + Seconds(25), Timestamp(1, 2));
+    auto after = Date_t::now();
+    ASSERT_LT(after - before, Seconds(25));
+    thread.join();
+}
+
 TEST_F(CollectionTest, HaveCappedWaiters) {
     NamespaceString nss("test.t");
     makeCapped(nss);
@@ -80,7 +80,10 @@ public:
 
         virtual bool isDropPending(OperationContext* opCtx) const = 0;
 
-        virtual void getStats(OperationContext* opCtx, BSONObjBuilder* output, double scale) = 0;
+        virtual void getStats(OperationContext* opCtx,
+                              BSONObjBuilder* output,
+                              double scale,
+                              bool exact) = 0;
 
         virtual const DatabaseCatalogEntry* getDatabaseCatalogEntry() const = 0;
 
@@ -267,8 +270,9 @@ public:
 
     inline void getStats(OperationContext* const opCtx,
                          BSONObjBuilder* const output,
-                         const double scale = 1) {
-        return this->_impl().getStats(opCtx, output, scale);
+                         const double scale = 1,
+                         const bool exact = false) {
+        return this->_impl().getStats(opCtx, output, scale, exact);
     }
 
     inline const DatabaseCatalogEntry* getDatabaseCatalogEntry() const {
@@ -63,6 +63,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/storage_stats_cache.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_engine.h"
@@ -369,10 +370,15 @@ bool DatabaseImpl::isDropPending(OperationContext* opCtx) const {
     return _dropPending;
 }
 
-void DatabaseImpl::getStats(OperationContext* opCtx, BSONObjBuilder* output, double scale) {
+void DatabaseImpl::getStats(OperationContext* opCtx,
+                            BSONObjBuilder* output,
+                            double scale,
+                            bool exact) {
     list<string> collections;
     _dbEntry->getCollectionNamespaces(&collections);
 
+    StorageStatsCache& statsCache = StorageStatsCache::get(opCtx->getServiceContext());
+
     long long nCollections = 0;
     long long nViews = 0;
     long long objects = 0;
@@ -394,12 +400,25 @@ void DatabaseImpl::getStats(OperationContext* opCtx, BSONObjBuilder* output, dou
         objects += collection->numRecords(opCtx);
         size += collection->dataSize(opCtx);
 
-        BSONObjBuilder temp;
-        storageSize += collection->getRecordStore()->storageSize(opCtx, &temp);
-        numExtents += temp.obj()["numExtents"].numberInt();  // XXX
-
         indexes += collection->getIndexCatalog()->numIndexesTotal(opCtx);
-        indexSize += collection->getIndexSize(opCtx);
+
+        // Storage size and index size require a storage engine walk per collection; unless the
+        // caller asked for exact values, serve them from the snapshot maintained by the storage
+        // stats sampler.
+        boost::optional<StorageStatsCache::Snapshot> snapshot;
+        if (!exact)
+            snapshot = statsCache.lookup(ns);
+
+        if (snapshot) {
+            storageSize += snapshot->storageSize;
+            indexSize += snapshot->indexSize;
+        } else {
+            BSONObjBuilder temp;
+            storageSize += collection->getRecordStore()->storageSize(opCtx, &temp);
+            numExtents += temp.obj()["numExtents"].numberInt();  // XXX
+
+            indexSize += collection->getIndexSize(opCtx);
+        }
     }
 
     getViewCatalog()->iterate(opCtx, [&](const ViewDefinition& view) { nViews += 1; });
@@ -153,7 +153,10 @@ public:
 
     bool isDropPending(OperationContext* opCtx) const final;
 
-    void getStats(OperationContext* opCtx, BSONObjBuilder* output, double scale = 1) final;
+    void getStats(OperationContext* opCtx,
+                  BSONObjBuilder* output,
+                  double scale = 1,
+                  bool exact = false) final;
 
     const DatabaseCatalogEntry* getDatabaseCatalogEntry() const final;
 
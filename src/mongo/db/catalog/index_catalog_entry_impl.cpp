@@ -197,8 +197,9 @@ bool IndexCatalogEntryImpl::isMultikey(OperationContext* opCtx) const {
         return false;
     }
 
+    const NamespaceString nss(_ns);
     for (const MultikeyPathInfo& path : txnParticipant->getMultikeyPathInfo()) {
-        if (path.nss == NamespaceString(_ns) && path.indexName == _descriptor->indexName()) {
+        if (path.nss == nss && path.indexName == _descriptor->indexName()) {
             return true;
         }
     }
@@ -215,8 +216,9 @@ MultikeyPaths IndexCatalogEntryImpl::getMultikeyPaths(OperationContext* opCtx) c
     }
 
     MultikeyPaths ret = _indexMultikeyPaths;
+    const NamespaceString nss(_ns);
     for (const MultikeyPathInfo& path : txnParticipant->getMultikeyPathInfo()) {
-        if (path.nss == NamespaceString(_ns) && path.indexName == _descriptor->indexName()) {
+        if (path.nss == nss && path.indexName == _descriptor->indexName()) {
             MultikeyPathTracker::mergeMultikeyPaths(&ret, path.multikeyPaths);
         }
     }
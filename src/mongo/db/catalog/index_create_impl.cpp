@@ -74,6 +74,11 @@ MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildOf);
 
 AtomicInt32 maxIndexBuildMemoryUsageMegabytes(500);
 
+// When set to a non-zero value, a background index build sleeps this long after every batch of
+// scanned documents, limiting how hard the build competes with foreground traffic for tickets
+// and IO. Zero (the default) disables the throttle.
+AtomicInt32 backgroundIndexBuildThrottleMillis(0);
+
 MONGO_REGISTER_SHIM(MultiIndexBlock::makeImpl)
 (OperationContext* const opCtx, Collection* const collection, PrivateTo<MultiIndexBlock>)
     ->std::unique_ptr<MultiIndexBlock::Impl> {
@@ -101,6 +106,26 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+class ExportedBackgroundIndexBuildThrottleParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedBackgroundIndexBuildThrottleParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "backgroundIndexBuildThrottleMillis",
+              &backgroundIndexBuildThrottleMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "backgroundIndexBuildThrottleMillis must be greater than or equal to 0");
+        }
+
+        return Status::OK();
+    }
+
+} exportedBackgroundIndexBuildThrottleParameter;
+
 
 /**
  * On rollback sets MultiIndexBlockImpl::_needToCleanup to true.
@@ -416,6 +441,18 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
             progress->hit();
             n++;
             retries = 0;
+
+            // Apply the optional throttle once per batch of documents, so an administrator can
+            // pace a background build instead of letting it compete at full speed with
+            // foreground traffic for tickets and IO. The sleep is interruptible, so a throttled
+            // build can still be killed promptly.
+            const size_t kThrottleBatchSize = 128;
+            if (_buildInBackground && (n % kThrottleBatchSize == 0)) {
+                const auto throttleMillis = backgroundIndexBuildThrottleMillis.load();
+                if (throttleMillis > 0) {
+                    _opCtx->sleepFor(Milliseconds(throttleMillis));
+                }
+            }
         } catch (const WriteConflictException&) {
             CurOp::get(_opCtx)->debug().additiveMetrics.incrementWriteConflicts(1);
             retries++;  // logAndBackoff expects this to be 1 on first call.
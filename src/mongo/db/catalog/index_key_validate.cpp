@@ -80,6 +80,7 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kDropDuplicatesFieldName,
     IndexDescriptor::kExpireAfterSecondsFieldName,
     IndexDescriptor::kGeoHaystackBucketSize,
+    IndexDescriptor::kHashVersionFieldName,
     IndexDescriptor::kIndexNameFieldName,
     IndexDescriptor::kIndexVersionFieldName,
     IndexDescriptor::kKeyPatternFieldName,
@@ -438,6 +439,30 @@ StatusWith<BSONObj> validateIndexSpec(
                 return ex.toStatus(str::stream() << "Failed to parse: "
                                                  << IndexDescriptor::kPathProjectionFieldName);
             }
+        } else if (IndexDescriptor::kHashVersionFieldName == indexSpecElemFieldName) {
+            const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+            if (IndexNames::findPluginName(key) != IndexNames::HASHED) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' is only allowed in a '"
+                                      << IndexNames::HASHED
+                                      << "' index"};
+            }
+
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' must be a number, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+
+            const auto hashVersion = representAs<int>(indexSpecElem.number());
+            if (!hashVersion || (*hashVersion != 0 && *hashVersion != 1)) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' must be 0 or 1, but got "
+                                      << indexSpecElem.toString(false, false)};
+            }
         } else {
             // We can assume field name is valid at this point. Validation of fieldname is handled
             // prior to this in validateIndexSpecFieldNames().
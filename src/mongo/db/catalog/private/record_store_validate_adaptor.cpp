@@ -78,22 +78,38 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
         return status;
     }
 
-    IndexCatalog::IndexIterator i = _indexCatalog->getIndexIterator(_opCtx, false);
+    // Resolve the per-index state once per validation run rather than once per record; on large
+    // collections the iterator construction, namespace strings and map lookups below dominate
+    // the per-record cost otherwise.
+    if (_indexInfos.empty()) {
+        IndexCatalog::IndexIterator i = _indexCatalog->getIndexIterator(_opCtx, false);
+        while (i.more()) {
+            const IndexDescriptor* descriptor = i.next();
+            std::string indexNs = descriptor->indexNamespace();
+            const int indexNumber = _indexConsistency->getIndexNumber(indexNs);
+            const MatchExpression* filterExpression = descriptor->isPartial()
+                ? _indexCatalog->getEntry(descriptor)->getFilterExpression()
+                : nullptr;
+            _indexInfos.push_back({descriptor,
+                                   _indexCatalog->getIndex(descriptor),
+                                   std::move(indexNs),
+                                   indexNumber,
+                                   Ordering::make(descriptor->keyPattern()),
+                                   filterExpression});
+        }
+    }
 
-    while (i.more()) {
-        const IndexDescriptor* descriptor = i.next();
-        const std::string indexNs = descriptor->indexNamespace();
-        int indexNumber = _indexConsistency->getIndexNumber(indexNs);
+    for (const auto& indexInfo : _indexInfos) {
+        const IndexDescriptor* descriptor = indexInfo.descriptor;
+        const std::string& indexNs = indexInfo.indexNs;
+        const int indexNumber = indexInfo.indexNumber;
         ValidateResults curRecordResults;
 
-        const IndexAccessMethod* iam = _indexCatalog->getIndex(descriptor);
+        const IndexAccessMethod* iam = indexInfo.iam;
 
-        if (descriptor->isPartial()) {
-            const IndexCatalogEntry* ice = _indexCatalog->getEntry(descriptor);
-            if (!ice->getFilterExpression()->matchesBSON(recordBson)) {
-                (*_indexNsResultsMap)[indexNs] = curRecordResults;
-                continue;
-            }
+        if (indexInfo.filterExpression && !indexInfo.filterExpression->matchesBSON(recordBson)) {
+            (*_indexNsResultsMap)[indexNs] = curRecordResults;
+            continue;
         }
 
         BSONObjSet documentKeySet = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
@@ -119,8 +135,7 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
                                                        indexNumber);
         }
 
-        const auto& pattern = descriptor->keyPattern();
-        const Ordering ord = Ordering::make(pattern);
+        const Ordering& ord = indexInfo.ordering;
         bool largeKeyDisallowed = isLargeKeyDisallowed();
 
         for (const auto& key : documentKeySet) {
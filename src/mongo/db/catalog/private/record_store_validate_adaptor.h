@@ -28,6 +28,10 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
+#include "mongo/bson/ordering.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/index/index_access_method.h"
@@ -38,6 +42,7 @@
 namespace mongo {
 
 class IndexConsistency;
+class MatchExpression;
 
 namespace {
 
@@ -92,10 +97,27 @@ public:
     void validateIndexKeyCount(IndexDescriptor* idx, int64_t numRecs, ValidateResults& results);
 
 private:
+    /**
+     * Per-index information resolved once per validation run instead of once per record. The
+     * index catalog cannot change underneath a validation, which holds the collection lock in a
+     * mode that conflicts with index creation and drops.
+     */
+    struct IndexInfo {
+        const IndexDescriptor* descriptor;   // Not owned.
+        const IndexAccessMethod* iam;        // Not owned.
+        std::string indexNs;
+        int indexNumber;
+        Ordering ordering;
+        const MatchExpression* filterExpression;  // Not owned. Null for non-partial indexes.
+    };
+
     OperationContext* _opCtx;             // Not owned.
     IndexConsistency* _indexConsistency;  // Not owned.
     ValidateCmdLevel _level;
     IndexCatalog* _indexCatalog;             // Not owned.
     ValidateResultsMap* _indexNsResultsMap;  // Not owned.
+
+    // Lazily populated on the first record validated.
+    std::vector<IndexInfo> _indexInfos;
 };
 }  // namespace
@@ -31,6 +31,8 @@
 
 #include "uuid_catalog.h"
 
+#include <memory>
+
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/storage/recovery_unit.h"
@@ -133,6 +135,7 @@ void UUIDCatalog::onCreateCollection(OperationContext* opCtx,
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
     _removeUUIDCatalogEntry_inlock(uuid);  // Remove UUID if it exists
     _registerUUIDCatalogEntry_inlock(uuid, coll);
+    _publishSnapshot_inlock();
     opCtx->recoveryUnit()->onRollback([this, uuid] { removeUUIDCatalogEntry(uuid); });
 }
 
@@ -168,6 +171,7 @@ void UUIDCatalog::onCloseCatalog(OperationContext* opCtx) {
     _shadowCatalog.emplace();
     for (auto entry : _catalog)
         _shadowCatalog->insert({entry.first, entry.second->ns()});
+    _publishSnapshot_inlock();
 }
 
 void UUIDCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -175,26 +179,32 @@ void UUIDCatalog::onOpenCatalog(OperationContext* opCtx) {
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
     invariant(_shadowCatalog);
     _shadowCatalog.reset();
+    _publishSnapshot_inlock();
 }
 
 Collection* UUIDCatalog::lookupCollectionByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<stdx::mutex> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    return foundIt == _catalog.end() ? nullptr : foundIt->second;
+    // Lock-free: probe the published snapshot instead of taking _catalogLock. This runs on
+    // every operation's collection resolution, so it must not contend with writers.
+    auto snapshot = std::atomic_load(&_snapshot);
+    auto foundIt = snapshot->catalog.find(uuid);
+    return foundIt == snapshot->catalog.end() ? nullptr : foundIt->second.collection;
 }
 
 NamespaceString UUIDCatalog::lookupNSSByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<stdx::mutex> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end())
-        return foundIt->second->ns();
+    auto snapshot = std::atomic_load(&_snapshot);
+    auto foundIt = snapshot->catalog.find(uuid);
+    // Return the namespace copied into the snapshot entry rather than Collection::ns(): this
+    // lookup runs without locks, and the Collection object may already have been deleted by a
+    // drop that committed after this snapshot was published.
+    if (foundIt != snapshot->catalog.end())
+        return foundIt->second.nss;
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
     // using the pre-close state. This ensures that any tasks reloading the catalog can see their
     // own updates.
-    if (_shadowCatalog) {
-        auto shadowIt = _shadowCatalog->find(uuid);
-        if (shadowIt != _shadowCatalog->end())
+    if (snapshot->shadowCatalog) {
+        auto shadowIt = snapshot->shadowCatalog->find(uuid);
+        if (shadowIt != snapshot->shadowCatalog->end())
             return shadowIt->second;
     }
     return NamespaceString();
@@ -206,16 +216,20 @@ Collection* UUIDCatalog::replaceUUIDCatalogEntry(CollectionUUID uuid, Collection
     Collection* oldColl = _removeUUIDCatalogEntry_inlock(uuid);
     invariant(oldColl != nullptr);  // Need to replace an existing coll
     _registerUUIDCatalogEntry_inlock(uuid, coll);
+    _publishSnapshot_inlock();
     return oldColl;
 }
 void UUIDCatalog::registerUUIDCatalogEntry(CollectionUUID uuid, Collection* coll) {
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
     _registerUUIDCatalogEntry_inlock(uuid, coll);
+    _publishSnapshot_inlock();
 }
 
 Collection* UUIDCatalog::removeUUIDCatalogEntry(CollectionUUID uuid) {
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
-    return _removeUUIDCatalogEntry_inlock(uuid);
+    auto foundColl = _removeUUIDCatalogEntry_inlock(uuid);
+    _publishSnapshot_inlock();
+    return foundColl;
 }
 
 boost::optional<CollectionUUID> UUIDCatalog::prev(const StringData& db, CollectionUUID uuid) {
@@ -288,4 +302,19 @@ Collection* UUIDCatalog::_removeUUIDCatalogEntry_inlock(CollectionUUID uuid) {
     _catalog.erase(foundIt);
     return foundCol;
 }
+
+void UUIDCatalog::_publishSnapshot_inlock() {
+    // Copy-on-write: readers holding the previous snapshot continue to use it; new readers see
+    // this one. Catalog changes are DDL-frequency events, so the copy is cheap relative to the
+    // mutex acquisitions it saves on every lookup.
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->catalog.reserve(_catalog.size());
+    for (const auto& entry : _catalog) {
+        // Dereferencing the Collection* here is safe: it is still registered, so the drop that
+        // would delete it has not yet removed it under _catalogLock.
+        snapshot->catalog[entry.first] = {entry.second, entry.second->ns()};
+    }
+    snapshot->shadowCatalog = _shadowCatalog;
+    std::atomic_store(&_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
 }  // namespace mongo
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 
 #include "mongo/base/disallow_copying.h"
@@ -213,12 +214,47 @@ public:
     boost::optional<CollectionUUID> next(const StringData& db, CollectionUUID uuid);
 
 private:
+    /**
+     * An immutable view of the catalog contents, shared with readers. Writers build a new
+     * Snapshot under _catalogLock and publish it atomically, so lookups by UUID never take the
+     * catalog mutex: they load the current snapshot and probe it, and the shared_ptr keeps the
+     * snapshot they are reading alive even if a writer publishes a newer one concurrently.
+     *
+     * The shared_ptr only keeps the maps alive, not the Collection objects the entries point
+     * to: a dropped Collection is deleted at WUOW commit regardless of stale snapshots still
+     * referencing it. Each entry therefore carries a copy of the namespace so that
+     * lookupNSSByUUID, which runs without any locks, never dereferences the Collection*; only
+     * lookupCollectionByUUID returns the pointer, and its callers must hold locks that keep
+     * the collection alive.
+     */
+    struct SnapshotEntry {
+        Collection* collection;
+        NamespaceString nss;
+    };
+    struct Snapshot {
+        mongo::stdx::unordered_map<CollectionUUID, SnapshotEntry, CollectionUUID::Hash> catalog;
+        boost::optional<
+            mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
+            shadowCatalog;
+    };
+
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
                                                            const stdx::lock_guard<stdx::mutex>&);
     void _registerUUIDCatalogEntry_inlock(CollectionUUID uuid, Collection* coll);
     Collection* _removeUUIDCatalogEntry_inlock(CollectionUUID uuid);
 
+    /**
+     * Copies the current catalog contents (and shadow catalog, if set) into a fresh Snapshot
+     * and publishes it for readers. Must be called before releasing _catalogLock whenever the
+     * catalog or shadow catalog changed.
+     */
+    void _publishSnapshot_inlock();
+
     mutable mongo::stdx::mutex _catalogLock;
+
+    // Current published snapshot. Read with std::atomic_load, written with std::atomic_store
+    // while holding _catalogLock.
+    std::shared_ptr<const Snapshot> _snapshot = std::make_shared<Snapshot>();
     /**
      * When present, indicates that the catalog is in closed state, and contains a map from UUID
      * to pre-close NSS. See also onCloseCatalog.
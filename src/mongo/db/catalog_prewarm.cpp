@@ -0,0 +1,150 @@
+// catalog_prewarm.cpp
+
+/**
+*    Copyright (C) 2018 MongoDB Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog_prewarm.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/util/background.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/stringutils.h"
+
+namespace mongo {
+
+// Comma-separated list of database name or namespace prefixes. Databases that can contain a
+// namespace matching one of the prefixes are opened by a background job at startup, so their
+// first operation after a restart does not pay for loading the catalog and initializing index
+// metadata. Empty (the default) disables prewarming.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(catalogPrewarmPrefixes, std::string, "");
+
+namespace {
+
+/**
+ * Returns whether database 'dbName' can contain a namespace starting with 'prefix'. This is the
+ * case when the database name itself starts with the prefix (e.g. prefix "tenant" and database
+ * "tenantA"), or when the prefix extends past the database name into a collection name (e.g.
+ * prefix "tenantA.orders" and database "tenantA").
+ */
+bool databaseMatchesPrefix(const std::string& dbName, const std::string& prefix) {
+    return StringData(dbName).startsWith(prefix) || StringData(prefix).startsWith(dbName + ".");
+}
+}  // namespace
+
+class CatalogPrewarmer : public BackgroundJob {
+public:
+    CatalogPrewarmer() {}
+    virtual ~CatalogPrewarmer() {}
+
+    virtual std::string name() const {
+        return "CatalogPrewarmer";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+
+        std::vector<std::string> prefixes;
+        splitStringDelim(catalogPrewarmPrefixes, &prefixes, ',');
+
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+
+        std::vector<std::string> dbNames;
+        {
+            Lock::GlobalLock lk(&opCtx, MODE_IS);
+            getGlobalServiceContext()->getStorageEngine()->listDatabases(&dbNames);
+        }
+
+        for (const std::string& dbName : dbNames) {
+            if (globalInShutdownDeprecated())
+                break;
+
+            bool matches = false;
+            for (const std::string& prefix : prefixes) {
+                if (!prefix.empty() && databaseMatchesPrefix(dbName, prefix)) {
+                    matches = true;
+                    break;
+                }
+            }
+
+            if (!matches)
+                continue;
+
+            // Opening a database instantiates a Collection object, with an initialized index
+            // catalog, for every collection in it, and the DatabaseHolder keeps them alive
+            // until the database is closed again. A single openDb call therefore both builds
+            // and pins all the metadata we want warm. Failures are logged and otherwise
+            // ignored: prewarming is best-effort and the regular operation paths load any
+            // database we could not open here.
+            try {
+                Lock::DBLock dbLock(&opCtx, dbName, MODE_X);
+                DatabaseHolder::getDatabaseHolder().openDb(&opCtx, dbName);
+                LOG(1) << "prewarmed catalog for database " << dbName;
+            } catch (const DBException& ex) {
+                warning() << "catalog prewarm of database " << dbName << " failed"
+                          << causedBy(redact(ex.toStatus()));
+            }
+        }
+
+        LOG(1) << "catalog prewarm pass complete";
+    }
+};
+
+namespace {
+// The global CatalogPrewarmer object is intentionally leaked.  Even though it is only used in
+// one function, we declare it here to indicate to the leak sanitizer that the leak of this
+// object should not be reported.
+CatalogPrewarmer* catalogPrewarmer = nullptr;
+}  // namespace
+
+void startCatalogPrewarmBackgroundJob() {
+    if (catalogPrewarmPrefixes.empty())
+        return;
+
+    catalogPrewarmer = new CatalogPrewarmer();
+    catalogPrewarmer->go();
+}
+}  // namespace mongo
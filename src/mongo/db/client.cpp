@@ -127,11 +127,13 @@ void Client::setOperationContext(OperationContext* opCtx) {
     // We can only set the OperationContext once before resetting it.
     invariant(opCtx != NULL && _opCtx == NULL);
     _opCtx = opCtx;
+    _hasOpCtx.store(true);
 }
 
 void Client::resetOperationContext() {
     invariant(_opCtx != NULL);
     _opCtx = NULL;
+    _hasOpCtx.store(false);
 }
 
 std::string Client::clientAddress(bool includePort) const {
@@ -42,6 +42,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/random.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/session.h"
@@ -197,6 +198,16 @@ public:
         return _opCtx;
     }
 
+    /**
+     * Lock-free check for whether an operation context is active on this client. May be called
+     * on an unlocked client, making it suitable for scans that only want to skip idle clients
+     * without serializing on each one. The answer may be stale by the time it is used; callers
+     * that need the context itself must lock the client and call getOperationContext().
+     */
+    bool hasActiveOperationContext() const {
+        return _hasOpCtx.loadRelaxed();
+    }
+
     // TODO(spencer): SERVER-10228 SERVER-14779 Remove this/move it fully into OperationContext.
     bool isInDirectClient() const {
         return _inDirectClient;
@@ -240,6 +251,9 @@ private:
     // If != NULL, then contains the currently active OperationContext
     OperationContext* _opCtx = nullptr;
 
+    // Mirrors (_opCtx != nullptr) for readers that do not hold the client lock.
+    AtomicBool _hasOpCtx{false};
+
     PseudoRandom _prng;
 };
 
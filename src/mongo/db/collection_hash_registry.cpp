@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/collection_hash_registry.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/util/md5.hpp"
+
+namespace mongo {
+
+namespace {
+
+// Set this to maintain an order-independent per-collection content hash on every write, letting
+// the dbHash command answer from the maintained value instead of scanning the collection.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(enableIncrementalDbHash, bool, false);
+
+const auto getCollectionHashRegistry = ServiceContext::declareDecoration<CollectionHashRegistry>();
+
+}  // namespace
+
+std::string CollectionHashRegistry::Hash::toHexString() const {
+    md5digest digest;
+    std::copy(bytes.begin(), bytes.end(), digest);
+    return digestToString(digest);
+}
+
+CollectionHashRegistry& CollectionHashRegistry::get(ServiceContext* service) {
+    return getCollectionHashRegistry(service);
+}
+
+bool CollectionHashRegistry::isEnabled() {
+    return enableIncrementalDbHash;
+}
+
+CollectionHashRegistry::Hash CollectionHashRegistry::hashDocument(const BSONObj& doc) {
+    Hash hash;
+    md5digest digest;
+    md5(doc.objdata(), doc.objsize(), digest);
+    std::copy(digest, digest + sizeof(digest), hash.bytes.begin());
+    return hash;
+}
+
+void CollectionHashRegistry::seed(const UUID& uuid, const Hash& hash) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _entries[uuid] = hash;
+}
+
+boost::optional<CollectionHashRegistry::Hash> CollectionHashRegistry::lookup(
+    const UUID& uuid) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _entries.find(uuid);
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void CollectionHashRegistry::invalidate(const UUID& uuid) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _entries.erase(uuid);
+}
+
+void CollectionHashRegistry::invalidateAll() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _entries.clear();
+}
+
+void CollectionHashRegistry::onInsert(OperationContext* opCtx,
+                                      const UUID& uuid,
+                                      const BSONObj& doc) {
+    if (!_isTracked(uuid)) {
+        return;
+    }
+    _scheduleDelta(opCtx, uuid, hashDocument(doc));
+}
+
+void CollectionHashRegistry::onUpdate(OperationContext* opCtx,
+                                      const UUID& uuid,
+                                      const boost::optional<BSONObj>& preImage,
+                                      const BSONObj& postImage) {
+    if (!_isTracked(uuid)) {
+        return;
+    }
+    if (!preImage) {
+        // Without the old document's digest the hash cannot be kept current; discard it once
+        // the write commits so the next dbHash reseeds with a scan.
+        auto service = opCtx->getServiceContext();
+        opCtx->recoveryUnit()->onCommit([service, uuid](boost::optional<Timestamp>) {
+            CollectionHashRegistry::get(service).invalidate(uuid);
+        });
+        return;
+    }
+    auto delta = hashDocument(*preImage);
+    delta.xorWith(hashDocument(postImage));
+    _scheduleDelta(opCtx, uuid, delta);
+}
+
+void CollectionHashRegistry::onDelete(OperationContext* opCtx,
+                                      const UUID& uuid,
+                                      const Hash& docHash) {
+    if (!_isTracked(uuid)) {
+        return;
+    }
+    _scheduleDelta(opCtx, uuid, docHash);
+}
+
+bool CollectionHashRegistry::_isTracked(const UUID& uuid) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _entries.count(uuid) > 0;
+}
+
+void CollectionHashRegistry::_scheduleDelta(OperationContext* opCtx,
+                                            const UUID& uuid,
+                                            const Hash& delta) {
+    auto service = opCtx->getServiceContext();
+    opCtx->recoveryUnit()->onCommit([service, uuid, delta](boost::optional<Timestamp>) {
+        CollectionHashRegistry::get(service)._applyDelta(uuid, delta);
+    });
+}
+
+void CollectionHashRegistry::_applyDelta(const UUID& uuid, const Hash& delta) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _entries.find(uuid);
+    if (it == _entries.end()) {
+        // Invalidated between the write and its commit.
+        return;
+    }
+    it->second.xorWith(delta);
+}
+
+}  // namespace mongo
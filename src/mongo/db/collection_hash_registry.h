@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * An incrementally maintained, order-independent content hash for each collection, used by the
+ * dbHash command to answer consistency checks without rescanning.
+ *
+ * The hash of a collection is the bitwise XOR of the MD5 digests of its documents, so it does
+ * not depend on scan order and composes under writes: an insert XORs the new document's digest
+ * in, a delete XORs the removed document's digest out, and an update XORs both images. Two
+ * collections holding the same documents therefore produce the same hash regardless of how or
+ * when it was computed.
+ *
+ * An entry exists only after the dbHash command has seeded it with a full scan. Writes that
+ * cannot be folded into the hash — updates whose preimage was not made available to the
+ * OpObserver — invalidate the entry so that the next dbHash reseeds it. All deltas are applied
+ * when the originating unit of work commits; aborted writes leave the hash untouched.
+ *
+ * Maintenance is off unless the enableIncrementalDbHash server parameter is set at startup.
+ */
+class CollectionHashRegistry {
+    MONGO_DISALLOW_COPYING(CollectionHashRegistry);
+
+public:
+    /**
+     * Order-independent 128-bit collection hash; XOR is both "add" and "remove".
+     */
+    struct Hash {
+        std::array<std::uint8_t, 16> bytes{};
+
+        void xorWith(const Hash& other) {
+            for (std::size_t i = 0; i < bytes.size(); i++) {
+                bytes[i] ^= other.bytes[i];
+            }
+        }
+
+        std::string toHexString() const;
+    };
+
+    CollectionHashRegistry() = default;
+
+    static CollectionHashRegistry& get(ServiceContext* service);
+
+    /**
+     * Returns true if the enableIncrementalDbHash startup parameter is set. When false, the
+     * registry is never consulted or updated.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns the MD5 digest of 'doc' as a Hash.
+     */
+    static Hash hashDocument(const BSONObj& doc);
+
+    /**
+     * Installs the full-scan hash for the collection with the given UUID, enabling incremental
+     * maintenance for it. The caller must guarantee that no writes to the collection can commit
+     * between the scan and the seed (the dbHash command holds the database lock in MODE_S).
+     */
+    void seed(const UUID& uuid, const Hash& hash);
+
+    /**
+     * Returns the maintained hash for the collection, or boost::none if it has never been
+     * seeded or has been invalidated.
+     */
+    boost::optional<Hash> lookup(const UUID& uuid) const;
+
+    /**
+     * Discards the entry for the collection (if any), forcing the next dbHash to reseed it.
+     * Also used when the collection is dropped.
+     */
+    void invalidate(const UUID& uuid);
+
+    /**
+     * Discards all entries, e.g. after replication rollback rewrites collection contents
+     * through paths the OpObserver cannot attribute document-by-document.
+     */
+    void invalidateAll();
+
+    /**
+     * Write hooks, called by the OpObserver inside the write's unit of work. Each folds the
+     * change into the collection's hash when the unit of work commits and is a no-op if the
+     * collection has no seeded entry. An update without a preimage invalidates the entry
+     * instead, since the old document's digest cannot be XORed out.
+     */
+    void onInsert(OperationContext* opCtx, const UUID& uuid, const BSONObj& doc);
+    void onUpdate(OperationContext* opCtx,
+                  const UUID& uuid,
+                  const boost::optional<BSONObj>& preImage,
+                  const BSONObj& postImage);
+    void onDelete(OperationContext* opCtx, const UUID& uuid, const Hash& docHash);
+
+private:
+    bool _isTracked(const UUID& uuid) const;
+
+    void _scheduleDelta(OperationContext* opCtx, const UUID& uuid, const Hash& delta);
+
+    void _applyDelta(const UUID& uuid, const Hash& delta);
+
+    mutable stdx::mutex _mutex;
+    stdx::unordered_map<UUID, Hash, UUID::Hash> _entries;  // (M)
+};
+
+}  // namespace mongo
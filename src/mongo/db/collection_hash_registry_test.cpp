@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/collection_hash_registry.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+using Hash = CollectionHashRegistry::Hash;
+
+TEST(CollectionHashRegistryTest, HashDocumentIsDeterministic) {
+    auto doc = BSON("_id" << 1 << "x"
+                          << "abc");
+    ASSERT_EQUALS(CollectionHashRegistry::hashDocument(doc).toHexString(),
+                  CollectionHashRegistry::hashDocument(doc).toHexString());
+    ASSERT_NOT_EQUALS(CollectionHashRegistry::hashDocument(doc).toHexString(),
+                      CollectionHashRegistry::hashDocument(BSON("_id" << 2)).toHexString());
+}
+
+TEST(CollectionHashRegistryTest, XorIsOrderIndependentAndSelfInverse) {
+    auto docA = BSON("_id" << 1);
+    auto docB = BSON("_id" << 2);
+
+    Hash aThenB;
+    aThenB.xorWith(CollectionHashRegistry::hashDocument(docA));
+    aThenB.xorWith(CollectionHashRegistry::hashDocument(docB));
+
+    Hash bThenA;
+    bThenA.xorWith(CollectionHashRegistry::hashDocument(docB));
+    bThenA.xorWith(CollectionHashRegistry::hashDocument(docA));
+
+    ASSERT_EQUALS(aThenB.toHexString(), bThenA.toHexString());
+
+    // Removing a document undoes its insertion.
+    aThenB.xorWith(CollectionHashRegistry::hashDocument(docB));
+    Hash onlyA;
+    onlyA.xorWith(CollectionHashRegistry::hashDocument(docA));
+    ASSERT_EQUALS(onlyA.toHexString(), aThenB.toHexString());
+}
+
+TEST(CollectionHashRegistryTest, SeedLookupAndInvalidate) {
+    CollectionHashRegistry registry;
+    auto uuid = UUID::gen();
+
+    ASSERT_FALSE(registry.lookup(uuid));
+
+    Hash hash;
+    hash.xorWith(CollectionHashRegistry::hashDocument(BSON("_id" << 1)));
+    registry.seed(uuid, hash);
+
+    auto found = registry.lookup(uuid);
+    ASSERT_TRUE(found);
+    ASSERT_EQUALS(hash.toHexString(), found->toHexString());
+
+    ASSERT_FALSE(registry.lookup(UUID::gen()));
+
+    registry.invalidate(uuid);
+    ASSERT_FALSE(registry.lookup(uuid));
+}
+
+TEST(CollectionHashRegistryTest, InvalidateAllDiscardsEveryEntry) {
+    CollectionHashRegistry registry;
+    auto uuid1 = UUID::gen();
+    auto uuid2 = UUID::gen();
+    registry.seed(uuid1, Hash());
+    registry.seed(uuid2, Hash());
+    registry.invalidateAll();
+    ASSERT_FALSE(registry.lookup(uuid1));
+    ASSERT_FALSE(registry.lookup(uuid2));
+}
+
+}  // namespace
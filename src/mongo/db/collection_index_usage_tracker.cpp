@@ -31,6 +31,9 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/collection_index_usage_tracker.h"
+
+#include <boost/align/aligned_allocator.hpp>
+
 #include "mongo/util/assert_util.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/log.h"
@@ -44,17 +47,27 @@ CollectionIndexUsageTracker::CollectionIndexUsageTracker(ClockSource* clockSourc
 
 void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
     invariant(!indexName.empty());
-    dassert(_indexUsageMap.find(indexName) != _indexUsageMap.end());
 
-    _indexUsageMap[indexName].accesses.fetchAndAdd(1);
+    auto it = _indexUsageMap.find(indexName);
+    dassert(it != _indexUsageMap.end());
+    if (it == _indexUsageMap.end()) {
+        // The index was concurrently dropped; normally the PlanExecutor would have been killed
+        // first, but be defensive rather than mutating the map on the hot path.
+        return;
+    }
+
+    it->second->accesses.fetchAndAdd(1);
 }
 
 void CollectionIndexUsageTracker::registerIndex(StringData indexName, const BSONObj& indexKey) {
     invariant(!indexName.empty());
     dassert(_indexUsageMap.find(indexName) == _indexUsageMap.end());
 
-    // Create map entry.
-    _indexUsageMap[indexName] = IndexUsageStats(_clockSource->now(), indexKey);
+    // Create map entry. The counter node gets its own cache-line-aligned allocation.
+    _indexUsageMap[indexName] = std::allocate_shared<AlignedIndexUsageStats>(
+        boost::alignment::aligned_allocator<AlignedIndexUsageStats>(),
+        _clockSource->now(),
+        indexKey);
 }
 
 void CollectionIndexUsageTracker::unregisterIndex(StringData indexName) {
@@ -64,7 +77,11 @@ void CollectionIndexUsageTracker::unregisterIndex(StringData indexName) {
 }
 
 CollectionIndexUsageMap CollectionIndexUsageTracker::getUsageStats() const {
-    return _indexUsageMap;
+    CollectionIndexUsageMap stats;
+    for (auto&& entry : _indexUsageMap) {
+        stats[entry.first] = *entry.second;
+    }
+    return stats;
 }
 
 }  // namespace mongo
@@ -28,12 +28,15 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -105,14 +108,21 @@ public:
     void unregisterIndex(StringData indexName);
 
     /**
-     * Get the current state of the usage statistics map. This map will only include indexes that
-     * exist at the time of calling. Must be called while holding the collection lock in any mode.
+     * Get a snapshot of the usage statistics map. This map will only include indexes that exist
+     * at the time of calling. Must be called while holding the collection lock in any mode.
      */
     StringMap<CollectionIndexUsageTracker::IndexUsageStats> getUsageStats() const;
 
 private:
-    // Map from index name to usage statistics.
-    StringMap<CollectionIndexUsageTracker::IndexUsageStats> _indexUsageMap;
+    // Each index's counter lives in its own cache-line-aligned heap allocation so that
+    // concurrent increments for different indexes never contend on the same line. The nodes are
+    // created and destroyed only at index registration/deregistration (DDL time, under
+    // exclusive collection lock); the hot path just finds the node and bumps its atomic.
+    using AlignedIndexUsageStats = CacheAligned<IndexUsageStats>;
+
+    // Map from index name to usage statistics. Only modified at DDL time; read concurrently by
+    // operations holding the collection lock in any mode.
+    StringMap<std::shared_ptr<AlignedIndexUsageStats>> _indexUsageMap;
 
     // Clock source. Used when the 'trackerStartTime' time for an IndexUsageStats object needs to
     // be set.
@@ -685,7 +685,9 @@ public:
                 CurOp::get(opCtx)->enter_inlock(dbname.c_str(), db->getProfilingLevel());
             }
 
-            db->getStats(opCtx, &result, scale);
+            // Storage and index sizes are normally served from the background sampler's
+            // snapshots; {exact: true} forces fresh storage engine walks for every collection.
+            db->getStats(opCtx, &result, scale, jsobj["exact"].trueValue());
         }
 
         return true;
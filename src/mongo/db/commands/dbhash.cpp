@@ -40,6 +40,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/collection_hash_registry.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -219,7 +220,9 @@ private:
 
         boost::optional<Lock::CollectionLock> collLock;
         auto txnParticipant = TransactionParticipant::get(opCtx);
-        if (txnParticipant && txnParticipant->inMultiDocumentTransaction()) {
+        const bool inMultiDocumentTransaction =
+            txnParticipant && txnParticipant->inMultiDocumentTransaction();
+        if (inMultiDocumentTransaction) {
             // When inside a multi-statement transaction, we are only holding the database lock in
             // intent mode. We need to also acquire the collection lock in intent mode to ensure
             // reading from the consistent snapshot doesn't overlap with any catalog operations on
@@ -244,6 +247,17 @@ private:
             invariant(opCtx->lockState()->isDbLockedForMode(db->name(), MODE_S));
         }
 
+        // With incremental hashing enabled, the per-collection hash is the order-independent
+        // XOR of per-document MD5s instead of an MD5 over the scan, so a value maintained by
+        // the CollectionHashRegistry and a value computed by scanning are interchangeable.
+        const bool useIncrementalHash = CollectionHashRegistry::isEnabled();
+        auto& collectionHashes = CollectionHashRegistry::get(opCtx->getServiceContext());
+        if (useIncrementalHash && collection->uuid()) {
+            if (auto hash = collectionHashes.lookup(*collection->uuid())) {
+                return hash->toHexString();
+            }
+        }
+
         IndexDescriptor* desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
@@ -267,13 +281,18 @@ private:
 
         md5_state_t st;
         md5_init(&st);
+        CollectionHashRegistry::Hash xorHash;
 
         long long n = 0;
         PlanExecutor::ExecState state;
         BSONObj c;
         verify(NULL != exec.get());
         while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, NULL))) {
-            md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+            if (useIncrementalHash) {
+                xorHash.xorWith(CollectionHashRegistry::hashDocument(c));
+            } else {
+                md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+            }
             n++;
         }
         if (PlanExecutor::IS_EOF != state) {
@@ -282,6 +301,17 @@ private:
                       "Plan executor error while running dbHash command: " +
                           WorkingSetCommon::toStatusString(c));
         }
+        if (useIncrementalHash) {
+            // Seed the registry so subsequent dbHash runs read the maintained value. Only the
+            // MODE_S path may seed: inside a transaction we read from a timestamp that may not
+            // reflect current contents, and capped collections delete old documents without
+            // notifying the OpObserver.
+            if (!inMultiDocumentTransaction && collection->uuid() && !collection->isCapped()) {
+                collectionHashes.seed(*collection->uuid(), xorHash);
+            }
+            return xorHash.toHexString();
+        }
+
         md5digest d;
         md5_finish(&st, d);
         std::string hash = digestToString(d);
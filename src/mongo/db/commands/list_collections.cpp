@@ -279,6 +279,12 @@ public:
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
         BSONArrayBuilder firstBatch;
         {
+            // This command only reads the catalog, which is not kept consistent with replication
+            // batch boundaries, so there is no need to stall behind the ParallelBatchWriterMode
+            // lock on secondaries while a batch is being applied.
+            ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+                opCtx->lockState());
+
             AutoGetDb autoDb(opCtx, dbname, MODE_IS);
             Database* db = autoDb.getDb();
 
@@ -109,6 +109,12 @@ public:
         }
         bool nameOnly = jsobj[kNameOnlyField].trueValue();
 
+        // This command only reads the catalog, which is not kept consistent with replication
+        // batch boundaries, so there is no need to stall behind the ParallelBatchWriterMode lock
+        // on secondaries while a batch is being applied.
+        ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+            opCtx->lockState());
+
         vector<string> dbNames;
         StorageEngine* storageEngine = getGlobalServiceContext()->getStorageEngine();
         {
@@ -425,6 +425,12 @@ Status listPlansOriginalFormat(std::unique_ptr<CanonicalQuery> cq,
     // Append whether or not the entry is active.
     bob->append("isActive", entry->isActive);
     bob->append("works", static_cast<long long>(entry->works));
+    bob->append("executions", static_cast<long long>(entry->executions));
+    // Stage-level stats from the most recent sampled production execution of the cached plan.
+    if (!entry->sampledPlanStats.isEmpty()) {
+        bob->append("sampledPlanStats", entry->sampledPlanStats);
+        bob->append("timeOfSampledPlanStats", entry->timeOfSampledPlanStats);
+    }
     return Status::OK();
 }
 }  // namespace
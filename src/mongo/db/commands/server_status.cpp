@@ -36,6 +36,9 @@
 #include "mongo/db/commands/server_status_internal.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/clock_source.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/ramlog.h"
@@ -119,7 +122,7 @@ public:
                 continue;
             }
 
-            section->appendSection(opCtx, elem, &result);
+            _appendSection(opCtx, section, elem, clock, &result);
             timeBuilder.appendNumber(
                 static_cast<string>(str::stream() << "after " << section->getSectionName()),
                 durationCount<Milliseconds>(clock->now() - runStart));
@@ -164,11 +167,64 @@ public:
     }
 
 private:
+    struct SectionCache {
+        stdx::mutex mutex;
+        Date_t generatedAt;
+        BSONObj contents;
+    };
+
+    /**
+     * Appends 'section' to 'result', serving it from cache when the section declares a
+     * freshness window and a sufficiently recent generation exists. Concurrent callers inside
+     * the window block on the section's cache mutex and then reuse the single generation, so
+     * several monitoring systems polling at once cost one generation per window.
+     */
+    void _appendSection(OperationContext* opCtx,
+                        ServerStatusSection* section,
+                        const BSONElement& configElement,
+                        ClockSource* clock,
+                        BSONObjBuilder* result) {
+        const auto window = section->cacheFreshnessWindow();
+
+        // Only plain inclusion is cacheable; a section handed a config object may produce
+        // output specific to that configuration.
+        const bool cacheable = window > Milliseconds(0) &&
+            (configElement.eoo() || configElement.isNumber() || configElement.isBoolean());
+        if (!cacheable) {
+            section->appendSection(opCtx, configElement, result);
+            return;
+        }
+
+        SectionCache* cache = [&] {
+            stdx::lock_guard<stdx::mutex> lk(_cachesMutex);
+            auto& entry = _caches[section];
+            if (!entry) {
+                entry = stdx::make_unique<SectionCache>();
+            }
+            return entry.get();
+        }();
+
+        stdx::lock_guard<stdx::mutex> lk(cache->mutex);
+        const auto now = clock->now();
+        if (cache->generatedAt == Date_t() || now - cache->generatedAt >= window) {
+            // Capture whatever the section appends (sections may write several top-level
+            // fields) so custom appendSection implementations are cacheable too.
+            BSONObjBuilder captured;
+            section->appendSection(opCtx, configElement, &captured);
+            cache->contents = captured.obj();
+            cache->generatedAt = now;
+        }
+        result->appendElements(cache->contents);
+    }
+
     const Date_t _started;
     bool _runCalled;
 
     typedef map<string, ServerStatusSection*> SectionMap;
     SectionMap _sections;
+
+    stdx::mutex _cachesMutex;
+    std::map<const ServerStatusSection*, std::unique_ptr<SectionCache>> _caches;
 };
 
 namespace {
@@ -34,6 +34,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
 #include <string>
 
 namespace mongo {
@@ -65,6 +66,16 @@ public:
      */
     virtual bool includeByDefault() const = 0;
 
+    /**
+     * The duration for which this section's generated output may be served from cache.
+     * Sections that are expensive to generate (e.g. those that walk storage engine statistics
+     * cursors) can return a non-zero window so repeated or concurrent serverStatus polls within
+     * it share a single generation. Returning zero (the default) disables caching.
+     */
+    virtual Milliseconds cacheFreshnessWindow() const {
+        return Milliseconds(0);
+    }
+
     /**
      * Adds the privileges that are required to view this section
      * TODO: Remove this empty default implementation and implement for every section.
@@ -63,8 +63,10 @@ const int kMaxStressThreads = 32;  // max number of threads to use for lock stre
  */
 class UseGlobalThrottling {
 public:
-    explicit UseGlobalThrottling(OperationContext* opCtx, int numTickets)
-        : _opCtx(opCtx), _holder(numTickets) {
+    explicit UseGlobalThrottling(OperationContext* opCtx,
+                                 int numTickets,
+                                 int reservedForInternal = 0)
+        : _opCtx(opCtx), _holder(numTickets, reservedForInternal) {
         _opCtx->lockState()->setGlobalThrottling(&_holder, &_holder);
     }
     ~UseGlobalThrottling() noexcept(false) {
@@ -1209,6 +1211,30 @@ TEST_F(DConcurrencyTestFixture, ReleaseAndReacquireTicket) {
     }
 }
 
+TEST_F(DConcurrencyTestFixture, ReservedTicketsAvailableToInternalOpsWhenSaturated) {
+    auto clientOpctxPairs = makeKClientsWithLockers(3);
+    auto opctx1 = clientOpctxPairs[0].second.get();
+    auto opctx2 = clientOpctxPairs[1].second.get();
+    auto opctx3 = clientOpctxPairs[2].second.get();
+    // Two tickets total, one of which is reserved for internal operations.
+    UseGlobalThrottling throttle(opctx1, 2, 1);
+
+    // The first user operation consumes the only unreserved ticket.
+    Lock::GlobalRead R1(opctx1, Date_t::now(), Lock::InterruptBehavior::kThrow);
+    ASSERT(R1.isLocked());
+
+    {
+        // A second user operation may not dip into the reserved ticket.
+        Lock::GlobalRead R2(opctx2, Date_t::now(), Lock::InterruptBehavior::kThrow);
+        ASSERT(!R2.isLocked());
+    }
+
+    // An internal operation can still make progress using the reserved ticket.
+    opctx3->lockState()->setUsesReservedTickets(true);
+    Lock::GlobalRead R3(opctx3, Date_t::now(), Lock::InterruptBehavior::kThrow);
+    ASSERT(R3.isLocked());
+}
+
 TEST_F(DConcurrencyTestFixture, LockerWithReleasedTicketCanBeUnlocked) {
     auto clientOpctxPairs = makeKClientsWithLockers(2);
     auto opctx1 = clientOpctxPairs[0].second.get();
@@ -29,11 +29,14 @@
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kWrite
 
 #include "mongo/db/concurrency/deferred_writer.h"
+#include "mongo/base/counter.h"
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
@@ -42,17 +45,60 @@ namespace mongo {
 
 namespace {
 auto kLogInterval = stdx::chrono::minutes(1);
+
+Counter64 deferredWritesBatches;
+ServerStatusMetricField<Counter64> displayDeferredWritesBatches("deferredWrites.batches",
+                                                               &deferredWritesBatches);
+
+Counter64 deferredWritesEntries;
+ServerStatusMetricField<Counter64> displayDeferredWritesEntries("deferredWrites.entries",
+                                                                &deferredWritesEntries);
+
+Counter64 deferredWritesDropped;
+ServerStatusMetricField<Counter64> displayDeferredWritesDropped("deferredWrites.dropped",
+                                                                &deferredWritesDropped);
+
+/**
+ * The thread pool shared by all DeferredWriter instances, started lazily so that writers which
+ * never receive an entry cost nothing.  Owned by the ServiceContext; the pool's destructor
+ * shuts it down and joins its threads.
+ */
+class SharedWriterPool {
+public:
+    ThreadPool* get() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (!_pool) {
+            ThreadPool::Options options;
+            options.poolName = "deferred writer pool";
+            options.threadNamePrefix = "DeferredWriter-";
+            options.minThreads = 0;
+            options.maxThreads = 2;
+            options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+            _pool = stdx::make_unique<ThreadPool>(options);
+            _pool->startup();
+        }
+        return _pool.get();
+    }
+
+private:
+    stdx::mutex _mutex;
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+const auto getSharedWriterPool = ServiceContext::declareDecoration<SharedWriterPool>();
 }
 
 void DeferredWriter::_logFailure(const Status& status) {
     if (TimePoint::clock::now() - _lastLogged > kLogInterval) {
-        log() << "Unable to write to collection " << _nss.toString() << ": " << status.toString();
+        log() << "Unable to write to collection " << _nss.toString() << " (" << _workerName
+              << "): " << status.toString();
         _lastLogged = stdx::chrono::system_clock::now();
     }
 }
 
 void DeferredWriter::_logDroppedEntry() {
     _droppedEntries += 1;
+    deferredWritesDropped.increment();
     if (TimePoint::clock::now() - _lastLoggedDrop > kLogInterval) {
         log() << "Deferred write buffer for " << _nss.toString() << " is full. " << _droppedEntries
               << " entries have been dropped.";
@@ -92,39 +138,70 @@ StatusWith<std::unique_ptr<AutoGetCollection>> DeferredWriter::_getCollection(
     return std::move(agc);
 }
 
-void DeferredWriter::_worker(InsertStatement stmt) {
+void DeferredWriter::_flush() {
     auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
     OperationContext* opCtx = uniqueOpCtx.get();
-    auto result = _getCollection(opCtx);
 
-    if (!result.isOK()) {
-        _logFailure(result.getStatus());
-        return;
+    // Take everything that has accumulated so far; entries arriving from here on are picked up
+    // by the rescheduled flush below.
+    std::vector<InsertStatement> batch;
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        batch.swap(_buffer);
     }
 
-    auto agc = std::move(result.getValue());
-
-    Collection& collection = *agc->getCollection();
+    // The batch's bytes stay accounted against the buffer cap until the write completes, so
+    // that a stalled flush (e.g. blocked behind a global lock) still produces backpressure.
+    int64_t batchBytes = 0;
+    for (auto&& stmt : batch) {
+        batchBytes += stmt.doc.objsize();
+    }
 
-    Status status = writeConflictRetry(opCtx, "deferred insert", _nss.ns(), [&] {
-        WriteUnitOfWork wuow(opCtx);
-        Status status = collection.insertDocument(opCtx, stmt, nullptr, false);
-        if (!status.isOK()) {
-            return status;
+    Status status = Status::OK();
+    if (!batch.empty()) {
+        auto result = _getCollection(opCtx);
+        if (!result.isOK()) {
+            status = result.getStatus();
+        } else {
+            auto agc = std::move(result.getValue());
+            Collection& collection = *agc->getCollection();
+
+            status = writeConflictRetry(opCtx, "deferred insert", _nss.ns(), [&] {
+                WriteUnitOfWork wuow(opCtx);
+                Status insertStatus =
+                    collection.insertDocuments(opCtx, batch.begin(), batch.end(), nullptr, false);
+                if (!insertStatus.isOK()) {
+                    return insertStatus;
+                }
+
+                wuow.commit();
+                return Status::OK();
+            });
+
+            if (status.isOK()) {
+                deferredWritesBatches.increment();
+                deferredWritesEntries.increment(batch.size());
+            }
         }
-
-        wuow.commit();
-        return Status::OK();
-    });
+    }
 
     stdx::lock_guard<stdx::mutex> lock(_mutex);
 
-    _numBytes -= stmt.doc.objsize();
+    _numBytes -= batchBytes;
 
     // If a write to a deferred collection fails, periodically tell the log.
     if (!status.isOK()) {
         _logFailure(status);
     }
+
+    // More entries may have arrived while we were writing; keep the flush task alive until the
+    // buffer is drained.
+    if (!_buffer.empty()) {
+        fassert(51470, _pool->schedule([this] { _flush(); }));
+    } else {
+        _flushScheduled = false;
+        _flushDone.notify_all();
+    }
 }
 
 DeferredWriter::DeferredWriter(NamespaceString nss, CollectionOptions opts, int64_t maxSize)
@@ -140,25 +217,21 @@ DeferredWriter::~DeferredWriter() {}
 void DeferredWriter::startup(std::string workerName) {
     // We should only start up once.
     invariant(!_pool);
-    ThreadPool::Options options;
-    options.poolName = "deferred writer pool";
-    options.threadNamePrefix = workerName;
-    options.minThreads = 0;
-    options.maxThreads = 1;
-    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
-    _pool = stdx::make_unique<ThreadPool>(options);
-    _pool->startup();
+    _workerName = std::move(workerName);
+    _pool = getSharedWriterPool(getGlobalServiceContext()).get();
 }
 
 void DeferredWriter::shutdown(void) {
-    // If we never allocated the pool, no cleanup is necessary.
+    // If we never attached to the pool, no cleanup is necessary.
     if (!_pool) {
         return;
     }
 
-    _pool->waitForIdle();
-    _pool->shutdown();
-    _pool->join();
+    // Wait for our own buffer to drain rather than shutting the pool down; the pool is shared
+    // with other writers.
+    stdx::unique_lock<stdx::mutex> lock(_mutex);
+    _flushDone.wait(lock, [&] { return !_flushScheduled; });
+    _pool = nullptr;
 }
 
 bool DeferredWriter::insertDocument(BSONObj obj) {
@@ -177,7 +250,13 @@ bool DeferredWriter::insertDocument(BSONObj obj) {
 
     // Add the object to the buffer.
     _numBytes += obj.objsize();
-    fassert(40588, _pool->schedule([this, obj] { _worker(InsertStatement(obj.getOwned())); }));
+    _buffer.push_back(InsertStatement(obj.getOwned()));
+
+    // One flush task per writer is in flight at a time; it drains whatever has accumulated.
+    if (!_flushScheduled) {
+        _flushScheduled = true;
+        fassert(40588, _pool->schedule([this] { _flush(); }));
+    }
     return true;
 }
 
@@ -28,9 +28,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 
 namespace mongo {
@@ -54,6 +57,10 @@ class ThreadPool;
  *
  * Instances of this class are unconditionally thread-safe, and cannot cause deadlock barring
  * improper use of the ctor, `flush` and `shutdown` methods below.
+ *
+ * All instances share one thread pool, owned by the global ServiceContext; each writer coalesces
+ * whatever has accumulated in its buffer into a single WriteUnitOfWork per flush rather than
+ * paying a write (and collection lock acquisition) per document.
  */
 class DeferredWriter {
     MONGO_DISALLOW_COPYING(DeferredWriter);
@@ -70,18 +77,19 @@ public:
     DeferredWriter(NamespaceString nss, CollectionOptions opts, int64_t maxSize);
 
     /**
-     * Start the background worker thread writing to the given collection.
+     * Attach the writer to the shared background thread pool so it can begin writing.
      *
-     * @param workerName The name of the client associated with the worker thread.
+     * @param workerName A name identifying this writer in diagnostic log messages.
      */
     void startup(std::string workerName);
 
     /**
-     * Flush the buffer and `join` the worker thread.
+     * Flush the buffer and detach from the shared thread pool.
      *
      * IMPORTANT: Must be called before destruction if `startup` has been called.
      *
-     * Blocks until buffered writes complete.  Must not be called repeatedly.
+     * Blocks until buffered writes complete.  Must not be called repeatedly.  Does not shut down
+     * the shared pool, which other writers may still be using.
      */
     void shutdown(void);
 
@@ -132,9 +140,10 @@ private:
     StatusWith<std::unique_ptr<AutoGetCollection>> _getCollection(OperationContext* opCtx);
 
     /**
-     * The method that the worker thread will run.
+     * Writes everything accumulated in the buffer in a single WriteUnitOfWork, rescheduling
+     * itself if more entries arrived while it was writing.  Runs on the shared thread pool.
      */
-    void _worker(InsertStatement stmt);
+    void _flush();
 
     /**
      * The options for the collection, in case we need to create it.
@@ -151,7 +160,16 @@ private:
      */
     const NamespaceString _nss;
 
-    std::unique_ptr<ThreadPool> _pool;
+    /**
+     * The shared thread pool, owned by the global ServiceContext.  Non-null between `startup`
+     * and `shutdown`.
+     */
+    ThreadPool* _pool = nullptr;
+
+    /**
+     * The name identifying this writer in diagnostic log messages.
+     */
+    std::string _workerName;
 
     /**
      * Guards all non-const, non-thread-safe members.
@@ -159,7 +177,22 @@ private:
     stdx::mutex _mutex;
 
     /**
-     * The number of bytes currently in the in-memory buffer.
+     * Entries waiting to be written by the next flush.
+     */
+    std::vector<InsertStatement> _buffer;
+
+    /**
+     * Whether a flush task is currently scheduled or running on the shared pool.
+     */
+    bool _flushScheduled = false;
+
+    /**
+     * Signalled when the in-flight flush task finds the buffer empty and retires.
+     */
+    stdx::condition_variable _flushDone;
+
+    /**
+     * The number of bytes currently buffered or being written by an in-flight flush.
      */
     int64_t _numBytes;
 
@@ -32,6 +32,8 @@
 
 #include "mongo/db/concurrency/lock_manager.h"
 
+#include <algorithm>
+
 #include <third_party/murmurhash3/MurmurHash3.h>
 
 #include "mongo/base/data_type_endian.h"
@@ -41,8 +43,10 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/stringutils.h"
 #include "mongo/util/timer.h"
 
@@ -316,14 +320,35 @@ void LockHead::decConflictModeCount(LockMode mode) {
 // LockManager
 //
 
-// Have more buckets than CPUs to reduce contention on lock and caches
-const unsigned LockManager::_numLockBuckets(128);
+namespace {
+
+unsigned roundUpToPowerOfTwo(unsigned n) {
+    unsigned result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Have more buckets than CPUs to reduce contention on lock and caches. The historical value of
+// 128 is kept as a floor so small machines behave as before.
+unsigned numLockBuckets() {
+    const auto numCores = static_cast<unsigned>(ProcessInfo::getNumAvailableCores());
+    return std::max(128u, roundUpToPowerOfTwo(numCores * 4));
+}
+
+// Balance scalability of intent locks against potential added cost of conflicting locks. Sized
+// to the number of cores (power of two, with the historical value of 32 as a floor) so that a
+// storm of intent-mode lockers on a many-core machine is not funneled through fewer partition
+// mutexes than there are cores running lockers.
+unsigned numPartitions() {
+    const auto numCores = static_cast<unsigned>(ProcessInfo::getNumAvailableCores());
+    return std::max(32u, roundUpToPowerOfTwo(numCores));
+}
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+}  // namespace
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numLockBuckets(numLockBuckets()), _numPartitions(numPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -494,52 +519,67 @@ bool LockManager::unlock(LockRequest* request) {
     }
     invariant(request->lock);
 
-    LockHead* lock = request->lock;
-    LockBucket* bucket = _getBucket(lock->resourceId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    DeferredGrantVector deferredGrants;
+    {
+        LockHead* lock = request->lock;
+        LockBucket* bucket = _getBucket(lock->resourceId);
+        stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
 
-    if (request->status == LockRequest::STATUS_GRANTED) {
-        // This releases a currently held lock and is the most common path, so it should be
-        // as efficient as possible. The fast path for decrementing multiple references did
-        // already ensure request->recursiveCount == 0.
+        if (request->status == LockRequest::STATUS_GRANTED) {
+            // This releases a currently held lock and is the most common path, so it should be
+            // as efficient as possible. The fast path for decrementing multiple references did
+            // already ensure request->recursiveCount == 0.
 
-        // Remove from the granted list
-        lock->grantedList.remove(request);
-        lock->decGrantedModeCount(request->mode);
+            // Remove from the granted list
+            lock->grantedList.remove(request);
+            lock->decGrantedModeCount(request->mode);
 
-        if (request->compatibleFirst) {
-            invariant(lock->compatibleFirstCount > 0);
-            lock->compatibleFirstCount--;
-            invariant(lock->compatibleFirstCount == 0 || !lock->grantedList.empty());
-        }
+            if (request->compatibleFirst) {
+                invariant(lock->compatibleFirstCount > 0);
+                lock->compatibleFirstCount--;
+                invariant(lock->compatibleFirstCount == 0 || !lock->grantedList.empty());
+            }
 
-        _onLockModeChanged(lock, lock->grantedCounts[request->mode] == 0);
-    } else if (request->status == LockRequest::STATUS_WAITING) {
-        // This cancels a pending lock request
-        invariant(request->recursiveCount == 0);
+            _onLockModeChanged(lock, lock->grantedCounts[request->mode] == 0, &deferredGrants);
+        } else if (request->status == LockRequest::STATUS_WAITING) {
+            // This cancels a pending lock request
+            invariant(request->recursiveCount == 0);
 
-        lock->conflictList.remove(request);
-        lock->decConflictModeCount(request->mode);
+            lock->conflictList.remove(request);
+            lock->decConflictModeCount(request->mode);
 
-        _onLockModeChanged(lock, true);
-    } else if (request->status == LockRequest::STATUS_CONVERTING) {
-        // This cancels a pending convert request
-        invariant(request->recursiveCount > 0);
-        invariant(lock->conversionsCount > 0);
+            _onLockModeChanged(lock, true, &deferredGrants);
+        } else if (request->status == LockRequest::STATUS_CONVERTING) {
+            // This cancels a pending convert request
+            invariant(request->recursiveCount > 0);
+            invariant(lock->conversionsCount > 0);
 
-        // Lock only goes from GRANTED to CONVERTING, so cancelling the conversion request
-        // brings it back to the previous granted mode.
-        request->status = LockRequest::STATUS_GRANTED;
+            // Lock only goes from GRANTED to CONVERTING, so cancelling the conversion request
+            // brings it back to the previous granted mode.
+            request->status = LockRequest::STATUS_GRANTED;
 
-        lock->conversionsCount--;
-        lock->decGrantedModeCount(request->convertMode);
+            lock->conversionsCount--;
+            lock->decGrantedModeCount(request->convertMode);
 
-        request->convertMode = MODE_NONE;
+            request->convertMode = MODE_NONE;
 
-        _onLockModeChanged(lock, lock->grantedCounts[request->convertMode] == 0);
-    } else {
-        // Invalid request status
-        MONGO_UNREACHABLE;
+            _onLockModeChanged(
+                lock, lock->grantedCounts[request->convertMode] == 0, &deferredGrants);
+        } else {
+            // Invalid request status
+            MONGO_UNREACHABLE;
+        }
+    }
+
+    _notifyDeferredGrants(deferredGrants);
+
+    // If another thread resolved a conflict in this request's favor while the caller had already
+    // decided to give up waiting (e.g. because its deadline passed), a grant notification for
+    // this request may still be in flight. Wait for it to be delivered before returning, because
+    // once we return the owning Locker is free to destroy the request and the notification
+    // object it points to. In the common case the count is zero and this is a single load.
+    while (request->deferredNotifyCount.load() > 0) {
+        stdx::this_thread::yield();
     }
 
     return (request->recursiveCount == 0);
@@ -557,14 +597,19 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
 
     LockHead* lock = request->lock;
 
-    LockBucket* bucket = _getBucket(lock->resourceId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    DeferredGrantVector deferredGrants;
+    {
+        LockBucket* bucket = _getBucket(lock->resourceId);
+        stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
 
-    lock->incGrantedModeCount(newMode);
-    lock->decGrantedModeCount(request->mode);
-    request->mode = newMode;
+        lock->incGrantedModeCount(newMode);
+        lock->decGrantedModeCount(request->mode);
+        request->mode = newMode;
+
+        _onLockModeChanged(lock, true, &deferredGrants);
+    }
 
-    _onLockModeChanged(lock, true);
+    _notifyDeferredGrants(deferredGrants);
 }
 
 void LockManager::cleanupUnusedLocks() {
@@ -604,7 +649,9 @@ void LockManager::_cleanupUnusedLocksInBucket(LockBucket* bucket) {
     }
 }
 
-void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
+void LockManager::_onLockModeChanged(LockHead* lock,
+                                     bool checkConflictQueue,
+                                     DeferredGrantVector* deferredGrants) {
     // Unblock any converting requests (because conversions are still counted as granted and
     // are on the granted queue).
     for (LockRequest* iter = lock->grantedList._front;
@@ -642,7 +689,8 @@ void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
                 iter->mode = iter->convertMode;
                 iter->convertMode = MODE_NONE;
 
-                iter->notify->notify(lock->resourceId, LOCK_OK);
+                iter->deferredNotifyCount.addAndFetch(1);
+                deferredGrants->push_back(std::make_pair(iter, lock->resourceId));
             }
         }
     }
@@ -699,7 +747,8 @@ void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
             newlyCompatibleFirst |= (lock->compatibleFirstCount++ == 0);
         }
 
-        iter->notify->notify(lock->resourceId, LOCK_OK);
+        iter->deferredNotifyCount.addAndFetch(1);
+        deferredGrants->push_back(std::make_pair(iter, lock->resourceId));
 
         // Small optimization - nothing is compatible with a newly granted MODE_X, so no point in
         // looking further in the conflict queue. Conflicting MODE_X requests are skipped above.
@@ -714,6 +763,18 @@ void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
     invariant((lock->conflictModes == 0) ^ (lock->conflictList._front != nullptr));
 }
 
+void LockManager::_notifyDeferredGrants(const DeferredGrantVector& deferredGrants) {
+    for (auto&& grant : deferredGrants) {
+        LockRequest* request = grant.first;
+
+        // The notify call must complete before the deferred count is decremented, because as
+        // soon as the count reaches zero a concurrent unlock of this request may return and
+        // allow the owning Locker, and with it the notification object, to be destroyed.
+        request->notify->notify(grant.second, LOCK_OK);
+        request->deferredNotifyCount.subtractAndFetch(1);
+    }
+}
+
 LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
     return &_lockBuckets[resId % _numLockBuckets];
 }
@@ -1073,6 +1134,8 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
     this->locker = locker;
     this->notify = notify;
 
+    deferredNotifyCount.store(0);
+
     enqueueAtFront = false;
     compatibleFirst = false;
     recursiveCount = 1;
@@ -198,6 +198,14 @@ private:
                           const LockBucket* bucket,
                           BSONArrayBuilder* locks);
 
+    /**
+     * A grant decided while holding a bucket mutex, whose notification is delivered after the
+     * mutex has been released. All deferred grants are successful, so only the granted request
+     * and the resource need to be remembered. Each entry holds a reference on the request's
+     * deferredNotifyCount, which keeps the request alive until the notification is delivered.
+     */
+    typedef std::vector<std::pair<LockRequest*, ResourceId>> DeferredGrantVector;
+
     /**
      * Should be invoked when the state of a lock changes in a way, which could potentially
      * allow other blocked requests to proceed.
@@ -208,8 +216,20 @@ private:
      * @param checkConflictQueue Whether to go through the conflict queue. This is an
      *          optimization in that we only need to check the conflict queue if one of the
      *          granted modes, which was conflicting before became zero.
+     * @param deferredGrants Newly granted requests are appended here instead of being
+     *          notified directly, so that an entire cohort of compatible waiters can be woken
+     *          in one pass after the bucket mutex is released; see _notifyDeferredGrants().
+     */
+    void _onLockModeChanged(LockHead* lock,
+                            bool checkConflictQueue,
+                            DeferredGrantVector* deferredGrants);
+
+    /**
+     * Delivers the notifications collected by _onLockModeChanged(). MUST be called without
+     * holding any bucket mutex, so that waking a large cohort of waiters does not extend the
+     * bucket's critical section and none of the woken threads contend with the wakeup itself.
      */
-    void _onLockModeChanged(LockHead* lock, bool checkConflictQueue);
+    static void _notifyDeferredGrants(const DeferredGrantVector& deferredGrants);
 
     /**
      * Helper function to delete all locks that have no request on them on a single bucket.
@@ -217,10 +237,13 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
-    static const unsigned _numLockBuckets;
+    // Both counts are computed from the number of cores at construction so that many-core
+    // machines do not funnel all lockers through a handful of mutexes; see the comments on
+    // the sizing helpers in the .cpp for the floors and rationale.
+    const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
+    const unsigned _numPartitions;
     Partition* _partitions;
 };
 
@@ -35,6 +35,7 @@
 #include "mongo/base/static_assert.h"
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/hash_namespace.h"
 
 namespace mongo {
@@ -346,6 +347,16 @@ struct LockRequest {
     // No synchronization
     LockGrantNotification* notify;
 
+    // Number of grant notifications for this request, which have been handed off to a granting
+    // thread for delivery outside of the lock bucket mutex, but have not yet been delivered.
+    // LockManager::unlock waits for this count to drain before returning, since once unlock
+    // returns the owning Locker is free to destroy the request and the notification object.
+    //
+    // Incremented by LockManager under the bucket mutex
+    // Decremented by LockManager on the granting thread, without the bucket mutex
+    // Read by LockManager on any thread
+    AtomicUInt32 deferredNotifyCount;
+
     // If the request cannot be granted right away, whether to put it at the front or at the end of
     // the queue. By default, requests are put at the back. If a request is requested to be put at
     // the front, this effectively bypasses fairness. Default is FALSE.
@@ -34,6 +34,7 @@
 
 #include <vector>
 
+#include "mongo/db/admission_control.h"
 #include "mongo/db/concurrency/replication_lock_manager_manipulator.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
@@ -248,6 +249,11 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+TicketHolder* Locker::getGlobalThrottledTicketHolder(LockMode mode) {
+    return ticketHolders[mode];
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -334,10 +340,22 @@ LockResult LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Da
         // If the ticket wait is interrupted, restore the state of the client.
         auto restoreStateOnErrorGuard = MakeGuard([&] { _clientState.store(kInactive); });
 
+        // Feed the wait (including timed out and interrupted waits) to admission control, so
+        // it can start delaying new low-priority operations once waits here grow too long.
+        const uint64_t startOfTicketWaitMicros = curTimeMicros64();
+        auto recordWaitGuard = MakeGuard([&] {
+            const uint64_t ticketWaitMicros = curTimeMicros64() - startOfTicketWaitMicros;
+            _ticketWaitTimeMicros.addAndFetch(ticketWaitMicros);
+            globalAdmissionController.recordTicketWait(
+                Milliseconds(static_cast<int64_t>(ticketWaitMicros / 1000)));
+        });
+
+        const auto lane = usesReservedTickets() ? TicketHolder::Lane::kInternal
+                                                : TicketHolder::Lane::kUser;
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, lane);
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, lane)) {
             return LOCK_TIMEOUT;
         }
         restoreStateOnErrorGuard.Dismiss();
@@ -899,7 +917,8 @@ void LockerImpl::releaseTicket() {
 void LockerImpl::_releaseTicket() {
     auto holder = shouldAcquireTicket() ? ticketHolders[_modeForTicket] : nullptr;
     if (holder) {
-        holder->release();
+        holder->release(usesReservedTickets() ? TicketHolder::Lane::kInternal
+                                              : TicketHolder::Lane::kUser);
     }
     _clientState.store(kInactive);
 }
@@ -186,6 +186,14 @@ public:
     virtual boost::optional<LockerInfo> getLockerInfo(
         const boost::optional<SingleThreadedLockStats> lockStatsBase) const final;
 
+    virtual int64_t getCumulativeLockWaitTimeMicros() const {
+        return _stats.getCumulativeWaitTimeMicros();
+    }
+
+    virtual int64_t getCumulativeTicketWaitTimeMicros() const {
+        return _ticketWaitTimeMicros.load();
+    }
+
     virtual bool saveLockStateAndUnlock(LockSnapshot* stateOut);
 
     virtual void restoreLockState(OperationContext* opCtx, const LockSnapshot& stateToRestore);
@@ -254,9 +262,11 @@ public:
     }
 
     /**
-     * This function is for unit testing only.
+     * This function is for unit testing only. Returns a reference rather than a copy, because
+     * LockRequest is no longer copyable now that it carries an atomic word; callers must not
+     * inspect the map while the locker is in use by another thread.
      */
-    FastMapNoAlloc<ResourceId, LockRequest> getRequestsForTest() const {
+    const FastMapNoAlloc<ResourceId, LockRequest>& getRequestsForTest() const {
         scoped_spinlock scopedLock(_lock);
         return _requests;
     }
@@ -323,6 +333,10 @@ private:
     // db.currentOp. Complementary to the per-instance locking statistics.
     SingleThreadedLockStats _stats;
 
+    // Total time spent waiting for a concurrency ticket. Atomic because other threads read it
+    // through the Locker interface while this locker's thread updates it.
+    AtomicInt64 _ticketWaitTimeMicros{0};
+
     // Delays release of exclusive/intent-exclusive locked resources until the write unit of
     // work completes. Value of 0 means we are not inside a write unit of work.
     int _wuowNestingLevel;
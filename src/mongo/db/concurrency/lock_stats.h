@@ -185,6 +185,22 @@ public:
         }
     }
 
+    /**
+     * Returns the total wait time recorded across all resource types and modes.
+     */
+    int64_t getCumulativeWaitTimeMicros() const {
+        int64_t total = 0;
+        for (int i = 0; i < ResourceTypesCount; i++) {
+            for (int mode = 0; mode < LockModesCount; mode++) {
+                total += CounterOps::get(_stats[i].modeStats[mode].combinedWaitTimeMicros);
+            }
+        }
+        for (int mode = 0; mode < LockModesCount; mode++) {
+            total += CounterOps::get(_oplogStats.modeStats[mode].combinedWaitTimeMicros);
+        }
+        return total;
+    }
+
     void report(BSONObjBuilder* builder) const;
     void reset();
 
@@ -73,6 +73,12 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Returns the ticket holder used to throttle global lock acquisitions in 'mode', or nullptr
+     * if 'mode' is not throttled or setGlobalThrottling() has not been called.
+     */
+    static class TicketHolder* getGlobalThrottledTicketHolder(LockMode mode);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -326,6 +332,17 @@ public:
     virtual boost::optional<LockerInfo> getLockerInfo(
         const boost::optional<SingleThreadedLockStats> lockStatsBase) const = 0;
 
+    /**
+     * Returns the total time this locker has spent waiting for locks, across all resources
+     * and modes. Cheaper than summing the stats from getLockerInfo().
+     */
+    virtual int64_t getCumulativeLockWaitTimeMicros() const = 0;
+
+    /**
+     * Returns the total time this locker has spent waiting for a concurrency ticket.
+     */
+    virtual int64_t getCumulativeTicketWaitTimeMicros() const = 0;
+
     /**
      * LockSnapshot captures the state of all resources that are locked, what modes they're
      * locked in, and how many times they've been locked in that mode.
@@ -444,6 +461,21 @@ public:
     bool shouldAcquireTicket() const {
         return _shouldAcquireTicket;
     }
+
+    /**
+     * If set to true, tickets are acquired from the ticket holders' reserved internal lane, so
+     * this locker does not queue behind user operations once all general tickets are in use.
+     * This should only be set for replication and other internal operations whose progress the
+     * user workload itself depends on. Must not change while a ticket is held.
+     */
+    void setUsesReservedTickets(bool newValue) {
+        invariant(!isLocked() || isNoop());
+        _usesReservedTickets = newValue;
+    }
+    bool usesReservedTickets() const {
+        return _usesReservedTickets;
+    }
+
     /**
      * This function is for unit testing only.
      */
@@ -471,6 +503,7 @@ protected:
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAcquireTicket = true;
+    bool _usesReservedTickets = false;
 };
 
 /**
@@ -167,6 +167,14 @@ public:
         return boost::none;
     }
 
+    virtual int64_t getCumulativeLockWaitTimeMicros() const {
+        return 0;
+    }
+
+    virtual int64_t getCumulativeTicketWaitTimeMicros() const {
+        return 0;
+    }
+
     virtual bool saveLockStateAndUnlock(LockSnapshot* stateOut) {
         MONGO_UNREACHABLE;
     }
@@ -30,13 +30,86 @@
 
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kWrite
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stacktrace.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Tracks which namespaces are suffering write conflicts, so that hot spots can be identified
+ * from serverStatus. The table is capped; once it is full, conflicts on previously unseen
+ * namespaces are aggregated into a catch-all bucket.
+ */
+class WriteConflictStats {
+public:
+    void record(StringData ns) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _counts.find(ns);
+        if (it != _counts.end()) {
+            it->second++;
+        } else if (_counts.size() < kMaxTrackedNamespaces) {
+            _counts[ns]++;
+        } else {
+            _untracked++;
+        }
+    }
+
+    void report(BSONObjBuilder* bob) const {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (auto&& entry : _counts) {
+            bob->append(entry.first, entry.second);
+        }
+        if (_untracked) {
+            bob->append("other", _untracked);
+        }
+    }
+
+private:
+    static const size_t kMaxTrackedNamespaces = 128;
+
+    mutable stdx::mutex _mutex;
+    StringMap<long long> _counts;
+    long long _untracked = 0;
+} writeConflictStats;
+
+Counter64 writeConflictsTotal;
+ServerStatusMetricField<Counter64> displayWriteConflictsTotal("writeConflicts.total",
+                                                              &writeConflictsTotal);
+
+class WriteConflictsByNamespaceMetric : public ServerStatusMetric {
+public:
+    WriteConflictsByNamespaceMetric() : ServerStatusMetric("writeConflicts.byNamespace") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        BSONObjBuilder sub(b.subobjStart(_leafName));
+        writeConflictStats.report(&sub);
+    }
+} writeConflictsByNamespaceMetric;
+
+/**
+ * Returns a random sleep length in [1, maxMillis]. The randomization desynchronizes threads
+ * that conflicted with one another, so they do not wake in lockstep and immediately collide on
+ * the same document again.
+ */
+int randomBackoffMillis(int maxMillis) {
+    static stdx::mutex randomMutex;
+    static PseudoRandom backoffRandom(SecureRandom::create()->nextInt64());
+
+    stdx::lock_guard<stdx::mutex> lk(randomMutex);
+    return 1 + backoffRandom.nextInt32(maxMillis);
+}
+
+}  // namespace
+
 AtomicBool WriteConflictException::trace(false);
 
 WriteConflictException::WriteConflictException()
@@ -50,17 +123,27 @@ void WriteConflictException::logAndBackoff(int attempt, StringData operation, St
     LOG(1) << "Caught WriteConflictException doing " << operation << " on " << ns
            << ", attempt: " << attempt << " retrying";
 
-    // All numbers below chosen by guess and check against a few random benchmarks.
+    writeConflictsTotal.increment();
+    writeConflictStats.record(ns);
+
+    // The tier maximums below were chosen by guess and check against a few random benchmarks,
+    // sized so each tier's expected sleep matches the fixed sleep we used historically. The
+    // actual sleep within a tier is randomized; see randomBackoffMillis().
+    int maxSleepMillis = 0;
     if (attempt < 4) {
         // no-op
     } else if (attempt < 10) {
-        sleepmillis(1);
+        maxSleepMillis = 2;
     } else if (attempt < 100) {
-        sleepmillis(5);
+        maxSleepMillis = 10;
     } else if (attempt < 200) {
-        sleepmillis(10);
+        maxSleepMillis = 20;
     } else {
-        sleepmillis(100);
+        maxSleepMillis = 200;
+    }
+
+    if (maxSleepMillis > 0) {
+        sleepmillis(randomBackoffMillis(maxSleepMillis));
     }
 }
 
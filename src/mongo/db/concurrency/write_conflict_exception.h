@@ -48,8 +48,10 @@ public:
     WriteConflictException();
 
     /**
-     * Will log a message if sensible and will do an exponential backoff to make sure
-     * we don't hammer the same doc over and over.
+     * Will log a message if sensible and will do a randomized tiered backoff to make sure we
+     * don't hammer the same doc over and over, and that the threads which conflicted do not
+     * retry in lockstep. Also feeds the per-namespace conflict counts reported under
+     * serverStatus().metrics.writeConflicts.
      * @param attempt - what attempt is this, 1 based
      * @param operation - e.g. "update"
      */
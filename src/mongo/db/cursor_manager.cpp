@@ -32,6 +32,8 @@
 
 #include "mongo/db/cursor_manager.h"
 
+#include <algorithm>
+
 #include "mongo/base/data_cursor.h"
 #include "mongo/base/init.h"
 #include "mongo/db/audit.h"
@@ -53,6 +55,7 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/platform/random.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/allocation_accounting.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/startup_test.h"
@@ -493,21 +496,95 @@ bool CursorManager::cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_
     return (now - cursor->_lastUseDate) >= Milliseconds(getCursorTimeoutMillis());
 }
 
+void CursorManager::noteCursorLastUseDate(Date_t lastUseDate) {
+    const long long millis = lastUseDate.toMillisSinceEpoch();
+    long long current = _minLastUseDateMillis.load();
+    while (millis < current) {
+        const long long found = _minLastUseDateMillis.compareAndSwap(current, millis);
+        if (found == current) {
+            break;
+        }
+        current = found;
+    }
+}
+
+void CursorManager::_recordIdleCursor(CursorId id, Date_t lastUseDate) {
+    auto& indexPartition = _idleCursorIndex[static_cast<uint64_t>(id) % kNumPartitions];
+    stdx::lock_guard<SimpleMutex> lk(indexPartition.mutex);
+    indexPartition.entries.emplace(lastUseDate, id);
+}
+
+void CursorManager::_forgetIdleCursor(CursorId id, Date_t lastUseDate) {
+    auto& indexPartition = _idleCursorIndex[static_cast<uint64_t>(id) % kNumPartitions];
+    stdx::lock_guard<SimpleMutex> lk(indexPartition.mutex);
+    auto range = indexPartition.entries.equal_range(lastUseDate);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == id) {
+            indexPartition.entries.erase(it);
+            return;
+        }
+    }
+}
+
 std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
+    // Fast path: if no cursor has been idle long enough to possibly have expired, there is no
+    // reason to consult the idle cursor index at all.
+    if (now - Date_t::fromMillisSinceEpoch(_minLastUseDateMillis.load()) <
+        Milliseconds(getCursorTimeoutMillis())) {
+        return 0;
+    }
+
     std::vector<std::unique_ptr<ClientCursor, ClientCursor::Deleter>> toDisposeWithoutMutex;
 
+    // Re-compute the last-use bound from the index while draining it. Pinned cursors are not
+    // indexed; their last-use date is refreshed when the pin is released, which re-indexes them.
+    // No-timeout cursors are never indexed, since they can never expire. The result is capped at
+    // 'now' so that cursors registered while the pass is in progress, necessarily with a later
+    // last-use date, remain covered by the bound.
+    const Milliseconds timeout{getCursorTimeoutMillis()};
+    Date_t minLastUseDate = Date_t::max();
     for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
-        auto lockedPartition = _cursorMap->lockOnePartitionById(partitionId);
-        for (auto it = lockedPartition->begin(); it != lockedPartition->end();) {
+        auto& indexPartition = _idleCursorIndex[partitionId];
+
+        // Extract the entries whose recorded last-use date is old enough to have expired. Only
+        // these cursors are examined; everything younger is left in place untouched.
+        std::vector<std::pair<Date_t, CursorId>> candidates;
+        {
+            stdx::lock_guard<SimpleMutex> lk(indexPartition.mutex);
+            auto firstUnexpired = indexPartition.entries.upper_bound(now - timeout);
+            candidates.assign(indexPartition.entries.begin(), firstUnexpired);
+            indexPartition.entries.erase(indexPartition.entries.begin(), firstUnexpired);
+            if (!indexPartition.entries.empty()) {
+                minLastUseDate = std::min(minLastUseDate, indexPartition.entries.begin()->first);
+            }
+        }
+
+        for (auto&& candidate : candidates) {
+            auto lockedPartition = _cursorMap->lockOnePartition(candidate.second);
+            auto it = lockedPartition->find(candidate.second);
+            if (it == lockedPartition->end()) {
+                // The cursor was killed or deregistered while idle; drop the stale entry.
+                continue;
+            }
             auto* cursor = it->second;
+            if (cursor->_operationUsingCursor) {
+                // The cursor was pinned again since the entry was recorded; a fresh entry is
+                // added when the pin is released.
+                continue;
+            }
             if (cursorShouldTimeout_inlock(cursor, now)) {
                 toDisposeWithoutMutex.emplace_back(cursor);
-                it = lockedPartition->erase(it);
+                lockedPartition->erase(it);
             } else {
-                ++it;
+                // Not expired after all, e.g. because the timeout was raised after the entry
+                // was recorded. Put the entry back so the cursor is revisited later.
+                stdx::lock_guard<SimpleMutex> lk(indexPartition.mutex);
+                indexPartition.entries.emplace(cursor->_lastUseDate, cursor->cursorid());
+                minLastUseDate = std::min(minLastUseDate, cursor->_lastUseDate);
             }
         }
     }
+    _minLastUseDateMillis.store(std::min(minLastUseDate, now).toMillisSinceEpoch());
 
     // Be careful not to dispose of cursors while holding the partition lock.
     for (auto&& cursor : toDisposeWithoutMutex) {
@@ -564,6 +641,9 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
     }
 
     cursor->_operationUsingCursor = opCtx;
+    if (!cursor->isNoTimeout()) {
+        _forgetIdleCursor(id, cursor->_lastUseDate);
+    }
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefor,
     // we pass down to the logical session cache and vivify the record (updating last use).
@@ -605,6 +685,11 @@ void CursorManager::unpin(OperationContext* opCtx,
         cursor->markAsKilled(interruptStatus);
     }
 
+    // The cursor is idle again; index it so the timeout pass will find it once it expires.
+    if (!cursor->isNoTimeout()) {
+        _recordIdleCursor(cursor->cursorid(), now);
+    }
+
     // The cursor will stay around in '_cursorMap', so release the unique pointer to avoid deleting
     // it.
     cursor.release();
@@ -678,32 +763,28 @@ size_t CursorManager::numCursors() const {
     return _cursorMap->size();
 }
 
-CursorId CursorManager::allocateCursorId_inlock() {
-    for (int i = 0; i < 10000; i++) {
-        // The leading two bits of a CursorId are used to determine if the cursor is registered on
-        // the global cursor manager.
-        CursorId id;
-        if (isGlobalManager()) {
-            // This is the global cursor manager, so generate a random number and make sure the
-            // first two bits are 01.
-            uint64_t mask = 0x3FFFFFFFFFFFFFFF;
-            uint64_t bitToSet = 1ULL << 62;
-            id = ((_random->nextInt64() & mask) | bitToSet);
-        } else {
-            // The first 2 bits are 0, the next 30 bits are the collection identifier, the next 32
-            // bits are random.
-            uint32_t myPart = static_cast<uint32_t>(_random->nextInt32());
-            id = cursorIdFromParts(_collectionCacheRuntimeId, myPart);
-        }
-        auto partition = _cursorMap->lockOnePartition(id);
-        if (partition->count(id) == 0)
-            return id;
+CursorId CursorManager::generateCursorId_inlock() {
+    // The leading two bits of a CursorId are used to determine if the cursor is registered on
+    // the global cursor manager.
+    if (isGlobalManager()) {
+        // This is the global cursor manager, so generate a random number and make sure the
+        // first two bits are 01.
+        uint64_t mask = 0x3FFFFFFFFFFFFFFF;
+        uint64_t bitToSet = 1ULL << 62;
+        return ((_random->nextInt64() & mask) | bitToSet);
     }
-    fassertFailed(17360);
+    // The first 2 bits are 0, the next 30 bits are the collection identifier, the next 32
+    // bits are random.
+    uint32_t myPart = static_cast<uint32_t>(_random->nextInt32());
+    return cursorIdFromParts(_collectionCacheRuntimeId, myPart);
 }
 
 ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
                                               ClientCursorParams&& cursorParams) {
+    // Attribute the cursor's allocations to the cursor subsystem.
+    allocation_accounting::ScopedSubsystemTag allocationTag(
+        allocation_accounting::Subsystem::kCursors);
+
     // Avoid computing the current time within the critical section.
     auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
 
@@ -714,23 +795,37 @@ ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
     cursorParams.exec.get_deleter().dismissDisposal();
     cursorParams.exec->unsetRegistered();
 
-    // Note we must hold the registration lock from now until insertion into '_cursorMap' to ensure
-    // we don't insert two cursors with the same cursor id.
-    stdx::lock_guard<SimpleMutex> lock(_registrationLock);
-    CursorId cursorId = allocateCursorId_inlock();
-    std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
-        new ClientCursor(std::move(cursorParams), this, cursorId, opCtx, now));
-
     // Register this cursor for lookup by transaction.
     if (opCtx->getLogicalSessionId() && opCtx->getTxnNumber()) {
         invariant(opCtx->getLogicalSessionId());
     }
 
-    // Transfer ownership of the cursor to '_cursorMap'.
-    auto partition = _cursorMap->lockOnePartition(cursorId);
-    ClientCursor* unownedCursor = clientCursor.release();
-    partition->emplace(cursorId, unownedCursor);
-    return ClientCursorPin(opCtx, unownedCursor);
+    // The partition a cursor id maps to is derived from the id itself, so uniqueness can be
+    // checked and the cursor inserted while holding only that partition's lock; concurrent
+    // registrations against different partitions no longer serialize on a manager-wide mutex.
+    // '_registrationLock' is held just long enough to generate a candidate id.
+    for (int i = 0; i < 10000; i++) {
+        CursorId cursorId;
+        {
+            stdx::lock_guard<SimpleMutex> lock(_registrationLock);
+            cursorId = generateCursorId_inlock();
+        }
+
+        auto partition = _cursorMap->lockOnePartition(cursorId);
+        if (partition->count(cursorId) != 0)
+            continue;
+
+        // Keep the idle bound used by timeoutCursors() covering the new cursor.
+        noteCursorLastUseDate(now);
+
+        // Transfer ownership of the cursor to '_cursorMap'.
+        std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
+            new ClientCursor(std::move(cursorParams), this, cursorId, opCtx, now));
+        ClientCursor* unownedCursor = clientCursor.release();
+        partition->emplace(cursorId, unownedCursor);
+        return ClientCursorPin(opCtx, unownedCursor);
+    }
+    fassertFailed(17360);
 }
 
 void CursorManager::deregisterCursor(ClientCursor* cursor) {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <map>
 #include <utility>
 
 #include "mongo/db/catalog/util/partitioned.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/mutex.h"
@@ -250,14 +252,23 @@ public:
                                     stdx::function<Status(CursorManager*)> callback);
 
 private:
-    static constexpr int kNumPartitions = 16;
+    // The number of partitions in '_registeredPlanExecutors' and '_cursorMap'. The partition of
+    // a cursor is its id modulo this count, so the low bits of a cursor id identify its partition
+    // directly and a lookup by id locks exactly one partition. Sized generously relative to
+    // typical core counts so that getMore storms against a single hot collection rarely contend
+    // on the same partition.
+    static constexpr int kNumPartitions = 64;
     friend class ClientCursorPin;
 
     struct PlanExecutorPartitioner {
         std::size_t operator()(const PlanExecutor* exec, std::size_t nPartitions);
     };
 
-    CursorId allocateCursorId_inlock();
+    /**
+     * Generates a candidate cursor id. The caller must hold '_registrationLock' and is
+     * responsible for checking that the id is not already in use within its partition.
+     */
+    CursorId generateCursorId_inlock();
 
     /**
      * Creates a generic cursor from a ClientCursor. Can only be called while holding the
@@ -280,6 +291,25 @@ private:
 
     bool cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_t now);
 
+    /**
+     * Lowers '_minLastUseDateMillis' to 'lastUseDate' if it is currently higher. Called on
+     * cursor registration so that the bound covers the new cursor.
+     */
+    void noteCursorLastUseDate(Date_t lastUseDate);
+
+    /**
+     * Records in the idle cursor index that the cursor with the given id became idle with the
+     * given last-use date. Called when a cursor is unpinned, unless it has the no-timeout option
+     * set.
+     */
+    void _recordIdleCursor(CursorId id, Date_t lastUseDate);
+
+    /**
+     * Removes the idle cursor index entry recorded by _recordIdleCursor(). Called when a cursor
+     * is pinned. A no-op if the entry has already been extracted by a concurrent timeout pass.
+     */
+    void _forgetIdleCursor(CursorId id, Date_t lastUseDate);
+
     bool isGlobalManager() const {
         return _nss.isEmpty();
     }
@@ -297,12 +327,12 @@ private:
     // There are several mutexes at work to protect concurrent access to data structures managed by
     // this cursor manager. The two registration data structures '_registeredPlanExecutors' and
     // '_cursorMap' are partitioned to decrease contention, and each partition of the structure is
-    // protected by its own mutex. Separately, there is a '_registrationLock' which protects
-    // concurrent access to '_random' for cursor id generation, and must be held from cursor id
-    // generation until insertion into '_cursorMap'. If you ever need to acquire more than one of
-    // these mutexes at once, you must follow the following rules:
-    // - '_registrationLock' must be acquired first, if at all.
-    // - Mutex(es) for '_registeredPlanExecutors' must be acquired next.
+    // protected by its own mutex. Separately, there is a '_registrationLock' which only protects
+    // concurrent access to '_random' for cursor id generation; it is never held together with a
+    // partition mutex, since uniqueness of a candidate id is checked under the lock of the single
+    // partition that id maps to. If you ever need to acquire more than one of the remaining
+    // mutexes at once, you must follow the following rules:
+    // - Mutex(es) for '_registeredPlanExecutors' must be acquired first.
     // - Mutex(es) for '_cursorMap' must be acquired next.
     // - If you need to access multiple partitions within '_registeredPlanExecutors' or '_cursorMap'
     //   at once, you must acquire the mutexes for those partitions in ascending order, or use the
@@ -313,5 +343,29 @@ private:
         _registeredPlanExecutors;
     std::unique_ptr<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>>
         _cursorMap;
+
+    // A conservative lower bound, in milliseconds since the epoch, on the last-use date of every
+    // cursor owned by this manager. It lets timeoutCursors() skip walking the partitioned cursor
+    // map entirely when no cursor can have been idle long enough to expire, which is the common
+    // case for the periodic timeout pass. The bound may be earlier than the true minimum (which
+    // merely costs a wasted walk). A registration racing with the walk can leave it later than
+    // the new cursor's last-use date by at most the skew between the two clock reads, which can
+    // delay that cursor's timeout by the same negligible amount. It is lowered on cursor
+    // registration and re-computed, capped at the time of the pass, by timeoutCursors().
+    AtomicInt64 _minLastUseDateMillis{0};
+
+    // A deadline-ordered index of idle cursors, keyed by the last-use date each cursor had when
+    // it became idle. timeoutCursors() extracts the entries that are old enough to have expired
+    // and examines only those cursors, instead of walking the whole cursor map. Entries are
+    // added when a cursor without the no-timeout option is unpinned and removed when it is
+    // pinned again; entries for cursors that were killed or deregistered while idle are dropped
+    // lazily when their date comes up in a timeout pass. Each index partition has its own mutex,
+    // which may be acquired while holding a '_cursorMap' partition lock but never the other way
+    // around.
+    struct IdleCursorIndexPartition {
+        SimpleMutex mutex;
+        std::multimap<Date_t, CursorId> entries;
+    };
+    IdleCursorIndexPartition _idleCursorIndex[kNumPartitions];
 };
 }  // namespace mongo
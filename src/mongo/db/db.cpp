@@ -59,6 +59,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/uuid_catalog.h"
+#include "mongo/db/catalog_prewarm.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
@@ -123,6 +124,7 @@
 #include "mongo/db/session_killer.h"
 #include "mongo/db/startup_warnings_mongod.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/storage_stats_sampler.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_engine.h"
@@ -155,6 +157,7 @@
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/fast_clock_source_factory.h"
+#include "mongo/util/tsc_clock_source.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/net/ssl_manager.h"
@@ -280,6 +283,10 @@ ExitCode _initAndListen(int listenPort) {
     auto serviceContext = getGlobalServiceContext();
 
     serviceContext->setFastClockSource(FastClockSourceFactory::create(Milliseconds(10)));
+    if (auto tscClock = TSCClockSource::makeIfSupported()) {
+        // Precise reads off the invariant TSC avoid a system call per Date_t::now().
+        serviceContext->setPreciseClockSource(std::move(tscClock));
+    }
     auto opObserverRegistry = stdx::make_unique<OpObserverRegistry>();
     opObserverRegistry->addObserver(stdx::make_unique<OpObserverShardingImpl>());
     opObserverRegistry->addObserver(stdx::make_unique<UUIDCatalogObserver>());
@@ -605,6 +612,12 @@ ExitCode _initAndListen(int listenPort) {
 
     startClientCursorMonitor();
 
+    startCatalogPrewarmBackgroundJob();
+
+    startStorageStatsSamplerBackgroundJob();
+
+    startProfileWriter();
+
     PeriodicTask::startRunningPeriodicTasks();
 
     SessionKiller::set(serviceContext,
@@ -809,6 +822,23 @@ auto makeReplicationExecutor(ServiceContext* serviceContext) {
         executor::makeNetworkInterface("Replication", nullptr, std::move(hookList)));
 }
 
+// Heartbeat traffic gets its own small executor and network interface so that queue delay from
+// bulk replication tasks on the main replication executor cannot inflate perceived heartbeat
+// round trip times and trigger spurious elections.
+auto makeReplicationHeartbeatExecutor(ServiceContext* serviceContext) {
+    ThreadPool::Options tpOptions;
+    tpOptions.poolName = "replexec-hb";
+    tpOptions.maxThreads = 4;
+    tpOptions.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName.c_str());
+    };
+    auto hookList = stdx::make_unique<rpc::EgressMetadataHookList>();
+    hookList->addHook(stdx::make_unique<rpc::LogicalTimeMetadataHook>(serviceContext));
+    return stdx::make_unique<executor::ThreadPoolTaskExecutor>(
+        stdx::make_unique<ThreadPool>(tpOptions),
+        executor::makeNetworkInterface("ReplicationHeartbeat", nullptr, std::move(hookList)));
+}
+
 void setUpReplication(ServiceContext* serviceContext) {
     repl::StorageInterface::set(serviceContext, stdx::make_unique<repl::StorageInterfaceImpl>());
     auto storageInterface = repl::StorageInterface::get(serviceContext);
@@ -843,7 +873,8 @@ void setUpReplication(ServiceContext* serviceContext) {
         stdx::make_unique<repl::TopologyCoordinator>(topoCoordOptions),
         replicationProcess,
         storageInterface,
-        static_cast<int64_t>(curTimeMillis64()));
+        static_cast<int64_t>(curTimeMillis64()),
+        makeReplicationHeartbeatExecutor(serviceContext));
     repl::ReplicationCoordinator::set(serviceContext, std::move(replCoord));
     repl::setOplogCollectionName(serviceContext);
 }
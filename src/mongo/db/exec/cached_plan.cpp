@@ -194,8 +194,30 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache) {
     _specificStats.replanned = true;
 
     if (shouldCache) {
-        // Deactivate the current cache entry.
         PlanCache* cache = _collection->infoCache()->getPlanCache();
+
+        if (internalQueryCacheReplanIncrementally.load()) {
+            // Before evicting the entry and re-running the full planner, try to re-rank the
+            // incumbent against the single best rival recorded when the entry was created.
+            // This avoids paying the full planning and multi-plan trial cost on the common
+            // path where one of the original candidates is still competitive.
+            auto statusWithEntry = cache->getEntry(*_canonicalQuery);
+            if (statusWithEntry.isOK() && statusWithEntry.getValue()->plannerData.size() > 1) {
+                Status status =
+                    replanFromCachedCandidates(*statusWithEntry.getValue(), yieldPolicy);
+                if (status.isOK()) {
+                    return Status::OK();
+                }
+
+                LOG(1) << "Incremental replanning failed, replanning from scratch: "
+                       << redact(_canonicalQuery->toStringShort())
+                       << " status: " << redact(status);
+                _children.clear();
+                _ws->clear();
+            }
+        }
+
+        // Deactivate the current cache entry.
         cache->deactivate(*_canonicalQuery);
     }
 
@@ -268,6 +290,55 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache) {
     return Status::OK();
 }
 
+Status CachedPlanStage::replanFromCachedCandidates(const PlanCacheEntry& entry,
+                                                   PlanYieldPolicy* yieldPolicy) {
+    invariant(entry.plannerData.size() > 1);
+
+    // Trial only the incumbent and the next-best candidate. The candidates in 'plannerData'
+    // are ordered by the score they received when the entry was created, best first.
+    const size_t numCandidates = 2;
+
+    // The trial's winner is cached, replacing the old entry. The working set will be shared
+    // by both candidate plans.
+    _children.emplace_back(new MultiPlanStage(
+        getOpCtx(), _collection, _canonicalQuery, MultiPlanStage::CachingMode::AlwaysCache));
+    MultiPlanStage* multiPlanStage = static_cast<MultiPlanStage*>(child().get());
+
+    for (size_t ix = 0; ix < numCandidates; ++ix) {
+        auto statusWithQs =
+            QueryPlanner::planFromCache(*_canonicalQuery, _plannerParams, *entry.plannerData[ix]);
+        if (!statusWithQs.isOK()) {
+            return statusWithQs.getStatus();
+        }
+        auto solution = std::move(statusWithQs.getValue());
+
+        // Solutions rebuilt from the cache carry no cache data of their own; reattach the
+        // entry's planner data so the trial's winner can be written back to the cache.
+        if (!solution->cacheData) {
+            solution->cacheData.reset(entry.plannerData[ix]->clone());
+        }
+        solution->cacheData->indexFilterApplied = _plannerParams.indexFiltersApplied;
+
+        PlanStage* nextPlanRoot;
+        verify(StageBuilder::build(
+            getOpCtx(), _collection, *_canonicalQuery, *solution, _ws, &nextPlanRoot));
+
+        // Takes ownership of 'nextPlanRoot'.
+        multiPlanStage->addPlan(std::move(solution), nextPlanRoot, _ws);
+    }
+
+    // Delegate to the MultiPlanStage's plan selection facility.
+    Status pickBestPlanStatus = multiPlanStage->pickBestPlan(yieldPolicy);
+    if (!pickBestPlanStatus.isOK()) {
+        return pickBestPlanStatus;
+    }
+
+    LOG(1) << "Incremental replanning of " << redact(_canonicalQuery->toStringShort())
+           << " resulted in plan with summary: " << Explain::getPlanSummary(child().get())
+           << ", which has been written to the cache";
+    return Status::OK();
+}
+
 bool CachedPlanStage::isEOF() {
     return _results.empty() && child()->isEOF();
 }
@@ -304,17 +375,28 @@ const SpecificStats* CachedPlanStage::getSpecificStats() const {
 }
 
 void CachedPlanStage::updatePlanCache() {
-    const double score = PlanRanker::scoreTree(getStats()->children[0].get());
+    std::unique_ptr<PlanStageStats> stats = getStats();
+    const double score = PlanRanker::scoreTree(stats->children[0].get());
 
     PlanCache* cache = _collection->infoCache()->getPlanCache();
-    Status fbs = cache->feedback(*_canonicalQuery, score);
+    StatusWith<bool> fbs = cache->feedback(*_canonicalQuery, score);
     if (!fbs.isOK()) {
-        LOG(5) << _canonicalQuery->ns() << ": Failed to update cache with feedback: " << redact(fbs)
-               << " - "
+        LOG(5) << _canonicalQuery->ns()
+               << ": Failed to update cache with feedback: " << redact(fbs.getStatus()) << " - "
                << "(query: " << redact(_canonicalQuery->getQueryObj())
                << "; sort: " << _canonicalQuery->getQueryRequest().getSort()
                << "; projection: " << _canonicalQuery->getQueryRequest().getProj()
                << ") is no longer in plan cache.";
+        return;
+    }
+
+    if (fbs.getValue()) {
+        // This execution was selected for stats sampling. Serialize the stage-level counters of
+        // the winning plan outside of the cache's partition lock and store them in the entry,
+        // where planCacheListPlans reports them.
+        cache->recordExecutionStatsSample(*_canonicalQuery,
+                                          Explain::statsToBSON(*stats->children[0]))
+            .ignore();
     }
 }
 
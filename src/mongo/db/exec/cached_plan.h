@@ -41,6 +41,7 @@
 
 namespace mongo {
 
+class PlanCacheEntry;
 class PlanYieldPolicy;
 
 /**
@@ -104,6 +105,17 @@ private:
      */
     Status replan(PlanYieldPolicy* yieldPolicy, bool shouldCache);
 
+    /**
+     * Re-ranks the incumbent plan against the runner-up candidate recorded in 'entry' by
+     * running a two-way MultiPlanStage trial, rather than regenerating and trialing every
+     * candidate plan. Both candidates are rebuilt from their cached planner data, so the
+     * full planner never runs. The trial's winner replaces the old cache entry.
+     *
+     * Returns a non-OK status if a candidate cannot be rebuilt from its cached planner data
+     * or the trial fails, in which case the caller falls back to replanning from scratch.
+     */
+    Status replanFromCachedCandidates(const PlanCacheEntry& entry, PlanYieldPolicy* yieldPolicy);
+
     /**
      * May yield during the cached plan stage's trial period or replanning phases.
      *
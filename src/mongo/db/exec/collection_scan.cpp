@@ -184,6 +184,80 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+PlanStage::StageState CollectionScan::doWorkBatch(size_t maxCount,
+                                                  std::vector<WorkingSetID>* results,
+                                                  WorkingSetID* out) {
+    // Let doWork() handle the edge cases (dead scans, cursor creation, the initial seek) one call
+    // at a time; once the cursor is positioned mid-scan we can drain it in a tight loop.
+    if (_isDead || _commonStats.isEOF || !_cursor ||
+        (_lastSeenId.isNull() && !_params.start.isNull())) {
+        return PlanStage::doWorkBatch(maxCount, results, out);
+    }
+
+    // Pull a whole batch out of the storage cursor at once. On a write conflict, any records the
+    // cursor handed back before the conflict have already been consumed from it and must still be
+    // processed below, or the scan would silently skip them on retry.
+    std::vector<Record> batch;
+    batch.reserve(maxCount);
+    bool hitEof = false;
+    bool needYield = false;
+    try {
+        hitEof = _cursor->nextBatch(maxCount, &batch) < maxCount;
+    } catch (const WriteConflictException&) {
+        needYield = true;
+    }
+
+    for (auto&& record : batch) {
+        ++_commonStats.works;
+
+        _lastSeenId = record.id;
+        if (_params.shouldTrackLatestOplogTimestamp) {
+            auto status = setLatestOplogEntryTimestamp(record);
+            if (!status.isOK()) {
+                *out = WorkingSetCommon::allocateStatusMember(_workingSet, status);
+                return PlanStage::FAILURE;
+            }
+        }
+
+        WorkingSetID id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = record.id;
+        member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), record.data.releaseToBson()};
+        _workingSet->transitionToRecordIdAndObj(id);
+
+        WorkingSetID matchedId = WorkingSet::INVALID_ID;
+        StageState state = returnIfMatches(member, id, &matchedId);
+        if (PlanStage::ADVANCED == state) {
+            ++_commonStats.advanced;
+            results->push_back(matchedId);
+        } else if (PlanStage::NEED_TIME == state) {
+            ++_commonStats.needTime;
+        } else {
+            invariant(PlanStage::IS_EOF == state);  // The end condition matched.
+            return state;
+        }
+    }
+
+    if (needYield) {
+        ++_commonStats.needYield;
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    if (hitEof) {
+        // Same EOF handling as doWork(): a tailable scan that has returned data already gets to
+        // pick up where it left off on a later call.
+        if (_params.tailable && !_lastSeenId.isNull()) {
+            _cursor.reset();
+        } else {
+            _commonStats.isEOF = true;
+        }
+        return PlanStage::IS_EOF;
+    }
+
+    return results->empty() ? PlanStage::NEED_TIME : PlanStage::ADVANCED;
+}
+
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     if (tsElem.type() != BSONType::bsonTimestamp) {
@@ -56,6 +56,9 @@ public:
                    const MatchExpression* filter);
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxCount,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
     bool isEOF() final;
 
     void doSaveState() final;
@@ -53,19 +53,15 @@ FetchStage::FetchStage(OperationContext* opCtx,
                        PlanStage* child,
                        const MatchExpression* filter,
                        const Collection* collection)
-    : PlanStage(kStageType, opCtx),
-      _collection(collection),
-      _ws(ws),
-      _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {
+    : PlanStage(kStageType, opCtx), _collection(collection), _ws(ws), _filter(filter) {
     _children.emplace_back(child);
 }
 
 FetchStage::~FetchStage() {}
 
 bool FetchStage::isEOF() {
-    if (WorkingSet::INVALID_ID != _idRetrying) {
-        // We have a working set member that we need to retry.
+    if (!_idsRetrying.empty()) {
+        // We have working set members that we need to retry.
         return false;
     }
 
@@ -77,15 +73,15 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // Either retry the last WSM we worked on or get a new one from our child.
+    // Either retry the next WSM we need to work on or get a new one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
+    if (_idsRetrying.empty()) {
         status = child()->work(&id);
     } else {
         status = ADVANCED;
-        id = _idRetrying;
-        _idRetrying = WorkingSet::INVALID_ID;
+        id = _idsRetrying.front();
+        _idsRetrying.pop_front();
     }
 
     if (PlanStage::ADVANCED == status) {
@@ -111,7 +107,7 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
                 // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
                 // be freed when we yield.
                 member->makeObjOwnedIfNeeded();
-                _idRetrying = id;
+                _idsRetrying.push_front(id);
                 *out = WorkingSet::INVALID_ID;
                 return NEED_YIELD;
             }
@@ -131,6 +127,92 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatch(size_t maxCount,
+                                              std::vector<WorkingSetID>* results,
+                                              WorkingSetID* out) {
+    // Drain any retries one at a time through doWork(); batching resumes once they are gone.
+    if (!_idsRetrying.empty() || isEOF()) {
+        return PlanStage::doWorkBatch(maxCount, results, out);
+    }
+
+    // Pull a batch from the child, then fetch all of the missing documents in one pass over the
+    // record store, which visits them in RecordId order on a single cursor regardless of the
+    // order the index scan produced them in.
+    std::vector<WorkingSetID> childBatch;
+    WorkingSetID childOut = WorkingSet::INVALID_ID;
+    const StageState childState = child()->workBatch(maxCount, &childBatch, &childOut);
+
+    std::vector<RecordId> idsToFetch;
+    for (WorkingSetID id : childBatch) {
+        WorkingSetMember* member = _ws->get(id);
+        if (!member->hasObj()) {
+            // We need a valid RecordId to fetch from and this is the only state that has one.
+            verify(WorkingSetMember::RID_AND_IDX == member->getState());
+            verify(member->hasRecordId());
+            idsToFetch.push_back(member->recordId);
+        }
+    }
+
+    std::vector<RecordData> fetchedData;
+    if (!idsToFetch.empty()) {
+        try {
+            _collection->getRecordStore()->findRecords(getOpCtx(), idsToFetch, &fetchedData);
+        } catch (const WriteConflictException&) {
+            if (PlanStage::FAILURE == childState || PlanStage::DEAD == childState) {
+                // The query is over regardless; surface the terminal state.
+                *out = childOut;
+                return childState;
+            }
+            // None of the members have been transitioned yet; retry each of them individually
+            // after the yield.
+            for (WorkingSetID id : childBatch) {
+                _ws->get(id)->makeObjOwnedIfNeeded();
+                _idsRetrying.push_back(id);
+            }
+            ++_commonStats.needYield;
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
+        }
+    }
+
+    size_t fetchIdx = 0;
+    for (WorkingSetID id : childBatch) {
+        ++_commonStats.works;
+        WorkingSetMember* member = _ws->get(id);
+
+        if (member->hasObj()) {
+            ++_specificStats.alreadyHasObj;
+        } else {
+            RecordData& data = fetchedData[fetchIdx++];
+            if (!data.data() || !WorkingSetCommon::fetch(getOpCtx(), _ws, id, std::move(data))) {
+                // The document was deleted, or no longer matches its index entry.
+                _ws->free(id);
+                ++_commonStats.needTime;
+                continue;
+            }
+        }
+
+        WorkingSetID matchedId = WorkingSet::INVALID_ID;
+        if (PlanStage::ADVANCED == returnIfMatches(member, id, &matchedId)) {
+            ++_commonStats.advanced;
+            results->push_back(matchedId);
+        } else {
+            ++_commonStats.needTime;
+        }
+    }
+
+    switch (childState) {
+        case PlanStage::ADVANCED:
+        case PlanStage::NEED_TIME:
+            return results->empty() ? PlanStage::NEED_TIME : PlanStage::ADVANCED;
+        default:
+            // IS_EOF, NEED_YIELD, DEAD and FAILURE end the batch; results appended above remain
+            // valid for the caller.
+            *out = childOut;
+            return childState;
+    }
+}
+
 void FetchStage::doSaveState() {
     if (_cursor)
         _cursor->saveUnpositioned();
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -59,6 +60,9 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxCount,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
 
     void doSaveState() final;
     void doRestoreState() final;
@@ -94,8 +98,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
-    // If not Null, we use this rather than asking our child what to do next.
-    WorkingSetID _idRetrying;
+    // If not empty, we return these members rather than asking our child what to do next. Used
+    // to retry after a WriteConflictException; the batched path may queue a whole batch here.
+    std::deque<WorkingSetID> _idsRetrying;
 
     // Stats
     FetchStats _specificStats;
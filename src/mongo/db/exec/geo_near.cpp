@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/geo_near.h"
 
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -1017,6 +1018,18 @@ PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* opCtx,
     return state;
 }
 
+namespace {
+
+// Number of results we aim to buffer per search interval. This matches the lower edge of the
+// window the old fixed double/halve heuristic targeted.
+const long long kTargetIntervalResults = 300;
+
+// Bound on how much the annulus increment may grow or shrink between intervals, so one
+// unrepresentative interval cannot swing the search radius wildly.
+const double kMaxBoundsIncrementGrowth = 4.0;
+
+}  // namespace
+
 StatusWith<NearStage::CoveredInterval*>  //
     GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
                                        WorkingSet* workingSet,
@@ -1031,13 +1044,35 @@ StatusWith<NearStage::CoveredInterval*>  //
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
+        // Grow the next interval based on the result density observed over everything searched
+        // so far, aiming for a constant expected number of buffered results per interval. Dense
+        // regions get thin rings, and sparse regions get wide ones instead of dozens of
+        // near-empty interval scans.
+        long long totalBuffered = 0;
+        for (const IntervalStats& intervalStats : _specificStats.intervalStats) {
+            totalBuffered += intervalStats.numResultsBuffered;
+        }
 
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        const double innerRadius = _fullBounds.getInner();
+        const double outerRadius = _currBounds.getOuter();
+        const double searchedArea =
+            M_PI * (outerRadius * outerRadius - innerRadius * innerRadius);
+
+        if (totalBuffered > 0 && searchedArea > 0) {
+            const double density = totalBuffered / searchedArea;
+            _specificStats.estimatedResultDensity = density;
+
+            // Solve for the ring whose expected result count at this density is the target.
+            const double targetOuter = std::sqrt(outerRadius * outerRadius +
+                                                 kTargetIntervalResults / (density * M_PI));
+            _boundsIncrement = std::max(std::min(targetOuter - outerRadius,
+                                                 _boundsIncrement * kMaxBoundsIncrementGrowth),
+                                        _boundsIncrement / kMaxBoundsIncrementGrowth);
+        } else {
+            // No results yet, so no density signal; grow as fast as allowed to escape the
+            // empty region.
+            _boundsIncrement *= kMaxBoundsIncrementGrowth;
+        }
     }
 
     invariant(_boundsIncrement > 0.0);
@@ -40,6 +40,7 @@
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -134,10 +135,37 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
             case GETTING_NEXT:
                 kv = _indexCursor->next();
                 break;
-            case NEED_SEEK:
-                ++_specificStats.seeks;
-                kv = _indexCursor->seek(_seekPoint);
+            case NEED_SEEK: {
+                // The intervals of a multi-interval scan are visited in index order, so the start
+                // of the next interval is often just a few keys ahead of the cursor's current
+                // position. Probe forward with next() first: a probe is a step within the current
+                // leaf, whereas seek() pays a full descent of the index tree. If the probes don't
+                // reach the next interval, fall back to the seek with the latest seek point.
+                bool found = false;
+                while (_gallopBudget > 0) {
+                    --_gallopBudget;
+                    kv = _indexCursor->next();
+                    if (!kv) {
+                        // Ran off the end of the index; let the EOF handling below take over.
+                        found = true;
+                        break;
+                    }
+                    IndexBoundsChecker::KeyCheck keyCheck =
+                        _checker->checkKey(kv->key, &_seekPoint);
+                    if (IndexBoundsChecker::MUST_ADVANCE != keyCheck) {
+                        // VALID or DONE; the checkKey() call below re-derives this cheaply.
+                        found = true;
+                        break;
+                    }
+                    // Still short of the next interval; count the key we stepped over.
+                    ++_specificStats.keysExamined;
+                }
+                if (!found) {
+                    ++_specificStats.seeks;
+                    kv = _indexCursor->seek(_seekPoint);
+                }
                 break;
+            }
             case HIT_END:
                 return PlanStage::IS_EOF;
         }
@@ -180,6 +208,7 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
             case IndexBoundsChecker::MUST_ADVANCE:
                 _scanState = NEED_SEEK;
+                _gallopBudget = internalQueryIndexScanGallopBeforeSeek.load();
                 return PlanStage::NEED_TIME;
         }
     }
@@ -236,6 +265,9 @@ void IndexScan::doSaveState() {
         return;
 
     if (_scanState == NEED_SEEK) {
+        // The cursor loses its position, so probing forward from it is no longer meaningful; the
+        // next NEED_SEEK pass must do a real seek.
+        _gallopBudget = 0;
         _indexCursor->saveUnpositioned();
         return;
     }
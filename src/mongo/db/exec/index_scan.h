@@ -189,6 +189,11 @@ private:
     std::unique_ptr<IndexBoundsChecker> _checker;
     IndexSeekPoint _seekPoint;
 
+    // While in the NEED_SEEK state, the number of forward cursor probes we may still make in
+    // search of the next interval before falling back to a full seek. Only meaningful while the
+    // cursor is positioned; reset to zero whenever the cursor is saved unpositioned.
+    int _gallopBudget = 0;
+
     //
     // 2) If the index scan is a single contiguous interval, then the scan can execute faster by
     //    letting the index cursor tell us when it hits the end, rather than repeatedly doing
@@ -84,6 +84,50 @@ PlanStage::StageState MultiIteratorStage::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState MultiIteratorStage::doWorkBatch(size_t maxCount,
+                                                      std::vector<WorkingSetID>* results,
+                                                      WorkingSetID* out) {
+    // Let doWork() produce the status member if the stage has been killed.
+    if (_collection == NULL) {
+        return PlanStage::doWorkBatch(maxCount, results, out);
+    }
+
+    // Drain the partition cursors in a tight loop. When one partition is exhausted we fall
+    // through to the next within the same batch, so consumers see a steady stream of full
+    // batches regardless of how the collection was partitioned.
+    while (maxCount--) {
+        ++_commonStats.works;
+
+        boost::optional<Record> record;
+        try {
+            while (!_iterators.empty()) {
+                record = _iterators.back()->next();
+                if (record)
+                    break;
+                _iterators.pop_back();
+            }
+        } catch (const WriteConflictException&) {
+            // If _advance throws a WCE we shouldn't have moved.
+            invariant(!_iterators.empty());
+            ++_commonStats.needYield;
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+
+        if (!record)
+            return IS_EOF;
+
+        WorkingSetID id = _ws->allocate();
+        WorkingSetMember* member = _ws->get(id);
+        member->recordId = record->id;
+        member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
+        _ws->transitionToRecordIdAndObj(id);
+        ++_commonStats.advanced;
+        results->push_back(id);
+    }
+    return results->empty() ? PlanStage::NEED_TIME : PlanStage::ADVANCED;
+}
+
 bool MultiIteratorStage::isEOF() {
     return _collection == NULL || _iterators.empty();
 }
@@ -51,6 +51,9 @@ public:
     void addIterator(std::unique_ptr<RecordCursor> it);
 
     PlanStage::StageState doWork(WorkingSetID* out) final;
+    PlanStage::StageState doWorkBatch(size_t maxCount,
+                                      std::vector<WorkingSetID>* results,
+                                      WorkingSetID* out) final;
 
     bool isEOF() final;
 
@@ -45,6 +45,7 @@
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -205,6 +206,14 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     size_t numWorks = getTrialPeriodWorks(getOpCtx(), _collection);
     size_t numResults = getTrialPeriodNumToReturn(*_query);
 
+    // The works-based trial limit scales with the collection size, so on large collections a
+    // trial in which no candidate reaches EOF or fills its result quota can run for a very long
+    // time. If enabled, bound the trial by wall-clock time as well; ranking is then performed on
+    // the statistics gathered so far.
+    const int maxTimeMillis = internalQueryPlanEvaluationMaxTimeMillis.load();
+    const Date_t trialDeadline = maxTimeMillis > 0 ? getClock()->now() + Milliseconds(maxTimeMillis)
+                                                   : Date_t::max();
+
     // Work the plans, stopping when a plan hits EOF or returns some
     // fixed number of results.
     for (size_t ix = 0; ix < numWorks; ++ix) {
@@ -212,6 +221,11 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         if (!moreToDo) {
             break;
         }
+        if (maxTimeMillis > 0 && getClock()->now() >= trialDeadline) {
+            LOG(2) << "Plan evaluation trial period hit the " << maxTimeMillis
+                   << "ms time limit after " << (ix + 1) << " rounds; ranking with partial stats";
+            break;
+        }
     }
 
     if (_failure) {
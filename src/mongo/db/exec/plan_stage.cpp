@@ -32,6 +32,8 @@
 
 #include "mongo/db/exec/plan_stage.h"
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
@@ -40,7 +42,10 @@ namespace mongo {
 
 PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     invariant(_opCtx);
-    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    boost::optional<ScopedTimer> timer;
+    if (_collectTimingInfo) {
+        timer.emplace(getClock(), &_commonStats.executionTimeMillis);
+    }
     ++_commonStats.works;
 
     StageState workResult = doWork(out);
@@ -56,6 +61,42 @@ PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     return workResult;
 }
 
+PlanStage::StageState PlanStage::workBatch(size_t maxCount,
+                                           std::vector<WorkingSetID>* results,
+                                           WorkingSetID* out) {
+    invariant(_opCtx);
+    boost::optional<ScopedTimer> timer;
+    if (_collectTimingInfo) {
+        timer.emplace(getClock(), &_commonStats.executionTimeMillis);
+    }
+
+    return doWorkBatch(maxCount, results, out);
+}
+
+PlanStage::StageState PlanStage::doWorkBatch(size_t maxCount,
+                                             std::vector<WorkingSetID>* results,
+                                             WorkingSetID* out) {
+    while (maxCount--) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState workResult = doWork(&id);
+        ++_commonStats.works;
+
+        if (StageState::ADVANCED == workResult) {
+            ++_commonStats.advanced;
+            results->push_back(id);
+        } else if (StageState::NEED_TIME == workResult) {
+            ++_commonStats.needTime;
+        } else {
+            if (StageState::NEED_YIELD == workResult) {
+                ++_commonStats.needYield;
+            }
+            *out = id;
+            return workResult;
+        }
+    }
+    return results->empty() ? PlanStage::NEED_TIME : PlanStage::ADVANCED;
+}
+
 void PlanStage::saveState() {
     ++_commonStats.yields;
     for (auto&& child : _children) {
@@ -187,6 +187,25 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Batched form of work(). Produces up to 'maxCount' units of output in a single call,
+     * appending the WorkingSetID of each ADVANCED result to 'results'. NEED_TIME results are
+     * absorbed inside the loop, so scan-heavy plans pay for the per-call timing and stats
+     * bookkeeping once per batch rather than once per document.
+     *
+     * Returns ADVANCED when the batch filled up, and otherwise the state that terminated the
+     * batch. Any results appended to 'results' are valid regardless of the return value, and
+     * must be consumed (or freed) by the caller before acting on a NEED_YIELD, DEAD or FAILURE
+     * state. For those states, 'out' carries the same WSID that work() would have returned.
+     */
+    StageState workBatch(size_t maxCount, std::vector<WorkingSetID>* results, WorkingSetID* out);
+
+    /**
+     * Suggested number of WorkingSetIDs to request per workBatch() call. Large enough to amortize
+     * the per-batch overhead, small enough that a batch of members stays cache resident.
+     */
+    static const size_t kDefaultBatchSize = 128;
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -286,6 +305,19 @@ public:
         return _children.front();
     }
 
+    /**
+     * Turns on collection of per-stage execution time. Collecting it costs two clock reads per
+     * work() call per stage, so it stays off unless something will actually report it: explain
+     * at executionStats verbosity and the profiler mark the tree before running it. Propagates
+     * to all current children.
+     */
+    void markShouldCollectTimingInfo() {
+        _collectTimingInfo = true;
+        for (auto&& child : _children) {
+            child->markShouldCollectTimingInfo();
+        }
+    }
+
     /**
      * What type of stage is this?
      */
@@ -331,6 +363,16 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Batched counterpart of doWork(), with the contract described at workBatch(). The default
+     * implementation drives doWork() in a loop; stages that sit directly on a storage cursor
+     * (e.g. CollectionScan) override this to drain the cursor without per-document stage
+     * dispatch.
+     */
+    virtual StageState doWorkBatch(size_t maxCount,
+                                   std::vector<WorkingSetID>* results,
+                                   WorkingSetID* out);
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
@@ -374,6 +416,9 @@ protected:
     Children _children;
     CommonStats _commonStats;
 
+    // Whether work() should accumulate executionTimeMillis. See markShouldCollectTimingInfo().
+    bool _collectTimingInfo = false;
+
 private:
     OperationContext* _opCtx;
 };
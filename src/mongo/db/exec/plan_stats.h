@@ -566,6 +566,9 @@ struct NearStats : public SpecificStats {
     }
 
     std::vector<IntervalStats> intervalStats;
+    // Latest observed result density (results per square unit of annulus searched) used to size
+    // search intervals; -1 until an interval buffers results.
+    double estimatedResultDensity = -1;
     std::string indexName;
     // btree index version, not geo index version
     int indexVersion;
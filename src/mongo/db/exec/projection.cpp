@@ -61,8 +61,8 @@ ProjectionStage::ProjectionStage(OperationContext* opCtx,
     _projObj = params.projObj;
 
     if (ProjectionStageParams::NO_FAST_PATH == _projImpl) {
-        _exec.reset(
-            new ProjectionExec(opCtx, params.projObj, params.fullExpression, params.collator));
+        _exec = ProjectionExec::getCached(
+            opCtx, params.projObj, params.fullExpression, params.collator);
     } else {
         // We shouldn't need the full expression if we're fast-pathing.
         invariant(NULL == params.fullExpression);
@@ -94,6 +94,8 @@ ProjectionStage::ProjectionStage(OperationContext* opCtx,
                     // If we are including this key field store its field name.
                     _keyFieldNames.push_back(fieldIt->first);
                     _includeKey.push_back(true);
+                    _lastIncludedKeyIndex = static_cast<int>(_includeKey.size()) - 1;
+                    _includedKeyNameBytes += fieldIt->first.size();
                 }
             }
         } else {
@@ -148,7 +150,15 @@ Status ProjectionStage::transform(WorkingSetMember* member) {
         return _exec->transform(member);
     }
 
-    BSONObjBuilder bob;
+    // Size the output buffer up front (the projection can't produce more value bytes than its
+    // input has) so the projected bytes are copied exactly once.
+    int sizeHint = 64;
+    if (member->hasObj()) {
+        sizeHint = member->obj.value().objsize();
+    } else if (1 == member->keyData.size()) {
+        sizeHint = member->keyData[0].keyData.objsize() + _includedKeyNameBytes + 16;
+    }
+    BSONObjBuilder bob(sizeHint);
 
     // SIMPLE_DOC implies that we expect an object so it's kind of redundant.
     if ((ProjectionStageParams::SIMPLE_DOC == _projImpl) || member->hasObj()) {
@@ -161,18 +171,17 @@ Status ProjectionStage::transform(WorkingSetMember* member) {
         invariant(ProjectionStageParams::COVERED_ONE_INDEX == _projImpl);
         // We're pulling data out of the key.
         invariant(1 == member->keyData.size());
-        size_t keyIndex = 0;
 
-        // Look at every key element...
+        // Look at every key element up to the last one we include; trailing key fields that are
+        // not part of the projection never need to be decoded.
         BSONObjIterator keyIterator(member->keyData[0].keyData);
-        while (keyIterator.more()) {
+        for (int keyIndex = 0; keyIndex <= _lastIncludedKeyIndex; ++keyIndex) {
             BSONElement elt = keyIterator.next();
             // If we're supposed to include it...
             if (_includeKey[keyIndex]) {
                 // Do so.
                 bob.appendAs(elt, _keyFieldNames[keyIndex]);
             }
-            ++keyIndex;
         }
     }
 
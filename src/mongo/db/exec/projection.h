@@ -115,7 +115,8 @@ public:
 private:
     Status transform(WorkingSetMember* member);
 
-    std::unique_ptr<ProjectionExec> _exec;
+    // Possibly shared with other queries projecting the same shape; see ProjectionExec::getCached.
+    std::shared_ptr<const ProjectionExec> _exec;
 
     // _ws is not owned by us.
     WorkingSet* _ws;
@@ -144,6 +145,14 @@ private:
 
     // If the i-th entry of _includeKey is true this is the field name for the i-th key field.
     std::vector<StringData> _keyFieldNames;
+
+    // Index of the last true entry in _includeKey, or -1 if there is none. Lets the covered
+    // transform stop decoding key fields once everything included has been copied out.
+    int _lastIncludedKeyIndex = -1;
+
+    // Total length of the output field names of the included key fields, used to size the output
+    // builder so covered key bytes are copied exactly once.
+    int _includedKeyNameBytes = 0;
 };
 
 }  // namespace mongo
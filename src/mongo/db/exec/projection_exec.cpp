@@ -33,8 +33,10 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/lru_key_value.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/db/update/path_support.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -65,8 +67,65 @@ Status addSortKeyMetaProj(StringData fieldName,
     return Status::OK();
 }
 
+// The executor cache. Keyed on the raw bytes of the projection spec, so two queries hit the same
+// entry exactly when their projections are byte-for-byte identical. Only executors passing
+// isCacheable() (no per-query or per-collation state) go in, so entries can be shared freely
+// across threads; transform() is const.
+const size_t kMaxCachedProjectionExecs = 128;
+
+stdx::mutex executorCacheMutex;
+LRUKeyValue<std::string, std::shared_ptr<const ProjectionExec>>& executorCache() {
+    static LRUKeyValue<std::string, std::shared_ptr<const ProjectionExec>> cache(
+        kMaxCachedProjectionExecs);
+    return cache;
+}
+
 }  // namespace
 
+// static
+bool ProjectionExec::isCacheable(const BSONObj& spec) {
+    for (auto&& elt : spec) {
+        // Positional projections consult the query's MatchDetails per document.
+        if (mongoutils::str::contains(elt.fieldName(), ".$")) {
+            return false;
+        }
+        // $elemMatch compiles the predicate, under the query's collation, into the executor.
+        if (Object == elt.type() &&
+            mongoutils::str::equals(elt.embeddedObject().firstElementFieldName(), "$elemMatch")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// static
+std::shared_ptr<const ProjectionExec> ProjectionExec::getCached(
+    OperationContext* opCtx,
+    const BSONObj& spec,
+    const MatchExpression* queryExpression,
+    const CollatorInterface* collator) {
+    if (!isCacheable(spec)) {
+        return std::make_shared<const ProjectionExec>(opCtx, spec, queryExpression, collator);
+    }
+
+    std::string key(spec.objdata(), spec.objsize());
+    {
+        stdx::lock_guard<stdx::mutex> lk(executorCacheMutex);
+        std::shared_ptr<const ProjectionExec>* entry;
+        if (executorCache().get(key, &entry).isOK()) {
+            return *entry;
+        }
+    }
+
+    // Compile outside the lock; a concurrent query compiling the same shape just replaces the
+    // entry with an equivalent one. The cached executor must own its spec since it outlives the
+    // query that compiled it.
+    auto exec = std::make_shared<const ProjectionExec>(opCtx, spec.getOwned(), nullptr, collator);
+    stdx::lock_guard<stdx::mutex> lk(executorCacheMutex);
+    executorCache().add(key, new std::shared_ptr<const ProjectionExec>(exec));
+    return exec;
+}
+
 ProjectionExec::ProjectionExec()
     : _include(true),
       _special(false),
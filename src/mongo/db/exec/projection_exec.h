@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
@@ -73,6 +75,24 @@ public:
 
     ~ProjectionExec();
 
+    /**
+     * Returns true if 'spec' compiles to an executor that does not depend on the query predicate
+     * or the collation, and can therefore be shared across queries projecting the same shape.
+     * Positional projections need per-query MatchDetails and $elemMatch compiles the predicate
+     * (under the query's collation) into the executor, so neither is shareable.
+     */
+    static bool isCacheable(const BSONObj& spec);
+
+    /**
+     * Returns an executor for 'spec', consulting a process-wide LRU cache of compiled executors
+     * keyed on the projection shape. Repeated queries with the same projection skip the spec
+     * analysis entirely; specs that fail isCacheable() are compiled fresh each call.
+     */
+    static std::shared_ptr<const ProjectionExec> getCached(OperationContext* opCtx,
+                                                           const BSONObj& spec,
+                                                           const MatchExpression* queryExpression,
+                                                           const CollatorInterface* collator);
+
     /**
      * Apply this projection to the 'member'.  Changes the type to OWNED_OBJ.
      */
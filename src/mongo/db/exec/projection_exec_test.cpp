@@ -384,4 +384,37 @@ TEST(ProjectionExecTest, TransformMetaSortKeyCoveredCompound3) {
     ASSERT_BSONOBJ_EQ(actualOut, expectedOut);
 }
 
+//
+// executor cache
+//
+
+TEST(ProjectionExecTest, CacheabilityDependsOnQueryAndCollationIndependence) {
+    ASSERT_TRUE(ProjectionExec::isCacheable(fromjson("{a: 1, b: 1}")));
+    ASSERT_TRUE(ProjectionExec::isCacheable(fromjson("{_id: 0, a: 1}")));
+    ASSERT_TRUE(ProjectionExec::isCacheable(fromjson("{a: {$slice: 2}}")));
+    ASSERT_FALSE(ProjectionExec::isCacheable(fromjson("{'a.$': 1}")));
+    ASSERT_FALSE(ProjectionExec::isCacheable(fromjson("{a: {$elemMatch: {b: 1}}}")));
+}
+
+TEST(ProjectionExecTest, GetCachedSharesExecutorsAcrossIdenticalSpecs) {
+    QueryTestServiceContext serviceCtx;
+    auto opCtx = serviceCtx.makeOperationContext();
+    const BSONObj spec = fromjson("{_id: 0, cachedSpecField: 1}");
+
+    auto first = ProjectionExec::getCached(opCtx.get(), spec, nullptr, nullptr);
+    auto second = ProjectionExec::getCached(opCtx.get(), spec, nullptr, nullptr);
+    ASSERT_EQUALS(first.get(), second.get());
+}
+
+TEST(ProjectionExecTest, GetCachedCompilesUncacheableSpecsFresh) {
+    QueryTestServiceContext serviceCtx;
+    auto opCtx = serviceCtx.makeOperationContext();
+    const BSONObj spec = fromjson("{'a.$': 1}");
+    unique_ptr<MatchExpression> queryExpression = parseMatchExpression(fromjson("{a: 1}"));
+
+    auto first = ProjectionExec::getCached(opCtx.get(), spec, queryExpression.get(), nullptr);
+    auto second = ProjectionExec::getCached(opCtx.get(), spec, queryExpression.get(), nullptr);
+    ASSERT_NOT_EQUALS(first.get(), second.get());
+}
+
 }  // namespace
@@ -123,4 +123,39 @@ TEST_F(QueuedDataStageTest, validateStats) {
     unique_ptr<PlanStageStats> allStats(mock->getStats());
     ASSERT_TRUE(stats->isEOF);
 }
+
+//
+// Test that the default batched work path collects ADVANCED results, absorbs NEED_TIME, and
+// surfaces the terminating state.
+//
+TEST_F(QueuedDataStageTest, workBatchCollectsResults) {
+    WorkingSet ws;
+    auto mock = make_unique<QueuedDataStage>(getOpCtx(), &ws);
+
+    WorkingSetID first = ws.allocate();
+    WorkingSetID second = ws.allocate();
+    mock->pushBack(first);
+    mock->pushBack(PlanStage::NEED_TIME);
+    mock->pushBack(second);
+
+    std::vector<WorkingSetID> results;
+    WorkingSetID wsID = WorkingSet::INVALID_ID;
+
+    // A batch large enough for everything queued: both results come back in order, the NEED_TIME
+    // is absorbed, and the batch reports ADVANCED.
+    ASSERT_EQUALS(PlanStage::ADVANCED, mock->workBatch(3, &results, &wsID));
+    ASSERT_EQUALS(2U, results.size());
+    ASSERT_EQUALS(first, results[0]);
+    ASSERT_EQUALS(second, results[1]);
+
+    const CommonStats* stats = mock->getCommonStats();
+    ASSERT_EQUALS(stats->works, 3U);
+    ASSERT_EQUALS(stats->advanced, 2U);
+    ASSERT_EQUALS(stats->needTime, 1U);
+
+    // The queue is now empty, so the next batch terminates with IS_EOF and adds nothing.
+    results.clear();
+    ASSERT_EQUALS(PlanStage::IS_EOF, mock->workBatch(3, &results, &wsID));
+    ASSERT_TRUE(results.empty());
+}
 }
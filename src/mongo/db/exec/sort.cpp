@@ -84,11 +84,10 @@ SortStage::SortStage(OperationContext* opCtx,
     BSONObj sortComparator = FindCommon::transformSortSpec(_pattern);
     _sortKeyComparator = stdx::make_unique<WorkingSetComparator>(sortComparator);
 
-    // If limit > 1, we need to initialize _dataSet here to maintain ordered set of data items while
+    // If limit > 1, only the best _limit items are kept, arranged as a heap in _data while
     // fetching from the child stage.
     if (_limit > 1) {
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        _dataSet.reset(new SortableDataItemSet(cmp));
+        _data.reserve(_limit);
     }
 }
 
@@ -205,10 +204,12 @@ const SpecificStats* SortStage::getSpecificStats() const {
  *                     Updates memory usage if item was replaced.
  *     sortBuffer() - Does nothing.
  * limit > 1:
- *     addToBuffer() - Does not update vector. Adds item to set.
- *                     If size of set exceeds limit, remove item from set
- *                     with lowest key. Updates memory usage accordingly.
- *     sortBuffer() - Copies items from set to vectors.
+ *     addToBuffer() - Maintains the vector as a bounded max-heap of the
+ *                     best 'limit' items, with the worst kept item at the
+ *                     front. A candidate that does not beat the front is
+ *                     rejected with one comparison; one that does replaces
+ *                     the front. Updates memory usage accordingly.
+ *     sortBuffer() - Sorts the heap in place (sort_heap).
  */
 void SortStage::addToBuffer(const SortableDataItem& item) {
     // Holds ID of working set member to be freed at end of this function.
@@ -237,33 +238,26 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             _memUsage = member->getMemUsage();
         }
     } else {
-        // Update data item set instead of vector
-        // Limit not reached - insert and return
-        vector<SortableDataItem>::size_type limit(_limit);
-        if (_dataSet->size() < limit) {
+        const WorkingSetComparator& cmp = *_sortKeyComparator;
+        // Limit not reached - push onto the heap and return.
+        if (_data.size() < _limit) {
             member->makeObjOwnedIfNeeded();
-            _dataSet->insert(item);
+            _data.push_back(item);
+            std::push_heap(_data.begin(), _data.end(), cmp);
             _memUsage += member->getMemUsage();
             return;
         }
-        // Limit will be exceeded - compare with item with lowest key
-        // If new item does not have a lower key value than last item,
-        // do nothing.
+        // Limit would be exceeded - compare with the worst kept item, which the heap keeps at
+        // the front. If the new item does not beat it, do nothing.
         wsidToFree = item.wsid;
-        SortableDataItemSet::const_iterator lastItemIt = --(_dataSet->end());
-        const SortableDataItem& lastItem = *lastItemIt;
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        if (cmp(item, lastItem)) {
-            _memUsage -= _ws->get(lastItem.wsid)->getMemUsage();
+        if (cmp(item, _data.front())) {
+            wsidToFree = _data.front().wsid;
+            _memUsage -= _ws->get(_data.front().wsid)->getMemUsage();
             _memUsage += member->getMemUsage();
-            wsidToFree = lastItem.wsid;
-            // According to std::set iterator validity rules,
-            // it does not matter which of erase()/insert() happens first.
-            // Here, we choose to erase first to release potential resources
-            // used by the last item and to keep the scope of the iterator to a minimum.
-            _dataSet->erase(lastItemIt);
             member->makeObjOwnedIfNeeded();
-            _dataSet->insert(item);
+            std::pop_heap(_data.begin(), _data.end(), cmp);
+            _data.back() = item;
+            std::push_heap(_data.begin(), _data.end(), cmp);
         }
     }
 
@@ -283,12 +277,9 @@ void SortStage::sortBuffer() {
         // Buffer contains either 0 or 1 item so it is already in a sorted state.
         return;
     } else {
-        // Set already contains items in sorted order, so we simply copy the items
-        // from the set to the vector.
-        // Release the memory for the set after the copy.
-        vector<SortableDataItem> newData(_dataSet->begin(), _dataSet->end());
-        _data.swap(newData);
-        _dataSet.reset();
+        // The vector is arranged as a max-heap, so sorting it in place yields ascending order.
+        const WorkingSetComparator& cmp = *_sortKeyComparator;
+        std::sort_heap(_data.begin(), _data.end(), cmp);
     }
 }
 
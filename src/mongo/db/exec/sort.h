@@ -28,7 +28,6 @@
 
 #pragma once
 
-#include <set>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -137,16 +136,14 @@ private:
     };
 
     /**
-     * Inserts one item into data buffer (vector or set).
-     * If limit is exceeded, remove item with lowest key.
+     * Inserts one item into the data buffer.
+     * If the limit would be exceeded, evicts the item with the highest key.
      */
     void addToBuffer(const SortableDataItem& item);
 
     /**
-     * Sorts data buffer.
-     * Assumes no more items will be added to buffer.
-     * If data is stored in set, copy set
-     * contents to vector and clear set.
+     * Sorts the data buffer.
+     * Assumes no more items will be added to the buffer.
      */
     void sortBuffer();
 
@@ -155,15 +152,13 @@ private:
     std::unique_ptr<WorkingSetComparator> _sortKeyComparator;
 
     // The data we buffer and sort.
-    // _data will contain sorted data when all data is gathered
-    // and sorted.
-    // When _limit is greater than 1 and not all data has been gathered from child stage,
-    // _dataSet is used instead to maintain an ordered set of the incomplete data set.
-    // When the data set is complete, we copy the items from _dataSet to _data which will
-    // be used to provide the results of this stage through _resultIterator.
+    // _data will contain sorted data when all data is gathered and sorted.
+    // When _limit is greater than 1 and not all data has been gathered from the child stage,
+    // _data is arranged as a bounded max-heap of the best _limit items seen so far, with the
+    // worst kept item at the front. The heap lives in the same contiguous vector that later
+    // serves the sorted results, so maintaining the top K costs no per-item allocation and a
+    // losing candidate is rejected with a single comparison against the front.
     std::vector<SortableDataItem> _data;
-    typedef std::set<SortableDataItem, WorkingSetComparator> SortableDataItemSet;
-    std::unique_ptr<SortableDataItemSet> _dataSet;
 
     // Iterates through _data post-sort returning it.
     std::vector<SortableDataItem>::iterator _resultIterator;
@@ -237,6 +237,23 @@ TEST_F(SortStageTest, SortDescendingWithLimit) {
         "{a: -1}", nullptr, 2, "{input: [{a: 2}, {a: 1}, {a: 3}]}", "{output: [{a: 3}, {a: 2}]}");
 }
 
+TEST_F(SortStageTest, SortAscendingWithLimitEvictsWorstAcrossManyCandidates) {
+    // Enough input to force repeated heap evictions in both directions.
+    testWork("{a: 1}",
+             nullptr,
+             3,
+             "{input: [{a: 7}, {a: 2}, {a: 9}, {a: 4}, {a: 1}, {a: 8}, {a: 3}, {a: 6}, {a: 5}]}",
+             "{output: [{a: 1}, {a: 2}, {a: 3}]}");
+}
+
+TEST_F(SortStageTest, SortDescendingWithLimitEvictsWorstAcrossManyCandidates) {
+    testWork("{a: -1}",
+             nullptr,
+             3,
+             "{input: [{a: 7}, {a: 2}, {a: 9}, {a: 4}, {a: 1}, {a: 8}, {a: 3}, {a: 6}, {a: 5}]}",
+             "{output: [{a: 9}, {a: 8}, {a: 7}]}");
+}
+
 //
 // Sorting with limit > size of data set
 // Implementation should retain top N items
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/write_stage_common.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/ops/update_lifecycle.h"
+#include "mongo/db/pipeline/document_diff.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -325,7 +326,28 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                   << BSONObjMaxUserSize,
                     newObj.objsize() <= BSONObjMaxUserSize);
 
-            if (!request->isExplain()) {
+            // Mutable bson stops tracking in-place updates as soon as any one mod is not
+            // trivially expressible as a same-size overwrite, but the final document may still
+            // differ from the old one only in the bytes of same-size leaf values. Diffing the
+            // two recovers those cases so that only the changed bytes flow through the storage
+            // engine instead of the whole document. This is only safe when no indexed fields
+            // are affected, since the damage path does not maintain indexes.
+            const bool updatedWithDamages = !request->isExplain() &&
+                !driver->modsAffectIndices() && _collection->updateWithDamagesSupported() &&
+                document_diff::computeInPlaceDamages(oldObj.value(), newObj, &_damages) &&
+                !_damages.empty();
+
+            if (updatedWithDamages) {
+                const RecordData oldRec(oldObj.value().objdata(), oldObj.value().objsize());
+
+                Snapshotted<RecordData> snap(oldObj.snapshotId(), oldRec);
+
+                StatusWith<RecordData> newRecStatus = _collection->updateDocumentWithDamages(
+                    getOpCtx(), recordId, std::move(snap), newObj.objdata(), _damages, &args);
+
+                newObj = uassertStatusOK(std::move(newRecStatus)).releaseToBson();
+                newRecordId = recordId;
+            } else if (!request->isExplain()) {
                 newRecordId = _collection->updateDocument(getOpCtx(),
                                                           recordId,
                                                           oldObj,
@@ -43,21 +43,21 @@ WorkingSet::MemberHolder::~MemberHolder() {}
 
 WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
 
-WorkingSet::~WorkingSet() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
-    }
-}
+WorkingSet::~WorkingSet() {}
 
 WorkingSetID WorkingSet::allocate() {
     if (_freeList == INVALID_ID) {
-        // The free list is empty so we need to make a single new WSM to return. This relies on
-        // vector::resize being amortized O(1) for efficient allocation. Note that the free list
-        // remains empty until something is returned by a call to free().
+        // The free list is empty so we need to hand out a new WSM, carving it out of the current
+        // slab (or a fresh one if the current slab is full). Note that the free list remains
+        // empty until something is returned by a call to free().
         WorkingSetID id = _data.size();
+        const size_t offsetInSlab = id % kMembersPerSlab;
+        if (offsetInSlab == 0) {
+            _slabs.emplace_back(new WorkingSetMember[kMembersPerSlab]);
+        }
         _data.resize(_data.size() + 1);
         _data.back().nextFreeOrSelf = id;
-        _data.back().member = new WorkingSetMember();
+        _data.back().member = &_slabs.back()[offsetInSlab];
         return id;
     }
 
@@ -80,10 +80,8 @@ void WorkingSet::free(WorkingSetID i) {
 }
 
 void WorkingSet::clear() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
-    }
     _data.clear();
+    _slabs.clear();
 
     // Since working set is now empty, the free list pointer should
     // point to nothing.
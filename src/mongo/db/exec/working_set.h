@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
@@ -120,14 +121,24 @@ private:
         // Free list link if freed. Points to self if in use.
         WorkingSetID nextFreeOrSelf;
 
-        // Owning pointer
+        // Points into one of the slabs in '_slabs', which own the members.
         WorkingSetMember* member;
     };
 
+    // Number of members per slab. Large enough to amortize the allocation, small enough that a
+    // slab of members stays cache resident during a scan.
+    static const size_t kMembersPerSlab = 64;
+
     // All WorkingSetIDs are indexes into this, except for INVALID_ID.
     // Elements are added to _freeList rather than removed when freed.
     std::vector<MemberHolder> _data;
 
+    // Backing storage for the members, in slabs of kMembersPerSlab. Members are handed out in
+    // slab order, so members allocated together are adjacent in memory; freed members are
+    // recycled in place via '_freeList' and slabs are only released by clear(). Slab addresses
+    // never move, which keeps the pointers returned by get() stable.
+    std::vector<std::unique_ptr<WorkingSetMember[]>> _slabs;
+
     // Index into _data, forming a linked-list using MemberHolder::nextFreeOrSelf as the next
     // link. INVALID_ID is the list terminator since 0 is a valid index.
     // If _freeList == INVALID_ID, the free list is empty and all elements in _data are in use.
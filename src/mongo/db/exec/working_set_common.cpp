@@ -70,7 +70,20 @@ bool WorkingSetCommon::fetch(OperationContext* opCtx,
         return false;
     }
 
-    member->obj = {opCtx->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
+    return fetch(opCtx, workingSet, id, std::move(record->data));
+}
+
+// static
+bool WorkingSetCommon::fetch(OperationContext* opCtx,
+                             WorkingSet* workingSet,
+                             WorkingSetID id,
+                             RecordData data) {
+    WorkingSetMember* member = workingSet->get(id);
+
+    invariant(member->hasRecordId());
+
+    member->obj.reset();
+    member->obj = {opCtx->recoveryUnit()->getSnapshotId(), data.releaseToBson()};
 
     if (member->isSuspicious) {
         // Make sure that all of the keyData is still valid for this copy of the document.
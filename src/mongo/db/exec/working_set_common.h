@@ -29,6 +29,7 @@
 #pragma once
 
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/storage/record_data.h"
 #include "mongo/util/unowned_ptr.h"
 
 namespace mongo {
@@ -66,6 +67,15 @@ public:
                       WorkingSetID id,
                       unowned_ptr<SeekableRecordCursor> cursor);
 
+    /**
+     * As above, but uses an already-fetched copy of the document instead of seeking 'cursor'.
+     * Used by batched fetch paths that look up many RecordIds in a single record store pass.
+     */
+    static bool fetch(OperationContext* opCtx,
+                      WorkingSet* workingSet,
+                      WorkingSetID id,
+                      RecordData data);
+
     /**
      * Build a BSONObj which represents a Status to return in a WorkingSet.
      */
@@ -154,4 +154,41 @@ TEST_F(WorkingSetFixture, getDottedFieldFromIndex) {
     ASSERT_FALSE(member->getFieldDotted("y", &elt));
 }
 
+TEST_F(WorkingSetFixture, pointersStayValidAcrossSlabGrowth) {
+    // Allocate well past several slab boundaries and check that every previously returned
+    // pointer still refers to the same member.
+    const size_t nMembers = 500;
+    std::vector<WorkingSetID> ids;
+    std::vector<WorkingSetMember*> members;
+    for (size_t i = 0; i < nMembers; i++) {
+        WorkingSetID allocatedId = ws->allocate();
+        WorkingSetMember* allocatedMember = ws->get(allocatedId);
+        allocatedMember->obj = Snapshotted<BSONObj>(SnapshotId(), BSON("i" << static_cast<int>(i)));
+        ws->transitionToOwnedObj(allocatedId);
+        ids.push_back(allocatedId);
+        members.push_back(allocatedMember);
+    }
+    for (size_t i = 0; i < nMembers; i++) {
+        ASSERT_EQUALS(members[i], ws->get(ids[i]));
+        ASSERT_EQUALS(static_cast<int>(i), members[i]->obj.value()["i"].numberInt());
+    }
+}
+
+TEST_F(WorkingSetFixture, freedMembersAreRecycledClean) {
+    WorkingSetID allocatedId = ws->allocate();
+    WorkingSetMember* allocatedMember = ws->get(allocatedId);
+    allocatedMember->obj = Snapshotted<BSONObj>(SnapshotId(), BSON("x" << 1));
+    ws->transitionToOwnedObj(allocatedId);
+    ws->free(allocatedId);
+    ASSERT_TRUE(ws->isFree(allocatedId));
+
+    // The freed slot comes back from the free list, reset to the initial state.
+    WorkingSetID recycledId = ws->allocate();
+    ASSERT_EQUALS(allocatedId, recycledId);
+    WorkingSetMember* recycledMember = ws->get(recycledId);
+    ASSERT_EQUALS(allocatedMember, recycledMember);
+    ASSERT_EQUALS(WorkingSetMember::INVALID, recycledMember->getState());
+    ASSERT_FALSE(recycledMember->hasObj());
+}
+
 }  // namespace
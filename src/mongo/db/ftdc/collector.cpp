@@ -30,6 +30,8 @@
 
 #include "mongo/db/ftdc/collector.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -54,9 +56,14 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
         return std::tuple<BSONObj, Date_t>(BSONObj(), Date_t());
     }
 
-    BSONObjBuilder builder;
+    // Samples are collected every period and are nearly identical in size from one period to the
+    // next, so sizing the buffer from the previous sample turns the default grow-by-doubling
+    // series of reallocations and copies into a single allocation for the common case.
+    BSONObjBuilder builder(std::max(_previousSampleSize, 512));
+
+    auto* clock = client->getServiceContext()->getPreciseClockSource();
 
-    Date_t start = client->getServiceContext()->getPreciseClockSource()->now();
+    Date_t start = clock->now();
     Date_t end;
     bool firstLoop = true;
 
@@ -80,7 +87,7 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
         Date_t now = start;
 
         if (!firstLoop) {
-            now = client->getServiceContext()->getPreciseClockSource()->now();
+            now = clock->now();
         }
 
         firstLoop = false;
@@ -89,13 +96,16 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
         collector->collect(opCtx.get(), subObjBuilder);
 
-        end = client->getServiceContext()->getPreciseClockSource()->now();
+        end = clock->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
     }
 
     builder.appendDate(kFTDCCollectEndField, end);
 
-    return std::tuple<BSONObj, Date_t>(builder.obj(), start);
+    BSONObj sample = builder.obj();
+    _previousSampleSize = sample.objsize();
+
+    return std::tuple<BSONObj, Date_t>(std::move(sample), start);
 }
 
 }  // namespace mongo
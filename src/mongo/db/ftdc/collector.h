@@ -110,6 +110,10 @@ public:
 private:
     // collection of collectors
     std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+
+    // Size of the most recently collected sample. Successive samples are nearly the same size,
+    // so this is used to right-size the next sample's buffer in one allocation.
+    int _previousSampleSize = 0;
 };
 
 }  // namespace mongo
@@ -37,19 +37,18 @@
 #include "mongo/db/fts/tokenizer.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
-#include "mongo/util/stringutils.h"
 
 namespace mongo {
 namespace fts {
 
-using std::string;
-
 BasicFTSTokenizer::BasicFTSTokenizer(const FTSLanguage* language)
     : _language(language), _stemmer(language), _stopWords(StopWords::getStopWords(language)) {}
 
 void BasicFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
-    _document = document.toString();
+    // Reference the caller's buffer rather than copying it; every call site keeps the document
+    // alive while it drains the iterator, and the tokens point into the original text.
+    _document = document;
     _tokenizer = stdx::make_unique<Tokenizer>(_language, _document);
 }
 
@@ -57,7 +56,7 @@ bool BasicFTSTokenizer::moveNext() {
     while (true) {
         bool hasMore = _tokenizer->more();
         if (!hasMore) {
-            _stem = "";
+            _stem.clear();
             return false;
         }
 
@@ -68,19 +67,26 @@ bool BasicFTSTokenizer::moveNext() {
             continue;
         }
 
-        string word = tolowerString(token.data);
+        // Stop words are case-sensitive so we need them to be lower cased to check against the
+        // stop word list. Lower case into a buffer reused across tokens; in steady state this
+        // allocates nothing.
+        _word.resize(token.data.size());
+        for (size_t i = 0; i < token.data.size(); i++) {
+            _word[i] = static_cast<char>(tolower(static_cast<int>(token.data[i])));
+        }
 
-        // Stop words are case-sensitive so we need them to be lower cased to check
-        // against the stop word list
-        if ((_options & FTSTokenizer::kFilterStopWords) && _stopWords->isStopWord(word)) {
+        if ((_options & FTSTokenizer::kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & FTSTokenizer::kGenerateCaseSensitiveTokens) {
-            word = token.data.toString();
+            _word.assign(token.data.rawData(), token.data.size());
         }
 
-        _stem = _stemmer.stem(word).toString();
+        // The stemmer returns a view into its own buffer, valid until the next stem() call;
+        // copy it into the reused result buffer.
+        const StringData stemmed = _stemmer.stem(_word);
+        _stem.assign(stemmed.rawData(), stemmed.size());
         return true;
     }
 }
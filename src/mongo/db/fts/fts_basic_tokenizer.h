@@ -73,10 +73,15 @@ private:
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
 
-    std::string _document;
+    // Tokens reference the caller's buffer directly; reset() requires it to stay alive for the
+    // duration of the iteration.
+    StringData _document;
     std::unique_ptr<Tokenizer> _tokenizer;
     Options _options;
 
+    // Reused across tokens so that once grown to the longest word, moveNext() allocates
+    // nothing.
+    std::string _word;
     std::string _stem;
 };
 
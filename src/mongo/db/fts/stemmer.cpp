@@ -29,18 +29,101 @@
 */
 
 #include <cstdlib>
+#include <map>
+#include <memory>
 
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
 namespace fts {
 
+namespace {
+
+// The cache holds kStemCacheShards * kStemCacheEntriesPerShard stems per language; corpora with
+// heavy token repetition (logs, structured text) are covered by a few thousand distinct tokens.
+const size_t kStemCacheShards = 8;
+const size_t kStemCacheEntriesPerShard = 512;
+
+}  // namespace
+
+/**
+ * Cache of libstemmer results, shared by all Stemmer instances for one language. Stemming is
+ * deterministic per language, so entries never invalidate; an LRU bound per shard caps memory.
+ * Sharded by token hash so concurrent index builds and inserts do not serialize on one mutex.
+ */
+class StemCache {
+    MONGO_DISALLOW_COPYING(StemCache);
+
+public:
+    StemCache() = default;
+
+    /**
+     * Returns the process-wide cache for 'language', creating it on first use. Languages are
+     * few and fixed, so entries live for the life of the process.
+     */
+    static StemCache* forLanguage(const std::string& language) {
+        static stdx::mutex registryMutex;
+        static std::map<std::string, std::unique_ptr<StemCache>>* registry =
+            new std::map<std::string, std::unique_ptr<StemCache>>();
+
+        stdx::lock_guard<stdx::mutex> lk(registryMutex);
+        auto& entry = (*registry)[language];
+        if (!entry) {
+            entry = stdx::make_unique<StemCache>();
+        }
+        return entry.get();
+    }
+
+    /**
+     * If 'word' has a cached stem, copies it into 'out' and returns true. Most tokens fit in
+     * the small-string buffer, so the key lookup does not allocate.
+     */
+    bool lookup(StringData word, std::string* out) {
+        Shard& shard = _shard(word);
+        stdx::lock_guard<SimpleMutex> lk(shard.mutex);
+        auto it = shard.cache.find(word.toString());
+        if (it == shard.cache.end()) {
+            return false;
+        }
+        *out = it->second;
+        return true;
+    }
+
+    void store(StringData word, StringData stem) {
+        Shard& shard = _shard(word);
+        stdx::lock_guard<SimpleMutex> lk(shard.mutex);
+        shard.cache.add(word.toString(), stem.toString());
+    }
+
+private:
+    struct Shard {
+        SimpleMutex mutex;
+        LRUCache<std::string, std::string> cache{kStemCacheEntriesPerShard};
+    };
+
+    Shard& _shard(StringData word) {
+        return _shards[StringMapTraits::hash(word) % kStemCacheShards];
+    }
+
+    Shard _shards[kStemCacheShards];
+};
+
 Stemmer::Stemmer(const FTSLanguage* language) {
     _stemmer = NULL;
-    if (language->str() != "none")
+    _cache = NULL;
+    if (language->str() != "none") {
         _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
+        if (_stemmer) {
+            _cache = StemCache::forLanguage(language->str());
+        }
+    }
 }
 
 Stemmer::~Stemmer() {
@@ -54,6 +137,10 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    if (_cache->lookup(word, &_cachedResult)) {
+        return _cachedResult;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -62,7 +149,9 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    StringData stemmed((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    _cache->store(word, stemmed);
+    return stemmed;
 }
 }
 }
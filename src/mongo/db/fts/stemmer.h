@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -39,6 +41,8 @@ namespace mongo {
 
 namespace fts {
 
+class StemCache;
+
 /**
  * maintains case
  * but works
@@ -62,6 +66,14 @@ public:
 
 private:
     struct sb_stemmer* _stemmer;
+
+    // Cache of stem results shared by every Stemmer for the same language; not owned. Null when
+    // the language does not stem.
+    StemCache* _cache;
+
+    // Holds a cache hit's result so the returned StringData obeys this object's lifetime
+    // contract even if the cache entry is evicted concurrently.
+    mutable std::string _cachedResult;
 };
 }
 }
@@ -48,5 +48,17 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, RepeatedTokensHitCache) {
+    // Repeats go through the shared stem cache; results must match the uncached path, from this
+    // stemmer and from a fresh one.
+    Stemmer s(&languageEnglishV2);
+    ASSERT_EQUALS("run", s.stem("running"));
+    ASSERT_EQUALS("run", s.stem("running"));
+    ASSERT_EQUALS("run", s.stem("running"));
+
+    Stemmer other(&languageEnglishV2);
+    ASSERT_EQUALS("run", other.stem("running"));
+}
 }
 }
@@ -74,7 +74,28 @@ bool Tokenizer::_skipWhitespace() {
 }
 
 
-Token::Type Tokenizer::_type(char c) const {
+namespace {
+
+Token::Type classifyChar(char c, bool english);
+
+// Byte classification tables, built once so that tokenizing does a single indexed load per
+// character. The apostrophe is part of a word in English (contractions) and whitespace in
+// other languages, hence one table per case.
+struct CharTypeTables {
+    CharTypeTables() {
+        for (int c = 0; c < 256; c++) {
+            english[c] = classifyChar(static_cast<char>(c), true);
+            other[c] = classifyChar(static_cast<char>(c), false);
+        }
+    }
+
+    Token::Type english[256];
+    Token::Type other[256];
+};
+
+const CharTypeTables charTypeTables;
+
+Token::Type classifyChar(char c, bool english) {
     switch (c) {
         case ' ':
         case '\f':
@@ -84,7 +105,7 @@ Token::Type Tokenizer::_type(char c) const {
         case '\n':
             return Token::WHITESPACE;
         case '\'':
-            if (_english)
+            if (english)
                 return Token::TEXT;
             else
                 return Token::WHITESPACE;
@@ -134,5 +155,12 @@ Token::Type Tokenizer::_type(char c) const {
             return Token::TEXT;
     }
 }
+
+}  // namespace
+
+Token::Type Tokenizer::_type(char c) const {
+    const Token::Type* table = _english ? charTypeTables.english : charTypeTables.other;
+    return table[static_cast<unsigned char>(c)];
+}
 }
 }
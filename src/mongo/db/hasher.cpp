@@ -34,7 +34,9 @@
 
 #include "mongo/db/hasher.h"
 
+#include <third_party/murmurhash3/MurmurHash3.h>
 
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/startup_test.h"
@@ -47,12 +49,13 @@ namespace {
 
 typedef unsigned char HashDigest[16];
 
-class Hasher {
-    MONGO_DISALLOW_COPYING(Hasher);
+// HashVersion 0: MD5 over the seed followed by the canonicalized element bytes.
+class Md5Hasher {
+    MONGO_DISALLOW_COPYING(Md5Hasher);
 
 public:
-    explicit Hasher(HashSeed seed);
-    ~Hasher(){};
+    explicit Md5Hasher(HashSeed seed);
+    ~Md5Hasher(){};
 
     // pointer to next part of input key, length in bytes to read
     void addData(const void* keyData, size_t numBytes);
@@ -66,19 +69,43 @@ private:
     HashSeed _seed;
 };
 
-Hasher::Hasher(HashSeed seed) : _seed(seed) {
+Md5Hasher::Md5Hasher(HashSeed seed) : _seed(seed) {
     md5_init(&_md5State);
     md5_append(&_md5State, reinterpret_cast<const md5_byte_t*>(&_seed), sizeof(_seed));
 }
 
-void Hasher::addData(const void* keyData, size_t numBytes) {
+void Md5Hasher::addData(const void* keyData, size_t numBytes) {
     md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
 }
 
-void Hasher::finish(HashDigest out) {
+void Md5Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
+// HashVersion 1: seeded MurmurHash3 over the same canonicalized element bytes that
+// HashVersion 0 feeds to MD5. MurmurHash3 has no streaming interface, so the bytes are
+// gathered into a single buffer and hashed in one shot; a typical index key fits in the
+// stack portion of the builder.
+class Murmur3Hasher {
+    MONGO_DISALLOW_COPYING(Murmur3Hasher);
+
+public:
+    explicit Murmur3Hasher(HashSeed seed) : _seed(seed) {}
+
+    void addData(const void* keyData, size_t numBytes) {
+        _buf.appendBuf(keyData, numBytes);
+    }
+
+    void finish(HashDigest out) {
+        MurmurHash3_x64_128(_buf.buf(), _buf.len(), static_cast<uint32_t>(_seed), out);
+    }
+
+private:
+    StackBufBuilder _buf;
+    HashSeed _seed;
+};
+
+template <typename Hasher>
 void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
@@ -128,7 +155,17 @@ struct HasherUnitTest : public StartupTest {
 }  // namespace
 
 long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
-    Hasher h(seed);
+    Md5Hasher h(seed);
+    recursiveHash(&h, e, false);
+    HashDigest d;
+    h.finish(d);
+    // HashDigest is actually 16 bytes, but we just read 8 bytes
+    ConstDataView digestView(reinterpret_cast<const char*>(d));
+    return digestView.read<LittleEndian<long long int>>();
+}
+
+long long int BSONElementHasher::hash64V1(const BSONElement& e, HashSeed seed) {
+    Murmur3Hasher h(seed);
     recursiveHash(&h, e, false);
     HashDigest d;
     h.finish(d);
@@ -68,6 +68,17 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* HashVersion 1 of the hashed index key computation. Hashes exactly the same
+     * canonicalized byte stream as hash64() (so the type-squashing semantics above
+     * apply unchanged), but uses seeded MurmurHash3 in place of MD5, which is far
+     * cheaper for this non-cryptographic purpose.
+     *
+     * Only used for indexes whose spec explicitly requests { hashVersion: 1 }.
+     * Hashed shard keys and existing indexes continue to use hash64(); the two
+     * versions produce unrelated values for the same input.
+     */
+    static long long int hash64V1(const BSONElement& e, HashSeed seed);
+
 private:
     BSONElementHasher();
 };
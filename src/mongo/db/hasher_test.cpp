@@ -359,5 +359,40 @@ TEST(BSONElementHasher, HashCodeWScope) {
     ASSERT_EQUALS(hashIt(o), 501342939894575968LL);
 }
 
+// HashVersion 1 hashes the same canonicalized byte stream as version 0, but through
+// MurmurHash3 instead of MD5.
+long long hashItV1(const BSONObj& object, int seed = 0) {
+    return BSONElementHasher::hash64V1(object.firstElement(), seed);
+}
+
+// The type-squashing semantics of version 0 carry over to version 1.
+TEST(BSONElementHasher, V1ConsistentHashOfIntLongAndDouble) {
+    ASSERT_EQUALS(hashItV1(BSON("a" << 3)), hashItV1(BSON("a" << (long long)3)));
+    ASSERT_EQUALS(hashItV1(BSON("a" << 3)), hashItV1(BSON("a" << 3.1)));
+}
+
+TEST(BSONElementHasher, V1SeedMatters) {
+    ASSERT_NOT_EQUALS(hashItV1(BSON("a" << 4), 0), hashItV1(BSON("a" << 4), 1));
+}
+
+TEST(BSONElementHasher, V1DiffersFromV0) {
+    ASSERT_NOT_EQUALS(hashItV1(BSON("a" << 4)), hashIt(BSON("a" << 4)));
+}
+
+// Hard-coded checks to ensure version 1 of the hash function is consistent across
+// platforms and server versions. All values have been determined experimentally.
+TEST(BSONElementHasher, V1HashIsNotChanged) {
+    BSONObj o = BSON("check" << 42);
+    ASSERT_EQUALS(hashItV1(o), 8715208212397937794LL);
+    ASSERT_EQUALS(hashItV1(o, 1), -9087602108468514688LL);
+
+    o = BSON("check" << BSONNULL);
+    ASSERT_EQUALS(hashItV1(o), 6655367218388208063LL);
+
+    o = BSON("check"
+             << "abc");
+    ASSERT_EQUALS(hashItV1(o), 1087612813366940559LL);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -95,21 +95,40 @@ AllPathsKeyGenerator::AllPathsKeyGenerator(BSONObj keyPattern,
                                            const CollatorInterface* collator)
     : _collator(collator), _keyPattern(keyPattern) {
     _projExec = createProjectionExec(keyPattern, pathProjection);
+
+    // If we are indexing all paths and the user did not supply a projection, then the projection
+    // applied at the top of generateKeys() is exactly the default {_id: 0}. In that case we can
+    // skip the _id field during the traversal itself rather than materializing a projected copy
+    // of the entire document for every insert.
+    auto indexRoot = keyPattern.firstElement().fieldNameStringData();
+    _projectionExcludesOnlyId =
+        (indexRoot.find(kSubtreeSuffix) == std::string::npos && pathProjection.isEmpty());
 }
 
 void AllPathsKeyGenerator::generateKeys(BSONObj inputDoc,
                                         BSONObjSet* keys,
                                         BSONObjSet* multikeyPaths) const {
     FieldRef rootPath;
-    _traverseAllPaths(_projExec->applyProjection(inputDoc), false, &rootPath, keys, multikeyPaths);
+    if (_projectionExcludesOnlyId) {
+        _traverseAllPaths(inputDoc, false, &rootPath, keys, multikeyPaths, true /* skipIdField */);
+    } else {
+        _traverseAllPaths(
+            _projExec->applyProjection(inputDoc), false, &rootPath, keys, multikeyPaths);
+    }
 }
 
 void AllPathsKeyGenerator::_traverseAllPaths(BSONObj obj,
                                              bool objIsArray,
                                              FieldRef* path,
                                              BSONObjSet* keys,
-                                             BSONObjSet* multikeyPaths) const {
+                                             BSONObjSet* multikeyPaths,
+                                             bool skipIdField) const {
     for (const auto elem : obj) {
+        // Skip the _id field at the root of the document if we are standing in for the default
+        // {_id: 0} projection.
+        if (skipIdField && elem.fieldNameStringData() == "_id"_sd)
+            continue;
+
         // If the element's fieldName contains a ".", fast-path skip it because it's not queryable.
         if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
             continue;
@@ -67,11 +67,14 @@ public:
 
 private:
     // Traverses every path of the post-projection document, adding keys to the set as it goes.
+    // If 'skipIdField' is true, the _id field at the root of the document is ignored; this is
+    // used in place of applying the default {_id: 0} projection.
     void _traverseAllPaths(BSONObj obj,
                            bool objIsArray,
                            FieldRef* path,
                            BSONObjSet* keys,
-                           BSONObjSet* multikeyPaths) const;
+                           BSONObjSet* multikeyPaths,
+                           bool skipIdField = false) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(const FieldRef& fullPath, BSONObjSet* multikeyPaths) const;
@@ -87,5 +90,10 @@ private:
     std::unique_ptr<ProjectionExecAgg> _projExec;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
+
+    // True if the projection this generator would apply is exactly the default {_id: 0}, in
+    // which case generateKeys() skips the _id field during traversal instead of materializing a
+    // projected copy of each document.
+    bool _projectionExcludesOnlyId = false;
 };
 }  // namespace mongo
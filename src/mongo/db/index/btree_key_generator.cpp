@@ -174,15 +174,51 @@ void BtreeKeyGenerator::getKeys(const BSONObj& obj,
             invariant(multikeyPaths->empty());
             multikeyPaths->resize(_fieldNames.size());
         }
-        // '_fieldNames' and '_fixed' are passed by value so that their copies can be mutated as
-        // part of the _getKeysWithArray method.
-        _getKeysWithArray(_fieldNames, _fixed, obj, keys, 0, _emptyPositionalInfo, multikeyPaths);
+        if (!_getKeysNoArray(obj, keys)) {
+            // '_fieldNames' and '_fixed' are passed by value so that their copies can be mutated
+            // as part of the _getKeysWithArray method.
+            _getKeysWithArray(
+                _fieldNames, _fixed, obj, keys, 0, _emptyPositionalInfo, multikeyPaths);
+        }
     }
     if (keys->empty() && !_isSparse) {
         keys->insert(_nullKey);
     }
 }
 
+bool BtreeKeyGenerator::_getKeysNoArray(const BSONObj& obj, BSONObjSet* keys) const {
+    BSONObjBuilder b(_sizeTracker);
+    size_t numNotFound = 0;
+
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        const char* field = _fieldNames[i];
+        if (*field == '\0') {
+            // A caller-supplied fixed element; only the general machinery knows how to handle it.
+            return false;
+        }
+
+        BSONElement e = dps::extractElementAtPathOrArrayAlongPath(obj, field);
+        if (e.type() == Array) {
+            // An array along an indexed path requires expansion into potentially many keys as
+            // well as multikey bookkeeping, so hand the document to the general machinery.
+            return false;
+        }
+        if (e.eoo()) {
+            e = nullElt;
+            ++numNotFound;
+        }
+        CollationIndexKey::collationAwareIndexKeyAppend(e, _collator, &b);
+    }
+
+    if (_isSparse && numNotFound == _fieldNames.size()) {
+        // A sparse index has no entries for documents missing all of its indexed fields.
+        return true;
+    }
+
+    keys->insert(b.obj());
+    return true;
+}
+
 void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
                                           std::vector<BSONElement> fixed,
                                           const BSONObj& obj,
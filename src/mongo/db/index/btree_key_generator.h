@@ -129,6 +129,16 @@ private:
         const char* remainingPath;
     };
 
+    /**
+     * Fast path for the common case where no indexed field of 'obj' contains an array. Walks
+     * each indexed path directly and, if it never encounters an array value, emits the single
+     * resulting key into 'keys' and returns true. Returns false, leaving 'keys' untouched, if
+     * an array value (or a caller-supplied fixed element) requires the general machinery of
+     * _getKeysWithArray(), which pays for recursion state and per-call vector copies that are
+     * wasted on non-multikey documents.
+     */
+    bool _getKeysNoArray(const BSONObj& obj, BSONObjSet* keys) const;
+
     /**
      * This recursive method does the heavy-lifting for getKeys().
      */
@@ -371,8 +371,8 @@ void ExpressionKeysPrivate::getHashKeys(const BSONObj& obj,
 
 // static
 long long int ExpressionKeysPrivate::makeSingleHashKey(const BSONElement& e, HashSeed seed, int v) {
-    massert(16767, "Only HashVersion 0 has been defined", v == 0);
-    return BSONElementHasher::hash64(e, seed);
+    massert(16767, "Only HashVersions 0 and 1 have been defined", v == 0 || v == 1);
+    return v == 1 ? BSONElementHasher::hash64V1(e, seed) : BSONElementHasher::hash64(e, seed);
 }
 
 // static
@@ -550,6 +550,8 @@ Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
 
     bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
 
+    int64_t dupsDropped = 0;
+
     while (it->more()) {
         if (mayInterrupt) {
             opCtx->checkForInterrupt();
@@ -581,6 +583,7 @@ Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
 
                 if (dupsToDrop) {
                     dupsToDrop->insert(data.second);
+                    dupsDropped++;
                     continue;
                 }
             }
@@ -601,6 +604,10 @@ Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
                                              "Index: (3/3) BTree Middle Progress");
     }
 
+    if (dupsDropped > 0) {
+        log() << "index build dropped " << dupsDropped << " duplicate key(s)";
+    }
+
     LOG(timer.seconds() > 10 ? 0 : 1) << "\t done building bottom layer, going to commit";
 
     WriteUnitOfWork wunit(opCtx);
@@ -53,6 +53,7 @@
 #include "mongo/db/auth/security_key.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/logger/async_appender.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event.h"
@@ -299,9 +300,19 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
         LogManager* manager = logger::globalLogManager();
         manager->getGlobalDomain()->clearAppenders();
-        manager->getGlobalDomain()->attachAppender(
-            std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        if (serverGlobalParams.logAsync) {
+            // Encode on the logging thread, but hand the encoded line to a writer thread so a
+            // slow disk or an in-progress log rotation does not stall operation threads.
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<logger::AsyncAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(),
+                    std::make_unique<RotatableFileAppender<std::string>>(
+                        std::make_unique<logger::PreEncodedLineEncoder>(), writer.getValue())));
+        } else {
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        }
         manager->getNamedDomain("javascriptOutput")
             ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
                 std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
@@ -32,17 +32,27 @@
 
 #include "mongo/db/introspect.h"
 
+#include <vector>
+
+#include "mongo/base/counter.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 
@@ -79,9 +89,195 @@ void _appendUserInfo(const CurOp& c, BSONObjBuilder& builder, AuthorizationSessi
     builder.append("user", bestUser.getUser().empty() ? "" : bestUser.getFullName());
 }
 
+// When enabled, profile entries are handed to a background writer thread which batches the
+// inserts into system.profile, instead of being written synchronously on the operation's own
+// thread. Off by default because the synchronous write guarantees the entry is visible as soon
+// as the profiled operation returns, which tests and tooling may rely on.
+MONGO_EXPORT_SERVER_PARAMETER(profileAsyncWriteEnabled, bool, false);
+
+// Upper bound on the number of profile entries queued for the background writer. Entries
+// arriving while the queue is full are dropped and accounted for in serverStatus.
+MONGO_EXPORT_SERVER_PARAMETER(profileAsyncWriteMaxQueuedEntries, int, 1000)
+    ->withValidator([](const int& potentialNewValue) {
+        if (potentialNewValue < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "profileAsyncWriteMaxQueuedEntries must be at least 1");
+        }
+        return Status::OK();
+    });
+
+Counter64 profileEntriesDropped;
+ServerStatusMetricField<Counter64> profileEntriesDroppedDisplay("profiler.entriesDropped",
+                                                                &profileEntriesDropped);
+
+/**
+ * Writes 'entries' to the system.profile collection of 'dbName', creating the collection if it
+ * does not exist. 'wasLocked' must indicate whether the calling operation already held locks
+ * when profiling began; it controls whether we dare upgrade to a database X lock to create the
+ * collection.
+ */
+void writeProfileEntries(OperationContext* opCtx,
+                         const std::string& dbName,
+                         const std::vector<BSONObj>& entries,
+                         bool wasLocked) {
+    // Even if the operation we are profiling was interrupted, we still want to output the
+    // profiler entry.  This lock guard will prevent lock acquisitions from throwing exceptions
+    // before we finish writing the entry. However, our maximum lock timeout overrides
+    // uninterruptibility.
+    boost::optional<UninterruptibleLockGuard> noInterrupt;
+    if (!opCtx->lockState()->hasMaxLockTimeout()) {
+        noInterrupt.emplace(opCtx->lockState());
+    }
+
+    bool acquireDbXLock = false;
+    while (true) {
+        std::unique_ptr<AutoGetDb> autoGetDb;
+        if (acquireDbXLock) {
+            autoGetDb.reset(new AutoGetDb(opCtx, dbName, MODE_X));
+            if (autoGetDb->getDb()) {
+                createProfileCollection(opCtx, autoGetDb->getDb()).transitional_ignore();
+            }
+        } else {
+            autoGetDb.reset(new AutoGetDb(opCtx, dbName, MODE_IX));
+        }
+
+        Database* const db = autoGetDb->getDb();
+        if (!db) {
+            // Database disappeared
+            log() << "note: not profiling because db went away for " << dbName;
+            break;
+        }
+
+        Lock::CollectionLock collLock(opCtx->lockState(), db->getProfilingNS(), MODE_IX);
+
+        Collection* const coll = db->getCollection(opCtx, db->getProfilingNS());
+        if (coll) {
+            std::vector<InsertStatement> inserts;
+            inserts.reserve(entries.size());
+            for (const auto& entry : entries) {
+                inserts.emplace_back(entry);
+            }
+
+            WriteUnitOfWork wuow(opCtx);
+            OpDebug* const nullOpDebug = nullptr;
+            coll->insertDocuments(opCtx, inserts.begin(), inserts.end(), nullOpDebug, false)
+                .transitional_ignore();
+            wuow.commit();
+
+            break;
+        } else if (!acquireDbXLock &&
+                   (!wasLocked || opCtx->lockState()->isDbLockedForMode(dbName, MODE_X))) {
+            // Try to create the collection only if we are not under lock, in order to
+            // avoid deadlocks due to lock conversion. This would only be hit if someone
+            // deletes the profiler collection after setting profile level.
+            acquireDbXLock = true;
+        } else {
+            // Cannot write the profile information
+            break;
+        }
+    }
+}
+
+/**
+ * Background thread which drains queued profile entries and writes them to the system.profile
+ * collection of their respective databases in batches, so that profiled operations do not pay
+ * for the insert (or the collection lock acquisition) on their own thread.
+ */
+class ProfileWriter : public BackgroundJob {
+public:
+    ProfileWriter() : BackgroundJob(false /* selfDelete */) {}
+
+    std::string name() const override {
+        return "ProfileWriter";
+    }
+
+    /**
+     * Queues 'entry' for insertion into the system.profile collection of 'dbName'. If the queue
+     * is at capacity the entry is dropped and the drop counter is incremented.
+     */
+    void enqueue(const std::string& dbName, const BSONObj& entry) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_queue.size() >= static_cast<size_t>(profileAsyncWriteMaxQueuedEntries.load())) {
+            profileEntriesDropped.increment();
+            return;
+        }
+        _queue.push_back({dbName, entry.getOwned()});
+        _condvar.notify_one();
+    }
+
+    void run() override {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+
+        while (!globalInShutdownDeprecated()) {
+            std::vector<Entry> batch;
+            {
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lk, Milliseconds(100).toSystemDuration(), [&] {
+                    return !_queue.empty() || globalInShutdownDeprecated();
+                });
+                batch.swap(_queue);
+            }
+
+            if (batch.empty()) {
+                continue;
+            }
+
+            const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+            OperationContext& opCtx = *opCtxPtr;
+
+            // Group consecutive entries by database so each group is written in one unit of
+            // work under a single lock acquisition.
+            size_t batchStart = 0;
+            for (size_t i = 1; i <= batch.size(); i++) {
+                if (i < batch.size() && batch[i].dbName == batch[batchStart].dbName) {
+                    continue;
+                }
+
+                std::vector<BSONObj> docs;
+                docs.reserve(i - batchStart);
+                for (size_t j = batchStart; j < i; j++) {
+                    docs.push_back(std::move(batch[j].doc));
+                }
+
+                try {
+                    writeProfileEntries(&opCtx, batch[batchStart].dbName, docs, false);
+                } catch (const AssertionException& assertionEx) {
+                    warning() << "Caught Assertion while writing profile batch for "
+                              << batch[batchStart].dbName << ": " << redact(assertionEx);
+                }
+
+                batchStart = i;
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        std::string dbName;
+        BSONObj doc;
+    };
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    std::vector<Entry> _queue;
+};
+
+// The single instance of the profile writer, created by startProfileWriter(). Never deleted,
+// because it is still accessible from operation threads at shutdown.
+ProfileWriter* profileWriter = nullptr;
+
 }  // namespace
 
 
+void startProfileWriter() {
+    invariant(!profileWriter);
+    profileWriter = new ProfileWriter();
+    profileWriter->go();
+}
+
 void profile(OperationContext* opCtx, NetworkOp op) {
     // Initialize with 1kb at start in order to avoid realloc later
     BufBuilder profileBufBuilder(1024);
@@ -115,58 +311,15 @@ void profile(OperationContext* opCtx, NetworkOp op) {
 
     const string dbName(nsToDatabase(CurOp::get(opCtx)->getNS()));
 
-    try {
-        // Even if the operation we are profiling was interrupted, we still want to output the
-        // profiler entry.  This lock guard will prevent lock acquisitions from throwing exceptions
-        // before we finish writing the entry. However, our maximum lock timeout overrides
-        // uninterruptibility.
-        boost::optional<UninterruptibleLockGuard> noInterrupt;
-        if (!opCtx->lockState()->hasMaxLockTimeout()) {
-            noInterrupt.emplace(opCtx->lockState());
-        }
-
-        bool acquireDbXLock = false;
-        while (true) {
-            std::unique_ptr<AutoGetDb> autoGetDb;
-            if (acquireDbXLock) {
-                autoGetDb.reset(new AutoGetDb(opCtx, dbName, MODE_X));
-                if (autoGetDb->getDb()) {
-                    createProfileCollection(opCtx, autoGetDb->getDb()).transitional_ignore();
-                }
-            } else {
-                autoGetDb.reset(new AutoGetDb(opCtx, dbName, MODE_IX));
-            }
-
-            Database* const db = autoGetDb->getDb();
-            if (!db) {
-                // Database disappeared
-                log() << "note: not profiling because db went away for "
-                      << CurOp::get(opCtx)->getNS();
-                break;
-            }
+    if (profileAsyncWriteEnabled.load() && profileWriter) {
+        // Hand the entry to the background writer, which batches inserts into system.profile
+        // off the operation's thread.
+        profileWriter->enqueue(dbName, p);
+        return;
+    }
 
-            Lock::CollectionLock collLock(opCtx->lockState(), db->getProfilingNS(), MODE_IX);
-
-            Collection* const coll = db->getCollection(opCtx, db->getProfilingNS());
-            if (coll) {
-                WriteUnitOfWork wuow(opCtx);
-                OpDebug* const nullOpDebug = nullptr;
-                coll->insertDocument(opCtx, InsertStatement(p), nullOpDebug, false)
-                    .transitional_ignore();
-                wuow.commit();
-
-                break;
-            } else if (!acquireDbXLock &&
-                       (!wasLocked || opCtx->lockState()->isDbLockedForMode(dbName, MODE_X))) {
-                // Try to create the collection only if we are not under lock, in order to
-                // avoid deadlocks due to lock conversion. This would only be hit if someone
-                // deletes the profiler collection after setting profile level.
-                acquireDbXLock = true;
-            } else {
-                // Cannot write the profile information
-                break;
-            }
-        }
+    try {
+        writeProfileEntries(opCtx, dbName, {p}, wasLocked);
     } catch (const AssertionException& assertionEx) {
         warning() << "Caught Assertion while trying to profile " << networkOpToString(op)
                   << " against " << CurOp::get(opCtx)->getNS() << ": " << redact(assertionEx);
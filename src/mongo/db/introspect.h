@@ -41,6 +41,12 @@ class OperationContext;
  */
 void profile(OperationContext* opCtx, NetworkOp op);
 
+/**
+ * Starts the background thread which, when profileAsyncWriteEnabled is set, batches profile
+ * entries into system.profile off the profiled operations' threads.
+ */
+void startProfileWriter();
+
 /**
  * Pre-creates the profile collection for the specified database.
  */
@@ -42,6 +42,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/periodic_runner.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -54,6 +55,10 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(disableLogicalSessionCacheRefresh, bool, f
 
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(maxSessions, int, 1'000'000);
 
+// Upper bound on the random delay added before each periodic pass over the sessions collection,
+// so that processes started together do not refresh in lockstep. Zero disables the jitter.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logicalSessionRefreshJitterMillis, int, 10'000);
+
 constexpr Milliseconds LogicalSessionCacheImpl::kLogicalSessionDefaultRefresh;
 
 LogicalSessionCacheImpl::LogicalSessionCacheImpl(
@@ -65,7 +70,8 @@ LogicalSessionCacheImpl::LogicalSessionCacheImpl(
       _sessionTimeout(options.sessionTimeout),
       _service(std::move(service)),
       _sessionsColl(std::move(collection)),
-      _transactionReaper(std::move(transactionReaper)) {
+      _transactionReaper(std::move(transactionReaper)),
+      _random(SecureRandom::create()->nextInt64()) {
     _stats.setLastSessionsCollectionJobTimestamp(now());
     _stats.setLastTransactionReaperJobTimestamp(now());
 
@@ -172,6 +178,8 @@ size_t LogicalSessionCacheImpl::size() {
 }
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
+    _sleepForJitter();
+
     try {
         _refresh(client);
     } catch (...) {
@@ -180,6 +188,8 @@ void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
 }
 
 void LogicalSessionCacheImpl::_periodicReap(Client* client) {
+    _sleepForJitter();
+
     auto res = _reap(client);
     if (!res.isOK()) {
         log() << "Failed to reap transaction table: " << res;
@@ -188,6 +198,23 @@ void LogicalSessionCacheImpl::_periodicReap(Client* client) {
     return;
 }
 
+void LogicalSessionCacheImpl::_sleepForJitter() {
+    // Never delay a job by more than half its interval, no matter how the jitter is configured.
+    const auto maxJitter =
+        std::min(Milliseconds(logicalSessionRefreshJitterMillis), _refreshInterval / 2);
+    if (maxJitter <= Milliseconds::zero()) {
+        return;
+    }
+
+    Milliseconds jitter;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+        jitter = Milliseconds(_random.nextInt64(maxJitter.count() + 1));
+    }
+
+    sleepFor(jitter);
+}
+
 Status LogicalSessionCacheImpl::_reap(Client* client) {
     if (!_transactionReaper) {
         return Status::OK();
@@ -36,6 +36,7 @@
 #include "mongo/db/time_proof_service.h"
 #include "mongo/db/transaction_reaper.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/random.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/lru_cache.h"
 
@@ -138,6 +139,13 @@ private:
     void _periodicReap(Client* client);
     Status _reap(Client* client);
 
+    /**
+     * Sleeps for a random duration of up to logicalSessionRefreshJitterMillis (but no more than
+     * half the refresh interval) before a periodic job does its work, so that a fleet of processes
+     * started together does not hit the sessions collection in lockstep.
+     */
+    void _sleepForJitter();
+
     /**
      * Returns true if a record has passed its given expiration.
      */
@@ -161,6 +169,10 @@ private:
     mutable stdx::mutex _reaperMutex;
     std::shared_ptr<TransactionReaper> _transactionReaper;
 
+    // Generates the jitter for the periodic jobs. Only accessed under _cacheMutex, since both
+    // background jobs draw from it.
+    PseudoRandom _random;
+
     mutable stdx::mutex _cacheMutex;
 
     LogicalSessionIdMap<LogicalSessionRecord> _activeSessions;
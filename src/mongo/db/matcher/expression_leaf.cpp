@@ -394,6 +394,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
     next->_originalEqualityVector = _originalEqualityVector;
+    next->_equalityHashFilter = _equalityHashFilter;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -402,11 +403,45 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     return std::move(next);
 }
 
+void InMatchExpression::_rebuildEqualityHashFilter() {
+    _equalityHashFilter.clear();
+    if (_equalitySet.size() < kMinEqualitiesForHashFilter) {
+        return;
+    }
+    // Size the filter at roughly eight bits per element (rounded up to a power of two words),
+    // which keeps the false positive rate at a few percent with two probes per element.
+    size_t nWords = 1;
+    while (nWords * 64 < _equalitySet.size() * 8) {
+        nWords *= 2;
+    }
+    _equalityHashFilter.assign(nWords, 0);
+    const uint64_t bitMask = nWords * 64 - 1;
+    for (auto&& equality : _equalitySet) {
+        const uint64_t h = _eltCmp.hash(equality);
+        const uint64_t bit1 = h & bitMask;
+        const uint64_t bit2 = (h >> 32) & bitMask;
+        _equalityHashFilter[bit1 / 64] |= uint64_t(1) << (bit1 % 64);
+        _equalityHashFilter[bit2 / 64] |= uint64_t(1) << (bit2 % 64);
+    }
+}
+
+bool InMatchExpression::_maybeInEqualitySet(const BSONElement& e) const {
+    if (_equalityHashFilter.empty()) {
+        return true;
+    }
+    const uint64_t bitMask = _equalityHashFilter.size() * 64 - 1;
+    const uint64_t h = _eltCmp.hash(e);
+    const uint64_t bit1 = h & bitMask;
+    const uint64_t bit2 = (h >> 32) & bitMask;
+    return (_equalityHashFilter[bit1 / 64] >> (bit1 % 64)) &
+        (_equalityHashFilter[bit2 / 64] >> (bit2 % 64)) & 1;
+}
+
 bool InMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
     if (_hasNull && e.eoo()) {
         return true;
     }
-    if (_equalitySet.find(e) != _equalitySet.end()) {
+    if (_maybeInEqualitySet(e) && _equalitySet.find(e) != _equalitySet.end()) {
         return true;
     }
     for (auto&& regex : _regexes) {
@@ -507,6 +542,9 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
 
     // We need to re-compute '_equalitySet', since our set comparator has changed.
     _equalitySet = _eltCmp.makeBSONEltFlatSet(_originalEqualityVector);
+
+    // The element hashes respect the collation, so the prefilter must be rebuilt as well.
+    _rebuildEqualityHashFilter();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -537,6 +575,8 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
 
     _equalitySet = _eltCmp.makeBSONEltFlatSet(_originalEqualityVector);
 
+    _rebuildEqualityHashFilter();
+
     return Status::OK();
 }
 
@@ -443,6 +443,22 @@ public:
 private:
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Rebuilds '_equalityHashFilter' from '_equalitySet'. Must be called whenever the equalities
+     * or the collator change, since the element hashes respect the collation.
+     */
+    void _rebuildEqualityHashFilter();
+
+    /**
+     * Returns false only if 'e' is definitely not in '_equalitySet'. Used to skip the binary
+     * search over full element comparisons for the common miss case.
+     */
+    bool _maybeInEqualitySet(const BSONElement& e) const;
+
+    // Number of equalities below which the hash prefilter is not built; the flat_set's binary
+    // search resolves small lists just as quickly.
+    static const size_t kMinEqualitiesForHashFilter = 16;
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -469,6 +485,12 @@ private:
     // for this set.
     BSONEltFlatSet _equalitySet;
 
+    // Bloom filter over the '_eltCmp' hashes of '_equalitySet', two bit probes per element. The
+    // hash respects the comparator's equivalence classes (numeric widening, collation), so a miss
+    // in the filter proves the element is not in the set. Empty when the list of equalities is
+    // too small for the filter to pay off.
+    std::vector<uint64_t> _equalityHashFilter;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
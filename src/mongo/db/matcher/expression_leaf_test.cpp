@@ -1144,6 +1144,55 @@ TEST(InMatchExpression, MatchesElementMultiple) {
 }
 
 
+TEST(InMatchExpression, MatchesElementLargeListUsesHashPrefilter) {
+    // Large enough to enable the hash prefilter over the equality set.
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 1000; i += 2) {
+        bab.append(i);
+    }
+    BSONObj operand = bab.arr();
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+
+    InMatchExpression in("");
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    for (int i = 0; i < 1000; i++) {
+        BSONObj candidate = BSON("a" << i);
+        ASSERT_EQUALS(i % 2 == 0, in.matchesSingleElement(candidate["a"]));
+    }
+
+    // Numeric widening must hash into the same equivalence class as the set comparison.
+    BSONObj doubleMatch = BSON("a" << 42.0);
+    BSONObj doubleNotMatch = BSON("a" << 42.5);
+    ASSERT(in.matchesSingleElement(doubleMatch["a"]));
+    ASSERT(!in.matchesSingleElement(doubleNotMatch["a"]));
+}
+
+TEST(InMatchExpression, LargeListRespectsCollatorWithHashPrefilter) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 100; i++) {
+        bab.append("string" + std::to_string(i));
+    }
+    BSONObj operand = bab.arr();
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+
+    InMatchExpression in("");
+    // Setting the collator after the equalities exercises the prefilter rebuild.
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    in.setCollator(&collator);
+
+    for (int i = 0; i < 100; i++) {
+        BSONObj match = BSON("a" << ("string" + std::to_string(i)));
+        ASSERT(in.matchesSingleElement(match["a"]));
+    }
+    BSONObj notMatch = BSON("a"
+                            << "string100");
+    ASSERT(!in.matchesSingleElement(notMatch["a"]));
+}
+
 TEST(InMatchExpression, MatchesScalar) {
     BSONObj operand = BSON_ARRAY(5);
     InMatchExpression in("a");
@@ -49,6 +49,7 @@ public:
         _elementPath.init(_path);
         _elementPath.setLeafArrayBehavior(leafArrBehavior);
         _elementPath.setNonLeafArrayBehavior(nonLeafArrayBehavior);
+        _isSingleSegmentPath = _path.find('.') == std::string::npos;
     }
 
     virtual ~PathMatchExpression() {}
@@ -68,6 +69,22 @@ public:
         return false;
     }
 
+    /**
+     * A single-segment path on a non-array value identifies exactly one element, so the match can
+     * probe the document directly and skip the MatchableDocument and ElementIterator machinery.
+     * Arrays and dotted paths fall through to the general traversal, which also covers the
+     * missing-field case identically (the probe yields an eoo element either way).
+     */
+    bool matchesBSON(const BSONObj& doc, MatchDetails* details = nullptr) const final {
+        if (_isSingleSegmentPath) {
+            BSONElement e = doc.getField(_path);
+            if (e.type() != Array) {
+                return matchesSingleElement(e, details);
+            }
+        }
+        return MatchExpression::matchesBSON(doc, details);
+    }
+
     const StringData path() const final {
         return _path;
     }
@@ -75,6 +92,7 @@ public:
     void setPath(StringData path) {
         _path = path;
         _elementPath.init(_path);
+        _isSingleSegmentPath = _path.find('.') == std::string::npos;
     }
 
     /**
@@ -128,6 +146,9 @@ private:
     StringData _path;
     ElementPath _elementPath;
 
+    // True if '_path' has a single segment, enabling the direct-probe fast path in matchesBSON().
+    bool _isSingleSegmentPath = false;
+
     // We use this when we rewrite the value in '_path' and we need a backing store for the
     // rewritten string.
     std::string _rewrittenPath;
@@ -57,7 +57,7 @@ void MultikeyPathTracker::addMultikeyPathInfo(MultikeyPathInfo info) {
     }
 
     // If an existing entry wasn't found for the (collection, index) input, create a new entry.
-    _multikeyPathInfo.emplace_back(info);
+    _multikeyPathInfo.emplace_back(std::move(info));
 }
 
 const WorkerMultikeyPathInfo& MultikeyPathTracker::getMultikeyPathInfo() const {
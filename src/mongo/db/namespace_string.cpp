@@ -33,6 +33,9 @@
 #include <ostream>
 
 #include "mongo/base/parse_number.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -43,8 +46,45 @@ constexpr auto listIndexesCursorNSPrefix = "$cmd.listIndexes."_sd;
 constexpr auto collectionlessAggregateCursorCol = "$cmd.aggregate"_sd;
 constexpr auto dropPendingNSPrefix = "system.drop."_sd;
 
+// The intern table is sharded so namespace construction does not serialize behind a single
+// mutex, and each shard is LRU-bounded so a workload generating unbounded distinct namespaces
+// cannot grow the table without limit. An entry evicted from the table stays alive for as long
+// as any NamespaceString still references it; re-interning the same namespace afterwards simply
+// creates a fresh entry.
+const size_t kInternTableShards = 16;
+const size_t kInternTableShardSize = 256;
+
 }  // namespace
 
+std::shared_ptr<const NamespaceString::Interned> NamespaceString::_intern(StringData ns) {
+    struct Shard {
+        SimpleMutex mutex;
+        LRUCache<std::string, std::shared_ptr<const Interned>> entries{kInternTableShardSize};
+    };
+    static Shard* shards = new Shard[kInternTableShards];
+
+    std::string nsStr = ns.toString();
+    Shard& shard = shards[std::hash<std::string>()(nsStr) % kInternTableShards];
+
+    stdx::lock_guard<SimpleMutex> lk(shard.mutex);
+    auto it = shard.entries.find(nsStr);
+    if (it != shard.entries.end()) {
+        return it->second;
+    }
+
+    auto entry = std::make_shared<const Interned>(std::move(nsStr));
+    shard.entries.add(entry->ns, entry);
+    return entry;
+}
+
+const std::shared_ptr<const NamespaceString::Interned>& NamespaceString::_emptyInterned() {
+    // Default-constructed NamespaceStrings are common enough to share one entry, created on
+    // first use so the empty namespace never occupies an intern table slot.
+    static const auto* empty =
+        new std::shared_ptr<const Interned>(std::make_shared<const Interned>(std::string()));
+    return *empty;
+}
+
 constexpr StringData NamespaceString::kAdminDb;
 constexpr StringData NamespaceString::kLocalDb;
 constexpr StringData NamespaceString::kConfigDb;
@@ -167,7 +207,7 @@ NamespaceString NamespaceString::makeDropPendingNamespace(const repl::OpTime& op
 StatusWith<repl::OpTime> NamespaceString::getDropPendingNamespaceOpTime() const {
     if (!isDropPendingNamespace()) {
         return Status(ErrorCodes::BadValue,
-                      str::stream() << "Not a drop-pending namespace: " << _ns);
+                      str::stream() << "Not a drop-pending namespace: " << ns());
     }
 
     auto collectionName = coll();
@@ -180,20 +220,20 @@ StatusWith<repl::OpTime> NamespaceString::getDropPendingNamespaceOpTime() const
     auto incrementSeparatorIndex = opTimeStr.find('i');
     if (std::string::npos == incrementSeparatorIndex) {
         return Status(ErrorCodes::FailedToParse,
-                      str::stream() << "Missing 'i' separator in drop-pending namespace: " << _ns);
+                      str::stream() << "Missing 'i' separator in drop-pending namespace: " << ns());
     }
 
     auto termSeparatorIndex = opTimeStr.find('t', incrementSeparatorIndex);
     if (std::string::npos == termSeparatorIndex) {
         return Status(ErrorCodes::FailedToParse,
-                      str::stream() << "Missing 't' separator in drop-pending namespace: " << _ns);
+                      str::stream() << "Missing 't' separator in drop-pending namespace: " << ns());
     }
 
     long long seconds;
     auto status = parseNumberFromString(opTimeStr.substr(0, incrementSeparatorIndex), &seconds);
     if (!status.isOK()) {
         return status.withContext(
-            str::stream() << "Invalid timestamp seconds in drop-pending namespace: " << _ns);
+            str::stream() << "Invalid timestamp seconds in drop-pending namespace: " << ns());
     }
 
     unsigned int increment;
@@ -203,14 +243,14 @@ StatusWith<repl::OpTime> NamespaceString::getDropPendingNamespaceOpTime() const
                               &increment);
     if (!status.isOK()) {
         return status.withContext(
-            str::stream() << "Invalid timestamp increment in drop-pending namespace: " << _ns);
+            str::stream() << "Invalid timestamp increment in drop-pending namespace: " << ns());
     }
 
     long long term;
     status = mongo::parseNumberFromString(opTimeStr.substr(termSeparatorIndex + 1), &term);
     if (!status.isOK()) {
         return status.withContext(str::stream() << "Invalid term in drop-pending namespace: "
-                                                << _ns);
+                                                << ns());
     }
 
     return repl::OpTime(Timestamp(Seconds(seconds), increment), term);
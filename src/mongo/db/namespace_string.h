@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <boost/optional.hpp>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
 #include "mongo/base/status_with.h"
@@ -94,25 +95,23 @@ public:
     /**
      * Constructs an empty NamespaceString.
      */
-    NamespaceString() : _ns(), _dotIndex(std::string::npos) {}
+    NamespaceString() : _interned(_emptyInterned()) {}
 
     /**
      * Constructs a NamespaceString from the fully qualified namespace named in "ns".
      */
     explicit NamespaceString(StringData ns) {
-        _ns = ns.toString();  // copy to our buffer
-        _dotIndex = _ns.find('.');
         uassert(ErrorCodes::InvalidNamespace,
                 "namespaces cannot have embedded null characters",
-                _ns.find('\0') == std::string::npos);
+                ns.find('\0') == std::string::npos);
+        _interned = _intern(ns);
     }
 
     /**
      * Constructs a NamespaceString for the given database and collection names.
      * "dbName" must not contain a ".", and "collectionName" must not start with one.
      */
-    NamespaceString(StringData dbName, StringData collectionName)
-        : _ns(dbName.size() + collectionName.size() + 1, '\0') {
+    NamespaceString(StringData dbName, StringData collectionName) {
         uassert(ErrorCodes::InvalidNamespace,
                 "'.' is an invalid character in a database name",
                 dbName.find('.') == std::string::npos);
@@ -120,18 +119,19 @@ public:
                 "Collection names cannot start with '.'",
                 collectionName.empty() || collectionName[0] != '.');
 
-        std::string::iterator it = std::copy(dbName.begin(), dbName.end(), _ns.begin());
+        std::string ns(dbName.size() + collectionName.size() + 1, '\0');
+        std::string::iterator it = std::copy(dbName.begin(), dbName.end(), ns.begin());
         *it = '.';
         ++it;
         it = std::copy(collectionName.begin(), collectionName.end(), it);
-        _dotIndex = dbName.size();
-
-        dassert(it == _ns.end());
-        dassert(_ns[_dotIndex] == '.');
+        dassert(it == ns.end());
 
         uassert(ErrorCodes::InvalidNamespace,
                 "namespaces cannot have embedded null characters",
-                _ns.find('\0') == std::string::npos);
+                ns.find('\0') == std::string::npos);
+
+        _interned = _intern(ns);
+        dassert(_dotIndex() == dbName.size());
     }
 
     /**
@@ -181,17 +181,18 @@ public:
     };
 
     StringData db() const {
-        return _dotIndex == std::string::npos ? _ns : StringData(_ns.data(), _dotIndex);
+        return _dotIndex() == std::string::npos ? StringData(_ns())
+                                                : StringData(_ns().data(), _dotIndex());
     }
 
     StringData coll() const {
-        return _dotIndex == std::string::npos
+        return _dotIndex() == std::string::npos
             ? StringData()
-            : StringData(_ns.c_str() + _dotIndex + 1, _ns.size() - 1 - _dotIndex);
+            : StringData(_ns().c_str() + _dotIndex() + 1, _ns().size() - 1 - _dotIndex());
     }
 
     const std::string& ns() const {
-        return _ns;
+        return _ns();
     }
 
     const std::string& toString() const {
@@ -199,16 +200,17 @@ public:
     }
 
     size_t size() const {
-        return _ns.size();
+        return _ns().size();
     }
 
     bool isEmpty() const {
-        return _ns.empty();
+        return _ns().empty();
     }
 
     struct Hasher {
         size_t operator()(const NamespaceString& nss) const {
-            return std::hash<std::string>()(nss._ns);
+            // The hash was computed once, when the interned entry was created.
+            return nss._interned->hash;
         }
     };
 
@@ -244,10 +246,10 @@ public:
         return coll() == "$cmd";
     }
     bool isOplog() const {
-        return oplog(_ns);
+        return oplog(_ns());
     }
     bool isSpecial() const {
-        return special(_ns);
+        return special(_ns());
     }
     bool isOnInternalDb() const {
         if (db() == kAdminDb)
@@ -259,7 +261,7 @@ public:
         return false;
     }
     bool isNormal() const {
-        return normal(_ns);
+        return normal(_ns());
     }
     bool isOrphanCollection() const {
         return db() == kOrphanCollectionDb && coll().startsWith(kOrphanCollectionPrefix);
@@ -270,7 +272,7 @@ public:
      * generic data storage.
      */
     bool isVirtualized() const {
-        return virtualized(_ns);
+        return virtualized(_ns());
     }
 
     /**
@@ -429,10 +431,12 @@ public:
 
     // Relops among `NamespaceString`.
     friend bool operator==(const NamespaceString& a, const NamespaceString& b) {
-        return a.ns() == b.ns();
+        // Copies and intern table hits share the same entry, so equal namespaces usually
+        // compare equal without looking at the characters.
+        return a._interned == b._interned || a.ns() == b.ns();
     }
     friend bool operator!=(const NamespaceString& a, const NamespaceString& b) {
-        return a.ns() != b.ns();
+        return !(a == b);
     }
     friend bool operator<(const NamespaceString& a, const NamespaceString& b) {
         return a.ns() < b.ns();
@@ -448,8 +452,42 @@ public:
     }
 
 private:
-    std::string _ns;
-    size_t _dotIndex;
+    /**
+     * The immutable backing storage for a namespace, shared by every NamespaceString naming
+     * that namespace. The db/coll split and the hash are computed once, when the entry is
+     * created.
+     */
+    struct Interned {
+        explicit Interned(std::string fullNs)
+            : ns(std::move(fullNs)), dotIndex(ns.find('.')), hash(std::hash<std::string>()(ns)) {}
+
+        const std::string ns;
+        const size_t dotIndex;
+        const size_t hash;
+    };
+
+    /**
+     * Returns the shared entry for 'ns', consulting the global intern table so that the few
+     * hundred distinct namespaces a typical workload touches share one allocation each.
+     */
+    static std::shared_ptr<const Interned> _intern(StringData ns);
+
+    /**
+     * Returns the shared entry for the empty namespace, used by the default constructor.
+     */
+    static const std::shared_ptr<const Interned>& _emptyInterned();
+
+    const std::string& _ns() const {
+        return _interned->ns;
+    }
+
+    size_t _dotIndex() const {
+        return _interned->dotIndex;
+    }
+
+    // Copying a NamespaceString bumps the entry's reference count instead of copying the
+    // string. The entry is never modified after construction.
+    std::shared_ptr<const Interned> _interned;
 };
 
 /**
@@ -374,5 +374,29 @@ TEST(NamespaceStringTest, EmptyNSStringReturnsEmptyDb) {
     ASSERT_EQ(nss.db(), StringData{});
 }
 
+TEST(NamespaceStringTest, CopiesShareInternedStorage) {
+    NamespaceString original("test.foo");
+    NamespaceString copy = original;
+    ASSERT_EQUALS(original, copy);
+    ASSERT_EQUALS(static_cast<const void*>(original.ns().data()),
+                  static_cast<const void*>(copy.ns().data()));
+}
+
+TEST(NamespaceStringTest, ReconstructedNamespaceSharesInternedStorage) {
+    // Two independently parsed instances of the same namespace resolve to the same intern
+    // table entry.
+    NamespaceString first("interntest.sharedEntry");
+    NamespaceString second("interntest.sharedEntry");
+    ASSERT_EQUALS(first, second);
+    ASSERT_EQUALS(static_cast<const void*>(first.ns().data()),
+                  static_cast<const void*>(second.ns().data()));
+}
+
+TEST(NamespaceStringTest, HasherMatchesAcrossConstructionPaths) {
+    NamespaceString fromNs("interntest.hash");
+    NamespaceString fromDbAndColl("interntest", "hash");
+    ASSERT_EQUALS(NamespaceString::Hasher()(fromNs), NamespaceString::Hasher()(fromDbAndColl));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -37,6 +37,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/namespace_uuid_cache.h"
+#include "mongo/db/collection_hash_registry.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
@@ -66,6 +67,11 @@ MONGO_FAIL_POINT_DEFINE(failCollectionUpdates);
 
 const auto documentKeyDecoration = OperationContext::declareDecoration<BSONObj>();
 
+// Digest of the document about to be deleted, stashed by aboutToDelete() for onDelete() to fold
+// into the incremental collection hash.
+const auto deletedDocHashDecoration =
+    OperationContext::declareDecoration<boost::optional<CollectionHashRegistry::Hash>>();
+
 repl::OpTime logOperation(OperationContext* opCtx,
                           const char* opstr,
                           const NamespaceString& ns,
@@ -408,6 +414,13 @@ void OpObserverImpl::onInserts(OperationContext* opCtx,
             opCtx, nss, session, stmtIdsWritten, lastOpTime, lastWriteDate, boost::none);
     }
 
+    if (uuid && CollectionHashRegistry::isEnabled()) {
+        auto& collectionHashes = CollectionHashRegistry::get(opCtx->getServiceContext());
+        for (auto it = first; it != last; it++) {
+            collectionHashes.onInsert(opCtx, *uuid, it->doc);
+        }
+    }
+
     size_t index = 0;
     for (auto it = first; it != last; it++, index++) {
         AuthorizationManager::get(opCtx->getServiceContext())
@@ -473,6 +486,11 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
                            boost::none);
     }
 
+    if (CollectionHashRegistry::isEnabled()) {
+        CollectionHashRegistry::get(opCtx->getServiceContext())
+            .onUpdate(opCtx, args.uuid, args.updateArgs.preImageDoc, args.updateArgs.updatedDoc);
+    }
+
     AuthorizationManager::get(opCtx->getServiceContext())
         ->logOp(opCtx, "u", args.nss, args.updateArgs.update, &args.updateArgs.criteria);
 
@@ -505,6 +523,11 @@ void OpObserverImpl::aboutToDelete(OperationContext* opCtx,
                                    BSONObj const& doc) {
     documentKeyDecoration(opCtx) = getDocumentKey(opCtx, nss, doc);
 
+    if (CollectionHashRegistry::isEnabled()) {
+        // onDelete() receives the full document only in special cases, so digest it here.
+        deletedDocHashDecoration(opCtx) = CollectionHashRegistry::hashDocument(doc);
+    }
+
     shardObserveAboutToDelete(opCtx, nss, doc);
 }
 
@@ -517,6 +540,15 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
     auto& documentKey = documentKeyDecoration(opCtx);
 
     invariant(!documentKey.isEmpty());
+
+    if (uuid && CollectionHashRegistry::isEnabled()) {
+        auto& docHash = deletedDocHashDecoration(opCtx);
+        if (docHash) {
+            CollectionHashRegistry::get(opCtx->getServiceContext())
+                .onDelete(opCtx, *uuid, *docHash);
+            docHash = boost::none;
+        }
+    }
     auto txnParticipant = TransactionParticipant::get(opCtx);
     const bool inMultiDocumentTransaction = txnParticipant && opCtx->writesAreReplicated() &&
         txnParticipant->inMultiDocumentTransaction();
@@ -754,6 +786,10 @@ repl::OpTime OpObserverImpl::onDropCollection(OperationContext* opCtx,
             "dropping the server configuration collection (admin.system.version) is not allowed.",
             collectionName != NamespaceString::kServerConfigurationNamespace);
 
+    if (uuid && CollectionHashRegistry::isEnabled()) {
+        CollectionHashRegistry::get(opCtx->getServiceContext()).invalidate(*uuid);
+    }
+
     if (collectionName.coll() == DurableViewCatalog::viewsCollectionName()) {
         DurableViewCatalog::onExternalChange(opCtx, collectionName);
     } else if (collectionName == NamespaceString::kSessionTransactionsTableNamespace) {
@@ -1124,6 +1160,12 @@ void OpObserverImpl::onReplicationRollback(OperationContext* opCtx,
         SessionCatalog::get(opCtx)->invalidateSessions(opCtx, boost::none);
     }
 
+    // Rollback rewrites collection contents through paths that bypass the document-level
+    // observer hooks, so the incremental collection hashes must be rebuilt from scratch.
+    if (CollectionHashRegistry::isEnabled()) {
+        CollectionHashRegistry::get(opCtx->getServiceContext()).invalidateAll();
+    }
+
     // Reset the key manager cache.
     auto validator = LogicalTimeValidator::get(opCtx);
     if (validator) {
@@ -147,6 +147,17 @@ StatusWith<BSONObj> fixDocumentForInsert(ServiceContext* service, const BSONObj&
     if (firstElementIsId && !hasTimestampToFix)
         return StatusWith<BSONObj>(BSONObj());
 
+    if (!hadId && !hasTimestampToFix) {
+        // Common driver-less case: the document is fine as-is except that it needs a generated
+        // _id prepended. Bulk-copy the original element bytes rather than re-appending one
+        // element at a time, so the rest of the insert path can stay a single memcpy of the
+        // incoming message payload.
+        BSONObjBuilder b(doc.objsize() + 16);
+        b.appendOID("_id", NULL, true);
+        b.appendElements(doc);
+        return StatusWith<BSONObj>(b.obj());
+    }
+
     BSONObjIterator i(doc);
 
     BSONObjBuilder b(doc.objsize() + 16);
@@ -31,10 +31,12 @@
 #include "mongo/db/pipeline/document.h"
 
 #include <boost/functional/hash.hpp>
+#include <cstdlib>
 
 #include "mongo/bson/bson_depth.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/field_path.h"
+#include "mongo/util/allocator.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -120,6 +122,42 @@ Value& DocumentStorage::appendField(StringData name) {
     return getField(pos).val;
 }
 
+namespace {
+
+// Per-thread cache of DocumentStorage blocks. 32 retained blocks cover the deepest temporary
+// chains a single pipeline stage produces without holding a meaningful amount of idle memory
+// (~40KB per active thread).
+const size_t kStoragePoolMaxBlocks = 32;
+
+struct StoragePool {
+    ~StoragePool() {
+        for (size_t i = 0; i < size; i++)
+            free(blocks[i]);
+    }
+    void* blocks[kStoragePoolMaxBlocks];
+    size_t size = 0;
+};
+
+thread_local StoragePool storagePool;
+
+}  // namespace
+
+void* DocumentStorage::operator new(size_t sz) {
+    // Subclasses (there are none today) would have a different size and must not use the pool.
+    if (sz == sizeof(DocumentStorage) && storagePool.size > 0) {
+        return storagePool.blocks[--storagePool.size];
+    }
+    return mongoMalloc(sz);
+}
+
+void DocumentStorage::operator delete(void* ptr, size_t sz) {
+    if (sz == sizeof(DocumentStorage) && storagePool.size < kStoragePoolMaxBlocks) {
+        storagePool.blocks[storagePool.size++] = ptr;
+        return;
+    }
+    free(ptr);
+}
+
 // Call after adding field to _fields and increasing _numFields
 void DocumentStorage::addFieldToHashTable(Position pos) {
     ValueElement& elem = getField(pos);
@@ -151,21 +189,25 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_buffer);
-    _buffer = new char[capacity];
+    char* const oldBufPtr = _buffer;
+    std::unique_ptr<char[]> oldBuf(usingInlineBuffer() ? nullptr : _buffer);
+    _buffer = capacity <= INLINE_BUFFER_BYTES ? _inlineBuffer : new char[capacity];
     _bufferEnd = _buffer + capacity - hashTabBytes();
 
     if (!firstAlloc) {
-        // This just copies the elements
-        memcpy(_buffer, oldBuf.get(), _usedBytes);
+        // This just copies the elements. Growth within the inline buffer keeps the same base
+        // pointer, in which case the elements are already in place.
+        if (_buffer != oldBufPtr)
+            memcpy(_buffer, oldBufPtr, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
             if (doingRehash) {
                 rehash();
             } else {
-                // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                // no rehash needed so just slide table down to new position; memmove since the
+                // old and new table positions can share the inline buffer
+                memmove(_hashTab, oldBufPtr + oldCapacity, hashTabBytes());
             }
         }
     }
@@ -184,7 +226,8 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _buffer = new char[newSize + hashTabBytes()];
+    const size_t totalSize = newSize + hashTabBytes();
+    _buffer = totalSize <= INLINE_BUFFER_BYTES ? _inlineBuffer : new char[totalSize];
     _bufferEnd = _buffer + newSize;
 }
 
@@ -194,7 +237,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     // Make a copy of the buffer.
     // It is very important that the positions of each field are the same after cloning.
     const size_t bufferBytes = allocatedBytes();
-    out->_buffer = new char[bufferBytes];
+    out->_buffer = bufferBytes <= INLINE_BUFFER_BYTES ? out->_inlineBuffer : new char[bufferBytes];
     out->_bufferEnd = out->_buffer + (_bufferEnd - _buffer);
     if (bufferBytes > 0) {
         memcpy(out->_buffer, _buffer, bufferBytes);
@@ -220,7 +263,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_buffer);
+    std::unique_ptr<char[]> deleteBufferAtScopeEnd(usingInlineBuffer() ? nullptr : _buffer);
 
     for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_diff.h"
+
+#include <cstring>
+
+#include "mongo/bson/bsonobjiterator.h"
+
+namespace mongo {
+namespace document_diff {
+
+namespace {
+
+/**
+ * Diffs the objects rooted at 'pre' and 'post', whose buffers start at 'preBase' and 'postBase'
+ * respectively. Returns false as soon as a structural difference is found.
+ */
+bool diffObjects(const BSONObj& pre,
+                 const BSONObj& post,
+                 const char* preBase,
+                 const char* postBase,
+                 mutablebson::DamageVector* damages) {
+    BSONObjIterator preIt(pre);
+    BSONObjIterator postIt(post);
+
+    while (preIt.more() && postIt.more()) {
+        BSONElement preElem = preIt.next();
+        BSONElement postElem = postIt.next();
+
+        // A damage patches value bytes only, so the element headers (type byte and field name)
+        // must match exactly.
+        if (preElem.type() != postElem.type() ||
+            preElem.fieldNameStringData() != postElem.fieldNameStringData()) {
+            return false;
+        }
+
+        const int valueSize = preElem.valuesize();
+        if (valueSize != postElem.valuesize()) {
+            return false;
+        }
+
+        if (std::memcmp(preElem.value(), postElem.value(), valueSize) == 0) {
+            continue;
+        }
+
+        if (preElem.type() == Object || preElem.type() == Array) {
+            // Descend so that a change to one member of a large subdocument damages only that
+            // member's bytes.
+            if (!diffObjects(preElem.Obj(), postElem.Obj(), preBase, postBase, damages)) {
+                return false;
+            }
+            continue;
+        }
+
+        mutablebson::DamageEvent event;
+        event.sourceOffset = postElem.value() - postBase;
+        event.targetOffset = preElem.value() - preBase;
+        event.size = valueSize;
+        damages->push_back(event);
+    }
+
+    // Any leftover elements on either side mean a field was added or removed.
+    return !preIt.more() && !postIt.more();
+}
+
+}  // namespace
+
+bool computeInPlaceDamages(const BSONObj& pre,
+                           const BSONObj& post,
+                           mutablebson::DamageVector* damages) {
+    if (!diffObjects(pre, post, pre.objdata(), post.objdata(), damages)) {
+        damages->clear();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace document_diff
+}  // namespace mongo
@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/mutable/damage_vector.h"
+
+namespace mongo {
+namespace document_diff {
+
+/**
+ * Computes the byte-level differences that turn 'pre' into 'post' and appends them to 'damages',
+ * with source offsets relative to 'post.objdata()' and target offsets relative to
+ * 'pre.objdata()'. The resulting damage vector is suitable for RecordStore::updateWithDamages,
+ * which patches byte ranges of the stored record in place.
+ *
+ * Damages can only describe same-size overwrites, so this returns true only when 'post' preserves
+ * the structure of 'pre': the same fields in the same order, with each changed value occupying
+ * exactly as many bytes as the value it replaces. Objects and arrays are descended into so that a
+ * change deep inside a large document damages only the bytes of the leaf value. When the
+ * documents differ structurally (fields added, removed, renamed, reordered, retyped or resized)
+ * this returns false and leaves 'damages' empty; callers should then fall back to a whole-document
+ * update.
+ *
+ * Returns true with an empty damage vector when the documents are byte-for-byte identical.
+ */
+bool computeInPlaceDamages(const BSONObj& pre,
+                           const BSONObj& post,
+                           mutablebson::DamageVector* damages);
+
+}  // namespace document_diff
+}  // namespace mongo
@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cstring>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/document_diff.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace document_diff {
+namespace {
+
+/**
+ * Applies 'damages' (with 'post' as the source buffer) to a copy of 'pre' and returns the result.
+ */
+BSONObj applyDamages(const BSONObj& pre,
+                     const BSONObj& post,
+                     const mutablebson::DamageVector& damages) {
+    std::vector<char> buffer(pre.objdata(), pre.objdata() + pre.objsize());
+    for (auto&& damage : damages) {
+        std::memcpy(
+            buffer.data() + damage.targetOffset, post.objdata() + damage.sourceOffset, damage.size);
+    }
+    return BSONObj(buffer.data()).getOwned();
+}
+
+TEST(DocumentDiffTest, IdenticalDocumentsProduceNoDamages) {
+    auto doc = fromjson("{a: 1, b: {c: 'x'}}");
+    mutablebson::DamageVector damages;
+    ASSERT_TRUE(computeInPlaceDamages(doc, doc, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+TEST(DocumentDiffTest, ChangedScalarDamagesOnlyThatValue) {
+    auto pre = fromjson("{a: 1, b: 2, c: 3}");
+    auto post = fromjson("{a: 1, b: 5, c: 3}");
+    mutablebson::DamageVector damages;
+    ASSERT_TRUE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_EQUALS(sizeof(int), damages[0].size);
+    ASSERT_BSONOBJ_EQ(post, applyDamages(pre, post, damages));
+}
+
+TEST(DocumentDiffTest, ChangeInsideSubdocumentDamagesOnlyTheLeaf) {
+    auto pre = fromjson("{a: {b: {c: 1, d: 2}}, e: 3}");
+    auto post = fromjson("{a: {b: {c: 1, d: 7}}, e: 3}");
+    mutablebson::DamageVector damages;
+    ASSERT_TRUE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_EQUALS(sizeof(int), damages[0].size);
+    ASSERT_BSONOBJ_EQ(post, applyDamages(pre, post, damages));
+}
+
+TEST(DocumentDiffTest, MultipleChangesProduceMultipleDamages) {
+    auto pre = fromjson("{a: 1, b: {c: 2}, d: 3}");
+    auto post = fromjson("{a: 9, b: {c: 8}, d: 3}");
+    mutablebson::DamageVector damages;
+    ASSERT_TRUE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_EQUALS(2U, damages.size());
+    ASSERT_BSONOBJ_EQ(post, applyDamages(pre, post, damages));
+}
+
+TEST(DocumentDiffTest, SameLengthStringChangeIsInPlace) {
+    auto pre = fromjson("{a: 'hello'}");
+    auto post = fromjson("{a: 'world'}");
+    mutablebson::DamageVector damages;
+    ASSERT_TRUE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_BSONOBJ_EQ(post, applyDamages(pre, post, damages));
+}
+
+TEST(DocumentDiffTest, ArrayElementChangeIsInPlace) {
+    auto pre = fromjson("{a: [1, 2, 3]}");
+    auto post = fromjson("{a: [1, 4, 3]}");
+    mutablebson::DamageVector damages;
+    ASSERT_TRUE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_BSONOBJ_EQ(post, applyDamages(pre, post, damages));
+}
+
+TEST(DocumentDiffTest, DifferentLengthStringIsNotExpressible) {
+    auto pre = fromjson("{a: 'short'}");
+    auto post = fromjson("{a: 'a bit longer'}");
+    mutablebson::DamageVector damages;
+    ASSERT_FALSE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+TEST(DocumentDiffTest, AddedFieldIsNotExpressible) {
+    auto pre = fromjson("{a: 1}");
+    auto post = fromjson("{a: 1, b: 2}");
+    mutablebson::DamageVector damages;
+    ASSERT_FALSE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+TEST(DocumentDiffTest, RemovedFieldIsNotExpressible) {
+    auto pre = fromjson("{a: 1, b: 2}");
+    auto post = fromjson("{a: 1}");
+    mutablebson::DamageVector damages;
+    ASSERT_FALSE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+TEST(DocumentDiffTest, ReorderedFieldsAreNotExpressible) {
+    auto pre = fromjson("{a: 1, b: 2}");
+    auto post = fromjson("{b: 2, a: 1}");
+    mutablebson::DamageVector damages;
+    ASSERT_FALSE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+TEST(DocumentDiffTest, TypeChangeIsNotExpressible) {
+    auto pre = fromjson("{a: 1}");
+    auto post = fromjson("{a: true}");
+    mutablebson::DamageVector damages;
+    ASSERT_FALSE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+TEST(DocumentDiffTest, PartialDamagesAreClearedOnFailure) {
+    // The first field changes in place, but the second field resizes; no damages may leak out.
+    auto pre = fromjson("{a: 1, b: 'one'}");
+    auto post = fromjson("{a: 2, b: 'three'}");
+    mutablebson::DamageVector damages;
+    ASSERT_FALSE(computeInPlaceDamages(pre, post, &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+}  // namespace
+}  // namespace document_diff
+}  // namespace mongo
@@ -194,6 +194,16 @@ public:
 
     ~DocumentStorage();
 
+    /**
+     * DocumentStorage objects are created and destroyed at a very high rate by expression
+     * evaluation ($project, $addFields and friends create a storage per produced document), so
+     * they are recycled through a thread-local free list rather than returned to the general
+     * allocator. The blocks are all the same size, which makes the pool trivial: pop on new,
+     * push on delete, with a fixed cap on retained blocks.
+     */
+    void* operator new(size_t sz);
+    void operator delete(void* ptr, size_t sz);
+
     enum MetaType : char {
         TEXT_SCORE,
         RAND_VAL,
@@ -405,6 +415,18 @@ private:
                                  // set to 1 to always hash
     };
 
+    enum {
+        // Documents whose element space plus hash table fits in this many bytes (roughly 16
+        // small fields) use the inline slab below rather than a separate heap buffer, so the
+        // typical small document costs a single allocation: the DocumentStorage itself. Must
+        // cover at least one step of the power-of-two growth sequence in alloc().
+        INLINE_BUFFER_BYTES = 1024,
+    };
+
+    bool usingInlineBuffer() const {
+        return _buffer == _inlineBuffer;
+    }
+
     // _buffer layout:
     // -------------------------------------------------------------------------------
     // | ValueElement1 Name1 | ValueElement2 Name2 | ... FREE SPACE ... | Hash Table |
@@ -429,6 +451,9 @@ private:
     unsigned _numFields;    // this includes removed fields
     unsigned _hashTabMask;  // equal to hashTabBuckets()-1 but used more often
 
+    // Small-document storage; see INLINE_BUFFER_BYTES. Intentionally uninitialized.
+    alignas(8) char _inlineBuffer[INLINE_BUFFER_BYTES];
+
     std::bitset<MetaType::NUM_FIELDS> _metaFields;
     double _textScore;
     double _randVal;
@@ -102,17 +102,52 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
         };
 
         _sorter.reset(Sorter<Value, Document>::make(opts, comparator));
+
+        // The sorted entries are only ever fed to the accumulator expressions, so if those
+        // expressions have a finite dependency set and need no metadata, each entry can retain
+        // just the top-level fields containing those dependencies instead of the whole input
+        // document. This bounds what the sorter buffers and spills by the size of the accumulated
+        // fields rather than the size of the collection's documents.
+        DepsTracker accumDeps(DepsTracker::kAllMetadataAvailable);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            accumulatedField.expression->addDependencies(&accumDeps);
+        }
+        if (!accumDeps.needWholeDocument && !accumDeps.getNeedsAnyMetadata()) {
+            _sortPayloadFields.emplace();
+            for (auto&& field : accumDeps.fields) {
+                // Keeping the entire top-level field preserves array traversal semantics for
+                // dotted dependencies.
+                _sortPayloadFields->insert(
+                    FieldPath::extractFirstFieldFromDottedPath(field).toString());
+            }
+        }
     }
 
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
-        _sorter->add(extractKey(nextDoc), nextDoc);
+        auto key = extractKey(nextDoc);
+        _sorter->add(std::move(key), trimDocumentForAccumulators(nextDoc));
         _nDocuments++;
     }
     return next;
 }
 
+Document DocumentSourceBucketAuto::trimDocumentForAccumulators(const Document& doc) const {
+    if (!_sortPayloadFields) {
+        return doc;
+    }
+
+    MutableDocument trimmed(_sortPayloadFields->size());
+    for (auto&& field : *_sortPayloadFields) {
+        auto value = doc.getField(field);
+        if (!value.missing()) {
+            trimmed.addField(field, std::move(value));
+        }
+    }
+    return trimmed.freeze();
+}
+
 Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     if (!_groupByExpression) {
         return Value(BSONNULL);
@@ -124,6 +124,13 @@ private:
      */
     Value extractKey(const Document& doc);
 
+    /**
+     * Returns a copy of 'doc' containing only the top-level fields in '_sortPayloadFields', or
+     * 'doc' itself if the accumulator dependencies could not be narrowed to a field set. The
+     * trimmed document is what is buffered (and possibly spilled) by the sorter.
+     */
+    Document trimDocumentForAccumulators(const Document& doc) const;
+
     /**
      * Calculates the bucket boundaries for the input documents and places them into buckets.
      */
@@ -158,6 +165,11 @@ private:
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
     long long _nDocuments = 0;
+
+    // The top-level fields needed by the 'output' accumulator expressions, when those expressions
+    // have a finite dependency set and need no metadata. Set when the sorter is created; unset
+    // means each sorter entry must retain the entire input document.
+    boost::optional<std::set<std::string>> _sortPayloadFields;
 };
 
 }  // namespace mongo
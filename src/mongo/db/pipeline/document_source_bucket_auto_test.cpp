@@ -288,6 +288,20 @@ TEST_F(BucketAutoTests, EvaluatesAccumulatorsInOutputField) {
     ASSERT_DOCUMENT_EQ(results[1], Document(fromjson("{_id : {min : 4, max : 6}, avg : 5}")));
 }
 
+TEST_F(BucketAutoTests, EvaluatesAccumulatorOnDottedPathThroughArray) {
+    // The sorter only retains the fields needed by the accumulator expressions, so an accumulator
+    // depending on a dotted path that traverses an array must still see the entire top-level
+    // field.
+    auto bucketAutoSpec = fromjson(
+        "{$bucketAuto : {groupBy : '$x', buckets : 1, output : {sum : {$sum : '$y.z'}}}}");
+    auto results = getResults(bucketAutoSpec,
+                              {Document(fromjson("{x : 1, y : [{z : 1}, {z : 2}]}")),
+                               Document(fromjson("{x : 2, y : [{z : 3}]}"))});
+
+    ASSERT_EQUALS(results.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(results[0], Document(fromjson("{_id : {min : 1, max : 2}, sum : 6}")));
+}
+
 TEST_F(BucketAutoTests, EvaluatesNonFieldPathExpressionInGroupByField) {
     auto bucketAutoSpec = fromjson("{$bucketAuto : {groupBy : {$add : ['$x', 1]}, buckets : 2}}");
     auto results = getResults(
@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/change_stream_constants.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_change_stream_close_cursor.h"
+#include "mongo/db/pipeline/document_source_change_stream_coalesce.h"
 #include "mongo/db/pipeline/document_source_change_stream_transform.h"
 #include "mongo/db/pipeline/document_source_check_invalidate.h"
 #include "mongo/db/pipeline/document_source_check_resume_token.h"
@@ -246,8 +247,18 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
     auto commandsOnTargetDb =
         BSON("$and" << BSON_ARRAY(cmdNsFilter << BSON("$or" << relevantCommands.arr())));
 
+    // For a single-collection stream, match the target namespace with an exact string equality.
+    // This is cheaper to evaluate against every oplog entry than the equivalent anchored regex,
+    // which matters on busy oplogs where the vast majority of entries are for other namespaces.
+    // Database and cluster streams must still use a regex to cover multiple namespaces.
+    auto makeNsMatch = [&](StringData fieldName) {
+        return (sourceType == ChangeStreamType::kSingleCollection)
+            ? BSON(fieldName << nss.ns())
+            : BSON(fieldName << BSONRegEx(getNsRegexForChangeStream(nss)));
+    };
+
     // 1.2) Supported commands that have arbitrary db namespaces in "ns" field.
-    auto renameDropTarget = BSON("o.to" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    auto renameDropTarget = makeNsMatch("o.to");
 
     // All supported commands that are either (1.1) or (1.2).
     BSONObj commandMatch = BSON("op"
@@ -264,7 +275,7 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
                                    << "migrateChunkToNewShard");
 
     // 2) Supported operations on the target namespace.
-    BSONObj nsMatch = BSON("ns" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    BSONObj nsMatch = makeNsMatch("ns");
     auto opMatch = BSON(nsMatch["ns"] << OR(normalOpTypeMatch, chunkMigratedMatch));
 
     // 3) Look for 'applyOps' which were created as part of a transaction.
@@ -427,8 +438,23 @@ list<intrusive_ptr<DocumentSource>> DocumentSourceChangeStream::createFromBson(
 
     const bool shouldLookupPostImage = (fullDocOption == "updateLookup"_sd);
 
+    const auto coalesceWindowMillis = spec.getCoalesceWindowMillis();
+    uassert(51472,
+            str::stream() << "coalesceWindowMillis must be non-negative, got "
+                          << coalesceWindowMillis,
+            coalesceWindowMillis >= 0);
+
     auto stages = buildPipeline(expCtx, spec, elem);
     if (!expCtx->needsMerge) {
+        // If requested, coalesce update events ahead of the close cursor stage, so that buffered
+        // events are flushed before any invalidate notification is examined. This stage must see
+        // the whole stream, so in a sharded cluster it runs on mongos after the events from all
+        // shards have been merged.
+        if (coalesceWindowMillis > 0) {
+            stages.push_back(
+                DocumentSourceChangeStreamCoalesce::create(expCtx, coalesceWindowMillis));
+        }
+
         // There should only be one close cursor stage. If we're on the shards and producing input
         // to be merged, do not add a close cursor stage, since the mongos will already have one.
         stages.push_back(DocumentSourceCloseCursor::create(expCtx));
@@ -0,0 +1,230 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_change_stream_coalesce.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mongo {
+
+using DSCS = DocumentSourceChangeStream;
+
+namespace {
+constexpr StringData kUpdatedFieldsField = "updatedFields"_sd;
+constexpr StringData kRemovedFieldsField = "removedFields"_sd;
+}  // namespace
+
+boost::intrusive_ptr<DocumentSourceChangeStreamCoalesce> DocumentSourceChangeStreamCoalesce::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, long long windowMillis) {
+    return new DocumentSourceChangeStreamCoalesce(expCtx, windowMillis);
+}
+
+DocumentSourceChangeStreamCoalesce::DocumentSourceChangeStreamCoalesce(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, long long windowMillis)
+    : DocumentSource(expCtx),
+      _windowMillis(windowMillis),
+      _pending(expCtx->getValueComparator().makeUnorderedValueMap<PendingEvent>()) {
+    invariant(windowMillis > 0);
+}
+
+Value DocumentSourceChangeStreamCoalesce::extractCoalesceKey(const Document& doc) const {
+    return Value(Document{{DSCS::kNamespaceField, doc[DSCS::kNamespaceField]},
+                          {DSCS::kDocumentKeyField, doc[DSCS::kDocumentKeyField]}});
+}
+
+Document DocumentSourceChangeStreamCoalesce::composeUpdateEvents(const Document& earlier,
+                                                                 const Document& later) const {
+    auto earlierDesc = earlier[DSCS::kUpdateDescriptionField].getDocument();
+    auto laterDesc = later[DSCS::kUpdateDescriptionField].getDocument();
+
+    // Collect the field names the later event updated and removed; they decide the fate of each
+    // field from the earlier event.
+    std::set<std::string> laterUpdatedNames;
+    {
+        auto iter = laterDesc[kUpdatedFieldsField].getDocument().fieldIterator();
+        while (iter.more()) {
+            laterUpdatedNames.insert(iter.next().first.toString());
+        }
+    }
+    std::set<std::string> laterRemovedNames;
+    for (const auto& removed : laterDesc[kRemovedFieldsField].getArray()) {
+        laterRemovedNames.insert(removed.getString());
+    }
+
+    // The later event's updates win, and a field the later event removed is no longer updated.
+    MutableDocument updatedFields(earlierDesc[kUpdatedFieldsField].getDocument());
+    {
+        auto iter = laterDesc[kUpdatedFieldsField].getDocument().fieldIterator();
+        while (iter.more()) {
+            auto field = iter.next();
+            updatedFields[field.first] = field.second;
+        }
+    }
+    for (const auto& removedName : laterRemovedNames) {
+        updatedFields.remove(removedName);
+    }
+
+    // A field removed by the earlier event stays removed unless the later event touched it.
+    std::vector<Value> removedFields;
+    for (const auto& removed : laterDesc[kRemovedFieldsField].getArray()) {
+        removedFields.push_back(removed);
+    }
+    for (const auto& removed : earlierDesc[kRemovedFieldsField].getArray()) {
+        const auto name = removed.getString();
+        if (!laterUpdatedNames.count(name) && !laterRemovedNames.count(name)) {
+            removedFields.push_back(removed);
+        }
+    }
+
+    // Everything else, in particular the resume token and cluster time, comes from the later
+    // event, so resuming after the merged event skips all of its constituents.
+    MutableDocument result(later);
+    result[DSCS::kUpdateDescriptionField] =
+        Value(Document{{kUpdatedFieldsField, updatedFields.freeze()},
+                       {kRemovedFieldsField, Value(removedFields)}});
+    return result.freeze();
+}
+
+void DocumentSourceChangeStreamCoalesce::expireThrough(Timestamp clusterTime) {
+    // Cluster times have second granularity, so the window is rounded up to whole seconds.
+    while (!_pendingOrder.empty()) {
+        auto it = _pending.find(_pendingOrder.front());
+        invariant(it != _pending.end());
+
+        const auto ageMillis =
+            (static_cast<long long>(clusterTime.getSecs()) -
+             static_cast<long long>(it->second.firstClusterTime.getSecs())) *
+            1000LL;
+        if (ageMillis <= _windowMillis) {
+            break;
+        }
+
+        _readyQueue.push_back(std::move(it->second.event));
+        _pending.erase(it);
+        _pendingOrder.pop_front();
+    }
+}
+
+void DocumentSourceChangeStreamCoalesce::flushKey(const Value& key) {
+    auto it = _pending.find(key);
+    if (it == _pending.end()) {
+        return;
+    }
+
+    _readyQueue.push_back(std::move(it->second.event));
+    _pending.erase(it);
+
+    const auto& cmp = pExpCtx->getValueComparator();
+    _pendingOrder.remove_if([&](const Value& pendingKey) {
+        return cmp.evaluate(pendingKey == key);
+    });
+}
+
+void DocumentSourceChangeStreamCoalesce::flushAll() {
+    for (const auto& key : _pendingOrder) {
+        auto it = _pending.find(key);
+        invariant(it != _pending.end());
+        _readyQueue.push_back(std::move(it->second.event));
+    }
+    _pending.clear();
+    _pendingOrder.clear();
+}
+
+DocumentSource::GetNextResult DocumentSourceChangeStreamCoalesce::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    while (true) {
+        if (!_readyQueue.empty()) {
+            auto result = std::move(_readyQueue.front());
+            _readyQueue.pop_front();
+            return std::move(result);
+        }
+
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            // The source has run out of input for this batch (or for good). Flush everything we
+            // have buffered so that no event is ever held across a getMore boundary.
+            flushAll();
+            if (!_readyQueue.empty()) {
+                continue;
+            }
+            return nextInput;
+        }
+
+        auto doc = nextInput.releaseDocument();
+
+        const auto& kOperationTypeField = DSCS::kOperationTypeField;
+        DSCS::checkValueType(doc[kOperationTypeField], kOperationTypeField, BSONType::String);
+        const auto operationType = doc[kOperationTypeField].getString();
+
+        const auto clusterTime = doc[DSCS::kClusterTimeField];
+        if (clusterTime.getType() == BSONType::bsonTimestamp) {
+            expireThrough(clusterTime.getTimestamp());
+        }
+
+        const auto documentKey = doc[DSCS::kDocumentKeyField];
+
+        if (operationType != DSCS::kUpdateOpType || documentKey.missing() ||
+            doc[DSCS::kUpdateDescriptionField].missing()) {
+            if (documentKey.missing()) {
+                // Commands, invalidates and similar events are not tied to one document; flush
+                // everything so that no coalesced event is delivered after a notification which
+                // may end the stream.
+                flushAll();
+            } else {
+                // Inserts, deletes and replaces must stay ordered with respect to the updates
+                // on the same document key.
+                flushKey(extractCoalesceKey(doc));
+            }
+            _readyQueue.push_back(std::move(doc));
+            continue;
+        }
+
+        auto key = extractCoalesceKey(doc);
+        auto it = _pending.find(key);
+        if (it == _pending.end()) {
+            PendingEvent pending;
+            pending.firstClusterTime = clusterTime.getType() == BSONType::bsonTimestamp
+                ? clusterTime.getTimestamp()
+                : Timestamp();
+            pending.event = std::move(doc);
+            _pending.emplace(key, std::move(pending));
+            _pendingOrder.push_back(std::move(key));
+        } else {
+            it->second.event = composeUpdateEvents(it->second.event, doc);
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,141 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <list>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/value_comparator.h"
+
+namespace mongo {
+
+/**
+ * This stage implements the 'coalesceWindowMillis' option of $changeStream: within the window,
+ * consecutive 'update' events for the same document key are merged into a single event whose
+ * 'updateDescription' is the composition of the individual deltas and whose resume token is that
+ * of the last merged event. Consumers which only apply the latest state per key receive one
+ * event per hot key per window instead of one per write.
+ *
+ * Events are never held across a getMore boundary: when the source runs out of input, all
+ * buffered events are flushed, so the added latency is bounded by the window and the batch.
+ * Non-update events and events that may invalidate the stream flush any event they could be
+ * ordered against before being passed through. Note that coalescing reorders a merged update
+ * relative to later events on other document keys.
+ *
+ * It is not intended to be created by the user.
+ */
+class DocumentSourceChangeStreamCoalesce final : public DocumentSource {
+public:
+    GetNextResult getNext() final;
+
+    const char* getSourceName() const final {
+        // This is used in error reporting.
+        return "$changeStream";
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        // This stage should never be in the shards part of a split pipeline.
+        invariant(pipeState != Pipeline::SplitState::kSplitForShards);
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                // If this is parsed on mongos it should stay on mongos, so that events from all
+                // shards are merged before being coalesced. If we're not in a sharded cluster
+                // then it's okay to run on mongod.
+                HostTypeRequirement::kLocalOnly,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kNotAllowed,
+                TransactionRequirement::kNotAllowed,
+                ChangeStreamRequirement::kChangeStreamStage};
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final {
+        // This stage is created by the DocumentSourceChangeStream stage, so serializing it
+        // here would result in it being created twice.
+        return Value();
+    }
+
+    static boost::intrusive_ptr<DocumentSourceChangeStreamCoalesce> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, long long windowMillis);
+
+private:
+    DocumentSourceChangeStreamCoalesce(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       long long windowMillis);
+
+    struct PendingEvent {
+        Document event;
+
+        // The cluster time of the first event merged into 'event'. The window is measured from
+        // here, so a key which is updated continuously is still emitted once per window.
+        Timestamp firstClusterTime;
+    };
+
+    /**
+     * Returns the value which identifies the document 'doc' is about: its namespace together
+     * with its document key.
+     */
+    Value extractCoalesceKey(const Document& doc) const;
+
+    /**
+     * Returns the event for 'later' with its 'updateDescription' replaced by the composition of
+     * the descriptions of 'earlier' and 'later'.
+     */
+    Document composeUpdateEvents(const Document& earlier, const Document& later) const;
+
+    /**
+     * Moves pending events whose window has expired as of 'clusterTime' into the ready queue,
+     * oldest first.
+     */
+    void expireThrough(Timestamp clusterTime);
+
+    /**
+     * Moves the pending event for 'key', if any, into the ready queue.
+     */
+    void flushKey(const Value& key);
+
+    /**
+     * Moves all pending events into the ready queue, oldest first.
+     */
+    void flushAll();
+
+    const long long _windowMillis;
+
+    // Coalesced update events not yet emitted, keyed by the value extractCoalesceKey() returns.
+    ValueUnorderedMap<PendingEvent> _pending;
+
+    // Keys of '_pending' in arrival order of their first event. Since events arrive in cluster
+    // time order, the front is always the entry whose window expires first.
+    std::list<Value> _pendingOrder;
+
+    // Events ready to be returned from getNext().
+    std::deque<Document> _readyQueue;
+};
+
+}  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/document_source_change_stream_coalesce.h"
 #include "mongo/db/pipeline/document_source_change_stream_transform.h"
 #include "mongo/db/pipeline/document_source_check_resume_token.h"
 #include "mongo/db/pipeline/document_source_limit.h"
@@ -1689,6 +1690,122 @@ TEST_F(ChangeStreamStageDBTest, ResumeAfterWithTokenFromDropDatabase) {
 }
 
 
+//
+// Tests of the DocumentSourceChangeStreamCoalesce stage.
+//
+
+Document makeCoalesceUpdateEvent(int tokenNum,
+                                 Timestamp ts,
+                                 Value docKey,
+                                 Document updatedFields,
+                                 std::vector<V> removedFields = {}) {
+    return Document{{DSChangeStream::kIdField, D{{"tokenNum", tokenNum}}},
+                    {DSChangeStream::kOperationTypeField, DSChangeStream::kUpdateOpType},
+                    {DSChangeStream::kClusterTimeField, ts},
+                    {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+                    {DSChangeStream::kDocumentKeyField, docKey},
+                    {DSChangeStream::kUpdateDescriptionField,
+                     D{{"updatedFields", updatedFields}, {"removedFields", V(removedFields)}}}};
+}
+
+TEST_F(ChangeStreamStageTest, CoalesceMergesUpdatesOnSameKeyWithinWindow) {
+    auto coalesce = DocumentSourceChangeStreamCoalesce::create(getExpCtx(), 60 * 1000);
+    auto mock = DocumentSourceMock::create(std::deque<DocumentSource::GetNextResult>{
+        makeCoalesceUpdateEvent(1, Timestamp(100, 1), V(D{{"_id", 1}}), D{{"a", 1}, {"b", 1}}),
+        makeCoalesceUpdateEvent(
+            2, Timestamp(100, 2), V(D{{"_id", 1}}), D{{"b", 2}}, {V("a"_sd)})});
+    coalesce->setSource(mock.get());
+
+    // The two events merge into one carrying the second event's resume token and the composed
+    // delta: "b" takes the later value and "a", updated then removed, is only removed.
+    auto next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto event = next.releaseDocument();
+    ASSERT_DOCUMENT_EQ(event[DSChangeStream::kIdField].getDocument(), (D{{"tokenNum", 2}}));
+    ASSERT_DOCUMENT_EQ(
+        event[DSChangeStream::kUpdateDescriptionField].getDocument(),
+        (D{{"updatedFields", D{{"b", 2}}}, {"removedFields", std::vector<V>{V("a"_sd)}}}));
+
+    ASSERT_TRUE(coalesce->getNext().isEOF());
+}
+
+TEST_F(ChangeStreamStageTest, CoalesceDoesNotMergeUpdatesOnDifferentKeys) {
+    auto coalesce = DocumentSourceChangeStreamCoalesce::create(getExpCtx(), 60 * 1000);
+    auto mock = DocumentSourceMock::create(std::deque<DocumentSource::GetNextResult>{
+        makeCoalesceUpdateEvent(1, Timestamp(100, 1), V(D{{"_id", 1}}), D{{"a", 1}}),
+        makeCoalesceUpdateEvent(2, Timestamp(100, 2), V(D{{"_id", 2}}), D{{"a", 2}})});
+    coalesce->setSource(mock.get());
+
+    auto next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument()[DSChangeStream::kIdField].getDocument(),
+                       (D{{"tokenNum", 1}}));
+
+    next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument()[DSChangeStream::kIdField].getDocument(),
+                       (D{{"tokenNum", 2}}));
+
+    ASSERT_TRUE(coalesce->getNext().isEOF());
+}
+
+TEST_F(ChangeStreamStageTest, CoalesceDoesNotMergeUpdatesOutsideWindow) {
+    auto coalesce = DocumentSourceChangeStreamCoalesce::create(getExpCtx(), 1000);
+    auto mock = DocumentSourceMock::create(std::deque<DocumentSource::GetNextResult>{
+        makeCoalesceUpdateEvent(1, Timestamp(100, 1), V(D{{"_id", 1}}), D{{"a", 1}}),
+        makeCoalesceUpdateEvent(2, Timestamp(200, 1), V(D{{"_id", 1}}), D{{"a", 2}})});
+    coalesce->setSource(mock.get());
+
+    // The second event arrives 100 seconds after the first, well past the 1 second window, so
+    // both events are emitted unmerged.
+    auto next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument()[DSChangeStream::kIdField].getDocument(),
+                       (D{{"tokenNum", 1}}));
+
+    next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument()[DSChangeStream::kIdField].getDocument(),
+                       (D{{"tokenNum", 2}}));
+
+    ASSERT_TRUE(coalesce->getNext().isEOF());
+}
+
+TEST_F(ChangeStreamStageTest, CoalesceFlushesPendingUpdateBeforeDeleteOnSameKey) {
+    auto coalesce = DocumentSourceChangeStreamCoalesce::create(getExpCtx(), 60 * 1000);
+    Document deleteEvent{
+        {DSChangeStream::kIdField, D{{"tokenNum", 2}}},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kDeleteOpType},
+        {DSChangeStream::kClusterTimeField, Timestamp(100, 2)},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, D{{"_id", 1}}}};
+    auto mock = DocumentSourceMock::create(std::deque<DocumentSource::GetNextResult>{
+        makeCoalesceUpdateEvent(1, Timestamp(100, 1), V(D{{"_id", 1}}), D{{"a", 1}}), deleteEvent});
+    coalesce->setSource(mock.get());
+
+    // The buffered update must be delivered before the delete on the same document key.
+    auto next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto event = next.releaseDocument();
+    ASSERT_DOCUMENT_EQ(event[DSChangeStream::kIdField].getDocument(), (D{{"tokenNum", 1}}));
+    ASSERT_VALUE_EQ(event[DSChangeStream::kOperationTypeField],
+                    V(DSChangeStream::kUpdateOpType));
+
+    next = coalesce->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.releaseDocument()[DSChangeStream::kOperationTypeField],
+                    V(DSChangeStream::kDeleteOpType));
+
+    ASSERT_TRUE(coalesce->getNext().isEOF());
+}
+
+TEST_F(ChangeStreamStageTest, CannotCreateStageWithNegativeCoalesceWindow) {
+    auto spec = BSON("$changeStream" << BSON("coalesceWindowMillis" << -1));
+    ASSERT_THROWS_CODE(DSChangeStream::createFromBson(spec.firstElement(), getExpCtx()),
+                       AssertionException,
+                       51472);
+}
+
 TEST_F(ChangeStreamStageDBTest, StartAfterSucceedsEvenIfResumeTokenDoesNotContainUUID) {
     const auto uuid = testUuid();
 
@@ -220,7 +220,7 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx, size_t
             // This will return when some exchange buffer is full and we cannot make any forward
             // progress anymore.
             // The return value is an index of a full consumer buffer.
-            size_t fullConsumerId = loadNextBatch();
+            size_t fullConsumerId = loadNextBatch(lk);
 
             _pipeline->detachFromOperationContext();
 
@@ -238,10 +238,28 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx, size_t
     }
 }
 
-size_t Exchange::loadNextBatch() {
-    auto input = _pipeline->getSources().back()->getNext();
+size_t Exchange::loadNextBatch(stdx::unique_lock<stdx::mutex>& lk) {
+    invariant(lk.owns_lock());
+
+    for (;;) {
+        // Only the loading thread touches '_pipeline', so the lock is not needed while producing
+        // the next document. Releasing it lets the other consumers keep draining their buffers
+        // while the inner pipeline stages do their work, rather than serializing every consumer
+        // behind the load.
+        lk.unlock();
+        auto input = _pipeline->getSources().back()->getNext();
+        lk.lock();
+
+        if (input.isEOF()) {
+            // We have reached the end so send EOS to all consumers.
+            for (auto& c : _consumers) {
+                c->appendDocument(input, _maxBufferSize);
+            }
+
+            return kInvalidThreadId;
+        }
+        invariant(input.isAdvanced());
 
-    for (; input.isAdvanced(); input = _pipeline->getSources().back()->getNext()) {
         // We have a document and we will deliver it to a consumer(s) based on the policy.
         switch (_policy) {
             case ExchangePolicyEnum::kBroadcast: {
@@ -283,15 +301,6 @@ size_t Exchange::loadNextBatch() {
                 MONGO_UNREACHABLE;
         }
     }
-
-    invariant(input.isEOF());
-
-    // We have reached the end so send EOS to all consumers.
-    for (auto& c : _consumers) {
-        c->appendDocument(input, _maxBufferSize);
-    }
-
-    return kInvalidThreadId;
 }
 
 size_t Exchange::getTargetConsumer(const Document& input) {
@@ -78,7 +78,15 @@ public:
     void dispose(OperationContext* opCtx);
 
 private:
-    size_t loadNextBatch();
+    /**
+     * Loads documents from the inner pipeline into the consumer buffers until some buffer reaches
+     * its size limit, returning the id of the full consumer, or until EOF, returning
+     * 'kInvalidThreadId'. Must be called by the loading thread with 'lk' locked; the lock is
+     * released while pulling each document from '_pipeline' (which only the loading thread
+     * touches) so that consumers can drain their buffers concurrently, and reacquired to append
+     * to the buffers.
+     */
+    size_t loadNextBatch(stdx::unique_lock<stdx::mutex>& lk);
 
     size_t getTargetConsumer(const Document& input);
 
@@ -28,6 +28,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -39,6 +41,7 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/allocation_accounting.h"
 
 namespace mongo {
 
@@ -47,6 +50,23 @@ using std::pair;
 using std::shared_ptr;
 using std::vector;
 
+namespace {
+
+// Each $group stage enforces only its own memory limit, so these serverStatus metrics give
+// operators node-wide visibility: the combined in-memory footprint of all in-flight $group
+// stages, and how often stages reach their limit and spill.
+Counter64 groupInMemoryBytes;
+Counter64 groupSpills;
+Counter64 groupSpilledRecords;
+
+ServerStatusMetricField<Counter64> displayGroupInMemoryBytes("query.groupInMemoryBytes",
+                                                             &groupInMemoryBytes);
+ServerStatusMetricField<Counter64> displayGroupSpills("query.groupSpills", &groupSpills);
+ServerStatusMetricField<Counter64> displayGroupSpilledRecords("query.groupSpilledRecords",
+                                                              &groupSpilledRecords);
+
+}  // namespace
+
 REGISTER_DOCUMENT_SOURCE(group,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceGroup::createFromBson);
@@ -164,10 +184,21 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
     return std::move(out);
 }
 
+void DocumentSourceGroup::reportMemoryUsage() {
+    if (_memoryUsageBytes >= _reportedMemoryUsageBytes) {
+        groupInMemoryBytes.increment(_memoryUsageBytes - _reportedMemoryUsageBytes);
+    } else {
+        groupInMemoryBytes.decrement(_reportedMemoryUsageBytes - _memoryUsageBytes);
+    }
+    _reportedMemoryUsageBytes = _memoryUsageBytes;
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _memoryUsageBytes = 0;
+    reportMemoryUsage();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -471,6 +502,10 @@ void getFieldPathListForSpilled(ExpressionObject* expressionObj,
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
+    // Attribute the hash table and accumulator state built here to aggregation.
+    allocation_accounting::ScopedSubsystemTag allocationTag(
+        allocation_accounting::Subsystem::kAggregation);
+
     const size_t numAccumulators = _accumulatedFields.size();
 
     boost::optional<BSONObj> inputSort = findRelevantInputSort();
@@ -510,6 +545,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                     _allowDiskUse);
             _sortedFiles.push_back(spill());
             _memoryUsageBytes = 0;
+            reportMemoryUsage();
         }
 
         // We release the result document here so that it does not outlive the end of this loop
@@ -521,7 +557,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
         // looking it up in '_groups' multiple times.
         const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
+        Accumulators& group = (*_groups)[id];
         const bool inserted = _groups->size() != oldSize;
 
         if (inserted) {
@@ -548,6 +584,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
             _memoryUsageBytes += group[i]->memUsageForSorter();
         }
+        reportMemoryUsage();
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
@@ -578,6 +615,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
                 // We won't be using groups again so free its memory.
                 _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+                _memoryUsageBytes = 0;
+                reportMemoryUsage();
 
                 _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
                     _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
@@ -616,7 +655,12 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
         ptrs.push_back(&*it);
     }
 
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    groupSpills.increment();
+    groupSpilledRecords.increment(ptrs.size());
+
+    // A plain sort suffices: the group ids are unique map keys, so there are no equal elements
+    // for stability to preserve, and std::sort avoids stable_sort's temporary buffer.
+    std::sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
 
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
     switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
 #include <memory>
 #include <utility>
 
@@ -40,7 +41,10 @@ namespace mongo {
 
 class DocumentSourceGroup final : public DocumentSource, public NeedsMergerDocumentSource {
 public:
-    using Accumulators = std::vector<boost::intrusive_ptr<Accumulator>>;
+    // Most $group stages have a handful of accumulators, so the accumulator pointers for a group
+    // are stored inline in the map entry rather than behind a separately allocated vector
+    // buffer. Stages with more accumulators than the inline capacity fall back to the heap.
+    using Accumulators = boost::container::small_vector<boost::intrusive_ptr<Accumulator>, 4>;
     using GroupsMap = ValueUnorderedMap<Accumulators>;
 
     boost::intrusive_ptr<DocumentSource> optimize() final;
@@ -176,11 +180,18 @@ private:
      */
     bool pathIncludedInGroupKeys(const std::string& dottedPath) const;
 
+    /**
+     * Publishes the delta between '_memoryUsageBytes' and the amount last reported to the global
+     * 'query.groupInMemoryBytes' serverStatus gauge.
+     */
+    void reportMemoryUsage();
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     bool _usedDisk;  // Keeps track of whether this $group spilled to disk.
     bool _doingMerge;
     size_t _memoryUsageBytes = 0;
+    size_t _reportedMemoryUsageBytes = 0;
     size_t _maxMemoryUsageBytes;
     std::vector<std::string> _idFieldNames;  // used when id is a document
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmarks a $group over an in-memory input stream, end to end through getNext(). The first
+ * argument is the number of input documents, the second the number of distinct groups, so the
+ * same suite covers both high-cardinality grouping (hash table pressure) and accumulation-heavy
+ * grouping (few groups, many updates).
+ */
+void BM_GroupSumByKey(benchmark::State& state) {
+    const long long nDocs = state.range(0);
+    const long long nGroups = state.range(1);
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+
+    std::deque<DocumentSource::GetNextResult> docs;
+    for (long long i = 0; i < nDocs; i++) {
+        docs.emplace_back(Document{{"a", static_cast<int>(i % nGroups)}, {"b", 1}});
+    }
+
+    const BSONObj groupSpec =
+        BSON("$group" << BSON("_id"
+                              << "$a"
+                              << "total"
+                              << BSON("$sum"
+                                      << "$b")));
+
+    for (auto keepRunning : state) {
+        auto source = DocumentSourceMock::create(docs);
+        auto group = DocumentSourceGroup::createFromBson(groupSpec.firstElement(), expCtx);
+        group->setSource(source.get());
+
+        long long nReturned = 0;
+        for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+            nReturned++;
+        }
+        benchmark::DoNotOptimize(nReturned);
+        group->dispose();
+    }
+
+    state.SetItemsProcessed(state.iterations() * nDocs);
+}
+
+BENCHMARK(BM_GroupSumByKey)
+    ->Args({1000, 10})
+    ->Args({1000, 1000})
+    ->Args({100000, 10})
+    ->Args({100000, 100000});
+
+}  // namespace
+}  // namespace mongo
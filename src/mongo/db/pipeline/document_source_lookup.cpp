@@ -99,6 +99,9 @@ DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
     // we'll eventually construct from the input document.
     _resolvedPipeline.reserve(_resolvedPipeline.size() + 1);
     _resolvedPipeline.push_back(BSONObj());
+
+    _resultsCache.emplace(pExpCtx->getValueComparator());
+    _resultsCacheMaxBytes = internalDocumentSourceLookupCacheSizeBytes.load();
 }
 
 DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
@@ -246,9 +249,28 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    boost::optional<Value> cacheKey;
     if (!wasConstructedWithPipelineSyntax()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+
+        // The generated $match stage is a deterministic function of the join key values, so it
+        // also serves as the key under which we cache the foreign results for that join key.
+        // Serve a repeated key from the cache rather than re-running the foreign query.
+        if (_resultsCache) {
+            cacheKey.emplace(matchStage);
+            if (auto cached = (*_resultsCache)[*cacheKey]) {
+                std::vector<Value> results;
+                results.reserve(cached->size());
+                for (auto&& doc : *cached) {
+                    results.emplace_back(doc);
+                }
+                MutableDocument output(std::move(inputDoc));
+                output.setNestedField(_as, Value(std::move(results)));
+                return output.freeze();
+            }
+        }
+
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
         _resolvedPipeline.back() = matchStage;
     }
@@ -272,6 +294,15 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
             _usedDisk = true;
     }
 
+    if (cacheKey) {
+        // Record the results for this join key, including the case where it matched nothing.
+        _resultsCache->insert(*cacheKey);
+        for (auto&& result : results) {
+            _resultsCache->insert(*cacheKey, result.getDocument());
+        }
+        _resultsCache->evictDownTo(_resultsCacheMaxBytes);
+    }
+
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
     return output.freeze();
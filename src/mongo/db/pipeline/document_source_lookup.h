@@ -301,6 +301,14 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // For use when $lookup is specified with localField/foreignField syntax. Caches the foreign
+    // collection results of previously seen join keys, since enrichment-style workloads commonly
+    // look up the same key for many consecutive input documents. Repeated keys are then served
+    // from memory rather than by re-running the foreign query. Entries are evicted in LRU order
+    // once the cache grows beyond '_resultsCacheMaxBytes'.
+    boost::optional<LookupSetCache> _resultsCache;
+    size_t _resultsCacheMaxBytes = 0;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
@@ -74,26 +74,32 @@ void DocumentSourceOutReplaceColl::initializeWriteNs() {
                 conn->runCommand(outputNs.db().toString(), cmd.done(), info));
     }
 
-    if (_originalIndexes.empty()) {
-        return;
-    }
-
-    // Copy the indexes of the output collection to the temp collection.
-    std::vector<BSONObj> tempNsIndexes;
-    for (const auto& indexSpec : _originalIndexes) {
-        // Replace the spec's 'ns' field value, which is the original collection, with the temp
-        // collection.
-        tempNsIndexes.push_back(indexSpec.addField(BSON("ns" << _tempNs.ns()).firstElement()));
-    }
-    try {
-        conn->createIndexes(_tempNs.ns(), tempNsIndexes);
-    } catch (DBException& ex) {
-        ex.addContext("Copying indexes for $out failed");
-        throw;
-    }
+    // The indexes of the output collection are not copied to the temp collection here; they are
+    // built in finalize(), once all results have been inserted. Building them on the populated
+    // collection goes through the bulk index builder instead of maintaining every index on every
+    // inserted batch.
 };
 
 void DocumentSourceOutReplaceColl::finalize() {
+    // Copy the indexes of the output collection to the temp collection before renaming. Any
+    // index constraint violation (e.g. a unique index) surfaces here, before the rename, so the
+    // target collection is left untouched just as it would be by a failed insert.
+    if (!_originalIndexes.empty()) {
+        DBClientBase* conn = pExpCtx->mongoProcessInterface->directClient();
+        std::vector<BSONObj> tempNsIndexes;
+        for (const auto& indexSpec : _originalIndexes) {
+            // Replace the spec's 'ns' field value, which is the original collection, with the
+            // temp collection.
+            tempNsIndexes.push_back(indexSpec.addField(BSON("ns" << _tempNs.ns()).firstElement()));
+        }
+        try {
+            conn->createIndexes(_tempNs.ns(), tempNsIndexes);
+        } catch (DBException& ex) {
+            ex.addContext("Copying indexes for $out failed");
+            throw;
+        }
+    }
+
     const auto& outputNs = getOutputNs();
     auto renameCommandObj =
         BSON("renameCollection" << _tempNs.ns() << "to" << outputNs.ns() << "dropTarget" << true);
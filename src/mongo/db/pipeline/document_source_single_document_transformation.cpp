@@ -32,8 +32,10 @@
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
+#include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_limit.h"
+#include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/value.h"
@@ -42,6 +44,62 @@ namespace mongo {
 
 using boost::intrusive_ptr;
 
+namespace {
+
+/**
+ * Returns true if the given field dependencies of a $match are guaranteed to have the same
+ * values before and after a transformation with the given modified paths, meaning the $match can
+ * be evaluated against the transformation's input documents instead.
+ */
+bool matchCanSwapWithTransform(const std::set<std::string>& dependencies,
+                               const DocumentSource::GetModPathsReturn& modifiedPaths) {
+    // Any rename means a dependency could refer to a value that lives under a different path
+    // before the transformation; be conservative and keep the stages in place.
+    if (!modifiedPaths.renames.empty()) {
+        return false;
+    }
+
+    switch (modifiedPaths.type) {
+        case DocumentSource::GetModPathsReturn::Type::kFiniteSet:
+            // The swap is legal if no modified path overlaps a dependency, in either prefix
+            // direction: modifying "a.b" changes a dependency on "a", and modifying "a" changes
+            // a dependency on "a.b".
+            for (auto&& dependency : dependencies) {
+                for (auto&& modified : modifiedPaths.paths) {
+                    if (dependency == modified ||
+                        expression::isPathPrefixOf(dependency, modified) ||
+                        expression::isPathPrefixOf(modified, dependency)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+
+        case DocumentSource::GetModPathsReturn::Type::kAllExcept:
+            // Here 'paths' are the preserved paths. Each dependency must lie entirely within a
+            // preserved subtree; a dependency that is a proper prefix of a preserved path reads
+            // parts of the subtree which the transformation removes.
+            for (auto&& dependency : dependencies) {
+                bool preserved = false;
+                for (auto&& kept : modifiedPaths.paths) {
+                    if (dependency == kept || expression::isPathPrefixOf(kept, dependency)) {
+                        preserved = true;
+                        break;
+                    }
+                }
+                if (!preserved) {
+                    return false;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
 DocumentSourceSingleDocumentTransformation::DocumentSourceSingleDocumentTransformation(
     const intrusive_ptr<ExpressionContext>& pExpCtx,
     std::unique_ptr<TransformerInterface> parsedTransform,
@@ -92,6 +150,21 @@ Value DocumentSourceSingleDocumentTransformation::serialize(
 Pipeline::SourceContainer::iterator DocumentSourceSingleDocumentTransformation::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
+
+    // If the following stage is a $match which does not depend on any path this transformation
+    // modifies, swap it ahead of us. Filtering first avoids building transformed Documents that
+    // the $match would immediately discard, and moving the $match towards the front of the
+    // pipeline lets it coalesce with other $match stages and reach the query system.
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get());
+    if (nextMatch && !nextMatch->isTextQuery()) {
+        DepsTracker deps(DepsTracker::MetadataAvailable::kTextScore);
+        nextMatch->getDependencies(&deps);
+        if (!deps.needWholeDocument && matchCanSwapWithTransform(deps.fields, getModifiedPaths())) {
+            std::swap(*itr, *std::next(itr));
+            return itr == container->begin() ? itr : std::prev(itr);
+        }
+    }
+
     auto nextSkip = dynamic_cast<DocumentSourceSkip*>((*std::next(itr)).get());
 
     if (nextSkip) {
@@ -0,0 +1,178 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_unpack_bucket.h"
+
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/pipeline/value.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+using std::string;
+
+REGISTER_DOCUMENT_SOURCE(unpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceUnpackBucket::createFromBson);
+
+DocumentSourceUnpackBucket::DocumentSourceUnpackBucket(
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    string timeField,
+    boost::optional<string> metaField)
+    : DocumentSource(pExpCtx), _timeField(std::move(timeField)), _metaField(std::move(metaField)) {}
+
+const char* DocumentSourceUnpackBucket::getSourceName() const {
+    return "$unpackBucket";
+}
+
+intrusive_ptr<DocumentSourceUnpackBucket> DocumentSourceUnpackBucket::create(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const string& timeField,
+    const boost::optional<string>& metaField) {
+    return new DocumentSourceUnpackBucket(expCtx, timeField, metaField);
+}
+
+DocumentSource::GetNextResult DocumentSourceUnpackBucket::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    while (_unpacked.empty()) {
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            return nextInput;
+        }
+
+        _unpackBucket(nextInput.releaseDocument());
+    }
+
+    auto measurement = std::move(_unpacked.front());
+    _unpacked.pop_front();
+    return measurement;
+}
+
+void DocumentSourceUnpackBucket::_unpackBucket(const Document& bucket) {
+    const auto data = bucket["data"];
+    uassert(50915,
+            str::stream() << "input to $unpackBucket must have a 'data' object, but found: "
+                          << bucket.toString(),
+            data.getType() == Object);
+
+    const auto timeColumn = data[_timeField];
+    uassert(50916,
+            str::stream() << "bucket data is missing a column for the time field '" << _timeField
+                          << "'",
+            timeColumn.getType() == Object);
+
+    const auto metaValue = _metaField ? bucket["meta"] : Value();
+
+    // Each key of the time column identifies one measurement; the remaining columns are sparse,
+    // so a measurement simply omits the fields whose columns have no value at its key.
+    auto timeIt = timeColumn.getDocument().fieldIterator();
+    while (timeIt.more()) {
+        const auto key = timeIt.next().first;
+
+        MutableDocument measurement;
+        if (_metaField && !metaValue.missing()) {
+            measurement.addField(*_metaField, metaValue);
+        }
+
+        auto columnIt = data.getDocument().fieldIterator();
+        while (columnIt.more()) {
+            const auto column = columnIt.next();
+            uassert(50918,
+                    str::stream() << "each column in bucket data must be an object, but '"
+                                  << column.first
+                                  << "' is a "
+                                  << typeName(column.second.getType()),
+                    column.second.getType() == Object);
+
+            const auto value = column.second.getDocument()[key];
+            if (!value.missing()) {
+                measurement.addField(column.first, value);
+            }
+        }
+
+        _unpacked.push_back(measurement.freeze());
+    }
+}
+
+Value DocumentSourceUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec["timeField"] = Value(_timeField);
+    if (_metaField) {
+        spec["metaField"] = Value(*_metaField);
+    }
+    return Value(DOC(getSourceName() << spec.freezeToValue()));
+}
+
+DepsTracker::State DocumentSourceUnpackBucket::getDependencies(DepsTracker* deps) const {
+    // The set of fields this stage produces cannot be determined without looking at the buckets
+    // themselves, so the whole bucket document is required.
+    deps->needWholeDocument = true;
+    return DepsTracker::State::EXHAUSTIVE_ALL;
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceUnpackBucket::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(50904,
+            str::stream() << "expected an object as specification for $unpackBucket stage, got "
+                          << typeName(elem.type()),
+            elem.type() == Object);
+
+    string timeField;
+    boost::optional<string> metaField;
+    for (auto&& subElem : elem.Obj()) {
+        if (subElem.fieldNameStringData() == "timeField") {
+            uassert(50906,
+                    str::stream() << "expected a string for the timeField option to $unpackBucket "
+                                     "stage, got "
+                                  << typeName(subElem.type()),
+                    subElem.type() == String);
+            timeField = subElem.str();
+        } else if (subElem.fieldNameStringData() == "metaField") {
+            uassert(50913,
+                    str::stream() << "expected a non-empty string for the metaField option to "
+                                     "$unpackBucket stage, got "
+                                  << typeName(subElem.type()),
+                    subElem.type() == String && !subElem.String().empty());
+            metaField = subElem.String();
+        } else {
+            uasserted(50914,
+                      str::stream() << "unrecognized option to $unpackBucket stage: "
+                                    << subElem.fieldNameStringData());
+        }
+    }
+    uassert(50919, "no timeField specified to $unpackBucket stage", !timeField.empty());
+
+    return DocumentSourceUnpackBucket::create(pExpCtx, timeField, metaField);
+}
+
+}  // namespace mongo
@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * The $unpackBucket stage turns bucket documents of the form produced by BucketBuilder (see
+ * db/timeseries/bucket_builder.h) back into one document per measurement:
+ *
+ *     {$unpackBucket: {timeField: <string>, metaField: <optional string>}}
+ *
+ * Each key of the bucket's data.<timeField> column identifies one measurement; the measurement is
+ * assembled from the value at that key in every column of 'data', with the bucket-level 'meta'
+ * value restored under 'metaField' when one is specified.
+ */
+class DocumentSourceUnpackBucket final : public DocumentSource {
+public:
+    GetNextResult getNext() final;
+    const char* getSourceName() const final;
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed};
+    }
+
+    DepsTracker::State getDependencies(DepsTracker* deps) const final;
+
+    /**
+     * Creates a new $unpackBucket DocumentSource from a BSON specification.
+     */
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    static boost::intrusive_ptr<DocumentSourceUnpackBucket> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const std::string& timeField,
+        const boost::optional<std::string>& metaField);
+
+private:
+    DocumentSourceUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
+                               std::string timeField,
+                               boost::optional<std::string> metaField);
+
+    /**
+     * Unpacks 'bucket' into per-measurement documents queued for return from getNext(). Throws if
+     * the document does not have the expected bucket shape.
+     */
+    void _unpackBucket(const Document& bucket);
+
+    // Configuration state.
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    // Measurements unpacked from the current bucket which have not yet been returned.
+    std::deque<Document> _unpacked;
+};
+
+}  // namespace mongo
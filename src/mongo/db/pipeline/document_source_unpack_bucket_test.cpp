@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_unpack_bucket.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using UnpackBucketStageTest = AggregationContextFixture;
+
+TEST_F(UnpackBucketStageTest, UnpacksOneDocumentPerMeasurement) {
+    auto unpack = DocumentSourceUnpackBucket::create(getExpCtx(), "t", std::string("m"));
+    auto mock = DocumentSourceMock::create(Document(
+        fromjson("{meta: 'sensorA', data: {t: {'0': 1, '1': 2}, v: {'0': 10, '1': 20}}}")));
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{m: 'sensorA', t: 1, v: 10}")), next.getDocument());
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{m: 'sensorA', t: 2, v: 20}")), next.getDocument());
+
+    ASSERT_TRUE(unpack->getNext().isEOF());
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(UnpackBucketStageTest, OmitsFieldsMissingFromSparseColumns) {
+    auto unpack = DocumentSourceUnpackBucket::create(getExpCtx(), "t", boost::none);
+    auto mock = DocumentSourceMock::create(
+        Document(fromjson("{data: {t: {'0': 1, '1': 2}, v: {'1': 20}}}")));
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 1}")), next.getDocument());
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 2, v: 20}")), next.getDocument());
+
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(UnpackBucketStageTest, ShouldPropagatePauses) {
+    auto unpack = DocumentSourceUnpackBucket::create(getExpCtx(), "t", boost::none);
+    auto mock =
+        DocumentSourceMock::create({Document(fromjson("{data: {t: {'0': 1}}}")),
+                                    DocumentSource::GetNextResult::makePauseExecution(),
+                                    Document(fromjson("{data: {t: {'0': 2}}}"))});
+    unpack->setSource(mock.get());
+
+    ASSERT_TRUE(unpack->getNext().isAdvanced());
+    ASSERT_TRUE(unpack->getNext().isPaused());
+    ASSERT_TRUE(unpack->getNext().isAdvanced());
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(UnpackBucketStageTest, ThrowsOnMalformedBucket) {
+    auto unpack = DocumentSourceUnpackBucket::create(getExpCtx(), "t", boost::none);
+
+    auto noData = DocumentSourceMock::create(Document(fromjson("{meta: 'sensorA'}")));
+    unpack->setSource(noData.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, 50915);
+
+    auto noTimeColumn = DocumentSourceMock::create(Document(fromjson("{data: {v: {'0': 10}}}")));
+    unpack->setSource(noTimeColumn.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, 50916);
+
+    auto scalarColumn =
+        DocumentSourceMock::create(Document(fromjson("{data: {t: {'0': 1}, v: 10}}")));
+    unpack->setSource(scalarColumn.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, 50918);
+}
+
+TEST_F(UnpackBucketStageTest, SerializesToItsOwnSpecification) {
+    auto spec = fromjson("{$unpackBucket: {timeField: 't', metaField: 'm'}}");
+    auto unpack = DocumentSourceUnpackBucket::createFromBson(spec.firstElement(), getExpCtx());
+
+    std::vector<Value> serialization;
+    unpack->serializeToArray(serialization);
+    ASSERT_EQ(1U, serialization.size());
+    ASSERT_VALUE_EQ(Value(Document(spec)), serialization[0]);
+}
+
+TEST_F(UnpackBucketStageTest, RejectsInvalidSpecifications) {
+    const auto parse = [&](const std::string& json) {
+        return DocumentSourceUnpackBucket::createFromBson(fromjson(json).firstElement(),
+                                                          getExpCtx());
+    };
+
+    ASSERT_THROWS_CODE(parse("{$unpackBucket: 't'}"), AssertionException, 50904);
+    ASSERT_THROWS_CODE(parse("{$unpackBucket: {timeField: 1}}"), AssertionException, 50906);
+    ASSERT_THROWS_CODE(
+        parse("{$unpackBucket: {timeField: 't', metaField: ''}}"), AssertionException, 50913);
+    ASSERT_THROWS_CODE(
+        parse("{$unpackBucket: {timeField: 't', bogus: 1}}"), AssertionException, 50914);
+    ASSERT_THROWS_CODE(parse("{$unpackBucket: {}}"), AssertionException, 50919);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -111,6 +111,23 @@ TEST(DocumentConstruction, FromEmptyDocumentClone) {
     ASSERT_DOCUMENT_EQ(document, documentClone);
 }
 
+TEST(DocumentConstruction, GrowthAcrossInlineStorageBoundary) {
+    // Build documents whose storage crosses the DocumentStorage inline-slab boundary to exercise
+    // the spill to a heap buffer, including a clone at every size.
+    MutableDocument md;
+    for (int i = 0; i < 100; i++) {
+        md.addField("field" + std::to_string(i), Value(i));
+    }
+    Document document = md.freeze();
+    ASSERT_EQUALS(100U, document.size());
+    Document documentClone = document.clone();
+    ASSERT_DOCUMENT_EQ(document, documentClone);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQUALS(i, document["field" + std::to_string(i)].getInt());
+        ASSERT_EQUALS(i, documentClone["field" + std::to_string(i)].getInt());
+    }
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
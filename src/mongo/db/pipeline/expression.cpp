@@ -1876,6 +1876,20 @@ intrusive_ptr<Expression> ExpressionObject::optimize() {
     if (allValuesConstant) {
         return ExpressionConstant::create(getExpressionContext(), evaluate(Document()));
     }
+
+    // Classify each child once so evaluate() can dispatch on a tag instead of a virtual call for
+    // the common constant and field path children.
+    _childKinds.clear();
+    _childKinds.reserve(_expressions.size());
+    for (auto&& pair : _expressions) {
+        if (dynamic_cast<ExpressionConstant*>(pair.second.get())) {
+            _childKinds.push_back(ChildKind::kConstant);
+        } else if (dynamic_cast<ExpressionFieldPath*>(pair.second.get())) {
+            _childKinds.push_back(ChildKind::kFieldPath);
+        } else {
+            _childKinds.push_back(ChildKind::kGeneric);
+        }
+    }
     return this;
 }
 
@@ -1887,6 +1901,29 @@ void ExpressionObject::_doAddDependencies(DepsTracker* deps) const {
 
 Value ExpressionObject::evaluate(const Document& root) const {
     MutableDocument outputDoc;
+    if (_childKinds.size() == _expressions.size()) {
+        // Fused path, set up by optimize(). ExpressionConstant and ExpressionFieldPath are final,
+        // so the casted calls below resolve without virtual dispatch.
+        for (size_t i = 0; i < _expressions.size(); i++) {
+            auto&& pair = _expressions[i];
+            switch (_childKinds[i]) {
+                case ChildKind::kConstant:
+                    outputDoc.addField(
+                        pair.first,
+                        static_cast<ExpressionConstant*>(pair.second.get())->getValue());
+                    break;
+                case ChildKind::kFieldPath:
+                    outputDoc.addField(
+                        pair.first,
+                        static_cast<ExpressionFieldPath*>(pair.second.get())->evaluate(root));
+                    break;
+                case ChildKind::kGeneric:
+                    outputDoc.addField(pair.first, pair.second->evaluate(root));
+                    break;
+            }
+        }
+        return outputDoc.freezeToValue();
+    }
     for (auto&& pair : _expressions) {
         outputDoc.addField(pair.first, pair.second->evaluate(root));
     }
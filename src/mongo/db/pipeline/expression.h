@@ -1516,9 +1516,18 @@ private:
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>>&& expressions);
 
+    // Most object specifications are built entirely out of constants and field paths, so evaluate()
+    // can skip the virtual evaluate() dispatch for those children once optimize() has classified
+    // them. kGeneric children go through the regular virtual call.
+    enum class ChildKind : char { kConstant, kFieldPath, kGeneric };
+
     // The mapping from field name to expression within this object. This needs to respect the order
     // in which the fields were specified in the input BSON.
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> _expressions;
+
+    // Parallel to '_expressions'; empty until optimize() runs. evaluate() only takes the fused path
+    // when the sizes match, so expressions that were never optimized behave as before.
+    std::vector<ChildKind> _childKinds;
 };
 
 
@@ -2889,6 +2889,20 @@ TEST(ExpressionObjectEvaluate, ShouldEvaluateFieldsWithinNestedObject) {
                     object->evaluate(Document{{"_id", "ID"_sd}}));
 }
 
+TEST(ExpressionObjectEvaluate, OptimizedObjectShouldEvaluateIdenticallyToUnoptimized) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    VariablesParseState vps = expCtx->variablesParseState;
+    // Mixes constant, field path, and generic children so optimize() classifies all three kinds.
+    auto spec = fromjson("{a: 1, b: '$x', c: {$add: ['$x', 1]}}");
+    auto object = ExpressionObject::parse(expCtx, spec, vps);
+    auto input = Document{{"x", 5}};
+    auto expectedWithField = object->evaluate(input);
+    auto expectedWithoutField = object->evaluate(Document());
+    auto optimized = object->optimize();
+    ASSERT_VALUE_EQ(expectedWithField, optimized->evaluate(input));
+    ASSERT_VALUE_EQ(expectedWithoutField, optimized->evaluate(Document()));
+}
+
 TEST(ExpressionObjectEvaluate, ShouldEvaluateToEmptyDocumentIfAllFieldsAreMissing) {
     intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     auto object =
@@ -121,6 +121,26 @@ public:
         _memoryUsage += docSize;
     }
 
+    /**
+     * Insert an entry for "key" with no associated values if one is not already present, so that
+     * a later lookup of "key" can distinguish a cached empty result from a missing entry. If
+     * "key" is already present, move it to the middle of the cache.
+     */
+    void insert(Value key) {
+        // Get an iterator to the middle of the container.
+        size_t middle = size() / 2;
+        auto it = _container.begin();
+        std::advance(it, middle);
+        const auto keySize = key.getApproximateSize();
+
+        auto insertionResult = _container.insert(it, {std::move(key), {}});
+        if (insertionResult.second) {
+            _memoryUsage += keySize;
+        } else {
+            _container.relocate(it, insertionResult.first);
+        }
+    }
+
     /**
      * Evict the least-recently-used item.
      */
@@ -56,6 +56,17 @@ std::vector<BSONObj> MongoProcessCommon::getCurrentOps(
          Client* client = cursor.next();) {
         invariant(client);
 
+        // Ignore inactive connections unless 'idleConnections' is true. This is checked before
+        // taking the client lock so the scan does not serialize on the (possibly tens of
+        // thousands of) idle clients it is about to skip anyway. The flag is published without
+        // the lock, so a just-started operation may occasionally be missed; currentOp is
+        // inherently a racy snapshot, and the locked check below re-confirms for clients that
+        // pass this filter.
+        if (connMode == CurrentOpConnectionsMode::kExcludeIdle &&
+            !client->hasActiveOperationContext()) {
+            continue;
+        }
+
         stdx::lock_guard<Client> lk(*client);
 
         // If auth is disabled, ignore the allUsers parameter.
@@ -449,6 +449,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         bob->append("indexVersion", spec->indexVersion);
 
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("estimatedResultDensity", spec->estimatedResultDensity);
             BSONArrayBuilder intervalsBob(bob->subarrayStart("searchIntervals"));
             for (vector<IntervalStats>::const_iterator it = spec->intervalStats.begin();
                  it != spec->intervalStats.end();
@@ -841,6 +842,7 @@ void Explain::explainPipelineExecutor(PlanExecutor* exec,
 
     // If we need execution stats, this runs the plan in order to gather the stats.
     if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        exec->getRootStage()->markShouldCollectTimingInfo();
         // TODO SERVER-32732: An execution error should be reported in explain, but should not
         // cause the explain itself to fail.
         uassertStatusOK(exec->executePlan());
@@ -860,6 +862,7 @@ void Explain::explainStages(PlanExecutor* exec,
 
     // If we need execution stats, then run the plan in order to gather the stats.
     if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        exec->getRootStage()->markShouldCollectTimingInfo();
         executePlanStatus = exec->executePlan();
 
         // If executing the query failed because it was killed, then the collection may no longer be
@@ -1025,6 +1028,12 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     scoresBuilder.doneFast();
 
     out->append("indexFilterSet", entry.plannerData[0]->indexFilterApplied);
+
+    out->append("executions", static_cast<long long>(entry.executions));
+    if (!entry.sampledPlanStats.isEmpty()) {
+        out->append("sampledPlanStats", entry.sampledPlanStats);
+        out->append("timeOfSampledPlanStats", entry.timeOfSampledPlanStats);
+    }
 }
 
 }  // namespace mongo
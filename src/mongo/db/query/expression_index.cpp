@@ -28,15 +28,21 @@
 
 #include "mongo/db/query/expression_index.h"
 
+#include <algorithm>
 #include <iostream>
 #include <unordered_set>
 
+#include "mongo/base/disallow_copying.h"
+
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -45,9 +51,17 @@ namespace mongo {
 
 using std::set;
 
-BSONObj ExpressionMapping::hash(const BSONElement& value) {
+BSONObj ExpressionMapping::hash(const BSONElement& value, int hashVersion) {
+    // Must match the dispatch in ExpressionKeysPrivate::makeSingleHashKey(), or the computed
+    // bounds will not line up with the keys the index actually stores.
+    massert(51473,
+            "Only HashVersions 0 and 1 have been defined",
+            hashVersion == 0 || hashVersion == 1);
     BSONObjBuilder bob;
-    bob.append("", BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
+    bob.append("",
+               hashVersion == 1
+                   ? BSONElementHasher::hash64V1(value, BSONElementHasher::DEFAULT_HASH_SEED)
+                   : BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
     return bob.obj();
 }
 
@@ -108,10 +122,12 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
-    auto minLevel = internalQueryS2GeoCoarsestLevel.load();
-    auto maxLevel = internalQueryS2GeoFinestLevel.load();
+namespace {
 
+std::vector<S2CellId> computeS2Covering(const S2Region& region,
+                                        int minLevel,
+                                        int maxLevel,
+                                        int maxCells) {
     uassert(28739, "Geo coarsest level must be in range [0,30]", 0 <= minLevel && minLevel <= 30);
     uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
     uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
@@ -119,13 +135,102 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     S2RegionCoverer coverer;
     coverer.set_min_level(minLevel);
     coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(internalQueryS2GeoMaxCells.load());
+    coverer.set_max_cells(maxCells);
 
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
     return cover;
 }
 
+/**
+ * Process-wide cache of 2dsphere query coverings. Coverings depend only on the query geometry
+ * and the covering parameters, so entries never invalidate; the LRU bound caps memory. Workloads
+ * that reissue a fixed set of geometries (geo-fences) hit this constantly, and a covering is at
+ * most internalQueryS2GeoMaxCells cell ids, so entries are small.
+ */
+class S2CoveringCache {
+    MONGO_DISALLOW_COPYING(S2CoveringCache);
+
+public:
+    S2CoveringCache() = default;
+
+    static S2CoveringCache* get() {
+        static S2CoveringCache* cache = new S2CoveringCache();
+        return cache;
+    }
+
+    bool lookup(const std::string& key, std::vector<S2CellId>* out) {
+        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            return false;
+        }
+        *out = it->second;
+        return true;
+    }
+
+    void store(const std::string& key, const std::vector<S2CellId>& covering) {
+        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        _cache.add(key, covering);
+    }
+
+private:
+    SimpleMutex _mutex;
+    LRUCache<std::string, std::vector<S2CellId>> _cache{
+        static_cast<size_t>(std::max(1, internalQueryS2CoveringCacheSize.load()))};
+};
+
+/**
+ * Builds a binary key from the raw geometry predicate and the covering parameters. The
+ * parameters are runtime-settable, so they are baked into the key rather than trusted to be
+ * stable: a knob change simply stops matching old entries, which then age out of the LRU.
+ */
+std::string coveringCacheKey(const BSONObj& rawGeometryObj,
+                             int minLevel,
+                             int maxLevel,
+                             int maxCells) {
+    std::string key;
+    key.reserve(rawGeometryObj.objsize() + 3 * sizeof(int));
+    key.append(rawGeometryObj.objdata(), rawGeometryObj.objsize());
+    key.append(reinterpret_cast<const char*>(&minLevel), sizeof(minLevel));
+    key.append(reinterpret_cast<const char*>(&maxLevel), sizeof(maxLevel));
+    key.append(reinterpret_cast<const char*>(&maxCells), sizeof(maxCells));
+    return key;
+}
+
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return computeS2Covering(region,
+                             internalQueryS2GeoCoarsestLevel.load(),
+                             internalQueryS2GeoFinestLevel.load(),
+                             internalQueryS2GeoMaxCells.load());
+}
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& rawGeometryObj) {
+    if (internalQueryS2CoveringCacheSize.load() <= 0) {
+        return get2dsphereCovering(region);
+    }
+
+    // Load the parameters once so the covering we compute matches the key we store it under,
+    // even if a knob changes concurrently.
+    const int minLevel = internalQueryS2GeoCoarsestLevel.load();
+    const int maxLevel = internalQueryS2GeoFinestLevel.load();
+    const int maxCells = internalQueryS2GeoMaxCells.load();
+
+    const std::string key = coveringCacheKey(rawGeometryObj, minLevel, maxLevel, maxCells);
+
+    std::vector<S2CellId> cover;
+    if (S2CoveringCache::get()->lookup(key, &cover)) {
+        return cover;
+    }
+
+    cover = computeS2Covering(region, minLevel, maxLevel, maxCells);
+    S2CoveringCache::get()->store(key, cover);
+    return cover;
+}
+
 void ExpressionMapping::cover2dsphere(const S2Region& region,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
@@ -133,6 +238,14 @@ void ExpressionMapping::cover2dsphere(const S2Region& region,
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
+void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& rawGeometryObj,
+                                      const S2IndexingParams& indexingParams,
+                                      OrderedIntervalList* oilOut) {
+    std::vector<S2CellId> cover = get2dsphereCovering(region, rawGeometryObj);
+    S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
+}
+
 namespace {
 bool compareIntervals(const Interval& a, const Interval& b) {
     return a.precedes(b);
@@ -48,7 +48,12 @@ namespace mongo {
  */
 class ExpressionMapping {
 public:
-    static BSONObj hash(const BSONElement& value);
+    /**
+     * Hashes 'value' the way a hashed index with the given hashVersion stores its keys. The
+     * version must come from the index's spec; mixing versions produces bounds that match
+     * nothing.
+     */
+    static BSONObj hash(const BSONElement& value, int hashVersion);
 
     static std::vector<GeoHash> get2dCovering(const R2Region& region,
                                               const BSONObj& indexInfoObj,
@@ -64,6 +69,15 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * As above, but consults a bounded process-wide cache keyed by 'rawGeometryObj' (the
+     * original geo predicate from the query) before running the S2 coverer. Workloads that
+     * reissue a fixed set of geometries (e.g. geo-fences) skip the recursive cell subdivision
+     * entirely on a hit.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     const BSONObj& rawGeometryObj);
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
@@ -77,6 +91,12 @@ public:
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
+
+    // As above, but obtains the covering through the cache keyed by 'rawGeometryObj'.
+    static void cover2dsphere(const S2Region& region,
+                              const BSONObj& rawGeometryObj,
+                              const S2IndexingParams& indexParams,
+                              OrderedIntervalList* oilOut);
 };
 
 }  // namespace mongo
@@ -59,4 +59,9 @@ extern AtomicInt32 internalQueryS2GeoCoarsestLevel;
 // What is the maximum cell count that we want? (advisory, not a hard threshold)
 extern AtomicInt32 internalQueryS2GeoMaxCells;
 
+// How many 2dsphere query coverings to cache, keyed by query geometry. 0 disables the cache.
+// The capacity is fixed at the first geo query after startup; setting the knob to 0 at runtime
+// bypasses (but does not shrink) the cache.
+extern AtomicInt32 internalQueryS2CoveringCacheSize;
+
 }  // namespace mongo
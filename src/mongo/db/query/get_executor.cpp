@@ -80,6 +80,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/oplog_hack.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/scripting/engine.h"
 #include "mongo/stdx/memory.h"
@@ -582,6 +583,96 @@ std::pair<boost::optional<Timestamp>, boost::optional<Timestamp>> extractTsRange
     }
 }
 
+/**
+ * Returns the "ts" value of the record at 'id', or boost::none if there is no such record or its
+ * "ts" field is missing or not a Timestamp.
+ */
+boost::optional<Timestamp> readRecordTs(OperationContext* opCtx,
+                                        RecordStore* rs,
+                                        const RecordId& id) {
+    auto cursor = rs->getCursor(opCtx);
+    boost::optional<Record> record = cursor->seekExact(id);
+    if (!record) {
+        return boost::none;
+    }
+    BSONElement elem = record->data.toBson()[repl::OpTime::kTimestampFieldName];
+    if (elem.type() != BSONType::bsonTimestamp) {
+        return boost::none;
+    }
+    return elem.timestamp();
+}
+
+/**
+ * Computes a start location for a bounded collection scan over a collection whose records are
+ * ordered by "ts" in RecordId order (an insert-only capped collection other than the oplog). The
+ * oplog encodes "ts" in the RecordId itself, so the lower bound converts directly; here the
+ * mapping is unknown, so we binary search the RecordId space, probing with the record store's
+ * positioned seek and reading "ts" from the probed document.
+ *
+ * Returns the RecordId of a record at or before the first record with ts >= 'minTs', or
+ * boost::none if the scan should simply start at the beginning of the collection (either because
+ * every record might match, or because the record store or data don't support the search).
+ */
+boost::optional<RecordId> tsRangeStartLoc(OperationContext* opCtx,
+                                          Collection* collection,
+                                          Timestamp minTs) {
+    RecordStore* rs = collection->getRecordStore();
+
+    boost::optional<Record> first = rs->getCursor(opCtx, true)->next();
+    boost::optional<Record> last = rs->getCursor(opCtx, false)->next();
+    if (!first || !last) {
+        return boost::none;
+    }
+
+    const auto firstTs = readRecordTs(opCtx, rs, first->id);
+    const auto lastTs = readRecordTs(opCtx, rs, last->id);
+    if (!firstTs || !lastTs) {
+        // Documents aren't shaped the way we need; let the filter do all the work.
+        return boost::none;
+    }
+    if (*firstTs >= minTs) {
+        // Every record might match; scan from the beginning.
+        return boost::none;
+    }
+    if (*lastTs < minTs) {
+        // Nothing matches; start at the last record and let the filter reject it.
+        return last->id;
+    }
+
+    // Invariants: every record with RecordId <= lo has ts < minTs, and every record with
+    // RecordId >= hi has ts >= minTs. Both are records that exist.
+    long long lo = first->id.repr();
+    long long hi = last->id.repr();
+    while (hi - lo > 1) {
+        const long long mid = lo + (hi - lo) / 2;
+        const auto probe = rs->oplogStartHack(opCtx, RecordId(mid));
+        if (!probe) {
+            // This record store doesn't support positioned probes.
+            return boost::none;
+        }
+        if (probe->repr() <= lo) {
+            // No records in (lo, mid], so every record <= mid is already known to be below the
+            // bound.
+            lo = mid;
+            continue;
+        }
+        const auto probeTs = readRecordTs(opCtx, rs, *probe);
+        if (!probeTs) {
+            return boost::none;
+        }
+        if (*probeTs < minTs) {
+            // 'probe' is the highest record <= mid, so everything <= mid is below the bound.
+            lo = mid;
+        } else {
+            hi = probe->repr();
+        }
+    }
+
+    // All records <= lo are below the bound; the first possible match is the next record after
+    // 'lo'. Start the scan at the highest record <= lo so the first match is never skipped.
+    return rs->oplogStartHack(opCtx, RecordId(lo));
+}
+
 StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getOplogStartHack(
     OperationContext* opCtx,
     Collection* collection,
@@ -612,10 +703,17 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getOplogStartHack(
 
     boost::optional<RecordId> startLoc = boost::none;
 
-    // See if the RecordStore supports the oplogStartHack.
-    StatusWith<RecordId> goal = oploghack::keyForOptime(*minTs);
-    if (goal.isOK()) {
-        startLoc = collection->getRecordStore()->oplogStartHack(opCtx, goal.getValue());
+    if (collection->ns().isOplog()) {
+        // The oplog's RecordIds encode "ts" directly, so the lower bound converts to a RecordId
+        // without inspecting any documents. See if the RecordStore supports the oplogStartHack.
+        StatusWith<RecordId> goal = oploghack::keyForOptime(*minTs);
+        if (goal.isOK()) {
+            startLoc = collection->getRecordStore()->oplogStartHack(opCtx, goal.getValue());
+        }
+    } else {
+        // Other capped collections are also insert-ordered by RecordId, but the mapping from
+        // "ts" to RecordId is unknown, so binary search the RecordId space instead.
+        startLoc = tsRangeStartLoc(opCtx, collection, *minTs);
     }
 
     // Build our collection scan.
@@ -930,7 +1028,6 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpdate(
 
     const PlanExecutor::YieldPolicy policy = parsedUpdate->yieldPolicy();
 
-    unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
     UpdateStageParams updateStageParams(request, driver, opDebug);
 
     if (!parsedUpdate->hasParsedQuery()) {
@@ -944,6 +1041,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpdate(
             // an UpdateStage, so in this case we put an UpdateStage on top of an EOFStage.
             LOG(2) << "Collection " << nss.ns() << " does not exist."
                    << " Using EOF stage: " << redact(unparsedQuery);
+            auto ws = make_unique<WorkingSet>();
             auto updateStage = make_unique<UpdateStage>(
                 opCtx, updateStageParams, ws.get(), collection, new EOFStage(opCtx));
             return PlanExecutor::make(opCtx, std::move(ws), std::move(updateStage), nss, policy);
@@ -958,8 +1056,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpdate(
             request->getProj().isEmpty() && hasCollectionDefaultCollation) {
             LOG(2) << "Using idhack: " << redact(unparsedQuery);
 
-            // Working set 'ws' is discarded. InternalPlanner::updateWithIdHack() makes its own
-            // WorkingSet.
+            // InternalPlanner::updateWithIdHack() makes its own WorkingSet.
             return InternalPlanner::updateWithIdHack(opCtx,
                                                      collection,
                                                      updateStageParams,
@@ -977,6 +1074,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpdate(
     }
 
     // This is the regular path for when we have a CanonicalQuery.
+    unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
     unique_ptr<CanonicalQuery> cq(parsedUpdate->releaseParsedQuery());
 
     const size_t defaultPlannerOptions = 0;
@@ -1087,9 +1185,15 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
 /**
  * Returns true if indices contains an index that can be used with DistinctNode (the "fast distinct
  * hack" node, which can be used only if there is an empty query predicate).  Sets indexOut to the
- * array index of PlannerParams::indices.  Look for the index for the fewest fields.  Criteria for
- * suitable index is that the index cannot be special (geo, hashed, text, ...), and the index cannot
- * be a partial index.
+ * array index of PlannerParams::indices and fieldNoOut to the position of the distinct field in
+ * that index's key pattern.  Criteria for a suitable index is that the index cannot be special
+ * (geo, hashed, text, ...), and the index cannot be a partial index.
+ *
+ * The distinct field does not have to be the first component of the index: with an empty query
+ * predicate every key is in bounds, so the distinct scan can skip through the distinct values of
+ * a later component as well, seeking once per distinct combination of the leading components.
+ * Indexes where the field appears earlier are preferred, since each additional leading component
+ * multiplies the number of seeks.
  *
  * Multikey indices are not suitable for DistinctNode when the projection is on an array element.
  * Arrays are flattened in a multikey index which makes it impossible for the distinct scan stage
@@ -1102,9 +1206,12 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
 bool getDistinctNodeIndex(const std::vector<IndexEntry>& indices,
                           const std::string& field,
                           const CollatorInterface* collator,
-                          size_t* indexOut) {
+                          size_t* indexOut,
+                          int* fieldNoOut) {
     invariant(indexOut);
+    invariant(fieldNoOut);
     bool isDottedField = str::contains(field, '.');
+    int minFieldNo = std::numeric_limits<int>::max();
     int minFields = std::numeric_limits<int>::max();
     for (size_t i = 0; i < indices.size(); ++i) {
         // Skip indices with non-matching collator.
@@ -1123,18 +1230,27 @@ bool getDistinctNodeIndex(const std::vector<IndexEntry>& indices,
         if (indices[i].multikey && isDottedField) {
             continue;
         }
-        // Skip indices where the first key is not field.
-        if (indices[i].keyPattern.firstElement().fieldNameStringData() != StringData(field)) {
+        // Determine the position of the distinct field in the key pattern, and skip indices
+        // which do not contain it at all.
+        int fieldNo = 0;
+        BSONObjIterator it(indices[i].keyPattern);
+        while (it.more() && StringData(field) != it.next().fieldNameStringData()) {
+            ++fieldNo;
+        }
+        const int nFields = indices[i].keyPattern.nFields();
+        if (fieldNo == nFields) {
             continue;
         }
-        int nFields = indices[i].keyPattern.nFields();
-        // Pick the index with the lowest number of fields.
-        if (nFields < minFields) {
+        // Pick the index with the earliest occurrence of the field; among those, the one with
+        // the lowest number of fields.
+        if (fieldNo < minFieldNo || (fieldNo == minFieldNo && nFields < minFields)) {
+            minFieldNo = fieldNo;
             minFields = nFields;
             *indexOut = i;
+            *fieldNoOut = fieldNo;
         }
     }
-    return minFields != std::numeric_limits<int>::max();
+    return minFieldNo != std::numeric_limits<int>::max();
 }
 
 /**
@@ -1445,7 +1561,8 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDistinct(
     // When can we do a fast distinct hack?
     // 1. There is a plan with just one leaf and that leaf is an ixscan.
     // 2. The ixscan indexes the field we're interested in.
-    // 2a: We are correct if the index contains the field but for now we look for prefix.
+    // 2a: The field may appear at any position of the index when the query predicate is empty;
+    //     with a predicate the field must be resolvable through normal planning below.
     // 3. The query is covered/no fetch.
     //
     // We go through normal planning (with limited parameters) to see if we can produce
@@ -1506,15 +1623,17 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDistinct(
     // Not every index in plannerParams.indices may be suitable. Refer to
     // getDistinctNodeIndex().
     size_t distinctNodeIndex = 0;
+    int distinctFieldNo = 0;
     if (parsedDistinct->getQuery()->getQueryRequest().getFilter().isEmpty() &&
         getDistinctNodeIndex(plannerParams.indices,
                              parsedDistinct->getKey(),
                              cq->getCollator(),
-                             &distinctNodeIndex)) {
+                             &distinctNodeIndex,
+                             &distinctFieldNo)) {
         auto dn = stdx::make_unique<DistinctNode>(plannerParams.indices[distinctNodeIndex]);
         dn->direction = 1;
         IndexBoundsBuilder::allValuesBounds(dn->index.keyPattern, &dn->bounds);
-        dn->fieldNo = 0;
+        dn->fieldNo = distinctFieldNo;
 
         // An index with a non-simple collation requires a FETCH stage.
         std::unique_ptr<QuerySolutionNode> solnRoot = std::move(dn);
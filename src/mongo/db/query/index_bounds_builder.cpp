@@ -37,6 +37,7 @@
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/s2.h"
 #include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_internal_expr_eq.h"
@@ -115,9 +116,18 @@ const BSONObj kUndefinedElementObj = BSON("" << BSONUndefined);
 const BSONObj kNullElementObj = BSON("" << BSONNULL);
 
 const Interval kHashedUndefinedInterval = IndexBoundsBuilder::makePointInterval(
-    ExpressionMapping::hash(kUndefinedElementObj.firstElement()));
-const Interval kHashedNullInterval =
-    IndexBoundsBuilder::makePointInterval(ExpressionMapping::hash(kNullElementObj.firstElement()));
+    ExpressionMapping::hash(kUndefinedElementObj.firstElement(), 0));
+const Interval kHashedNullInterval = IndexBoundsBuilder::makePointInterval(
+    ExpressionMapping::hash(kNullElementObj.firstElement(), 0));
+
+/**
+ * Returns the hash version the keys of the given hashed index were written with, so that points
+ * hashed for bounds match what is stored. Defaults to 0 when the spec omits the field, mirroring
+ * ExpressionParams::parseHashParams().
+ */
+int hashedIndexVersion(const IndexEntry& index) {
+    return index.infoObj[IndexDescriptor::kHashVersionFieldName].numberInt();
+}
 
 void makeNullEqualityBounds(const IndexEntry& index,
                             bool isHashed,
@@ -128,11 +138,23 @@ void makeNullEqualityBounds(const IndexEntry& index,
     *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
 
     // There are two values that could possibly be equal to null in an index: undefined and null.
-    oil->intervals.push_back(isHashed
-                                 ? kHashedUndefinedInterval
-                                 : IndexBoundsBuilder::makePointInterval(kUndefinedElementObj));
-    oil->intervals.push_back(isHashed ? kHashedNullInterval
-                                      : IndexBoundsBuilder::makePointInterval(kNullElementObj));
+    if (isHashed) {
+        // The cached intervals hold version 0 hashes; indexes hashed with a newer version need
+        // their points recomputed so the bounds line up with the stored keys.
+        const int version = hashedIndexVersion(index);
+        if (version == 0) {
+            oil->intervals.push_back(kHashedUndefinedInterval);
+            oil->intervals.push_back(kHashedNullInterval);
+        } else {
+            oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(
+                ExpressionMapping::hash(kUndefinedElementObj.firstElement(), version)));
+            oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(
+                ExpressionMapping::hash(kNullElementObj.firstElement(), version)));
+        }
+    } else {
+        oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(kUndefinedElementObj));
+        oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(kNullElementObj));
+    }
     // Just to be sure, make sure the bounds are in the right order if the hash values are opposite.
     IndexBoundsBuilder::unionize(oil);
 }
@@ -711,7 +733,8 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            // Pass the raw predicate so repeated query geometries can reuse a cached covering.
+            ExpressionMapping::cover2dsphere(region, gme->getRawObj(), indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if (mongoutils::str::equals("2d", elt.valuestrsafe())) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
@@ -951,7 +974,7 @@ void IndexBoundsBuilder::translateEquality(const BSONElement& data,
     if (BSONType::Array != data.type()) {
         BSONObj dataObj = objFromElement(data, index.collator);
         if (isHashed) {
-            dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            dataObj = ExpressionMapping::hash(dataObj.firstElement(), hashedIndexVersion(index));
         }
 
         verify(dataObj.isOwned());
@@ -862,7 +862,7 @@ TEST(IndexBoundsBuilderTest, TranslateExprEqualHashedIndex) {
     IndexBoundsBuilder::BoundsTightness tightness;
     IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
 
-    BSONObj expectedHash = ExpressionMapping::hash(BSON("" << 4).firstElement());
+    BSONObj expectedHash = ExpressionMapping::hash(BSON("" << 4).firstElement(), 0);
     BSONObjBuilder intervalBuilder;
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
@@ -2102,7 +2102,7 @@ TEST(IndexBoundsBuilderTest, TranslateEqualsToNullShouldBuildTwoIntervalsForHash
     {
         const BSONObj undefinedElementObj = BSON("" << BSONUndefined);
         const BSONObj hashedUndefinedInterval =
-            ExpressionMapping::hash(undefinedElementObj.firstElement());
+            ExpressionMapping::hash(undefinedElementObj.firstElement(), 0);
         ASSERT_EQ(hashedUndefinedInterval.firstElement().type(), BSONType::NumberLong);
 
         const auto& firstInterval = oil.intervals[0];
@@ -2115,7 +2115,8 @@ TEST(IndexBoundsBuilderTest, TranslateEqualsToNullShouldBuildTwoIntervalsForHash
 
     {
         const BSONObj nullElementObj = BSON("" << BSONNULL);
-        const BSONObj hashedNullInterval = ExpressionMapping::hash(nullElementObj.firstElement());
+        const BSONObj hashedNullInterval =
+            ExpressionMapping::hash(nullElementObj.firstElement(), 0);
         ASSERT_EQ(hashedNullInterval.firstElement().type(), BSONType::NumberLong);
 
         const auto& secondInterval = oil.intervals[1];
@@ -2805,7 +2806,7 @@ TEST(IndexBoundsBuilderTest, StringEqualityAgainstHashedIndexWithCollatorUsesHas
 
     BSONObj expectedCollationKey = BSON(""
                                         << "oof");
-    BSONObj expectedHash = ExpressionMapping::hash(expectedCollationKey.firstElement());
+    BSONObj expectedHash = ExpressionMapping::hash(expectedCollationKey.firstElement(), 0);
     BSONObjBuilder intervalBuilder;
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
@@ -2832,7 +2833,36 @@ TEST(IndexBoundsBuilderTest, EqualityToNumberAgainstHashedIndexWithCollatorUsesH
     IndexBoundsBuilder::BoundsTightness tightness;
     IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
 
-    BSONObj expectedHash = ExpressionMapping::hash(obj.firstElement());
+    BSONObj expectedHash = ExpressionMapping::hash(obj.firstElement(), 0);
+    BSONObjBuilder intervalBuilder;
+    intervalBuilder.append("", expectedHash.firstElement().numberLong());
+    intervalBuilder.append("", expectedHash.firstElement().numberLong());
+    BSONObj intervalObj = intervalBuilder.obj();
+
+    ASSERT_EQUALS(oil.name, "a");
+    ASSERT_EQUALS(oil.intervals.size(), 1U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(intervalObj, true, true)));
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
+}
+
+TEST(IndexBoundsBuilderTest, EqualityAgainstHashedIndexUsesIndexHashVersion) {
+    BSONObj keyPattern = fromjson("{a: 'hashed'}");
+    BSONElement elt = keyPattern.firstElement();
+    IndexEntry testIndex = IndexEntry(keyPattern);
+    testIndex.infoObj = fromjson("{hashVersion: 1}");
+
+    BSONObj obj = fromjson("{a: 3}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+
+    // The bounds must be computed with the index's hash version, not version 0.
+    BSONObj expectedHash = ExpressionMapping::hash(obj.firstElement(), 1);
+    ASSERT_NOT_EQUALS(expectedHash.firstElement().numberLong(),
+                      ExpressionMapping::hash(obj.firstElement(), 0).firstElement().numberLong());
     BSONObjBuilder intervalBuilder;
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
@@ -2861,7 +2891,7 @@ TEST(IndexBoundsBuilderTest, InWithStringAgainstHashedIndexWithCollatorUsesHashO
 
     BSONObj expectedCollationKey = BSON(""
                                         << "oof");
-    BSONObj expectedHash = ExpressionMapping::hash(expectedCollationKey.firstElement());
+    BSONObj expectedHash = ExpressionMapping::hash(expectedCollationKey.firstElement(), 0);
     BSONObjBuilder intervalBuilder;
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
     intervalBuilder.append("", expectedHash.firstElement().numberLong());
@@ -46,6 +46,8 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/allocation_accounting.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/log.h"
@@ -467,6 +469,9 @@ PlanCacheEntry* PlanCacheEntry::clone() const {
 
     // Copy performance stats.
     entry->feedback = feedback;
+    entry->executions = executions;
+    entry->sampledPlanStats = sampledPlanStats.getOwned();
+    entry->timeOfSampledPlanStats = timeOfSampledPlanStats;
 
     return entry;
 }
@@ -582,11 +587,27 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
+// static
+const size_t PlanCache::kNumPartitions;
+
 PlanCache::PlanCache() : PlanCache(internalQueryCacheSize.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size) {
+    // Distribute the configured capacity evenly across the partitions, allowing each to
+    // hold at least one entry.
+    const size_t partitionSize = std::max(size / kNumPartitions, static_cast<size_t>(1));
+    for (size_t i = 0; i < kNumPartitions; ++i) {
+        _partitions.push_back(stdx::make_unique<Partition>(partitionSize));
+    }
+}
 
-PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize.load()), _ns(ns) {}
+PlanCache::PlanCache(const std::string& ns) : PlanCache(internalQueryCacheSize.load()) {
+    _ns = ns;
+}
+
+PlanCache::Partition& PlanCache::partitionFor(const PlanCacheKey& key) const {
+    return *_partitions[computeQueryHash(key) % kNumPartitions];
+}
 
 PlanCache::~PlanCache() {}
 
@@ -817,6 +838,10 @@ Status PlanCache::set(const CanonicalQuery& query,
                       boost::optional<double> worksGrowthCoefficient) {
     invariant(why);
 
+    // Attribute the cache entry's allocations to the plan cache.
+    allocation_accounting::ScopedSubsystemTag allocationTag(
+        allocation_accounting::Subsystem::kPlanCache);
+
     if (solns.empty()) {
         return Status(ErrorCodes::BadValue, "no solutions provided");
     }
@@ -836,7 +861,8 @@ Status PlanCache::set(const CanonicalQuery& query,
 
     const auto key = computeKey(query);
     const size_t newWorks = why->stats[0]->common.works;
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     if (internalQueryCacheDisableInactiveEntries.load()) {
@@ -845,7 +871,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = PlanCache::computeQueryHash(key);
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = partition.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -888,7 +914,7 @@ Status PlanCache::set(const CanonicalQuery& query,
     }
     newEntry->projection = projBuilder.obj();
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, newEntry.release());
 
     if (NULL != evictedEntry.get()) {
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
@@ -905,9 +931,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -922,9 +949,10 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return {CacheEntryState::kNotPresent, nullptr};
@@ -936,12 +964,13 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
     return {state, stdx::make_unique<CachedSolution>(key, *entry)};
 }
 
-Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
+StatusWith<bool> PlanCache::feedback(const CanonicalQuery& cq, double score) {
     PlanCacheKey ck = computeKey(cq);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(ck);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = partition.cache.get(ck, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -952,17 +981,48 @@ Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
         entry->feedback.push_back(score);
     }
 
+    entry->executions++;
+
+    // Select the first execution and every Nth one after it for stats sampling. The caller
+    // serializes the stage stats outside of the partition lock and stores them with
+    // recordExecutionStatsSample().
+    const int sampleEveryN = internalQueryCacheSampleExecutionStatsEveryN.load();
+    if (sampleEveryN <= 0) {
+        return false;
+    }
+    return (entry->executions - 1) % static_cast<size_t>(sampleEveryN) == 0;
+}
+
+Status PlanCache::recordExecutionStatsSample(const CanonicalQuery& cq, BSONObj statsObj) {
+    PlanCacheKey ck = computeKey(cq);
+
+    Partition& partition = partitionFor(ck);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    PlanCacheEntry* entry;
+    Status cacheStatus = partition.cache.get(ck, &entry);
+    if (!cacheStatus.isOK()) {
+        return cacheStatus;
+    }
+    invariant(entry);
+
+    entry->sampledPlanStats = statsObj.getOwned();
+    entry->timeOfSampledPlanStats = Date_t::now();
+
     return Status::OK();
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheKey key = computeKey(canonicalQuery);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -980,9 +1040,10 @@ uint32_t PlanCache::computeQueryHash(const PlanCacheKey& key) {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -992,20 +1053,28 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    // Each partition is locked in turn, so the result is not a point-in-time snapshot of
+    // the whole cache. This is fine for the diagnostic commands that call us.
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
@@ -1016,13 +1085,15 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
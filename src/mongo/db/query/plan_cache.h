@@ -29,8 +29,11 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <memory>
 #include <set>
+#include <vector>
 
+#include "mongo/base/status_with.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/index_tag.h"
@@ -279,6 +282,16 @@ public:
     // trigger a replan. Running a query of the same shape while this cache entry is inactive may
     // cause this value to be increased.
     size_t works = 0;
+
+    // Number of times a plan from this cache entry has been executed.
+    size_t executions = 0;
+
+    // Stage-level execution stats sampled from a production execution of the cached plan, and
+    // the time the sample was taken. Refreshed every
+    // 'internalQueryCacheSampleExecutionStatsEveryN' executions of the plan and reported by
+    // planCacheListPlans; empty until the first sample is recorded.
+    BSONObj sampledPlanStats;
+    Date_t timeOfSampledPlanStats;
 };
 
 /**
@@ -398,9 +411,20 @@ public:
      * and an error Status is returned.
      *
      * If the entry corresponding to 'cq' still exists, 'feedback' is added to the run
-     * statistics about the plan.  Status::OK() is returned.
+     * statistics about the plan and the entry's execution counter is bumped. The returned value
+     * indicates whether this execution was selected for stats sampling, in which case the caller
+     * should serialize the stage-level execution stats of this run and store them via
+     * recordExecutionStatsSample().
+     */
+    StatusWith<bool> feedback(const CanonicalQuery& cq, double score);
+
+    /**
+     * Stores 'statsObj', the serialized stage-level execution stats of a sampled production
+     * execution of the cached plan, into the entry corresponding to 'cq'. Called by the
+     * CachedPlanStage when feedback() requested a sample. Returns an error Status if the entry
+     * is no longer in the cache.
      */
-    Status feedback(const CanonicalQuery& cq, double score);
+    Status recordExecutionStatsSample(const CanonicalQuery& cq, BSONObj statsObj);
 
     /**
      * Remove the entry corresponding to 'ck' from the cache.  Returns Status::OK() if the plan
@@ -430,6 +454,13 @@ public:
      */
     static uint32_t computeQueryHash(const PlanCacheKey& key);
 
+    /**
+     * Number of independently locked partitions the cache is striped across. A key's
+     * partition is determined by computeQueryHash(key) modulo this constant. Exposed so
+     * tests can construct keys that collide in (or avoid) a particular partition.
+     */
+    static const size_t kNumPartitions = 16;
+
     /**
      * Returns a copy of a cache entry.
      * Used by planCacheListPlans to display plan details.
@@ -482,10 +513,28 @@ private:
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
+    /**
+     * The cache is partitioned by query shape hash so that concurrent operations on
+     * different shapes do not serialize on a single mutex. Each partition is an
+     * independently locked LRU store holding an equal slice of the total capacity. A
+     * fully lock-free lookup is not practical here because a successful get() promotes
+     * the entry in the LRU recency list.
+     */
+    struct Partition {
+        explicit Partition(size_t maxSize) : cache(maxSize) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry> cache;
+
+        // Protects 'cache'.
+        mutable stdx::mutex mutex;
+    };
+
+    /**
+     * Returns the partition responsible for 'key'.
+     */
+    Partition& partitionFor(const PlanCacheKey& key) const;
 
-    // Protects _cache.
-    mutable stdx::mutex _cacheMutex;
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Full namespace of collection.
     std::string _ns;
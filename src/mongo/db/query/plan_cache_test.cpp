@@ -35,6 +35,8 @@
 #include <algorithm>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
@@ -475,37 +477,53 @@ TEST(PlanCacheTest, InactiveEntriesDisabled) {
 
 
 TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
-    // Use a tiny cache size.
-    const size_t kCacheSize = 2;
-    PlanCache planCache(kCacheSize);
+    // Use a tiny cache size: each of the cache's partitions holds at most two entries.
+    PlanCache planCache(2 * PlanCache::kNumPartitions);
     QueryTestServiceContext serviceContext;
 
-    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
-    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kNotPresent);
-    addCacheEntryForShape(*cqA.get(), &planCache);
+    // The LRU policy is applied per partition, so find three distinct query shapes whose
+    // plan cache keys fall in the same partition and therefore compete for the same slots.
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    queries.emplace_back(canonicalize("{lru0: 1}"));
+    const size_t targetPartition =
+        PlanCache::computeQueryHash(planCache.computeKey(*queries[0])) % PlanCache::kNumPartitions;
+    for (int i = 1; queries.size() < 3U; ++i) {
+        const std::string filter = "{lru" + std::to_string(i) + ": 1}";
+        unique_ptr<CanonicalQuery> cq(canonicalize(filter.c_str()));
+        const size_t partition =
+            PlanCache::computeQueryHash(planCache.computeKey(*cq)) % PlanCache::kNumPartitions;
+        if (partition == targetPartition) {
+            queries.push_back(std::move(cq));
+        }
+    }
+    const CanonicalQuery& cqA = *queries[0];
+    const CanonicalQuery& cqB = *queries[1];
+    const CanonicalQuery& cqC = *queries[2];
+
+    ASSERT_EQ(planCache.get(cqA).state, PlanCache::CacheEntryState::kNotPresent);
+    addCacheEntryForShape(cqA, &planCache);
 
     // After add, the planCache should have an inactive entry.
-    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(planCache.get(cqA).state, PlanCache::CacheEntryState::kPresentInactive);
 
     // Add a cache entry for another shape.
-    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
-    ASSERT_EQ(planCache.get(*cqB).state, PlanCache::CacheEntryState::kNotPresent);
-    addCacheEntryForShape(*cqB.get(), &planCache);
-    ASSERT_EQ(planCache.get(*cqB).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(planCache.get(cqB).state, PlanCache::CacheEntryState::kNotPresent);
+    addCacheEntryForShape(cqB, &planCache);
+    ASSERT_EQ(planCache.get(cqB).state, PlanCache::CacheEntryState::kPresentInactive);
 
-    // Access the cached solution for the {a: 1} shape. Now the entry for {b: 1} will be the least
-    // recently used.
-    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+    // Access the cached solution for the first shape. Now the entry for the second shape
+    // will be the least recently used in their shared partition.
+    ASSERT_EQ(planCache.get(cqA).state, PlanCache::CacheEntryState::kPresentInactive);
 
-    // Insert another entry. Since the cache size is 2, we expect the {b: 1} entry to be ejected.
-    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
-    ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kNotPresent);
-    addCacheEntryForShape(*cqC.get(), &planCache);
+    // Insert another entry. Since the partition holds only two entries, we expect the
+    // second shape's entry to be ejected.
+    ASSERT_EQ(planCache.get(cqC).state, PlanCache::CacheEntryState::kNotPresent);
+    addCacheEntryForShape(cqC, &planCache);
 
-    // Check that {b: 1} is gone, but {a: 1} and {c: 1} both still have entries.
-    ASSERT_EQ(planCache.get(*cqB).state, PlanCache::CacheEntryState::kNotPresent);
-    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
-    ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
+    // Check that the second shape is gone, but the first and third both still have entries.
+    ASSERT_EQ(planCache.get(cqB).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.get(cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(planCache.get(cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
@@ -628,6 +646,36 @@ TEST(PlanCacheTest, WorksValueIncreases) {
     ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
 }
 
+TEST(PlanCacheTest, FeedbackSamplesExecutionStatsEveryN) {
+    const auto previousSampleEveryN = internalQueryCacheSampleExecutionStatsEveryN.load();
+    internalQueryCacheSampleExecutionStatsEveryN.store(3);
+    ON_BLOCK_EXIT(
+        [previousSampleEveryN] { internalQueryCacheSampleExecutionStatsEveryN.store(previousSampleEveryN); });
+
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    QueryTestServiceContext serviceContext;
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U), Date_t{}));
+
+    // The first execution and every third one after it should be selected for sampling.
+    ASSERT_TRUE(assertGet(planCache.feedback(*cq, 1.0)));
+    ASSERT_FALSE(assertGet(planCache.feedback(*cq, 1.0)));
+    ASSERT_FALSE(assertGet(planCache.feedback(*cq, 1.0)));
+    ASSERT_TRUE(assertGet(planCache.feedback(*cq, 1.0)));
+
+    // Recording a sample makes it visible on the entry, along with the execution count.
+    ASSERT_OK(planCache.recordExecutionStatsSample(*cq,
+                                                   BSON("stage"
+                                                        << "COLLSCAN")));
+    auto entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->executions, 4U);
+    ASSERT_BSONOBJ_EQ(entry->sampledPlanStats,
+                      BSON("stage"
+                           << "COLLSCAN"));
+}
+
 TEST(PlanCacheTest, WorksValueIncreasesByAtLeastOne) {
     // Will use a very small growth coefficient.
     const double kWorksCoeff = 1.10;
@@ -71,6 +71,10 @@ const OperationContext::Decoration<repl::OpTime> clientsLastKnownCommittedOpTime
 struct CappedInsertNotifierData {
     shared_ptr<CappedInsertNotifier> notifier;
     uint64_t lastEOFVersion = ~0;
+
+    // The lower bound the query places on the "ts" field, if any. Inserts below this bound cannot
+    // produce results, so they need not wake the waiting thread.
+    boost::optional<Timestamp> minTs;
 };
 
 namespace {
@@ -78,6 +82,42 @@ namespace {
 MONGO_FAIL_POINT_DEFINE(planExecutorAlwaysFails);
 MONGO_FAIL_POINT_DEFINE(planExecutorHangBeforeShouldWaitForInserts);
 
+/**
+ * Returns the lower bound that the query places on the "ts" field: a $eq, $gt or $gte comparison
+ * against a Timestamp, either at the top level or inside a top-level $and.
+ */
+boost::optional<Timestamp> extractTsLowerBound(const MatchExpression* me, bool topLevel = true) {
+    if (me->matchType() == MatchExpression::AND && topLevel) {
+        boost::optional<Timestamp> min;
+        for (size_t i = 0; i < me->numChildren(); ++i) {
+            auto childMin = extractTsLowerBound(me->getChild(i), false);
+            if (childMin && (!min || childMin.get() > min.get())) {
+                min = childMin;
+            }
+        }
+        return min;
+    }
+
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(me) ||
+        me->path() != repl::OpTime::kTimestampFieldName) {
+        return boost::none;
+    }
+
+    auto rawElem = static_cast<const ComparisonMatchExpression*>(me)->getData();
+    if (rawElem.type() != BSONType::bsonTimestamp) {
+        return boost::none;
+    }
+
+    switch (me->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return rawElem.timestamp();
+        default:
+            return boost::none;
+    }
+}
+
 /**
  * Constructs a PlanYieldPolicy based on 'policy'.
  */
@@ -229,6 +269,15 @@ PlanExecutor::PlanExecutor(OperationContext* opCtx,
       _nss(std::move(nss)),
       // There's no point in yielding if the collection doesn't exist.
       _yieldPolicy(makeYieldPolicy(this, collection ? yieldPolicy : NO_YIELD)) {
+    // Per-stage execution time only shows up in explain output and profiler entries, and
+    // collecting it costs clock reads on every work() call. Turn it on up front when this
+    // execution will be reported; explain marks the tree again before running it, but marking
+    // here also covers the multi-planner's trial period.
+    if (CurOp::get(opCtx)->shouldDBProfile() ||
+        (_cq && _cq->getQueryRequest().isExplain())) {
+        _root->markShouldCollectTimingInfo();
+    }
+
     // We may still need to initialize _nss from either collection or _cq.
     if (!_nss.isEmpty()) {
         return;  // We already have an _nss set, so there's nothing more to do.
@@ -469,10 +518,18 @@ PlanExecutor::ExecState PlanExecutor::waitForInserts(CappedInsertNotifierData* n
     curOp->pauseTimer();
     ON_BLOCK_EXIT([curOp] { curOp->resumeTimer(); });
     auto opCtx = _opCtx;
+
+    // Waiters with a lastKnownCommittedOpTime must be woken by every insert, since even an insert
+    // their query cannot match may advance the commit point they report to the client.
+    boost::optional<Timestamp> minTs;
+    if (clientsLastKnownCommittedOpTime(opCtx).isNull()) {
+        minTs = notifierData->minTs;
+    }
+
     uint64_t currentNotifierVersion = notifierData->notifier->getVersion();
-    auto yieldResult = _yieldPolicy->yieldOrInterrupt([opCtx, notifierData] {
+    auto yieldResult = _yieldPolicy->yieldOrInterrupt([opCtx, notifierData, minTs] {
         const auto deadline = awaitDataState(opCtx).waitForInsertsDeadline;
-        notifierData->notifier->waitUntil(notifierData->lastEOFVersion, deadline);
+        notifierData->notifier->waitUntil(notifierData->lastEOFVersion, deadline, minTs);
     });
     notifierData->lastEOFVersion = currentNotifierVersion;
 
@@ -524,6 +581,14 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
     if (shouldListenForInserts()) {
         // We always construct the CappedInsertNotifier for awaitData cursors.
         cappedInsertNotifierData.notifier = getCappedInsertNotifier();
+
+        // Oplog tailers with a lower "ts" bound in the future only need to be woken once an
+        // insert at or above that bound becomes visible. The filter is restricted to the oplog
+        // because only its notifications carry a timestamp that bounds all newly visible
+        // documents.
+        if (_nss.isOplog() && _cq) {
+            cappedInsertNotifierData.minTs = extractTsLowerBound(_cq->root());
+        }
     }
     for (;;) {
         // These are the conditions which can cause us to yield:
@@ -692,11 +757,24 @@ void PlanExecutor::enqueue(const BSONObj& obj) {
 }
 
 Timestamp PlanExecutor::getLatestOplogTimestamp() {
-    if (auto pipelineProxy = getStageByType(_root.get(), STAGE_PIPELINE_PROXY))
-        return static_cast<PipelineProxyStage*>(pipelineProxy)->getLatestOplogTimestamp();
-    if (auto collectionScan = getStageByType(_root.get(), STAGE_COLLSCAN))
-        return static_cast<CollectionScan*>(collectionScan)->getLatestOplogTimestamp();
-    return Timestamp();
+    if (!_latestOplogTimestampStageResolved) {
+        _latestOplogTimestampStageResolved = true;
+        if (auto pipelineProxy = getStageByType(_root.get(), STAGE_PIPELINE_PROXY)) {
+            _latestOplogTimestampStage = pipelineProxy;
+        } else if (auto collectionScan = getStageByType(_root.get(), STAGE_COLLSCAN)) {
+            _latestOplogTimestampStage = collectionScan;
+        }
+    }
+
+    if (!_latestOplogTimestampStage) {
+        return Timestamp();
+    }
+
+    if (_latestOplogTimestampStage->stageType() == STAGE_PIPELINE_PROXY) {
+        return static_cast<PipelineProxyStage*>(_latestOplogTimestampStage)
+            ->getLatestOplogTimestamp();
+    }
+    return static_cast<CollectionScan*>(_latestOplogTimestampStage)->getLatestOplogTimestamp();
 }
 
 //
@@ -572,6 +572,13 @@ private:
     // stages.
     std::queue<BSONObj> _stash;
 
+    // The stage tracking the latest oplog timestamp, if any, resolved on the first call to
+    // getLatestOplogTimestamp(). The plan tree is fixed for the life of the executor, so we
+    // locate this stage at most once rather than walking the tree on every call; find and
+    // getMore call getLatestOplogTimestamp() once per document when building a batch.
+    PlanStage* _latestOplogTimestampStage = nullptr;
+    bool _latestOplogTimestampStageResolved = false;
+
     enum { kUsable, kSaved, kDetached, kDisposed } _currentState = kUsable;
 
     // Set if this PlanExecutor is registered with the CursorManager.
@@ -48,6 +48,12 @@ extern AtomicDouble internalQueryPlanEvaluationCollFraction;
 // Stop working plans once a plan returns this many results.
 extern AtomicInt32 internalQueryPlanEvaluationMaxResults;
 
+// Stop the plan evaluation trial period after this much wall-clock time, even if no plan has
+// reached EOF or produced enough results. The plans are then ranked on the statistics gathered
+// so far. Zero means no time limit. This bounds the multi-planning cost on large collections,
+// where the works-based trial limit can otherwise grow with the collection size.
+extern AtomicInt32 internalQueryPlanEvaluationMaxTimeMillis;
+
 // Do we give a big ranking bonus to intersection plans?
 extern AtomicBool internalQueryForceIntersectionPlans;
 
@@ -79,9 +85,18 @@ extern AtomicDouble internalQueryCacheWorksGrowthCoefficient;
 // Whether or not cache entries can be marked as "inactive."
 extern AtomicBool internalQueryCacheDisableInactiveEntries;
 
+// Whether a poorly performing cached plan is first re-ranked against the runner-up candidate
+// recorded in its cache entry, rather than immediately replanning the query from scratch.
+extern AtomicBool internalQueryCacheReplanIncrementally;
+
 // Whether or not planCacheListPlans uses the new output format.
 extern AtomicBool internalQueryCacheListPlansNewOutput;
 
+// Every how many executions of a cached plan its stage-level execution stats are sampled into
+// the cache entry, where they can be inspected via planCacheListPlans. Zero or less disables
+// sampling.
+extern AtomicInt32 internalQueryCacheSampleExecutionStatsEveryN;
+
 //
 // Planning and enumeration.
 //
@@ -120,6 +135,13 @@ extern AtomicInt32 internalQueryExecYieldIterations;
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// When a multi-interval index scan must reposition to the next interval, probe forward this many
+// keys from the cursor's current position before falling back to a full seek. Each probe is a
+// single cursor advance, whereas a seek is a new descent of the index tree; for dense bounds (e.g.
+// a large $in over clustered values) the next interval usually starts within a few keys. Set to 0
+// to always seek.
+extern AtomicInt32 internalQueryIndexScanGallopBeforeSeek;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
@@ -434,12 +434,18 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     const CachedSolution& cachedSoln) {
     invariant(!cachedSoln.plannerData.empty());
 
+    // Look up winning solution in cached solution's array.
+    return planFromCache(query, params, *cachedSoln.plannerData[0]);
+}
+
+// static
+StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
+    const CanonicalQuery& query,
+    const QueryPlannerParams& params,
+    const SolutionCacheData& winnerCacheData) {
     // A query not suitable for caching should not have made its way into the cache.
     invariant(PlanCache::shouldCacheQuery(query));
 
-    // Look up winning solution in cached solution's array.
-    const SolutionCacheData& winnerCacheData = *cachedSoln.plannerData[0];
-
     if (SolutionCacheData::WHOLE_IXSCAN_SOLN == winnerCacheData.solnType) {
         // The solution can be constructed by a scan over the entire index.
         auto soln = buildWholeIXSoln(
@@ -66,6 +66,21 @@ public:
         const QueryPlannerParams& params,
         const CachedSolution& cachedSoln);
 
+    /**
+     * Generates and returns a query solution from the planner data of a single cached
+     * candidate plan. Used to reconstruct the winning solution of a cache entry, and by
+     * CachedPlanStage to rebuild a runner-up candidate when re-ranking a poorly performing
+     * cached plan.
+     *
+     * @param query -- query for which we are generating a plan
+     * @param params -- planning parameters
+     * @param solnCacheData -- the planner data of one cached candidate plan.
+     */
+    static StatusWith<std::unique_ptr<QuerySolution>> planFromCache(
+        const CanonicalQuery& query,
+        const QueryPlannerParams& params,
+        const SolutionCacheData& solnCacheData);
+
     /**
      * Generates and returns the index tag tree that will be inserted into the plan cache. This data
      * gets stashed inside a QuerySolution until it can be inserted into the cache proper.
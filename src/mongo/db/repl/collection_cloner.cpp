@@ -39,6 +39,7 @@
 #include "mongo/client/dbclient_connection.h"
 #include "mongo/client/remote_command_retry_scheduler.h"
 #include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/client.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/repl/oplogreader.h"
@@ -46,11 +47,13 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -73,6 +76,13 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
 // Whether to use the "exhaust cursor" feature when retrieving collection data.
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(collectionClonerUsesExhaust, bool, true);
+// The maximum number of cursors to use when cloning a single collection. When greater than one,
+// the collection is split into disjoint _id ranges (using split points sampled from the sync
+// source) which are cloned concurrently over separate connections.
+MONGO_EXPORT_SERVER_PARAMETER(maxNumInitialSyncCollectionClonerCursors, int, 1);
+
+// Collections smaller than this are not worth the cost of sampling split points.
+const long long kMinBytesPerClonerCursor = 10LL * 1024 * 1024;
 }  // namespace
 
 // Failpoint which causes initial sync to hang before establishing its cursor to clone the
@@ -548,20 +558,67 @@ void CollectionCloner::_runQuery(const executor::TaskExecutor::CallbackArgs& cal
     auto onCompletionGuard =
         std::make_shared<OnCompletionGuard>(cancelRemainingWorkInLock, finishCallbackFn);
 
-    try {
-        conn->query(
-            [this, onCompletionGuard](DBClientCursorBatchIterator& iter) {
-                _handleNextBatch(onCompletionGuard, iter);
-            },
-            NamespaceStringOrUUID(_sourceNss.db().toString(), *_options.uuid),
-            Query(),
-            nullptr /* fieldsToReturn */,
-            QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
-                (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
-            _collectionClonerBatchSize);
-    } catch (const DBException& e) {
-        auto queryStatus = e.toStatus().withContext(str::stream() << "Error querying collection '"
-                                                                  << _sourceNss.ns());
+    const int numCursors = maxNumInitialSyncCollectionClonerCursors.load();
+    std::vector<BSONObj> splitPoints;
+    if (numCursors > 1) {
+        splitPoints = _getSplitPoints(conn.get(), numCursors);
+    }
+
+    Status queryStatus = Status::OK();
+    if (splitPoints.empty()) {
+        queryStatus = _queryRange(conn.get(), Query(), onCompletionGuard);
+    } else {
+        // Build disjoint _id ranges from the split points; the first and last ranges are
+        // unbounded below and above respectively so the ranges cover the whole collection.
+        std::vector<Query> rangeQueries;
+        for (size_t i = 0; i <= splitPoints.size(); i++) {
+            BSONObjBuilder bounds;
+            if (i > 0) {
+                bounds.appendAs(splitPoints[i - 1].firstElement(), "$gte");
+            }
+            if (i < splitPoints.size()) {
+                bounds.appendAs(splitPoints[i].firstElement(), "$lt");
+            }
+            rangeQueries.push_back(Query(BSON("_id" << bounds.obj())));
+        }
+
+        LOG(1) << "Cloning collection " << _sourceNss.ns() << " with " << rangeQueries.size()
+               << " concurrent cursors";
+
+        // The first range reuses the connection we already authenticated; each additional range
+        // gets its own connection and thread so the exhaust cursors run concurrently.
+        std::vector<Status> rangeStatuses(rangeQueries.size(), Status::OK());
+        std::vector<stdx::thread> workers;
+        for (size_t i = 1; i < rangeQueries.size(); i++) {
+            workers.emplace_back([this, i, &rangeQueries, &rangeStatuses, onCompletionGuard] {
+                Client::initThread("CollectionClonerCursor");
+                ON_BLOCK_EXIT([] { Client::destroy(); });
+                auto workerConn = _createClientFn();
+                Status workerStatus = workerConn->connect(_source, StringData());
+                if (workerStatus.isOK() && !replAuthenticate(workerConn.get())) {
+                    workerStatus = {ErrorCodes::AuthenticationFailed,
+                                    str::stream() << "Failed to authenticate to " << _source};
+                }
+                if (workerStatus.isOK()) {
+                    workerStatus =
+                        _queryRange(workerConn.get(), rangeQueries[i], onCompletionGuard);
+                }
+                rangeStatuses[i] = workerStatus;
+            });
+        }
+        rangeStatuses[0] = _queryRange(conn.get(), rangeQueries[0], onCompletionGuard);
+        for (auto&& worker : workers) {
+            worker.join();
+        }
+        for (auto&& rangeStatus : rangeStatuses) {
+            if (!rangeStatus.isOK()) {
+                queryStatus = rangeStatus;
+                break;
+            }
+        }
+    }
+
+    if (!queryStatus.isOK()) {
         stdx::unique_lock<stdx::mutex> lock(_mutex);
         if (queryStatus.code() == ErrorCodes::OperationFailed ||
             queryStatus.code() == ErrorCodes::CursorNotFound) {
@@ -582,11 +639,80 @@ void CollectionCloner::_runQuery(const executor::TaskExecutor::CallbackArgs& cal
     onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
 }
 
+std::vector<BSONObj> CollectionCloner::_getSplitPoints(DBClientConnection* conn, int numCursors) {
+    // Split points are _id index bounds, whose comparison semantics depend on the collection's
+    // default collation, so only simple-collation collections are split.
+    if (!_options.collation.isEmpty()) {
+        return {};
+    }
+
+    try {
+        BSONObj statsResult;
+        if (!conn->runCommand(_sourceNss.db().toString(),
+                              BSON("collStats" << _sourceNss.coll()),
+                              statsResult)) {
+            LOG(1) << "collStats failed while sampling split points for " << _sourceNss.ns()
+                   << ", falling back to a single cursor: " << redact(statsResult);
+            return {};
+        }
+        const long long dataSize = statsResult["size"].safeNumberLong();
+        if (dataSize < kMinBytesPerClonerCursor * numCursors) {
+            return {};
+        }
+
+        BSONObj splitResult;
+        if (!conn->runCommand(_sourceNss.db().toString(),
+                              BSON("splitVector" << _sourceNss.ns() << "keyPattern"
+                                                 << BSON("_id" << 1)
+                                                 << "maxSplitPoints"
+                                                 << numCursors - 1
+                                                 << "maxChunkSizeBytes"
+                                                 << dataSize / numCursors),
+                              splitResult)) {
+            LOG(1) << "splitVector failed while sampling split points for " << _sourceNss.ns()
+                   << ", falling back to a single cursor: " << redact(splitResult);
+            return {};
+        }
+
+        std::vector<BSONObj> splitPoints;
+        for (auto&& key : splitResult["splitKeys"].Obj()) {
+            splitPoints.push_back(key.Obj().getOwned());
+        }
+        return splitPoints;
+    } catch (const DBException& e) {
+        LOG(1) << "Error sampling split points for " << _sourceNss.ns()
+               << ", falling back to a single cursor: " << redact(e.toStatus());
+        return {};
+    }
+}
+
+Status CollectionCloner::_queryRange(DBClientConnection* conn,
+                                     const Query& query,
+                                     const std::shared_ptr<OnCompletionGuard>& onCompletionGuard) {
+    try {
+        conn->query(
+            [this, onCompletionGuard](DBClientCursorBatchIterator& iter) {
+                _handleNextBatch(onCompletionGuard, iter);
+            },
+            NamespaceStringOrUUID(_sourceNss.db().toString(), *_options.uuid),
+            query,
+            nullptr /* fieldsToReturn */,
+            QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
+                (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+            _collectionClonerBatchSize);
+    } catch (const DBException& e) {
+        return e.toStatus().withContext(str::stream() << "Error querying collection '"
+                                                      << _sourceNss.ns());
+    }
+    return Status::OK();
+}
+
 void CollectionCloner::_handleNextBatch(std::shared_ptr<OnCompletionGuard> onCompletionGuard,
                                         DBClientCursorBatchIterator& iter) {
-    _stats.receivedBatches++;
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
+        // Batches may arrive concurrently from multiple cloner cursors.
+        _stats.receivedBatches++;
         uassert(ErrorCodes::CallbackCanceled,
                 "Collection cloning cancelled.",
                 _queryState != QueryState::kCanceling);
@@ -217,6 +217,22 @@ private:
      */
     void _runQuery(const executor::TaskExecutor::CallbackArgs& callbackData);
 
+    /**
+     * Samples up to 'numCursors - 1' _id split points from the sync source so that the
+     * collection can be cloned with multiple concurrent cursors over disjoint _id ranges.
+     * Returns an empty vector if sampling fails or does not apply (small collection, non-simple
+     * default collation), in which case a single cursor is used.
+     */
+    std::vector<BSONObj> _getSplitPoints(DBClientConnection* conn, int numCursors);
+
+    /**
+     * Runs a (possibly range-bounded) query for the collection's documents on 'conn', feeding
+     * each batch to _handleNextBatch(). Returns the error raised by the query, if any.
+     */
+    Status _queryRange(DBClientConnection* conn,
+                       const Query& query,
+                       const std::shared_ptr<OnCompletionGuard>& onCompletionGuard);
+
     /**
      * Put all results from a query batch into a buffer to be inserted, and schedule
      * it to be inserted.
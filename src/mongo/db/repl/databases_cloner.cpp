@@ -152,6 +152,11 @@ Status DatabasesCloner::getStatus() {
     return _status;
 }
 
+bool DatabasesCloner::isCollectionCloned(const NamespaceString& nss) const {
+    LockGuard lk(_mutex);
+    return _clonedCollections.count(nss.ns()) > 0;
+}
+
 DatabasesCloner::Stats DatabasesCloner::getStats() const {
     LockGuard lk(_mutex);
     DatabasesCloner::Stats stats = _stats;
@@ -340,9 +345,12 @@ void DatabasesCloner::_onListDatabaseFinish(
             LOG(2) << "Allowing cloning of collectionInfo: " << collInfo;
             return true;
         };
-        const auto onCollectionFinish = [](const Status& status, const NamespaceString& srcNss) {
+        const auto onCollectionFinish = [this](const Status& status,
+                                               const NamespaceString& srcNss) {
             if (status.isOK()) {
                 LOG(1) << "collection clone finished: " << srcNss;
+                LockGuard lk(_mutex);
+                _clonedCollections.insert(srcNss.ns());
             } else {
                 warning() << "collection clone for '" << srcNss << "' failed due to "
                           << status.toString();
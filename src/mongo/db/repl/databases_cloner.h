@@ -44,6 +44,7 @@
 #include "mongo/executor/task_executor.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/net/hostandport.h"
 
@@ -91,6 +92,13 @@ public:
     Status getStatus();
     std::string toString() const;
 
+    /**
+     * Returns true if the collection cloner for 'nss' has completed successfully. Used by the
+     * initial syncer to begin applying buffered oplog entries to collections that have already
+     * been cloned while the remaining collections are still copying.
+     */
+    bool isCollectionCloned(const NamespaceString& nss) const;
+
     /**
      * Overrides how executor schedules database work.
      *
@@ -187,6 +195,7 @@ private:
 
     std::unique_ptr<RemoteCommandRetryScheduler> _listDBsScheduler;  // (M) scheduler for listDBs.
     std::vector<std::shared_ptr<DatabaseCloner>> _databaseCloners;   // (M) database cloners by name
+    stdx::unordered_set<std::string> _clonedCollections;  // (M) namespaces cloned successfully.
     Stats _stats;                                                    // (M)
 
     // State transitions:
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/file_copier.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/crc32c.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace repl {
+
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncFileCopyMaxMBPerSec, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "initialSyncFileCopyMaxMBPerSec must be non-negative");
+        }
+        return Status::OK();
+    });
+
+namespace {
+
+// Reads are issued in chunks this large so the copy runs at the disk's sequential bandwidth
+// rather than its seek rate.
+constexpr std::size_t kCopyBufferBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
+FileCopier::FileCopier(std::string sourceRoot, std::string destinationRoot)
+    : _sourceRoot(std::move(sourceRoot)),
+      _destinationRoot(std::move(destinationRoot)),
+      _windowStart(Date_t::now()) {}
+
+StatusWith<FileCopier::FileResult> FileCopier::copyFile(const std::string& relativePath) {
+    const auto sourcePath = boost::filesystem::path(_sourceRoot) / relativePath;
+    const auto destinationPath = boost::filesystem::path(_destinationRoot) / relativePath;
+
+    std::ifstream source(sourcePath.string().c_str(), std::ios::binary);
+    if (!source.is_open()) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "failed to open " << sourcePath.string() << " for reading"};
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(destinationPath.parent_path(), ec);
+    if (ec) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "failed to create directory "
+                              << destinationPath.parent_path().string()
+                              << ": "
+                              << ec.message()};
+    }
+
+    std::ofstream destination(destinationPath.string().c_str(),
+                              std::ios::binary | std::ios::trunc);
+    if (!destination.is_open()) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "failed to open " << destinationPath.string() << " for writing"};
+    }
+
+    const auto buffer = stdx::make_unique<char[]>(kCopyBufferBytes);
+    FileResult result;
+    while (true) {
+        source.read(buffer.get(), kCopyBufferBytes);
+        const auto bytesRead = source.gcount();
+        if (source.bad()) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "failed reading from " << sourcePath.string()};
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+
+        destination.write(buffer.get(), bytesRead);
+        if (destination.fail()) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "failed writing to " << destinationPath.string()};
+        }
+
+        result.checksum = crc32c(result.checksum, buffer.get(), bytesRead);
+        result.bytesCopied += bytesRead;
+        _throttle(bytesRead);
+
+        if (source.eof()) {
+            break;
+        }
+    }
+
+    destination.flush();
+    if (destination.fail()) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "failed writing to " << destinationPath.string()};
+    }
+
+    _totalBytesCopied += result.bytesCopied;
+    LOG(2) << "Copied " << relativePath << " (" << result.bytesCopied << " bytes, crc32c "
+           << result.checksum << ")";
+    return result;
+}
+
+void FileCopier::_throttle(std::uint64_t bytes) {
+    _windowBytes += bytes;
+
+    const std::int64_t maxMBPerSec = initialSyncFileCopyMaxMBPerSec.load();
+    if (maxMBPerSec <= 0) {
+        return;
+    }
+
+    const std::uint64_t maxBytesPerWindow = maxMBPerSec * 1024 * 1024;
+    const auto now = Date_t::now();
+    if (now - _windowStart >= Seconds(1)) {
+        _windowStart = now;
+        _windowBytes = bytes;
+        return;
+    }
+
+    if (_windowBytes > maxBytesPerWindow) {
+        // The budget for this one-second window is spent; sleep out the remainder.
+        sleepFor(_windowStart + Seconds(1) - now);
+        _windowStart = Date_t::now();
+        _windowBytes = 0;
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
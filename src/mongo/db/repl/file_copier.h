@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/status_with.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace repl {
+
+// Upper bound, in megabytes per second, on the rate at which FileCopier streams file data, so a
+// physical copy does not starve the source (or destination) of disk bandwidth. 0 means unlimited.
+extern AtomicInt32 initialSyncFileCopyMaxMBPerSec;
+
+/**
+ * Copies the files enumerated by a backup cursor (see BackupCursorHooks::openBackupCursor(),
+ * whose filenames are paths relative to the source node's dbpath) from one directory tree into
+ * another, the way a physical-copy initial sync would seed a fresh replica from a storage engine
+ * snapshot of its sync source.
+ *
+ * Files are streamed with large sequential reads, a CRC-32C is accumulated over each file as it
+ * passes through so the two sides of a remote copy can cheaply agree the bytes arrived intact,
+ * and the copy paces itself against initialSyncFileCopyMaxMBPerSec.
+ *
+ * Not thread-safe; run one FileCopier per copy operation.
+ */
+class FileCopier {
+public:
+    struct FileResult {
+        std::uint64_t bytesCopied = 0;
+        std::uint32_t checksum = 0;
+    };
+
+    FileCopier(std::string sourceRoot, std::string destinationRoot);
+
+    /**
+     * Copies 'relativePath' from the source root to the same path under the destination root,
+     * creating intermediate directories as needed and replacing any existing destination file.
+     * Returns the byte count and CRC-32C of the copied data.
+     */
+    StatusWith<FileResult> copyFile(const std::string& relativePath);
+
+    /**
+     * Total bytes copied by this FileCopier across all copyFile() calls.
+     */
+    std::uint64_t totalBytesCopied() const {
+        return _totalBytesCopied;
+    }
+
+private:
+    /**
+     * Accounts for 'bytes' just having been copied and sleeps as needed to keep the overall rate
+     * under initialSyncFileCopyMaxMBPerSec.
+     */
+    void _throttle(std::uint64_t bytes);
+
+    const std::string _sourceRoot;
+    const std::string _destinationRoot;
+
+    std::uint64_t _totalBytesCopied = 0;
+
+    // State of the current one-second throttling window.
+    Date_t _windowStart;
+    std::uint64_t _windowBytes = 0;
+};
+
+}  // namespace repl
+}  // namespace mongo
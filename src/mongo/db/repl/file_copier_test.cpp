@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/file_copier.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/crc32c.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+void writeFile(const boost::filesystem::path& path, const std::string& contents) {
+    boost::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path.string().c_str(), std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    file << contents;
+}
+
+std::string readFile(const boost::filesystem::path& path) {
+    std::ifstream file(path.string().c_str(), std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+TEST(FileCopierTest, CopiesFileAndReportsChecksum) {
+    unittest::TempDir source("fileCopierSource");
+    unittest::TempDir destination("fileCopierDestination");
+
+    const std::string contents = "physical copy beats logical sync";
+    writeFile(boost::filesystem::path(source.path()) / "collection-0.wt", contents);
+
+    FileCopier copier(source.path(), destination.path());
+    auto result = unittest::assertGet(copier.copyFile("collection-0.wt"));
+
+    ASSERT_EQUALS(contents.size(), result.bytesCopied);
+    ASSERT_EQUALS(crc32c(contents.data(), contents.size()), result.checksum);
+    ASSERT_EQUALS(contents,
+                  readFile(boost::filesystem::path(destination.path()) / "collection-0.wt"));
+    ASSERT_EQUALS(contents.size(), copier.totalBytesCopied());
+}
+
+TEST(FileCopierTest, CreatesIntermediateDirectories) {
+    unittest::TempDir source("fileCopierSource");
+    unittest::TempDir destination("fileCopierDestination");
+
+    writeFile(boost::filesystem::path(source.path()) / "journal" / "WiredTigerLog.01", "abc");
+
+    FileCopier copier(source.path(), destination.path());
+    auto result = unittest::assertGet(copier.copyFile("journal/WiredTigerLog.01"));
+
+    ASSERT_EQUALS(3U, result.bytesCopied);
+    ASSERT_EQUALS(
+        "abc",
+        readFile(boost::filesystem::path(destination.path()) / "journal" / "WiredTigerLog.01"));
+}
+
+TEST(FileCopierTest, CopiesEmptyFile) {
+    unittest::TempDir source("fileCopierSource");
+    unittest::TempDir destination("fileCopierDestination");
+
+    writeFile(boost::filesystem::path(source.path()) / "WiredTiger.lock", "");
+
+    FileCopier copier(source.path(), destination.path());
+    auto result = unittest::assertGet(copier.copyFile("WiredTiger.lock"));
+
+    ASSERT_EQUALS(0U, result.bytesCopied);
+    ASSERT_EQUALS(0U, result.checksum);
+    ASSERT_TRUE(
+        boost::filesystem::exists(boost::filesystem::path(destination.path()) / "WiredTiger.lock"));
+}
+
+TEST(FileCopierTest, FailsCleanlyOnMissingSourceFile) {
+    unittest::TempDir source("fileCopierSource");
+    unittest::TempDir destination("fileCopierDestination");
+
+    FileCopier copier(source.path(), destination.path());
+    ASSERT_EQUALS(ErrorCodes::FileOpenFailed, copier.copyFile("no-such-file.wt").getStatus());
+    ASSERT_EQUALS(0U, copier.totalBytesCopied());
+}
+
+TEST(FileCopierTest, AccumulatesTotalAcrossFiles) {
+    unittest::TempDir source("fileCopierSource");
+    unittest::TempDir destination("fileCopierDestination");
+
+    writeFile(boost::filesystem::path(source.path()) / "a.wt", "aaaa");
+    writeFile(boost::filesystem::path(source.path()) / "b.wt", "bb");
+
+    FileCopier copier(source.path(), destination.path());
+    ASSERT_OK(copier.copyFile("a.wt").getStatus());
+    ASSERT_OK(copier.copyFile("b.wt").getStatus());
+    ASSERT_EQUALS(6U, copier.totalBytesCopied());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -50,6 +50,7 @@
 #include "mongo/db/repl/initial_sync_state.h"
 #include "mongo/db/repl/member_state.h"
 #include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/oplog_fetcher.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/replication_consistency_markers.h"
@@ -116,6 +117,12 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncOplogFindAttempts, int, 3);
 // The batchSize to use for the find/getMore queries called by the OplogFetcher
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(initialSyncOplogFetcherBatchSize, int, defaultBatchSize);
 
+// When enabled, buffered oplog entries are applied to collections that have already finished
+// cloning while the remaining collections are still copying, instead of waiting for the entire
+// data cloning phase to complete. This bounds the growth of the oplog buffer on large initial
+// syncs.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncStreamingApplyEnabled, bool, true);
+
 // The number of initial sync attempts that have failed since server startup. Each instance of
 // InitialSyncer may run multiple attempts to fulfill an initial sync request that is triggered
 // when InitialSyncer::startup() is called.
@@ -293,12 +300,14 @@ void InitialSyncer::_cancelRemainingWork_inlock() {
     _cancelHandle_inlock(_getBaseRollbackIdHandle);
     _cancelHandle_inlock(_getLastRollbackIdHandle);
     _cancelHandle_inlock(_getNextApplierBatchHandle);
+    _cancelHandle_inlock(_streamingApplyHandle);
 
     _shutdownComponent_inlock(_oplogFetcher);
     if (_initialSyncState) {
         _shutdownComponent_inlock(_initialSyncState->dbsCloner);
     }
     _shutdownComponent_inlock(_applier);
+    _shutdownComponent_inlock(_streamingApplier);
     _shutdownComponent_inlock(_fCVFetcher);
     _shutdownComponent_inlock(_lastOplogEntryFetcher);
 }
@@ -857,6 +866,21 @@ void InitialSyncer::_fcvFetcherCallback(const StatusWith<Fetcher::QueryResponse>
         onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
         return;
     }
+
+    // While the cloners run, periodically apply buffered oplog entries to the collections that
+    // have already been cloned so that the oplog buffer does not grow without bound.
+    if (initialSyncStreamingApplyEnabled.load()) {
+        auto when = _exec->now() + _opts.getApplierBatchCallbackRetryWait;
+        status = _scheduleWorkAtAndSaveHandle_inlock(
+            when,
+            [=](const CallbackArgs& args) { _streamingApplyCallback(args, onCompletionGuard); },
+            &_streamingApplyHandle,
+            "_streamingApplyCallback");
+        if (!status.isOK()) {
+            onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+            return;
+        }
+    }
 }
 
 void InitialSyncer::_oplogFetcherCallback(const Status& oplogFetcherFinishStatus,
@@ -940,7 +964,8 @@ void InitialSyncer::_lastOplogEntryFetcherCallbackForStopTimestamp(
         _initialSyncState->stopTimestamp = optimeWithHash.opTime.getTimestamp();
 
         if (_initialSyncState->beginTimestamp != _initialSyncState->stopTimestamp) {
-            invariant(_lastApplied.opTime.isNull());
+            // '_lastApplied' may already be non-null if batches were applied during the cloning
+            // phase by _streamingApplyCallback().
             _checkApplierProgressAndScheduleGetNextApplierBatch_inlock(lock, onCompletionGuard);
             return;
         }
@@ -994,6 +1019,21 @@ void InitialSyncer::_getNextApplierBatchCallback(
         return;
     }
 
+    // A batch scheduled by _streamingApplyCallback() during collection cloning may still be in
+    // flight; wait for it to finish so that batches are applied in order.
+    if (_streamingApplier && _streamingApplier->isActive()) {
+        auto when = _exec->now() + _opts.getApplierBatchCallbackRetryWait;
+        status = _scheduleWorkAtAndSaveHandle_inlock(
+            when,
+            [=](const CallbackArgs& args) { _getNextApplierBatchCallback(args, onCompletionGuard); },
+            &_getNextApplierBatchHandle,
+            "_getNextApplierBatchCallback");
+        if (!status.isOK()) {
+            onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+        }
+        return;
+    }
+
     auto batchResult = _getNextApplierBatch_inlock();
     if (!batchResult.isOK()) {
         warning() << "Failure creating next apply batch: " << redact(batchResult.getStatus());
@@ -1095,6 +1135,102 @@ void InitialSyncer::_multiApplierCallback(const Status& multiApplierStatus,
     _checkApplierProgressAndScheduleGetNextApplierBatch_inlock(lock, onCompletionGuard);
 }
 
+void InitialSyncer::_streamingApplyCallback(
+    const executor::TaskExecutor::CallbackArgs& callbackArgs,
+    std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    // Streaming apply is an optimization, so cancellation here must not fail the attempt.
+    if (!callbackArgs.status.isOK() || _isShuttingDown_inlock()) {
+        return;
+    }
+
+    // Once the cloner has finished, the remaining buffered entries belong to the regular apply
+    // phase driven by _getNextApplierBatchCallback().
+    if (!_initialSyncState || !_initialSyncState->dbsCloner ||
+        !_initialSyncState->dbsCloner->isActive()) {
+        return;
+    }
+
+    auto ops = _getStreamingApplierBatch_inlock();
+    if (!ops.empty()) {
+        _fetchCount.store(0);
+        MultiApplier::MultiApplyFn applyBatchOfOperationsFn = [this](OperationContext* opCtx,
+                                                                     MultiApplier::Operations ops) {
+            return _oplogApplier->multiApply(opCtx, std::move(ops));
+        };
+        const auto& lastEntry = ops.back();
+        OpTimeWithHash lastApplied(lastEntry.getHash(), lastEntry.getOpTime());
+        auto numApplied = ops.size();
+        MultiApplier::CallbackFn onCompletionFn = [=](const Status& s) {
+            return _streamingApplierCallback(s, lastApplied, numApplied, onCompletionGuard);
+        };
+
+        _streamingApplier = stdx::make_unique<MultiApplier>(
+            _exec, ops, std::move(applyBatchOfOperationsFn), std::move(onCompletionFn));
+        auto status = _startupComponent_inlock(_streamingApplier);
+        if (!status.isOK()) {
+            // The batch has already been removed from the oplog buffer, so failing to apply it
+            // must fail the attempt.
+            onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+        }
+        return;
+    }
+
+    // Nothing eligible to apply yet; check the oplog buffer again in
+    // '_opts.getApplierBatchCallbackRetryWait' ms.
+    auto when = _exec->now() + _opts.getApplierBatchCallbackRetryWait;
+    auto status = _scheduleWorkAtAndSaveHandle_inlock(
+        when,
+        [=](const CallbackArgs& args) { _streamingApplyCallback(args, onCompletionGuard); },
+        &_streamingApplyHandle,
+        "_streamingApplyCallback");
+    if (!status.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+        return;
+    }
+}
+
+void InitialSyncer::_streamingApplierCallback(const Status& multiApplierStatus,
+                                              OpTimeWithHash lastApplied,
+                                              std::uint32_t numApplied,
+                                              std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    auto status = _checkForShutdownAndConvertStatus_inlock(multiApplierStatus,
+                                                           "error applying batch during cloning");
+    if (!status.isOK()) {
+        error() << "Failed to apply batch during cloning due to '" << redact(status) << "'";
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+        return;
+    }
+
+    _initialSyncState->appliedOps += numApplied;
+    _lastApplied = lastApplied;
+    _opts.setMyLastOptime(_lastApplied.opTime,
+                          ReplicationCoordinator::DataConsistency::Inconsistent);
+
+    // Unlike _multiApplierCallback(), there is no need to refetch the sync source's last oplog
+    // entry when missing documents were fetched during the batch: the stop timestamp has not
+    // been determined yet and will be read from the sync source after cloning completes, which
+    // covers any documents fetched here.
+    auto fetchCount = _fetchCount.load();
+    if (fetchCount > 0) {
+        _initialSyncState->fetchedMissingDocs += fetchCount;
+        _fetchCount.store(0);
+    }
+
+    // Look for the next eligible batch. The callback bails out if cloning has finished by then.
+    auto when = _exec->now() + _opts.getApplierBatchCallbackRetryWait;
+    status = _scheduleWorkAtAndSaveHandle_inlock(
+        when,
+        [=](const CallbackArgs& args) { _streamingApplyCallback(args, onCompletionGuard); },
+        &_streamingApplyHandle,
+        "_streamingApplyCallback");
+    if (!status.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+        return;
+    }
+}
+
 void InitialSyncer::_lastOplogEntryFetcherCallbackAfterFetchingMissingDocuments(
     const StatusWith<Fetcher::QueryResponse>& result,
     std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
@@ -1505,6 +1641,40 @@ StatusWith<Operations> InitialSyncer::_getNextApplierBatch_inlock() {
     return _oplogApplier->getNextApplierBatch(opCtx.get(), batchLimits);
 }
 
+MultiApplier::Operations InitialSyncer::_getStreamingApplierBatch_inlock() {
+    // Respect the same fail-point as the regular apply phase.
+    if (MONGO_FAIL_POINT(rsSyncApplyStop)) {
+        return {};
+    }
+
+    auto opCtx = makeOpCtx();
+    const std::size_t batchLimitOps = OplogApplier::getBatchLimitOperations();
+
+    MultiApplier::Operations ops;
+    std::uint32_t totalBytes = 0;
+    BSONObj op;
+    while (ops.size() < batchLimitOps && totalBytes < OplogApplier::replBatchLimitBytes &&
+           _oplogBuffer->peek(opCtx.get(), &op)) {
+        auto entry = OplogEntry(op);
+
+        // Commands act as barriers and are left for the regular apply phase after cloning
+        // completes, as are operations on collections that are still being cloned. Noops carry
+        // no collection writes and are safe to apply at any time.
+        if (entry.getOpType() != OpTypeEnum::kNoop &&
+            (!entry.isCrudOpType() ||
+             !_initialSyncState->dbsCloner->isCollectionCloned(entry.getNss()))) {
+            break;
+        }
+
+        totalBytes += entry.getRawObjSizeBytes();
+        ops.push_back(std::move(entry));
+
+        BSONObj opToPopAndDiscard;
+        invariant(_oplogBuffer->tryPop(opCtx.get(), &opToPopAndDiscard));
+    }
+    return ops;
+}
+
 StatusWith<HostAndPort> InitialSyncer::_chooseSyncSource_inlock() {
     auto syncSource = _opts.syncSourceSelector->chooseNewSyncSource(_lastFetched.opTime);
     if (syncSource.empty()) {
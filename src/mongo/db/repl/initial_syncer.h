@@ -437,6 +437,24 @@ private:
     void _getNextApplierBatchCallback(const executor::TaskExecutor::CallbackArgs& callbackArgs,
                                       std::shared_ptr<OnCompletionGuard> onCompletionGuard);
 
+    /**
+     * Callback that applies buffered oplog entries to collections that have already been cloned
+     * while the DatabasesCloner is still copying the remaining collections. This keeps the oplog
+     * buffer from growing without bound during long cloning phases. Reschedules itself until
+     * cloning completes; afterwards the remaining buffered operations are drained by
+     * _getNextApplierBatchCallback() as usual.
+     */
+    void _streamingApplyCallback(const executor::TaskExecutor::CallbackArgs& callbackArgs,
+                                 std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Callback for MultiApplier completion for a batch applied during the cloning phase.
+     */
+    void _streamingApplierCallback(const Status& status,
+                                   OpTimeWithHash lastApplied,
+                                   std::uint32_t numApplied,
+                                   std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
     /**
      * Callback for MultiApplier completion.
      */
@@ -494,6 +512,14 @@ private:
 
     StatusWith<MultiApplier::Operations> _getNextApplierBatch_inlock();
 
+    /**
+     * Returns a prefix of the oplog buffer containing only operations that can be applied while
+     * cloning is still in progress: CRUD operations on collections that have already been fully
+     * cloned, and noops. Stops at the first command or the first operation on a collection that
+     * has not finished cloning. The returned operations are removed from the oplog buffer.
+     */
+    MultiApplier::Operations _getStreamingApplierBatch_inlock();
+
     /**
      * Schedules a fetcher to get the last oplog entry from the sync source.
      */
@@ -612,11 +638,15 @@ private:
     // Handle to currently scheduled _getNextApplierBatchCallback() task.
     executor::TaskExecutor::CallbackHandle _getNextApplierBatchHandle;  // (M)
 
+    // Handle to currently scheduled _streamingApplyCallback() task.
+    executor::TaskExecutor::CallbackHandle _streamingApplyHandle;  // (M)
+
     std::unique_ptr<InitialSyncState> _initialSyncState;  // (M)
     std::unique_ptr<OplogFetcher> _oplogFetcher;          // (S)
     std::unique_ptr<Fetcher> _lastOplogEntryFetcher;      // (S)
     std::unique_ptr<Fetcher> _fCVFetcher;                 // (S)
     std::unique_ptr<MultiApplier> _applier;               // (M)
+    std::unique_ptr<MultiApplier> _streamingApplier;      // (M) applies batches during cloning.
     HostAndPort _syncSource;                              // (M)
     OpTimeWithHash _lastFetched;                          // (MX)
     OpTimeWithHash _lastApplied;                          // (MX)
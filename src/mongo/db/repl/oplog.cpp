@@ -317,11 +317,13 @@ void appendSessionInfo(OperationContext* opCtx,
     }
 }
 
-OplogDocWriter _logOpWriter(OperationContext* opCtx,
+/**
+ * Appends the frame of an oplog entry (everything except the 'o' field) to 'b'.
+ */
+void _appendOplogEntryFrame(OperationContext* opCtx,
                             const char* opstr,
                             const NamespaceString& nss,
                             OptionalCollectionUUID uuid,
-                            const BSONObj& obj,
                             const BSONObj* o2,
                             bool fromMigrate,
                             OpTime optime,
@@ -330,33 +332,64 @@ OplogDocWriter _logOpWriter(OperationContext* opCtx,
                             const OperationSessionInfo& sessionInfo,
                             StmtId statementId,
                             const OplogLink& oplogLink,
-                            bool prepare) {
-    BSONObjBuilder b(256);
-
-    b.append("ts", optime.getTimestamp());
+                            bool prepare,
+                            BSONObjBuilder* b) {
+    b->append("ts", optime.getTimestamp());
     if (optime.getTerm() != -1)
-        b.append("t", optime.getTerm());
-    b.append("h", hashNew);
-    b.append("v", OplogEntry::kOplogVersion);
-    b.append("op", opstr);
-    b.append("ns", nss.ns());
+        b->append("t", optime.getTerm());
+    b->append("h", hashNew);
+    b->append("v", OplogEntry::kOplogVersion);
+    b->append("op", opstr);
+    b->append("ns", nss.ns());
     if (uuid)
-        uuid->appendToBuilder(&b, "ui");
+        uuid->appendToBuilder(b, "ui");
 
     if (fromMigrate)
-        b.appendBool("fromMigrate", true);
+        b->appendBool("fromMigrate", true);
 
     if (o2)
-        b.append("o2", *o2);
+        b->append("o2", *o2);
 
     invariant(wallTime != Date_t{});
-    b.appendDate("wall", wallTime);
+    b->appendDate("wall", wallTime);
 
-    appendSessionInfo(opCtx, &b, statementId, sessionInfo, oplogLink);
+    appendSessionInfo(opCtx, b, statementId, sessionInfo, oplogLink);
 
     if (prepare) {
-        b.appendBool(OplogEntryBase::kPrepareFieldName, true);
+        b->appendBool(OplogEntryBase::kPrepareFieldName, true);
     }
+}
+
+OplogDocWriter _logOpWriter(OperationContext* opCtx,
+                            const char* opstr,
+                            const NamespaceString& nss,
+                            OptionalCollectionUUID uuid,
+                            const BSONObj& obj,
+                            const BSONObj* o2,
+                            bool fromMigrate,
+                            OpTime optime,
+                            long long hashNew,
+                            Date_t wallTime,
+                            const OperationSessionInfo& sessionInfo,
+                            StmtId statementId,
+                            const OplogLink& oplogLink,
+                            bool prepare) {
+    BSONObjBuilder b(256);
+
+    _appendOplogEntryFrame(opCtx,
+                           opstr,
+                           nss,
+                           uuid,
+                           o2,
+                           fromMigrate,
+                           optime,
+                           hashNew,
+                           wallTime,
+                           sessionInfo,
+                           statementId,
+                           oplogLink,
+                           prepare,
+                           &b);
 
     return OplogDocWriter(OplogDocWriter(b.obj(), obj));
 }
@@ -540,36 +573,70 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
         oplogLink.prevOpTime = session->getLastWriteOpTime(*opCtx->getTxnNumber());
     }
 
+    // Serialize the frames (everything except the 'o' field) of all entries in the batch
+    // back-to-back into one preallocated buffer instead of building each entry with its own
+    // heap-backed builder. Offsets are recorded while the buffer grows because it may
+    // reallocate; the frame objects are materialized once it has reached its final size. The
+    // 'o' fields are not copied here because insertDocumentsForOplog() streams each DocWriter
+    // directly into the record store's buffer.
+    BufBuilder frameArena(count * 256);
+    std::vector<int> frameOffsets;
+    frameOffsets.reserve(count);
+
+    // Reserve optimes for the whole batch up front. In the common case no statement carries a
+    // pre-assigned slot, so the batch needs just one pass through the optime critical section
+    // instead of one per document.
+    std::vector<OplogSlot> slots(count);
+    bool allSlotsUnassigned = true;
+    for (size_t i = 0; i < count; i++) {
+        slots[i] = begin[i].oplogSlot;
+        allSlotsUnassigned = allSlotsUnassigned && slots[i].opTime.isNull();
+    }
+    if (allSlotsUnassigned) {
+        _getNextOpTimes(opCtx, oplog, count, slots.data());
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            if (slots[i].opTime.isNull()) {
+                _getNextOpTimes(opCtx, oplog, 1, &slots[i]);
+            }
+        }
+    }
+
     auto timestamps = stdx::make_unique<Timestamp[]>(count);
     std::vector<OpTime> opTimes;
     for (size_t i = 0; i < count; i++) {
-        // Make a mutable copy.
-        auto insertStatementOplogSlot = begin[i].oplogSlot;
-        // Fetch optime now, if not already fetched.
-        if (insertStatementOplogSlot.opTime.isNull()) {
-            _getNextOpTimes(opCtx, oplog, 1, &insertStatementOplogSlot);
-        }
+        const auto& insertStatementOplogSlot = slots[i];
         // Only 'applyOps' oplog entries can be prepared.
         constexpr bool prepare = false;
-        writers.emplace_back(_logOpWriter(opCtx,
-                                          "i",
-                                          nss,
-                                          uuid,
-                                          begin[i].doc,
-                                          NULL,
-                                          fromMigrate,
-                                          insertStatementOplogSlot.opTime,
-                                          insertStatementOplogSlot.hash,
-                                          wallClockTime,
-                                          sessionInfo,
-                                          begin[i].stmtId,
-                                          oplogLink,
-                                          prepare));
+        frameOffsets.push_back(frameArena.len());
+        {
+            BSONObjBuilder frameBob(frameArena);
+            _appendOplogEntryFrame(opCtx,
+                                   "i",
+                                   nss,
+                                   uuid,
+                                   NULL,
+                                   fromMigrate,
+                                   insertStatementOplogSlot.opTime,
+                                   insertStatementOplogSlot.hash,
+                                   wallClockTime,
+                                   sessionInfo,
+                                   begin[i].stmtId,
+                                   oplogLink,
+                                   prepare,
+                                   &frameBob);
+            frameBob.doneFast();
+        }
         oplogLink.prevOpTime = insertStatementOplogSlot.opTime;
         timestamps[i] = oplogLink.prevOpTime.getTimestamp();
         opTimes.push_back(insertStatementOplogSlot.opTime);
     }
 
+    for (size_t i = 0; i < count; i++) {
+        writers.emplace_back(
+            OplogDocWriter(BSONObj(frameArena.buf() + frameOffsets[i]), begin[i].doc));
+    }
+
     MONGO_FAIL_POINT_BLOCK(sleepBetweenInsertOpTimeGenerationAndLogOp, customWait) {
         const BSONObj& data = customWait.getData();
         auto numMillis = data["waitForMillis"].numberInt();
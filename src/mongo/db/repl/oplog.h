@@ -69,6 +69,12 @@ public:
 
     StmtId stmtId = kUninitializedStmtId;
     OplogSlot oplogSlot;
+
+    // May be an unowned view into the request's Message buffer. This is safe because the message
+    // stays pinned for the duration of the operation and the record store copies the payload into
+    // its own cache on insert; it also means the write path never needs to take ownership of the
+    // incoming document bytes. Callers that stash an InsertStatement beyond the lifetime of the
+    // request must call doc.getOwned() themselves.
     BSONObj doc;
 };
 
@@ -0,0 +1,232 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_ring.h"
+
+#include <algorithm>
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+// Limit buffer to 256MB, matching OplogBufferBlockingQueue.
+const std::size_t kOplogBufferSize = 256 * 1024 * 1024;
+
+// Default number of entry slots. At the byte budget above this leaves room for entries down to
+// an average of 2KB; below that the producer waits briefly for a slot, at which point the buffer
+// already holds far more entries than the applier drains in one batch.
+const std::size_t kDefaultCapacity = 128 * 1024;
+
+std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+std::size_t getDocumentSize(const BSONObj& o) {
+    // SERVER-9808 Avoid Fortify complaint about implicit signed->unsigned conversion
+    return static_cast<std::size_t>(o.objsize());
+}
+
+}  // namespace
+
+OplogBufferRing::OplogBufferRing() : OplogBufferRing(nullptr) {}
+OplogBufferRing::OplogBufferRing(Counters* counters)
+    : OplogBufferRing(counters, kDefaultCapacity) {}
+OplogBufferRing::OplogBufferRing(Counters* counters, std::size_t capacity)
+    : _counters(counters),
+      _capacityMask(roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2)) - 1),
+      _ring(_capacityMask + 1) {}
+
+void OplogBufferRing::startup(OperationContext*) {
+    // Update server status metric to reflect the current oplog buffer's max size.
+    if (_counters) {
+        _counters->setMaxSize(getMaxSize());
+    }
+}
+
+void OplogBufferRing::shutdown(OperationContext* opCtx) {
+    clear(opCtx);
+}
+
+void OplogBufferRing::pushEvenIfFull(OperationContext*, const Value& value) {
+    _pushOne(value);
+    _notifyConsumer();
+}
+
+void OplogBufferRing::push(OperationContext* opCtx, const Value& value) {
+    waitForSpace(opCtx, getDocumentSize(value));
+    _pushOne(value);
+    _notifyConsumer();
+}
+
+void OplogBufferRing::pushAllNonBlocking(OperationContext*,
+                                         Batch::const_iterator begin,
+                                         Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+    for (auto i = begin; i != end; ++i) {
+        _pushOne(*i);
+    }
+    _notifyConsumer();
+}
+
+void OplogBufferRing::waitForSpace(OperationContext*, std::size_t size) {
+    while (_size.load() + size > getMaxSize()) {
+        stdx::unique_lock<stdx::mutex> lk(_waitMutex);
+        _producerWaiting.store(true);
+        // Re-check under the mutex; the consumer notifies while holding it, so a pop between
+        // the check above and this one cannot be missed.
+        if (_size.load() + size > getMaxSize()) {
+            _waitCondition.wait(lk);
+        }
+        _producerWaiting.store(false);
+    }
+}
+
+bool OplogBufferRing::isEmpty() const {
+    return _count() == 0;
+}
+
+std::size_t OplogBufferRing::getMaxSize() const {
+    return kOplogBufferSize;
+}
+
+std::size_t OplogBufferRing::getSize() const {
+    return _size.load();
+}
+
+std::size_t OplogBufferRing::getCount() const {
+    return _count();
+}
+
+void OplogBufferRing::clear(OperationContext*) {
+    // May not run concurrently with any push or pop; see the class comment.
+    const auto tail = _tail.load();
+    for (auto head = _head.load(); head != tail; ++head) {
+        _ring[head & _capacityMask] = Value();
+    }
+    _head.store(tail);
+    _size.store(0);
+    if (_counters) {
+        _counters->clear();
+    }
+    _notifyProducer();
+}
+
+bool OplogBufferRing::tryPop(OperationContext*, Value* value) {
+    const auto head = _head.load();
+    if (head == _tail.load()) {
+        return false;
+    }
+    auto& slot = _ring[head & _capacityMask];
+    *value = std::move(slot);
+    slot = Value();
+    _size.fetchAndSubtract(getDocumentSize(*value));
+    _head.store(head + 1);  // Returns the slot to the producer.
+    if (_counters) {
+        _counters->decrement(*value);
+    }
+    _notifyProducer();
+    return true;
+}
+
+bool OplogBufferRing::waitForData(Seconds waitDuration) {
+    if (_count() > 0) {
+        return true;
+    }
+    stdx::unique_lock<stdx::mutex> lk(_waitMutex);
+    _consumerWaiting.store(true);
+    // The producer notifies while holding _waitMutex whenever it observes _consumerWaiting, so
+    // a push between setting the flag and sleeping cannot be missed.
+    bool result = _waitCondition.wait_for(
+        lk, waitDuration.toSystemDuration(), [this]() { return _count() > 0; });
+    _consumerWaiting.store(false);
+    return result;
+}
+
+bool OplogBufferRing::peek(OperationContext*, Value* value) {
+    const auto head = _head.load();
+    if (head == _tail.load()) {
+        return false;
+    }
+    *value = _ring[head & _capacityMask];
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferRing::lastObjectPushed(OperationContext*) const {
+    // Only legal on the pushing thread; see the class comment.
+    if (_count() == 0) {
+        return boost::none;
+    }
+    return _lastPushed;
+}
+
+void OplogBufferRing::_pushOne(const Value& value) {
+    const auto tail = _tail.load();
+    // Wait for a free slot; only the consumer can return one. This can only happen once the
+    // entry count exceeds the slot count, i.e. when the buffer is far beyond any batch size.
+    while (tail - _head.load() > _capacityMask) {
+        stdx::unique_lock<stdx::mutex> lk(_waitMutex);
+        _producerWaiting.store(true);
+        if (tail - _head.load() > _capacityMask) {
+            _waitCondition.wait(lk);
+        }
+        _producerWaiting.store(false);
+    }
+    _ring[tail & _capacityMask] = value;
+    _lastPushed = value;
+    _size.fetchAndAdd(getDocumentSize(value));
+    _tail.store(tail + 1);  // Publishes the slot to the consumer.
+    if (_counters) {
+        _counters->increment(value);
+    }
+}
+
+void OplogBufferRing::_notifyConsumer() {
+    if (_consumerWaiting.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_waitMutex);
+        _waitCondition.notify_all();
+    }
+}
+
+void OplogBufferRing::_notifyProducer() {
+    if (_producerWaiting.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_waitMutex);
+        _waitCondition.notify_all();
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer backed by a bounded lock-free single-producer/single-consumer ring of BSONObj.
+ *
+ * Pushes and pops on the hot path synchronize solely through the atomic head and tail indexes,
+ * so the fetcher and the applier never take a mutex while the buffer is neither empty nor full.
+ * A mutex and condition variable exist only to put a thread to sleep when it must block (the
+ * consumer waiting for data, the producer waiting for space); the other side takes that mutex
+ * only when it observes a sleeper.
+ *
+ * Like all OplogBuffer implementations this supports exactly one pusher and one popper.
+ * Additionally, lastObjectPushed() may only be called from the pushing thread, and clear() may
+ * not run concurrently with any push or pop.
+ */
+class OplogBufferRing final : public OplogBuffer {
+public:
+    OplogBufferRing();
+    explicit OplogBufferRing(Counters* counters);
+
+    /**
+     * 'capacity' is the number of entry slots in the ring, rounded up to a power of two. The
+     * default is large enough that the byte budget returned by getMaxSize() is reached before
+     * the slots run out for all but pathologically small entries. Exposed for testing.
+     */
+    OplogBufferRing(Counters* counters, std::size_t capacity);
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void pushEvenIfFull(OperationContext* opCtx, const Value& value) override;
+    void push(OperationContext* opCtx, const Value& value) override;
+    void pushAllNonBlocking(OperationContext* opCtx,
+                            Batch::const_iterator begin,
+                            Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+private:
+    /**
+     * Writes 'value' into the slot at the tail and publishes it to the consumer, waiting for a
+     * free slot first if the ring is full. Does not wake a sleeping consumer; callers notify
+     * once per push or batch.
+     */
+    void _pushOne(const Value& value);
+
+    /**
+     * Wakes the consumer (producer) if it has advertised that it is sleeping. Taken together
+     * with re-checking the indexes under _waitMutex before sleeping, this cannot lose a wakeup.
+     */
+    void _notifyConsumer();
+    void _notifyProducer();
+
+    std::size_t _count() const {
+        return static_cast<std::size_t>(_tail.load() - _head.load());
+    }
+
+    Counters* const _counters;        // (S)
+    const std::size_t _capacityMask;  // (R) Slot count minus one; the slot count is a power of
+                                      // two so the mask maps an index to its slot.
+    std::vector<Value> _ring;         // Slot i of index pos is _ring[pos & _capacityMask]. A slot
+                                      // is owned by the producer for indexes in [_tail, _head +
+                                      // slot count) and by the consumer for indexes in [_head,
+                                      // _tail).
+
+    // Indexes increase monotonically; _head is advanced only by the consumer and _tail only by
+    // the producer. Storing _tail publishes the pushed slot; storing _head returns it.
+    AtomicUInt64 _head;
+    AtomicUInt64 _tail;
+
+    AtomicUInt64 _size;  // (S) Total bytes currently buffered, as measured by objsize().
+
+    Value _lastPushed;  // Owned by the producer.
+
+    // Sleep/wake machinery for the blocking operations; never taken on the uncontended path.
+    mutable stdx::mutex _waitMutex;
+    mutable stdx::condition_variable _waitCondition;
+    AtomicBool _consumerWaiting;
+    AtomicBool _producerWaiting;
+};
+
+}  // namespace repl
+}  // namespace mongo
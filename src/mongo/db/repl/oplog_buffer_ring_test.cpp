@@ -0,0 +1,162 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <boost/optional/optional_io.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_ring.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+BSONObj makeEntry(int i) {
+    return BSON("_id" << i);
+}
+
+TEST(OplogBufferRingTest, PopsEntriesInPushOrder) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+    for (int i = 0; i < 10; i++) {
+        buffer.push(nullptr, makeEntry(i));
+    }
+    ASSERT_EQUALS(10U, buffer.getCount());
+    for (int i = 0; i < 10; i++) {
+        BSONObj doc;
+        ASSERT_TRUE(buffer.tryPop(nullptr, &doc));
+        ASSERT_BSONOBJ_EQ(makeEntry(i), doc);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+    BSONObj doc;
+    ASSERT_FALSE(buffer.tryPop(nullptr, &doc));
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, WrapsAroundWhenIndexesExceedCapacity) {
+    // Capacity of four slots; push/pop more entries than that so the indexes wrap.
+    OplogBufferRing buffer(nullptr, 4U);
+    buffer.startup(nullptr);
+    for (int i = 0; i < 100; i++) {
+        buffer.push(nullptr, makeEntry(i));
+        BSONObj doc;
+        ASSERT_TRUE(buffer.tryPop(nullptr, &doc));
+        ASSERT_BSONOBJ_EQ(makeEntry(i), doc);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, PeekReturnsOldestEntryWithoutRemovingIt) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+    BSONObj doc;
+    ASSERT_FALSE(buffer.peek(nullptr, &doc));
+    buffer.push(nullptr, makeEntry(1));
+    buffer.push(nullptr, makeEntry(2));
+    ASSERT_TRUE(buffer.peek(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeEntry(1), doc);
+    ASSERT_EQUALS(2U, buffer.getCount());
+    ASSERT_TRUE(buffer.tryPop(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeEntry(1), doc);
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, SizeAndCountTrackPushesAndPops) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+    auto entry = makeEntry(1);
+    OplogBuffer::Batch batch{entry, entry, entry};
+    buffer.pushAllNonBlocking(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_EQUALS(3U, buffer.getCount());
+    ASSERT_EQUALS(std::size_t(entry.objsize()) * 3, buffer.getSize());
+    BSONObj doc;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &doc));
+    ASSERT_EQUALS(2U, buffer.getCount());
+    ASSERT_EQUALS(std::size_t(entry.objsize()) * 2, buffer.getSize());
+    buffer.clear(nullptr);
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_TRUE(buffer.isEmpty());
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, LastObjectPushedReturnsNoneWhenEmpty) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+    ASSERT_EQUALS(boost::none, buffer.lastObjectPushed(nullptr));
+    buffer.push(nullptr, makeEntry(1));
+    buffer.push(nullptr, makeEntry(2));
+    auto last = buffer.lastObjectPushed(nullptr);
+    ASSERT_TRUE(last);
+    ASSERT_BSONOBJ_EQ(makeEntry(2), *last);
+    BSONObj doc;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &doc));
+    ASSERT_TRUE(buffer.tryPop(nullptr, &doc));
+    ASSERT_EQUALS(boost::none, buffer.lastObjectPushed(nullptr));
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, WaitForDataReturnsFalseWhenBufferStaysEmpty) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+    buffer.pushEvenIfFull(nullptr, makeEntry(1));
+    ASSERT_TRUE(buffer.waitForData(Seconds(0)));
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, ConcurrentProducerAndConsumerTransferAllEntriesInOrder) {
+    // A small slot count forces the producer to wait for the consumer repeatedly, exercising
+    // both the lock-free fast path and the sleep/wake slow path.
+    OplogBufferRing buffer(nullptr, 8U);
+    buffer.startup(nullptr);
+    const int kNumEntries = 10000;
+    stdx::thread producer([&]() {
+        for (int i = 0; i < kNumEntries; i++) {
+            buffer.push(nullptr, makeEntry(i));
+        }
+    });
+    for (int i = 0; i < kNumEntries; i++) {
+        BSONObj doc;
+        while (!buffer.tryPop(nullptr, &doc)) {
+            buffer.waitForData(Seconds(1));
+        }
+        ASSERT_BSONOBJ_EQ(makeEntry(i), doc);
+    }
+    producer.join();
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    buffer.shutdown(nullptr);
+}
+
+}  // namespace
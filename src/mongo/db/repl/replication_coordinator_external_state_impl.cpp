@@ -65,6 +65,7 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_ring.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
@@ -147,6 +148,10 @@ MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherInitialSyncMaxFetcherRestarts, int, 10
         return Status::OK();
     });
 
+// Set this to back the steady state oplog buffer with a lock-free ring instead of the mutex
+// guarded blocking queue, removing fetcher/applier contention on the buffer handoff.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(useLockFreeOplogBuffer, bool, false);
+
 // The count of items in the buffer
 OplogBuffer::Counters bufferGauge;
 ServerStatusMetricField<Counter64> displayBufferCount("repl.buffer.count", &bufferGauge.count);
@@ -240,10 +245,14 @@ void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
         return;
 
     invariant(replCoord);
-    _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    if (useLockFreeOplogBuffer) {
+        _oplogBuffer = std::make_unique<OplogBufferRing>(&bufferGauge);
+    } else {
+        _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    }
 
-    // No need to log OplogBuffer::startup because the blocking queue implementation
-    // does not start any threads or access the storage layer.
+    // No need to log OplogBuffer::startup because neither in-memory implementation
+    // starts any threads or accesses the storage layer.
     _oplogBuffer->startup(opCtx);
 
     invariant(!_oplogApplier);
@@ -254,57 +254,51 @@ private:
 };
 
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(WaiterType waiter) {
-    _list.push_back(waiter);
+    _waiters.emplace(waiter->opTime, waiter);
 }
 
-void ReplicationCoordinatorImpl::WaiterList::signalIf_inlock(
-    stdx::function<bool(WaiterType)> func) {
-    for (auto it = _list.begin(); it != _list.end();) {
-        if (!func(*it)) {
+void ReplicationCoordinatorImpl::WaiterList::signalUpTo_inlock(
+    const OpTime& opTimeBound, stdx::function<bool(WaiterType)> func) {
+    // The map is ordered by target optime, so the walk stops at the first waiter beyond the
+    // bound without examining the rest.
+    for (auto it = _waiters.begin(); it != _waiters.end() && it->first <= opTimeBound;) {
+        WaiterType waiter = it->second;
+        if (!func(waiter)) {
             // This element doesn't match, so we advance the iterator to the next one.
             ++it;
             continue;
         }
 
-        if (!(*it)->runs_once()) {
-            (*it)->notify_inlock();
+        if (!waiter->runs_once()) {
+            waiter->notify_inlock();
             // Keep the waiter on the list and let the guard remove it instead. Advance the
             // iterator since we are skipping the removal.
             ++it;
             continue;
         }
 
-        // Remove the waiter from the list if it was only meant to be notified once.
-        WaiterType waiter = std::move(*it);
-
-        if (it == std::prev(_list.end())) {
-            // Iterator will be invalid after erasing the last element, so set it to the
-            // next one (i.e. end()).
-            it = _list.erase(it);
-        } else {
-            // Iterator is still valid after pop_back().
-            std::swap(*it, _list.back());
-            _list.pop_back();
-        }
-        // It's important to call notify() after the waiter has been removed from the list
-        // since notify() might remove the waiter itself.
+        // Remove the waiter from the list if it was only meant to be notified once. It's
+        // important to call notify() after the waiter has been removed from the list since
+        // notify() might remove the waiter itself.
+        it = _waiters.erase(it);
         waiter->notify_inlock();
     }
 }
 
 
 void ReplicationCoordinatorImpl::WaiterList::signalAll_inlock() {
-    this->signalIf_inlock([](Waiter* waiter) { return true; });
+    this->signalUpTo_inlock(OpTime::max(), [](Waiter* waiter) { return true; });
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(WaiterType waiter) {
-    auto it = std::find(_list.begin(), _list.end(), waiter);
-    if (it == _list.end()) {
-        return false;
+    auto range = _waiters.equal_range(waiter->opTime);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == waiter) {
+            _waiters.erase(it);
+            return true;
+        }
     }
-    std::swap(*it, _list.back());
-    _list.pop_back();
-    return true;
+    return false;
 }
 
 namespace {
@@ -340,12 +334,14 @@ ReplicationCoordinatorImpl::ReplicationCoordinatorImpl(
     std::unique_ptr<TopologyCoordinator> topCoord,
     ReplicationProcess* replicationProcess,
     StorageInterface* storage,
-    int64_t prngSeed)
+    int64_t prngSeed,
+    std::unique_ptr<executor::TaskExecutor> heartbeatExecutor)
     : _service(service),
       _settings(settings),
       _replMode(getReplicationModeFromSettings(settings)),
       _topCoord(std::move(topCoord)),
       _replExecutor(std::move(executor)),
+      _heartbeatExecutor(std::move(heartbeatExecutor)),
       _externalState(std::move(externalState)),
       _inShutdown(false),
       _memberState(MemberState::RS_STARTUP),
@@ -790,6 +786,9 @@ void ReplicationCoordinatorImpl::startup(OperationContext* opCtx) {
     }
 
     _replExecutor->startup();
+    if (_heartbeatExecutor) {
+        _heartbeatExecutor->startup();
+    }
 
     bool doneLoadingConfig = _startLoadLocalConfig(opCtx);
     if (doneLoadingConfig) {
@@ -850,8 +849,14 @@ void ReplicationCoordinatorImpl::shutdown(OperationContext* opCtx) {
         initialSyncerCopy.reset();
     }
     _externalState->shutdown(opCtx);
+    if (_heartbeatExecutor) {
+        _heartbeatExecutor->shutdown();
+    }
     _replExecutor->shutdown();
     _replExecutor->join();
+    if (_heartbeatExecutor) {
+        _heartbeatExecutor->join();
+    }
 }
 
 const ReplSettings& ReplicationCoordinatorImpl::getSettings() const {
@@ -1133,8 +1138,7 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTime_inlock(const OpTime& op
     }
 
     // Signal anyone waiting on optime changes.
-    _opTimeWaiterList.signalIf_inlock(
-        [opTime](Waiter* waiter) { return waiter->opTime <= opTime; });
+    _opTimeWaiterList.signalUpTo_inlock(opTime, [](Waiter* waiter) { return true; });
 
     if (opTime.isNull()) {
         return;
@@ -2834,9 +2838,14 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig_inlock(OperationContext* opCtx,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters_inlock() {
-    _replicationWaiterList.signalIf_inlock([this](Waiter* waiter) {
-        return _doneWaitingForReplication_inlock(waiter->opTime, *waiter->writeConcern);
-    });
+    // No waiter targeting an optime beyond the latest replication progress reported by any node
+    // can be satisfied, whatever its write concern, so only the prefix of the optime-ordered
+    // list up to that bound has to be checked. Waiters whose write concerns have become
+    // unsatisfiable are woken by signalAll_inlock() when the config changes.
+    _replicationWaiterList.signalUpTo_inlock(
+        _topCoord->latestKnownAppliedOpTime(), [this](Waiter* waiter) {
+            return _doneWaitingForReplication_inlock(waiter->opTime, *waiter->writeConcern);
+        });
 }
 
 Status ReplicationCoordinatorImpl::processReplSetUpdatePosition(const UpdatePositionArgs& updates,
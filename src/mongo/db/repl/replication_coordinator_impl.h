@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -85,6 +86,11 @@ class ReplicationCoordinatorImpl : public ReplicationCoordinator {
     MONGO_DISALLOW_COPYING(ReplicationCoordinatorImpl);
 
 public:
+    /**
+     * 'heartbeatExecutor' optionally supplies a dedicated executor for heartbeat traffic so
+     * that queue delay from bulk replication tasks on 'executor' cannot inflate perceived
+     * heartbeat round trip times. When null, heartbeats share 'executor'.
+     */
     ReplicationCoordinatorImpl(ServiceContext* serviceContext,
                                const ReplSettings& settings,
                                std::unique_ptr<ReplicationCoordinatorExternalState> externalState,
@@ -92,7 +98,8 @@ public:
                                std::unique_ptr<TopologyCoordinator> topoCoord,
                                ReplicationProcess* replicationProcess,
                                StorageInterface* storage,
-                               int64_t prngSeed);
+                               int64_t prngSeed,
+                               std::unique_ptr<executor::TaskExecutor> heartbeatExecutor = nullptr);
 
     virtual ~ReplicationCoordinatorImpl();
 
@@ -491,6 +498,9 @@ private:
 
     class WaiterGuard;
 
+    // Waiters are kept ordered by their target optime so that advancing replication progress
+    // only has to examine the prefix of waiters whose optimes the progress could have satisfied,
+    // rather than scanning every waiter on each advance.
     class WaiterList {
     public:
         using WaiterType = Waiter*;
@@ -499,13 +509,14 @@ private:
         void add_inlock(WaiterType waiter);
         // Returns whether waiter is found and removed.
         bool remove_inlock(WaiterType waiter);
-        // Signals all waiters that satisfy the condition.
-        void signalIf_inlock(stdx::function<bool(WaiterType)> fun);
+        // Signals all waiters with a target optime at or below 'opTimeBound' that satisfy the
+        // condition. Waiters beyond the bound are not examined.
+        void signalUpTo_inlock(const OpTime& opTimeBound, stdx::function<bool(WaiterType)> fun);
         // Signals all waiters from the list.
         void signalAll_inlock();
 
     private:
-        std::vector<WaiterType> _list;
+        std::multimap<OpTime, WaiterType> _waiters;
     };
 
     typedef std::vector<executor::TaskExecutor::CallbackHandle> HeartbeatHandles;
@@ -677,6 +688,13 @@ private:
 
     void _untrackHeartbeatHandle_inlock(const executor::TaskExecutor::CallbackHandle& handle);
 
+    /**
+     * Returns the executor heartbeat work is scheduled on: the dedicated heartbeat executor
+     * when one was supplied at construction, otherwise _replExecutor. All handles in
+     * _heartbeatHandles belong to this executor.
+     */
+    executor::TaskExecutor* _getHeartbeatExecutor();
+
     /*
      * Return a randomized offset amount that is scaled in proportion to the size of the
      * _electionTimeoutPeriod. Used to add randomization to an election timeout.
@@ -1130,6 +1148,10 @@ private:
     // Executor that drives the topology coordinator.
     std::unique_ptr<executor::TaskExecutor> _replExecutor;  // (S)
 
+    // Optional dedicated executor for heartbeat traffic; null when heartbeats share
+    // _replExecutor. See _getHeartbeatExecutor().
+    std::unique_ptr<executor::TaskExecutor> _heartbeatExecutor;  // (S)
+
     // Pointer to the ReplicationCoordinatorExternalState owned by this ReplicationCoordinator.
     std::unique_ptr<ReplicationCoordinatorExternalState> _externalState;  // (PS)
 
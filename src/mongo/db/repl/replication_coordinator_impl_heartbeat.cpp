@@ -112,7 +112,7 @@ void ReplicationCoordinatorImpl::_doMemberHeartbeat(executor::TaskExecutor::Call
 
     LOG_FOR_HEARTBEATS(2) << "Sending heartbeat (requestId: " << request.id << ") to " << target
                           << ", " << heartbeatObj;
-    _trackHeartbeatHandle_inlock(_replExecutor->scheduleRemoteCommand(request, callback));
+    _trackHeartbeatHandle_inlock(_getHeartbeatExecutor()->scheduleRemoteCommand(request, callback));
 }
 
 void ReplicationCoordinatorImpl::_scheduleHeartbeatToTarget_inlock(const HostAndPort& target,
@@ -120,7 +120,7 @@ void ReplicationCoordinatorImpl::_scheduleHeartbeatToTarget_inlock(const HostAnd
                                                                    Date_t when) {
     LOG_FOR_HEARTBEATS(2) << "Scheduling heartbeat to " << target << " at "
                           << dateToISOStringUTC(when);
-    _trackHeartbeatHandle_inlock(_replExecutor->scheduleWorkAt(
+    _trackHeartbeatHandle_inlock(_getHeartbeatExecutor()->scheduleWorkAt(
         when, [=](const executor::TaskExecutor::CallbackArgs& cbData) {
             _doMemberHeartbeat(cbData, target, targetIndex);
         }));
@@ -624,6 +624,10 @@ void ReplicationCoordinatorImpl::_trackHeartbeatHandle_inlock(
     _heartbeatHandles.push_back(handle.getValue());
 }
 
+executor::TaskExecutor* ReplicationCoordinatorImpl::_getHeartbeatExecutor() {
+    return _heartbeatExecutor ? _heartbeatExecutor.get() : _replExecutor.get();
+}
+
 void ReplicationCoordinatorImpl::_untrackHeartbeatHandle_inlock(
     const executor::TaskExecutor::CallbackHandle& handle) {
     const HeartbeatHandles::iterator newEnd =
@@ -636,7 +640,7 @@ void ReplicationCoordinatorImpl::_cancelHeartbeats_inlock() {
     LOG_FOR_HEARTBEATS(2) << "Cancelling all heartbeats.";
 
     for (const auto& handle : _heartbeatHandles) {
-        _replExecutor->cancel(handle);
+        _getHeartbeatExecutor()->cancel(handle);
     }
     // Heartbeat callbacks will remove themselves from _heartbeatHandles when they execute with
     // CallbackCanceled status, so it's better to leave the handles in the list, for now.
@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2018 MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/repl/session_update_tracker.h"
+#include "mongo/db/session_txn_record_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const NamespaceString kNss("test.foo");
+
+/**
+ * Creates an OplogEntry with the given optime and session info and preset defaults for this
+ * test suite.
+ */
+OplogEntry makeOplogEntry(const NamespaceString& ns,
+                          OpTime opTime,
+                          OpTypeEnum opType,
+                          BSONObj object,
+                          boost::optional<BSONObj> object2,
+                          const OperationSessionInfo& sessionInfo,
+                          Date_t wallClockTime) {
+    return OplogEntry(opTime,         // optime
+                      0,              // hash
+                      opType,         // opType
+                      ns,             // namespace
+                      boost::none,    // uuid
+                      boost::none,    // fromMigrate
+                      0,              // version
+                      object,         // o
+                      object2,        // o2
+                      sessionInfo,    // sessionInfo
+                      boost::none,    // upsert
+                      wallClockTime,  // wall clock time
+                      boost::none,    // statement id
+                      boost::none,    // optime of previous write within same transaction
+                      boost::none,    // pre-image optime
+                      boost::none);   // post-image optime
+}
+
+OperationSessionInfo makeSessionInfo(const LogicalSessionId& lsid, TxnNumber txnNumber) {
+    OperationSessionInfo sessionInfo;
+    sessionInfo.setSessionId(lsid);
+    sessionInfo.setTxnNumber(txnNumber);
+    return sessionInfo;
+}
+
+SessionTxnRecord parseDerivedUpdate(const OplogEntry& entry) {
+    ASSERT_EQUALS(OpTypeEnum::kUpdate, entry.getOpType());
+    ASSERT_EQUALS(NamespaceString::kSessionTransactionsTableNamespace, entry.getNss());
+    return SessionTxnRecord::parse(IDLParserErrorContext("parse derived txn table update"),
+                                   entry.getObject());
+}
+
+TEST(SessionUpdateTrackerTest, FlushAllEmitsOneUpdatePerSessionReflectingTheLatestWrite) {
+    SessionUpdateTracker tracker;
+
+    const auto lsid1 = makeLogicalSessionIdForTest();
+    const auto lsid2 = makeLogicalSessionIdForTest();
+    const auto wallTime = Date_t::now();
+
+    // Three statements for session 1 and one for session 2, as an applier batch would see them.
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(1, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 1),
+                                                      boost::none,
+                                                      makeSessionInfo(lsid1, 3),
+                                                      wallTime)));
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(2, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 2),
+                                                      boost::none,
+                                                      makeSessionInfo(lsid2, 5),
+                                                      wallTime)));
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(3, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 3),
+                                                      boost::none,
+                                                      makeSessionInfo(lsid1, 3),
+                                                      wallTime)));
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(4, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 4),
+                                                      boost::none,
+                                                      makeSessionInfo(lsid1, 4),
+                                                      wallTime)));
+
+    // Each session gets exactly one config.transactions upsert, carrying its latest optime and
+    // txnNumber.
+    auto flushed = tracker.flushAll();
+    ASSERT_EQUALS(2U, flushed.size());
+
+    bool seenSession1 = false;
+    bool seenSession2 = false;
+    for (const auto& entry : flushed) {
+        auto txnRecord = parseDerivedUpdate(entry);
+        if (txnRecord.getSessionId() == lsid1) {
+            seenSession1 = true;
+            ASSERT_EQUALS(4, txnRecord.getTxnNum());
+            ASSERT_EQUALS(OpTime(Timestamp(4, 0), 1), txnRecord.getLastWriteOpTime());
+        } else if (txnRecord.getSessionId() == lsid2) {
+            seenSession2 = true;
+            ASSERT_EQUALS(5, txnRecord.getTxnNum());
+            ASSERT_EQUALS(OpTime(Timestamp(2, 0), 1), txnRecord.getLastWriteOpTime());
+        }
+    }
+    ASSERT_TRUE(seenSession1);
+    ASSERT_TRUE(seenSession2);
+
+    // Flushing leaves nothing behind.
+    ASSERT_TRUE(tracker.flushAll().empty());
+}
+
+TEST(SessionUpdateTrackerTest, WriteToSessionTableFlushesOnlyTheMatchingSession) {
+    SessionUpdateTracker tracker;
+
+    const auto lsid1 = makeLogicalSessionIdForTest();
+    const auto lsid2 = makeLogicalSessionIdForTest();
+    const auto wallTime = Date_t::now();
+
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(1, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 1),
+                                                      boost::none,
+                                                      makeSessionInfo(lsid1, 3),
+                                                      wallTime)));
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(2, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 2),
+                                                      boost::none,
+                                                      makeSessionInfo(lsid2, 5),
+                                                      wallTime)));
+
+    // A delete against config.transactions for session 1 forces its tracked update out ahead of
+    // the delete; session 2 stays buffered until the end of the batch.
+    auto flushed =
+        tracker.updateOrFlush(makeOplogEntry(NamespaceString::kSessionTransactionsTableNamespace,
+                                             OpTime(Timestamp(3, 0), 1),
+                                             OpTypeEnum::kDelete,
+                                             BSON("_id" << lsid1.toBSON()),
+                                             boost::none,
+                                             {},
+                                             wallTime));
+    ASSERT_TRUE(flushed);
+    ASSERT_EQUALS(1U, flushed->size());
+    ASSERT_EQUALS(lsid1, parseDerivedUpdate(flushed->front()).getSessionId());
+
+    auto remaining = tracker.flushAll();
+    ASSERT_EQUALS(1U, remaining.size());
+    ASSERT_EQUALS(lsid2, parseDerivedUpdate(remaining.front()).getSessionId());
+}
+
+TEST(SessionUpdateTrackerTest, EntriesWithoutSessionInfoAreIgnored) {
+    SessionUpdateTracker tracker;
+
+    ASSERT_FALSE(tracker.updateOrFlush(makeOplogEntry(kNss,
+                                                      OpTime(Timestamp(1, 0), 1),
+                                                      OpTypeEnum::kInsert,
+                                                      BSON("_id" << 1),
+                                                      boost::none,
+                                                      {},
+                                                      Date_t::now())));
+    ASSERT_TRUE(tracker.flushAll().empty());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -72,6 +72,7 @@
 #include "mongo/db/session_txn_record_gen.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -354,9 +355,14 @@ void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
               std::vector<Status>* statusVector,
               std::vector<WorkerMultikeyPathInfo>* workerMultikeyPathInfo) {
     invariant(writerVectors.size() == statusVector->size());
+
+    // Hand the entire round to the pool in one scheduleBatch() call, so the pool takes its lock
+    // and wakes its workers once per round rather than once per writer vector.
+    std::vector<ThreadPool::Task> batch;
+    batch.reserve(writerVectors.size());
     for (size_t i = 0; i < writerVectors.size(); i++) {
         if (!writerVectors[i].empty()) {
-            invariant(writerPool->schedule([
+            batch.emplace_back([
                 &func,
                 st,
                 &writer = writerVectors.at(i),
@@ -364,10 +370,16 @@ void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
                 &workerMultikeyPathInfo = workerMultikeyPathInfo->at(i)
             ] {
                 auto opCtx = cc().makeOperationContext();
+
+                // Oplog application is on the critical path for keeping this node in sync, so
+                // draw tickets from the lane reserved for internal operations.
+                opCtx->lockState()->setUsesReservedTickets(true);
+
                 status = func(opCtx.get(), &writer, st, &workerMultikeyPathInfo);
-            }));
+            });
         }
     }
+    invariant(writerPool->scheduleBatch(std::move(batch)));
 }
 
 // Schedules the writes to the oplog for 'ops' into threadPool. The caller must guarantee that 'ops'
@@ -383,6 +395,11 @@ void scheduleWritesToOplog(OperationContext* opCtx,
         // guarantees that 'ops' will stay in scope until the spawned threads complete.
         return [storageInterface, &ops, begin, end] {
             auto opCtx = cc().makeOperationContext();
+
+            // Writing the fetched batch to the oplog is on the critical path for keeping this
+            // node in sync, so draw tickets from the lane reserved for internal operations.
+            opCtx->lockState()->setUsesReservedTickets(true);
+
             UnreplicatedWritesBlock uwb(opCtx.get());
             ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
                 opCtx->lockState());
@@ -421,13 +438,18 @@ void scheduleWritesToOplog(OperationContext* opCtx,
     }
 
 
+    // Enqueue all the ranges with a single scheduleBatch() call, so the handoff to the pool is
+    // one synchronization event for the whole batch instead of one per range.
     const size_t numOplogThreads = threadPool->getStats().numThreads;
     const size_t numOpsPerThread = ops.size() / numOplogThreads;
+    std::vector<ThreadPool::Task> batch;
+    batch.reserve(numOplogThreads);
     for (size_t thread = 0; thread < numOplogThreads; thread++) {
         size_t begin = thread * numOpsPerThread;
         size_t end = (thread == numOplogThreads - 1) ? ops.size() : begin + numOpsPerThread;
-        invariant(threadPool->schedule(makeOplogWriterForRange(begin, end)));
+        batch.emplace_back(makeOplogWriterForRange(begin, end));
     }
+    invariant(threadPool->scheduleBatch(std::move(batch)));
 }
 
 /**
@@ -476,6 +498,46 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Decides which writer thread each operation in a batch runs on.
+ *
+ * Two operations conflict when they may touch the same document: for doc locking engines that
+ * means ops with the same namespace and _id, for other engines and for capped collections any
+ * two ops on the same namespace. Conflicting ops stay on the same writer, in batch order, so
+ * their relative order is preserved. The first op of each conflict chain is placed on the writer
+ * with the fewest ops so far, rather than a fixed hash bucket, so a burst of writes to distinct
+ * documents in one hot collection spreads across all writer threads instead of serializing on
+ * whichever thread the namespace hashes to.
+ *
+ * One scheduler covers an entire batch, including the operations derived from applyOps and
+ * session updates, so every recursive fillWriterVectors() call over the same writer vectors must
+ * share the same instance.
+ */
+class WriterVectorScheduler {
+public:
+    uint32_t assign(uint32_t conflictKey,
+                    const std::vector<MultiApplier::OperationPtrs>& writerVectors) {
+        auto it = _assignments.find(conflictKey);
+        if (it != _assignments.end()) {
+            return it->second;
+        }
+
+        uint32_t writerId = 0;
+        for (uint32_t i = 1; i < writerVectors.size(); i++) {
+            if (writerVectors[i].size() < writerVectors[writerId].size()) {
+                writerId = i;
+            }
+        }
+        _assignments[conflictKey] = writerId;
+        return writerId;
+    }
+
+private:
+    // Conflict key -> writer thread index. Two distinct documents whose keys collide merely
+    // share a writer, which is conservative but still correct.
+    stdx::unordered_map<uint32_t, uint32_t> _assignments;
+};
+
 /**
  * ops - This only modifies the isForCappedCollection field on each op. It does not alter the ops
  *      vector in any other way.
@@ -483,17 +545,18 @@ private:
  * derivedOps - If provided, this function inserts a decomposition of applyOps operations
  *      and instructions for updating the transactions table.
  * sessionUpdateTracker - if provided, keeps track of session info from ops.
+ * scheduler - assigns each op to a writer thread; shared across the whole batch.
  */
 void fillWriterVectors(OperationContext* opCtx,
                        MultiApplier::Operations* ops,
                        std::vector<MultiApplier::OperationPtrs>* writerVectors,
                        std::vector<MultiApplier::Operations>* derivedOps,
-                       SessionUpdateTracker* sessionUpdateTracker) {
+                       SessionUpdateTracker* sessionUpdateTracker,
+                       WriterVectorScheduler* scheduler) {
     const auto serviceContext = opCtx->getServiceContext();
     const auto storageEngine = serviceContext->getStorageEngine();
 
     const bool supportsDocLocking = storageEngine->supportsDocLocking();
-    const uint32_t numWriters = writerVectors->size();
 
     CachedCollectionProperties collPropertiesCache;
 
@@ -506,7 +569,8 @@ void fillWriterVectors(OperationContext* opCtx,
         if (sessionUpdateTracker) {
             if (auto newOplogWrites = sessionUpdateTracker->updateOrFlush(op)) {
                 derivedOps->emplace_back(std::move(*newOplogWrites));
-                fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+                fillWriterVectors(
+                    opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr, scheduler);
             }
         }
 
@@ -541,7 +605,8 @@ void fillWriterVectors(OperationContext* opCtx,
                 derivedOps->emplace_back(ApplyOps::extractOperations(op));
 
                 // Nested entries cannot have different session updates.
-                fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+                fillWriterVectors(
+                    opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr, scheduler);
             } catch (...) {
                 fassertFailedWithStatusNoTrace(
                     50711,
@@ -552,7 +617,7 @@ void fillWriterVectors(OperationContext* opCtx,
             continue;
         }
 
-        auto& writer = (*writerVectors)[hash % numWriters];
+        auto& writer = (*writerVectors)[scheduler->assign(hash, *writerVectors)];
         if (writer.empty()) {
             writer.reserve(8);  // Skip a few growth rounds
         }
@@ -565,12 +630,17 @@ void fillWriterVectors(OperationContext* opCtx,
                        std::vector<MultiApplier::OperationPtrs>* writerVectors,
                        std::vector<MultiApplier::Operations>* derivedOps) {
     SessionUpdateTracker sessionUpdateTracker;
-    fillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    WriterVectorScheduler scheduler;
+    fillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker, &scheduler);
 
+    // The tracker coalesces the session info carried by the batch, so this emits exactly one
+    // config.transactions upsert per logical session no matter how many retryable-write
+    // statements the batch contained for it.
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        fillWriterVectors(
+            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr, &scheduler);
     }
 }
 
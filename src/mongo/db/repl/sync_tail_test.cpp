@@ -448,11 +448,9 @@ TEST_F(SyncTailTest,
                                                      createOplogCollectionOptions()));
 }
 
-TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceHash) {
-    // This test relies on implementation details of how multiApply uses hashing to distribute ops
-    // to threads. It is possible for this test to fail, even if the implementation of multiApply is
-    // correct. If it fails, consider adjusting the namespace names (to adjust the hash values) or
-    // the number of threads in the pool.
+TEST_F(SyncTailTest, MultiApplySpreadsNonConflictingOperationsAcrossWriterThreads) {
+    // Operations on different namespaces cannot conflict, so multiApply starts each one on the
+    // least-loaded writer thread and the two ops must land on different threads.
     NamespaceString nss1("test.t0");
     NamespaceString nss2("test.t1");
     auto writerPool = OplogApplier::makeWriterPool(2);
@@ -518,6 +516,50 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_EQUALS(op2, lastEntry);
 }
 
+TEST_F(SyncTailTest, MultiApplyKeepsConflictingOperationsOnOneWriterThreadInOrder) {
+    // Without document-level locking every op on a namespace conflicts with every other, so all
+    // four ops must stay on a single writer thread in batch order even though other writer
+    // threads are idle.
+    NamespaceString nss("test.t0");
+    auto writerPool = OplogApplier::makeWriterPool(2);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn =
+        [&mutex, &operationsApplied](OperationContext* opCtx,
+                                     MultiApplier::OperationPtrs* operationsForWriterThreadToApply,
+                                     SyncTail* st,
+                                     WorkerMultikeyPathInfo*) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    MultiApplier::Operations ops;
+    for (int i = 0; i < 4; i++) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(i + 1), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    SyncTail syncTail(nullptr,
+                      getConsistencyMarkers(),
+                      getStorageInterface(),
+                      applyOperationFn,
+                      writerPool.get());
+    auto lastOpTime = unittest::assertGet(syncTail.multiApply(_opCtx.get(), ops));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    ASSERT_EQUALS(1U, operationsApplied.size());
+    ASSERT_EQUALS(ops.size(), operationsApplied.front().size());
+    for (size_t i = 0; i < ops.size(); i++) {
+        ASSERT_EQUALS(ops[i], operationsApplied.front()[i]);
+    }
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
@@ -863,6 +863,17 @@ bool TopologyCoordinator::haveTaggedNodesReachedOpTime(const OpTime& opTime,
     return false;
 }
 
+OpTime TopologyCoordinator::latestKnownAppliedOpTime() const {
+    OpTime latest = getMyLastAppliedOpTime();
+    for (auto&& memberData : _memberData) {
+        const auto& memberOpTime = memberData.getLastAppliedOpTime();
+        if (memberOpTime > latest) {
+            latest = memberOpTime;
+        }
+    }
+    return latest;
+}
+
 HeartbeatResponseAction TopologyCoordinator::checkMemberTimeouts(Date_t now) {
     bool stepdown = false;
     for (int memberIndex = 0; memberIndex < static_cast<int>(_memberData.size()); memberIndex++) {
@@ -398,6 +398,13 @@ public:
                                       const ReplSetTagPattern& tagPattern,
                                       bool durablyWritten);
 
+    /**
+     * Returns the greatest last applied optime reported by any member, including ourself. No
+     * write concern can be satisfied at an optime beyond this bound, so callers may use it to
+     * skip waiters that cannot possibly be done.
+     */
+    OpTime latestKnownAppliedOpTime() const;
+
     /**
      * Returns a vector of members that have applied the operation with OpTime 'op'.
      * "durablyWritten" indicates whether the operation has to be durably applied.
@@ -38,6 +38,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -48,6 +49,7 @@
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
@@ -55,9 +57,11 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -69,6 +73,22 @@ MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchDelayMS, int, 20)
         return Status::OK();
     });
 
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchSize, int, 0)->withValidator([](const int& newVal) {
+    if (newVal < 0) {
+        return Status(ErrorCodes::BadValue, "rangeDeleterBatchSize must not be negative");
+    }
+    return Status::OK();
+});
+
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterMaxReplicationLagSecs, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "rangeDeleterMaxReplicationLagSecs must not be negative");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using Deletion = CollectionRangeDeleter::Deletion;
@@ -91,6 +111,61 @@ boost::optional<DeleteNotification> checkOverlap(std::list<Deletion> const& dele
     return boost::none;
 }
 
+/**
+ * Returns true if 'rangeDeleterMaxReplicationLagSecs' is enabled and the majority-committed
+ * optime trails this node's last applied optime by more than that many seconds. Deleting more
+ * documents while secondaries are already behind would only widen the gap.
+ */
+bool replicationLagExceedsLimit(OperationContext* opCtx) {
+    const int maxLagSecs = rangeDeleterMaxReplicationLagSecs.load();
+    if (maxLagSecs == 0) {
+        return false;
+    }
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return false;
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp();
+    const auto lastCommitted = replCoord->getLastCommittedOpTime().getTimestamp();
+    return lastApplied.getSecs() > lastCommitted.getSecs() + static_cast<unsigned>(maxLagSecs);
+}
+
+/**
+ * Scales the batch size down in proportion to the fraction of storage engine write tickets
+ * currently available, so that orphan cleanup yields to foreground writes instead of competing
+ * with them for tickets. With an idle storage engine the full batch size is used.
+ */
+int adjustBatchSizeForTickets(int maxToDelete) {
+    auto* const writeTickets = Locker::getGlobalThrottledTicketHolder(MODE_IX);
+    if (!writeTickets || writeTickets->outof() == 0) {
+        return maxToDelete;
+    }
+
+    return std::max(maxToDelete * writeTickets->available() / writeTickets->outof(), 1);
+}
+
+/**
+ * Returns the delay before the next deletion batch, starting from 'rangeDeleterBatchDelayMS' and
+ * backing off as storage engine write tickets become scarce.
+ */
+Milliseconds computeBatchDelay() {
+    Milliseconds delay{rangeDeleterBatchDelayMS.load()};
+
+    auto* const writeTickets = Locker::getGlobalThrottledTicketHolder(MODE_IX);
+    if (writeTickets && writeTickets->outof() > 0) {
+        const int available = writeTickets->available();
+        if (available * 4 < writeTickets->outof()) {
+            delay *= 4;
+        } else if (available * 2 < writeTickets->outof()) {
+            delay *= 2;
+        }
+    }
+
+    return delay;
+}
+
 }  // namespace
 
 CollectionRangeDeleter::CollectionRangeDeleter() = default;
@@ -107,6 +182,22 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
     int maxToDelete,
     CollectionRangeDeleter* forTestOnly) {
 
+    if (replicationLagExceedsLimit(opCtx)) {
+        LOG(1) << "Postponing deletions in " << nss.ns() << " because replication lag exceeds "
+               << rangeDeleterMaxReplicationLagSecs.load() << " seconds";
+        return Date_t::now() + Seconds(1);
+    }
+
+    maxToDelete = adjustBatchSizeForTickets(maxToDelete);
+
+    // Accumulate the wall time this pass consumes; together with countDocsDeletedOnDonor this
+    // lets operators derive the cleanup rate, and from it the remaining cleanup time.
+    Timer passTimer;
+    ON_BLOCK_EXIT([&] {
+        ShardingStatistics::get(opCtx).totalDonorRangeDeletionTimeMillis.addAndFetch(
+            passTimer.millis());
+    });
+
     StatusWith<int> wrote = 0;
 
     auto range = boost::optional<ChunkRange>(boost::none);
@@ -289,7 +380,7 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
                    << redact(self->_orphans.front().range.toString()) << " next.";
         }
 
-        return Date_t::now() + stdx::chrono::milliseconds{rangeDeleterBatchDelayMS.load()};
+        return Date_t::now() + computeBatchDelay();
     }
 
     invariant(range);
@@ -297,7 +388,7 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
     invariant(wrote.getValue() > 0);
 
     notification.abandon();
-    return Date_t::now() + stdx::chrono::milliseconds{rangeDeleterBatchDelayMS.load()};
+    return Date_t::now() + computeBatchDelay();
 }
 
 StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
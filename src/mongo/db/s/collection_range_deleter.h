@@ -43,9 +43,19 @@ class Collection;
 class OperationContext;
 
 // After completing a batch of document deletions, the time in millis to wait before commencing the
-// next batch of deletions.
+// next batch of deletions. The effective delay is scaled up when storage engine write tickets run
+// low, so that orphan cleanup yields to foreground writes.
 extern AtomicInt32 rangeDeleterBatchDelayMS;
 
+// Maximum number of documents to delete in a single range deletion batch. A value of 0 means the
+// batch size is derived from internalQueryExecYieldIterations. The effective batch size is scaled
+// down when storage engine write tickets run low.
+extern AtomicInt32 rangeDeleterBatchSize;
+
+// If non-zero and the majority-committed optime trails this node's last applied optime by more
+// than this many seconds, range deletion batches are postponed until replication catches up.
+extern AtomicInt32 rangeDeleterMaxReplicationLagSecs;
+
 class CollectionRangeDeleter {
     MONGO_DISALLOW_COPYING(CollectionRangeDeleter);
 
@@ -147,7 +147,10 @@ void scheduleCleanup(executor::TaskExecutor* executor,
             auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
             auto opCtx = uniqueOpCtx.get();
 
-            const int maxToDelete = std::max(int(internalQueryExecYieldIterations.load()), 1);
+            const int batchSize = rangeDeleterBatchSize.load();
+            const int maxToDelete = batchSize > 0
+                ? batchSize
+                : std::max(int(internalQueryExecYieldIterations.load()), 1);
 
             MONGO_FAIL_POINT_PAUSE_WHILE_SET(suspendRangeDeletion);
 
@@ -32,6 +32,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -54,6 +55,7 @@
 #include "mongo/db/s/move_timing_helper.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/client/shard_registry.h"
@@ -73,6 +75,14 @@ namespace {
 const auto getMigrationDestinationManager =
     ServiceContext::declareDecoration<MigrationDestinationManager>();
 
+// The number of concurrent clone streams during the bulk clone phase of a chunk migration. Each
+// stream fetches batches from the donor and inserts them independently, so a single migration
+// can overlap network transfer with insertion and index maintenance across streams. The donor
+// hands out every document exactly once, so the streams dynamically partition the chunk between
+// themselves. A value of 1 or less clones through a single stream, which still overlaps
+// fetching with insertion.
+MONGO_EXPORT_SERVER_PARAMETER(migrateCloneStreams, int, 1);
+
 const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 // Note: Even though we're setting UNSET here,
                                                 // kMajority implies JOURNAL if journaling is
@@ -379,14 +389,42 @@ void MigrationDestinationManager::cloneDocumentsFromDonor(
     stdx::function<void(OperationContext*, BSONObj)> insertBatchFn,
     stdx::function<BSONObj(OperationContext*)> fetchBatchFn) {
 
-    ProducerConsumerQueue<BSONObj> batches(1);
-    stdx::thread inserterThread{[&] {
+    const size_t numStreams = static_cast<size_t>(std::max(1, migrateCloneStreams.load()));
+
+    // Each stream is a fetcher/inserter pair connected by a single-slot batch queue, so within a
+    // stream the next batch is fetched from the donor while the previous one is being inserted.
+    // Multiple streams additionally overlap the donor-side batch construction and the network
+    // transfer of one stream with the insertion and index maintenance of the others.
+    struct CloneStream {
+        CloneStream() : batches(1) {}
+
+        ProducerConsumerQueue<BSONObj> batches;
+
+        stdx::thread inserterThread;
+
+        // Unused for the first stream, which fetches on the migration thread itself
+        stdx::thread fetcherThread;
+    };
+
+    std::vector<std::unique_ptr<CloneStream>> streams;
+    for (size_t i = 0; i < numStreams; i++) {
+        streams.push_back(stdx::make_unique<CloneStream>());
+    }
+
+    // Failures on the worker threads are reflected onto the migration thread's operation context
+    // so that all other streams notice and unwind.
+    auto killMigrateThread = [&](const Status& status) {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(opCtx, status.code());
+    };
+
+    auto inserterFn = [&](CloneStream* stream) {
         Client::initThreadIfNotAlready("chunkInserter");
         auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
-        auto consumerGuard = MakeGuard([&] { batches.closeConsumerEnd(); });
+        auto consumerGuard = MakeGuard([&] { stream->batches.closeConsumerEnd(); });
         try {
             while (true) {
-                auto nextBatch = batches.pop(inserterOpCtx.get());
+                auto nextBatch = stream->batches.pop(inserterOpCtx.get());
                 auto arr = nextBatch["objects"].Obj();
                 if (arr.isEmpty()) {
                     return;
@@ -394,31 +432,77 @@ void MigrationDestinationManager::cloneDocumentsFromDonor(
                 insertBatchFn(inserterOpCtx.get(), arr);
             }
         } catch (...) {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            opCtx->getServiceContext()->killOperation(opCtx, exceptionToStatus().code());
+            killMigrateThread(exceptionToStatus());
             log() << "Batch insertion failed " << causedBy(redact(exceptionToStatus()));
         }
-    }};
-    auto inserterThreadJoinGuard = MakeGuard([&] {
-        batches.closeProducerEnd();
-        inserterThread.join();
+    };
+
+    // Fetches batches into the stream until the donor reports that the clone set is exhausted.
+    // The donor hands out every document exactly once, so concurrent streams dynamically
+    // partition the chunk between themselves without any range bookkeeping, and each stream
+    // individually observes an empty batch once no documents remain.
+    auto fetcherFn = [&](CloneStream* stream, OperationContext* fetchOpCtx) {
+        while (true) {
+            fetchOpCtx->checkForInterrupt();
+
+            auto res = fetchBatchFn(fetchOpCtx);
+
+            fetchOpCtx->checkForInterrupt();
+            stream->batches.push(res.getOwned(), fetchOpCtx);
+            auto arr = res["objects"].Obj();
+            if (arr.isEmpty()) {
+                return;
+            }
+        }
+    };
+
+    for (auto& stream : streams) {
+        stream->inserterThread =
+            stdx::thread([&, streamPtr = stream.get()] { inserterFn(streamPtr); });
+    }
+
+    auto joinGuard = MakeGuard([&] {
+        for (auto& stream : streams) {
+            stream->batches.closeProducerEnd();
+        }
+        for (auto& stream : streams) {
+            if (stream->fetcherThread.joinable()) {
+                stream->fetcherThread.join();
+            }
+            stream->inserterThread.join();
+        }
     });
 
-    while (true) {
-        opCtx->checkForInterrupt();
+    for (size_t i = 1; i < numStreams; i++) {
+        streams[i]->fetcherThread = stdx::thread([&, streamPtr = streams[i].get()] {
+            Client::initThreadIfNotAlready("chunkFetcher");
+            auto fetchOpCtx = Client::getCurrent()->makeOperationContext();
+            auto producerGuard = MakeGuard([&] { streamPtr->batches.closeProducerEnd(); });
+            try {
+                fetcherFn(streamPtr, fetchOpCtx.get());
+            } catch (...) {
+                killMigrateThread(exceptionToStatus());
+                log() << "Batch fetching failed " << causedBy(redact(exceptionToStatus()));
+            }
+        });
+    }
 
-        auto res = fetchBatchFn(opCtx);
+    // The first stream fetches on the migration thread itself
+    fetcherFn(streams[0].get(), opCtx);
 
-        opCtx->checkForInterrupt();
-        batches.push(res.getOwned(), opCtx);
-        auto arr = res["objects"].Obj();
-        if (arr.isEmpty()) {
-            inserterThreadJoinGuard.Dismiss();
-            inserterThread.join();
-            opCtx->checkForInterrupt();
-            break;
+    // Every stream terminates on its own once the donor's clone set is exhausted, so on success
+    // we only have to wait for the remaining fetches and inserts to finish.
+    joinGuard.Dismiss();
+    for (auto& stream : streams) {
+        if (stream->fetcherThread.joinable()) {
+            stream->fetcherThread.join();
         }
     }
+    for (auto& stream : streams) {
+        stream->batches.closeProducerEnd();
+        stream->inserterThread.join();
+    }
+    opCtx->checkForInterrupt();
 }
 
 Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
@@ -28,9 +28,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <set>
+
 #include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/shard_server_test_fixture.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -104,6 +109,61 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that multiple concurrent clone streams together deliver every document exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithMultipleStreams) {
+    auto streamsParam = ServerParameterSet::getGlobal()->get("migrateCloneStreams");
+    ASSERT_OK(streamsParam->set(BSON("" << 4).firstElement()));
+    auto restoreGuard =
+        MakeGuard([&] { streamsParam->set(BSON("" << 1).firstElement()).ignore(); });
+
+    const int kNumBatches = 10;
+
+    stdx::mutex fetchMutex;
+    int batchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+
+        stdx::lock_guard<stdx::mutex> lk(fetchMutex);
+
+        if (batchesFetched >= kNumBatches) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            BSONArrayBuilder arrayBuilder;
+            arrayBuilder.append(createDocument(batchesFetched++));
+            fetchBatchResultBuilder.append("objects", arrayBuilder.arr());
+        }
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    stdx::mutex insertMutex;
+    std::vector<BSONObj> resultDocs;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<stdx::mutex> lk(insertMutex);
+        for (auto&& docToClone : docs) {
+            resultDocs.push_back(docToClone.Obj().getOwned());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn);
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), resultDocs.size());
+
+    // The streams race for the batches, so only the set of cloned documents is deterministic
+    std::set<int> clonedValues;
+    for (const auto& doc : resultDocs) {
+        clonedValues.insert(doc["X"].numberInt());
+    }
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), clonedValues.size());
+    for (int i = 0; i < kNumBatches; i++) {
+        ASSERT_EQ(1u, clonedValues.count(i));
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
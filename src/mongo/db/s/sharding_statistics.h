@@ -68,6 +68,11 @@ struct ShardingStatistics {
     // node by the rangeDeleter.
     AtomicInt64 countDocsDeletedOnDonor{0};
 
+    // Cumulative, always-increasing counter of how much time the rangeDeleter on the donor node
+    // has spent in deletion passes. Dividing countDocsDeletedOnDonor by this gives the orphan
+    // cleanup rate, from which remaining cleanup time can be estimated.
+    AtomicInt64 totalDonorRangeDeletionTimeMillis{0};
+
     // Cumulative, always-increasing counter of how many chunks this node started to receive
     // (whether the receiving succeeded or not)
     AtomicInt64 countRecipientMoveChunkStarted{0};
@@ -215,6 +215,12 @@ Status addBaseServerOptions(moe::OptionSection* options) {
                                moe::Switch,
                                "append to logpath instead of over-writing");
 
+    options->addOptionChaining("systemLog.logAsync",
+                               "logAsync",
+                               moe::Switch,
+                               "write log entries to logpath from a background thread so "
+                               "operations do not block on slow log writes");
+
     options->addOptionChaining("systemLog.logRotate",
                                "logRotate",
                                moe::String,
@@ -506,6 +512,10 @@ Status storeBaseOptions(const moe::Environment& params) {
         serverGlobalParams.logAppend = true;
     }
 
+    if (params.count("systemLog.logAsync") && params["systemLog.logAsync"].as<bool>() == true) {
+        serverGlobalParams.logAsync = true;
+    }
+
     if (params.count("systemLog.logRotate")) {
         std::string logRotateParam = params["systemLog.logRotate"].as<string>();
         if (logRotateParam == "reopen") {
@@ -35,6 +35,7 @@
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/admission_control.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/impersonation_session.h"
@@ -76,6 +77,7 @@
 #include "mongo/db/snapshot_window_util.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/db/stats/wait_time_attribution.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/rpc/factory.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -92,6 +94,7 @@
 #include "mongo/s/cannot_implicitly_create_collection_info.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/stale_exception.h"
+#include "mongo/transport/session.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
@@ -967,6 +970,16 @@ void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request) {
     curop->setNS_inlock(nss.ns());
 }
 
+/**
+ * Returns true for operations admission control may delay or reject: those from external
+ * clients that are not acting on behalf of another operation.
+ */
+bool isLowPriorityClient(Client* client) {
+    return !client->isInDirectClient() &&
+        !(client->session() &&
+          (client->session()->getTags() & transport::Session::kInternalClient));
+}
+
 DbResponse receivedCommands(OperationContext* opCtx,
                             const Message& message,
                             const ServiceEntryPointCommon::Hooks& behaviors) {
@@ -1023,6 +1036,14 @@ DbResponse receivedCommands(OperationContext* opCtx,
                 CurOp::get(opCtx)->setLogicalOp_inlock(c->getLogicalOp());
             }
 
+            // When the server is saturated well past the admission control target, shed
+            // external commands with a retryable error before they consume tickets and locks.
+            // Commands which do not require auth (isMaster, ping, the auth commands) stay
+            // exempt so monitoring and authentication keep working during overload.
+            if (c->requiresAuth() && isLowPriorityClient(opCtx->getClient())) {
+                globalAdmissionController.uassertNotSaturated();
+            }
+
             execCommandDatabase(opCtx, c, request, replyBuilder.get(), behaviors);
         } catch (const DBException& ex) {
             BSONObjBuilder metadataBob;
@@ -1308,6 +1329,24 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
 
     OpDebug& debug = currentOp.debug();
 
+    // Run the operation through admission control before dispatching it. Operations from
+    // external clients are delayed here while recent global ticket waits are above target,
+    // shedding load before it reaches the ticket holders and the lock manager.
+    AdmissionController::Category admissionCategory;
+    if (isCommand) {
+        admissionCategory = AdmissionController::kCommand;
+    } else if (op == dbQuery || op == dbGetMore) {
+        admissionCategory = AdmissionController::kRead;
+    } else if (op == dbInsert || op == dbUpdate || op == dbDelete) {
+        admissionCategory = AdmissionController::kWrite;
+    } else {
+        admissionCategory = AdmissionController::kOther;
+    }
+
+    globalAdmissionController.admitOperation(opCtx, admissionCategory, isLowPriorityClient(&c));
+    auto admissionGuard =
+        MakeGuard([&] { globalAdmissionController.finishOperation(admissionCategory); });
+
     boost::optional<long long> slowMsOverride;
     bool forceLog = false;
 
@@ -1372,6 +1411,28 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    {
+        // Flush this operation's lock and ticket waits to the per-database attribution. Most
+        // operations never wait, so this usually costs two loads.
+        auto locker = opCtx->lockState();
+        const int64_t lockWaitMicros = locker->getCumulativeLockWaitTimeMicros();
+        const int64_t ticketWaitMicros = locker->getCumulativeTicketWaitTimeMicros();
+        if ((lockWaitMicros > 0 || ticketWaitMicros > 0) && !currentOp.getNS().empty()) {
+            WaitTimeAttribution::get(opCtx->getServiceContext())
+                .record(currentOp.getNS(), lockWaitMicros, ticketWaitMicros);
+        }
+    }
+
+    if (debug.queryHash) {
+        Top::get(opCtx->getServiceContext())
+            .incrementQueryShapeLatencyStats(
+                opCtx,
+                currentOp.getNS(),
+                *debug.queryHash,
+                durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
+                currentOp.getReadWriteType());
+    }
+
     if (currentOp.shouldDBProfile(shouldSample)) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
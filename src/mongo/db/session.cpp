@@ -377,6 +377,7 @@ void Session::invalidate() {
 
     _activeTxnNumber = kUninitializedTxnNumber;
     _activeTxnCommittedStatements.clear();
+    _lastFetchedStatementEntry = boost::none;
     _hasIncompleteHistory = false;
 }
 
@@ -394,20 +395,35 @@ repl::OpTime Session::getLastWriteOpTime(TxnNumber txnNumber) const {
 boost::optional<repl::OplogEntry> Session::checkStatementExecuted(OperationContext* opCtx,
                                                                   TxnNumber txnNumber,
                                                                   StmtId stmtId) const {
+    boost::optional<repl::OplogEntry> cachedEntry;
     const auto stmtTimestamp = [&] {
         stdx::lock_guard<stdx::mutex> lg(_mutex);
-        return _checkStatementExecuted(lg, txnNumber, stmtId);
+        auto opTime = _checkStatementExecuted(lg, txnNumber, stmtId);
+        if (opTime && _lastFetchedStatementEntry && _lastFetchedStatementEntry->first == stmtId) {
+            cachedEntry = _lastFetchedStatementEntry->second;
+        }
+        return opTime;
     }();
 
     if (!stmtTimestamp)
         return boost::none;
 
+    if (cachedEntry)
+        return cachedEntry;
+
     TransactionHistoryIterator txnIter(*stmtTimestamp);
     while (txnIter.hasNext()) {
         const auto entry = txnIter.next(opCtx);
         invariant(entry.getStatementId());
-        if (*entry.getStatementId() == stmtId)
+        if (*entry.getStatementId() == stmtId) {
+            stdx::lock_guard<stdx::mutex> lg(_mutex);
+            // Only populate the cache if the session was not invalidated or moved to a newer
+            // transaction while the oplog was being read.
+            if (_isValid && _activeTxnNumber == txnNumber) {
+                _lastFetchedStatementEntry.emplace(stmtId, entry);
+            }
             return entry;
+        }
     }
 
     MONGO_UNREACHABLE;
@@ -459,6 +475,7 @@ void Session::_setActiveTxn(WithLock wl, TxnNumber txnNumber) {
 
     _activeTxnNumber = txnNumber;
     _activeTxnCommittedStatements.clear();
+    _lastFetchedStatementEntry = boost::none;
     _hasIncompleteHistory = false;
 }
 
@@ -301,6 +301,11 @@ private:
     // having to scan through the oplog.
     CommittedStatementTimestampMap _activeTxnCommittedStatements;
 
+    // Caches the most recently fetched oplog entry for a committed statement of the active txn,
+    // so that repeated retries of the same statement are answered from memory rather than by
+    // re-reading the oplog. Cleared whenever '_activeTxnCommittedStatements' is.
+    mutable boost::optional<std::pair<StmtId, repl::OplogEntry>> _lastFetchedStatementEntry;
+
     // Stores the state from last refresh.
     boost::optional<RefreshState> _lastRefreshState;
 
@@ -43,7 +43,9 @@
 #include "mongo/db/transaction_participant.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/allocation_accounting.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -55,17 +57,35 @@ const auto operationSessionDecoration =
 
 }  // namespace
 
+thread_local std::shared_ptr<SessionCatalog::SessionRuntimeInfo>
+    SessionCatalog::_lastReleasedSession;
+thread_local SessionCatalog* SessionCatalog::_lastReleasedCatalog = nullptr;
+
 SessionCatalog::~SessionCatalog() {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-    for (const auto& entry : _sessions) {
-        auto& sri = entry.second;
-        invariant(!sri->checkedOut);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lg(partition.mutex);
+        for (const auto& entry : partition.sessions) {
+            auto& sri = entry.second;
+            invariant(!sri->checkedOut.load());
+
+            // Stop the thread-local caches of other threads from resurrecting sessions belonging
+            // to a destroyed catalog.
+            sri->obsolete.store(true);
+        }
     }
 }
 
 void SessionCatalog::reset_forTest() {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-    _sessions.clear();
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lg(partition.mutex);
+        for (const auto& entry : partition.sessions) {
+            entry.second->obsolete.store(true);
+        }
+        partition.sessions.clear();
+    }
+
+    _lastReleasedSession.reset();
+    _lastReleasedCatalog = nullptr;
 }
 
 SessionCatalog* SessionCatalog::get(OperationContext* opCtx) {
@@ -126,23 +146,47 @@ ScopedCheckedOutSession SessionCatalog::checkOutSession(OperationContext* opCtx)
 
     const auto lsid = *opCtx->getLogicalSessionId();
 
-    stdx::unique_lock<stdx::mutex> ul(_mutex);
+    // Attribute session state allocations to the session catalog.
+    allocation_accounting::ScopedSubsystemTag allocationTag(
+        allocation_accounting::Subsystem::kSessions);
 
-    while (!_allowCheckingOutSessions) {
-        opCtx->waitForConditionOrInterrupt(_checkingOutSessionsAllowedCond, ul);
+    if (auto sri = _tryLockFreeReacquire(lsid)) {
+        return ScopedCheckedOutSession(opCtx, ScopedSession(std::move(sri)));
     }
 
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, lsid);
+    {
+        stdx::unique_lock<stdx::mutex> ul(_checkOutGateMutex);
 
-    // Wait until the session is no longer checked out
-    opCtx->waitForConditionOrInterrupt(
-        sri->availableCondVar, ul, [&sri]() { return !sri->checkedOut; });
+        while (!_allowCheckingOutSessions.load()) {
+            opCtx->waitForConditionOrInterrupt(_checkingOutSessionsAllowedCond, ul);
+        }
 
-    invariant(!sri->checkedOut);
-    sri->checkedOut = true;
-    ++_numCheckedOutSessions;
+        // Count this checkout before releasing the gate mutex, so that a concurrent
+        // PreventCheckingOutSessionsBlock cannot observe a zero count while this checkout is still
+        // in progress.
+        _numCheckedOutSessions.fetchAndAdd(1);
+    }
 
-    return ScopedCheckedOutSession(opCtx, ScopedSession(std::move(sri)));
+    try {
+        auto& partition = _partitionFor(lsid);
+        stdx::unique_lock<stdx::mutex> ul(partition.mutex);
+
+        auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, partition, lsid);
+
+        // Wait until the session is no longer checked out. The session is claimed with a
+        // compare-and-swap because the lock-free fast path claims without taking the partition
+        // mutex.
+        sri->numWaiters.fetchAndAdd(1);
+        const auto waiterGuard = MakeGuard([&sri] { sri->numWaiters.subtractAndFetch(1); });
+        opCtx->waitForConditionOrInterrupt(sri->availableCondVar, ul, [&sri]() {
+            return !sri->checkedOut.compareAndSwap(false, true);
+        });
+
+        return ScopedCheckedOutSession(opCtx, ScopedSession(std::move(sri)));
+    } catch (...) {
+        _onSessionCheckedIn();
+        throw;
+    }
 }
 
 ScopedSession SessionCatalog::getOrCreateSession(OperationContext* opCtx,
@@ -151,9 +195,14 @@ ScopedSession SessionCatalog::getOrCreateSession(OperationContext* opCtx,
     invariant(!opCtx->getLogicalSessionId());
     invariant(!opCtx->getTxnNumber());
 
+    // Attribute session state allocations to the session catalog.
+    allocation_accounting::ScopedSubsystemTag allocationTag(
+        allocation_accounting::Subsystem::kSessions);
+
     auto ss = [&] {
-        stdx::unique_lock<stdx::mutex> ul(_mutex);
-        return ScopedSession(_getOrCreateSessionRuntimeInfo(ul, opCtx, lsid));
+        auto& partition = _partitionFor(lsid);
+        stdx::unique_lock<stdx::mutex> ul(partition.mutex);
+        return ScopedSession(_getOrCreateSessionRuntimeInfo(ul, opCtx, partition, lsid));
     }();
 
     return ss;
@@ -171,31 +220,43 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
                 !opCtx->getLogicalSessionId());
     }
 
-    const auto invalidateSessionFn = [&](WithLock, SessionRuntimeInfoMap::iterator it) {
+    const auto invalidateSessionFn = [&](WithLock,
+                                         SessionRuntimeInfoMap& sessions,
+                                         SessionRuntimeInfoMap::iterator it) {
         auto& sri = it->second;
         sri->txnState.invalidate();
 
         // We cannot remove checked-out sessions from the cache, because operations expect to find
-        // them there to check back in
-        if (!sri->checkedOut) {
-            _sessions.erase(it);
+        // them there to check back in. The entry is marked obsolete before consulting the
+        // check-out state, so that the lock-free fast path cannot claim an entry this erases (see
+        // _tryLockFreeReacquire).
+        sri->obsolete.store(true);
+        if (!sri->checkedOut.load()) {
+            sessions.erase(it);
+        } else {
+            sri->obsolete.store(false);
         }
     };
 
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-
     if (singleSessionDoc) {
         const auto lsid = LogicalSessionId::parse(IDLParserErrorContext("lsid"),
                                                   singleSessionDoc->getField("_id").Obj());
 
-        auto it = _sessions.find(lsid);
-        if (it != _sessions.end()) {
-            invalidateSessionFn(lg, it);
+        auto& partition = _partitionFor(lsid);
+        stdx::lock_guard<stdx::mutex> lg(partition.mutex);
+
+        auto it = partition.sessions.find(lsid);
+        if (it != partition.sessions.end()) {
+            invalidateSessionFn(lg, partition.sessions, it);
         }
     } else {
-        auto it = _sessions.begin();
-        while (it != _sessions.end()) {
-            invalidateSessionFn(lg, it++);
+        for (auto& partition : _partitions) {
+            stdx::lock_guard<stdx::mutex> lg(partition.mutex);
+
+            auto it = partition.sessions.begin();
+            while (it != partition.sessions.end()) {
+                invalidateSessionFn(lg, partition.sessions, it++);
+            }
         }
     }
 }
@@ -203,46 +264,102 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
 void SessionCatalog::scanSessions(OperationContext* opCtx,
                                   const SessionKiller::Matcher& matcher,
                                   stdx::function<void(OperationContext*, Session*)> workerFn) {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
+    LOG(2) << "Beginning scanSessions. Scanning " << _partitions.size() << " partitions.";
+
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lg(partition.mutex);
+
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end(); ++it) {
+            // TODO SERVER-33850: Rename KillAllSessionsByPattern and
+            // ScopedKillAllSessionsByPatternImpersonator to not refer to session kill.
+            if (const KillAllSessionsByPattern* pattern = matcher.match(it->first)) {
+                ScopedKillAllSessionsByPatternImpersonator impersonator(opCtx, *pattern);
+                workerFn(opCtx, &(it->second->txnState));
+            }
+        }
+    }
+}
+
+SessionCatalog::Partition& SessionCatalog::_partitionFor(const LogicalSessionId& lsid) {
+    return _partitions[LogicalSessionIdHash{}(lsid) % kNumPartitions];
+}
 
-    LOG(2) << "Beginning scanSessions. Scanning " << _sessions.size() << " sessions.";
+std::shared_ptr<SessionCatalog::SessionRuntimeInfo> SessionCatalog::_tryLockFreeReacquire(
+    const LogicalSessionId& lsid) {
+    const auto sri = _lastReleasedSession;
+    if (!sri || _lastReleasedCatalog != this || sri->txnState.getSessionId() != lsid) {
+        return nullptr;
+    }
 
-    for (auto it = _sessions.begin(); it != _sessions.end(); ++it) {
-        // TODO SERVER-33850: Rename KillAllSessionsByPattern and
-        // ScopedKillAllSessionsByPatternImpersonator to not refer to session kill.
-        if (const KillAllSessionsByPattern* pattern = matcher.match(it->first)) {
-            ScopedKillAllSessionsByPatternImpersonator impersonator(opCtx, *pattern);
-            workerFn(opCtx, &(it->second->txnState));
-        }
+    // Claim the session with a compare-and-swap. If another thread has it checked out, or is
+    // claiming it under its partition mutex, fall back to the locked path, which knows how to
+    // wait.
+    if (sri->checkedOut.compareAndSwap(false, true)) {
+        return nullptr;
+    }
+
+    _numCheckedOutSessions.fetchAndAdd(1);
+
+    // Now that the claim is visible, re-check the states which the locked path consults under
+    // mutexes. The increment above is sequenced before these loads, so either this thread observes
+    // the prevention/invalidation, or the preventing/invalidating thread observes this checkout.
+    if (_allowCheckingOutSessions.load() && !sri->obsolete.load()) {
+        return sri;
+    }
+
+    // Undo the claim and take the locked path.
+    sri->checkedOut.store(false);
+    if (sri->numWaiters.load() > 0) {
+        stdx::lock_guard<stdx::mutex> lg(_partitionFor(lsid).mutex);
+        sri->availableCondVar.notify_one();
     }
+    _onSessionCheckedIn();
+
+    if (sri->obsolete.load()) {
+        _lastReleasedSession.reset();
+        _lastReleasedCatalog = nullptr;
+    }
+
+    return nullptr;
 }
 
 std::shared_ptr<SessionCatalog::SessionRuntimeInfo> SessionCatalog::_getOrCreateSessionRuntimeInfo(
-    WithLock, OperationContext* opCtx, const LogicalSessionId& lsid) {
+    WithLock, OperationContext* opCtx, Partition& partition, const LogicalSessionId& lsid) {
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());
-    invariant(_allowCheckingOutSessions);
 
-    auto it = _sessions.find(lsid);
-    if (it == _sessions.end()) {
-        it = _sessions.emplace(lsid, std::make_shared<SessionRuntimeInfo>(lsid)).first;
+    auto it = partition.sessions.find(lsid);
+    if (it == partition.sessions.end()) {
+        it = partition.sessions.emplace(lsid, std::make_shared<SessionRuntimeInfo>(lsid)).first;
     }
 
     return it->second;
 }
 
-void SessionCatalog::_releaseSession(const LogicalSessionId& lsid) {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
+void SessionCatalog::_releaseSession(std::shared_ptr<SessionRuntimeInfo> sri) {
+    invariant(sri->checkedOut.load());
 
-    auto it = _sessions.find(lsid);
-    invariant(it != _sessions.end());
+    // Remember the released session so that this thread can check it out again without locks.
+    _lastReleasedSession = sri;
+    _lastReleasedCatalog = this;
 
-    auto& sri = it->second;
-    invariant(sri->checkedOut);
+    sri->checkedOut.store(false);
+
+    // The waiter count is incremented under the partition mutex before a waiter first evaluates
+    // its predicate, so if it reads zero here no thread can be blocked on this session yet, and
+    // any later waiter will observe the store above and claim the session without waiting.
+    if (sri->numWaiters.load() > 0) {
+        stdx::lock_guard<stdx::mutex> lg(_partitionFor(sri->txnState.getSessionId()).mutex);
+        sri->availableCondVar.notify_one();
+    }
+
+    _onSessionCheckedIn();
+}
 
-    sri->checkedOut = false;
-    sri->availableCondVar.notify_one();
-    --_numCheckedOutSessions;
-    if (_numCheckedOutSessions == 0) {
+void SessionCatalog::_onSessionCheckedIn() {
+    if (_numCheckedOutSessions.subtractAndFetch(1) == 0) {
+        // Taking the gate mutex orders this notification after any concurrent
+        // waitForAllSessionsToBeCheckedIn() predicate evaluation.
+        stdx::lock_guard<stdx::mutex> lg(_checkOutGateMutex);
         _allSessionsCheckedInCond.notify_all();
     }
 }
@@ -252,25 +369,25 @@ SessionCatalog::PreventCheckingOutSessionsBlock::PreventCheckingOutSessionsBlock
     : _sessionCatalog(sessionCatalog) {
     invariant(sessionCatalog);
 
-    stdx::lock_guard<stdx::mutex> lg(sessionCatalog->_mutex);
-    invariant(sessionCatalog->_allowCheckingOutSessions);
-    sessionCatalog->_allowCheckingOutSessions = false;
+    stdx::lock_guard<stdx::mutex> lg(sessionCatalog->_checkOutGateMutex);
+    invariant(sessionCatalog->_allowCheckingOutSessions.load());
+    sessionCatalog->_allowCheckingOutSessions.store(false);
 }
 
 SessionCatalog::PreventCheckingOutSessionsBlock::~PreventCheckingOutSessionsBlock() {
-    stdx::lock_guard<stdx::mutex> lg(_sessionCatalog->_mutex);
+    stdx::lock_guard<stdx::mutex> lg(_sessionCatalog->_checkOutGateMutex);
 
-    invariant(!_sessionCatalog->_allowCheckingOutSessions);
-    _sessionCatalog->_allowCheckingOutSessions = true;
+    invariant(!_sessionCatalog->_allowCheckingOutSessions.load());
+    _sessionCatalog->_allowCheckingOutSessions.store(true);
     _sessionCatalog->_checkingOutSessionsAllowedCond.notify_all();
 }
 
 void SessionCatalog::PreventCheckingOutSessionsBlock::waitForAllSessionsToBeCheckedIn(
     OperationContext* opCtx) {
-    stdx::unique_lock<stdx::mutex> ul(_sessionCatalog->_mutex);
+    stdx::unique_lock<stdx::mutex> ul(_sessionCatalog->_checkOutGateMutex);
 
-    invariant(!_sessionCatalog->_allowCheckingOutSessions);
-    while (_sessionCatalog->_numCheckedOutSessions > 0) {
+    invariant(!_sessionCatalog->_allowCheckingOutSessions.load());
+    while (_sessionCatalog->_numCheckedOutSessions.load() > 0) {
         opCtx->waitForConditionOrInterrupt(_sessionCatalog->_allSessionsCheckedInCond, ul);
     }
 }
@@ -28,13 +28,17 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/session.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -92,6 +96,10 @@ public:
      * will block until it is put back in the 'available' state when the returned object goes out of
      * scope.
      *
+     * A thread which re-checks out the session it most recently released takes a lock-free fast
+     * path, which is the common case for connection-pinned sessions issuing a stream of retryable
+     * writes or transaction operations.
+     *
      * Throws exception on errors.
      */
     ScopedCheckedOutSession checkOutSession(OperationContext* opCtx);
@@ -120,8 +128,9 @@ public:
     void invalidateSessions(OperationContext* opCtx, boost::optional<BSONObj> singleSessionDoc);
 
     /**
-     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. Each partition
+     * of the catalog is locked and scanned in turn, so the scan is not a point-in-time snapshot of
+     * the catalog as a whole.
      * TODO SERVER-33850: Take Matcher out of the SessionKiller namespace.
      */
     void scanSessions(OperationContext* opCtx,
@@ -134,11 +143,20 @@ private:
 
         // Current check-out state of the session. If set to false, the session can be checked out.
         // If set to true, the session is in use by another operation and the caller must wait to
-        // check it out.
-        bool checkedOut{false};
+        // check it out. Claimed (transitioned to true) with a compare-and-swap, either under the
+        // owning partition's mutex or lock-free by _tryLockFreeReacquire().
+        AtomicBool checkedOut{false};
+
+        // Number of threads blocked in checkOutSession() waiting for this session to become
+        // available. Only modified under the owning partition's mutex, but read without it by
+        // _releaseSession() to decide whether waking waiters requires taking that mutex.
+        AtomicInt32 numWaiters{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Set when this entry is removed from the catalog, so that the lock-free reacquisition
+        // fast path cannot check out a session which is no longer tracked.
+        AtomicBool obsolete{false};
+
+        // Signaled when the state becomes available. Waited on with the owning partition's mutex.
         stdx::condition_variable availableCondVar;
 
         // Must only be accessed when the state is kInUse and only by the operation context, which
@@ -150,30 +168,56 @@ private:
                                                       std::shared_ptr<SessionRuntimeInfo>,
                                                       LogicalSessionIdHash>;
 
+    // The catalog is partitioned by lsid hash so that operations on unrelated sessions do not
+    // contend on a single mutex. Each partition's mutex guards its portion of the session map and
+    // the check-out waits of the sessions it contains.
+    struct Partition {
+        stdx::mutex mutex;
+        SessionRuntimeInfoMap sessions;
+    };
+
+    static constexpr std::size_t kNumPartitions = 16;
+
+    Partition& _partitionFor(const LogicalSessionId& lsid);
+
     /**
-     * May release and re-acquire it zero or more times before returning. The returned
-     * 'SessionRuntimeInfo' is guaranteed to be linked on the catalog's _txnTable as long as the
-     * lock is held.
+     * Attempts to check out the session this thread most recently released without taking any
+     * locks. Returns nullptr if the thread's cached session does not match 'lsid' or cannot be
+     * claimed, in which case the caller must take the regular (locked) path.
+     */
+    std::shared_ptr<SessionRuntimeInfo> _tryLockFreeReacquire(const LogicalSessionId& lsid);
+
+    /**
+     * Must be called with the partition's mutex held. The returned 'SessionRuntimeInfo' is
+     * guaranteed to be linked on the partition's session map as long as the lock is held.
      */
     std::shared_ptr<SessionRuntimeInfo> _getOrCreateSessionRuntimeInfo(
-        WithLock, OperationContext* opCtx, const LogicalSessionId& lsid);
+        WithLock, OperationContext* opCtx, Partition& partition, const LogicalSessionId& lsid);
 
     /**
      * Makes a session, previously checked out through 'checkoutSession', available again.
      */
-    void _releaseSession(const LogicalSessionId& lsid);
+    void _releaseSession(std::shared_ptr<SessionRuntimeInfo> sri);
+
+    /**
+     * Decrements the checked-out sessions count, waking waitForAllSessionsToBeCheckedIn() when it
+     * reaches zero.
+     */
+    void _onSessionCheckedIn();
 
-    // Protects members below.
-    stdx::mutex _mutex;
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
 
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    // Serializes changes to _allowCheckingOutSessions and guards the two conditions below. The
+    // partition mutexes are never acquired while this mutex is held.
+    stdx::mutex _checkOutGateMutex;
 
-    // Count of the number of Sessions that are currently checked out.
-    uint32_t _numCheckedOutSessions{0};
+    // Count of the number of Sessions that are currently checked out, including checkouts which
+    // have passed the _allowCheckingOutSessions gate but not yet claimed their session.
+    AtomicUInt32 _numCheckedOutSessions{0};
 
-    // Set to false to cause all Session checkout or creation requests to block.
-    bool _allowCheckingOutSessions{true};
+    // Set to false to cause all Session checkout or creation requests to block. Written under
+    // '_checkOutGateMutex'; read without it by the lock-free fast path.
+    AtomicBool _allowCheckingOutSessions{true};
 
     // Condition that is signaled when the number of checked out sessions goes to 0.
     stdx::condition_variable _allSessionsCheckedInCond;
@@ -181,6 +225,12 @@ private:
     // Condition that is signaled when checking out Sessions becomes legal again after having
     // previously been forbidden.
     stdx::condition_variable _checkingOutSessionsAllowedCond;
+
+    // The session most recently released on this thread, kept so the same thread can check it out
+    // again without taking any locks. The catalog pointer disambiguates catalogs belonging to
+    // different service contexts in unit tests.
+    static thread_local std::shared_ptr<SessionRuntimeInfo> _lastReleasedSession;
+    static thread_local SessionCatalog* _lastReleasedCatalog;
 };
 
 /**
@@ -229,6 +279,8 @@ public:
     }
 
 private:
+    friend class ScopedCheckedOutSession;
+
     std::shared_ptr<SessionCatalog::SessionRuntimeInfo> _sri;
 };
 
@@ -246,7 +298,7 @@ public:
 
     ~ScopedCheckedOutSession() {
         if (_scopedSession) {
-            SessionCatalog::get(_opCtx)->_releaseSession(_scopedSession->getSessionId());
+            SessionCatalog::get(_opCtx)->_releaseSession(_scopedSession._sri);
         }
     }
 
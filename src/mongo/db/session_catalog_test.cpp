@@ -105,6 +105,43 @@ TEST_F(SessionCatalogTest, OperationContextNonCheckedOutSession) {
     ASSERT(!session);
 }
 
+TEST_F(SessionCatalogTest, ReleasedSessionIsReacquiredOnSameThread) {
+    opCtx()->setLogicalSessionId(makeLogicalSessionIdForTest());
+
+    Session* session;
+    {
+        auto scopedSession = catalog()->checkOutSession(opCtx());
+        session = scopedSession.get();
+        ASSERT(session);
+    }
+
+    // Checking the session out again on the same thread takes the lock-free fast path and must
+    // yield the same Session object.
+    auto scopedSession = catalog()->checkOutSession(opCtx());
+    ASSERT_EQ(session, scopedSession.get());
+}
+
+TEST_F(SessionCatalogTest, PreventCheckoutAppliesToReacquisitionFastPath) {
+    const auto lsid = makeLogicalSessionIdForTest();
+    opCtx()->setLogicalSessionId(lsid);
+
+    // Populate this thread's reacquisition cache.
+    { auto scopedSession = catalog()->checkOutSession(opCtx()); }
+
+    opCtx()->setDeadlineAfterNowBy(Milliseconds(10), ErrorCodes::MaxTimeMSExpired);
+
+    {
+        SessionCatalog::PreventCheckingOutSessionsBlock preventCheckoutBlock(catalog());
+
+        ASSERT_THROWS_CODE(
+            catalog()->checkOutSession(opCtx()), AssertionException, ErrorCodes::MaxTimeMSExpired);
+    }
+
+    auto scopedSession = catalog()->checkOutSession(opCtx());
+    ASSERT(scopedSession.get());
+    ASSERT_EQ(lsid, scopedSession->getSessionId());
+}
+
 TEST_F(SessionCatalogTest, GetOrCreateNonExistentSession) {
     const auto lsid = makeLogicalSessionIdForTest();
     auto scopedSession = catalog()->getOrCreateSession(opCtx(), lsid);
@@ -48,13 +48,21 @@ namespace mongo {
 
 namespace {
 
-// This batch size is chosen to ensure that we don't form requests larger than the 16mb limit.
-// Especially for refreshes, the updates we send include the full user name (user@db), and user
-// names can be quite large (we enforce a max 10k limit for usernames used with sessions).
-//
-// At 1000 elements, a 16mb payload gives us a budget of 16000 bytes per user, which we should
-// comfortably be able to stay under, even with 10k user names.
-constexpr size_t kMaxBatchSize = 1000;
+// Write batches are flushed once their payload reaches this size, which leaves plenty of headroom
+// under the 16mb limit for the command's fixed fields. Tracking the payload size directly lets a
+// batch of small records (the common case: an upsert with no user name is well under 100 bytes)
+// pack tens of thousands of entries, while still staying within budget for refreshes whose updates
+// include the full user name (user@db, up to the 10k limit we enforce for usernames used with
+// sessions).
+constexpr size_t kMaxBatchByteSize = 8 * 1024 * 1024;
+
+// In addition to the byte budget above, write batches never exceed the server's cap on the number
+// of ops in a single write command.
+constexpr size_t kMaxWriteBatchSize = write_ops::kMaxWriteBatchSize;
+
+// Fetches are sent as single-batch finds with an $in filter over the ids, so they use a fixed
+// count limit rather than a byte budget.
+constexpr size_t kMaxFetchBatchSize = 1000;
 
 // Used to refresh or remove items from the session collection with write
 // concern majority
@@ -92,8 +100,13 @@ BSONObj updateQuery(const LogicalSessionRecord& record) {
     return updateBuilder.obj();
 }
 
-template <typename TFactory, typename AddLineFn, typename SendFn, typename Container>
-Status runBulkGeneric(TFactory makeT, AddLineFn addLine, SendFn sendBatch, const Container& items) {
+template <typename TFactory, typename AddLineFn, typename SendFn, typename Container, typename IsFullFn>
+Status runBulkGeneric(TFactory makeT,
+                      AddLineFn addLine,
+                      SendFn sendBatch,
+                      const Container& items,
+                      size_t maxBatchSize,
+                      IsFullFn isFull) {
     using T = decltype(makeT());
 
     size_t i = 0;
@@ -111,7 +124,7 @@ Status runBulkGeneric(TFactory makeT, AddLineFn addLine, SendFn sendBatch, const
     for (const auto& item : items) {
         addLine(*thing, item);
 
-        if (++i >= kMaxBatchSize) {
+        if (++i >= maxBatchSize || isFull(*thing)) {
             auto res = sendLocalBatch();
             if (!res.isOK()) {
                 return res;
@@ -153,7 +166,13 @@ Status runBulkCmd(StringData label,
         return sendBatch(batchBuilder->done());
     };
 
-    return runBulkGeneric(makeBatch, addLine, sendLocalBatch, items);
+    // 'buf' holds the whole command being built, so its length is the batch's payload size.
+    auto batchIsFull = [&](BSONArrayBuilder*) {
+        return static_cast<size_t>(buf.len()) >= kMaxBatchByteSize;
+    };
+
+    return runBulkGeneric(
+        makeBatch, addLine, sendLocalBatch, items, kMaxWriteBatchSize, batchIsFull);
 }
 
 }  // namespace
@@ -287,7 +306,9 @@ StatusWith<LogicalSessionIdSet> SessionsCollection::doFetch(const NamespaceStrin
         return wrappedSend(request.toBSON());
     };
 
-    auto status = runBulkGeneric(makeT, add, sendLocal, sessions);
+    auto neverFull = [](const std::vector<LogicalSessionId>&) { return false; };
+
+    auto status = runBulkGeneric(makeT, add, sendLocal, sessions, kMaxFetchBatchSize, neverFull);
 
     if (!status.isOK()) {
         return status;
@@ -49,6 +49,9 @@
 
 #include <boost/filesystem/operations.hpp>
 #include <snappy.h>
+
+#include <algorithm>
+#include <exception>
 #include <vector>
 
 #include "mongo/base/string_data.h"
@@ -59,6 +62,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/destructor_guard.h"
@@ -408,27 +412,38 @@ public:
     NoLimitSorter(const SortOptions& opts,
                   const Comparator& comp,
                   const Settings& settings = Settings())
-        : _comp(comp), _settings(settings), _opts(opts), _memUsed(0) {
+        : _comp(comp),
+          _settings(settings),
+          _opts(opts),
+          _memUsed(0),
+          _spillThresholdBytes(opts.maxMemoryUsageBytes) {
         verify(_opts.limit == 0);
     }
 
+    ~NoLimitSorter() {
+        if (_spillThread.joinable())
+            _spillThread.join();
+        delete _pendingIter;
+    }
+
     void add(const Key& key, const Value& val) {
         _data.push_back(std::make_pair(key, val));
 
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _spillThresholdBytes)
             spill();
     }
 
     Iterator* done() {
-        if (_iters.empty()) {
+        if (_iters.empty() && !_spillThread.joinable()) {
             sort();
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
+        joinSpillThread();
         return Iterator::merge(_iters, _opts, _comp);
     }
 
@@ -480,22 +495,89 @@ private:
                           << " Pass allowDiskUse:true to opt in.");
         }
 
-        sort();
+        if (_iters.empty() && !_spillThread.joinable()) {
+            // The first spill is done inline, since until now there was no reason to believe the
+            // data wouldn't fit in memory. From here on, spill at half the memory budget so that
+            // the run being written in the background and the buffer being refilled together
+            // stay within the budget.
+            sort();
 
-        SortedFileWriter<Key, Value> writer(_opts, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+            SortedFileWriter<Key, Value> writer(_opts, _settings);
+            for (; !_data.empty(); _data.pop_front()) {
+                writer.addAlreadySorted(_data.front().first, _data.front().second);
+            }
+
+            _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+
+            _spillThresholdBytes = std::max<size_t>(_opts.maxMemoryUsageBytes / 2, 1);
+            _memUsed = 0;
+            return;
         }
 
-        _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+        // Wait for the previous background spill, if any, so that at most one run is in flight.
+        joinSpillThread();
 
+        // Sort and write this run on a background thread, overlapping the (CPU and IO heavy)
+        // spill with continued run generation by the producer. The thread communicates back
+        // through '_pendingIter' and '_spillException', which are only touched by the producer
+        // after join(), so no further synchronization is needed.
+        std::deque<Data> dataToSpill;
+        dataToSpill.swap(_data);
         _memUsed = 0;
+
+        _spillThread = stdx::thread([ this, data = std::move(dataToSpill) ]() mutable {
+            try {
+                STLComparator less(_comp);
+                std::stable_sort(data.begin(), data.end(), less);
+
+                SortedFileWriter<Key, Value> writer(_opts, _settings);
+                for (; !data.empty(); data.pop_front()) {
+                    writer.addAlreadySorted(data.front().first, data.front().second);
+                }
+
+                _pendingIter = writer.done();
+            } catch (...) {
+                _spillException = std::current_exception();
+            }
+        });
+    }
+
+    /**
+     * Waits for an in-flight background spill, collects its run into '_iters', and rethrows any
+     * exception it encountered.
+     */
+    void joinSpillThread() {
+        if (!_spillThread.joinable())
+            return;
+        _spillThread.join();
+
+        if (_spillException) {
+            auto exception = _spillException;
+            _spillException = nullptr;
+            std::rethrow_exception(exception);
+        }
+
+        invariant(_pendingIter);
+        _iters.push_back(std::shared_ptr<Iterator>(_pendingIter));
+        _pendingIter = nullptr;
     }
 
     const Comparator _comp;
     const Settings _settings;
     SortOptions _opts;
     size_t _memUsed;
+
+    // Spilling threshold for the in-memory buffer. Starts out as the full memory budget and
+    // drops to half of it once the first spill proves the sort is external; see spill().
+    size_t _spillThresholdBytes;
+
+    // State for the background spill thread. At most one spill is in flight at a time, and
+    // '_pendingIter' and '_spillException' are only accessed by the producer after joining
+    // '_spillThread'.
+    stdx::thread _spillThread;
+    Iterator* _pendingIter = nullptr;
+    std::exception_ptr _spillException;
+
     std::deque<Data> _data;                         // the "current" data
     std::vector<std::shared_ptr<Iterator>> _iters;  // data that has already been spilled
 };
@@ -41,41 +41,69 @@ namespace mongo {
 
 using std::endl;
 
-OpCounters::OpCounters() {}
+namespace {
+
+// Upper bound on the number of counter shards; beyond this, extra cores share shards.
+const size_t kMaxOpCounterShards = 64;
+
+// Returns a small integer identifying the current thread, assigned round-robin on first use.
+uint32_t threadSlot() {
+    static AtomicUInt32 nextSlot;
+    static const thread_local uint32_t slot = nextSlot.fetchAndAdd(1);
+    return slot;
+}
+
+}  // namespace
+
+OpCounters::OpCounters()
+    : _shards(std::max<size_t>(
+          1, std::min<size_t>(ProcessInfo::getNumCores(), kMaxOpCounterShards))) {}
+
+OpCounters::Shard& OpCounters::_shard() {
+    return _shards[threadSlot() % _shards.size()];
+}
+
+uint32_t OpCounters::_sum(AtomicUInt32 Shard::*counter) const {
+    uint32_t total = 0;
+    for (auto&& shard : _shards) {
+        total += (shard.*counter).loadRelaxed();
+    }
+    return total;
+}
 
 void OpCounters::gotInserts(int n) {
     RARELY _checkWrap();
-    _insert.fetchAndAdd(n);
+    _shard().insert.fetchAndAdd(n);
 }
 
 void OpCounters::gotInsert() {
     RARELY _checkWrap();
-    _insert.fetchAndAdd(1);
+    _shard().insert.fetchAndAdd(1);
 }
 
 void OpCounters::gotQuery() {
     RARELY _checkWrap();
-    _query.fetchAndAdd(1);
+    _shard().query.fetchAndAdd(1);
 }
 
 void OpCounters::gotUpdate() {
     RARELY _checkWrap();
-    _update.fetchAndAdd(1);
+    _shard().update.fetchAndAdd(1);
 }
 
 void OpCounters::gotDelete() {
     RARELY _checkWrap();
-    _delete.fetchAndAdd(1);
+    _shard().deleted.fetchAndAdd(1);
 }
 
 void OpCounters::gotGetMore() {
     RARELY _checkWrap();
-    _getmore.fetchAndAdd(1);
+    _shard().getmore.fetchAndAdd(1);
 }
 
 void OpCounters::gotCommand() {
     RARELY _checkWrap();
-    _command.fetchAndAdd(1);
+    _shard().command.fetchAndAdd(1);
 }
 
 void OpCounters::gotOp(int op, bool isCommand) {
@@ -109,28 +137,53 @@ void OpCounters::gotOp(int op, bool isCommand) {
 void OpCounters::_checkWrap() {
     const unsigned MAX = 1 << 30;
 
-    bool wrap = _insert.loadRelaxed() > MAX || _query.loadRelaxed() > MAX ||
-        _update.loadRelaxed() > MAX || _delete.loadRelaxed() > MAX ||
-        _getmore.loadRelaxed() > MAX || _command.loadRelaxed() > MAX;
+    bool wrap = getInsert() > MAX || getQuery() > MAX || getUpdate() > MAX || getDelete() > MAX ||
+        getGetMore() > MAX || getCommand() > MAX;
 
     if (wrap) {
-        _insert.store(0);
-        _query.store(0);
-        _update.store(0);
-        _delete.store(0);
-        _getmore.store(0);
-        _command.store(0);
+        for (auto&& shard : _shards) {
+            shard.insert.store(0);
+            shard.query.store(0);
+            shard.update.store(0);
+            shard.deleted.store(0);
+            shard.getmore.store(0);
+            shard.command.store(0);
+        }
     }
 }
 
+uint32_t OpCounters::getInsert() const {
+    return _sum(&Shard::insert);
+}
+
+uint32_t OpCounters::getQuery() const {
+    return _sum(&Shard::query);
+}
+
+uint32_t OpCounters::getUpdate() const {
+    return _sum(&Shard::update);
+}
+
+uint32_t OpCounters::getDelete() const {
+    return _sum(&Shard::deleted);
+}
+
+uint32_t OpCounters::getGetMore() const {
+    return _sum(&Shard::getmore);
+}
+
+uint32_t OpCounters::getCommand() const {
+    return _sum(&Shard::command);
+}
+
 BSONObj OpCounters::getObj() const {
     BSONObjBuilder b;
-    b.append("insert", _insert.loadRelaxed());
-    b.append("query", _query.loadRelaxed());
-    b.append("update", _update.loadRelaxed());
-    b.append("delete", _delete.loadRelaxed());
-    b.append("getmore", _getmore.loadRelaxed());
-    b.append("command", _command.loadRelaxed());
+    b.append("insert", getInsert());
+    b.append("query", getQuery());
+    b.append("update", getUpdate());
+    b.append("delete", getDelete());
+    b.append("getmore", getGetMore());
+    b.append("command", getCommand());
     return b.obj();
 }
 
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
+#include <vector>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/basic.h"
@@ -58,35 +61,46 @@ public:
 
     BSONObj getObj() const;
 
-    // thse are used by snmp, and other things, do not remove
-    const AtomicUInt32* getInsert() const {
-        return &_insert;
-    }
-    const AtomicUInt32* getQuery() const {
-        return &_query;
-    }
-    const AtomicUInt32* getUpdate() const {
-        return &_update;
-    }
-    const AtomicUInt32* getDelete() const {
-        return &_delete;
-    }
-    const AtomicUInt32* getGetMore() const {
-        return &_getmore;
-    }
-    const AtomicUInt32* getCommand() const {
-        return &_command;
-    }
+    // these are used by snmp, and other things, do not remove; they return the sum over all
+    // shards at the time of the call
+    uint32_t getInsert() const;
+    uint32_t getQuery() const;
+    uint32_t getUpdate() const;
+    uint32_t getDelete() const;
+    uint32_t getGetMore() const;
+    uint32_t getCommand() const;
 
 private:
+    // Counters are sharded; each thread increments one shard's cache-line-aligned group of
+    // counters, so concurrent operations on many cores do not bounce a shared line between
+    // them. Readers sum the shards.
+    struct Shard {
+        AtomicUInt32 insert;
+        AtomicUInt32 query;
+        AtomicUInt32 update;
+        AtomicUInt32 deleted;
+        AtomicUInt32 getmore;
+        AtomicUInt32 command;
+    };
+    static_assert(sizeof(Shard) <= stdx::hardware_constructive_interference_size,
+                  "cache line spill");
+
+    template <typename T>
+    using AlignedVector = std::vector<T, boost::alignment::aligned_allocator<T>>;
+
+    /**
+     * Returns the shard this thread increments.
+     */
+    Shard& _shard();
+
+    /**
+     * Sums the given counter over all shards.
+     */
+    uint32_t _sum(AtomicUInt32 Shard::*counter) const;
+
     void _checkWrap();
 
-    CacheAligned<AtomicUInt32> _insert;
-    CacheAligned<AtomicUInt32> _query;
-    CacheAligned<AtomicUInt32> _update;
-    CacheAligned<AtomicUInt32> _delete;
-    CacheAligned<AtomicUInt32> _getmore;
-    CacheAligned<AtomicUInt32> _command;
+    AlignedVector<CacheAligned<Shard>> _shards;
 };
 
 extern OpCounters globalOpCounters;
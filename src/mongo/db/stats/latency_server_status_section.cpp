@@ -57,5 +57,30 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the per-query-shape latency histograms. The output grows with the number of distinct
+ * query shapes seen, so the section is opt-in: {serverStatus: 1, queryShapeLatencies: 1}, with
+ * {queryShapeLatencies: {histograms: true}} for full bucket detail.
+ */
+class QueryShapeLatencyServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapeLatencyServerStatusSection() : ServerStatusSection("queryShapeLatencies") {}
+
+    bool includeByDefault() const {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const {
+        BSONObjBuilder latencyBuilder;
+        bool includeHistograms = false;
+        if (configElem.type() == BSONType::Object) {
+            includeHistograms = configElem.Obj()["histograms"].trueValue();
+        }
+        Top::get(opCtx->getServiceContext())
+            .appendQueryShapeLatencyStats(includeHistograms, &latencyBuilder);
+        return latencyBuilder.obj();
+    }
+} queryShapeLatencyServerStatusSection;
 }  // namespace
 }  // namespace mongo
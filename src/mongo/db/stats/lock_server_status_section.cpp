@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/wait_time_attribution.h"
 
 namespace mongo {
 namespace {
@@ -57,6 +58,14 @@ public:
         for (ServiceContext::LockedClientsCursor cursor(opCtx->getClient()->getServiceContext());
              Client* client = cursor.next();) {
             invariant(client);
+
+            // Idle clients count as inactive without taking their lock; serverStatus is a
+            // sample, and skipping the lock keeps this scan cheap with many connections.
+            if (!client->hasActiveOperationContext()) {
+                clientStatusCounts[Locker::kInactive]++;
+                continue;
+            }
+
             stdx::unique_lock<Client> uniqueLock(*client);
 
             const OperationContext* clientOpCtx = client->getOperationContext();
@@ -126,5 +135,27 @@ public:
 
 } lockStatsServerStatusSection;
 
+
+/**
+ * Breaks lock and ticket wait time down by the database (and busiest collections) whose
+ * operations spent it, which the per-resource-type "locks" section cannot do.
+ */
+class LockWaitsServerStatusSection : public ServerStatusSection {
+public:
+    LockWaitsServerStatusSection() : ServerStatusSection("lockWaits") {}
+
+    virtual bool includeByDefault() const {
+        return true;
+    }
+
+    virtual BSONObj generateSection(OperationContext* opCtx,
+                                    const BSONElement& configElement) const {
+        BSONObjBuilder ret;
+        WaitTimeAttribution::get(opCtx->getServiceContext()).append(&ret);
+        return ret.obj();
+    }
+
+} lockWaitsServerStatusSection;
+
 }  // namespace
 }  // namespace mongo
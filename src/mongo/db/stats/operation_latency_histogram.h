@@ -53,6 +53,12 @@ public:
      */
     void increment(uint64_t latency, Command::ReadWriteType type);
 
+    /**
+     * Adds all of 'other''s bucket counts, operation counts and latency totals to this
+     * histogram. Used to merge per-shard histograms for reporting.
+     */
+    void add(const OperationLatencyHistogram& other);
+
     /**
      * Appends the four histograms with latency totals and operation counts.
      */
@@ -76,6 +82,8 @@ private:
 
     void _incrementData(uint64_t latency, int bucket, HistogramData* data);
 
+    static void _addData(const HistogramData& other, HistogramData* data);
+
     HistogramData _reads, _writes, _commands, _transactions;
 };
 }  // namespace mongo
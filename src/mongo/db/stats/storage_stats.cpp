@@ -77,6 +77,24 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     if (numRecords)
         result->append("avgObjSize", collection->averageObjectSize(opCtx));
 
+    // Everything below here requires walking the storage engine, which is too expensive to
+    // repeat per call when monitoring polls many collections. Unless the caller opts into an
+    // exact read with {exact: true}, serve those statistics from the snapshot maintained by the
+    // storage stats sampler. Snapshots are collected unscaled and without verbose output, so
+    // scaled and verbose requests always take the exact path.
+    if (!param["exact"].trueValue() && !verbose && scale == 1) {
+        StorageStatsCache& cache = StorageStatsCache::get(opCtx->getServiceContext());
+        boost::optional<StorageStatsCache::Snapshot> snapshot = cache.lookup(nss.ns());
+        if (!snapshot) {
+            // The sampler has not visited this collection yet; collect a snapshot now so this
+            // and subsequent calls are served from the cache.
+            snapshot = collectStorageStatsSnapshot(opCtx, collection);
+            cache.update(nss.ns(), *snapshot);
+        }
+        result->appendElements(snapshot->engineStats);
+        return Status::OK();
+    }
+
     RecordStore* recordStore = collection->getRecordStore();
     result->appendNumber(
         "storageSize",
@@ -112,6 +130,54 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     return Status::OK();
 }
 
+StorageStatsCache::Snapshot collectStorageStatsSnapshot(OperationContext* opCtx,
+                                                        Collection* collection) {
+    StorageStatsCache::Snapshot snapshot;
+    snapshot.numRecords = collection->numRecords(opCtx);
+    snapshot.dataSize = collection->dataSize(opCtx);
+
+    // The field order below matches what the exact path in appendCollectionStorageStats
+    // produces after "avgObjSize", so cached and exact responses are indistinguishable apart
+    // from freshness.
+    BSONObjBuilder engineStats;
+
+    RecordStore* recordStore = collection->getRecordStore();
+    snapshot.storageSize = static_cast<long long>(recordStore->storageSize(opCtx, &engineStats, 0));
+    engineStats.appendNumber("storageSize", snapshot.storageSize);
+
+    recordStore->appendCustomStats(opCtx, &engineStats, 1);
+
+    IndexCatalog* indexCatalog = collection->getIndexCatalog();
+    snapshot.numIndexes = indexCatalog->numIndexesReady(opCtx);
+    engineStats.append("nindexes", snapshot.numIndexes);
+
+    BSONObjBuilder indexDetails;
+
+    IndexCatalog::IndexIterator i = indexCatalog->getIndexIterator(opCtx, false);
+    while (i.more()) {
+        const IndexDescriptor* descriptor = i.next();
+        IndexAccessMethod* iam = indexCatalog->getIndex(descriptor);
+        invariant(iam);
+
+        BSONObjBuilder bob;
+        if (iam->appendCustomStats(opCtx, &bob, 1)) {
+            indexDetails.append(descriptor->indexName(), bob.obj());
+        }
+    }
+
+    engineStats.append("indexDetails", indexDetails.obj());
+
+    BSONObjBuilder indexSizes;
+    snapshot.indexSize = collection->getIndexSize(opCtx, &indexSizes, 1);
+
+    engineStats.appendNumber("totalIndexSize", snapshot.indexSize);
+    engineStats.append("indexSizes", indexSizes.obj());
+
+    snapshot.engineStats = engineStats.obj();
+    snapshot.refreshed = Date_t::now();
+    return snapshot;
+}
+
 Status appendCollectionRecordCount(OperationContext* opCtx,
                                    const NamespaceString& nss,
                                    BSONObjBuilder* result) {
@@ -33,16 +33,24 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/storage_stats_cache.h"
 
 namespace mongo {
 
+class Collection;
+
 /**
  * Appends to 'builder' storage related statistics for the collection represented by 'nss'.
  *
+ * The storage-engine-derived portion of the statistics is normally served from the snapshot
+ * maintained by the storage stats sampler; pass "exact" as true in 'param' to force a fresh
+ * walk of the storage engine. Scaled and verbose requests are always exact, since snapshots
+ * are collected unscaled and without verbose output.
+ *
  * Params:
  * opCtx
  * nss Fully qualified namespace.
- * param Uses "scale" (default = 1) and "verbose".
+ * param Uses "scale" (default = 1), "verbose" and "exact".
  * builder out; object the stats will be appended to.
  *
  * returns Status, (note "NamespaceNotFound" will fill result with 0-ed stats)
@@ -52,6 +60,13 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
                                     const BSONObj& param,
                                     BSONObjBuilder* builder);
 
+/**
+ * Collects a fresh StorageStatsCache snapshot for 'collection' by walking the storage engine.
+ * The caller must hold at least an IS lock on the collection.
+ */
+StorageStatsCache::Snapshot collectStorageStatsSnapshot(OperationContext* opCtx,
+                                                        Collection* collection);
+
 /**
  * Appends the collection record count to 'builder' for the collection represented by 'nss'.
  */
@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/storage_stats_cache.h"
+
+#include <utility>
+#include <vector>
+
+namespace mongo {
+
+namespace {
+const auto getStorageStatsCache = ServiceContext::declareDecoration<StorageStatsCache>();
+}  // namespace
+
+StorageStatsCache& StorageStatsCache::get(ServiceContext* svcCtx) {
+    return getStorageStatsCache(svcCtx);
+}
+
+boost::optional<StorageStatsCache::Snapshot> StorageStatsCache::lookup(StringData ns) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _snapshots.find(ns);
+    if (it == _snapshots.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void StorageStatsCache::update(StringData ns, Snapshot snapshot) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _snapshots[ns] = std::move(snapshot);
+}
+
+void StorageStatsCache::prune(const std::set<std::string>& keep) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // StringMap::erase invalidates iterators, so collect the doomed keys first.
+    std::vector<std::string> toErase;
+    for (const auto& entry : _snapshots) {
+        if (!keep.count(entry.first)) {
+            toErase.push_back(entry.first);
+        }
+    }
+
+    for (const std::string& ns : toErase) {
+        _snapshots.erase(ns);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <set>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/service_context.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * Per-collection snapshots of the storage-engine-derived statistics that back collStats and
+ * dbStats. Collecting those statistics walks storage engine internals and is far too expensive
+ * to repeat per call when monitoring polls tens of thousands of collections every minute, so a
+ * background sampler keeps snapshots fresh (see storage_stats_sampler.cpp) and the commands
+ * serve them directly unless the caller opts into an exact read.
+ */
+class StorageStatsCache {
+public:
+    struct Snapshot {
+        // The storage-engine-derived portion of the collStats response, collected unscaled and
+        // without verbose output, in the same field order as the exact path produces.
+        BSONObj engineStats;
+
+        // The collection's cheap counters as of collection time. dbStats sums storageSize and
+        // indexSize; numRecords/dataSize/numIndexes are the drift signal the sampler uses to
+        // prioritize refreshes.
+        long long numRecords = 0;
+        long long dataSize = 0;
+        long long storageSize = 0;
+        long long indexSize = 0;
+        int numIndexes = 0;
+
+        Date_t refreshed;
+    };
+
+    static StorageStatsCache& get(ServiceContext* svcCtx);
+
+    boost::optional<Snapshot> lookup(StringData ns) const;
+
+    void update(StringData ns, Snapshot snapshot);
+
+    /**
+     * Discards snapshots for namespaces not in 'keep'. Called by the sampler after enumerating
+     * the catalog so snapshots of dropped collections do not linger.
+     */
+    void prune(const std::set<std::string>& keep);
+
+private:
+    mutable stdx::mutex _mutex;
+    StringMap<Snapshot> _snapshots;
+};
+
+}  // namespace mongo
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/storage_stats_cache.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+StorageStatsCache::Snapshot makeSnapshot(long long storageSize) {
+    StorageStatsCache::Snapshot snapshot;
+    snapshot.storageSize = storageSize;
+    snapshot.engineStats = BSON("storageSize" << storageSize);
+    return snapshot;
+}
+
+TEST(StorageStatsCacheTest, LookupMissesOnUnknownNamespace) {
+    StorageStatsCache cache;
+    ASSERT_FALSE(cache.lookup("test.absent"));
+}
+
+TEST(StorageStatsCacheTest, UpdateThenLookupReturnsSnapshot) {
+    StorageStatsCache cache;
+    cache.update("test.a", makeSnapshot(100));
+    cache.update("test.a", makeSnapshot(200));
+
+    auto snapshot = cache.lookup("test.a");
+    ASSERT_TRUE(snapshot);
+    ASSERT_EQUALS(200, snapshot->storageSize);
+    ASSERT_BSONOBJ_EQ(BSON("storageSize" << 200LL), snapshot->engineStats);
+}
+
+TEST(StorageStatsCacheTest, PruneDropsNamespacesNotKept) {
+    StorageStatsCache cache;
+    cache.update("test.a", makeSnapshot(1));
+    cache.update("test.b", makeSnapshot(2));
+
+    cache.prune({"test.b"});
+
+    ASSERT_FALSE(cache.lookup("test.a"));
+    ASSERT_TRUE(cache.lookup("test.b"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,250 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/storage_stats_sampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_catalog_entry.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/storage_stats.h"
+#include "mongo/db/stats/storage_stats_cache.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+MONGO_EXPORT_SERVER_PARAMETER(storageStatsSamplerEnabled, bool, true);
+
+MONGO_EXPORT_SERVER_PARAMETER(storageStatsSamplerIntervalSecs, int, 60)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0)
+            return Status(ErrorCodes::BadValue,
+                          "storageStatsSamplerIntervalSecs must be strictly positive");
+        return Status::OK();
+    });
+
+// Upper bound on the number of collections whose snapshot is refreshed in a single pass, so a
+// pass over a catalog with many changed collections cannot monopolize the storage engine.
+// Collections are refreshed most-changed first; the rest wait for a later pass.
+MONGO_EXPORT_SERVER_PARAMETER(storageStatsSamplerMaxCollectionsPerPass, int, 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0)
+            return Status(ErrorCodes::BadValue,
+                          "storageStatsSamplerMaxCollectionsPerPass must be strictly positive");
+        return Status::OK();
+    });
+
+class StorageStatsSampler : public BackgroundJob {
+public:
+    StorageStatsSampler() {}
+    virtual ~StorageStatsSampler() {}
+
+    virtual std::string name() const {
+        return "StorageStatsSampler";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+
+        while (!globalInShutdownDeprecated()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(storageStatsSamplerIntervalSecs.load());
+            }
+
+            if (globalInShutdownDeprecated())
+                break;
+
+            if (!storageStatsSamplerEnabled.load()) {
+                LOG(1) << "storage stats sampler disabled";
+                continue;
+            }
+
+            try {
+                doSamplerPass();
+            } catch (const DBException& ex) {
+                warning() << "storage stats sampler pass failed"
+                          << causedBy(redact(ex.toStatus()));
+            }
+        }
+    }
+
+private:
+    struct Candidate {
+        NamespaceString nss;
+
+        // Relative drift of the cheap counters since the snapshot was taken; infinity for
+        // collections that have never been sampled.
+        double score;
+    };
+
+    void doSamplerPass() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+
+        StorageStatsCache& cache = StorageStatsCache::get(opCtx.getServiceContext());
+
+        std::vector<std::string> dbNames;
+        {
+            Lock::GlobalLock lk(&opCtx, MODE_IS);
+            opCtx.getServiceContext()->getStorageEngine()->listDatabases(&dbNames);
+        }
+
+        // Score every collection by how far its cheap counters (numRecords, dataSize, index
+        // count) have drifted from the snapshot, so the refresh budget is spent on the
+        // collections whose cached statistics are most stale. Collections with no drift keep
+        // their snapshot untouched; with 40k mostly idle collections this is what makes a pass
+        // cheap.
+        std::vector<Candidate> candidates;
+        std::set<std::string> seen;
+
+        for (const std::string& dbName : dbNames) {
+            if (globalInShutdownDeprecated())
+                return;
+
+            AutoGetDb autoDb(&opCtx, dbName, MODE_IS);
+            Database* db = autoDb.getDb();
+            if (!db)
+                continue;
+
+            std::list<std::string> namespaces;
+            db->getDatabaseCatalogEntry()->getCollectionNamespaces(&namespaces);
+
+            for (const std::string& ns : namespaces) {
+                Collection* collection = db->getCollection(&opCtx, ns);
+                if (!collection)
+                    continue;
+
+                seen.insert(ns);
+
+                auto snapshot = cache.lookup(ns);
+                double score;
+                if (!snapshot) {
+                    // Never sampled; takes priority over any drifted collection.
+                    score = std::numeric_limits<double>::infinity();
+                } else {
+                    const long long numRecords =
+                        static_cast<long long>(collection->numRecords(&opCtx));
+                    const long long dataSize =
+                        static_cast<long long>(collection->dataSize(&opCtx));
+                    const double drift =
+                        std::abs(static_cast<double>(numRecords - snapshot->numRecords)) +
+                        std::abs(static_cast<double>(dataSize - snapshot->dataSize));
+                    const bool indexesChanged =
+                        collection->getIndexCatalog()->numIndexesReady(&opCtx) !=
+                        snapshot->numIndexes;
+
+                    if (drift == 0 && !indexesChanged)
+                        continue;  // Snapshot is still accurate.
+
+                    score = drift /
+                        static_cast<double>(snapshot->numRecords + snapshot->dataSize + 1);
+                }
+
+                candidates.push_back({NamespaceString(ns), score});
+            }
+        }
+
+        cache.prune(seen);
+
+        const size_t maxPerPass =
+            static_cast<size_t>(storageStatsSamplerMaxCollectionsPerPass.load());
+        if (candidates.size() > maxPerPass) {
+            std::partial_sort(candidates.begin(),
+                              candidates.begin() + maxPerPass,
+                              candidates.end(),
+                              [](const Candidate& a, const Candidate& b) {
+                                  return a.score > b.score;
+                              });
+            candidates.resize(maxPerPass);
+        }
+
+        size_t refreshed = 0;
+        for (const Candidate& candidate : candidates) {
+            if (globalInShutdownDeprecated())
+                return;
+
+            try {
+                AutoGetCollectionForRead ctx(&opCtx, candidate.nss);
+                Collection* collection = ctx.getCollection();
+                if (!collection)
+                    continue;  // Dropped since scoring; a later pass prunes the snapshot.
+
+                cache.update(candidate.nss.ns(),
+                             collectStorageStatsSnapshot(&opCtx, collection));
+                refreshed++;
+            } catch (const DBException& ex) {
+                LOG(1) << "storage stats sample of " << candidate.nss << " failed"
+                       << causedBy(redact(ex.toStatus()));
+            }
+        }
+
+        LOG(1) << "storage stats sampler pass refreshed " << refreshed << " collections";
+    }
+};
+
+namespace {
+// The global StorageStatsSampler object is intentionally leaked.  Even though it is only used
+// in one function, we declare it here to indicate to the leak sanitizer that the leak of this
+// object should not be reported.
+StorageStatsSampler* storageStatsSampler = nullptr;
+}  // namespace
+
+void startStorageStatsSamplerBackgroundJob() {
+    storageStatsSampler = new StorageStatsSampler();
+    storageStatsSampler->go();
+}
+
+}  // namespace mongo
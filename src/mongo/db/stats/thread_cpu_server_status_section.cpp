@@ -0,0 +1,178 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/jsobj.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#endif  // __linux__
+
+namespace mongo {
+namespace {
+
+#ifdef __linux__
+
+struct ThreadGroupCpu {
+    long long count = 0;
+    unsigned long long userTicks = 0;
+    unsigned long long systemTicks = 0;
+};
+
+/**
+ * Parses a /proc/self/task/<tid>/stat line into the thread name and its cumulative user and
+ * system CPU ticks. Returns false on any parse problem; threads come and go while the task
+ * directory is scanned, so failures here are expected and simply skipped.
+ */
+bool parseTaskStatLine(const std::string& line, std::string* name, ThreadGroupCpu* cpu) {
+    // The thread name is parenthesized and may itself contain spaces and parentheses, so scan
+    // from the last ')'. The fields after it are space-separated, starting with field 3
+    // (state); utime and stime are fields 14 and 15 of the stat line.
+    size_t open = line.find('(');
+    size_t close = line.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) {
+        return false;
+    }
+    *name = line.substr(open + 1, close - open - 1);
+
+    std::istringstream rest(line.substr(close + 1));
+    std::string token;
+    for (int field = 3; field <= 15 && (rest >> token); field++) {
+        if (field == 14) {
+            cpu->userTicks = strtoull(token.c_str(), nullptr, 10);
+        } else if (field == 15) {
+            cpu->systemTicks = strtoull(token.c_str(), nullptr, 10);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Strips a trailing number from a thread name so that per-connection and per-pool threads
+ * ("conn1234", "WTJournalFlusher", "ftdc") aggregate into one entry per thread role.
+ */
+std::string threadGroupName(const std::string& name) {
+    size_t end = name.size();
+    while (end > 0 && std::isdigit(static_cast<unsigned char>(name[end - 1]))) {
+        end--;
+    }
+    return end ? name.substr(0, end) : name;
+}
+
+#endif  // __linux__
+
+/**
+ * Reports cumulative CPU time per thread role, aggregated from /proc/self/task. This attributes
+ * CPU between subsystems (connection threads, journal flusher, checkpointer, ...) on hosts
+ * where attaching an external profiler is not possible. Reading procfs costs one pass over the
+ * task directory, so the section is opt-in: {serverStatus: 1, threadCpu: 1}.
+ */
+class ThreadCpuServerStatusSection final : public ServerStatusSection {
+public:
+    ThreadCpuServerStatusSection() : ServerStatusSection("threadCpu") {}
+
+    bool includeByDefault() const {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const {
+#ifndef __linux__
+        return BSON("supported" << false);
+#else
+        const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+        if (ticksPerSecond <= 0) {
+            return BSON("supported" << false);
+        }
+
+        std::map<std::string, ThreadGroupCpu> groups;
+
+        boost::system::error_code ec;
+        boost::filesystem::directory_iterator it("/proc/self/task", ec);
+        if (ec) {
+            return BSON("supported" << false);
+        }
+        for (; it != boost::filesystem::directory_iterator(); ++it) {
+            std::ifstream stat((it->path() / "stat").string());
+            std::string line;
+            if (!stat || !std::getline(stat, line)) {
+                continue;  // The thread exited mid-scan.
+            }
+
+            std::string name;
+            ThreadGroupCpu cpu;
+            if (!parseTaskStatLine(line, &name, &cpu)) {
+                continue;
+            }
+
+            auto& group = groups[threadGroupName(name)];
+            group.count++;
+            group.userTicks += cpu.userTicks;
+            group.systemTicks += cpu.systemTicks;
+        }
+
+        // Emit in decreasing CPU order so the biggest consumers read first.
+        std::vector<std::pair<std::string, ThreadGroupCpu>> ordered(groups.begin(), groups.end());
+        std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+            return a.second.userTicks + a.second.systemTicks >
+                b.second.userTicks + b.second.systemTicks;
+        });
+
+        const double msPerTick = 1000.0 / ticksPerSecond;
+        BSONObjBuilder result;
+        BSONObjBuilder threads(result.subobjStart("threads"));
+        for (const auto& entry : ordered) {
+            BSONObjBuilder group(threads.subobjStart(entry.first));
+            group.append("threads", entry.second.count);
+            group.append("userMs",
+                         static_cast<long long>(entry.second.userTicks * msPerTick));
+            group.append("systemMs",
+                         static_cast<long long>(entry.second.systemTicks * msPerTick));
+            group.doneFast();
+        }
+        threads.doneFast();
+        return result.obj();
+#endif  // __linux__
+    }
+} threadCpuServerStatusSection;
+
+}  // namespace
+}  // namespace mongo
@@ -35,7 +35,11 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/hex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/processinfo.h"
 
 namespace mongo {
 
@@ -48,6 +52,21 @@ namespace {
 
 const auto getTop = ServiceContext::declareDecoration<Top>();
 
+// Upper bound on the number of distinct query shapes tracked per shard with their own latency
+// histogram. A histogram set is a few kilobytes, so this caps the memory of the shape table
+// while covering far more shapes than a reasonable workload produces.
+const size_t kMaxTrackedQueryShapes = 1024;
+
+// Upper bound on the number of shards; beyond this, extra cores share shards.
+const size_t kMaxTopShards = 64;
+
+// Returns a small integer identifying the current thread, assigned round-robin on first use.
+uint32_t threadSlot() {
+    static AtomicUInt32 nextSlot;
+    static const thread_local uint32_t slot = nextSlot.fetchAndAdd(1);
+    return slot;
+}
+
 }  // namespace
 
 Top::UsageData::UsageData(const UsageData& older, const UsageData& newer) {
@@ -67,11 +86,32 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       remove(older.remove, newer.remove),
       commands(older.commands, newer.commands) {}
 
+void Top::CollectionData::add(const CollectionData& other) {
+    total.add(other.total);
+    readLock.add(other.readLock);
+    writeLock.add(other.writeLock);
+    queries.add(other.queries);
+    getmore.add(other.getmore);
+    insert.add(other.insert);
+    update.add(other.update);
+    remove.add(other.remove);
+    commands.add(other.commands);
+    opLatencyHistogram.add(other.opLatencyHistogram);
+}
+
+Top::Top()
+    : _numShards(std::max<size_t>(1, std::min<size_t>(ProcessInfo::getNumCores(), kMaxTopShards))),
+      _shards(new Shard[_numShards]) {}
+
 // static
 Top& Top::get(ServiceContext* service) {
     return getTop(service);
 }
 
+Top::Shard& Top::_shardForCurrentThread() const {
+    return _shards[threadSlot() % _numShards];
+}
+
 void Top::record(OperationContext* opCtx,
                  StringData ns,
                  LogicalOp logicalOp,
@@ -83,15 +123,16 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::HashedKey(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    Shard& shard = _shardForCurrentThread();
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
 
     if ((command || logicalOp == LogicalOp::opQuery) &&
-        _collDropNs.find(ns.toString()) != _collDropNs.end()) {
-        _collDropNs.erase(ns.toString());
+        shard.collDropNs.find(ns.toString()) != shard.collDropNs.end()) {
+        shard.collDropNs.erase(ns.toString());
         return;
     }
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = shard.usage[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
@@ -141,24 +182,39 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(StringData ns, bool databaseDropped) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(ns);
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<SimpleMutex> lk(_shards[i].lock);
+        _shards[i].usage.erase(ns);
+    }
 
     if (!databaseDropped) {
         // If a collection drop occurred, there will be a subsequent call to record for this
-        // collection namespace which must be ignored. This does not apply to a database drop.
-        _collDropNs.insert(ns.toString());
+        // collection namespace which must be ignored. That call happens on the thread running
+        // the drop, so the marker only needs to go into this thread's shard.
+        Shard& shard = _shardForCurrentThread();
+        stdx::lock_guard<SimpleMutex> lk(shard.lock);
+        shard.collDropNs.insert(ns.toString());
+    }
+}
+
+void Top::_mergeUsage(UsageMap& out) const {
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<SimpleMutex> lk(_shards[i].lock);
+        for (auto&& entry : _shards[i].usage) {
+            out[entry.first].add(entry.second);
+        }
     }
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out = UsageMap();
+    _mergeUsage(out);
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    UsageMap merged;
+    _mergeUsage(merged);
+    _appendToUsageMap(b, merged);
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -200,10 +256,16 @@ void Top::_appendStatsEntry(BSONObjBuilder& b, const char* statsName, const Usag
 }
 
 void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuilder* builder) {
-    auto hashedNs = UsageMap::HashedKey(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    OperationLatencyHistogram merged;
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<SimpleMutex> lk(_shards[i].lock);
+        auto it = _shards[i].usage.find(ns);
+        if (it != _shards[i].usage.end()) {
+            merged.add(it->second.opLatencyHistogram);
+        }
+    }
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, &latencyStatsBuilder);
+    merged.append(includeHistograms, &latencyStatsBuilder);
     builder->append("ns", ns);
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -211,18 +273,71 @@ void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuild
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    Shard& shard = _shardForCurrentThread();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    _incrementHistogram(opCtx, latency, &shard.globalHistogramStats, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, builder);
+    OperationLatencyHistogram merged;
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<SimpleMutex> guard(_shards[i].lock);
+        merged.add(_shards[i].globalHistogramStats);
+    }
+    merged.append(includeHistograms, builder);
+}
+
+void Top::incrementQueryShapeLatencyStats(OperationContext* opCtx,
+                                          StringData ns,
+                                          uint32_t queryHash,
+                                          uint64_t latency,
+                                          Command::ReadWriteType readWriteType) {
+    std::string key = str::stream() << ns << " " << unsignedIntToFixedLengthHex(queryHash);
+    Shard& shard = _shardForCurrentThread();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    auto it = shard.queryShapeHistograms.find(key);
+    if (it == shard.queryShapeHistograms.end()) {
+        if (shard.queryShapeHistograms.size() >= kMaxTrackedQueryShapes) {
+            shard.untrackedQueryShapeOps++;
+            return;
+        }
+        it = shard.queryShapeHistograms.emplace(key, OperationLatencyHistogram()).first;
+    }
+    _incrementHistogram(opCtx, latency, &it->second, readWriteType);
+}
+
+void Top::appendQueryShapeLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
+    StringMap<OperationLatencyHistogram> merged;
+    long long untrackedOps = 0;
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<SimpleMutex> guard(_shards[i].lock);
+        for (auto&& entry : _shards[i].queryShapeHistograms) {
+            merged[entry.first].add(entry.second);
+        }
+        untrackedOps += _shards[i].untrackedQueryShapeOps;
+    }
+
+    // Sort the keys so shapes for the same namespace read together.
+    vector<string> keys;
+    for (auto&& entry : merged) {
+        keys.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    BSONObjBuilder shapesBuilder(builder->subobjStart("shapes"));
+    for (auto&& key : keys) {
+        BSONObjBuilder shapeBuilder(shapesBuilder.subobjStart(key));
+        merged.find(key)->second.append(includeHistograms, &shapeBuilder);
+        shapeBuilder.done();
+    }
+    shapesBuilder.done();
+    builder->appendNumber("untrackedOps", untrackedOps);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    Shard& shard = _shardForCurrentThread();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    shard.globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
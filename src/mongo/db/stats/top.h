@@ -30,6 +30,8 @@
 #pragma once
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <memory>
+#include <set>
 
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
@@ -48,7 +50,7 @@ class Top {
 public:
     static Top& get(ServiceContext* service);
 
-    Top() = default;
+    Top();
 
     struct UsageData {
         UsageData() : time(0), count(0) {}
@@ -60,6 +62,11 @@ public:
             count++;
             time += micros;
         }
+
+        void add(const UsageData& other) {
+            time += other.time;
+            count += other.count;
+        }
     };
 
     struct CollectionData {
@@ -69,6 +76,11 @@ public:
         CollectionData() {}
         CollectionData(const CollectionData& older, const CollectionData& newer);
 
+        /**
+         * Adds another shard's data for the same collection into this one.
+         */
+        void add(const CollectionData& other);
+
         UsageData total;
 
         UsageData readLock;
@@ -128,7 +140,50 @@ public:
      */
     void appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder);
 
+    /**
+     * Increments the latency histogram for the query shape identified by 'queryHash' against
+     * 'ns'. Tracks a bounded number of shapes; once the table is full, operations with new
+     * shapes are counted but not bucketed.
+     */
+    void incrementQueryShapeLatencyStats(OperationContext* opCtx,
+                                         StringData ns,
+                                         uint32_t queryHash,
+                                         uint64_t latency,
+                                         Command::ReadWriteType readWriteType);
+
+    /**
+     * Appends per-query-shape latency statistics, keyed by "<ns> <queryHash>".
+     */
+    void appendQueryShapeLatencyStats(bool includeHistograms, BSONObjBuilder* builder);
+
 private:
+    /**
+     * All mutable state is sharded; each thread records into one shard, so concurrent
+     * operations neither serialize on a single mutex nor bounce one set of cache lines between
+     * cores. Readers merge every shard. A shard is much larger than a cache line, so adjacent
+     * shards do not false-share.
+     */
+    struct Shard {
+        mutable SimpleMutex lock;
+        OperationLatencyHistogram globalHistogramStats;
+        UsageMap usage;
+        std::set<std::string> collDropNs;
+        StringMap<OperationLatencyHistogram> queryShapeHistograms;
+        long long untrackedQueryShapeOps = 0;
+    };
+
+    /**
+     * Returns the shard this thread records into. Threads are assigned to shards round-robin
+     * on first use, so a thread always sees its own recent writes (which the collection-drop
+     * bookkeeping in record() relies on).
+     */
+    Shard& _shardForCurrentThread() const;
+
+    /**
+     * Merges every shard's usage map into 'out'.
+     */
+    void _mergeUsage(UsageMap& out) const;
+
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
@@ -145,10 +200,8 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
-    std::set<std::string> _collDropNs;
+    const size_t _numShards;
+    const std::unique_ptr<Shard[]> _shards;
 };
 
 }  // namespace mongo
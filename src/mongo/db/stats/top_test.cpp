@@ -39,4 +39,12 @@ TEST(TopTest, CollectionDropped) {
     Top().collectionDropped("coll");
 }
 
+TEST(TopTest, QueryShapeLatencyStatsStartEmpty) {
+    BSONObjBuilder builder;
+    Top().appendQueryShapeLatencyStats(false, &builder);
+    BSONObj stats = builder.obj();
+    ASSERT_TRUE(stats["shapes"].Obj().isEmpty());
+    ASSERT_EQUALS(0, stats["untrackedOps"].numberLong());
+}
+
 }  // namespace
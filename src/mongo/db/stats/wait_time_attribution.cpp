@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_time_attribution.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getWaitTimeAttribution = ServiceContext::declareDecoration<WaitTimeAttribution>();
+
+// Number of collections listed individually in the report; everything is always accounted for
+// in its database's totals regardless of making this list.
+const size_t kTopCollections = 10;
+
+}  // namespace
+
+WaitTimeAttribution& WaitTimeAttribution::get(ServiceContext* service) {
+    return getWaitTimeAttribution(service);
+}
+
+void WaitTimeAttribution::record(StringData ns,
+                                 long long lockWaitMicros,
+                                 long long ticketWaitMicros) {
+    auto& partition = _partition(ns);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    WaitData& data = partition.byNs[ns];
+    data.lockWaitMicros += lockWaitMicros;
+    data.ticketWaitMicros += ticketWaitMicros;
+    data.ops++;
+}
+
+void WaitTimeAttribution::append(BSONObjBuilder* builder) {
+    // Snapshot every stripe, then aggregate outside the mutexes. std::map keeps databases and
+    // namespaces in sorted order for the report.
+    std::map<std::string, WaitData> byNs;
+    for (size_t i = 0; i < kNumPartitions; i++) {
+        stdx::lock_guard<SimpleMutex> lk(_partitions[i].mutex);
+        for (auto&& entry : _partitions[i].byNs) {
+            byNs[entry.first] = entry.second;
+        }
+    }
+
+    std::map<std::string, WaitData> byDatabase;
+    for (auto&& entry : byNs) {
+        WaitData& data = byDatabase[nsToDatabaseSubstring(entry.first).toString()];
+        data.lockWaitMicros += entry.second.lockWaitMicros;
+        data.ticketWaitMicros += entry.second.ticketWaitMicros;
+        data.ops += entry.second.ops;
+    }
+
+    BSONObjBuilder databasesBuilder(builder->subobjStart("databases"));
+    for (auto&& entry : byDatabase) {
+        BSONObjBuilder dbBuilder(databasesBuilder.subobjStart(entry.first));
+        dbBuilder.appendNumber("lockWaitMicros", entry.second.lockWaitMicros);
+        dbBuilder.appendNumber("ticketWaitMicros", entry.second.ticketWaitMicros);
+        dbBuilder.appendNumber("ops", entry.second.ops);
+        dbBuilder.doneFast();
+    }
+    databasesBuilder.doneFast();
+
+    std::vector<std::pair<std::string, WaitData>> ordered(byNs.begin(), byNs.end());
+    std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return a.second.lockWaitMicros + a.second.ticketWaitMicros >
+            b.second.lockWaitMicros + b.second.ticketWaitMicros;
+    });
+    if (ordered.size() > kTopCollections) {
+        ordered.resize(kTopCollections);
+    }
+
+    BSONArrayBuilder topBuilder(builder->subarrayStart("topCollections"));
+    for (auto&& entry : ordered) {
+        BSONObjBuilder nsBuilder(topBuilder.subobjStart());
+        nsBuilder.append("ns", entry.first);
+        nsBuilder.appendNumber("lockWaitMicros", entry.second.lockWaitMicros);
+        nsBuilder.appendNumber("ticketWaitMicros", entry.second.ticketWaitMicros);
+        nsBuilder.appendNumber("ops", entry.second.ops);
+        nsBuilder.doneFast();
+    }
+    topBuilder.doneFast();
+}
+
+WaitTimeAttribution::Partition& WaitTimeAttribution::_partition(StringData ns) {
+    return _partitions[StringMapTraits::hash(ns) % kNumPartitions];
+}
+
+}  // namespace mongo
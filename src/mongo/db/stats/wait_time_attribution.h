@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class ServiceContext;
+
+/**
+ * Attributes lock and ticket wait time to the namespaces whose operations spent it. The global
+ * LockStats aggregate per resource type, which on a multi-tenant node cannot tell which
+ * database's workload is queueing; the per-locker wait counters are flushed here once per
+ * operation, keyed by the operation's namespace.
+ */
+class WaitTimeAttribution {
+public:
+    static WaitTimeAttribution& get(ServiceContext* service);
+
+    WaitTimeAttribution() = default;
+
+    /**
+     * Adds one completed operation's lock and ticket wait time to the totals for 'ns'.
+     */
+    void record(StringData ns, long long lockWaitMicros, long long ticketWaitMicros);
+
+    /**
+     * Appends the per-database wait totals and the collections with the largest combined wait
+     * time.
+     */
+    void append(BSONObjBuilder* builder);
+
+private:
+    struct WaitData {
+        long long lockWaitMicros = 0;
+        long long ticketWaitMicros = 0;
+        long long ops = 0;
+    };
+
+    // Waits are recorded into a set of maps striped by namespace hash so operations completing
+    // concurrently do not all serialize on one mutex; reporting walks every stripe.
+    static const size_t kNumPartitions = 8;
+
+    struct Partition {
+        SimpleMutex mutex;
+        StringMap<WaitData> byNs;
+    };
+
+    Partition& _partition(StringData ns);
+
+    Partition _partitions[kNumPartitions];
+};
+
+}  // namespace mongo
@@ -32,6 +32,7 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/snapshot_window_options.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
 #include "mongo/db/storage/key_string.h"
@@ -45,6 +46,11 @@
 namespace mongo {
 namespace biggie {
 
+// When enabled, record stores additionally shred inserted documents into per-field column
+// entries so that scans needing only a few fields can read just those columns. Intended for
+// in-memory analytics replicas; costs extra memory and write work per document.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(biggieColumnarMode, bool, false);
+
 mongo::RecoveryUnit* KVEngine::newRecoveryUnit() {
     return new RecoveryUnit(this, nullptr);
 }
@@ -67,6 +73,9 @@ std::unique_ptr<::mongo::RecordStore> KVEngine::getRecordStore(OperationContext*
                                                                StringData ident,
                                                                const CollectionOptions& options) {
     // TODO: deal with options.
+    if (biggieColumnarMode) {
+        return std::make_unique<ColumnarRecordStore>(ns, ident);
+    }
     return std::make_unique<RecordStore>(ns, ident);
 }
 
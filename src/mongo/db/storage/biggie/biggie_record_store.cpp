@@ -37,6 +37,7 @@
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
 
 #include "mongo/db/storage/biggie/biggie_record_store.h"
+#include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
@@ -432,5 +433,166 @@ void RecordStore::ReverseCursor::reattachToOperationContext(OperationContext* op
 bool RecordStore::ReverseCursor::inPrefix(const std::string& key_string) {
     return (key_string > _prefix) && (key_string < _postfix);
 }
+
+// Columnar variant
+
+ColumnarRecordStore::ColumnarRecordStore(StringData ns,
+                                         StringData ident,
+                                         bool isCapped,
+                                         int64_t cappedMaxSize,
+                                         int64_t cappedMaxDocs,
+                                         CappedCallback* cappedCallback)
+    : RecordStore(ns, ident, isCapped, cappedMaxSize, cappedMaxDocs, cappedCallback),
+      // The '+' separator keeps the column idents out of the document key range: in the
+      // KeyString encoding every document key continues with a 0x00 string terminator where a
+      // column key has '+', so column entries sort strictly after the documents and the base
+      // class's prefix scans never see them.
+      _columnIdentBase(std::string(ident.rawData(), ident.size()) + "+") {}
+
+const char* ColumnarRecordStore::name() const {
+    return "biggieColumnar";
+}
+
+std::string ColumnarRecordStore::_columnIdent(StringData fieldName) const {
+    return _columnIdentBase + fieldName.toString();
+}
+
+void ColumnarRecordStore::_shredDocument(StringStore* workingCopy,
+                                         int64_t recordId,
+                                         const char* data,
+                                         int len) {
+    if (len < BSONObj::kMinBSONLength || !validateBSON(data, len, BSONVersion::kLatest).isOK()) {
+        // Not a BSON document; nothing to shred.
+        return;
+    }
+    BSONObj obj(data);
+    for (auto&& elem : obj) {
+        StringStore::value_type vt{createKey(_columnIdent(elem.fieldNameStringData()), recordId),
+                                   std::string(elem.rawdata(), elem.size())};
+        workingCopy->insert(std::move(vt));
+    }
+}
+
+void ColumnarRecordStore::_unshredDocument(StringStore* workingCopy,
+                                           int64_t recordId,
+                                           const char* data,
+                                           int len) {
+    if (len < BSONObj::kMinBSONLength || !validateBSON(data, len, BSONVersion::kLatest).isOK()) {
+        return;
+    }
+    BSONObj obj(data);
+    for (auto&& elem : obj) {
+        workingCopy->erase(createKey(_columnIdent(elem.fieldNameStringData()), recordId));
+    }
+}
+
+void ColumnarRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& dl) {
+    // Copy the document before erasing anything; the RecordData points into the store.
+    RecordData rd;
+    invariant(findRecord(opCtx, dl, &rd));
+    const BSONObj oldDoc = rd.toBson().getOwned();
+
+    RecordStore::deleteRecord(opCtx, dl);
+    _unshredDocument(
+        getRecoveryUnitBranch_forking(opCtx), dl.repr(), oldDoc.objdata(), oldDoc.objsize());
+}
+
+StatusWith<RecordId> ColumnarRecordStore::insertRecord(OperationContext* opCtx,
+                                                       const char* data,
+                                                       int len,
+                                                       Timestamp ts) {
+    StatusWith<RecordId> res = RecordStore::insertRecord(opCtx, data, len, ts);
+    if (res.isOK()) {
+        _shredDocument(getRecoveryUnitBranch_forking(opCtx), res.getValue().repr(), data, len);
+    }
+    return res;
+}
+
+Status ColumnarRecordStore::insertRecordsWithDocWriter(OperationContext* opCtx,
+                                                       const DocWriter* const* docs,
+                                                       const Timestamp* timestamps,
+                                                       size_t nDocs,
+                                                       RecordId* idsOut) {
+    Status status =
+        RecordStore::insertRecordsWithDocWriter(opCtx, docs, timestamps, nDocs, idsOut);
+    if (!status.isOK()) {
+        return status;
+    }
+    for (size_t i = 0; i < nDocs; i++) {
+        RecordData rd;
+        invariant(findRecord(opCtx, idsOut[i], &rd));
+        _shredDocument(
+            getRecoveryUnitBranch_forking(opCtx), idsOut[i].repr(), rd.data(), rd.size());
+    }
+    return Status::OK();
+}
+
+Status ColumnarRecordStore::updateRecord(OperationContext* opCtx,
+                                         const RecordId& oldLocation,
+                                         const char* data,
+                                         int len) {
+    RecordData rd;
+    invariant(findRecord(opCtx, oldLocation, &rd));
+    const BSONObj oldDoc = rd.toBson().getOwned();
+
+    Status status = RecordStore::updateRecord(opCtx, oldLocation, data, len);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    StringStore* workingCopy = getRecoveryUnitBranch_forking(opCtx);
+    _unshredDocument(workingCopy, oldLocation.repr(), oldDoc.objdata(), oldDoc.objsize());
+    _shredDocument(workingCopy, oldLocation.repr(), data, len);
+    return Status::OK();
+}
+
+Status ColumnarRecordStore::truncate(OperationContext* opCtx) {
+    Status status = RecordStore::truncate(opCtx);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // All column entries live under idents beginning with _columnIdentBase, so they fall
+    // between the key for that exact ident and the key for the ident with the separator
+    // bumped to the next byte value.
+    StringStore* workingCopy = getRecoveryUnitBranch_forking(opCtx);
+    std::string colStart = createKey(_columnIdentBase, 0);
+    std::string colEnd =
+        createKey(_columnIdentBase.substr(0, _columnIdentBase.size() - 1) + ',', 0);
+    StringStore::const_iterator it = workingCopy->lower_bound(colStart);
+    std::vector<std::string> keysToErase;
+    while (it != workingCopy->end() && it->first < colEnd) {
+        keysToErase.push_back(it->first);
+        ++it;
+    }
+    for (auto& k : keysToErase) {
+        workingCopy->erase(k);
+    }
+    return Status::OK();
+}
+
+size_t ColumnarRecordStore::scanColumn(
+    OperationContext* opCtx,
+    StringData fieldName,
+    const stdx::function<bool(const RecordId&, const BSONElement&)>& callback) const {
+    StringStore* workingCopy = getRecoveryUnitBranch_forking(opCtx);
+    const std::string ident = _columnIdent(fieldName);
+    std::string prefix = createKey(ident, 0);
+    std::string postfix = createKey(ident, std::numeric_limits<int64_t>::max());
+
+    size_t nVisited = 0;
+    StringStore::const_iterator it = workingCopy->lower_bound(prefix);
+    StringStore::const_iterator end = workingCopy->upper_bound(postfix);
+    while (it != end) {
+        RecordId rid(extractRecordId(it->first));
+        BSONElement elem(it->second.c_str());
+        nVisited++;
+        if (!callback(rid, elem)) {
+            break;
+        }
+        ++it;
+    }
+    return nVisited;
+}
 }  // namespace biggie
 }  // namespace mongo
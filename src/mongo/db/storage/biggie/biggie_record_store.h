@@ -34,11 +34,13 @@
 #include <boost/shared_array.hpp>
 #include <map>
 
+#include "mongo/bson/bsonelement.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/biggie/store.h"
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
 
 namespace mongo {
@@ -183,5 +185,66 @@ private:
         bool inPrefix(const std::string& key_string);
     };
 };
+
+/**
+ * A RecordStore variant for analytics workloads that, in addition to storing whole documents,
+ * shreds each inserted BSON document into one column entry per top-level field. A scan that
+ * needs only a couple of fields can then read just those columns via scanColumn() instead of
+ * the full documents. Records that are not valid BSON are stored normally but contribute no
+ * column entries.
+ */
+class ColumnarRecordStore final : public RecordStore {
+public:
+    explicit ColumnarRecordStore(StringData ns,
+                                 StringData ident,
+                                 bool isCapped = false,
+                                 int64_t cappedMaxSize = -1,
+                                 int64_t cappedMaxDocs = -1,
+                                 CappedCallback* cappedCallback = nullptr);
+
+    virtual const char* name() const;
+
+    virtual void deleteRecord(OperationContext* opCtx, const RecordId& dl);
+
+    virtual StatusWith<RecordId> insertRecord(OperationContext* opCtx,
+                                              const char* data,
+                                              int len,
+                                              Timestamp);
+
+    virtual Status insertRecordsWithDocWriter(OperationContext* opCtx,
+                                              const DocWriter* const* docs,
+                                              const Timestamp* timestamps,
+                                              size_t nDocs,
+                                              RecordId* idsOut);
+
+    virtual Status updateRecord(OperationContext* opCtx,
+                                const RecordId& oldLocation,
+                                const char* data,
+                                int len);
+
+    virtual Status truncate(OperationContext* opCtx);
+
+    /**
+     * Invokes 'callback' with the RecordId and stored value of 'fieldName' for every document
+     * that has that top-level field, in RecordId order, stopping early if the callback returns
+     * false. The BSONElement points into the store and is only valid for the duration of the
+     * call. Returns the number of values visited.
+     */
+    size_t scanColumn(OperationContext* opCtx,
+                      StringData fieldName,
+                      const stdx::function<bool(const RecordId&, const BSONElement&)>& callback)
+        const;
+
+private:
+    /**
+     * Returns the ident under which the column entries for 'fieldName' are stored.
+     */
+    std::string _columnIdent(StringData fieldName) const;
+
+    void _shredDocument(StringStore* workingCopy, int64_t recordId, const char* data, int len);
+    void _unshredDocument(StringStore* workingCopy, int64_t recordId, const char* data, int len);
+
+    std::string _columnIdentBase;
+};
 }  // namespace biggie
 }  // namespace mongo
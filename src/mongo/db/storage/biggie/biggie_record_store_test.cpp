@@ -83,6 +83,100 @@ MONGO_INITIALIZER(RegisterHarnessFactory)(InitializerContext* const) {
     mongo::registerHarnessHelperFactory(makeHarnessHelper);
     return Status::OK();
 }
+
+TEST(BiggieColumnarRecordStoreTest, ScanColumnReadsOnlyRequestedField) {
+    RecordStoreHarnessHelper harnessHelper;
+    ColumnarRecordStore rs("a.b", "ident"_sd, false, 0, 0, nullptr);
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    std::vector<RecordId> locs;
+    for (int i = 0; i < 3; i++) {
+        WriteUnitOfWork uow(opCtx.get());
+        BSONObj doc = BSON("a" << i << "b" << (i * 10));
+        StatusWith<RecordId> res =
+            rs.insertRecord(opCtx.get(), doc.objdata(), doc.objsize(), Timestamp());
+        ASSERT_OK(res.getStatus());
+        locs.push_back(res.getValue());
+        uow.commit();
+    }
+
+    // A record that is not BSON is stored normally but contributes no column entries.
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        std::string data = "not bson";
+        ASSERT_OK(
+            rs.insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp()).getStatus());
+        uow.commit();
+    }
+
+    int i = 0;
+    size_t n = rs.scanColumn(opCtx.get(), "a", [&](const RecordId& rid, const BSONElement& elem) {
+        ASSERT_EQUALS(locs[i], rid);
+        ASSERT_EQUALS(i, elem.numberInt());
+        i++;
+        return true;
+    });
+    ASSERT_EQUALS(3u, n);
+
+    // The column entries are invisible to document reads.
+    ASSERT_EQUALS(4, rs.numRecords(opCtx.get()));
+    RecordData rd;
+    ASSERT(rs.findRecord(opCtx.get(), locs[1], &rd));
+    ASSERT_BSONOBJ_EQ(BSON("a" << 1 << "b" << 10), rd.toBson());
+}
+
+TEST(BiggieColumnarRecordStoreTest, ColumnsFollowUpdatesDeletesAndTruncate) {
+    RecordStoreHarnessHelper harnessHelper;
+    ColumnarRecordStore rs("a.b", "ident"_sd, false, 0, 0, nullptr);
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    std::vector<RecordId> locs;
+    for (int i = 0; i < 3; i++) {
+        WriteUnitOfWork uow(opCtx.get());
+        BSONObj doc = BSON("a" << i << "b" << (i * 10));
+        StatusWith<RecordId> res =
+            rs.insertRecord(opCtx.get(), doc.objdata(), doc.objsize(), Timestamp());
+        ASSERT_OK(res.getStatus());
+        locs.push_back(res.getValue());
+        uow.commit();
+    }
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        BSONObj newDoc = BSON("a" << 42);
+        ASSERT_OK(rs.updateRecord(opCtx.get(), locs[0], newDoc.objdata(), newDoc.objsize()));
+        rs.deleteRecord(opCtx.get(), locs[1]);
+        uow.commit();
+    }
+
+    std::vector<int> valuesOfA;
+    rs.scanColumn(opCtx.get(), "a", [&](const RecordId& rid, const BSONElement& elem) {
+        valuesOfA.push_back(elem.numberInt());
+        return true;
+    });
+    ASSERT_EQUALS(2u, valuesOfA.size());
+    ASSERT_EQUALS(42, valuesOfA[0]);
+    ASSERT_EQUALS(2, valuesOfA[1]);
+
+    // The update removed locs[0]'s 'b' entry and the delete removed locs[1]'s.
+    size_t n = rs.scanColumn(opCtx.get(), "b", [&](const RecordId& rid, const BSONElement& elem) {
+        ASSERT_EQUALS(locs[2], rid);
+        ASSERT_EQUALS(20, elem.numberInt());
+        return true;
+    });
+    ASSERT_EQUALS(1u, n);
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs.truncate(opCtx.get()));
+        uow.commit();
+    }
+    ASSERT_EQUALS(0, rs.numRecords(opCtx.get()));
+    ASSERT_EQUALS(0u,
+                  rs.scanColumn(opCtx.get(), "a", [](const RecordId&, const BSONElement&) {
+                      return true;
+                  }));
+}
 }  // namespace
 }  // namespace biggie
 }  // namespace mongo
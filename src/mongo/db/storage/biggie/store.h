@@ -103,7 +103,7 @@ public:
             return *(_current->data);
         }
 
-        const_pointer operator->() {
+        const_pointer operator->() const {
             return &*(_current->data);
         }
 
@@ -264,7 +264,7 @@ public:
             return *(_current->data);
         }
 
-        const_pointer operator->() {
+        const_pointer operator->() const {
             return &*(_current->data);
         }
 
@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/bson/timestamp.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -60,8 +63,10 @@ public:
     virtual bool haveCappedWaiters() = 0;
 
     /**
-     * Used to notify any waiters when new documents may be visible in the capped collection.
+     * Used to notify any waiters when new documents may be visible in the capped collection. If
+     * 'commitTs' is set, it is the timestamp at or below which the newly visible documents were
+     * written, and waiters that cannot be satisfied by it may be left asleep.
      */
-    virtual void notifyCappedWaitersIfNeeded() = 0;
+    virtual void notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs = boost::none) = 0;
 };
 }
@@ -627,9 +627,6 @@ RecordId EphemeralForTestRecordStore::allocateLoc() {
 
 boost::optional<RecordId> EphemeralForTestRecordStore::oplogStartHack(
     OperationContext* opCtx, const RecordId& startingPosition) const {
-    if (!_data->isOplog)
-        return boost::none;
-
     stdx::lock_guard<stdx::recursive_mutex> lock(_data->recordsMutex);
     const Records& records = _data->records;
 
@@ -383,6 +383,26 @@ void KeyString::_appendAllElementsForIndexing(const BSONObj& obj,
     _append(kEnd, false);
 }
 
+void KeyString::appendNumberLong(long long num, bool invert) {
+    _appendNumberLong(num, invert);
+}
+
+void KeyString::appendNumberDouble(double num, bool invert) {
+    _appendNumberDouble(num, invert);
+}
+
+void KeyString::appendString(StringData val, bool invert) {
+    _appendString(val, invert);
+}
+
+void KeyString::appendNull(bool invert) {
+    _append(CType::kNullish, invert);
+}
+
+void KeyString::appendEnd() {
+    _append(kEnd, false);
+}
+
 void KeyString::appendRecordId(RecordId loc) {
     // The RecordId encoding must be able to determine the full length starting from the last
     // byte, without knowing where the first byte is since it is stored at the end of a
@@ -2061,6 +2081,40 @@ BSONObj KeyString::toBsonSafe(const char* buffer,
     return builder.obj();
 }
 
+BSONObj KeyString::getKeyComponent(const char* buffer,
+                                   size_t len,
+                                   Ordering ord,
+                                   const TypeBits& typeBits,
+                                   size_t componentIndex) {
+    BufReader reader(buffer, len);
+    TypeBits::Reader typeBitsReader(typeBits);
+    for (int i = 0; reader.remaining(); i++) {
+        const bool invert = (ord.get(i) == -1);
+        uint8_t ctype = readType<uint8_t>(&reader, invert);
+        if (ctype == kLess || ctype == kGreater) {
+            ctype = readType<uint8_t>(&reader, invert);
+        }
+
+        if (ctype == kEnd)
+            break;
+
+        if (static_cast<size_t>(i) < componentIndex) {
+            // Earlier components must still be decoded so that the sequential type bits stay
+            // aligned with the requested component, but their output is discarded without
+            // assembling the whole key object.
+            BSONObjBuilder skipped;
+            toBsonValue(
+                ctype, &reader, &typeBitsReader, invert, typeBits.version, &(skipped << ""));
+            continue;
+        }
+
+        BSONObjBuilder builder;
+        toBsonValue(ctype, &reader, &typeBitsReader, invert, typeBits.version, &(builder << ""));
+        return builder.obj();
+    }
+    return BSONObj();
+}
+
 BSONObj KeyString::toBson(const char* buffer,
                           size_t len,
                           Ordering ord,
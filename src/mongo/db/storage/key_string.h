@@ -342,6 +342,16 @@ public:
                           const TypeBits& types) noexcept;
     static BSONObj toBsonSafe(const char* buffer, size_t len, Ordering ord, const TypeBits& types);
 
+    /**
+     * Decodes only the key component at 'componentIndex' (zero-based), returned as a
+     * single-element BSONObj with an empty field name, or an empty BSONObj if the key has
+     * fewer components. Components after the requested one are never examined. Components
+     * before it are decoded into a discarded buffer to keep the sequential type bits
+     * aligned, so extracting a leading component of a compound key is cheapest.
+     */
+    static BSONObj getKeyComponent(
+        const char* buffer, size_t len, Ordering ord, const TypeBits& types, size_t componentIndex);
+
     /**
      * Decodes a RecordId from the end of a buffer.
      */
@@ -360,6 +370,25 @@ public:
     void appendRecordId(RecordId loc);
     void appendTypeBits(const TypeBits& bits);
 
+    /**
+     * Directly appends a single key field of the given type, without going through an
+     * intermediate BSONObj or BSONElement. Fields must be appended in index key order, with
+     * 'invert' true for fields whose ordering direction is descending, mirroring
+     * resetToKey(). The bytes and TypeBits produced are identical to encoding a BSON key
+     * holding the same values.
+     */
+    void appendNumberLong(long long num, bool invert = false);
+    void appendNumberDouble(double num, bool invert = false);
+    void appendString(StringData val, bool invert = false);
+    void appendNull(bool invert = false);
+
+    /**
+     * Terminates a key built with the typed append methods, mirroring the end marker that
+     * resetToKey() writes after the last field. Call after the last field (and before
+     * appendRecordId(), if any) for the result to compare equal to a key built from BSON.
+     */
+    void appendEnd();
+
     /**
      * Resets to an empty state.
      * Equivalent to but faster than *this = KeyString()
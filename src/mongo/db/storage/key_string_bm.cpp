@@ -152,6 +152,45 @@ void BM_KeyStringToBSON(benchmark::State& state,
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+void BM_TypedAppendToKeyString(benchmark::State& state, const KeyString::Version version) {
+    std::mt19937 gen(seedGen());
+    std::exponential_distribution<double> expReal(1e-3);
+    long long values[kSampleSize];
+    for (int i = 0; i < kSampleSize; i++) {
+        values[i] = static_cast<long long>(expReal(gen));
+    }
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (auto value : values) {
+            KeyString ks(version);
+            ks.appendNumberLong(value);
+            ks.appendEnd();
+            benchmark::DoNotOptimize(ks);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
+void BM_KeyStringGetKeyComponent(benchmark::State& state,
+                                 const KeyString::Version version,
+                                 BsonValueType bsonType) {
+    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 0; i < kSampleSize; i++) {
+            BufReader buf(bsonsAndKeyStrings.typebits[i].get(), bsonsAndKeyStrings.typebitsLens[i]);
+            benchmark::DoNotOptimize(
+                KeyString::getKeyComponent(bsonsAndKeyStrings.keystrings[i].get(),
+                                           bsonsAndKeyStrings.keystringLens[i],
+                                           ALL_ASCENDING,
+                                           KeyString::TypeBits::fromBuffer(version, &buf),
+                                           0));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * bsonsAndKeyStrings.bsonSize);
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Int, KeyString::Version::V1, INT);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Double, KeyString::Version::V0, DOUBLE);
@@ -171,5 +210,11 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
+
+BENCHMARK_CAPTURE(BM_TypedAppendToKeyString, V0_Int, KeyString::Version::V0);
+BENCHMARK_CAPTURE(BM_TypedAppendToKeyString, V1_Int, KeyString::Version::V1);
+
+BENCHMARK_CAPTURE(BM_KeyStringGetKeyComponent, V1_Int, KeyString::Version::V1, INT);
+BENCHMARK_CAPTURE(BM_KeyStringGetKeyComponent, V1_String, KeyString::Version::V1, STRING);
 }  // namespace
 }  // namespace mongo
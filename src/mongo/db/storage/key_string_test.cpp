@@ -1429,6 +1429,71 @@ TEST_F(KeyStringTest, InvalidDecimalContinuation) {
         50850);
 }
 
+TEST_F(KeyStringTest, TypedAppendsMatchResetToKey) {
+    const BSONObj obj = BSON("" << 12345LL << ""
+                                << "hello"
+                                << "" << 5.5 << "" << BSONNULL);
+
+    KeyString expected(version, obj, ALL_ASCENDING, RecordId(42));
+
+    KeyString ks(version);
+    ks.appendNumberLong(12345);
+    ks.appendString("hello");
+    ks.appendNumberDouble(5.5);
+    ks.appendNull();
+    ks.appendEnd();
+    ks.appendRecordId(RecordId(42));
+
+    ASSERT_EQUALS(ks, expected);
+    ASSERT_EQUALS(ks.getSize(), expected.getSize());
+    ASSERT_EQUALS(0, memcmp(ks.getBuffer(), expected.getBuffer(), ks.getSize()));
+    ASSERT_EQUALS(ks.getTypeBits().getSize(), expected.getTypeBits().getSize());
+    ASSERT_EQUALS(0,
+                  memcmp(ks.getTypeBits().getBuffer(),
+                         expected.getTypeBits().getBuffer(),
+                         ks.getTypeBits().getSize()));
+}
+
+TEST_F(KeyStringTest, TypedAppendsMatchResetToKeyInverted) {
+    const Ordering ordering = Ordering::make(BSON("a" << -1 << "b" << -1));
+    const BSONObj obj = BSON("" << 54321LL << ""
+                                << "world");
+
+    KeyString expected(version, obj, ordering);
+
+    KeyString ks(version);
+    ks.appendNumberLong(54321, true /* invert */);
+    ks.appendString("world", true /* invert */);
+    ks.appendEnd();
+
+    ASSERT_EQUALS(ks.getSize(), expected.getSize());
+    ASSERT_EQUALS(0, memcmp(ks.getBuffer(), expected.getBuffer(), ks.getSize()));
+}
+
+TEST_F(KeyStringTest, GetKeyComponent) {
+    const BSONObj obj = BSON("" << 3 << ""
+                                << "abc"
+                                << "" << 5.5);
+    const Ordering orderings[] = {ALL_ASCENDING, Ordering::make(BSON("a" << 1 << "b" << -1))};
+
+    for (const auto& ordering : orderings) {
+        const KeyString ks(version, obj, ordering, RecordId(7));
+
+        BSONObjIterator it(obj);
+        for (size_t i = 0; i < 3; i++) {
+            const BSONObj component = KeyString::getKeyComponent(
+                ks.getBuffer(), ks.getSize(), ordering, ks.getTypeBits(), i);
+            ASSERT_BSONOBJ_EQ(component, it.next().wrap(""));
+        }
+
+        // Requesting a component past the end of the key yields an empty object. The appended
+        // RecordId must not be mistaken for a key component.
+        ASSERT_BSONOBJ_EQ(
+            KeyString::getKeyComponent(ks.getBuffer(), ks.getSize(), ordering, ks.getTypeBits(), 3),
+            BSONObj());
+    }
+}
+
 TEST_F(KeyStringTest, RandomizedInputsForToBsonSafe) {
     std::mt19937 gen(newSeed());
     std::uniform_int_distribution<unsigned int> randomNum(std::numeric_limits<unsigned int>::min(),
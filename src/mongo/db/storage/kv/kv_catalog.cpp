@@ -157,7 +157,11 @@ public:
     virtual void commit(boost::optional<Timestamp>) {}
     virtual void rollback() {
         stdx::lock_guard<stdx::mutex> lk(_catalog->_identsLock);
-        _catalog->_idents[_ident] = _entry;
+        Entry& entry = _catalog->_idents[_ident];
+        entry = _entry;
+        // The captured cached document may reflect other writes from this same unit of work that
+        // were also rolled back; force the next reader back to the record store.
+        entry.catalogEntry = BSONObj();
     }
 
     KVCatalog* const _catalog;
@@ -165,6 +169,26 @@ public:
     const Entry _entry;
 };
 
+class KVCatalog::InvalidateCachedEntryChange : public RecoveryUnit::Change {
+public:
+    InvalidateCachedEntryChange(KVCatalog* catalog, StringData ns)
+        : _catalog(catalog), _ns(ns.toString()) {}
+
+    virtual void commit(boost::optional<Timestamp>) {}
+    virtual void rollback() {
+        stdx::lock_guard<stdx::mutex> lk(_catalog->_identsLock);
+        NSToIdentMap::iterator it = _catalog->_idents.find(_ns);
+        if (it != _catalog->_idents.end()) {
+            // The cached document holds the rolled-back write; the next reader must re-fetch the
+            // committed version from the record store.
+            it->second.catalogEntry = BSONObj();
+        }
+    }
+
+    KVCatalog* const _catalog;
+    const std::string _ns;
+};
+
 bool KVCatalog::FeatureTracker::isFeatureDocument(BSONObj obj) {
     BSONElement firstElem = obj.firstElement();
     if (firstElem.fieldNameStringData() == kIsFeatureDocumentFieldName) {
@@ -369,7 +393,11 @@ void KVCatalog::init(OperationContext* opCtx) {
         // No rollback since this is just loading already committed data.
         string ns = obj["ns"].String();
         string ident = obj["ident"].String();
-        _idents[ns] = Entry(ident, record->id);
+        Entry entry(ident, record->id);
+        // We are parsing every document anyway, so prime the metadata cache to spare startup
+        // from re-reading each entry.
+        entry.catalogEntry = obj.getOwned();
+        _idents[ns] = entry;
     }
 
     if (!_featureTracker) {
@@ -424,6 +452,7 @@ Status KVCatalog::newCollection(OperationContext* opCtx,
         return res.getStatus();
 
     old = Entry(ident, res.getValue());
+    old.catalogEntry = obj;
     LOG(1) << "stored meta data for " << ns << " @ " << res.getValue();
     return Status::OK();
 }
@@ -450,6 +479,13 @@ BSONObj KVCatalog::_findEntry(OperationContext* opCtx, StringData ns, RecordId*
         NSToIdentMap::const_iterator it = _idents.find(ns.toString());
         invariant(it != _idents.end(), str::stream() << "Did not find collection. Ns: " << ns);
         dl = it->second.storedLoc;
+
+        if (!it->second.catalogEntry.isEmpty()) {
+            LOG(3) << "returning cached metadata for: " << ns << " @ " << dl;
+            if (out)
+                *out = dl;
+            return it->second.catalogEntry;
+        }
     }
 
     LOG(3) << "looking up metadata for: " << ns << " @ " << dl;
@@ -464,7 +500,17 @@ BSONObj KVCatalog::_findEntry(OperationContext* opCtx, StringData ns, RecordId*
     if (out)
         *out = dl;
 
-    return data.releaseToBson().getOwned();
+    BSONObj obj = data.releaseToBson().getOwned();
+    {
+        // Fill the cache for the next reader. The entry may have been removed or replaced while
+        // the record was being fetched, so only cache the document if it still belongs here.
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        NSToIdentMap::iterator it = _idents.find(ns.toString());
+        if (it != _idents.end() && it->second.storedLoc == dl) {
+            it->second.catalogEntry = obj;
+        }
+    }
+    return obj;
 }
 
 BSONCollectionCatalogEntry::MetaData KVCatalog::getMetaData(OperationContext* opCtx,
@@ -517,6 +563,17 @@ void KVCatalog::putMetaData(OperationContext* opCtx,
     LOG(3) << "recording new metadata: " << obj;
     Status status = _rs->updateRecord(opCtx, loc, obj.objdata(), obj.objsize());
     fassert(28521, status.isOK());
+
+    {
+        // Keep the cache in step with the record so that reads within this same unit of work see
+        // the new document. If the unit of work rolls back, the change below drops the cached
+        // copy and the next reader re-fetches the committed version.
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        NSToIdentMap::iterator it = _idents.find(ns.toString());
+        invariant(it != _idents.end(), str::stream() << "Did not find collection. Ns: " << ns);
+        it->second.catalogEntry = obj;
+    }
+    opCtx->recoveryUnit()->registerChange(new InvalidateCachedEntryChange(this, ns));
 }
 
 Status KVCatalog::renameCollection(OperationContext* opCtx,
@@ -525,6 +582,7 @@ Status KVCatalog::renameCollection(OperationContext* opCtx,
                                    bool stayTemp) {
     RecordId loc;
     BSONObj old = _findEntry(opCtx, fromNS, &loc).getOwned();
+    BSONObj renamedEntry;
     {
         BSONObjBuilder b;
 
@@ -539,8 +597,9 @@ Status KVCatalog::renameCollection(OperationContext* opCtx,
 
         b.appendElementsUnique(old);
 
-        BSONObj obj = b.obj();
-        Status status = _rs->updateRecord(opCtx, loc, obj.objdata(), obj.objsize());
+        renamedEntry = b.obj();
+        Status status =
+            _rs->updateRecord(opCtx, loc, renamedEntry.objdata(), renamedEntry.objsize());
         fassert(28522, status.isOK());
     }
 
@@ -552,7 +611,9 @@ Status KVCatalog::renameCollection(OperationContext* opCtx,
     opCtx->recoveryUnit()->registerChange(new AddIdentChange(this, toNS));
 
     _idents.erase(fromIt);
-    _idents[toNS.toString()] = Entry(old["ident"].String(), loc);
+    Entry& renamed = _idents[toNS.toString()];
+    renamed = Entry(old["ident"].String(), loc);
+    renamed.catalogEntry = renamedEntry;
 
     return Status::OK();
 }
@@ -593,6 +654,37 @@ std::vector<std::string> KVCatalog::getAllIdentsForDB(StringData db) const {
 std::vector<std::string> KVCatalog::getAllIdents(OperationContext* opCtx) const {
     std::vector<std::string> v;
 
+    {
+        // If every collection's document is cached, answer from the cache and avoid re-parsing
+        // the whole catalog. init() primes the cache and the write paths keep it filled, so
+        // falling through to the scan below should be rare.
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        bool allCached = true;
+        for (NSToIdentMap::const_iterator it = _idents.begin(); it != _idents.end(); ++it) {
+            if (it->second.catalogEntry.isEmpty()) {
+                allCached = false;
+                break;
+            }
+        }
+        if (allCached) {
+            for (NSToIdentMap::const_iterator it = _idents.begin(); it != _idents.end(); ++it) {
+                v.push_back(it->second.ident);
+
+                BSONElement e = it->second.catalogEntry["idxIdent"];
+                if (!e.isABSONObj())
+                    continue;
+                BSONObj idxIdent = e.Obj();
+
+                BSONObjIterator sub(idxIdent);
+                while (sub.more()) {
+                    BSONElement e = sub.next();
+                    v.push_back(e.String());
+                }
+            }
+            return v;
+        }
+    }
+
     auto cursor = _rs->getCursor(opCtx);
     while (auto record = cursor->next()) {
         BSONObj obj = record->data.releaseToBson();
@@ -667,6 +759,7 @@ StatusWith<std::string> KVCatalog::newOrphanedIdent(OperationContext* opCtx, std
         return res.getStatus();
 
     old = Entry(ident, res.getValue());
+    old.catalogEntry = obj;
     LOG(1) << "stored meta data for orphaned collection " << ns << " @ " << res.getValue();
     return StatusWith<std::string>(std::move(ns));
 }
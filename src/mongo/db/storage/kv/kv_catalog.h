@@ -114,6 +114,7 @@ public:
 private:
     class AddIdentChange;
     class RemoveIdentChange;
+    class InvalidateCachedEntryChange;
 
     BSONObj _findEntry(OperationContext* opCtx, StringData ns, RecordId* out = NULL) const;
 
@@ -141,9 +142,16 @@ private:
         Entry(std::string i, RecordId l) : ident(i), storedLoc(l) {}
         std::string ident;
         RecordId storedLoc;
+
+        // Owned copy of the catalog document for this collection, so repeated metadata reads do
+        // not have to re-fetch and re-parse the record. Empty when the document must be re-read
+        // from the record store; writers that change the document keep this in sync and register
+        // a rollback change that clears it.
+        BSONObj catalogEntry;
     };
     typedef std::map<std::string, Entry> NSToIdentMap;
-    NSToIdentMap _idents;
+    // Mutable so const readers can fill in an entry's cached catalog document on a miss.
+    mutable NSToIdentMap _idents;
     mutable stdx::mutex _identsLock;
 
     // Manages the feature document that may be present in the KVCatalog. '_featureTracker' is
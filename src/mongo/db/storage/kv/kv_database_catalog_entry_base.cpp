@@ -264,6 +264,18 @@ void KVDatabaseCatalogEntryBase::initCollection(OperationContext* opCtx,
         _engine->getEngine(), _engine->getCatalog(), ns, ident, std::move(rs));
 }
 
+void KVDatabaseCatalogEntryBase::initCollectionWithRecordStore(const std::string& ns,
+                                                               std::unique_ptr<RecordStore> rs) {
+    invariant(!_collections.count(ns));
+    invariant(rs);
+
+    const std::string ident = _engine->getCatalog()->getCollectionIdent(ns);
+
+    // No change registration since this is only for committed collections
+    _collections[ns] = new KVCollectionCatalogEntry(
+        _engine->getEngine(), _engine->getCatalog(), ns, ident, std::move(rs));
+}
+
 void KVDatabaseCatalogEntryBase::reinitCollectionAfterRepair(OperationContext* opCtx,
                                                              const std::string& ns) {
     // Get rid of the old entry.
@@ -82,6 +82,12 @@ public:
 
     void initCollection(OperationContext* opCtx, const std::string& ns, bool forRepair);
 
+    /**
+     * Installs an already-opened record store for 'ns'. Used by the parallel catalog load at
+     * startup, which opens record stores on worker threads and installs them serially.
+     */
+    void initCollectionWithRecordStore(const std::string& ns, std::unique_ptr<RecordStore> rs);
+
     void initCollectionBeforeRepair(OperationContext* opCtx, const std::string& ns);
     void reinitCollectionAfterRepair(OperationContext* opCtx, const std::string& ns);
 
@@ -294,6 +294,62 @@ TEST(KVCatalogTest, Idx1) {
     }
 }
 
+TEST(KVCatalogTest, MetaDataCacheRollback) {
+    unique_ptr<KVHarnessHelper> helper(KVHarnessHelper::create());
+    KVEngine* engine = helper->getEngine();
+
+    unique_ptr<RecordStore> rs;
+    unique_ptr<KVCatalog> catalog;
+    {
+        MyOperationContext opCtx(engine);
+        WriteUnitOfWork uow(&opCtx);
+        ASSERT_OK(engine->createRecordStore(&opCtx, "catalog", "catalog", CollectionOptions()));
+        rs = engine->getRecordStore(&opCtx, "catalog", "catalog", CollectionOptions());
+        catalog.reset(new KVCatalog(rs.get(), false, false));
+        ASSERT_OK(
+            catalog->newCollection(&opCtx, "a.b", CollectionOptions(), KVPrefix::kNotPrefixed));
+        uow.commit();
+    }
+
+    {
+        MyOperationContext opCtx(engine);
+        WriteUnitOfWork uow(&opCtx);
+
+        BSONCollectionCatalogEntry::MetaData md;
+        md.ns = "a.b";
+        md.indexes.push_back(BSONCollectionCatalogEntry::IndexMetaData(BSON("name"
+                                                                            << "foo"),
+                                                                       false,
+                                                                       RecordId(),
+                                                                       false,
+                                                                       KVPrefix::kNotPrefixed,
+                                                                       false));
+        catalog->putMetaData(&opCtx, "a.b", md);
+        uow.commit();
+    }
+
+    {
+        // Remove the index in a unit of work that rolls back. Reads inside the unit of work must
+        // see the uncommitted document, while reads after the rollback must see the committed
+        // version again rather than a stale cached copy.
+        MyOperationContext opCtx(engine);
+        WriteUnitOfWork uow(&opCtx);
+
+        BSONCollectionCatalogEntry::MetaData md;
+        md.ns = "a.b";
+        catalog->putMetaData(&opCtx, "a.b", md);
+        ASSERT_EQUALS(0U, catalog->getMetaData(&opCtx, "a.b").indexes.size());
+        // No commit; the unit of work rolls back on destruction.
+    }
+
+    {
+        MyOperationContext opCtx(engine);
+        BSONCollectionCatalogEntry::MetaData md = catalog->getMetaData(&opCtx, "a.b");
+        ASSERT_EQUALS(1U, md.indexes.size());
+        ASSERT_EQUALS("foo", md.indexes[0].name());
+    }
+}
+
 TEST(KVCatalogTest, DirectoryPerDb1) {
     unique_ptr<KVHarnessHelper> helper(KVHarnessHelper::create());
     KVEngine* engine = helper->getEngine();
@@ -43,7 +43,9 @@
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/unclean_shutdown.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
 
@@ -196,7 +198,7 @@ void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
         }
     }
 
-    KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
+    std::vector<std::string> collectionsToInit;
     for (const auto& coll : collectionsKnownToCatalog) {
         NamespaceString nss(coll);
         std::string dbName = nss.db().toString();
@@ -238,15 +240,15 @@ void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
             db = _databaseCatalogEntryFactory(dbName, this).release();
         }
 
-        db->initCollection(opCtx, coll, _options.forRepair);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, coll).getMaxPrefix();
-        maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
-
         if (nss.isOrphanCollection()) {
             log() << "Orphaned collection found: " << nss;
         }
+
+        collectionsToInit.push_back(coll);
     }
 
+    KVPrefix maxSeenPrefix = _initCollections(opCtx, collectionsToInit);
+
     KVPrefix::setLargestPrefix(maxSeenPrefix);
     opCtx->recoveryUnit()->abandonSnapshot();
 
@@ -255,6 +257,72 @@ void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
     startingAfterUncleanShutdown(getGlobalServiceContext()) = false;
 }
 
+KVPrefix KVStorageEngine::_initCollections(OperationContext* opCtx,
+                                           const std::vector<std::string>& collections) {
+    KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
+    if (collections.empty()) {
+        return maxSeenPrefix;
+    }
+
+    // In a repair context record stores are left unopened until they have been repaired, so there
+    // are no table opens to parallelize; keep the deterministic serial order.
+    if (_options.forRepair) {
+        for (const auto& coll : collections) {
+            _dbs[nsToDatabase(coll)]->initCollection(opCtx, coll, true);
+            maxSeenPrefix =
+                std::max(maxSeenPrefix, _catalog->getMetaData(opCtx, coll).getMaxPrefix());
+        }
+        return maxSeenPrefix;
+    }
+
+    // Opening every table is what dominates startup time with large numbers of collections, so
+    // spread the metadata reads and table opens across a thread pool. Each worker uses its own
+    // recovery unit; the opened record stores are installed in the database catalog entries
+    // serially below.
+    struct PendingCollection {
+        Status status = Status::OK();
+        BSONCollectionCatalogEntry::MetaData md;
+        std::unique_ptr<RecordStore> rs;
+    };
+    std::vector<PendingCollection> pending(collections.size());
+
+    ThreadPool::Options poolOptions;
+    poolOptions.poolName = "KVCatalogLoad";
+    poolOptions.maxThreads = std::max(
+        size_t(1), std::min(collections.size(), size_t(ProcessInfo::getNumAvailableCores())));
+    ThreadPool pool(poolOptions);
+    pool.startup();
+
+    for (size_t i = 0; i < collections.size(); i++) {
+        uassertStatusOK(pool.schedule([this, i, &collections, &pending] {
+            const std::string& coll = collections[i];
+            auto& result = pending[i];
+            try {
+                OperationContextNoop opCtx(_engine->newRecoveryUnit());
+                result.md = _catalog->getMetaData(&opCtx, coll);
+                result.rs = _engine->getGroupedRecordStore(
+                    &opCtx, coll, _catalog->getCollectionIdent(coll), result.md.options,
+                    result.md.prefix);
+                invariant(result.rs);
+            } catch (const DBException& ex) {
+                result.status = ex.toStatus();
+            }
+        }));
+    }
+    pool.shutdown();
+    pool.join();
+
+    for (size_t i = 0; i < collections.size(); i++) {
+        auto& result = pending[i];
+        uassertStatusOK(result.status);
+        _dbs[nsToDatabase(collections[i])]->initCollectionWithRecordStore(collections[i],
+                                                                          std::move(result.rs));
+        maxSeenPrefix = std::max(maxSeenPrefix, result.md.getMaxPrefix());
+    }
+
+    return maxSeenPrefix;
+}
+
 void KVStorageEngine::closeCatalog(OperationContext* opCtx) {
     dassert(opCtx->lockState()->isLocked());
     if (shouldLog(::mongo::logger::LogComponent::kStorageRecovery, kCatalogLogLevel)) {
@@ -387,66 +455,107 @@ KVStorageEngine::reconcileCatalogAndIdents(OperationContext* opCtx) {
     //
     // Also, remove unfinished builds except those that were background index builds started on a
     // secondary.
-    std::vector<CollectionIndexNamePair> ret;
-    for (const auto& coll : collections) {
-        BSONCollectionCatalogEntry::MetaData metaData = _catalog->getMetaData(opCtx, coll);
-
-        // Batch up the indexes to remove them from `metaData` outside of the iterator.
-        std::vector<std::string> indexesToDrop;
-        for (const auto& indexMetaData : metaData.indexes) {
-            const std::string& indexName = indexMetaData.name();
-            std::string indexIdent = _catalog->getIndexIdent(opCtx, coll, indexName);
-
-            const bool foundIdent = engineIdents.find(indexIdent) != engineIdents.end();
-            // An index drop will immediately remove the ident, but the `indexMetaData` catalog
-            // entry still exists implying the drop hasn't necessarily been replicated to a
-            // majority of nodes. The code will rebuild the index, despite potentially
-            // encountering another `dropIndex` command.
-            if (indexMetaData.ready && !foundIdent) {
-                log() << "Expected index data is missing, rebuilding. Collection: " << coll
-                      << " Index: " << indexName;
-                ret.emplace_back(coll, indexName);
-                continue;
-            }
+    //
+    // The scan only reads the catalog, so with many collections it is spread across a thread
+    // pool, each worker using its own recovery unit. The ident drops and catalog writes it
+    // decides on are applied serially afterwards on the caller's operation context.
+    struct CollectionReconcileResult {
+        Status status = Status::OK();
+        BSONCollectionCatalogEntry::MetaData metaData;
+        std::vector<CollectionIndexNamePair> indexesToRebuild;
+        // Unfinished index builds to remove, paired with the ident to drop.
+        std::vector<std::pair<std::string, std::string>> indexesToDrop;
+    };
+    std::vector<CollectionReconcileResult> results(collections.size());
+
+    ThreadPool::Options poolOptions;
+    poolOptions.poolName = "KVCatalogReconcile";
+    poolOptions.maxThreads = std::max(
+        size_t(1), std::min(collections.size(), size_t(ProcessInfo::getNumAvailableCores())));
+    ThreadPool pool(poolOptions);
+    pool.startup();
+
+    for (size_t i = 0; i < collections.size(); i++) {
+        uassertStatusOK(pool.schedule([this, i, &collections, &results, &engineIdents] {
+            const std::string& coll = collections[i];
+            auto& result = results[i];
+            try {
+                OperationContextNoop opCtx(_engine->newRecoveryUnit());
+                result.metaData = _catalog->getMetaData(&opCtx, coll);
+
+                for (const auto& indexMetaData : result.metaData.indexes) {
+                    const std::string& indexName = indexMetaData.name();
+                    std::string indexIdent = _catalog->getIndexIdent(&opCtx, coll, indexName);
+
+                    const bool foundIdent = engineIdents.find(indexIdent) != engineIdents.end();
+                    // An index drop will immediately remove the ident, but the `indexMetaData`
+                    // catalog entry still exists implying the drop hasn't necessarily been
+                    // replicated to a majority of nodes. The code will rebuild the index, despite
+                    // potentially encountering another `dropIndex` command.
+                    if (indexMetaData.ready && !foundIdent) {
+                        log() << "Expected index data is missing, rebuilding. Collection: " << coll
+                              << " Index: " << indexName;
+                        result.indexesToRebuild.emplace_back(coll, indexName);
+                        continue;
+                    }
 
-            // If the index was kicked off as a background secondary index build, replication
-            // recovery will not run into the oplog entry to recreate the index. If the index
-            // table is not found, or the index build did not successfully complete, this code
-            // will return the index to be rebuilt.
-            if (indexMetaData.isBackgroundSecondaryBuild && (!foundIdent || !indexMetaData.ready)) {
-                log()
-                    << "Expected background index build did not complete, rebuilding. Collection: "
-                    << coll << " Index: " << indexName;
-                ret.emplace_back(coll, indexName);
-                continue;
-            }
+                    // If the index was kicked off as a background secondary index build,
+                    // replication recovery will not run into the oplog entry to recreate the
+                    // index. If the index table is not found, or the index build did not
+                    // successfully complete, this code will return the index to be rebuilt.
+                    if (indexMetaData.isBackgroundSecondaryBuild &&
+                        (!foundIdent || !indexMetaData.ready)) {
+                        log() << "Expected background index build did not complete, rebuilding. "
+                                 "Collection: "
+                              << coll << " Index: " << indexName;
+                        result.indexesToRebuild.emplace_back(coll, indexName);
+                        continue;
+                    }
 
-            // The last anomaly is when the index build did not complete, nor was the index build
-            // a secondary background index build. This implies the index build was on a primary
-            // and the `createIndexes` command never successfully returned, or the index build was
-            // a foreground secondary index build, meaning replication recovery will build the
-            // index when it replays the oplog. In these cases the index entry in the catalog
-            // should be dropped.
-            if (!indexMetaData.ready && !indexMetaData.isBackgroundSecondaryBuild) {
-                log() << "Dropping unfinished index. Collection: " << coll
-                      << " Index: " << indexName;
-                // Ensure the `ident` is dropped while we have the `indexIdent` value.
-                fassert(50713, _engine->dropIdent(opCtx, indexIdent));
-                indexesToDrop.push_back(indexName);
-                continue;
+                    // The last anomaly is when the index build did not complete, nor was the
+                    // index build a secondary background index build. This implies the index
+                    // build was on a primary and the `createIndexes` command never successfully
+                    // returned, or the index build was a foreground secondary index build,
+                    // meaning replication recovery will build the index when it replays the
+                    // oplog. In these cases the index entry in the catalog should be dropped.
+                    if (!indexMetaData.ready && !indexMetaData.isBackgroundSecondaryBuild) {
+                        log() << "Dropping unfinished index. Collection: " << coll
+                              << " Index: " << indexName;
+                        // Record the `ident` while we have the `indexIdent` value; it is dropped
+                        // in the serial phase below.
+                        result.indexesToDrop.emplace_back(indexName, indexIdent);
+                        continue;
+                    }
+                }
+            } catch (const DBException& ex) {
+                result.status = ex.toStatus();
             }
+        }));
+    }
+    pool.shutdown();
+    pool.join();
+
+    std::vector<CollectionIndexNamePair> ret;
+    for (size_t i = 0; i < collections.size(); i++) {
+        const auto& coll = collections[i];
+        auto& result = results[i];
+        uassertStatusOK(result.status);
+
+        ret.insert(ret.end(), result.indexesToRebuild.begin(), result.indexesToRebuild.end());
+
+        if (result.indexesToDrop.empty()) {
+            continue;
         }
 
-        for (auto&& indexName : indexesToDrop) {
-            invariant(metaData.eraseIndex(indexName),
+        for (const auto& index : result.indexesToDrop) {
+            fassert(50713, _engine->dropIdent(opCtx, index.second));
+            invariant(result.metaData.eraseIndex(index.first),
                       str::stream() << "Index is missing. Collection: " << coll << " Index: "
-                                    << indexName);
-        }
-        if (indexesToDrop.size() > 0) {
-            WriteUnitOfWork wuow(opCtx);
-            _catalog->putMetaData(opCtx, coll, metaData);
-            wuow.commit();
+                                    << index.first);
         }
+        WriteUnitOfWork wuow(opCtx);
+        _catalog->putMetaData(opCtx, coll, result.metaData);
+        wuow.commit();
     }
 
     return ret;
@@ -30,6 +30,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
@@ -211,6 +212,15 @@ private:
                                       const NamespaceString& collectionName,
                                       StringData collectionIdent);
 
+    /**
+     * Opens the record stores for 'collections' and installs them in their database catalog
+     * entries. Outside of a repair context the table opens are spread across a thread pool, as
+     * they dominate startup time on high-collection-count databases. Returns the largest KVPrefix
+     * found in the collections' metadata.
+     */
+    KVPrefix _initCollections(OperationContext* opCtx,
+                              const std::vector<std::string>& collections);
+
     void _dumpCatalog(OperationContext* opCtx);
 
     class RemoveDBChange;
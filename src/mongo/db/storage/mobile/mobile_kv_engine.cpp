@@ -40,6 +40,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/storage/mobile/mobile_index.h"
 #include "mongo/db/storage/mobile/mobile_kv_engine.h"
+#include "mongo/db/storage/mobile/mobile_options.h"
 #include "mongo/db/storage/mobile/mobile_record_store.h"
 #include "mongo/db/storage/mobile/mobile_recovery_unit.h"
 #include "mongo/db/storage/mobile/mobile_session.h"
@@ -47,6 +48,7 @@
 #include "mongo/db/storage/mobile/mobile_util.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -84,9 +86,15 @@ MobileKVEngine::MobileKVEngine(const std::string& path) {
         LOG(MOBILE_LOG_LEVEL_LOW) << "MobileSE: Confirmed SQLite database opened in WAL mode";
     }
 
-    // Ensure SQLite is operating with "synchronous" flag set to FULL.
+    // Set and ensure SQLite is operating with the configured "synchronous" flag (FULL unless
+    // storage.mobile.durabilityLevel says otherwise).
     {
-#define PRAGMA_SYNC_FULL 2
+        std::string syncPragma = str::stream() << "PRAGMA main.synchronous = "
+                                               << mobileGlobalOptions.durabilityLevel << ";";
+        char* errMsg = NULL;
+        status = sqlite3_exec(initSession, syncPragma.c_str(), NULL, NULL, &errMsg);
+        checkStatus(status, SQLITE_OK, "sqlite3_exec", errMsg);
+        sqlite3_free(errMsg);
 
         sqlite3_stmt* stmt;
         status = sqlite3_prepare_v2(initSession, "PRAGMA main.synchronous;", -1, &stmt, NULL);
@@ -95,14 +103,14 @@ MobileKVEngine::MobileKVEngine(const std::string& path) {
         status = sqlite3_step(stmt);
         checkStatus(status, SQLITE_ROW, "sqlite3_step");
 
-        // Pragma returns current "synchronous" setting, ensure it is FULL.
+        // Pragma returns current "synchronous" setting, ensure it is the configured level.
         int sync_val = sqlite3_column_int(stmt, 0);
-        fassert(50869, sync_val == PRAGMA_SYNC_FULL);
+        fassert(50869, sync_val == mobileGlobalOptions.durabilityLevel);
         status = sqlite3_finalize(stmt);
         checkStatus(status, SQLITE_OK, "sqlite3_finalize");
 
         LOG(MOBILE_LOG_LEVEL_LOW) << "MobileSE: Confirmed SQLite database has synchronous "
-                                  << "set to FULL";
+                                  << "set to " << sync_val;
     }
 
     // Set and ensure SQLite is operating with F_FULLFSYNC if the platform permits.
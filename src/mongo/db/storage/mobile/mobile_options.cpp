@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/status.h"
+#include "mongo/db/storage/mobile/mobile_options.h"
+#include "mongo/util/log.h"
+#include "mongo/util/options_parser/constraints.h"
+
+namespace mongo {
+
+MobileGlobalOptions mobileGlobalOptions;
+
+Status MobileGlobalOptions::add(moe::OptionSection* options) {
+    moe::OptionSection mobileOptions("Mobile options");
+
+    mobileOptions
+        .addOptionChaining("storage.mobile.durabilityLevel",
+                           "mobileDurabilityLevel",
+                           moe::Int,
+                           "SQLite synchronous level [1 (NORMAL)|2 (FULL)|3 (EXTRA)]; at NORMAL "
+                           "commits append to the WAL without syncing, coalescing the sync cost "
+                           "of consecutive write transactions into checkpoints")
+        .validRange(1, 3)
+        .setDefault(moe::Value(MobileGlobalOptions::kSynchronousFull));
+    mobileOptions
+        .addOptionChaining("storage.mobile.durabilityDeadlineMillis",
+                           "mobileDurabilityDeadlineMillis",
+                           moe::Int,
+                           "with durabilityLevel 1 (NORMAL), maximum milliseconds committed "
+                           "writes may remain unsynced before a commit forces a WAL checkpoint; "
+                           "0 leaves checkpointing to SQLite")
+        .validRange(0, 3600000)
+        .setDefault(moe::Value(0));
+    mobileOptions
+        .addOptionChaining("storage.mobile.walAutoCheckpointPages",
+                           "mobileWalAutoCheckpointPages",
+                           moe::Int,
+                           "WAL size, in pages, at which a commit triggers an automatic "
+                           "checkpoint; 0 disables automatic checkpoints")
+        .validRange(0, 1000000)
+        .setDefault(moe::Value(1000));
+    mobileOptions
+        .addOptionChaining("storage.mobile.walSizeLimitKB",
+                           "mobileWalSizeLimitKB",
+                           moe::Int,
+                           "size, in kilobytes, the WAL file is truncated to after a checkpoint; "
+                           "0 leaves the WAL file size unlimited")
+        .validRange(0, 1000000000)
+        .setDefault(moe::Value(0));
+
+    return options->addSection(mobileOptions);
+}
+
+Status MobileGlobalOptions::store(const moe::Environment& params,
+                                  const std::vector<std::string>& args) {
+    if (params.count("storage.mobile.durabilityLevel")) {
+        mobileGlobalOptions.durabilityLevel = params["storage.mobile.durabilityLevel"].as<int>();
+    }
+    if (params.count("storage.mobile.durabilityDeadlineMillis")) {
+        mobileGlobalOptions.durabilityDeadlineMillis =
+            params["storage.mobile.durabilityDeadlineMillis"].as<int>();
+    }
+    if (params.count("storage.mobile.walAutoCheckpointPages")) {
+        mobileGlobalOptions.walAutoCheckpointPages =
+            params["storage.mobile.walAutoCheckpointPages"].as<int>();
+    }
+    if (params.count("storage.mobile.walSizeLimitKB")) {
+        mobileGlobalOptions.walSizeLimitKB = params["storage.mobile.walSizeLimitKB"].as<int>();
+    }
+
+    if (mobileGlobalOptions.durabilityDeadlineMillis > 0 &&
+        mobileGlobalOptions.durabilityLevel >= MobileGlobalOptions::kSynchronousFull) {
+        warning() << "storage.mobile.durabilityDeadlineMillis has no effect when "
+                     "storage.mobile.durabilityLevel is FULL or higher; every commit already "
+                     "syncs the WAL";
+    }
+
+    return Status::OK();
+}
+
+}  // namespace mongo
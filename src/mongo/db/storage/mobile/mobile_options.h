@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/util/options_parser/startup_option_init.h"
+#include "mongo/util/options_parser/startup_options.h"
+
+namespace mongo {
+
+namespace moe = mongo::optionenvironment;
+
+/**
+ * Startup options for the mobile storage engine. These tune how SQLite journals writes in WAL
+ * mode; the defaults preserve the engine's historical behavior of syncing the WAL on every
+ * commit.
+ */
+class MobileGlobalOptions {
+public:
+    // Values of the SQLite "synchronous" pragma.
+    static constexpr int kSynchronousNormal = 1;
+    static constexpr int kSynchronousFull = 2;
+
+    MobileGlobalOptions()
+        : durabilityLevel(kSynchronousFull),
+          durabilityDeadlineMillis(0),
+          walAutoCheckpointPages(1000),
+          walSizeLimitKB(0) {}
+
+    Status add(moe::OptionSection* options);
+    Status store(const moe::Environment& params, const std::vector<std::string>& args);
+
+    // SQLite "synchronous" level applied to every connection. At FULL (2, the default) every
+    // commit syncs the WAL. At NORMAL (1) commits only append to the WAL and the sync cost is
+    // shared by all commits since the last checkpoint.
+    int durabilityLevel;
+
+    // With durabilityLevel NORMAL, the maximum number of milliseconds committed writes may
+    // remain unsynced before a committing writer forces a WAL checkpoint. 0 leaves checkpoint
+    // timing entirely to SQLite's automatic checkpointer.
+    int durabilityDeadlineMillis;
+
+    // SQLite "wal_autocheckpoint" setting: the WAL size, in pages, at which a commit triggers an
+    // automatic checkpoint.
+    int walAutoCheckpointPages;
+
+    // SQLite "journal_size_limit" setting expressed in kilobytes: the size the WAL file is
+    // truncated to after a checkpoint. 0 leaves the WAL file size unlimited.
+    int walSizeLimitKB;
+};
+
+extern MobileGlobalOptions mobileGlobalOptions;
+}  // namespace mongo
@@ -210,6 +210,10 @@ void MobileRecoveryUnit::_txnClose(bool commit) {
 
     if (commit) {
         SqliteStatement::execQuery(_session.get(), "COMMIT");
+
+        // With a reduced durability level, commits do not sync the WAL; bound how long this
+        // commit may remain unsynced.
+        _sessionPool->maybeCheckpointWAL(_session.get());
     } else {
         SqliteStatement::execQuery(_session.get(), "ROLLBACK");
     }
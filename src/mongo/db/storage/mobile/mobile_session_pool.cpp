@@ -38,12 +38,15 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/mobile/mobile_options.h"
 #include "mongo/db/storage/mobile/mobile_session.h"
 #include "mongo/db/storage/mobile/mobile_session_pool.h"
 #include "mongo/db/storage/mobile/mobile_sqlite_statement.h"
 #include "mongo/db/storage/mobile/mobile_util.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -95,7 +98,9 @@ bool MobileDelayedOpQueue::isEmpty() {
 }
 
 MobileSessionPool::MobileSessionPool(const std::string& path, std::uint64_t maxPoolSize)
-    : _path(path), _maxPoolSize(maxPoolSize) {}
+    : _path(path),
+      _maxPoolSize(maxPoolSize),
+      _lastWALCheckpointMillis(Date_t::now().toMillisSinceEpoch()) {}
 
 MobileSessionPool::~MobileSessionPool() {
     shutDown();
@@ -119,6 +124,7 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
         sqlite3* session;
         int status = sqlite3_open(_path.c_str(), &session);
         checkStatus(status, SQLITE_OK, "sqlite3_open");
+        _configureSession(session);
         _curPoolSize++;
         return stdx::make_unique<MobileSession>(session, this);
     }
@@ -166,6 +172,7 @@ void MobileSessionPool::shutDown() {
 
         int status = sqlite3_open(_path.c_str(), &session);
         checkStatus(status, SQLITE_OK, "sqlite3_open");
+        _configureSession(session);
         std::unique_ptr<MobileSession> mobSession = stdx::make_unique<MobileSession>(session, this);
         LOG(MOBILE_LOG_LEVEL_LOW) << "MobileSE: Executing queued drops at shutdown";
         failedDropsQueue.execAndDequeueAllOps(mobSession.get());
@@ -177,6 +184,55 @@ void MobileSessionPool::shutDown() {
     }
 }
 
+void MobileSessionPool::maybeCheckpointWAL(MobileSession* session) {
+    // At FULL (or higher) durability every commit already syncs the WAL, and a deadline of 0
+    // leaves checkpoint scheduling entirely to SQLite's automatic checkpointer.
+    if (mobileGlobalOptions.durabilityLevel >= MobileGlobalOptions::kSynchronousFull ||
+        mobileGlobalOptions.durabilityDeadlineMillis == 0) {
+        return;
+    }
+
+    int64_t nowMillis = Date_t::now().toMillisSinceEpoch();
+    if (nowMillis - _lastWALCheckpointMillis.load() < mobileGlobalOptions.durabilityDeadlineMillis) {
+        return;
+    }
+
+    try {
+        SqliteStatement::execQuery(session, "PRAGMA wal_checkpoint(PASSIVE);");
+        _lastWALCheckpointMillis.store(nowMillis);
+        LOG(MOBILE_LOG_LEVEL_LOW) << "MobileSE: Checkpointed the WAL on reaching the durability "
+                                     "deadline";
+    } catch (const WriteConflictException&) {
+        // A concurrent reader is pinning the WAL. The commit this call follows has already
+        // succeeded, so leave the sync to a later commit rather than retrying here.
+        LOG(MOBILE_LOG_LEVEL_LOW) << "MobileSE: Deferred a durability-deadline WAL checkpoint "
+                                     "because the WAL is busy";
+    }
+}
+
+void MobileSessionPool::_configureSession(sqlite3* session) {
+    // These pragmas only affect the connection they are executed on, so they are applied to each
+    // session the pool opens rather than once at engine startup.
+    std::vector<std::string> pragmas;
+    pragmas.push_back(str::stream() << "PRAGMA synchronous = "
+                                    << mobileGlobalOptions.durabilityLevel << ";");
+    pragmas.push_back(str::stream() << "PRAGMA wal_autocheckpoint = "
+                                    << mobileGlobalOptions.walAutoCheckpointPages << ";");
+    if (mobileGlobalOptions.walSizeLimitKB > 0) {
+        pragmas.push_back(str::stream()
+                          << "PRAGMA journal_size_limit = "
+                          << static_cast<int64_t>(mobileGlobalOptions.walSizeLimitKB) * 1024
+                          << ";");
+    }
+
+    for (auto&& pragma : pragmas) {
+        char* errMsg = NULL;
+        int status = sqlite3_exec(session, pragma.c_str(), NULL, NULL, &errMsg);
+        checkStatus(status, SQLITE_OK, "sqlite3_exec", errMsg);
+        sqlite3_free(errMsg);
+    }
+}
+
 // This method should only be called when _sessions is locked.
 sqlite3* MobileSessionPool::_popSession_inlock() {
     sqlite3* session = _sessions.back();
@@ -36,6 +36,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/mobile/mobile_session.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
 
 namespace mongo {
@@ -87,10 +88,22 @@ public:
      */
     void shutDown();
 
+    /**
+     * Checkpoints the WAL on the given session if the configured durability deadline has passed
+     * since the last checkpoint. Called by a writer after committing; a no-op unless the engine
+     * is running with a reduced durability level, where commits do not sync the WAL themselves.
+     */
+    void maybeCheckpointWAL(MobileSession* session);
+
     // Failed drops get queued here and get re-tried periodically
     MobileDelayedOpQueue failedDropsQueue;
 
 private:
+    /**
+     * Applies the configured per-connection pragmas to a newly opened session.
+     */
+    void _configureSession(sqlite3* session);
+
     /**
      * Gets the front element from _sessions and then pops it off the queue.
      */
@@ -111,5 +124,9 @@ private:
 
     using SessionPool = std::vector<sqlite3*>;
     SessionPool _sessions;
+
+    // Time, in millis since epoch, of the last durability-deadline checkpoint. Only advanced by
+    // the committing writer, which runs under the global exclusive lock.
+    AtomicInt64 _lastWALCheckpointMillis;
 };
 }  // namespace mongo
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -136,6 +138,28 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Moves forward up to 'maxBatch' times, appending each record to 'out', and returns the
+     * number of records appended. Fewer than 'maxBatch' records means the cursor hit the same
+     * condition that would make next() return boost::none. Unlike next(), the appended records
+     * own their data, so they remain valid after the cursor moves again.
+     *
+     * Storage engines should override this when they can amortize per-record cursor entry costs
+     * over the batch; the default implementation simply drives next() in a loop.
+     */
+    virtual size_t nextBatch(size_t maxBatch, std::vector<Record>* out) {
+        size_t count = 0;
+        while (count < maxBatch) {
+            auto record = next();
+            if (!record)
+                break;
+            record->data.makeOwned();
+            out->push_back(std::move(*record));
+            ++count;
+        }
+        return count;
+    }
+
     //
     // Saving and restoring state
     //
@@ -319,6 +343,44 @@ public:
         return true;
     }
 
+    /**
+     * Batched form of findRecord(). Fetches the record for each id in 'ids', filling '*out' so
+     * that (*out)[i] holds the data for ids[i]; ids with no record leave their slot as a
+     * default-constructed (null) RecordData. Returns the number of records found.
+     *
+     * The lookups are performed in RecordId order on a single cursor regardless of the order of
+     * 'ids', so ids that cluster on the same leaf pages are fetched together. The returned data
+     * is always owned.
+     */
+    virtual size_t findRecords(OperationContext* opCtx,
+                               const std::vector<RecordId>& ids,
+                               std::vector<RecordData>* out) const {
+        out->clear();
+        out->resize(ids.size());
+
+        // Visit the ids in sorted order so the cursor sweeps forward through the tree, but fill
+        // '*out' positionally so callers can match results to their inputs.
+        std::vector<size_t> order(ids.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&ids](size_t lhs, size_t rhs) {
+            return ids[lhs] < ids[rhs];
+        });
+
+        auto cursor = getCursor(opCtx);
+        size_t numFound = 0;
+        for (size_t i : order) {
+            auto record = cursor->seekExact(ids[i]);
+            if (!record)
+                continue;
+            record->data.makeOwned();  // Unowned data expires when the cursor moves on.
+            (*out)[i] = std::move(record->data);
+            numFound++;
+        }
+        return numFound;
+    }
+
     virtual void deleteRecord(OperationContext* opCtx, const RecordId& dl) = 0;
 
     virtual StatusWith<RecordId> insertRecord(OperationContext* opCtx,
@@ -530,8 +592,10 @@ public:
     }
 
     /**
-     * Return the RecordId of an oplog entry as close to startingPosition as possible without
-     * being higher. If there are no entries <= startingPosition, return RecordId().
+     * Return the RecordId of a record as close to startingPosition as possible without being
+     * higher. If there are no records <= startingPosition, return RecordId(). Despite the name,
+     * this is not limited to the oplog: it also serves as the positioned probe behind bounded
+     * scans of other insert-ordered collections.
      *
      * If you don't implement the oplogStartHack, just use the default implementation which
      * returns boost::none.
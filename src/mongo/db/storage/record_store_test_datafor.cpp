@@ -133,5 +133,61 @@ TEST(RecordStoreTestHarness, DataForMultiple) {
     }
 }
 
+// Insert multiple records and fetch them in a single batched call, in an order other than the
+// one they were inserted in, along with an id that doesn't exist.
+TEST(RecordStoreTestHarness, FindRecords) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10;
+    RecordId locs[nToInsert];
+    for (int i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            stringstream ss;
+            ss << "record----" << i;
+            string data = ss.str();
+
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            locs[i] = res.getValue();
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        // Request the records in reverse insertion order, with a missing id in the middle.
+        std::vector<RecordId> ids;
+        for (int i = nToInsert - 1; i >= 0; i--) {
+            ids.push_back(locs[i]);
+        }
+        ids.insert(ids.begin() + 5, RecordId(nToInsert + 1000));
+
+        std::vector<RecordData> records;
+        ASSERT_EQUALS(static_cast<size_t>(nToInsert), rs->findRecords(opCtx.get(), ids, &records));
+        ASSERT_EQUALS(ids.size(), records.size());
+
+        size_t idx = 0;
+        for (int i = nToInsert - 1; i >= 0; i--, idx++) {
+            if (idx == 5) {
+                // The missing id leaves a null RecordData in its slot.
+                ASSERT(!records[idx].data());
+                idx++;
+            }
+
+            stringstream ss;
+            ss << "record----" << i;
+            string data = ss.str();
+
+            ASSERT_EQUALS(data.size() + 1, static_cast<size_t>(records[idx].size()));
+            ASSERT_EQUALS(data, records[idx].data());
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
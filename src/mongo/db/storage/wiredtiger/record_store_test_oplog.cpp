@@ -168,7 +168,10 @@ TEST(RecordStore_Oplog, OplogHackOnNonOplog) {
                       .getStatus());
         wuow.commit();
     }
-    ASSERT_EQ(rs->oplogStartHack(opCtx.get(), RecordId(0, 1)), boost::none);
+    // The hack is no longer restricted to the oplog; on other collections it is a plain
+    // positioned probe over RecordIds.
+    ASSERT_EQ(rs->oplogStartHack(opCtx.get(), RecordId(0, 1)), RecordId(1));
+    ASSERT_EQ(rs->oplogStartHack(opCtx.get(), RecordId()), RecordId());
 }
 
 
@@ -34,6 +34,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 
+#include <algorithm>
+#include <cstring>
 #include <set>
 
 #include "mongo/base/checked_cast.h"
@@ -677,8 +679,11 @@ public:
 private:
     StatusWith<SpecialFormatInserted> addKeyTimestampSafe(const BSONObj& newKey,
                                                           const RecordId& id) {
-        // Do a duplicate check
-        const int cmp = newKey.woCompare(_previousKey, _ordering);
+        // Encode the key portion before the duplicate check, so the check is a memcmp of the
+        // KeyString encodings (which are equal exactly when the keys compare equal) instead of
+        // a full BSON comparison plus an owned copy of the key for every call.
+        _keyString.resetToKey(newKey, _idx->ordering());
+        const int cmp = _compareToPreviousKey();
         if (cmp == 0) {
             // Duplicate found!
             if (!_dupsAllowed) {
@@ -686,12 +691,16 @@ private:
                     newKey, _idx->collectionNamespace(), _idx->indexName(), _idx->keyPattern());
             }
         } else {
-            // _previousKey.isEmpty() is only true on the first call to addKey().
+            // _previousKeyBytes.empty() is only true on the first call to addKey().
             // newKey must be > the last key
-            invariant(_previousKey.isEmpty() || cmp > 0);
+            invariant(_previousKeyBytes.empty() || cmp > 0);
         }
 
-        _keyString.resetToKey(newKey, _idx->ordering(), id);
+        _previousKeyBytes.assign(_keyString.getBuffer(), _keyString.getSize());
+
+        // Appending the RecordId produces the same bytes and TypeBits as encoding the key and
+        // the RecordId together would have.
+        _keyString.appendRecordId(id);
 
         // Can't use WiredTigerCursor since we aren't using the cache.
         WiredTigerItem keyItem(_keyString.getBuffer(), _keyString.getSize());
@@ -706,8 +715,6 @@ private:
 
         invariantWTOK(_cursor->insert(_cursor));
 
-        _previousKey = newKey.getOwned();
-
         if (_keyString.getTypeBits().isLongEncoding())
             return StatusWith<SpecialFormatInserted>(SpecialFormatInserted::LongTypeBitsInserted);
 
@@ -775,11 +782,34 @@ private:
         return SpecialFormatInserted::NoSpecialFormatInserted;
     }
 
+    /**
+     * Compares the key encoding currently in '_keyString' (which must not yet have a RecordId
+     * appended) against '_previousKeyBytes'. KeyString encodings are ordered by their bytes, so
+     * this returns a value with the same sign as woCompare() on the original keys would.
+     */
+    int _compareToPreviousKey() const {
+        const size_t newSize = _keyString.getSize();
+        const size_t commonSize = std::min(_previousKeyBytes.size(), newSize);
+        const int cmp = memcmp(_keyString.getBuffer(), _previousKeyBytes.data(), commonSize);
+        if (cmp != 0)
+            return cmp;
+        if (newSize == _previousKeyBytes.size())
+            return 0;
+        return newSize < _previousKeyBytes.size() ? -1 : 1;
+    }
+
     WiredTigerIndex* _idx;
     const bool _dupsAllowed;
     KeyString _keyString;
     std::vector<std::pair<RecordId, KeyString::TypeBits>> _records;
+
+    // The previous key in BSON form. Only used by the timestamp-unsafe format, where
+    // '_keyString' holds the encoding of the key group pending in '_records'.
     BSONObj _previousKey;
+
+    // The KeyString encoding (without RecordId) of the previous key. Only used by the
+    // timestamp-safe format.
+    std::string _previousKeyBytes;
 };
 
 namespace {
@@ -80,6 +80,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/background.h"
@@ -379,17 +380,67 @@ private:
     AtomicWord<std::uint64_t> _oplogNeededForCrashRecovery;
 };
 
+/**
+ * Periodically flushes the buffered collection size information to the size storer table.
+ * Doing this on a dedicated thread keeps the flush, which can visit tens of thousands of
+ * dirty entries, off the operation threads that buffer the updates.
+ */
+class WiredTigerKVEngine::WiredTigerSizeStorerFlusher : public BackgroundJob {
+public:
+    explicit WiredTigerSizeStorerFlusher(WiredTigerKVEngine* engine)
+        : BackgroundJob(false /* deleteSelf */), _engine(engine) {}
+
+    virtual string name() const {
+        return "WTSizeStorerFlusher";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        LOG(1) << "starting " << name() << " thread";
+
+        while (!_shuttingDown.load()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(1);
+            }
+            if (_shuttingDown.load())
+                break;
+
+            if (!_engine->_sizeStorerSyncTracker.intervalHasElapsed())
+                continue;
+            _engine->_sizeStorerSyncTracker.resetLastTime();
+            _engine->syncSizeInfo(false);
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    WiredTigerKVEngine* _engine;
+    AtomicBool _shuttingDown{false};
+};
+
 namespace {
 
 class TicketServerParameter : public ServerParameter {
     MONGO_DISALLOW_COPYING(TicketServerParameter);
 
 public:
-    TicketServerParameter(TicketHolder* holder, const std::string& name)
-        : ServerParameter(ServerParameterSet::getGlobal(), name, true, true), _holder(holder) {}
+    TicketServerParameter(TicketHolder* holder, AtomicInt32* configured, const std::string& name)
+        : ServerParameter(ServerParameterSet::getGlobal(), name, true, true),
+          _holder(holder),
+          _configured(configured) {}
 
     virtual void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) {
-        b.append(name, _holder->outof());
+        // Report the configured size; the ticket controller may have temporarily shrunk the
+        // holder below it while the cache is under eviction pressure.
+        b.append(name, _configured->load());
     }
 
     virtual Status set(const BSONElement& newValueElement) {
@@ -411,26 +462,307 @@ public:
             return Status(ErrorCodes::BadValue, str::stream() << name() << " has to be > 0");
         }
 
-        return _holder->resize(newNum);
+        Status status = _holder->resize(newNum);
+        if (status.isOK()) {
+            _configured->store(newNum);
+        }
+        return status;
     }
 
 private:
     TicketHolder* _holder;
+    AtomicInt32* _configured;
 };
 
-TicketHolder openWriteTransaction(128);
+// A few tickets on each side are reserved for replication and other internal operations, so
+// that oplog application (and on secondaries, oplog batch reads) cannot be starved by a
+// saturating user workload. The reserve is fixed because these holders are constructed before
+// server parameters are parsed; resize() enforces that the total stays above it.
+const int kReservedInternalTickets = 4;
+
+TicketHolder openWriteTransaction(128, kReservedInternalTickets);
+AtomicInt32 openWriteTransactionConfigured(128);
 TicketServerParameter openWriteTransactionParam(&openWriteTransaction,
+                                                &openWriteTransactionConfigured,
                                                 "wiredTigerConcurrentWriteTransactions");
 
-TicketHolder openReadTransaction(128);
+TicketHolder openReadTransaction(128, kReservedInternalTickets);
+AtomicInt32 openReadTransactionConfigured(128);
 TicketServerParameter openReadTransactionParam(&openReadTransaction,
+                                               &openReadTransactionConfigured,
                                                "wiredTigerConcurrentReadTransactions");
 
+// Enables the background controller that temporarily shrinks the available read/write tickets
+// while WiredTiger cache eviction is falling behind and restores them once pressure subsides.
+AtomicBool kWiredTigerEvictionTicketThrottlingEnabled(true);
+ExportedServerParameter<bool, ServerParameterType::kStartupAndRuntime>
+    WiredTigerEvictionTicketThrottlingEnabledSetting(ServerParameterSet::getGlobal(),
+                                                     "wiredTigerEvictionTicketThrottlingEnabled",
+                                                     &kWiredTigerEvictionTicketThrottlingEnabled);
+
+// Seconds between background compaction passes over the WiredTiger tables. Zero, the default,
+// disables background compaction.
+AtomicInt32 kWiredTigerBackgroundCompactionSecs(0);
+ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
+    WiredTigerBackgroundCompactionSecsSetting(ServerParameterSet::getGlobal(),
+                                              "wiredTigerBackgroundCompactionSecs",
+                                              &kWiredTigerBackgroundCompactionSecs);
+
 stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](StringData) -> bool {
     fassertFailed(40358);
 };
 }  // namespace
 
+/**
+ * Adjusts the number of available read/write tickets in response to cache eviction pressure.
+ * Admitting a full complement of operations while eviction is falling behind only deepens the
+ * stall, so while the cache pressure score stays above the threshold the controller halves the
+ * tickets (down to a quarter of the configured count) and, once pressure subsides, grows them
+ * back additively to the configured count.
+ */
+class WiredTigerKVEngine::WiredTigerTicketController : public BackgroundJob {
+public:
+    explicit WiredTigerTicketController(WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+
+    virtual string name() const {
+        return "WTTicketController";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        LOG(1) << "starting " << name() << " thread";
+
+        while (!_shuttingDown.load()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(1);
+            }
+            if (_shuttingDown.load())
+                break;
+
+            _adjustTickets();
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    void _adjustTickets() {
+        if (!kWiredTigerEvictionTicketThrottlingEnabled.load()) {
+            // A disabled controller must leave the tickets at their configured sizes.
+            _restoreIfNeeded(&openWriteTransaction, openWriteTransactionConfigured.load());
+            _restoreIfNeeded(&openReadTransaction, openReadTransactionConfigured.load());
+            return;
+        }
+
+        int64_t score;
+        try {
+            UniqueWiredTigerSession session = _sessionCache->getSession();
+            score = uassertStatusOK(WiredTigerUtil::getStatisticsValueAs<int64_t>(
+                session->getSession(), "statistics:", "", WT_STAT_CONN_CACHE_LOOKASIDE_SCORE));
+        } catch (const DBException& ex) {
+            LOG(1) << "could not sample eviction statistics: " << ex;
+            return;
+        }
+
+        const int32_t threshold = snapshotWindowParams.cachePressureThreshold.load();
+        _adjustHolder(
+            &openWriteTransaction, openWriteTransactionConfigured.load(), score, threshold);
+        _adjustHolder(&openReadTransaction, openReadTransactionConfigured.load(), score, threshold);
+    }
+
+    void _adjustHolder(TicketHolder* holder, int configured, int64_t score, int32_t threshold) {
+        const int current = holder->outof();
+        int target = current;
+        if (score >= threshold) {
+            // Under pressure: back off multiplicatively, but never below a quarter of the
+            // configured tickets (nor below the TicketHolder's own minimum of 5).
+            target = std::max(5, std::max(configured / 4, current / 2));
+        } else if (score < threshold / 2 && current < configured) {
+            // Pressure has subsided: grow back additively so admission ramps up smoothly.
+            target = std::min(configured, current + std::max(1, configured / 8));
+        }
+        if (target == current)
+            return;
+
+        log() << "adjusting WiredTiger concurrent transaction tickets from " << current << " to "
+              << target << " (cache pressure score " << score << ", threshold " << threshold
+              << ")";
+        _resize(holder, target);
+    }
+
+    void _restoreIfNeeded(TicketHolder* holder, int configured) {
+        if (holder->outof() != configured)
+            _resize(holder, configured);
+    }
+
+    void _resize(TicketHolder* holder, int newSize) {
+        // Shrinking waits for enough operations to finish and retire their tickets, which is
+        // exactly the admission backpressure we are after.
+        Status status = holder->resize(newSize);
+        if (!status.isOK()) {
+            warning() << "failed to resize WiredTiger transaction tickets to " << newSize << ": "
+                      << status;
+        }
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    AtomicBool _shuttingDown{false};
+};
+
+/**
+ * Periodically walks the WiredTiger tables and asks WiredTiger to compact each one, moving data
+ * towards the front of its file so the free space that accumulates at the end can be returned to
+ * the operating system. Compaction runs online, concurrently with regular operations, but it does
+ * generate cache and I/O work: each table gets a bounded amount of compaction time per pass, and
+ * a pass yields while cache eviction pressure is high so compaction never competes with an
+ * already struggling workload. Disabled unless wiredTigerBackgroundCompactionSecs is set.
+ */
+class WiredTigerKVEngine::WiredTigerBackgroundCompactor : public BackgroundJob {
+public:
+    explicit WiredTigerBackgroundCompactor(WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+
+    virtual string name() const {
+        return "WTBackgroundCompactor";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        LOG(1) << "starting " << name() << " thread";
+
+        int secsSinceLastPass = 0;
+        while (!_shuttingDown.load()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(1);
+            }
+            if (_shuttingDown.load())
+                break;
+
+            const int intervalSecs = kWiredTigerBackgroundCompactionSecs.load();
+            if (intervalSecs <= 0) {
+                // Disabled. Enabling it at runtime starts counting from scratch.
+                secsSinceLastPass = 0;
+                continue;
+            }
+
+            if (++secsSinceLastPass < intervalSecs)
+                continue;
+
+            if (_underCachePressure()) {
+                // Leave the counter elapsed so the pass starts as soon as pressure subsides.
+                continue;
+            }
+            secsSinceLastPass = 0;
+
+            try {
+                _compactPass();
+            } catch (const AssertionException& e) {
+                invariant(e.code() == ErrorCodes::ShutdownInProgress);
+            }
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+    void appendStats(BSONObjBuilder* bob) const {
+        bob->append("passes", _passes.load());
+        bob->append("tablesCompacted", _tablesCompacted.load());
+        bob->append("bytesAvailableForReuse", _bytesAvailableForReuse.load());
+    }
+
+private:
+    bool _underCachePressure() {
+        int64_t score;
+        try {
+            UniqueWiredTigerSession session = _sessionCache->getSession();
+            score = uassertStatusOK(WiredTigerUtil::getStatisticsValueAs<int64_t>(
+                session->getSession(), "statistics:", "", WT_STAT_CONN_CACHE_LOOKASIDE_SCORE));
+        } catch (const DBException& ex) {
+            LOG(1) << "could not sample eviction statistics: " << ex;
+            // Without a pressure reading, err on the side of not compacting.
+            return true;
+        }
+        return score >= snapshotWindowParams.cachePressureThreshold.load();
+    }
+
+    void _compactPass() {
+        int64_t bytesAvailable = 0;
+        for (const auto& uri : _tableURIs()) {
+            // Stop mid-pass if the server is shutting down, the feature was turned off, or the
+            // cache came under pressure; the remaining tables wait for the next pass.
+            if (_shuttingDown.load() || kWiredTigerBackgroundCompactionSecs.load() <= 0 ||
+                _underCachePressure())
+                return;
+
+            bytesAvailable += _compactTable(uri);
+        }
+        _bytesAvailableForReuse.store(bytesAvailable);
+        _passes.addAndFetch(1);
+    }
+
+    std::vector<std::string> _tableURIs() {
+        std::vector<std::string> uris;
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        WT_SESSION* s = session->getSession();
+        WT_CURSOR* c = nullptr;
+        invariantWTOK(s->open_cursor(s, "metadata:", nullptr, nullptr, &c));
+        ON_BLOCK_EXIT([&] { invariantWTOK(c->close(c)); });
+        int ret;
+        while ((ret = c->next(c)) == 0) {
+            const char* key;
+            invariantWTOK(c->get_key(c, &key));
+            if (StringData(key).startsWith("table:"))
+                uris.push_back(key);
+        }
+        invariant(ret == WT_NOTFOUND);
+        return uris;
+    }
+
+    int64_t _compactTable(const std::string& uri) {
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        WT_SESSION* s = session->getSession();
+
+        // Bound the work per table so one badly fragmented table cannot monopolize the pass; a
+        // table that runs out of time simply resumes where compaction left off on the next pass.
+        int ret = s->compact(s, uri.c_str(), "timeout=60");
+        if (ret == EBUSY || ret == ETIMEDOUT || ret == ENOENT || ret == WT_NOTFOUND) {
+            // The table is being checkpointed or dropped, or needs more time than this pass
+            // allows. Nothing is wrong; revisit it on the next pass.
+            LOG(2) << "background compaction of " << uri
+                   << " skipped: " << wiredtiger_strerror(ret);
+        } else if (ret != 0) {
+            warning() << "background compaction of " << uri << " failed: " << wtRCToStatus(ret);
+        } else {
+            _tablesCompacted.addAndFetch(1);
+        }
+
+        auto swBytes = WiredTigerUtil::getStatisticsValueAs<int64_t>(
+            s, "statistics:" + uri, "statistics=(fast)", WT_STAT_DSRC_BLOCK_REUSE_BYTES);
+        return swBytes.isOK() ? swBytes.getValue() : 0;
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    AtomicBool _shuttingDown{false};
+    AtomicInt64 _passes{0};
+    AtomicInt64 _tablesCompacted{0};
+    AtomicInt64 _bytesAvailableForReuse{0};
+};
+
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
                                        const std::string& path,
                                        ClockSource* cs,
@@ -573,6 +905,19 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
+    if (!_readOnly) {
+        _sizeStorerFlusher = stdx::make_unique<WiredTigerSizeStorerFlusher>(this);
+        _sizeStorerFlusher->go();
+
+        _ticketController = stdx::make_unique<WiredTigerTicketController>(_sessionCache.get());
+        _ticketController->go();
+    }
+
+    if (!_readOnly && !_ephemeral) {
+        _backgroundCompactor = stdx::make_unique<WiredTigerBackgroundCompactor>(_sessionCache.get());
+        _backgroundCompactor->go();
+    }
+
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 }
 
@@ -602,6 +947,13 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.done();
     }
     bb.done();
+
+    if (_backgroundCompactor) {
+        BSONObjBuilder cb(b.subobjStart("backgroundCompaction"));
+        cb.appendBool("enabled", kWiredTigerBackgroundCompactionSecs.load() > 0);
+        _backgroundCompactor->appendStats(&cb);
+        cb.done();
+    }
 }
 
 void WiredTigerKVEngine::_openWiredTiger(const std::string& path, const std::string& wtOpenConfig) {
@@ -664,6 +1016,21 @@ void WiredTigerKVEngine::_openWiredTiger(const std::string& path, const std::str
 
 void WiredTigerKVEngine::cleanShutdown() {
     log() << "WiredTigerKVEngine shutting down";
+    if (_backgroundCompactor) {
+        log() << "Shutting down background compactor thread";
+        _backgroundCompactor->shutdown();
+        log() << "Finished shutting down background compactor thread";
+    }
+    if (_sizeStorerFlusher) {
+        log() << "Shutting down size storer flusher thread";
+        _sizeStorerFlusher->shutdown();
+        log() << "Finished shutting down size storer flusher thread";
+    }
+    if (_ticketController) {
+        log() << "Shutting down ticket controller thread";
+        _ticketController->shutdown();
+        log() << "Finished shutting down ticket controller thread";
+    }
     if (!_readOnly)
         syncSizeInfo(true);
     if (!_conn) {
@@ -1192,11 +1559,6 @@ bool WiredTigerKVEngine::haveDropsQueued() const {
     Date_t now = _clockSource->now();
     Milliseconds delta = now - _previousCheckedDropsQueued;
 
-    if (!_readOnly && _sizeStorerSyncTracker.intervalHasElapsed()) {
-        _sizeStorerSyncTracker.resetLastTime();
-        syncSizeInfo(false);
-    }
-
     // We only want to check the queue max once per second or we'll thrash
     if (delta < Milliseconds(1000))
         return false;
@@ -1558,6 +1920,11 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
                           << stableTS.toString());
     }
 
+    // Stop the size storer flusher before the size storer is flushed and replaced below.
+    if (_sizeStorerFlusher) {
+        _sizeStorerFlusher->shutdown();
+    }
+
     LOG_FOR_ROLLBACK(2) << "WiredTiger::RecoverToStableTimestamp syncing size storer to disk.";
     syncSizeInfo(true);
 
@@ -1569,6 +1936,9 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
             _journalFlusher->shutdown();
         }
         _checkpointThread->shutdown();
+        if (_backgroundCompactor) {
+            _backgroundCompactor->shutdown();
+        }
     }
 
     const Timestamp stableTimestamp(_stableTimestamp.load());
@@ -1589,10 +1959,20 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
         }
         _checkpointThread = std::make_unique<WiredTigerCheckpointThread>(this, _sessionCache.get());
         _checkpointThread->go();
+        if (!_readOnly) {
+            _backgroundCompactor =
+                std::make_unique<WiredTigerBackgroundCompactor>(_sessionCache.get());
+            _backgroundCompactor->go();
+        }
     }
 
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
+    if (!_readOnly) {
+        _sizeStorerFlusher = std::make_unique<WiredTigerSizeStorerFlusher>(this);
+        _sizeStorerFlusher->go();
+    }
+
     return {stableTimestamp};
 }
 
@@ -335,6 +335,9 @@ public:
 private:
     class WiredTigerJournalFlusher;
     class WiredTigerCheckpointThread;
+    class WiredTigerSizeStorerFlusher;
+    class WiredTigerTicketController;
+    class WiredTigerBackgroundCompactor;
 
     /**
      * Opens a connection on the WiredTiger database 'path' with the configuration 'wtOpenConfig'.
@@ -416,6 +419,9 @@ private:
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
+    std::unique_ptr<WiredTigerSizeStorerFlusher> _sizeStorerFlusher;  // Depends on _sizeStorer
+    std::unique_ptr<WiredTigerTicketController> _ticketController;
+    std::unique_ptr<WiredTigerBackgroundCompactor> _backgroundCompactor;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -239,8 +239,10 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(
         }
         lk.unlock();
 
-        // Wake up any await_data cursors and tell them more data might be visible now.
-        oplogRecordStore->notifyCappedWaitersIfNeeded();
+        // Wake up any await_data cursors and tell them more data might be visible now. All newly
+        // visible entries have timestamps at or below the published read timestamp, so waiters
+        // that need an entry above it can stay asleep.
+        oplogRecordStore->notifyCappedWaitersIfNeeded(Timestamp(newTimestamp));
     }
 }
 
@@ -123,8 +123,24 @@ public:
 
         _oplogStones->_currentRecords.addAndFetch(_countInserted);
         int64_t newCurrentBytes = _oplogStones->_currentBytes.addAndFetch(_bytesInserted);
+
+        // Commits may finish out of order, so raise the highest seen record with a CAS loop
+        // rather than a plain store. This is the only bookkeeping the insert path does; cutting
+        // stones is left entirely to the oplog reclaim thread.
+        const int64_t repr = _highestInserted.repr();
+        int64_t seen = _oplogStones->_highestSeenRecord.load();
+        while (repr > seen) {
+            const int64_t found = _oplogStones->_highestSeenRecord.compareAndSwap(seen, repr);
+            if (found == seen) {
+                break;
+            }
+            seen = found;
+        }
+
         if (newCurrentBytes >= _oplogStones->_minBytesPerStone) {
-            _oplogStones->createNewStoneIfNeeded(_highestInserted);
+            // The stone being filled is full. Nudge the reclaim thread to cut it; notifying a
+            // condition variable doesn't block on any mutex held by other inserters.
+            _oplogStones->_oplogReclaimCv.notify_one();
         }
     }
 
@@ -144,9 +160,11 @@ public:
     void commit(boost::optional<Timestamp>) final {
         _oplogStones->_currentRecords.store(0);
         _oplogStones->_currentBytes.store(0);
+        _oplogStones->_highestSeenRecord.store(0);
 
         stdx::lock_guard<stdx::mutex> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_totalBytesInStones = 0;
     }
 
     void rollback() final {}
@@ -192,6 +210,10 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
     // Wait until kill() is called or there are too many oplog stones.
     stdx::unique_lock<stdx::mutex> lock(_oplogReclaimMutex);
     while (!_isDead) {
+        // Cut a stone if committed inserts have filled the current one. The insert path only
+        // bumps atomic counters and nudges this thread, so the stones mutex is only ever taken
+        // in the background.
+        cutNewStoneIfNeeded();
         {
             MONGO_IDLE_THREAD_BLOCK;
             stdx::lock_guard<stdx::mutex> lk(_mutex);
@@ -228,32 +250,34 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _totalBytesInStones -= _stones.front().bytes;
     _stones.pop_front();
 }
 
-void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex, stdx::try_to_lock);
-    if (!lk) {
-        // Someone else is either already creating a new stone or popping the oldest one. In the
-        // latter case, we let the next insert trigger the new stone's creation.
+void WiredTigerRecordStore::OplogStones::cutNewStoneIfNeeded() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    if (_currentBytes.load() < _minBytesPerStone) {
+        // The stone being filled isn't full yet; this was a stale nudge from the insert path.
         return;
     }
 
-    if (_currentBytes.load() < _minBytesPerStone) {
-        // Must have raced to create a new stone, someone else already triggered it.
+    RecordId lastRecord = RecordId(_highestSeenRecord.load());
+    if (!lastRecord.isValid()) {
+        // No insert has committed since startup, so there is no boundary to cut at yet.
         return;
     }
 
-    if (!_stones.empty() && lastRecord < _stones.back().lastRecord) {
-        // Skip creating a new stone when the record's position comes before the most recently
-        // created stone. We likely raced with another batch of inserts that caused us to try and
-        // make multiples stones.
+    if (!_stones.empty() && lastRecord <= _stones.back().lastRecord) {
+        // The highest committed record hasn't advanced past the most recently created stone, so
+        // cutting here wouldn't keep the stones' boundaries in increasing order.
         return;
     }
 
     LOG(2) << "create new oplogStone, current stones:" << _stones.size();
     OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), lastRecord};
     _stones.push_back(stone);
+    _totalBytesInStones += stone.bytes;
 
     _pokeReclaimThreadIfNeeded();
 }
@@ -293,6 +317,13 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _totalBytesInStones -= bytesInStonesToRemove;
+
+    // The highest record seen by an insert may have been truncated away. Lower the tracked value
+    // so that the next stone cut doesn't cover records that no longer exist.
+    if (_highestSeenRecord.load() >= firstRemovedId.repr()) {
+        _highestSeenRecord.store(firstRemovedId.repr() - 1);
+    }
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -356,8 +387,10 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationCon
 
             OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), record->id};
             _stones.push_back(stone);
+            _totalBytesInStones += stone.bytes;
         }
 
+        _highestSeenRecord.store(record->id.repr());
         numRecords++;
         dataSize += record->data.size();
     }
@@ -397,6 +430,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
             return;
         }
         latestOpTime = Timestamp(record->id.repr());
+        _highestSeenRecord.store(record->id.repr());
     }
 
     log() << "Sampling from the oplog between " << earliestOpTime.toStringPretty() << " and "
@@ -441,6 +475,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
         log() << "Placing a marker at optime " << Timestamp(lastRecord.repr()).toStringPretty();
         OplogStones::Stone stone = {estRecordsPerStone, estBytesPerStone, lastRecord};
         _stones.push_back(stone);
+        _totalBytesInStones += stone.bytes;
     }
 
     // Account for the partially filled chunk.
@@ -1335,11 +1370,11 @@ bool WiredTigerRecordStore::haveCappedWaiters() {
     return _cappedCallback && _cappedCallback->haveCappedWaiters();
 }
 
-void WiredTigerRecordStore::notifyCappedWaitersIfNeeded() {
+void WiredTigerRecordStore::notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs) {
     stdx::lock_guard<stdx::mutex> cappedCallbackLock(_cappedCallbackMutex);
     // This wakes up cursors blocking in await_data.
     if (_cappedCallback) {
-        _cappedCallback->notifyCappedWaitersIfNeeded();
+        _cappedCallback->notifyCappedWaitersIfNeeded(commitTs);
     }
 }
 
@@ -1644,9 +1679,6 @@ boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
     OperationContext* opCtx, const RecordId& startingPosition) const {
     dassert(opCtx->lockState()->isReadLocked());
 
-    if (!_isOplog)
-        return boost::none;
-
     if (_isOplog) {
         WiredTigerRecoveryUnit::get(opCtx)->setIsOplogReader();
     }
@@ -1876,8 +1908,34 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     if (_eof)
         return {};
 
+    return _advance(_cursor->get());
+}
+
+size_t WiredTigerRecordStoreCursorBase::nextBatch(size_t maxBatch, std::vector<Record>* out) {
+    if (_eof)
+        return 0;
+
+    // Enter the underlying cursor once for the whole batch. For forward oplog scans, visibility
+    // is fixed by the snapshot's read timestamp when the cursor is created, so a batch observes
+    // one visibility point rather than re-establishing it per record.
     WT_CURSOR* c = _cursor->get();
 
+    size_t count = 0;
+    while (count < maxBatch) {
+        auto record = _advance(c);
+        if (!record)
+            break;
+
+        // The data returned by _advance() points into the WT_CURSOR's buffer and would be
+        // invalidated by the next advance, so batched records must own their data.
+        record->data.makeOwned();
+        out->push_back(std::move(*record));
+        ++count;
+    }
+    return count;
+}
+
+boost::optional<Record> WiredTigerRecordStoreCursorBase::_advance(WT_CURSOR* c) {
     RecordId id;
     if (!_skipNextAdvance) {
         // Nothing after the next line can throw WCEs.
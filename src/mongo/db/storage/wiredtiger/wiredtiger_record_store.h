@@ -269,7 +269,7 @@ public:
 
     bool haveCappedWaiters();
 
-    void notifyCappedWaitersIfNeeded();
+    void notifyCappedWaitersIfNeeded(boost::optional<Timestamp> commitTs = boost::none);
 
     class OplogStones;
 
@@ -428,6 +428,8 @@ public:
 
     boost::optional<Record> next();
 
+    size_t nextBatch(size_t maxBatch, std::vector<Record>* out) override;
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     void save();
@@ -469,6 +471,12 @@ protected:
 
 private:
     bool isVisible(const RecordId& id);
+
+    /**
+     * Advances the already-entered cursor 'c' one record and returns it, or boost::none on EOF.
+     * Shared by next() and nextBatch().
+     */
+    boost::optional<Record> _advance(WT_CURSOR* c);
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
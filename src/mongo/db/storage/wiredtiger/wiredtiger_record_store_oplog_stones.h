@@ -58,13 +58,7 @@ public:
     void kill();
 
     bool hasExcessStones_inlock() const {
-        int64_t total_bytes = 0;
-        for (std::deque<OplogStones::Stone>::const_iterator it = _stones.begin();
-             it != _stones.end();
-             ++it) {
-            total_bytes += it->bytes;
-        }
-        return total_bytes > _rs->cappedMaxSize();
+        return _totalBytesInStones > _rs->cappedMaxSize();
     }
 
     void awaitHasExcessStonesOrDead();
@@ -73,7 +67,10 @@ public:
 
     void popOldestStone();
 
-    void createNewStoneIfNeeded(RecordId lastRecord);
+    // Cuts a new stone from the records and bytes accumulated by committed inserts, if they have
+    // reached '_minBytesPerStone'. Inserts themselves only bump atomic counters and nudge the
+    // oplog reclaim thread, which calls this; tests call it directly in place of that thread.
+    void cutNewStoneIfNeeded();
 
     void updateCurrentStoneAfterInsertOnCommit(OperationContext* opCtx,
                                                int64_t bytesInserted,
@@ -143,8 +140,16 @@ private:
     AtomicInt64 _currentRecords;  // Number of records in the stone being filled.
     AtomicInt64 _currentBytes;    // Number of bytes in the stone being filled.
 
+    // RecordId::repr() of the highest record seen by a committed insert. Maintained with a CAS
+    // loop on the insert path and used as the boundary when the next stone is cut.
+    AtomicInt64 _highestSeenRecord;
+
     mutable stdx::mutex _mutex;  // Protects against concurrent access to the deque of oplog stones.
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
+
+    // Running total of Stone::bytes over '_stones', so that checking for excess stones doesn't
+    // require scanning the deque. Protected by '_mutex'.
+    int64_t _totalBytesInStones = 0;
 };
 
 }  // namespace mongo
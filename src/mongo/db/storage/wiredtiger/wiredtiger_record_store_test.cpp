@@ -430,6 +430,11 @@ StatusWith<RecordId> insertBSONWithSize(OperationContext* opCtx,
     StatusWith<RecordId> res = rs->insertRecord(opCtx, obj.objdata(), obj.objsize(), opTime);
     if (res.isOK()) {
         wuow.commit();
+        // The oplog reclaim thread isn't running in this harness, so cut stones inline the way
+        // it would after being nudged by the committed insert.
+        if (auto oplogStones = wtrs->oplogStones()) {
+            oplogStones->cutNewStoneIfNeeded();
+        }
     }
     return res;
 }
@@ -74,6 +74,7 @@ WiredTigerRecoveryUnit::WiredTigerRecoveryUnit(WiredTigerSessionCache* sc,
 
 WiredTigerRecoveryUnit::~WiredTigerRecoveryUnit() {
     invariant(!_inUnitOfWork);
+    _flushStashedCursors();
     _abort();
 }
 
@@ -229,6 +230,13 @@ void WiredTigerRecoveryUnit::abandonSnapshot() {
         _txnClose(false);
     }
     _areWriteUnitOfWorksBanned = false;
+
+    // If a drop has been queued since the cursors were stashed, hand them back to the session so
+    // that the usual queued-drop handling closes them. Keeping them pinned across an idle period
+    // could otherwise block the drop indefinitely.
+    if (!_stashedCursors.empty() && _sessionCache->getCursorEpoch() != _stashedCursorEpoch) {
+        _flushStashedCursors();
+    }
 }
 
 void WiredTigerRecoveryUnit::preallocateSnapshot() {
@@ -544,10 +552,52 @@ RecoveryUnit::ReadSource WiredTigerRecoveryUnit::getTimestampReadSource() const
 void WiredTigerRecoveryUnit::beginIdle() {
     // Close all cursors, we don't want to keep any old cached cursors around.
     if (_session) {
+        _flushStashedCursors();
         _session->closeAllCursors("");
     }
 }
 
+WT_CURSOR* WiredTigerRecoveryUnit::getStashedCursor(uint64_t tableID) {
+    for (std::vector<StashedCursor>::iterator i = _stashedCursors.begin();
+         i != _stashedCursors.end();
+         ++i) {
+        if (i->id == tableID) {
+            WT_CURSOR* cursor = i->cursor;
+            _stashedCursors.erase(i);
+            return cursor;
+        }
+    }
+    return nullptr;
+}
+
+void WiredTigerRecoveryUnit::stashCursor(uint64_t tableID, WT_CURSOR* cursor) {
+    invariant(_session);
+
+    // A setting of zero disables all cursor caching above the storage engine so that exclusive
+    // operations are not blocked by inactive cursors; respect that here as well.
+    if (kWiredTigerCursorCacheSize.load() == 0 || _stashedCursors.size() >= kMaxStashedCursors) {
+        _session->releaseCursor(tableID, cursor);
+        return;
+    }
+
+    invariantWTOK(cursor->reset(cursor));
+    StashedCursor stashed = {tableID, cursor};
+    _stashedCursors.push_back(stashed);
+    _stashedCursorEpoch = _sessionCache->getCursorEpoch();
+}
+
+void WiredTigerRecoveryUnit::_flushStashedCursors() {
+    if (_stashedCursors.empty()) {
+        return;
+    }
+
+    invariant(_session);
+    for (size_t i = 0; i < _stashedCursors.size(); i++) {
+        _session->releaseCursor(_stashedCursors[i].id, _stashedCursors[i].cursor);
+    }
+    _stashedCursors.clear();
+}
+
 // ---------------------
 
 WiredTigerCursor::WiredTigerCursor(const std::string& uri,
@@ -557,11 +607,17 @@ WiredTigerCursor::WiredTigerCursor(const std::string& uri,
     _tableID = tableId;
     _ru = WiredTigerRecoveryUnit::get(opCtx);
     _session = _ru->getSession();
-    _cursor = _session->getCursor(uri, tableId, forRecordStore);
+
+    // Prefer a cursor pinned to the recovery unit by a previous WiredTigerCursor on the same
+    // table; it is guaranteed to have come from this session.
+    _cursor = _ru->getStashedCursor(tableId);
+    if (!_cursor) {
+        _cursor = _session->getCursor(uri, tableId, forRecordStore);
+    }
 }
 
 WiredTigerCursor::~WiredTigerCursor() {
-    _session->releaseCursor(_tableID, _cursor);
+    _ru->stashCursor(_tableID, _cursor);
     _cursor = NULL;
 }
 
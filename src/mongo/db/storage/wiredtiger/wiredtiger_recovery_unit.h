@@ -129,6 +129,20 @@ public:
     WiredTigerSessionCache* getSessionCache() {
         return _sessionCache;
     }
+
+    /**
+     * Returns a cursor for 'tableID' that a destroyed WiredTigerCursor left pinned to this
+     * recovery unit, or nullptr if there is none. The caller takes ownership of the cursor.
+     */
+    WT_CURSOR* getStashedCursor(uint64_t tableID);
+
+    /**
+     * Keeps 'cursor' pinned to this recovery unit so that the next WiredTigerCursor opened on
+     * 'tableID' reuses it without going back through the session's cursor cache. The cursor is
+     * released to the session instead when the stash is full or cursor caching is disabled.
+     */
+    void stashCursor(uint64_t tableID, WT_CURSOR* cursor);
+
     bool inActiveTxn() const {
         return _active;
     }
@@ -148,6 +162,11 @@ private:
     void _txnClose(bool commit);
     void _txnOpen();
 
+    /**
+     * Releases all stashed cursors back to the session's cursor cache.
+     */
+    void _flushStashedCursors();
+
     /**
      * Starts a transaction at the current all-committed timestamp.
      * Returns the timestamp the transaction was started at.
@@ -183,6 +202,22 @@ private:
     bool _isOplogReader = false;
     typedef std::vector<std::unique_ptr<Change>> Changes;
     Changes _changes;
+
+    // Cursors pinned to this recovery unit by destroyed WiredTigerCursors, so that getMore-heavy
+    // plans reacquire the same cursors across WriteUnitOfWork boundaries and yield/restore cycles
+    // without going through the session's cursor cache. The cursors are counted as "out" of
+    // '_session' and must be given back before the session is released.
+    struct StashedCursor {
+        uint64_t id;
+        WT_CURSOR* cursor;
+    };
+    static const size_t kMaxStashedCursors = 8;
+    std::vector<StashedCursor> _stashedCursors;
+
+    // The session cache's cursor epoch as of the last stashCursor() call. When the epoch moves on
+    // (a table drop has been queued), the stash is handed back to the session so that the usual
+    // queued-drop handling applies to it.
+    uint64_t _stashedCursorEpoch = 0;
 };
 
 /**
@@ -168,6 +168,34 @@ TEST_F(WiredTigerRecoveryUnitTestFixture, SetReadSource) {
     ASSERT_EQ(Timestamp(1, 1), ru1->getPointInTimeReadTimestamp());
 }
 
+TEST_F(WiredTigerRecoveryUnitTestFixture, CursorsAreStashedOnTheRecoveryUnitForReuse) {
+    auto opCtx = clientAndCtx1.second.get();
+    const std::string uri = "table:stash_test";
+    WT_SESSION* s = ru1->getSession()->getSession();
+    invariantWTOK(s->create(s, uri.c_str(), "key_format=q,value_format=u"));
+    const uint64_t tableId = WiredTigerSession::genTableId();
+
+    WT_CURSOR* raw;
+    {
+        WiredTigerCursor cursor(uri, tableId, true, opCtx);
+        raw = cursor.get();
+    }
+
+    // The destroyed cursor stays pinned to the recovery unit instead of returning to the
+    // session's cursor cache, so the session hands out a different cursor for the same table.
+    WT_CURSOR* other = ru1->getSession()->getCursor(uri, tableId, true);
+    ASSERT_NE(raw, other);
+    ru1->getSession()->releaseCursor(tableId, other);
+
+    // The stashed cursor survives the transaction boundary and is reused in preference to the
+    // session's cursor cache.
+    ru1->abandonSnapshot();
+    {
+        WiredTigerCursor cursor(uri, tableId, true, opCtx);
+        ASSERT_EQ(raw, cursor.get());
+    }
+}
+
 TEST_F(WiredTigerRecoveryUnitTestFixture, CreateAndCheckForCachePressure) {
     int time = 1;
 
@@ -54,6 +54,13 @@ bool WiredTigerServerStatusSection::includeByDefault() const {
     return true;
 }
 
+Milliseconds WiredTigerServerStatusSection::cacheFreshnessWindow() const {
+    // Walking the statistics cursors takes milliseconds, and several monitoring systems
+    // commonly poll serverStatus at around 1Hz; half a second of staleness is invisible to
+    // them but collapses their polls into one generation.
+    return Milliseconds(500);
+}
+
 BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                                                        const BSONElement& configElement) const {
     Lock::GlobalLock lk(opCtx, LockMode::MODE_IS);
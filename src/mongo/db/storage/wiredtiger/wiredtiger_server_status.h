@@ -43,6 +43,7 @@ class WiredTigerServerStatusSection : public ServerStatusSection {
 public:
     WiredTigerServerStatusSection(WiredTigerKVEngine* engine);
     virtual bool includeByDefault() const;
+    virtual Milliseconds cacheFreshnessWindow() const;
     virtual BSONObj generateSection(OperationContext* opCtx,
                                     const BSONElement& configElement) const;
 
@@ -35,6 +35,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <functional>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -77,6 +79,12 @@ namespace mongo {
 // is a good compromise for most workloads.
 AtomicInt32 kWiredTigerCursorCacheSize(-100);
 
+// Maximum time in microseconds that a journal flush in waitUntilDurable may be held back
+// so that concurrent writers requesting durability can share it. The delay is adaptive:
+// it is applied only when the previous flush absorbed concurrent waiters, so an isolated
+// j:true write still syncs immediately. Set to 0 to disable group commit batching.
+AtomicInt32 kWiredTigerGroupCommitWindowMicros(1000);
+
 const std::string kWTRepairMsg =
     "Please read the documentation for starting MongoDB with --repair here: "
     "http://dochub.mongodb.org/core/repair";
@@ -86,6 +94,11 @@ ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
                                      "wiredTigerCursorCacheSize",
                                      &kWiredTigerCursorCacheSize);
 
+ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
+    WiredTigerGroupCommitWindowMicrosSetting(ServerParameterSet::getGlobal(),
+                                             "wiredTigerGroupCommitWindowMicros",
+                                             &kWiredTigerGroupCommitWindowMicros);
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch), _cursorEpoch(cursorEpoch), _session(NULL), _cursorGen(0), _cursorsOut(0) {
     invariantWTOK(conn->open_session(conn, NULL, "isolation=snapshot", &_session));
@@ -269,16 +282,28 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
+    _durabilityWaiters.fetchAndAdd(1);
     stdx::unique_lock<stdx::mutex> lk(_lastSyncMutex);
+    _durabilityWaiters.fetchAndSubtract(1);
     uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
     if (current != start) {
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
-    _lastSyncTime.store(current + 1);
 
     // Nobody has synched yet, so we have to sync ourselves.
 
+    // Group commit: when the previous sync was contended, hold this one back briefly so
+    // that writers requesting durability in the meantime share it instead of queueing a
+    // sync of their own. Threads arriving during the window read _lastSyncTime before it
+    // is bumped below and are therefore absorbed by this sync.
+    const int32_t windowMicros = kWiredTigerGroupCommitWindowMicros.load();
+    if (windowMicros > 0 && _lastSyncWasContended) {
+        sleepmicros(windowMicros);
+    }
+    _lastSyncWasContended = _durabilityWaiters.load() > 0;
+    _lastSyncTime.store(current + 1);
+
     // This gets the token (OpTime) from the last write, before flushing (either the journal, or a
     // checkpoint), and then reports that token (OpTime) as a durable write.
     stdx::unique_lock<stdx::mutex> jlk(_journalListenerMutex);
@@ -320,10 +345,18 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
+WiredTigerSessionCache::SessionCachePartition& WiredTigerSessionCache::_homePartition() {
+    const thread_local size_t partition =
+        std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % kSessionCachePartitions;
+    return _partitions[partition];
+}
+
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -331,20 +364,26 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. The epoch is
+    // bumped before sweeping the partitions so that a concurrent release of an old-epoch
+    // session cannot slip into a partition behind the sweep: releaseSession() rechecks the
+    // epoch under the partition lock.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -361,13 +400,28 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    SessionCachePartition& home = _homePartition();
     {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+        stdx::lock_guard<stdx::mutex> lock(home.lock);
+        if (!home.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = home.sessions.back();
+            home.sessions.pop_back();
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+
+    // The home partition is empty; steal from another partition before paying to open a new
+    // WT_SESSION.
+    for (auto& partition : _partitions) {
+        if (&partition == &home) {
+            continue;
+        }
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        if (!partition.sessions.empty()) {
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -426,10 +480,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->dropQueuedIdentsAtSessionEndAllowed(true);
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        SessionCachePartition& home = _homePartition();
+        stdx::lock_guard<stdx::mutex> lock(home.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            home.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -33,6 +33,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -263,9 +264,25 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // The released-session freelist is striped into independently locked partitions so that
+    // threads starting and finishing operations concurrently do not all serialize on one
+    // mutex. Each thread hashes to a home partition; getSession() falls back to stealing
+    // from the other partitions, and then to opening a new WT_SESSION, when its home
+    // partition is empty.
+    struct SessionCachePartition {
+        stdx::mutex lock;
+        SessionCache sessions;
+    };
+    static const size_t kSessionCachePartitions = 8;
+
+    /**
+     * Returns the calling thread's home partition.
+     */
+    SessionCachePartition& _homePartition();
+
+    SessionCachePartition _partitions[kSessionCachePartitions];
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -277,6 +294,14 @@ private:
     AtomicUInt32 _lastSyncTime;
     stdx::mutex _lastSyncMutex;
 
+    // Number of threads blocked in waitUntilDurable waiting to acquire _lastSyncMutex.
+    AtomicUInt32 _durabilityWaiters;
+
+    // True if the last journal flush absorbed concurrent waiters, indicating that holding
+    // the next flush back briefly is likely to let more writers share it. Guarded by
+    // _lastSyncMutex.
+    bool _lastSyncWasContended = false;
+
     // Mutex and cond var for waiting on prepare commit or abort.
     stdx::mutex _prepareCommittedOrAbortedMutex;
     stdx::condition_variable _prepareCommittedOrAbortedCond;
@@ -305,4 +330,8 @@ typedef std::unique_ptr<WiredTigerSession,
     UniqueWiredTigerSession;
 
 extern const std::string kWTRepairMsg;
+
+// See the comment above the definition in wiredtiger_session_cache.cpp for the meaning of this
+// setting.
+extern AtomicInt32 kWiredTigerCursorCacheSize;
 }  // namespace
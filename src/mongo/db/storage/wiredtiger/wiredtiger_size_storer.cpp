@@ -35,6 +35,7 @@
 
 #include <wiredtiger.h>
 
+#include "mongo/base/simple_string_data_comparator.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/service_context.h"
@@ -70,14 +71,20 @@ WiredTigerSizeStorer::~WiredTigerSizeStorer() {
     _cursor->close(_cursor);
 }
 
+WiredTigerSizeStorer::BufferPartition& WiredTigerSizeStorer::_bufferPartition(
+    StringData uri) const {
+    return _bufferPartitions[SimpleStringDataComparator::kInstance.hash(uri) % kBufferPartitions];
+}
+
 void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeInfo) {
     // If the SizeInfo is still dirty, we're done.
     if (sizeInfo->_dirty.load() || _readOnly)
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<stdx::mutex> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    BufferPartition& partition = _bufferPartition(uri);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    auto& entry = partition.buffer[uri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -92,9 +99,10 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<stdx::mutex> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        BufferPartition& partition = _bufferPartition(uri);
+        stdx::lock_guard<stdx::mutex> bufferLock(partition.mutex);
+        Buffer::const_iterator it = partition.buffer.find(uri);
+        if (it != partition.buffer.end())
             return it->second;
     }
 
@@ -126,9 +134,15 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
     Buffer buffer;
-    {
-        stdx::lock_guard<stdx::mutex> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    for (auto& partition : _bufferPartitions) {
+        stdx::lock_guard<stdx::mutex> bufferLock(partition.mutex);
+        if (buffer.empty()) {
+            partition.buffer.swap(buffer);
+        } else {
+            for (auto& entry : partition.buffer)
+                buffer[entry.first] = std::move(entry.second);
+            partition.buffer.clear();
+        }
     }
 
     if (buffer.empty())
@@ -137,13 +151,14 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
     Timer t;
     stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
     {
-        // On failure, place entries back into the map, unless a newer value already exists.
+        // On failure, place entries back into their partitions, unless a newer value already
+        // exists.
         ON_BLOCK_EXIT([this, &buffer]() {
             this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<stdx::mutex> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
+            for (auto& it : buffer) {
+                BufferPartition& partition = this->_bufferPartition(it.first);
+                stdx::lock_guard<stdx::mutex> bufferLock(partition.mutex);
+                partition.buffer.try_emplace(it.first, it.second);
             }
         });
 
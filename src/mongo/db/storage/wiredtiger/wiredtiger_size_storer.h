@@ -96,13 +96,26 @@ public:
 private:
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any buffer partition mutex.
     mutable stdx::mutex _cursorMutex;
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
     using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
 
-    mutable stdx::mutex _bufferMutex;  // Guards _buffer
-    Buffer _buffer;
+    // The buffer of dirty entries is striped into independently locked partitions, selected
+    // by URI hash, so that concurrent size updates for different collections do not
+    // serialize on a single mutex. flush() drains every partition into one transaction.
+    struct BufferPartition {
+        mutable stdx::mutex mutex;  // Guards 'buffer'.
+        Buffer buffer;
+    };
+    static const size_t kBufferPartitions = 16;
+
+    /**
+     * Returns the partition responsible for 'uri'.
+     */
+    BufferPartition& _bufferPartition(StringData uri) const;
+
+    mutable BufferPartition _bufferPartitions[kBufferPartitions];
 };
 }
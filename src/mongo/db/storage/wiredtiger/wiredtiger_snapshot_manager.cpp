@@ -69,32 +69,44 @@ boost::optional<Timestamp> WiredTigerSnapshotManager::getMinSnapshotForNextCommi
 
 Timestamp WiredTigerSnapshotManager::beginTransactionOnCommittedSnapshot(
     WT_SESSION* session, WiredTigerBeginTxnBlock::IgnorePrepared ignorePrepared) const {
-    WiredTigerBeginTxnBlock txnOpen(session, ignorePrepared);
-
-    stdx::lock_guard<stdx::mutex> lock(_committedSnapshotMutex);
-    uassert(ErrorCodes::ReadConcernMajorityNotAvailableYet,
-            "Committed view disappeared while running operation",
-            _committedSnapshot);
+    // Only hold the mutex while copying the timestamp out. Starting the WiredTiger transaction
+    // with the mutex held would serialize every majority read through it; the copied timestamp
+    // stays a valid read timestamp regardless of what the committed snapshot does afterwards,
+    // since timestamped reads are bounded by the oldest timestamp, not by this bookkeeping.
+    Timestamp committedSnapshot;
+    {
+        stdx::lock_guard<stdx::mutex> lock(_committedSnapshotMutex);
+        uassert(ErrorCodes::ReadConcernMajorityNotAvailableYet,
+                "Committed view disappeared while running operation",
+                _committedSnapshot);
+        committedSnapshot = *_committedSnapshot;
+    }
 
-    auto status = txnOpen.setTimestamp(_committedSnapshot.get());
+    WiredTigerBeginTxnBlock txnOpen(session, ignorePrepared);
+    auto status = txnOpen.setTimestamp(committedSnapshot);
     fassert(30635, status);
 
     txnOpen.done();
-    return *_committedSnapshot;
+    return committedSnapshot;
 }
 
 Timestamp WiredTigerSnapshotManager::beginTransactionOnLocalSnapshot(
     WT_SESSION* session, WiredTigerBeginTxnBlock::IgnorePrepared ignorePrepared) const {
+    // As above, copy the timestamp out rather than starting the transaction under the mutex.
+    Timestamp localSnapshot;
+    {
+        stdx::lock_guard<stdx::mutex> lock(_localSnapshotMutex);
+        invariant(_localSnapshot);
+        localSnapshot = *_localSnapshot;
+    }
+
+    LOG(3) << "begin_transaction on local snapshot " << localSnapshot.toString();
     WiredTigerBeginTxnBlock txnOpen(session, ignorePrepared);
-
-    stdx::lock_guard<stdx::mutex> lock(_localSnapshotMutex);
-    invariant(_localSnapshot);
-    LOG(3) << "begin_transaction on local snapshot " << _localSnapshot.get().toString();
-    auto status = txnOpen.setTimestamp(_localSnapshot.get());
+    auto status = txnOpen.setTimestamp(localSnapshot);
     fassert(50775, status);
 
     txnOpen.done();
-    return *_localSnapshot;
+    return localSnapshot;
 }
 
 }  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_builder.h"
+
+#include "mongo/bson/oid.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+constexpr std::size_t BucketBuilder::kDefaultMaxCount;
+
+BucketBuilder::BucketBuilder(std::string timeField,
+                             boost::optional<std::string> metaField,
+                             std::size_t maxCount)
+    : _timeField(std::move(timeField)), _metaField(std::move(metaField)), _maxCount(maxCount) {
+    invariant(_maxCount > 0);
+}
+
+bool BucketBuilder::add(const BSONObj& measurement) {
+    const auto timeElem = measurement[_timeField];
+    uassert(50912,
+            str::stream() << "measurement is missing the time field '" << _timeField << "': "
+                          << measurement,
+            !timeElem.eoo());
+
+    if (_count >= _maxCount) {
+        return false;
+    }
+
+    if (_metaField) {
+        const auto metaElem = measurement[*_metaField];
+        auto meta = metaElem.eoo() ? BSONObj() : metaElem.wrap("meta");
+        if (_count == 0) {
+            _meta = std::move(meta);
+        } else if (!_meta.binaryEqual(meta)) {
+            return false;
+        }
+    }
+
+    const auto key = std::to_string(_count);
+    for (auto&& elem : measurement) {
+        if (_metaField && elem.fieldNameStringData() == *_metaField) {
+            continue;
+        }
+
+        auto& column = _columns[elem.fieldNameStringData()];
+        if (!column) {
+            column = stdx::make_unique<BSONObjBuilder>();
+            _fieldOrder.push_back(elem.fieldName());
+        }
+        column->appendAs(elem, key);
+    }
+
+    if (_count == 0 || timeElem.woCompare(_minTime.firstElement(), false) < 0) {
+        _minTime = timeElem.wrap();
+    }
+    if (_count == 0 || timeElem.woCompare(_maxTime.firstElement(), false) > 0) {
+        _maxTime = timeElem.wrap();
+    }
+
+    ++_count;
+    return true;
+}
+
+BSONObj BucketBuilder::done() {
+    invariant(_count > 0);
+
+    BSONObjBuilder bucket;
+    bucket.append("_id", OID::gen());
+    if (_metaField && !_meta.isEmpty()) {
+        bucket.appendAs(_meta.firstElement(), "meta");
+    }
+
+    {
+        BSONObjBuilder control(bucket.subobjStart("control"));
+        control.append("version", 1);
+        control.appendNumber("count", static_cast<long long>(_count));
+        {
+            BSONObjBuilder min(control.subobjStart("min"));
+            min.appendAs(_minTime.firstElement(), _timeField);
+        }
+        {
+            BSONObjBuilder max(control.subobjStart("max"));
+            max.appendAs(_maxTime.firstElement(), _timeField);
+        }
+    }
+
+    {
+        BSONObjBuilder data(bucket.subobjStart("data"));
+        for (const auto& field : _fieldOrder) {
+            data.append(field, _columns[field]->obj());
+        }
+    }
+
+    _count = 0;
+    _meta = BSONObj();
+    _minTime = BSONObj();
+    _maxTime = BSONObj();
+    _columns.clear();
+    _fieldOrder.clear();
+
+    return bucket.obj();
+}
+
+}  // namespace mongo
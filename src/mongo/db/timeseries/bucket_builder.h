@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Folds a sequence of measurement documents which share a meta value into a single bucket
+ * document, the storage unit for bucketed (time-series style) collections:
+ *
+ *     {
+ *         _id: <ObjectId>,
+ *         meta: <common meta value>,
+ *         control: {version: 1, count: N, min: {<timeField>: ...}, max: {<timeField>: ...}},
+ *         data: {
+ *             <timeField>: {"0": <t0>, "1": <t1>, ...},
+ *             <field>:     {"0": <v0>, ...}
+ *         }
+ *     }
+ *
+ * Each field of the measurements becomes one column object in 'data', keyed by the decimal
+ * measurement index; a missing index in a column means the corresponding measurement did not have
+ * that field. Storing many measurements per document amortizes the per-document overhead
+ * (RecordId, index entries, oplog entry) across the whole bucket, and because the index keys are
+ * monotonically increasing, appending a measurement is a pure suffix write to every column, which
+ * an ingest path can apply with RecordStore::updateWithDamages instead of rewriting the bucket.
+ *
+ * Buckets produced here can be turned back into measurement documents with the $unpackBucket
+ * aggregation stage.
+ *
+ * This class is not thread-safe.
+ */
+class BucketBuilder {
+public:
+    static constexpr std::size_t kDefaultMaxCount = 1000;
+
+    /**
+     * 'timeField' is the name of the field which every measurement must carry. If 'metaField' is
+     * provided, its value is hoisted out of the measurements into the bucket-level 'meta' field
+     * and only byte-identical meta values are accepted into the same bucket.
+     */
+    BucketBuilder(std::string timeField,
+                  boost::optional<std::string> metaField,
+                  std::size_t maxCount = kDefaultMaxCount);
+
+    /**
+     * Attempts to fold 'measurement' into the bucket. Returns false without modifying the bucket
+     * if it is full, or if the measurement's meta value differs from the one already in the
+     * bucket, in which case the caller should finish this bucket and start a new one. Throws if
+     * the measurement is missing the time field.
+     */
+    bool add(const BSONObj& measurement);
+
+    std::size_t count() const {
+        return _count;
+    }
+
+    bool empty() const {
+        return _count == 0;
+    }
+
+    /**
+     * Renders the bucket document and resets the builder so it can accept a new bucket's worth of
+     * measurements. Must not be called on an empty builder.
+     */
+    BSONObj done();
+
+private:
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+    const std::size_t _maxCount;
+
+    std::size_t _count = 0;
+
+    // The bucket's meta value, wrapped as {"meta": <value>}. Empty when no measurement with a
+    // meta value has been added yet.
+    BSONObj _meta;
+
+    // Least and greatest time values seen so far, each wrapped as a single-element object.
+    BSONObj _minTime;
+    BSONObj _maxTime;
+
+    // One in-progress column object per measurement field, plus the field order in which the
+    // columns were first seen, so that the rendered bucket is deterministic.
+    StringMap<std::unique_ptr<BSONObjBuilder>> _columns;
+    std::vector<std::string> _fieldOrder;
+};
+
+}  // namespace mongo
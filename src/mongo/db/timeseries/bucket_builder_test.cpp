@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_builder.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(BucketBuilder, FoldsMeasurementsIntoColumns) {
+    BucketBuilder builder("t", std::string("m"));
+
+    ASSERT_TRUE(builder.add(fromjson("{t: 1, m: 'sensorA', v: 10}")));
+    ASSERT_TRUE(builder.add(fromjson("{t: 2, m: 'sensorA', v: 20}")));
+    ASSERT_EQ(2U, builder.count());
+
+    const auto bucket = builder.done();
+    ASSERT_BSONOBJ_EQ(fromjson("{t: {'0': 1, '1': 2}, v: {'0': 10, '1': 20}}"),
+                      bucket["data"].Obj());
+    ASSERT_EQ("sensorA", bucket["meta"].String());
+    ASSERT_EQ(2, bucket["control"]["count"].numberInt());
+    ASSERT_EQ(1, bucket["control"]["min"]["t"].numberInt());
+    ASSERT_EQ(2, bucket["control"]["max"]["t"].numberInt());
+
+    // The builder is reusable after done().
+    ASSERT_TRUE(builder.empty());
+}
+
+TEST(BucketBuilder, ColumnsAreSparseForMissingFields) {
+    BucketBuilder builder("t", boost::none);
+
+    ASSERT_TRUE(builder.add(fromjson("{t: 1, v: 10, w: 100}")));
+    ASSERT_TRUE(builder.add(fromjson("{t: 2, v: 20}")));
+
+    const auto bucket = builder.done();
+    ASSERT_BSONOBJ_EQ(fromjson("{t: {'0': 1, '1': 2}, v: {'0': 10, '1': 20}, w: {'0': 100}}"),
+                      bucket["data"].Obj());
+    ASSERT_TRUE(bucket["meta"].eoo());
+}
+
+TEST(BucketBuilder, RejectsDifferentMetaValue) {
+    BucketBuilder builder("t", std::string("m"));
+
+    ASSERT_TRUE(builder.add(fromjson("{t: 1, m: 'sensorA', v: 10}")));
+    ASSERT_FALSE(builder.add(fromjson("{t: 2, m: 'sensorB', v: 20}")));
+    ASSERT_EQ(1U, builder.count());
+}
+
+TEST(BucketBuilder, RejectsMeasurementsBeyondMaxCount) {
+    BucketBuilder builder("t", boost::none, 2);
+
+    ASSERT_TRUE(builder.add(fromjson("{t: 1}")));
+    ASSERT_TRUE(builder.add(fromjson("{t: 2}")));
+    ASSERT_FALSE(builder.add(fromjson("{t: 3}")));
+    ASSERT_EQ(2U, builder.count());
+}
+
+TEST(BucketBuilder, ThrowsOnMissingTimeField) {
+    BucketBuilder builder("t", boost::none);
+
+    ASSERT_THROWS_CODE(builder.add(fromjson("{v: 10}")), AssertionException, 50912);
+}
+
+TEST(BucketBuilder, TracksMinAndMaxOfUnorderedTimes) {
+    BucketBuilder builder("t", boost::none);
+
+    ASSERT_TRUE(builder.add(fromjson("{t: 5}")));
+    ASSERT_TRUE(builder.add(fromjson("{t: 1}")));
+    ASSERT_TRUE(builder.add(fromjson("{t: 3}")));
+
+    const auto bucket = builder.done();
+    ASSERT_EQ(1, bucket["control"]["min"]["t"].numberInt());
+    ASSERT_EQ(5, bucket["control"]["max"]["t"].numberInt());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -118,6 +118,11 @@ const StringMap<int> txnAdminCommands = {{"abortTransaction", 1},
 const StringMap<int> preparedTxnCmdWhitelist = {
     {"abortTransaction", 1}, {"commitTransaction", 1}, {"prepareTransaction", 1}};
 
+// Most transactions are made up of only a few statements, so the operations vector is reserved
+// up front to avoid growth reallocations while statements are collected. The vector's buffer is
+// surrendered to the op observer at commit, so the reservation is repeated per transaction.
+const size_t kTransactionOperationsInitialCapacity = 4;
+
 }  // unnamed namespace
 
 TransactionParticipant* TransactionParticipant::get(OperationContext* opCtx) {
@@ -198,6 +203,7 @@ void TransactionParticipant::_beginMultiDocumentTransaction(WithLock wl, TxnNumb
             *_transactionExpireDate);
     }
     invariant(_transactionOperations.empty());
+    _transactionOperations.reserve(kTransactionOperationsInitialCapacity);
 }
 
 void TransactionParticipant::beginOrContinue(TxnNumber txnNumber,
@@ -953,7 +959,8 @@ void TransactionParticipant::_abortTransactionOnSession(WithLock wl) {
                 &Top::get(getGlobalServiceContext()));
         }
         _logSlowTransaction(wl,
-                            &(_txnResourceStash->locker()->getLockerInfo(boost::none))->stats,
+                            _txnResourceStash->locker(),
+                            boost::none,
                             TransactionState::kAborted,
                             _txnResourceStash->getReadConcernArgs());
         _txnResourceStash = boost::none;
@@ -979,11 +986,11 @@ void TransactionParticipant::_abortTransactionOnSession(WithLock wl) {
 void TransactionParticipant::_cleanUpTxnResourceOnOpCtx(
     WithLock wl, OperationContext* opCtx, TransactionState::StateFlag terminationCause) {
     // Log the transaction if its duration is longer than the slowMS command threshold.
-    _logSlowTransaction(
-        wl,
-        &(opCtx->lockState()->getLockerInfo(CurOp::get(*opCtx)->getLockStatsBase()))->stats,
-        terminationCause,
-        repl::ReadConcernArgs::get(opCtx));
+    _logSlowTransaction(wl,
+                        opCtx->lockState(),
+                        CurOp::get(*opCtx)->getLockStatsBase(),
+                        terminationCause,
+                        repl::ReadConcernArgs::get(opCtx));
 
     // Reset the WUOW. We should be able to abort empty transactions that don't have WUOW.
     if (opCtx->getWriteUnitOfWork()) {
@@ -1306,7 +1313,8 @@ std::string TransactionParticipant::_transactionInfoForLog(
 }
 
 void TransactionParticipant::_logSlowTransaction(WithLock wl,
-                                                 const SingleThreadedLockStats* lockStats,
+                                                 const Locker* locker,
+                                                 boost::optional<SingleThreadedLockStats> lockStatsBase,
                                                  TransactionState::StateFlag terminationCause,
                                                  repl::ReadConcernArgs readConcernArgs) {
     // Only log multi-document transactions.
@@ -1314,9 +1322,13 @@ void TransactionParticipant::_logSlowTransaction(WithLock wl,
         // Log the transaction if its duration is longer than the slowMS command threshold.
         if (_transactionMetricsObserver.getSingleTransactionStats().getDuration(curTimeMicros64()) >
             serverGlobalParams.slowMS * 1000ULL) {
+            // Gathering the LockerInfo copies the list of held locks and the lock statistics,
+            // so it is only done once the transaction is known to be logged.
+            const auto lockerInfo = locker->getLockerInfo(lockStatsBase);
+            invariant(lockerInfo);
             log(logger::LogComponent::kTransaction)
                 << "transaction "
-                << _transactionInfoForLog(lockStats, terminationCause, readConcernArgs);
+                << _transactionInfoForLog(&lockerInfo->stats, terminationCause, readConcernArgs);
         }
     }
 }
@@ -527,9 +527,12 @@ private:
                                           const std::string& cmdName);
 
     // Logs the transaction information if it has run slower than the global parameter slowMS. The
-    // transaction must be committed or aborted when this function is called.
+    // transaction must be committed or aborted when this function is called. The locker's full
+    // LockerInfo is only materialized for transactions that are actually logged, since gathering
+    // it allocates and the vast majority of transactions complete under the threshold.
     void _logSlowTransaction(WithLock wl,
-                             const SingleThreadedLockStats* lockStats,
+                             const Locker* locker,
+                             boost::optional<SingleThreadedLockStats> lockStatsBase,
                              TransactionState::StateFlag terminationCause,
                              repl::ReadConcernArgs readConcernArgs);
 
@@ -55,6 +55,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/ttl_collection_cache.h"
+#include "mongo/platform/random.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/exit.h"
@@ -77,6 +78,19 @@ MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60)
         return Status::OK();
     });  // used for testing
 
+// If positive and this node is a primary in a replica set, a TTL pass is cut short as soon as
+// the majority-committed optime trails this node's last applied optime by more than this many
+// seconds. The remaining expired documents are picked up by a later pass once the secondaries
+// have caught up, instead of the monitor piling more deletes onto an already lagging set. A
+// value of zero disables the check.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorMaxReplicationLagSecs, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0)
+            return Status(ErrorCodes::BadValue,
+                          "ttlMonitorMaxReplicationLagSecs must be non-negative");
+        return Status::OK();
+    });
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -93,10 +107,16 @@ public:
         ON_BLOCK_EXIT([] { Client::destroy(); });
         AuthorizationSession::get(cc())->grantInternalAuthorization();
 
+        // Jitter each sleep by up to 10% of the configured period, so that the TTL passes of
+        // the members of a replica set (which all start their monitors at roughly the same
+        // time) spread out instead of waking in lockstep.
+        PseudoRandom random(std::unique_ptr<SecureRandom>(SecureRandom::create())->nextInt64());
+
         while (!globalInShutdownDeprecated()) {
             {
                 MONGO_IDLE_THREAD_BLOCK;
-                sleepsecs(ttlMonitorSleepSecs.load());
+                const int64_t sleepMillis = ttlMonitorSleepSecs.load() * 1000LL;
+                sleepmillis(sleepMillis + random.nextInt64(sleepMillis / 10 + 1));
             }
 
             LOG(3) << "thread awake";
@@ -161,6 +181,11 @@ private:
         }
 
         for (const BSONObj& idx : ttlIndexes) {
+            if (replicationLagExceedsLimit(&opCtx)) {
+                LOG(1) << "TTL pass ending early; replication lag exceeds "
+                       << ttlMonitorMaxReplicationLagSecs.load() << " seconds";
+                break;
+            }
             try {
                 doTTLForIndex(&opCtx, idx);
             } catch (const DBException& dbex) {
@@ -171,6 +196,26 @@ private:
         }
     }
 
+    /**
+     * Returns true if 'ttlMonitorMaxReplicationLagSecs' is enabled and the majority-committed
+     * optime trails this node's last applied optime by more than that many seconds.
+     */
+    bool replicationLagExceedsLimit(OperationContext* opCtx) const {
+        const int maxLagSecs = ttlMonitorMaxReplicationLagSecs.load();
+        if (maxLagSecs == 0) {
+            return false;
+        }
+
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+            return false;
+        }
+
+        const auto lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp();
+        const auto lastCommitted = replCoord->getLastCommittedOpTime().getTimestamp();
+        return lastApplied.getSecs() > lastCommitted.getSecs() + static_cast<unsigned>(maxLagSecs);
+    }
+
     /**
      * Remove documents from the collection using the specified TTL index after a sufficient amount
      * of time has passed according to its expiry specification.
@@ -84,6 +84,7 @@ Status ViewCatalog::_reloadIfNeeded_inlock(OperationContext* opCtx) {
 
     // Need to reload, first clear our cache.
     _viewMap.clear();
+    _resolvedViewCache.clear();
 
     Status status = _durable->iterate(opCtx, [&](const BSONObj& view) -> Status {
         BSONObj collationSpec = view.hasField("collation") ? view["collation"].Obj() : BSONObj();
@@ -159,8 +160,10 @@ Status ViewCatalog::_createOrUpdateView_inlock(OperationContext* opCtx,
 
     _durable->upsert(opCtx, viewName, viewDefBuilder.obj());
     _viewMap[viewName.ns()] = view;
+    _resolvedViewCache.clear();
     opCtx->recoveryUnit()->onRollback([this, viewName]() {
         this->_viewMap.erase(viewName.ns());
+        this->_resolvedViewCache.clear();
         this->_viewGraphNeedsRefresh = true;
     });
 
@@ -389,9 +392,11 @@ Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& vie
     _durable->remove(opCtx, viewName);
     _viewGraph.remove(savedDefinition.name());
     _viewMap.erase(viewName.ns());
+    _resolvedViewCache.clear();
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition]() {
         this->_viewGraphNeedsRefresh = true;
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        this->_resolvedViewCache.clear();
     });
 
     // We may get invalidated, but we're exclusively locked, so the change must be ours.
@@ -436,6 +441,17 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
     // Keep looping until the resolution completes. If the catalog is invalidated during the
     // resolution, we start over from the beginning.
     while (true) {
+        // Reload the catalog if needed before consulting the resolved-view cache, so that a
+        // pending invalidation drops stale entries first.
+        if (!_valid.load()) {
+            uassertStatusOK(_reloadIfNeeded_inlock(opCtx));
+        }
+
+        auto cached = _resolvedViewCache.find(nss.ns());
+        if (cached != _resolvedViewCache.end()) {
+            return cached->second;
+        }
+
         // Points to the name of the most resolved namespace.
         const NamespaceString* resolvedNss = &nss;
 
@@ -477,8 +493,15 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                             str::stream() << "View pipeline exceeds maximum size; maximum size is "
                                           << ViewGraph::kMaxViewPipelineSizeBytes};
                 }
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+
+                ResolvedView resolvedView{
+                    *resolvedNss, std::move(resolvedPipeline), std::move(collation.get())};
+                if (depth > 0) {
+                    // 'nss' resolved through at least one view; remember the flattened result
+                    // until the next catalog change.
+                    _resolvedViewCache.insert({nss.ns(), resolvedView});
+                }
+                return StatusWith<ResolvedView>(std::move(resolvedView));
             }
 
             resolvedNss = &view->viewOn();
@@ -493,8 +516,10 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
 
             // If the first stage is a $collStats, then we return early with the viewOn namespace.
             if (toPrepend.size() > 0 && !toPrepend[0]["$collStats"].eoo()) {
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                ResolvedView resolvedView{
+                    *resolvedNss, std::move(resolvedPipeline), std::move(collation.get())};
+                _resolvedViewCache.insert({nss.ns(), resolvedView});
+                return StatusWith<ResolvedView>(std::move(resolvedView));
             }
         }
 
@@ -172,6 +172,12 @@ private:
 
     stdx::mutex _mutex;  // Protects all members, except for _valid.
     ViewMap _viewMap;
+
+    // Cache of fully-resolved (flattened) views, keyed by the namespace the resolution started
+    // from. Only namespaces that resolved through at least one view are cached, and the cache
+    // is cleared on every view catalog change, so queries against a view pay the graph walk
+    // once per definition change rather than once per query.
+    StringMap<ResolvedView> _resolvedViewCache;
     DurableViewCatalog* _durable;
     AtomicBool _valid;
     ViewGraph _viewGraph;
@@ -529,6 +529,37 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectPipeline) {
     }
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewIsCachedUntilCatalogChanges) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString viewOn("db.coll");
+    BSONArrayBuilder pipeline1;
+    pipeline1 << BSON("$match" << BSON("foo" << 1));
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(), view1, viewOn, pipeline1.arr(), emptyCollation));
+
+    auto first = viewCatalog.resolveView(opCtx.get(), view1);
+    ASSERT(first.isOK());
+    auto second = viewCatalog.resolveView(opCtx.get(), view1);
+    ASSERT(second.isOK());
+
+    // The second resolution is served from the cache, so its pipeline shares the first
+    // resolution's underlying buffers.
+    ASSERT_EQ(first.getValue().getPipeline().size(), second.getValue().getPipeline().size());
+    ASSERT_EQUALS(static_cast<const void*>(first.getValue().getPipeline()[0].objdata()),
+                  static_cast<const void*>(second.getValue().getPipeline()[0].objdata()));
+
+    // Changing the view definition must drop the cached resolution.
+    BSONArrayBuilder pipeline2;
+    pipeline2 << BSON("$match" << BSON("foo" << 2));
+    ASSERT_OK(viewCatalog.modifyView(opCtx.get(), view1, viewOn, pipeline2.arr()));
+
+    auto third = viewCatalog.resolveView(opCtx.get(), view1);
+    ASSERT(third.isOK());
+    ASSERT_EQ(1UL, third.getValue().getPipeline().size());
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(third.getValue().getPipeline()[0] ==
+                                                       BSON("$match" << BSON("foo" << 2))));
+}
+
 TEST_F(ViewCatalogFixture, ResolveViewCorrectlyExtractsDefaultCollation) {
     const NamespaceString view1("db.view1");
     const NamespaceString view2("db.view2");
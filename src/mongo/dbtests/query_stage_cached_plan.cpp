@@ -375,6 +375,32 @@ TEST_F(QueryStageCachedPlan, DeactivatesEntriesOnReplan) {
     ASSERT_EQ(assertGet(cache->getEntry(*shapeCq))->works, 1U);
 }
 
+TEST_F(QueryStageCachedPlan, ReplanningWorksWhenIncrementalReplanDisabled) {
+    // Disable incremental re-ranking so that replanning always runs the full planner.
+    internalQueryCacheReplanIncrementally.store(false);
+    ON_BLOCK_EXIT([] { internalQueryCacheReplanIncrementally.store(true); });
+
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    Collection* collection = ctx.getCollection();
+    ASSERT(collection);
+
+    // Query can be answered by either index on "a" or index on "b".
+    const auto noResultsCq =
+        canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 11}, b: {$gte: 11}}"));
+
+    PlanCache* cache = collection->infoCache()->getPlanCache();
+    ASSERT(cache);
+    ASSERT_EQ(cache->get(*noResultsCq).state, PlanCache::CacheEntryState::kNotPresent);
+
+    // Replanning from scratch should create an inactive entry, then activate it on the
+    // second replan, exactly as with incremental re-ranking enabled.
+    forceReplanning(collection, noResultsCq.get());
+    ASSERT_EQ(cache->get(*noResultsCq).state, PlanCache::CacheEntryState::kPresentInactive);
+    forceReplanning(collection, noResultsCq.get());
+    ASSERT_EQ(cache->get(*noResultsCq).state, PlanCache::CacheEntryState::kPresentActive);
+    ASSERT_EQ(assertGet(cache->getEntry(*noResultsCq))->works, 1U);
+}
+
 TEST_F(QueryStageCachedPlan, EntriesAreNotDeactivatedWhenInactiveEntriesDisabled) {
     // Set the global flag for disabling active entries.
     internalQueryCacheDisableInactiveEntries.store(true);
@@ -32,6 +32,7 @@
 
 #include "mongo/embedded/embedded.h"
 
+#include "mongo/base/global_initializer.h"
 #include "mongo/base/initializer.h"
 #include "mongo/config.h"
 #include "mongo/db/catalog/database_holder.h"
@@ -185,6 +186,19 @@ ServiceContext* initialize(const char* yaml_config) {
     // existed. If it is nullptr then use 0 count which will be interpreted as empty string.
     const char* argv[2] = {yaml_config, nullptr};
 
+    // Tiered initialization: only storage and CRUD-essential initializers run up front, to keep
+    // library startup short on constrained devices. Subsystems that no basic CRUD path touches
+    // are deferred to the service entry point, which completes them before serving the first
+    // request. Names not linked into this binary are simply absent from the graph.
+    auto& dependencyGraph = getGlobalInitializer().getInitializerDependencyGraph();
+    for (auto&& lazyNode : {"FTSAllLanguagesRegistered",
+                            "FTSRegisterV2LanguagesAndLater",
+                            "FTSRegisterLanguageAliases",
+                            "FTSIndexFormat",
+                            "StopWords"}) {
+        dependencyGraph.markNodeLazy(lazyNode).ignore();
+    }
+
     Status status = mongo::runGlobalInitializers(yaml_config ? 1 : 0, argv, nullptr);
     uassertStatusOKWithContext(status, "Global initilization failed");
     setGlobalServiceContext(ServiceContext::make());
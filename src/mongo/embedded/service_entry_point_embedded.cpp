@@ -32,6 +32,7 @@
 
 #include "mongo/embedded/service_entry_point_embedded.h"
 
+#include "mongo/base/initializer.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/service_entry_point_common.h"
 #include "mongo/embedded/not_implemented.h"
@@ -81,6 +82,11 @@ public:
 };
 
 DbResponse ServiceEntryPointEmbedded::handleRequest(OperationContext* opCtx, const Message& m) {
+    // Complete any initialization that embedded::initialize() deferred to shorten library
+    // startup. This runs once per instance, before its first request is served.
+    std::call_once(_lazyInitOnce, [this] { _lazyInitStatus = runGlobalLazyInitializers(); });
+    uassertStatusOK(_lazyInitStatus);
+
     // Only one thread will pump at a time and concurrent calls to this will skip the pumping and go
     // directly to handleRequest. This means that the jobs in the periodic runner can't provide any
     // guarantees of the state (that they have run).
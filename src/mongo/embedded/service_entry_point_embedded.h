@@ -28,7 +28,10 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
 #include "mongo/transport/service_entry_point.h"
 
 namespace mongo {
@@ -52,6 +55,10 @@ public:
 
 private:
     class Hooks;
+
+    // Completes lazily deferred global initialization before the first request is served.
+    std::once_flag _lazyInitOnce;
+    Status _lazyInitStatus = Status::OK();
 };
 
 }  // namespace mongo
@@ -32,6 +32,8 @@
 
 #include "mongo/executor/connection_pool.h"
 
+#include <boost/optional.hpp>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/remote_command_request.h"
@@ -43,7 +45,7 @@
 #include "mongo/util/scopeguard.h"
 
 // One interesting implementation note herein concerns how setup() and
-// refresh() are invoked outside of the global lock, but setTimeout is not.
+// refresh() are invoked outside of the pool's lock, but setTimeout is not.
 // This implementation detail simplifies mocks, allowing them to return
 // synchronously sometimes, whereas having timeouts fire instantly adds little
 // value. In practice, dumping the locks is always safe (because we restrict
@@ -58,9 +60,19 @@ namespace executor {
  * Pools come into existance the first time a connection is requested and
  * go out of existence after hostTimeout passes without any of their
  * connections being used.
+ *
+ * Each specific pool has its own mutex; the parent's mutex only guards the
+ * map of pools. Checkouts against distinct hosts therefore never contend on
+ * a lock beyond the map lookup, which matters for mongos fanning out to many
+ * shards. The only place both locks are held at once is when an idle pool
+ * delists itself from the parent, which acquires the parent mutex while
+ * holding its own; the parent never takes a pool's mutex while holding its
+ * own, so this ordering cannot deadlock.
  */
 class ConnectionPool::SpecificPool final
     : public std::enable_shared_from_this<ConnectionPool::SpecificPool> {
+    friend class ConnectionPool;
+
 public:
     /**
      * Whenever a function enters a specific pool, the function needs to be guarded.
@@ -69,7 +81,7 @@ public:
      *
      * The complexity comes from the need to hold a lock when writing to the
      * _activeClients param on the specific pool.  Because the code beneath the client needs to lock
-     * and unlock the parent mutex (and can leave unlocked), we want to start the client with the
+     * and unlock the pool's mutex (and can leave unlocked), we want to start the client with the
      * lock acquired, move it into the client, then re-acquire to decrement the counter on the way
      * out.
      *
@@ -85,11 +97,11 @@ public:
     template <typename Callback>
     auto guardCallback(Callback&& cb) {
         return [ cb = std::forward<Callback>(cb), anchor = shared_from_this() ](auto&&... args) {
-            stdx::unique_lock<stdx::mutex> lk(anchor->_parent->_mutex);
+            stdx::unique_lock<stdx::mutex> lk(anchor->_mutex);
             ++(anchor->_activeClients);
 
             ON_BLOCK_EXIT([anchor]() {
-                stdx::unique_lock<stdx::mutex> lk(anchor->_parent->_mutex);
+                stdx::unique_lock<stdx::mutex> lk(anchor->_mutex);
                 --(anchor->_activeClients);
             });
 
@@ -101,12 +113,16 @@ public:
     ~SpecificPool();
 
     /**
-     * Gets a connection from the specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Gets a connection from the specific pool. Sinks a unique_lock on this
+     * pool's _mutex to preserve the lock.
+     *
+     * Returns boost::none if this pool raced into shutdown between the caller
+     * looking it up and taking its lock; the caller should delist it and retry
+     * against a fresh pool.
      */
-    Future<ConnectionHandle> getConnection(const HostAndPort& hostAndPort,
-                                           Milliseconds timeout,
-                                           stdx::unique_lock<stdx::mutex> lk);
+    boost::optional<Future<ConnectionHandle>> getConnection(const HostAndPort& hostAndPort,
+                                                            Milliseconds timeout,
+                                                            stdx::unique_lock<stdx::mutex> lk);
 
     /**
      * Triggers the shutdown procedure. This function marks the state as kInShutdown
@@ -124,8 +140,8 @@ public:
     void processFailure(const Status& status, stdx::unique_lock<stdx::mutex> lk);
 
     /**
-     * Returns a connection to a specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Returns a connection to a specific pool. Sinks a unique_lock on this
+     * pool's _mutex to preserve the lock.
      */
     void returnConnection(ConnectionInterface* connection, stdx::unique_lock<stdx::mutex> lk);
 
@@ -203,6 +219,10 @@ private:
 
     const HostAndPort _hostAndPort;
 
+    // Guards all of this pool's mutable state. Mutable so the stats accessors,
+    // reached through a const parent, can lock it.
+    mutable stdx::mutex _mutex;
+
     LRUOwnershipPool _readyPool;
     OwnershipPool _processingPool;
     OwnershipPool _droppedProcessingPool;
@@ -289,7 +309,7 @@ void ConnectionPool::shutdown() {
     }();
 
     for (const auto& pair : pools) {
-        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        stdx::unique_lock<stdx::mutex> lk(pair.second->_mutex);
         pair.second->triggerShutdown(
             Status(ErrorCodes::ShutdownInProgress, "Shutting down the connection pool"),
             std::move(lk));
@@ -297,14 +317,17 @@ void ConnectionPool::shutdown() {
 }
 
 void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    auto pool = [&]() -> std::shared_ptr<SpecificPool> {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
 
-    auto iter = _pools.find(hostAndPort);
+        auto iter = _pools.find(hostAndPort);
+        return (iter == _pools.end()) ? nullptr : iter->second;
+    }();
 
-    if (iter == _pools.end())
+    if (!pool)
         return;
 
-    auto pool = iter->second;
+    stdx::unique_lock<stdx::mutex> lk(pool->_mutex);
     pool->processFailure(Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"),
                          std::move(lk));
 }
@@ -319,7 +342,7 @@ void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
     for (const auto& pair : pools) {
         auto& pool = pair.second;
 
-        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        stdx::unique_lock<stdx::mutex> lk(pool->_mutex);
         if (pool->matchesTags(lk, tags))
             continue;
 
@@ -332,14 +355,17 @@ void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
 void ConnectionPool::mutateTags(
     const HostAndPort& hostAndPort,
     const stdx::function<transport::Session::TagMask(transport::Session::TagMask)>& mutateFunc) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    auto pool = [&]() -> std::shared_ptr<SpecificPool> {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
 
-    auto iter = _pools.find(hostAndPort);
+        auto iter = _pools.find(hostAndPort);
+        return (iter == _pools.end()) ? nullptr : iter->second;
+    }();
 
-    if (iter == _pools.end())
+    if (!pool)
         return;
 
-    auto pool = iter->second;
+    stdx::unique_lock<stdx::mutex> lk(pool->_mutex);
     pool->mutateTags(lk, mutateFunc);
 }
 
@@ -351,31 +377,51 @@ void ConnectionPool::get(const HostAndPort& hostAndPort,
 
 Future<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPort& hostAndPort,
                                                              Milliseconds timeout) {
-    std::shared_ptr<SpecificPool> pool;
+    while (true) {
+        std::shared_ptr<SpecificPool> pool;
 
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+        {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
 
-    auto iter = _pools.find(hostAndPort);
+            auto iter = _pools.find(hostAndPort);
 
-    if (iter == _pools.end()) {
-        pool = stdx::make_unique<SpecificPool>(this, hostAndPort);
-        _pools[hostAndPort] = pool;
-    } else {
-        pool = iter->second;
-    }
+            if (iter == _pools.end()) {
+                pool = stdx::make_unique<SpecificPool>(this, hostAndPort);
+                _pools[hostAndPort] = pool;
+            } else {
+                pool = iter->second;
+            }
+        }
 
-    invariant(pool);
+        invariant(pool);
 
-    return pool->getConnection(hostAndPort, timeout, std::move(lk));
+        auto future = pool->getConnection(
+            hostAndPort, timeout, stdx::unique_lock<stdx::mutex>(pool->_mutex));
+        if (future)
+            return std::move(*future);
+
+        // The pool went into shutdown between our map lookup and taking its lock. It will
+        // delist itself; forget it here as well so the next pass creates a fresh pool.
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        auto iter = _pools.find(hostAndPort);
+        if (iter != _pools.end() && iter->second == pool) {
+            _pools.erase(iter);
+        }
+    }
 }
 
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    // Grab all current pools (under the lock)
+    auto pools = [&] {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        return _pools;
+    }();
 
-    for (const auto& kv : _pools) {
+    for (const auto& kv : pools) {
         HostAndPort host = kv.first;
 
         auto& pool = kv.second;
+        stdx::unique_lock<stdx::mutex> lk(pool->_mutex);
         ConnectionStatsPer hostStats{pool->inUseConnections(lk),
                                      pool->availableConnections(lk),
                                      pool->createdConnections(lk),
@@ -385,26 +431,34 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
 }
 
 size_t ConnectionPool::getNumConnectionsPerHost(const HostAndPort& hostAndPort) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-    auto iter = _pools.find(hostAndPort);
-    if (iter != _pools.end()) {
-        return iter->second->openConnections(lk);
+    auto pool = [&]() -> std::shared_ptr<SpecificPool> {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+        auto iter = _pools.find(hostAndPort);
+        return (iter == _pools.end()) ? nullptr : iter->second;
+    }();
+
+    if (pool) {
+        stdx::unique_lock<stdx::mutex> lk(pool->_mutex);
+        return pool->openConnections(lk);
     }
 
     return 0;
 }
 
 void ConnectionPool::returnConnection(ConnectionInterface* conn) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    auto pool = [&]() -> std::shared_ptr<SpecificPool> {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
 
-    auto iter = _pools.find(conn->getHostAndPort());
+        auto iter = _pools.find(conn->getHostAndPort());
+        return (iter == _pools.end()) ? nullptr : iter->second;
+    }();
 
-    invariant(iter != _pools.end(),
+    invariant(pool,
               str::stream() << "Tried to return connection but no pool found for "
                             << conn->getHostAndPort());
 
-    auto pool = iter->second;
-    pool->returnConnection(conn, std::move(lk));
+    pool->returnConnection(conn, stdx::unique_lock<stdx::mutex>(pool->_mutex));
 }
 
 ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAndPort& hostAndPort)
@@ -448,9 +502,16 @@ size_t ConnectionPool::SpecificPool::openConnections(const stdx::unique_lock<std
     return _checkedOutPool.size() + _readyPool.size() + _processingPool.size();
 }
 
-Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnection(
-    const HostAndPort& hostAndPort, Milliseconds timeout, stdx::unique_lock<stdx::mutex> lk) {
-    invariant(_state != State::kInShutdown);
+boost::optional<Future<ConnectionPool::ConnectionHandle>>
+ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
+                                            Milliseconds timeout,
+                                            stdx::unique_lock<stdx::mutex> lk) {
+    if (_state == State::kInShutdown) {
+        // We lost a race with this pool shutting down and delisting itself. The caller
+        // retries against a fresh pool rather than queueing a request that would never
+        // be serviced.
+        return boost::none;
+    }
 
     if (timeout < Milliseconds(0) || timeout > _parent->_options.refreshTimeout) {
         timeout = _parent->_options.refreshTimeout;
@@ -467,7 +528,7 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
     spawnConnections(lk);
     fulfillRequests(lk);
 
-    return std::move(pf.future);
+    return boost::optional<Future<ConnectionHandle>>(std::move(pf.future));
 }
 
 void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr,
@@ -804,9 +865,17 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
     if (_state == State::kInShutdown) {
         // If we're in shutdown, there is nothing to update. Our clients are all gone.
         if (_processingPool.empty() && !_activeClients) {
-            // If we have no more clients that require access to us, delist from the parent pool
+            // If we have no more clients that require access to us, delist from the parent pool.
+            // This takes the parent's mutex while holding our own; the parent never locks a
+            // specific pool's mutex while holding its own, so this ordering is deadlock free.
+            // A get() that raced into shutdown may have already replaced our map entry with a
+            // fresh pool, so only erase the entry if it is still ours.
             LOG(2) << "Delisting connection pool for " << _hostAndPort;
-            _parent->_pools.erase(_hostAndPort);
+            stdx::lock_guard<stdx::mutex> poolsLk(_parent->_mutex);
+            auto iter = _parent->_pools.find(_hostAndPort);
+            if (iter != _parent->_pools.end() && iter->second.get() == this) {
+                _parent->_pools.erase(iter);
+            }
         }
         return;
     }
@@ -876,7 +945,7 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
 
         // Set the shutdown timer, this gets reset on any request
         _requestTimer->setTimeout(timeout, [ this, anchor = shared_from_this() ]() {
-            stdx::unique_lock<stdx::mutex> lk(anchor->_parent->_mutex);
+            stdx::unique_lock<stdx::mutex> lk(anchor->_mutex);
             if (_state != State::kIdle)
                 return;
 
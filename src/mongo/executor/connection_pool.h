@@ -165,7 +165,9 @@ private:
 
     const std::shared_ptr<DependentTypeFactoryInterface> _factory;
 
-    // The global mutex for specific pool access and the generation counter
+    // Guards only the map of specific pools. Each SpecificPool is protected by its
+    // own mutex, so connection checkouts against distinct hosts contend here only
+    // for the map lookup.
     mutable stdx::mutex _mutex;
     stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 
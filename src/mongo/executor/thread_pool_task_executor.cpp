@@ -559,14 +559,21 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
         }
     }
 
+    std::vector<ThreadPoolInterface::Task> batch;
+    batch.reserve(todo.size());
     for (const auto& cbState : todo) {
         if (cbState->baton) {
             cbState->baton->schedule([this, cbState] { runCallback(std::move(cbState)); });
         } else {
-            const auto status =
-                _pool->schedule([this, cbState] { runCallback(std::move(cbState)); });
-            if (status == ErrorCodes::ShutdownInProgress)
-                break;
+            batch.emplace_back([this, cbState] { runCallback(std::move(cbState)); });
+        }
+    }
+
+    if (!batch.empty()) {
+        // Hand the whole burst to the pool at once, so that it takes its lock and wakes worker
+        // threads once per burst rather than once per task.
+        const auto status = _pool->scheduleBatch(std::move(batch));
+        if (status != ErrorCodes::ShutdownInProgress) {
             fassert(28735, status);
         }
     }
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/logger/appender.h"
+#include "mongo/logger/encoder.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace logger {
+
+/**
+ * Encoder for log lines that have already been formatted. Used downstream of an AsyncAppender,
+ * which hands pre-encoded lines to an Appender<std::string>.
+ */
+class PreEncodedLineEncoder : public Encoder<std::string> {
+public:
+    virtual ~PreEncodedLineEncoder() {}
+    virtual std::ostream& encode(const std::string& line, std::ostream& os) {
+        return os << line;
+    }
+};
+
+/**
+ * Appender that moves the writing of log events off the logging thread.
+ *
+ * Events are encoded on the caller's thread -- they are ephemeral and may reference the caller's
+ * stack, so they cannot outlive the append() call -- but the encoded line is only queued here.
+ * A dedicated thread drains the queue in batches and hands each line to the downstream
+ * Appender<std::string>, so a slow or rotating log file stalls the writer thread instead of
+ * every operation thread.
+ *
+ * The queue is bounded. When the writer cannot keep up, append() drops the event rather than
+ * block, and the writer reports how many lines were dropped once it catches up. Lines still
+ * queued when the process exits without destroying the appender are lost; the writer thread
+ * therefore drains eagerly instead of coalescing on a timer.
+ */
+template <typename Event>
+class AsyncAppender : public Appender<Event> {
+    MONGO_DISALLOW_COPYING(AsyncAppender);
+
+public:
+    typedef Encoder<Event> EventEncoder;
+
+    static const size_t kDefaultMaxQueuedLines = 16 * 1024;
+
+    AsyncAppender(std::unique_ptr<EventEncoder> encoder,
+                  std::unique_ptr<Appender<std::string>> downstream,
+                  size_t maxQueuedLines = kDefaultMaxQueuedLines)
+        : _encoder(std::move(encoder)),
+          _downstream(std::move(downstream)),
+          _maxQueuedLines(maxQueuedLines) {
+        _writer = stdx::thread([this] { _writeLoop(); });
+    }
+
+    virtual ~AsyncAppender() {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _shuttingDown = true;
+        }
+        _condvar.notify_one();
+        _writer.join();
+        // Whatever the writer had not gotten to is written synchronously; destruction is the
+        // one place where losing queued lines is not acceptable.
+        _writeBatch();
+    }
+
+    virtual Status append(const Event& event) {
+        std::ostringstream os;
+        _encoder->encode(event, os);
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (_queue.size() >= _maxQueuedLines) {
+                ++_dropped;
+                return Status::OK();
+            }
+            _queue.push_back(os.str());
+        }
+        _condvar.notify_one();
+        return Status::OK();
+    }
+
+    /**
+     * Number of events dropped so far because the queue was full. Dropped totals are also
+     * reported in-stream by the writer thread once it catches up.
+     */
+    size_t droppedEventCount() const {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _dropped;
+    }
+
+private:
+    void _writeLoop() {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        while (!_shuttingDown) {
+            if (_queue.empty()) {
+                _condvar.wait(lk);
+                continue;
+            }
+            lk.unlock();
+            _writeBatch();
+            lk.lock();
+        }
+    }
+
+    void _writeBatch() {
+        std::vector<std::string> batch;
+        size_t dropped;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            batch.assign(std::make_move_iterator(_queue.begin()),
+                         std::make_move_iterator(_queue.end()));
+            _queue.clear();
+            dropped = _dropped - _droppedReported;
+            _droppedReported = _dropped;
+        }
+        for (const auto& line : batch) {
+            _downstream->append(line).ignore();
+        }
+        if (dropped) {
+            std::ostringstream os;
+            os << "log: dropped " << dropped << " log lines; async log buffer was full\n";
+            _downstream->append(os.str()).ignore();
+        }
+    }
+
+    std::unique_ptr<EventEncoder> _encoder;
+    std::unique_ptr<Appender<std::string>> _downstream;
+    const size_t _maxQueuedLines;
+
+    mutable stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    std::deque<std::string> _queue;  // Guarded by _mutex.
+    size_t _dropped = 0;             // Guarded by _mutex.
+    size_t _droppedReported = 0;     // Guarded by _mutex.
+    bool _shuttingDown = false;      // Guarded by _mutex.
+    stdx::thread _writer;
+};
+
+}  // namespace logger
+}  // namespace mongo
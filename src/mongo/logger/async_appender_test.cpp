@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/logger/async_appender.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace logger {
+namespace {
+
+/**
+ * Downstream appender that records every line it receives. The optional gate lets a test hold
+ * the writer thread inside append() to force the async queue to fill up.
+ */
+class CapturingAppender : public Appender<std::string> {
+public:
+    virtual Status append(const std::string& line) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
+            _writerInAppend = true;
+            _writerEntered.notify_all();
+            while (_gated) {
+                _gateReleased.wait(lk);
+            }
+        }
+        _lines.push_back(line);
+        return Status::OK();
+    }
+
+    void closeGate() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _gated = true;
+    }
+
+    void openGate() {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _gated = false;
+        }
+        _gateReleased.notify_all();
+    }
+
+    void waitForWriter() {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        while (!_writerInAppend) {
+            _writerEntered.wait(lk);
+        }
+    }
+
+    // Only safe to inspect once the AsyncAppender under test has been destroyed.
+    const std::vector<std::string>& lines() const {
+        return _lines;
+    }
+
+private:
+    stdx::mutex _mutex;
+    stdx::condition_variable _gateReleased;
+    stdx::condition_variable _writerEntered;
+    bool _gated = false;
+    bool _writerInAppend = false;
+    std::vector<std::string> _lines;
+};
+
+TEST(AsyncAppenderTest, DeliversAllLinesInOrder) {
+    auto downstream = stdx::make_unique<CapturingAppender>();
+    CapturingAppender* capture = downstream.get();
+    {
+        AsyncAppender<std::string> appender(stdx::make_unique<PreEncodedLineEncoder>(),
+                                            std::move(downstream));
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_OK(appender.append("line " + std::to_string(i) + "\n"));
+        }
+        ASSERT_EQUALS(0U, appender.droppedEventCount());
+    }
+    ASSERT_EQUALS(100U, capture->lines().size());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQUALS("line " + std::to_string(i) + "\n", capture->lines()[i]);
+    }
+}
+
+TEST(AsyncAppenderTest, DropsWhenQueueIsFullAndReportsTheDrops) {
+    auto downstream = stdx::make_unique<CapturingAppender>();
+    CapturingAppender* capture = downstream.get();
+    capture->closeGate();
+
+    size_t dropped;
+    {
+        const size_t maxQueuedLines = 4;
+        AsyncAppender<std::string> appender(
+            stdx::make_unique<PreEncodedLineEncoder>(), std::move(downstream), maxQueuedLines);
+
+        // Park the writer thread inside the downstream appender, then overfill the queue.
+        ASSERT_OK(appender.append("first\n"));
+        capture->waitForWriter();
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_OK(appender.append("overflow\n"));
+        }
+        dropped = appender.droppedEventCount();
+        ASSERT_GREATER_THAN_OR_EQUALS(dropped, 20 - maxQueuedLines);
+
+        capture->openGate();
+    }
+
+    // Destruction drains the queue, and the writer reports the dropped total in-stream.
+    ASSERT_EQUALS("first\n", capture->lines().front());
+    bool foundDropNotice = false;
+    for (const auto& line : capture->lines()) {
+        if (line.find("dropped " + std::to_string(dropped)) != std::string::npos) {
+            foundDropNotice = true;
+        }
+    }
+    ASSERT_TRUE(foundDropNotice);
+}
+
+}  // namespace
+}  // namespace logger
+}  // namespace mongo
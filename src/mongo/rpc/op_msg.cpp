@@ -33,12 +33,14 @@
 #include "mongo/rpc/op_msg.h"
 
 #include <bitset>
+#include <cstring>
 #include <set>
 
 #include "mongo/base/data_type_endian.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/rpc/object_check.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/crc32c.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/log.h"
 
@@ -57,6 +59,15 @@ enum class Section : uint8_t {
     kDocSequence = 1,
 };
 
+constexpr int kCrc32Size = 4;
+
+// The checksum is computed over all bytes of the message, header included, except the checksum
+// field itself. Uses the hardware CRC instructions where the platform has them.
+uint32_t calculateChecksum(const Message& message) {
+    invariant(OpMsg::isFlagSet(message, OpMsg::kChecksumPresent));
+    return crc32c(message.singleData().view2ptr(), message.size() - kCrc32Size);
+}
+
 }  // namespace
 
 uint32_t OpMsg::flags(const Message& message) {
@@ -75,6 +86,23 @@ void OpMsg::replaceFlags(Message* message, uint32_t flags) {
     DataView(message->singleData().data()).write<LittleEndian<uint32_t>>(flags);
 }
 
+void OpMsg::appendChecksum(Message* message) {
+    invariant(!message->empty());
+    invariant(message->operation() == dbMsg);
+    invariant(!isFlagSet(*message, kChecksumPresent));
+
+    setFlag(message, kChecksumPresent);
+
+    const size_t newSize = message->size() + kCrc32Size;
+    auto buf = SharedBuffer::allocate(newSize);
+    memcpy(buf.get(), message->buf(), message->size());
+    MsgData::View(buf.get()).setLen(newSize);
+    *message = Message(std::move(buf));
+
+    DataView(message->buf())
+        .write<LittleEndian<uint32_t>>(calculateChecksum(*message), newSize - kCrc32Size);
+}
+
 OpMsg OpMsg::parse(const Message& message) try {
     // It is the caller's responsibility to call the correct parser for a given message type.
     invariant(!message.empty());
@@ -86,9 +114,11 @@ OpMsg OpMsg::parse(const Message& message) try {
                           << std::bitset<32>(flags).to_string(),
             !containsUnknownRequiredFlags(flags));
 
-    constexpr int kCrc32Size = 4;
     const bool haveChecksum = flags & kChecksumPresent;
     const int checksumSize = haveChecksum ? kCrc32Size : 0;
+    uassert(51251,
+            "Message too small to hold a checksum",
+            !haveChecksum || message.dataSize() >= static_cast<int>(sizeof(flags)) + kCrc32Size);
 
     // The sections begin after the flags and before the checksum (if present).
     BufReader sectionsBuf(message.singleData().data() + sizeof(flags),
@@ -151,6 +181,17 @@ OpMsg OpMsg::parse(const Message& message) try {
                 !inBody);
     }
 
+    if (haveChecksum) {
+        // Validating the checksum after the sections keeps the more precise section errors
+        // above for messages that are both truncated and corrupt.
+        const auto storedChecksum =
+            ConstDataView(message.singleData().data() + message.dataSize() - kCrc32Size)
+                .read<LittleEndian<uint32_t>>();
+        uassert(ErrorCodes::ChecksumMismatch,
+                "OP_MSG checksum does not match contents",
+                storedChecksum == calculateChecksum(message));
+    }
+
     return msg;
 } catch (const DBException& ex) {
     LOG(1) << "invalid message: " << ex.code() << " " << redact(ex) << " -- "
@@ -72,8 +72,17 @@ struct OpMsg {
         replaceFlags(message, flags(*message) | flag);
     }
 
+    /**
+     * Appends a checksum to the given OP_MSG message and sets kChecksumPresent. Only legal on
+     * an otherwise valid OP_MSG message that does not already have a checksum.
+     */
+    static void appendChecksum(Message* message);
+
     /**
      * Parses and returns an OpMsg containing unowned BSON.
+     *
+     * Throws ChecksumMismatch if kChecksumPresent is set and the checksum does not match the
+     * message contents.
      */
     static OpMsg parse(const Message& message);
 
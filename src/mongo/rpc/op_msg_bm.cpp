@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/rpc/op_msg.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeFindCommand() {
+    return BSON("find"
+                << "collection"
+                << "filter"
+                << BSON("_id" << 42)
+                << "limit"
+                << 1
+                << "$db"
+                << "test");
+}
+
+/**
+ * Serialize-then-parse round trip of a typical single-document command, the unit of work the
+ * server performs on every request and reply.
+ */
+void BM_OpMsgRoundTrip(benchmark::State& state) {
+    const BSONObj body = makeFindCommand();
+
+    for (auto keepRunning : state) {
+        OpMsgBuilder builder;
+        builder.setBody(body);
+        Message message = builder.finish();
+        benchmark::DoNotOptimize(OpMsg::parse(message));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Parse alone, over a message built once, for the receive side of the round trip. The message
+ * carries a document sequence like a vectored insert does, so this also covers section
+ * iteration.
+ */
+void BM_OpMsgParseWithDocSequence(benchmark::State& state) {
+    const long long nDocs = state.range(0);
+
+    OpMsgBuilder builder;
+    {
+        auto docSeq = builder.beginDocSequence("documents");
+        for (long long i = 0; i < nDocs; i++) {
+            docSeq.append(BSON("_id" << i << "x"
+                                     << "some padding to look like a real document"));
+        }
+    }
+    builder.setBody(BSON("insert"
+                         << "collection"
+                         << "ordered"
+                         << true
+                         << "$db"
+                         << "test"));
+    const Message message = builder.finish();
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(OpMsg::parse(message));
+    }
+
+    state.SetItemsProcessed(state.iterations() * nDocs);
+}
+
+BENCHMARK(BM_OpMsgRoundTrip);
+
+BENCHMARK(BM_OpMsgParseWithDocSequence)->Arg(1)->Arg(10)->Arg(100);
+
+}  // namespace
+}  // namespace mongo
@@ -157,8 +157,8 @@ const char kDocSequenceSection = 1;
 const uint32_t kNoFlags = 0;
 const uint32_t kHaveChecksum = 1;
 
-// CRC filler value
-const uint32_t kFakeCRC = 0;  // TODO will need to compute real crc when SERVER-28679 is done.
+// CRC filler value, intentionally never a valid checksum of the messages built below.
+const uint32_t kFakeCRC = 0;
 
 TEST_F(OpMsgParser, SucceedsWithJustBody) {
     auto msg = OpMsgBytes{
@@ -171,18 +171,40 @@ TEST_F(OpMsgParser, SucceedsWithJustBody) {
     ASSERT_EQ(msg.sequences.size(), 0u);
 }
 
-TEST_F(OpMsgParser, IgnoresCrcIfPresent) {  // Until SERVER-28679 is done.
-    auto msg = OpMsgBytes{
-        kHaveChecksum,  //
+TEST_F(OpMsgParser, SucceedsWithValidChecksum) {
+    auto message = OpMsgBytes{
+        kNoFlags,  //
         kBodySection,
         fromjson("{ping: 1}"),
-        kFakeCRC,  // If not ignored, this would be read as a second body.
-    }.parse();
+    }.done();
+    OpMsg::appendChecksum(&message);
+    ASSERT(OpMsg::isFlagSet(message, OpMsg::kChecksumPresent));
+
+    auto msg = OpMsg::parse(message);
 
     ASSERT_BSONOBJ_EQ(msg.body, fromjson("{ping: 1}"));
     ASSERT_EQ(msg.sequences.size(), 0u);
 }
 
+TEST_F(OpMsgParser, FailsWithBadChecksum) {
+    auto msg = OpMsgBytes{
+        kHaveChecksum,  //
+        kBodySection,
+        fromjson("{ping: 1}"),
+        kFakeCRC,
+    };
+
+    ASSERT_THROWS_CODE(msg.parse(), AssertionException, ErrorCodes::ChecksumMismatch);
+}
+
+TEST_F(OpMsgParser, FailsWithChecksumFlagButNoRoomForChecksum) {
+    auto msg = OpMsgBytes{
+        kHaveChecksum,  //
+    };
+
+    ASSERT_THROWS_CODE(msg.parse(), AssertionException, 51251);
+}
+
 TEST_F(OpMsgParser, SucceedsWithBodyThenSequence) {
     auto msg = OpMsgBytes{
         kNoFlags,  //
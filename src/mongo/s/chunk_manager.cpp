@@ -84,8 +84,29 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _defaultCollator(std::move(defaultCollator)),
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
-      _shardVersions(
-          _constructShardVersionMap(collectionVersion.epoch(), _chunkMap, _shardKeyOrdering)),
+      _shardVersions(_constructShardVersionMap(
+          collectionVersion.epoch(), _chunkMap, _shardKeyOrdering, &_shardChunkCounts)),
+      _collectionVersion(collectionVersion) {}
+
+RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
+                                         boost::optional<UUID> uuid,
+                                         KeyPattern shardKeyPattern,
+                                         std::unique_ptr<CollatorInterface> defaultCollator,
+                                         bool unique,
+                                         ChunkInfoMap chunkMap,
+                                         ShardVersionMap shardVersions,
+                                         ShardChunkCounts shardChunkCounts,
+                                         ChunkVersion collectionVersion)
+    : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
+      _nss(std::move(nss)),
+      _uuid(uuid),
+      _shardKeyPattern(shardKeyPattern),
+      _shardKeyOrdering(Ordering::make(_shardKeyPattern.toBSON())),
+      _defaultCollator(std::move(defaultCollator)),
+      _unique(unique),
+      _chunkMap(std::move(chunkMap)),
+      _shardChunkCounts(std::move(shardChunkCounts)),
+      _shardVersions(std::move(shardVersions)),
       _collectionVersion(collectionVersion) {}
 
 Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj& collation) const {
@@ -403,17 +424,24 @@ std::string RoutingTableHistory::toString() const {
     return sb.str();
 }
 
-ShardVersionMap RoutingTableHistory::_constructShardVersionMap(const OID& epoch,
-                                                               const ChunkInfoMap& chunkMap,
-                                                               Ordering shardKeyOrdering) {
+ShardVersionMap RoutingTableHistory::_constructShardVersionMap(
+    const OID& epoch,
+    const ChunkInfoMap& chunkMap,
+    Ordering shardKeyOrdering,
+    ShardChunkCounts* shardChunkCounts) {
+    shardChunkCounts->clear();
+    for (const auto& chunkMapEntry : chunkMap) {
+        ++(*shardChunkCounts)[chunkMapEntry.second->getShardIdAt(boost::none)];
+    }
+
     ShardVersionMap shardVersions;
-    ChunkInfoMap::const_iterator current = chunkMap.cbegin();
+    ChunkInfoMap::const_iterator current = chunkMap.begin();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
+    while (current != chunkMap.end()) {
+        const auto firstChunkInRange = current->second;
 
         // Tracks the max shard version for the shard on which the current range will reside
         auto shardVersionIt = shardVersions.find(firstChunkInRange->getShardIdAt(boost::none));
@@ -426,26 +454,27 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap(const OID& epoch,
 
         auto& maxShardVersion = shardVersionIt->second;
 
-        current = std::find_if(
-            current,
-            chunkMap.cend(),
-            [&firstChunkInRange, &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
-                const auto& currentChunk = chunkMapEntry.second;
-
-                if (currentChunk->getShardIdAt(boost::none) !=
-                    firstChunkInRange->getShardIdAt(boost::none))
-                    return true;
+        // Advance through the range of chunks residing on the same shard, remembering the last
+        // chunk seen so that the range's max boundary is known once the range ends. The map's
+        // iterators only move forwards, so the last chunk cannot be recovered by stepping back
+        // from 'current' afterwards.
+        auto rangeLast = firstChunkInRange;
+        while (current != chunkMap.end()) {
+            const auto& currentChunk = current->second;
 
-                if (currentChunk->getLastmod() > maxShardVersion)
-                    maxShardVersion = currentChunk->getLastmod();
+            if (currentChunk->getShardIdAt(boost::none) !=
+                firstChunkInRange->getShardIdAt(boost::none))
+                break;
 
-                return false;
-            });
+            if (currentChunk->getLastmod() > maxShardVersion)
+                maxShardVersion = currentChunk->getLastmod();
 
-        const auto rangeLast = std::prev(current);
+            rangeLast = currentChunk;
+            ++current;
+        }
 
         const BSONObj rangeMin = firstChunkInRange->getMin();
-        const BSONObj rangeMax = rangeLast->second->getMax();
+        const BSONObj rangeMax = rangeLast->getMax();
 
         if (lastMax) {
             uassert(ErrorCodes::ConflictingOperationInProgress,
@@ -513,7 +542,17 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
 
     const auto startingCollectionVersion = getVersion();
+
+    // Copying the map shares its tree with this routing table; the updates below only copy the
+    // nodes on the paths to the chunks they change.
     auto chunkMap = _chunkMap;
+    auto shardVersions = _shardVersions;
+    auto shardChunkCounts = _shardChunkCounts;
+
+    // The chunks inserted by this update, in map order. Only their surroundings can have become
+    // inconsistent, so only they need to be validated below instead of rescanning the entire map.
+    std::vector<std::pair<std::string, ChunkInfoPtr>> insertedChunks;
+    insertedChunks.reserve(changedChunks.size());
 
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
@@ -545,14 +584,31 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         // same chunk (the one being split). If we're inserting the last chunk
         // for the current chunk being split, low will point to the chunk that
         // we're splitting, and high will point to the next chunk past the one
-        // we're splitting (which could be chunkMap.end()). In this case,
-        // std::distance(low, high) == 1. Lastly, this does not apply during
-        // the creation of the original routing table, in which case the map is
+        // we're splitting (which could be chunkMap.end()), so there is exactly
+        // one chunk between them. Lastly, this does not apply during the
+        // creation of the original routing table, in which case the map is
         // empty and the first chunk that is inserted will find that low ==
         // high, but low == chunkMap.end(), and we aren't doing a split in that
         // case.
-        auto foundSingleChunk =
-            ((low == high || std::distance(low, high) == 1) && low != chunkMap.end());
+        //
+        // Collect the chunks overlapping the chunk we got from the persistent store, giving back
+        // the chunk count they contributed to their shards. They cannot be erased while the range
+        // is being walked, because the store only supports erasure by key.
+        std::vector<std::string> overlappingKeys;
+        for (auto it = low; it != high; ++it) {
+            overlappingKeys.push_back(it->first);
+
+            const auto erasedShardId = it->second->getShardIdAt(boost::none);
+            auto countIt = shardChunkCounts.find(erasedShardId);
+            invariant(countIt != shardChunkCounts.end());
+            if (--countIt->second == 0) {
+                // The shard no longer owns any chunks, so it must not report a shard version
+                shardChunkCounts.erase(countIt);
+                shardVersions.erase(erasedShardId);
+            }
+        }
+
+        auto foundSingleChunk = (low != chunkMap.end() && overlappingKeys.size() <= 1);
 
         auto newChunk = std::make_shared<ChunkInfo>(chunk);
         if (foundSingleChunk) {
@@ -563,10 +619,69 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         }
 
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-        chunkMap.erase(low, high);
+        for (const auto& overlappingKey : overlappingKeys) {
+            invariant(chunkMap.erase(overlappingKey) == 1);
+        }
 
         // Insert only the chunk itself
-        chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        auto inserted = chunkMap.insert(ChunkInfoMap::value_type(chunkMaxKeyString, newChunk));
+        invariant(inserted.second);
+        insertedChunks.emplace_back(chunkMaxKeyString, newChunk);
+
+        const auto newChunkShardId = newChunk->getShardIdAt(boost::none);
+        ++shardChunkCounts[newChunkShardId];
+
+        auto shardVersionIt = shardVersions.find(newChunkShardId);
+        if (shardVersionIt == shardVersions.end()) {
+            shardVersionIt =
+                shardVersions
+                    .emplace(newChunkShardId, ChunkVersion(0, 0, startingCollectionVersion.epoch()))
+                    .first;
+        }
+        if (chunkVersion > shardVersionIt->second) {
+            shardVersionIt->second = chunkVersion;
+        }
+    }
+
+    // A torn set of changed chunks can only manifest as a gap or an overlap adjacent to a chunk
+    // that this update inserted, because chunks are only ever erased around insertions. It is
+    // therefore sufficient to validate the neighbours of every inserted chunk that survived the
+    // update, rather than rescanning the entire map.
+    for (const auto& insertedChunk : insertedChunks) {
+        auto it = chunkMap.find(insertedChunk.first);
+        if (it == chunkMap.end() || it->second != insertedChunk.second) {
+            // The chunk was replaced by a later change from the same set
+            continue;
+        }
+
+        const auto& currentChunk = it->second;
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, currentChunk->getMin());
+        } else {
+            // Since every chunk is keyed by its max, in a consistent map the previous chunk is
+            // keyed by exactly this chunk's min
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream()
+                        << "Gap or an overlap at the lower bound of range "
+                        << ChunkRange(currentChunk->getMin(), currentChunk->getMax()).toString(),
+                    chunkMap.find(_extractKeyString(currentChunk->getMin())) != chunkMap.end());
+        }
+
+        auto next = it;
+        ++next;
+        if (next == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, currentChunk->getMax());
+        } else {
+            const auto& nextChunk = next->second;
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream()
+                        << "Gap or an overlap between ranges "
+                        << ChunkRange(currentChunk->getMin(), currentChunk->getMax()).toString()
+                        << " and "
+                        << ChunkRange(nextChunk->getMin(), nextChunk->getMax()).toString(),
+                    SimpleBSONObjComparator::kInstance.evaluate(currentChunk->getMax() ==
+                                                                nextChunk->getMin()));
+        }
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -587,6 +702,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
+                                std::move(shardVersions),
+                                std::move(shardChunkCounts),
                                 collectionVersion));
 }
 
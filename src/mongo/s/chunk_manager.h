@@ -36,6 +36,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/storage/biggie/store.h"
 #include "mongo/s/chunk.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
@@ -49,12 +50,55 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+/**
+ * Wraps a ChunkInfo object in the value interface that the RadixStore requires. The data size the
+ * store tracks is meaningless for the routing table, but its bookkeeping requires every value to
+ * report one.
+ */
+class ChunkInfoPtr {
+public:
+    ChunkInfoPtr() = default;
+    ChunkInfoPtr(std::shared_ptr<ChunkInfo> chunk) : _chunk(std::move(chunk)) {}
+
+    ChunkInfo& operator*() const {
+        return *_chunk;
+    }
+
+    ChunkInfo* operator->() const {
+        return _chunk.get();
+    }
+
+    ChunkInfo* get() const {
+        return _chunk.get();
+    }
+
+    bool operator==(const ChunkInfoPtr& other) const {
+        return _chunk == other._chunk;
+    }
+
+    bool operator!=(const ChunkInfoPtr& other) const {
+        return _chunk != other._chunk;
+    }
+
+    size_t size() const {
+        return sizeof(ChunkInfo);
+    }
+
+private:
+    std::shared_ptr<ChunkInfo> _chunk;
+};
+
+// Ordered map from the max for each chunk to an entry describing the chunk. Backed by a radix tree
+// with structural sharing between versions, so that a routing table updated from this one only
+// copies the nodes on the paths to the changed chunks instead of the entire map.
+using ChunkInfoMap = biggie::RadixStore<std::string, ChunkInfoPtr>;
 
 // Map from a shard is to the max chunk version on that shard
 using ShardVersionMap = std::map<ShardId, ChunkVersion>;
 
+// Map from a shard id to the number of chunks it owns
+using ShardChunkCounts = std::map<ShardId, size_t>;
+
 /**
  * In-memory representation of the routing table for a single sharded collection at various points
  * in time.
@@ -151,11 +195,13 @@ public:
 
 private:
     /**
-     * Does a single pass over the chunkMap and constructs the ShardVersionMap object.
+     * Does a single pass over the chunkMap, constructs the ShardVersionMap object and fills in
+     * 'shardChunkCounts' with the number of chunks each shard owns.
      */
     static ShardVersionMap _constructShardVersionMap(const OID& epoch,
                                                      const ChunkInfoMap& chunkMap,
-                                                     Ordering shardKeyOrdering);
+                                                     Ordering shardKeyOrdering,
+                                                     ShardChunkCounts* shardChunkCounts);
 
     RoutingTableHistory(NamespaceString nss,
                         boost::optional<UUID> uuid,
@@ -165,6 +211,20 @@ private:
                         ChunkInfoMap chunkMap,
                         ChunkVersion collectionVersion);
 
+    /**
+     * Used by makeUpdated(), which maintains the shard version map and the per-shard chunk counts
+     * incrementally instead of rescanning the entire chunk map.
+     */
+    RoutingTableHistory(NamespaceString nss,
+                        boost::optional<UUID> uuid,
+                        KeyPattern shardKeyPattern,
+                        std::unique_ptr<CollatorInterface> defaultCollator,
+                        bool unique,
+                        ChunkInfoMap chunkMap,
+                        ShardVersionMap shardVersions,
+                        ShardChunkCounts shardChunkCounts,
+                        ChunkVersion collectionVersion);
+
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
 
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
@@ -192,6 +252,11 @@ private:
     // ranges must cover the complete space from [MinKey, MaxKey).
     const ChunkInfoMap _chunkMap;
 
+    // Number of chunks that each shard currently owns. Maintained so that makeUpdated() can keep
+    // _shardVersions up to date without rescanning the entire chunk map: a shard's entry in
+    // _shardVersions is removed once the last of its chunks moves away.
+    ShardChunkCounts _shardChunkCounts;
+
     // Map from shard id to the maximum chunk version for that shard. If a shard contains no
     // chunks, it won't be present in this map.
     const ShardVersionMap _shardVersions;
@@ -289,8 +354,8 @@ public:
     }
 
     ConstRangeOfChunks chunks() const {
-        return {ConstChunkIterator{_rt->getChunkMap().cbegin(), _clusterTime},
-                ConstChunkIterator{_rt->getChunkMap().cend(), _clusterTime}};
+        return {ConstChunkIterator{_rt->getChunkMap().begin(), _clusterTime},
+                ConstChunkIterator{_rt->getChunkMap().end(), _clusterTime}};
     }
 
     int numChunks() const {
@@ -56,7 +56,6 @@
 #include "mongo/s/grid.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
-#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/log.h"
 #include "mongo/util/map_util.h"
 #include "mongo/util/mongoutils/str.h"
@@ -87,7 +86,9 @@ const ShardId ShardRegistry::kConfigServerShardId = ShardId("config");
 
 ShardRegistry::ShardRegistry(std::unique_ptr<ShardFactory> shardFactory,
                              const ConnectionString& configServerCS)
-    : _shardFactory(std::move(shardFactory)), _initConfigServerCS(configServerCS) {}
+    : _shardFactory(std::move(shardFactory)),
+      _initConfigServerCS(configServerCS),
+      _data(std::make_shared<ShardRegistryData>()) {}
 
 ShardRegistry::~ShardRegistry() {
     shutdown();
@@ -106,17 +107,26 @@ ConnectionString ShardRegistry::getConfigServerConnectionString() const {
     return getConfigShard()->getConnString();
 }
 
+std::shared_ptr<const ShardRegistryData> ShardRegistry::_getData() const {
+    return std::atomic_load(&_data);
+}
+
+void ShardRegistry::_setData(std::shared_ptr<const ShardRegistryData> newData) {
+    invariant(newData);
+    std::atomic_store(&_data, std::move(newData));
+}
+
 StatusWith<shared_ptr<Shard>> ShardRegistry::getShard(OperationContext* opCtx,
                                                       const ShardId& shardId) {
     // If we know about the shard, return it.
-    auto shard = _data.findByShardId(shardId);
+    auto shard = _getData()->findByShardId(shardId);
     if (shard) {
         return shard;
     }
 
     // If we can't find the shard, attempt to reload the ShardRegistry.
     bool didReload = reload(opCtx);
-    shard = _data.findByShardId(shardId);
+    shard = _getData()->findByShardId(shardId);
 
     // If we found the shard, return it.
     if (shard) {
@@ -132,7 +142,7 @@ StatusWith<shared_ptr<Shard>> ShardRegistry::getShard(OperationContext* opCtx,
     // If we did not perform the reload ourselves (because there was a concurrent reload), force a
     // reload again to ensure that we have seen data at least as up to date as our first reload.
     reload(opCtx);
-    shard = _data.findByShardId(shardId);
+    shard = _getData()->findByShardId(shardId);
 
     if (shard) {
         return shard;
@@ -142,15 +152,15 @@ StatusWith<shared_ptr<Shard>> ShardRegistry::getShard(OperationContext* opCtx,
 }
 
 shared_ptr<Shard> ShardRegistry::getShardNoReload(const ShardId& shardId) {
-    return _data.findByShardId(shardId);
+    return _getData()->findByShardId(shardId);
 }
 
 shared_ptr<Shard> ShardRegistry::getShardForHostNoReload(const HostAndPort& host) {
-    return _data.findByHostAndPort(host);
+    return _getData()->findByHostAndPort(host);
 }
 
 shared_ptr<Shard> ShardRegistry::getConfigShard() const {
-    auto shard = _data.getConfigShard();
+    auto shard = _getData()->getConfigShard();
     invariant(shard);
     return shard;
 }
@@ -160,12 +170,12 @@ unique_ptr<Shard> ShardRegistry::createConnection(const ConnectionString& connSt
 }
 
 shared_ptr<Shard> ShardRegistry::lookupRSName(const string& name) const {
-    return _data.findByRSName(name);
+    return _getData()->findByRSName(name);
 }
 
 void ShardRegistry::getAllShardIdsNoReload(vector<ShardId>* all) const {
     std::set<ShardId> seen;
-    _data.getAllShardIds(seen);
+    _getData()->getAllShardIds(seen);
     all->assign(seen.begin(), seen.end());
 }
 
@@ -185,12 +195,12 @@ void ShardRegistry::getAllShardIds(OperationContext* opCtx, vector<ShardId>* all
 
 int ShardRegistry::getNumShards() const {
     std::set<ShardId> seen;
-    _data.getAllShardIds(seen);
+    _getData()->getAllShardIds(seen);
     return seen.size();
 }
 
 void ShardRegistry::toBSON(BSONObjBuilder* result) const {
-    _data.toBSON(result);
+    _getData()->toBSON(result);
 }
 
 void ShardRegistry::updateReplSetHosts(const ConnectionString& newConnString) {
@@ -199,7 +209,11 @@ void ShardRegistry::updateReplSetHosts(const ConnectionString& newConnString) {
 
     // to prevent update config shard connection string during init
     stdx::unique_lock<stdx::mutex> lock(_reloadMutex);
-    _data.rebuildShardIfExists(newConnString, _shardFactory.get());
+
+    // Build an updated copy of the current snapshot and publish it wholesale.
+    auto newData = std::make_shared<ShardRegistryData>(*_getData());
+    newData->rebuildShardIfExists(newConnString, _shardFactory.get());
+    _setData(std::move(newData));
 }
 
 void ShardRegistry::init() {
@@ -207,7 +221,9 @@ void ShardRegistry::init() {
     invariant(_initConfigServerCS.isValid());
     auto configShard =
         _shardFactory->createShard(ShardRegistry::kConfigServerShardId, _initConfigServerCS);
-    _data.addConfigShard(configShard);
+    auto newData = std::make_shared<ShardRegistryData>(*_getData());
+    newData->addConfigShard(configShard);
+    _setData(std::move(newData));
     // set to invalid so it cant be started more than once.
     _initConfigServerCS = ConnectionString();
 }
@@ -317,17 +333,24 @@ bool ShardRegistry::reload(OperationContext* opCtx) {
         _inReloadCV.notify_all();
     });
 
-    ShardRegistryData currData(opCtx, _shardFactory.get());
-    currData.addConfigShard(_data.getConfigShard());
-    _data.swap(currData);
+    // Build the fresh snapshot from the config server without holding any locks, then swap it in
+    // as the published registry contents. The publish happens under _reloadMutex so that a
+    // concurrent updateReplSetHosts() cannot overwrite this snapshot with a copy of the stale one.
+    auto newData = std::make_shared<ShardRegistryData>(opCtx, _shardFactory.get());
+
+    reloadLock.lock();
+    auto oldData = _getData();
+    newData->addConfigShard(oldData->getConfigShard());
+    _setData(newData);
+    reloadLock.unlock();
 
     // Remove RSMs that are not in the catalog any more.
     std::set<ShardId> removedShardIds;
-    currData.getAllShardIds(removedShardIds);
-    _data.shardIdSetDifference(removedShardIds);
+    oldData->getAllShardIds(removedShardIds);
+    newData->shardIdSetDifference(removedShardIds);
 
     for (auto& shardId : removedShardIds) {
-        auto shard = currData.findByShardId(shardId);
+        auto shard = oldData->findByShardId(shardId);
         invariant(shard);
 
         auto name = shard->getConnString().getSetName();
@@ -412,8 +435,8 @@ ShardRegistryData::ShardRegistryData(OperationContext* opCtx, ShardFactory* shar
            << reloadOpTime.toBSON();
 
     // Ensure targeter exists for all shards and take shard connection string from the targeter.
-    // Do this before re-taking the mutex to avoid deadlock with the ReplicaSetMonitor updating
-    // hosts for a given shard.
+    // Do this before filling in the lookup maps to avoid deadlock with the ReplicaSetMonitor
+    // updating hosts for a given shard.
     std::vector<std::tuple<std::string, ConnectionString>> shardsInfo;
     for (const auto& shardType : shards) {
         // This validation should ideally go inside the ShardType::validate call. However, doing
@@ -436,46 +459,33 @@ ShardRegistryData::ShardRegistryData(OperationContext* opCtx, ShardFactory* shar
         auto shard = shardFactory->createShard(std::move(std::get<0>(shardInfo)),
                                                std::move(std::get<1>(shardInfo)));
 
-        _addShard(WithLock::withoutLock(), std::move(shard), false);
+        _addShard(std::move(shard), false);
     }
 }
 
-void ShardRegistryData::swap(ShardRegistryData& other) {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    _lookup.swap(other._lookup);
-    _rsLookup.swap(other._rsLookup);
-    _hostLookup.swap(other._hostLookup);
-    _configShard.swap(other._configShard);
-}
-
 shared_ptr<Shard> ShardRegistryData::getConfigShard() const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
     return _configShard;
 }
 
 void ShardRegistryData::addConfigShard(std::shared_ptr<Shard> shard) {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
     _configShard = shard;
-    _addShard(lk, shard, true);
+    _addShard(shard, true);
 }
 
 shared_ptr<Shard> ShardRegistryData::findByRSName(const string& name) const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
     auto i = _rsLookup.find(name);
     return (i != _rsLookup.end()) ? i->second : nullptr;
 }
 
 shared_ptr<Shard> ShardRegistryData::findByHostAndPort(const HostAndPort& hostAndPort) const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
     return mapFindWithDefault(_hostLookup, hostAndPort);
 }
 
 shared_ptr<Shard> ShardRegistryData::findByShardId(const ShardId& shardId) const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    return _findByShardId(lk, shardId);
+    return _findByShardId(shardId);
 }
 
-shared_ptr<Shard> ShardRegistryData::_findByShardId(WithLock, ShardId const& shardId) const {
+shared_ptr<Shard> ShardRegistryData::_findByShardId(ShardId const& shardId) const {
     auto i = _lookup.find(shardId);
     return (i != _lookup.end()) ? i->second : nullptr;
 }
@@ -483,12 +493,9 @@ shared_ptr<Shard> ShardRegistryData::_findByShardId(WithLock, ShardId const& sha
 void ShardRegistryData::toBSON(BSONObjBuilder* result) const {
     // Need to copy, then sort by shardId.
     std::vector<std::pair<ShardId, std::string>> shards;
-    {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
-        shards.reserve(_lookup.size());
-        for (auto&& shard : _lookup) {
-            shards.emplace_back(shard.first, shard.second->getConnString().toString());
-        }
+    shards.reserve(_lookup.size());
+    for (auto&& shard : _lookup) {
+        shards.emplace_back(shard.first, shard.second->getConnString().toString());
     }
 
     std::sort(std::begin(shards), std::end(shards));
@@ -500,7 +507,6 @@ void ShardRegistryData::toBSON(BSONObjBuilder* result) const {
 }
 
 void ShardRegistryData::getAllShardIds(std::set<ShardId>& seen) const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
     for (auto i = _lookup.begin(); i != _lookup.end(); ++i) {
         const auto& s = i->second;
         if (s->getId().toString() == "config") {
@@ -511,7 +517,6 @@ void ShardRegistryData::getAllShardIds(std::set<ShardId>& seen) const {
 }
 
 void ShardRegistryData::shardIdSetDifference(std::set<ShardId>& diff) const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
     for (auto i = _lookup.begin(); i != _lookup.end(); ++i) {
         invariant(i->second);
         auto res = diff.find(i->second->getId());
@@ -523,37 +528,33 @@ void ShardRegistryData::shardIdSetDifference(std::set<ShardId>& diff) const {
 
 void ShardRegistryData::rebuildShardIfExists(const ConnectionString& newConnString,
                                              ShardFactory* factory) {
-    stdx::unique_lock<stdx::mutex> updateConnStringLock(_mutex);
     auto it = _rsLookup.find(newConnString.getSetName());
     if (it == _rsLookup.end()) {
         return;
     }
 
-    _rebuildShard(updateConnStringLock, newConnString, factory);
+    _rebuildShard(newConnString, factory);
 }
 
 
-void ShardRegistryData::_rebuildShard(WithLock lk,
-                                      ConnectionString const& newConnString,
+void ShardRegistryData::_rebuildShard(ConnectionString const& newConnString,
                                       ShardFactory* factory) {
     auto it = _rsLookup.find(newConnString.getSetName());
     invariant(it->second);
     auto shard = factory->createShard(it->second->getId(), newConnString);
-    _addShard(lk, shard, true);
+    _addShard(shard, true);
     if (shard->isConfig()) {
         _configShard = shard;
     }
 }
 
-void ShardRegistryData::_addShard(WithLock lk,
-                                  std::shared_ptr<Shard> const& shard,
-                                  bool useOriginalCS) {
+void ShardRegistryData::_addShard(std::shared_ptr<Shard> const& shard, bool useOriginalCS) {
     const ShardId shardId = shard->getId();
 
     const ConnectionString connString =
         useOriginalCS ? shard->originalConnString() : shard->getConnString();
 
-    auto currentShard = _findByShardId(lk, shardId);
+    auto currentShard = _findByShardId(shardId);
     if (currentShard) {
         auto oldConnString = currentShard->originalConnString();
 
@@ -40,7 +40,6 @@
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
-#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -53,6 +52,11 @@ class ShardFactory;
 class Shard;
 class ShardType;
 
+/**
+ * An immutable snapshot of the set of shards known to the registry. The ShardRegistry publishes
+ * the current snapshot through an atomically swapped shared_ptr, so lookups never take a lock.
+ * Instances may only be mutated by the thread which is building them, before they are published.
+ */
 class ShardRegistryData {
 public:
     /**
@@ -62,8 +66,6 @@ public:
     ShardRegistryData() = default;
     ~ShardRegistryData() = default;
 
-    void swap(ShardRegistryData& other);
-
     /**
      * Lookup shard by replica set name. Returns nullptr if the name can't be found.
      */
@@ -85,7 +87,7 @@ public:
     std::shared_ptr<Shard> getConfigShard() const;
 
     /**
-     * Adds config shard.
+     * Adds config shard. May only be called on an unpublished snapshot.
      */
     void addConfigShard(std::shared_ptr<Shard>);
 
@@ -98,7 +100,8 @@ public:
     void toBSON(BSONObjBuilder* result) const;
     /**
      * If the shard with same replica set name as in the newConnString already exists then replace
-     * it with the shard built for the newConnString.
+     * it with the shard built for the newConnString. May only be called on an unpublished
+     * snapshot.
      */
     void rebuildShardIfExists(const ConnectionString& newConnString, ShardFactory* factory);
 
@@ -109,12 +112,9 @@ private:
      * lookup maps. Otherwise the current connection string from the Shard's RemoteCommandTargeter
      * will be used.
      */
-    void _addShard(WithLock, std::shared_ptr<Shard> const&, bool useOriginalCS);
-    auto _findByShardId(WithLock, ShardId const&) const -> std::shared_ptr<Shard>;
-    void _rebuildShard(WithLock, ConnectionString const& newConnString, ShardFactory* factory);
-
-    // Protects the lookup maps below.
-    mutable stdx::mutex _mutex;
+    void _addShard(std::shared_ptr<Shard> const&, bool useOriginalCS);
+    auto _findByShardId(ShardId const&) const -> std::shared_ptr<Shard>;
+    void _rebuildShard(ConnectionString const& newConnString, ShardFactory* factory);
 
     using ShardMap = stdx::unordered_map<ShardId, std::shared_ptr<Shard>, ShardId::Hasher>;
 
@@ -287,9 +287,28 @@ private:
      */
     ConnectionString _initConfigServerCS;
     void _internalReload(const executor::TaskExecutor::CallbackArgs& cbArgs);
-    ShardRegistryData _data;
 
-    // Protects the _reloadState and _initConfigServerCS during startup.
+    /**
+     * Returns the current data snapshot. The snapshot is immutable, so the result may be used
+     * without any locking.
+     */
+    std::shared_ptr<const ShardRegistryData> _getData() const;
+
+    /**
+     * Atomically publishes a new data snapshot. Callers must hold _reloadMutex so that concurrent
+     * writers do not lose each other's updates.
+     */
+    void _setData(std::shared_ptr<const ShardRegistryData> newData);
+
+    /**
+     * The current snapshot of the shard set. Read via std::atomic_load in _getData() and replaced
+     * wholesale via std::atomic_store in _setData(), so routing lookups never serialize on a
+     * mutex. Never null.
+     */
+    std::shared_ptr<const ShardRegistryData> _data;
+
+    // Protects the _reloadState and _initConfigServerCS during startup, and serializes writers
+    // which publish a new _data snapshot.
     mutable stdx::mutex _reloadMutex;
     stdx::condition_variable _inReloadCV;
 
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "mongo/client/fetcher.h"
 #include "mongo/client/read_preference.h"
@@ -51,6 +52,9 @@
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/rpc/metadata/tracking_metadata.h"
 #include "mongo/s/grid.h"
+#include "mongo/transport/baton.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/concurrency/notification.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/time_support.h"
@@ -75,6 +79,64 @@ MONGO_EXPORT_SERVER_PARAMETER(internalProhibitShardOperationRetry,
                               bool,
                               internalProhibitShardOperationRetryByDefault);
 
+MONGO_EXPORT_SERVER_PARAMETER(ShardRemoteUseBaton, bool, true);
+
+// Hedged reads: when a command targeted with a 'nearest' read preference has not been answered
+// within shardRemoteHedgedReadDelayMS, the same command is dispatched to a second eligible
+// member and the first response to arrive wins; the other request is then canceled. The delay
+// should sit around the upper percentiles (roughly p70) of healthy read latency, so that only
+// genuinely slow reads pay the cost of a duplicate dispatch.
+MONGO_EXPORT_SERVER_PARAMETER(shardRemoteHedgedReadsEnabled, bool, true);
+MONGO_EXPORT_SERVER_PARAMETER(shardRemoteHedgedReadDelayMS, int, 25)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "shardRemoteHedgedReadDelayMS must be non-negative");
+        }
+        return Status::OK();
+    });
+
+/**
+ * Attaches an ASIO baton to the operation for the duration of a blocking remote command, so that
+ * the thread waiting on the response runs the command's networking inline instead of paying two
+ * context switches through the task executor's thread pool. If the operation already has a baton
+ * (e.g. it is running under an AsyncRequestsSender), that baton is used without taking ownership.
+ * Shares the baton lifetime caveats of AsyncRequestsSender::BatonDetacher.
+ */
+class ScopedCommandBaton {
+    MONGO_DISALLOW_COPYING(ScopedCommandBaton);
+
+public:
+    explicit ScopedCommandBaton(OperationContext* opCtx) {
+        if (auto baton = opCtx->getBaton()) {
+            _baton = baton;
+            return;
+        }
+
+        if (ShardRemoteUseBaton.load()) {
+            if (auto transportLayer = opCtx->getServiceContext()->getTransportLayer()) {
+                _baton = transportLayer->makeBaton(opCtx);
+                // makeBaton returns nullptr on platforms without baton support
+                _owned = static_cast<bool>(_baton);
+            }
+        }
+    }
+
+    ~ScopedCommandBaton() {
+        if (_owned) {
+            _baton->detach();
+        }
+    }
+
+    const transport::BatonHandle& handle() const {
+        return _baton;
+    }
+
+private:
+    transport::BatonHandle _baton;
+    bool _owned = false;
+};
+
 /**
  * Returns a new BSONObj describing the same command and arguments as 'cmdObj', but with maxTimeMS
  * replaced by maxTimeMSOverride (or removed if maxTimeMSOverride is Milliseconds::max()).
@@ -190,29 +252,151 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
                                                             const string& dbName,
                                                             Milliseconds maxTimeMSOverride,
                                                             const BSONObj& cmdObj) {
-    RemoteCommandResponse response =
-        Status(ErrorCodes::InternalError,
-               str::stream() << "Failed to run remote command request cmd: " << cmdObj);
+    ScopedCommandBaton baton(opCtx);
+
+    // State shared between this thread and the response callbacks. The first response to arrive
+    // wins and sets 'done'; 'allDone' is set once every scheduled request has run its callback,
+    // after which no callback can touch this stack frame anymore.
+    struct SharedState {
+        explicit SharedState(RemoteCommandResponse initialResponse)
+            : response(std::move(initialResponse)) {}
+
+        stdx::mutex mutex;
+        RemoteCommandResponse response;
+        boost::optional<HostAndPort> winner;
+        size_t scheduled = 0;
+        size_t callbacksRun = 0;
+    } state{Status(ErrorCodes::InternalError,
+                   str::stream() << "Failed to run remote command request cmd: " << cmdObj)};
+
+    Notification<void> done;
+    Notification<void> allDone;
+
+    const auto callback = [&state, &done, &allDone](const RemoteCommandCallbackArgs& args) {
+        stdx::lock_guard<stdx::mutex> lk(state.mutex);
+        ++state.callbacksRun;
+        if (!state.winner) {
+            state.winner = args.request.target;
+            state.response = args.response;
+            done.set();
+        }
+        if (state.callbacksRun == state.scheduled) {
+            allDone.set();
+        }
+    };
 
+    std::vector<AsyncCmdHandle> asyncHandles;
+
+    state.scheduled = 1;
     auto asyncStatus = _scheduleCommand(
-        opCtx,
-        readPref,
-        dbName,
-        maxTimeMSOverride,
-        cmdObj,
-        [&response](const RemoteCommandCallbackArgs& args) { response = args.response; });
+        opCtx, readPref, dbName, maxTimeMSOverride, cmdObj, callback, baton.handle());
 
     if (!asyncStatus.isOK()) {
         return asyncStatus.getStatus();
     }
 
-    auto asyncHandle = asyncStatus.getValue();
+    asyncHandles.push_back(std::move(asyncStatus.getValue()));
 
-    // Block until the command is carried out
     auto executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
-    executor->wait(asyncHandle.handle);
 
-    const auto& host = asyncHandle.hostTargetted;
+    const auto cancelAllAndJoin = [&] {
+        for (const auto& asyncHandle : asyncHandles) {
+            executor->cancel(asyncHandle.handle);
+        }
+        // Wait for every callback to run without checking for interrupts, since the callbacks
+        // write to state on this stack.
+        opCtx->runWithoutInterruption([&] { allDone.get(opCtx); });
+    };
+
+    // Block until the first command response is available. If a baton is attached to the
+    // operation, this runs the command's networking inline on this thread.
+    try {
+        // For 'nearest' reads, give the targeted member a head start of the hedge delay; if it
+        // has not answered by then, dispatch the same command to a second eligible member and
+        // take whichever response arrives first.
+        if (shardRemoteHedgedReadsEnabled.load() && readPref.pref == ReadPreference::Nearest &&
+            !opCtx->getTxnNumber()) {
+            const Milliseconds hedgeDelay{shardRemoteHedgedReadDelayMS.load()};
+            if (!done.waitFor(opCtx, hedgeDelay)) {
+                ReadPreferenceSetting readPrefWithMinOpTime(readPref);
+                if (isConfig()) {
+                    readPrefWithMinOpTime.minOpTime = Grid::get(opCtx)->configOpTime();
+                }
+
+                // The targeter hands out one host at a time; for 'nearest' it picks randomly
+                // among the members within the latency window, so a few no-wait attempts are
+                // usually enough to find a distinct second candidate. If the set has no other
+                // eligible member, skip the hedge.
+                boost::optional<HostAndPort> hedgeHost;
+                for (int attempt = 0; attempt < 3 && !hedgeHost; ++attempt) {
+                    auto swHost = _targeter->findHostNoWait(readPrefWithMinOpTime);
+                    if (!swHost.isOK()) {
+                        break;
+                    }
+                    if (swHost.getValue() != asyncHandles.front().hostTargetted) {
+                        hedgeHost = std::move(swHost.getValue());
+                    }
+                }
+
+                bool scheduleHedge = false;
+                if (hedgeHost) {
+                    stdx::lock_guard<stdx::mutex> lk(state.mutex);
+                    // Only hedge while the original request is still unanswered; this also
+                    // guarantees that 'allDone' cannot have been set yet.
+                    if (!state.winner) {
+                        ++state.scheduled;
+                        scheduleHedge = true;
+                    }
+                }
+
+                if (scheduleHedge) {
+                    auto swHedgeHandle = _scheduleCommandToHost(opCtx,
+                                                                *hedgeHost,
+                                                                readPrefWithMinOpTime,
+                                                                dbName,
+                                                                maxTimeMSOverride,
+                                                                cmdObj,
+                                                                callback,
+                                                                baton.handle());
+                    if (swHedgeHandle.isOK()) {
+                        LOG(2) << "Hedging slow read against " << getId()
+                               << " with second dispatch to " << *hedgeHost;
+
+                        AsyncCmdHandle hedgeHandle;
+                        hedgeHandle.hostTargetted = *hedgeHost;
+                        hedgeHandle.handle = std::move(swHedgeHandle.getValue());
+                        asyncHandles.push_back(std::move(hedgeHandle));
+                    } else {
+                        // The hedge is best-effort. Put the count back, and complete 'allDone'
+                        // ourselves if the original request's callback ran meanwhile and was
+                        // left waiting on the hedge.
+                        stdx::lock_guard<stdx::mutex> lk(state.mutex);
+                        --state.scheduled;
+                        if (state.callbacksRun == state.scheduled) {
+                            allDone.set();
+                        }
+                    }
+                }
+            }
+        }
+
+        done.get(opCtx);
+    } catch (const DBException& ex) {
+        // If the operation is interrupted, cancel the outstanding requests and wait for the
+        // (canceled) callbacks to run, since they write to state on this stack.
+        cancelAllAndJoin();
+
+        updateReplSetMonitor(asyncHandles.front().hostTargetted, ex.toStatus());
+        return ex.toStatus();
+    }
+
+    // Cancel the losing hedged request, if any, and wait until no callback can reference local
+    // state. Canceling an already-finished request is a no-op, and the canceled response is not
+    // reported to the replica set monitor.
+    cancelAllAndJoin();
+
+    const auto host = *state.winner;
+    const auto& response = state.response;
     updateReplSetMonitor(host, response.status);
 
     if (!response.status.isOK()) {
@@ -397,7 +581,8 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
     const std::string& dbName,
     Milliseconds maxTimeMSOverride,
     const BSONObj& cmdObj,
-    const TaskExecutor::RemoteCommandCallbackFn& cb) {
+    const TaskExecutor::RemoteCommandCallbackFn& cb,
+    const transport::BatonHandle& baton) {
     ReadPreferenceSetting readPrefWithMinOpTime(readPref);
 
     if (isConfig()) {
@@ -412,11 +597,37 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
     AsyncCmdHandle asyncHandle;
     asyncHandle.hostTargetted = std::move(swHost.getValue());
 
+    auto swHandle = _scheduleCommandToHost(opCtx,
+                                           asyncHandle.hostTargetted,
+                                           readPrefWithMinOpTime,
+                                           dbName,
+                                           maxTimeMSOverride,
+                                           cmdObj,
+                                           cb,
+                                           baton);
+
+    if (!swHandle.isOK()) {
+        return swHandle.getStatus();
+    }
+
+    asyncHandle.handle = std::move(swHandle.getValue());
+    return asyncHandle;
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardRemote::_scheduleCommandToHost(
+    OperationContext* opCtx,
+    const HostAndPort& host,
+    const ReadPreferenceSetting& readPrefWithMinOpTime,
+    const std::string& dbName,
+    Milliseconds maxTimeMSOverride,
+    const BSONObj& cmdObj,
+    const TaskExecutor::RemoteCommandCallbackFn& cb,
+    const transport::BatonHandle& baton) {
     const Milliseconds requestTimeout =
         std::min(opCtx->getRemainingMaxTimeMillis(), maxTimeMSOverride);
 
     const RemoteCommandRequest request(
-        asyncHandle.hostTargetted,
+        host,
         dbName,
         appendMaxTimeToCmdObj(requestTimeout, cmdObj),
         _appendMetadataForCommand(opCtx, readPrefWithMinOpTime),
@@ -424,14 +635,7 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
         requestTimeout < Milliseconds::max() ? requestTimeout : RemoteCommandRequest::kNoTimeout);
 
     auto executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
-    auto swHandle = executor->scheduleRemoteCommand(request, cb);
-
-    if (!swHandle.isOK()) {
-        return swHandle.getStatus();
-    }
-
-    asyncHandle.handle = std::move(swHandle.getValue());
-    return asyncHandle;
+    return executor->scheduleRemoteCommand(request, cb, baton);
 }
 
 }  // namespace mongo
@@ -127,7 +127,24 @@ private:
         const std::string& dbName,
         Milliseconds maxTimeMSOverride,
         const BSONObj& cmdObj,
-        const executor::TaskExecutor::RemoteCommandCallbackFn& cb);
+        const executor::TaskExecutor::RemoteCommandCallbackFn& cb,
+        const transport::BatonHandle& baton = nullptr);
+
+    /**
+     * Schedules 'cmdObj' directly against 'host', bypassing targeting. 'readPrefWithMinOpTime'
+     * must already carry the config opTime when this shard is the config server. Used by
+     * _scheduleCommand once it has resolved a host, and to dispatch hedged reads to an
+     * alternate member.
+     */
+    StatusWith<executor::TaskExecutor::CallbackHandle> _scheduleCommandToHost(
+        OperationContext* opCtx,
+        const HostAndPort& host,
+        const ReadPreferenceSetting& readPrefWithMinOpTime,
+        const std::string& dbName,
+        Milliseconds maxTimeMSOverride,
+        const BSONObj& cmdObj,
+        const executor::TaskExecutor::RemoteCommandCallbackFn& cb,
+        const transport::BatonHandle& baton);
 
     /**
      * Protects _lastCommittedOpTime.
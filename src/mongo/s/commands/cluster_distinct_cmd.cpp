@@ -30,7 +30,7 @@
 
 #include "mongo/platform/basic.h"
 
-#include "mongo/bson/bsonobj_comparator.h"
+#include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/parsed_distinct.h"
@@ -208,13 +208,17 @@ public:
             return true;
         }
 
-        BSONObjComparator bsonCmp(
-            BSONObj(),
-            BSONObjComparator::FieldNamesMode::kConsider,
+        BSONElementComparator eltCmp(
+            BSONElementComparator::FieldNamesMode::kIgnore,
             !collation.isEmpty()
                 ? collator.get()
                 : (routingInfo.cm() ? routingInfo.cm()->getDefaultCollator() : nullptr));
-        BSONObjSet all = bsonCmp.makeBSONObjSet();
+        auto all = eltCmp.makeBSONEltSet();
+
+        // Each shard already returns its deduped set of values, so the merge just has to take the
+        // union. The set holds elements referencing the shards' response buffers, which stay alive
+        // in 'shardResponses' until the merged array has been built below.
+        int valuesSize = 0;
 
         for (const auto& response : shardResponses) {
             auto status = response.swResponse.isOK()
@@ -222,20 +226,23 @@ public:
                 : response.swResponse.getStatus();
             uassertStatusOK(status);
 
-            BSONObj res = std::move(response.swResponse.getValue().data);
+            const auto& res = response.swResponse.getValue().data;
             BSONObjIterator it(res["values"].embeddedObject());
             while (it.more()) {
                 BSONElement nxt = it.next();
-                BSONObjBuilder temp(32);
-                temp.appendAs(nxt, "");
-                all.insert(temp.obj());
+                if (all.insert(nxt).second) {
+                    valuesSize += nxt.size();
+                    uassert(51471,
+                            "distinct too big, 16mb cap",
+                            valuesSize + 1024 < BSONObjMaxUserSize);
+                }
             }
         }
 
         BSONObjBuilder b(32);
         int n = 0;
-        for (auto&& obj : all) {
-            b.appendAs(obj.firstElement(), b.numStr(n++));
+        for (auto&& elt : all) {
+            b.appendAs(elt, b.numStr(n++));
         }
 
         result.appendArray("values", b.obj());
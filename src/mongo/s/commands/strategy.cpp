@@ -53,7 +53,6 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_time_tracker.h"
 #include "mongo/db/ops/write_ops.h"
-#include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/db/stats/counters.h"
@@ -699,21 +698,20 @@ DbResponse Strategy::getMore(OperationContext* opCtx, const NamespaceString& nss
     }
     uassertStatusOK(cursorResponse.getStatus());
 
-    // Build the response document.
-    BufBuilder buffer(FindCommon::kInitReplyBufferSize);
-
+    // Build the response document directly into the reply message, rather than staging the batch
+    // in a separate buffer and paying a copy of the entire batch into the reply.
     int numResults = 0;
+    OpQueryReplyBuilder reply;
     for (const auto& obj : cursorResponse.getValue().getBatch()) {
-        buffer.appendBuf((void*)obj.objdata(), obj.objsize());
+        obj.appendSelfToBufBuilder(reply.bufBuilderForResults());
         ++numResults;
     }
 
-    return replyToQuery(0,
-                        buffer.buf(),
-                        buffer.len(),
-                        numResults,
-                        cursorResponse.getValue().getNumReturnedSoFar().value_or(0),
-                        cursorResponse.getValue().getCursorId());
+    return DbResponse{
+        reply.toQueryReply(0,  // query result flags
+                           numResults,
+                           cursorResponse.getValue().getNumReturnedSoFar().value_or(0),
+                           cursorResponse.getValue().getCursorId())};
 }
 
 void Strategy::killCursors(OperationContext* opCtx, DbMessage* dbm) {
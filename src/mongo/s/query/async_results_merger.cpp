@@ -32,6 +32,8 @@
 
 #include "mongo/s/query/async_results_merger.h"
 
+#include <algorithm>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/client/remote_command_targeter.h"
 #include "mongo/db/pipeline/change_stream_constants.h"
@@ -53,6 +55,10 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// How often the estimate of the client's consumption rate is refreshed. Documents returned since
+// the last refresh are folded into the smoothed rate once this much time has passed.
+const Milliseconds kConsumptionRateWindow{100};
+
 /**
  * Returns the sort key out of the $sortKey metadata field in 'obj'. This object is of the form
  * {'': 'firstSortKey', '': 'secondSortKey', ...}.
@@ -276,7 +282,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -293,16 +299,25 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
 
+    _updateConsumptionRate(lk);
+
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
     if (!_remotes[smallestRemote].docBuffer.empty()) {
         _mergeQueue.push(smallestRemote);
+        _prefetchIfRunningLow(lk, smallestRemote);
+    } else if (_tailableMode == TailableModeEnum::kNormal) {
+        // We have just drained this remote's buffer. A sorted merge cannot return any further
+        // results until every non-exhausted remote has a buffered result again, so get the next
+        // batch in flight right away rather than waiting for the merger to block in nextEvent().
+        // This overlaps the fetch with the consumption of the other remotes' buffered results.
+        _eagerlyScheduleGetMoreIfDrained(lk, smallestRemote);
     }
 
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
@@ -312,12 +327,16 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
             ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
             _remotes[_gettingFromRemote].docBuffer.pop();
 
+            _updateConsumptionRate(lk);
+
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
                 // The cursor is tailable and we're about to return the last buffered result. This
                 // means that the next value returned should be boost::none to indicate the end of
                 // the batch.
                 _eofNext = true;
+            } else {
+                _prefetchIfRunningLow(lk, _gettingFromRemote);
             }
 
             return front;
@@ -389,9 +408,79 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.lastRequestSentAt = _executor->now();
     return Status::OK();
 }
 
+void AsyncResultsMerger::_eagerlyScheduleGetMoreIfDrained(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    // Do nothing unless this remote's buffer has been fully drained and more results must be
+    // fetched for it. Be careful only to schedule work when '_opCtx' is non-null, since it is
+    // illegal to schedule a remote command on a user's behalf without a non-null OperationContext.
+    if (remote.hasNext() || remote.exhausted() || remote.cbHandle.isValid() ||
+        !remote.status.isOK() || _lifecycleState != kAlive || !_opCtx) {
+        return;
+    }
+
+    remote.status = _askForNextBatch(lk, remoteIndex);
+}
+
+void AsyncResultsMerger::_updateConsumptionRate(WithLock) {
+    const auto now = _executor->now();
+    if (_consumptionMark == Date_t()) {
+        _consumptionMark = now;
+    }
+    ++_docsConsumedSinceMark;
+
+    const auto elapsed = now - _consumptionMark;
+    if (elapsed < kConsumptionRateWindow) {
+        return;
+    }
+
+    const double windowRate = static_cast<double>(_docsConsumedSinceMark) /
+        durationCount<Milliseconds>(elapsed);
+    _consumptionRateDocsPerMs = _consumptionRateDocsPerMs == 0.0
+        ? windowRate
+        : (_consumptionRateDocsPerMs + windowRate) / 2;
+    _consumptionMark = now;
+    _docsConsumedSinceMark = 0;
+}
+
+void AsyncResultsMerger::_prefetchIfRunningLow(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    // The drained-buffer case is handled by _eagerlyScheduleGetMoreIfDrained(); here we only
+    // consider remotes that still have buffered results. Tailable cursors pass remote batches
+    // through to the client as-is, so we never fetch ahead for them. As elsewhere, scheduling a
+    // remote command requires a non-null '_opCtx'.
+    if (!remote.hasNext() || remote.exhausted() || remote.cbHandle.isValid() ||
+        !remote.status.isOK() || _lifecycleState != kAlive || !_opCtx ||
+        _tailableMode != TailableModeEnum::kNormal) {
+        return;
+    }
+
+    if (_consumptionRateDocsPerMs == 0.0 || remote.smoothedBatchLatency == Milliseconds::zero()) {
+        return;
+    }
+
+    // Estimate how many documents the client will consume while a getMore to this remote is in
+    // flight. If the remaining buffer is no larger than that, the buffer would run dry before a
+    // batch requested at drain time could arrive, so issue the getMore now. The estimate is
+    // capped at the size of the remote's last batch, which bounds the extra buffering to roughly
+    // one batch ahead of need.
+    double docsPerRoundTrip =
+        _consumptionRateDocsPerMs * durationCount<Milliseconds>(remote.smoothedBatchLatency);
+    if (remote.lastBatchNumReceived > 0) {
+        docsPerRoundTrip = std::min(docsPerRoundTrip,
+                                    static_cast<double>(remote.lastBatchNumReceived));
+    }
+
+    if (static_cast<double>(remote.docBuffer.size()) <= docsPerRoundTrip) {
+        remote.status = _askForNextBatch(lk, remoteIndex);
+    }
+}
+
 Status AsyncResultsMerger::scheduleGetMores() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     return _scheduleGetMores(lk);
@@ -596,6 +685,16 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
     // Update the cursorId; it is sent as '0' when the cursor has been exhausted on the shard.
     remote.cursorId = cursorResponse.getCursorId();
 
+    // Fold this batch's round-trip time into the remote's smoothed latency estimate, and remember
+    // the batch size. Both feed the decision of when to prefetch the remote's next batch.
+    if (remote.lastRequestSentAt != Date_t()) {
+        const Milliseconds latency = _executor->now() - remote.lastRequestSentAt;
+        remote.smoothedBatchLatency = remote.smoothedBatchLatency == Milliseconds::zero()
+            ? latency
+            : (remote.smoothedBatchLatency + latency) / 2;
+    }
+    remote.lastBatchNumReceived = static_cast<long long>(cursorResponse.getBatch().size());
+
     // Save the batch in the remote's buffer.
     if (!_addBatchToBuffer(lk, remoteIndex, cursorResponse)) {
         return;
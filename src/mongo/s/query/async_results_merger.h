@@ -293,6 +293,16 @@ private:
         // Count of fetched docs during ARM processing of the current batch. Used to reduce the
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
+
+        // Time at which the most recent batch request for this remote was sent. Used to measure
+        // the round-trip latency of a batch fetch.
+        Date_t lastRequestSentAt;
+
+        // Smoothed estimate of this remote's batch fetch round-trip latency.
+        Milliseconds smoothedBatchLatency{0};
+
+        // Number of documents in the most recent batch received from this remote.
+        long long lastBatchNumReceived = 0;
     };
 
     class MergingComparator {
@@ -335,6 +345,34 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * Eagerly schedules a getMore for the given remote if its buffer has just been drained and it
+     * is not exhausted, so that the next batch is already in flight while buffered results from
+     * the other remotes are being consumed. Without this, the getMore would only be scheduled once
+     * the merger blocks in nextEvent(), adding a full network round trip to the merged stream at
+     * every batch boundary.
+     *
+     * Any error scheduling the getMore is stored as the remote's status.
+     */
+    void _eagerlyScheduleGetMoreIfDrained(WithLock, size_t remoteIndex);
+
+    /**
+     * Folds the document just returned from nextReady() into the estimate of how quickly the
+     * client is consuming results, in documents per millisecond.
+     */
+    void _updateConsumptionRate(WithLock);
+
+    /**
+     * Schedules a getMore for the given remote if its remaining buffered results are expected to
+     * be consumed before a new batch could arrive, given the client's consumption rate and the
+     * remote's observed batch round-trip latency. This keeps the next batch in flight ahead of
+     * need, so the merged stream does not stall on a slow remote at every batch boundary. At most
+     * one getMore per remote is in flight at a time, bounding the extra buffering to one batch.
+     *
+     * Any error scheduling the getMore is stored as the remote's status.
+     */
+    void _prefetchIfRunningLow(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
@@ -446,6 +484,13 @@ private:
     // boost::none.
     bool _eofNext = false;
 
+    // State for estimating how quickly the client consumes results, used to decide when to
+    // prefetch the next batch from a remote. Documents returned since '_consumptionMark' are
+    // counted and periodically folded into the smoothed rate.
+    Date_t _consumptionMark;
+    long long _docsConsumedSinceMark = 0;
+    double _consumptionRateDocsPerMs = 0.0;
+
     boost::optional<Milliseconds> _awaitDataTimeout;
 
     //
@@ -273,6 +273,67 @@ TEST_F(AsyncResultsMergerTest, MultiShardSorted) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeSchedulesGetMoreAsSoonAsRemoteBufferIsDrained) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Schedule requests.
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    // The first shard responds with an open cursor, the second shard is exhausted.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}"),
+                                   fromjson("{$sortKey: {'': 2}}")};
+    responses.emplace_back(kTestNss, CursorId(5), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 3}}"),
+                                   fromjson("{$sortKey: {'': 4}}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    // The merged stream returns the first shard's results and thereby drains its buffer.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The sorted merge is now blocked on the first shard, and the getMore for its next batch must
+    // already be in flight, even though the merger has not yet blocked in nextEvent().
+    ASSERT_FALSE(arm->ready());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_EQ(getNthPendingRequest(0u).cmdObj["getMore"].numberLong(), 5LL);
+
+    readyEvent = unittest::assertGet(arm->nextEvent());
+
+    responses.clear();
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: {'': 5}}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    // The remainder of the results is returned in sorted order.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 3}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 4}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 5}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, MultiShardMultipleGets) {
     std::vector<RemoteCursor> cursors;
     cursors.push_back(
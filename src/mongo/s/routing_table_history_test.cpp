@@ -92,17 +92,15 @@ std::set<ChunkInfo*> getChunksInRange(std::shared_ptr<RoutingTableHistory> rt,
     std::transform(chunksFromSplitIter.first,
                    chunksFromSplitIter.second,
                    std::inserter(chunksFromSplit, chunksFromSplit.begin()),
-                   [](const std::pair<std::string, std::shared_ptr<ChunkInfo>>& pair) {
-                       return pair.second.get();
-                   });
+                   [](const ChunkInfoMap::value_type& pair) { return pair.second.get(); });
     return chunksFromSplit;
 }
 
 // Looks up a chunk that corresponds to or contains the range [min, max). There
 // should only be one such chunk in the input RoutingTableHistory object.
-std::shared_ptr<ChunkInfo> getChunkToSplit(std::shared_ptr<RoutingTableHistory> rt,
-                                           const BSONObj& min,
-                                           const BSONObj& max) {
+ChunkInfoPtr getChunkToSplit(std::shared_ptr<RoutingTableHistory> rt,
+                             const BSONObj& min,
+                             const BSONObj& max) {
     auto chunkToSplitIter = rt->overlappingRanges(min, max, false);
     invariant(std::distance(chunkToSplitIter.first, chunkToSplitIter.second) <= 1);
     invariant(chunkToSplitIter.first != rt->getChunkMap().end());
@@ -317,5 +315,68 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+TEST(RoutingTableHistoryShardVersions, MovingTheLastChunkOffAShardRemovesItsShardVersion) {
+    const OID epoch = OID::gen();
+    const KeyPattern shardKeyPattern(BSON("a" << 1));
+    const ShardId shard0("shard0");
+    const ShardId shard1("shard1");
+
+    std::vector<ChunkType> initialChunks = {
+        ChunkType{kNss,
+                  ChunkRange{shardKeyPattern.globalMin(), BSON("a" << 10)},
+                  ChunkVersion{1, 0, epoch},
+                  shard0},
+        ChunkType{kNss,
+                  ChunkRange{BSON("a" << 10), shardKeyPattern.globalMax()},
+                  ChunkVersion{1, 1, epoch},
+                  shard1}};
+
+    auto rt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, initialChunks);
+    ASSERT_EQ(ChunkVersion(1, 0, epoch), rt->getVersion(shard0));
+    ASSERT_EQ(ChunkVersion(1, 1, epoch), rt->getVersion(shard1));
+
+    // Migrate the only chunk off of shard0 and onto shard1.
+    auto newRt = rt->makeUpdated({ChunkType{kNss,
+                                            ChunkRange{shardKeyPattern.globalMin(), BSON("a" << 10)},
+                                            ChunkVersion{2, 0, epoch},
+                                            shard1}});
+    ASSERT_EQ(ChunkVersion(2, 0, epoch), newRt->getVersion(shard1));
+
+    // The donor no longer owns any chunks, so it must report the unset shard version.
+    ASSERT_EQ(ChunkVersion(0, 0, epoch), newRt->getVersion(shard0));
+
+    std::set<ShardId> shardIds;
+    newRt->getAllShardIds(&shardIds);
+    ASSERT_EQ(1u, shardIds.size());
+    ASSERT_EQ(1u, shardIds.count(shard1));
+}
+
+TEST(RoutingTableHistoryShardVersions, UpdateWithOverlappingLeftoverChunkThrows) {
+    const OID epoch = OID::gen();
+    const KeyPattern shardKeyPattern(BSON("a" << 1));
+    const ShardId shard0("shard0");
+    const ShardId shard1("shard1");
+
+    std::vector<ChunkType> initialChunks = {
+        ChunkType{kNss,
+                  ChunkRange{shardKeyPattern.globalMin(), shardKeyPattern.globalMax()},
+                  ChunkVersion{1, 0, epoch},
+                  shard0}};
+
+    auto rt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, initialChunks);
+
+    // A torn set of changed chunks that contains only the first half of a split leaves the
+    // original chunk overlapping the new one, which must be detected.
+    ASSERT_THROWS_CODE(
+        rt->makeUpdated({ChunkType{kNss,
+                                   ChunkRange{shardKeyPattern.globalMin(), BSON("a" << 10)},
+                                   ChunkVersion{2, 0, epoch},
+                                   shard1}}),
+        AssertionException,
+        ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/client/connpool.h"
 #include "mongo/client/dbclient_rs.h"
 #include "mongo/client/global_conn_pool.h"
+#include "mongo/client/read_preference.h"
 #include "mongo/client/remote_command_targeter.h"
 #include "mongo/client/remote_command_targeter_factory_impl.h"
 #include "mongo/client/replica_set_monitor.h"
@@ -57,8 +58,10 @@
 #include "mongo/db/logical_session_cache_factory_mongos.h"
 #include "mongo/db/logical_time_metadata_hook.h"
 #include "mongo/db/logical_time_validator.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/session_killer.h"
 #include "mongo/db/startup_warnings_common.h"
@@ -66,6 +69,7 @@
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/platform/process_id.h"
 #include "mongo/rpc/metadata/egress_metadata_hook_list.h"
+#include "mongo/s/async_requests_sender.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/shard_connection.h"
@@ -97,6 +101,7 @@
 #include "mongo/util/exception_filter_win32.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fast_clock_source_factory.h"
+#include "mongo/util/tsc_clock_source.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/net/socket_utils.h"
@@ -130,8 +135,88 @@ const ntservice::NtServiceDefaultStrings defaultServiceStrings = {
 
 constexpr auto kSignKeysRetryInterval = Seconds{1};
 
+// The number of connections to pre-establish to every shard before mongos starts accepting client
+// traffic. Zero or less disables connection warmup.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(warmupConnectionsPerShard, int, 0);
+
+// Comma-separated list of namespaces whose routing tables should be loaded into the catalog cache
+// before mongos starts accepting client traffic.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(warmupNamespaces, std::string, "");
+
 boost::optional<ShardingUptimeReporter> shardingUptimeReporter;
 
+/**
+ * Best-effort warmup phase, which runs after the sharding state has been initialized, but before
+ * client traffic is accepted. Pre-establishes a floor of connections to every shard and loads the
+ * routing tables for the configured set of hot namespaces so that the first operations after a
+ * restart do not pay for connection establishment and routing table refreshes. Failures are logged
+ * and otherwise ignored, because the regular request paths recover from missing connections and
+ * routing information on their own.
+ */
+void warmUpShardConnectionsAndRoutingTables(OperationContext* opCtx) try {
+    const int connectionsPerShard = warmupConnectionsPerShard;
+
+    if (connectionsPerShard > 0) {
+        std::vector<ShardId> shardIds;
+        Grid::get(opCtx)->shardRegistry()->getAllShardIds(opCtx, &shardIds);
+
+        std::vector<AsyncRequestsSender::Request> requests;
+        for (const auto& shardId : shardIds) {
+            requests.emplace_back(shardId, BSON("ping" << 1));
+        }
+
+        log() << "Pre-establishing " << connectionsPerShard << " connection(s) to each of "
+              << shardIds.size() << " shard(s)";
+
+        // Each AsyncRequestsSender keeps at most one command in flight per shard and every
+        // in-flight command occupies a pooled connection, so running 'connectionsPerShard'
+        // senders concurrently establishes the requested floor of connections in parallel.
+        std::vector<std::unique_ptr<AsyncRequestsSender>> senders;
+        for (int i = 0; i < connectionsPerShard; i++) {
+            senders.push_back(stdx::make_unique<AsyncRequestsSender>(
+                opCtx,
+                Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                "admin",
+                requests,
+                ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+                Shard::RetryPolicy::kNoRetry));
+        }
+
+        for (auto&& sender : senders) {
+            while (!sender->done()) {
+                auto response = sender->next();
+                if (!response.swResponse.isOK()) {
+                    warning() << "Failed to warm up a connection to shard " << response.shardId
+                              << causedBy(redact(response.swResponse.getStatus()));
+                }
+            }
+        }
+    }
+
+    if (!warmupNamespaces.empty()) {
+        std::vector<std::string> nsStrings;
+        splitStringDelim(warmupNamespaces, &nsStrings, ',');
+
+        for (const auto& nsString : nsStrings) {
+            const NamespaceString nss(nsString);
+            if (!nss.isValid()) {
+                warning() << "Not loading the routing table for invalid warmup namespace \""
+                          << nsString << "\"";
+                continue;
+            }
+
+            auto routingInfoStatus =
+                Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(opCtx, nss);
+            if (!routingInfoStatus.isOK()) {
+                warning() << "Failed to load the routing table for warmup namespace " << nss.ns()
+                          << causedBy(redact(routingInfoStatus.getStatus()));
+            }
+        }
+    }
+} catch (const DBException& ex) {
+    warning() << "Startup warmup phase failed" << causedBy(redact(ex.toStatus()));
+}
+
 Status waitForSigningKeys(OperationContext* opCtx) {
     auto const shardRegistry = Grid::get(opCtx)->shardRegistry();
 
@@ -406,6 +491,8 @@ ExitCode runMongosServer(ServiceContext* serviceContext) {
             .transitional_ignore();
     }
 
+    warmUpShardConnectionsAndRoutingTables(opCtx.get());
+
     startMongoSFTDC();
 
     Status status = AuthorizationManager::get(serviceContext)->initialize(NULL);
@@ -499,6 +586,10 @@ std::unique_ptr<AuthzManagerExternalState> createAuthzManagerExternalStateMongos
 
 ExitCode main(ServiceContext* serviceContext) {
     serviceContext->setFastClockSource(FastClockSourceFactory::create(Milliseconds{10}));
+    if (auto tscClock = TSCClockSource::makeIfSupported()) {
+        // Precise reads off the invariant TSC avoid a system call per Date_t::now().
+        serviceContext->setPreciseClockSource(std::move(tscClock));
+    }
 
     auto const shardingContext = Grid::get(serviceContext);
 
@@ -30,6 +30,7 @@
 
 #include "mongo/s/shard_key_pattern.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/db/field_ref.h"
@@ -132,6 +133,26 @@ BSONElement extractKeyElementFromMatchable(const MatchableDocument& matchable, S
     return matchEl;
 }
 
+/**
+ * Extracts the element at 'path' from 'doc' without ever traversing arrays: descending is only
+ * possible through embedded objects, so an array or scalar anywhere before the final path part
+ * yields no element. This mirrors what extractKeyElementFromMatchable returns for a
+ * BSONMatchableDocument over 'doc', but without setting up the matching machinery per document.
+ */
+BSONElement extractElementAtPathNoArrayTraversal(const BSONObj& doc, const FieldRef& path) {
+    BSONObj current = doc;
+    const size_t numParts = path.numParts();
+
+    for (size_t i = 0; i + 1 < numParts; ++i) {
+        const BSONElement el = current.getField(path.getPart(i));
+        if (el.type() != Object)
+            return BSONElement();
+        current = el.Obj();
+    }
+
+    return current.getField(path.getPart(numParts - 1));
+}
+
 BSONElement findEqualityElement(const EqualityMatches& equalities, const FieldRef& path) {
     int parentPathPart;
     const BSONElement parentEl =
@@ -179,6 +200,11 @@ Status ShardKeyPattern::checkShardKeyIsValidForMetadataStorage(const BSONObj& sh
 ShardKeyPattern::ShardKeyPattern(const BSONObj& keyPattern)
     : _keyPattern(keyPattern),
       _keyPatternPaths(parseShardKeyPattern(keyPattern)),
+      _isHashedPattern(isHashedPatternEl(keyPattern.firstElement())),
+      _allPathsSingleSegment(
+          std::all_of(_keyPatternPaths.begin(),
+                      _keyPatternPaths.end(),
+                      [](const auto& path) { return path->numParts() == 1u; })),
       _hasId(keyPattern.hasField("_id"_sd)) {}
 
 ShardKeyPattern::ShardKeyPattern(const KeyPattern& keyPattern)
@@ -189,7 +215,7 @@ bool ShardKeyPattern::isHashedPatternEl(const BSONElement& el) {
 }
 
 bool ShardKeyPattern::isHashedPattern() const {
-    return isHashedPatternEl(_keyPattern.toBSON().firstElement());
+    return _isHashedPattern;
 }
 
 const KeyPattern& ShardKeyPattern::getKeyPattern() const {
@@ -271,8 +297,54 @@ BSONObj ShardKeyPattern::extractShardKeyFromMatchable(const MatchableDocument& m
 }
 
 BSONObj ShardKeyPattern::extractShardKeyFromDoc(const BSONObj& doc) const {
-    BSONMatchableDocument matchable(doc);
-    return extractShardKeyFromMatchable(matchable);
+    // The pattern paths are parsed and classified once per collection, so extraction probes the
+    // document directly rather than building a MatchableDocument and re-resolving every pattern
+    // path for every document.
+    const size_t numFields = _keyPatternPaths.size();
+
+    std::vector<BSONElement> keyElements(numFields);
+
+    if (_allPathsSingleSegment) {
+        // All key fields are top-level, so a single walk over the document locates them all
+        size_t numFound = 0;
+        for (const auto& el : doc) {
+            const auto fieldName = el.fieldNameStringData();
+            for (size_t i = 0; i < numFields; ++i) {
+                if (keyElements[i].eoo() && _keyPatternPaths[i]->dottedField() == fieldName) {
+                    keyElements[i] = el;
+                    ++numFound;
+                    break;
+                }
+            }
+            if (numFound == numFields)
+                break;
+        }
+    } else {
+        for (size_t i = 0; i < numFields; ++i) {
+            keyElements[i] = extractElementAtPathNoArrayTraversal(doc, *_keyPatternPaths[i]);
+        }
+    }
+
+    BSONObjBuilder keyBuilder;
+    for (size_t i = 0; i < numFields; ++i) {
+        const BSONElement& keyEl = keyElements[i];
+
+        if (!isValidShardKeyElement(keyEl))
+            return BSONObj();
+
+        if (_isHashedPattern) {
+            keyBuilder.append(
+                _keyPatternPaths[i]->dottedField(),
+                BSONElementHasher::hash64(keyEl, BSONElementHasher::DEFAULT_HASH_SEED));
+        } else {
+            // NOTE: The extracted element may *not* have the same field name as the path - the
+            // key field name is always emitted from the pattern
+            keyBuilder.appendAs(keyEl, _keyPatternPaths[i]->dottedField());
+        }
+    }
+
+    dassert(isShardKey(keyBuilder.asTempObj()));
+    return keyBuilder.obj();
 }
 
 std::vector<StringData> ShardKeyPattern::findMissingShardKeyFieldsFromDoc(const BSONObj doc) const {
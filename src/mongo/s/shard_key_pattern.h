@@ -252,6 +252,15 @@ private:
     // Ordered, parsed paths
     std::vector<std::unique_ptr<FieldRef>> _keyPatternPaths;
 
+    // The following are computed once at construction so that per-document key extraction does
+    // not have to re-examine the pattern.
+
+    // Whether this is a hashed pattern, e.g. { a : "hashed" }
+    bool _isHashedPattern;
+
+    // Whether every pattern path consists of a single, top-level field
+    bool _allPathsSingleSegment;
+
     bool _hasId;
 };
 
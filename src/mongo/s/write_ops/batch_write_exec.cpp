@@ -32,12 +32,15 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <deque>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/client/connection_string.h"
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
@@ -45,11 +48,19 @@
 #include "mongo/s/transaction/transaction_router.h"
 #include "mongo/s/write_ops/batch_write_op.h"
 #include "mongo/s/write_ops/write_error_detail.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 namespace {
 
+// The number of dispatch rounds a single shard may have in flight at once when an unordered
+// batch is executed. Unordered batches which split into multiple rounds (because of the maximum
+// write batch size or the maximum BSON size) stream successive rounds to the shards without
+// waiting for the previous round's responses, bounded by this window. A value of 1 or less
+// falls back to awaiting each round before dispatching the next.
+MONGO_EXPORT_SERVER_PARAMETER(batchWriteExecPipelineWindow, int, 4);
+
 const ReadPreferenceSetting kPrimaryOnlyReadPreference(ReadPreference::PrimaryOnly);
 
 //
@@ -76,6 +87,251 @@ void noteStaleResponses(const std::vector<ShardError>& staleErrors, NSTargeter*
     }
 }
 
+/**
+ * Builds the wire version of a child batch request, attaching the operation's session info.
+ */
+BSONObj buildBatchRequestBSON(OperationContext* opCtx,
+                              BatchWriteOp& batchOp,
+                              const TargetedWriteBatch& nextBatch) {
+    const auto shardBatchRequest(batchOp.buildBatchRequest(nextBatch));
+
+    BSONObjBuilder requestBuilder;
+    shardBatchRequest.serialize(&requestBuilder);
+
+    {
+        OperationSessionInfo sessionInfo;
+
+        if (opCtx->getLogicalSessionId()) {
+            sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
+        }
+
+        sessionInfo.setTxnNumber(opCtx->getTxnNumber());
+        sessionInfo.serialize(&requestBuilder);
+    }
+
+    return requestBuilder.obj();
+}
+
+/**
+ * Notes the outcome of one dispatched child batch with 'batchOp' and the targeter. Returns true
+ * if the response showed that the routing metadata used to target the batch is stale, meaning
+ * further targeting is pointless until the targeter has refreshed.
+ */
+bool noteShardResponse(OperationContext* opCtx,
+                       NSTargeter& targeter,
+                       BatchWriteOp& batchOp,
+                       const AsyncRequestsSender::Response& response,
+                       const TargetedWriteBatch& batch,
+                       BatchWriteExecStats* stats) {
+    // First check if we were able to target a shard host.
+    if (!response.shardHostAndPort) {
+        invariant(!response.swResponse.isOK());
+
+        // Record a resolve failure
+        batchOp.noteBatchError(batch, errorFromStatus(response.swResponse.getStatus()));
+
+        // TODO: It may be necessary to refresh the cache if stale, or maybe just cancel
+        // and retarget the batch
+        LOG(4) << "Unable to send write batch to " << batch.getEndpoint().shardName
+               << causedBy(response.swResponse.getStatus());
+
+        return false;
+    }
+
+    const auto shardHost(*response.shardHostAndPort);
+
+    // Then check if we successfully got a response.
+    Status responseStatus = response.swResponse.getStatus();
+    BatchedCommandResponse batchedCommandResponse;
+    if (responseStatus.isOK()) {
+        std::string errMsg;
+        if (!batchedCommandResponse.parseBSON(response.swResponse.getValue().data, &errMsg) ||
+            !batchedCommandResponse.isValid(&errMsg)) {
+            responseStatus = {ErrorCodes::FailedToParse, errMsg};
+        }
+    }
+
+    if (!responseStatus.isOK()) {
+        // Error occurred dispatching, note it
+        const Status status =
+            responseStatus.withContext(str::stream() << "Write results unavailable from "
+                                                     << shardHost);
+
+        batchOp.noteBatchError(batch, errorFromStatus(status));
+
+        LOG(4) << "Unable to receive write results from " << shardHost << causedBy(redact(status));
+
+        return false;
+    }
+
+    TrackedErrors trackedErrors;
+    trackedErrors.startTracking(ErrorCodes::StaleShardVersion);
+    trackedErrors.startTracking(ErrorCodes::CannotImplicitlyCreateCollection);
+
+    LOG(4) << "Write results received from " << shardHost.toString() << ": "
+           << redact(batchedCommandResponse.toString());
+
+    // If we are in a transaction, we must fail the whole batch.
+    if (TransactionRouter::get(opCtx)) {
+        // Note: this returns a bad status if any part of the batch failed.
+        auto batchStatus = batchedCommandResponse.toStatus();
+        if (!batchStatus.isOK()) {
+            batchOp.forgetTargetedBatchesOnTransactionAbortingError();
+            uassertStatusOK(batchStatus.withContext(str::stream() << "Encountered error from "
+                                                                  << shardHost.toString()
+                                                                  << " during a transaction"));
+        }
+    }
+
+    // Dispatch was ok, note response
+    batchOp.noteBatchResponse(batch, batchedCommandResponse, &trackedErrors);
+
+    bool metadataStale = false;
+
+    // Note if anything was stale
+    const auto& staleErrors = trackedErrors.getErrors(ErrorCodes::StaleShardVersion);
+    if (!staleErrors.empty()) {
+        noteStaleResponses(staleErrors, &targeter);
+        ++stats->numStaleBatches;
+        metadataStale = true;
+    }
+
+    const auto& cannotImplicitlyCreateErrors =
+        trackedErrors.getErrors(ErrorCodes::CannotImplicitlyCreateCollection);
+    if (!cannotImplicitlyCreateErrors.empty()) {
+        // This forces the chunk manager to reload so we can attach the correct
+        // version on retry and make sure we route to the correct shard.
+        targeter.noteCouldNotTarget();
+        metadataStale = true;
+    }
+
+    // Remember that we successfully wrote to this shard
+    // NOTE: This will record lastOps for shards where we actually didn't update
+    // or delete any documents, which preserves old behavior but is conservative
+    stats->noteWriteAt(shardHost,
+                       batchedCommandResponse.isLastOpSet() ? batchedCommandResponse.getLastOp()
+                                                            : repl::OpTime(),
+                       batchedCommandResponse.isElectionIdSet()
+                           ? batchedCommandResponse.getElectionId()
+                           : OID());
+
+    return metadataStale;
+}
+
+/**
+ * Targets and dispatches successive rounds of child batches without awaiting the previous
+ * round's responses, keeping up to 'pipelineWindow' rounds on the network at once. Each round
+ * carries at most one child batch per shard, so the window also bounds the number of batches a
+ * single shard has in flight. Returns once no further round can be targeted without a targeter
+ * refresh and all dispatched rounds have been answered.
+ *
+ * Only used for unordered batches outside of a session, where neither the order of the writes
+ * nor the per-statement history requires the responses of a shard to be serialized.
+ */
+void executePipelinedRounds(OperationContext* opCtx,
+                            NSTargeter& targeter,
+                            const BatchedCommandRequest& clientRequest,
+                            BatchWriteOp& batchOp,
+                            BatchWriteExecStats* stats,
+                            int pipelineWindow,
+                            bool* refreshedTargeter) {
+    struct PendingRound {
+        // Owns the TargetedWriteBatches of this round, mapped by shard
+        OwnedShardBatchMap batches;
+
+        // The sender awaiting this round's responses
+        std::unique_ptr<MultiStatementTransactionRequestsSender> ars;
+    };
+
+    std::deque<std::unique_ptr<PendingRound>> pendingRounds;
+
+    // Once targeting fails or a response shows that our routing metadata is stale, further
+    // rounds would be targeted with the same stale metadata, so we stop filling the window and
+    // drain what is on the network before returning for a refresh.
+    bool stopTargeting = false;
+
+    while (true) {
+        //
+        // Top the window back up with new rounds.
+        //
+
+        while (!stopTargeting && pendingRounds.size() < static_cast<size_t>(pipelineWindow)) {
+            auto round = stdx::make_unique<PendingRound>();
+            auto& childBatches = round->batches.mutableMap();
+
+            // If we've already had a targeting error, we've refreshed the metadata once and can
+            // record target errors definitively.
+            Status targetStatus = batchOp.targetBatch(targeter, *refreshedTargeter, &childBatches);
+            if (!targetStatus.isOK()) {
+                // Don't do anything until a targeter refresh
+                targeter.noteCouldNotTarget();
+                *refreshedTargeter = true;
+                ++stats->numTargetErrors;
+                dassert(childBatches.size() == 0u);
+                stopTargeting = true;
+                break;
+            }
+
+            if (childBatches.empty()) {
+                // All remaining write ops are on the network already
+                stopTargeting = true;
+                break;
+            }
+
+            std::vector<AsyncRequestsSender::Request> requests;
+
+            for (auto& childBatch : childBatches) {
+                TargetedWriteBatch* const nextBatch = childBatch.second;
+                const auto& targetShardId = nextBatch->getEndpoint().shardName;
+
+                stats->noteTargetedShard(targetShardId);
+
+                const auto request = buildBatchRequestBSON(opCtx, batchOp, *nextBatch);
+
+                LOG(4) << "Sending write batch to " << targetShardId << ": " << redact(request);
+
+                requests.emplace_back(targetShardId, request);
+            }
+
+            round->ars = stdx::make_unique<MultiStatementTransactionRequestsSender>(
+                opCtx,
+                Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                clientRequest.getNS().db().toString(),
+                requests,
+                kPrimaryOnlyReadPreference,
+                Shard::RetryPolicy::kNoRetry);
+
+            pendingRounds.push_back(std::move(round));
+        }
+
+        if (pendingRounds.empty()) {
+            return;
+        }
+
+        //
+        // Drain the oldest round before topping the window back up. The younger rounds keep
+        // streaming in responses meanwhile; they are buffered by their senders.
+        //
+
+        auto& round = *pendingRounds.front();
+
+        while (!round.ars->done()) {
+            // Block until a response is available.
+            auto response = round.ars->next();
+
+            // Get the TargetedWriteBatch to find where to put the response
+            auto batchIt = round.batches.mutableMap().find(response.shardId);
+            dassert(batchIt != round.batches.mutableMap().end());
+
+            if (noteShardResponse(opCtx, targeter, batchOp, response, *batchIt->second, stats)) {
+                stopTargeting = true;
+            }
+        }
+
+        pendingRounds.pop_front();
+    }
+}
+
 // The number of times we'll try to continue a batch op if no progress is being made. This only
 // applies when no writes are occurring and metadata is not changing on reload.
 const int kMaxRoundsWithoutProgress(5);
@@ -100,6 +356,14 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
     int numCompletedOps = 0;
     int numRoundsWithoutProgress = 0;
 
+    // Unordered batches outside of a session may be dispatched pipelined: since neither the
+    // order of the writes nor the per-statement history constrains when a shard may see its
+    // next child batch, successive rounds are streamed out before the previous round's
+    // responses return.
+    const int pipelineWindow = batchWriteExecPipelineWindow.load();
+    const bool usePipelinedDispatch = pipelineWindow > 1 &&
+        !clientRequest.getWriteCommandBase().getOrdered() && !opCtx->getTxnNumber();
+
     while (!batchOp.isFinished()) {
         //
         // Get child batches to send using the targeter
@@ -125,203 +389,99 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         //    exactly when the metadata changed.
         //
 
-        OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
-        std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
-
-        // If we've already had a targeting error, we've refreshed the metadata once and can
-        // record target errors definitively.
-        bool recordTargetErrors = refreshedTargeter;
-        Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
-        if (!targetStatus.isOK()) {
-            // Don't do anything until a targeter refresh
-            targeter.noteCouldNotTarget();
-            refreshedTargeter = true;
-            ++stats->numTargetErrors;
-            dassert(childBatches.size() == 0u);
-        }
-
-        //
-        // Send all child batches
-        //
-
-        const size_t numToSend = childBatches.size();
-        size_t numSent = 0;
-
-        while (numSent != numToSend) {
-            // Collect batches out on the network, mapped by endpoint
-            OwnedShardBatchMap ownedPendingBatches;
-            OwnedShardBatchMap::MapType& pendingBatches = ownedPendingBatches.mutableMap();
+        if (usePipelinedDispatch) {
+            executePipelinedRounds(
+                opCtx, targeter, clientRequest, batchOp, stats, pipelineWindow, &refreshedTargeter);
+        } else {
+            OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
+            std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
+
+            // If we've already had a targeting error, we've refreshed the metadata once and can
+            // record target errors definitively.
+            bool recordTargetErrors = refreshedTargeter;
+            Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
+            if (!targetStatus.isOK()) {
+                // Don't do anything until a targeter refresh
+                targeter.noteCouldNotTarget();
+                refreshedTargeter = true;
+                ++stats->numTargetErrors;
+                dassert(childBatches.size() == 0u);
+            }
 
             //
-            // Construct the requests.
+            // Send all child batches
             //
 
-            std::vector<AsyncRequestsSender::Request> requests;
-
-            // Get as many batches as we can at once
-            for (auto& childBatch : childBatches) {
-                TargetedWriteBatch* const nextBatch = childBatch.second;
-
-                // If the batch is nullptr, we sent it previously, so skip
-                if (!nextBatch)
-                    continue;
-
-                // If we already have a batch for this shard, wait until the next time
-                const auto& targetShardId = nextBatch->getEndpoint().shardName;
-
-                if (pendingBatches.count(targetShardId))
-                    continue;
+            const size_t numToSend = childBatches.size();
+            size_t numSent = 0;
 
-                stats->noteTargetedShard(targetShardId);
-
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
+            while (numSent != numToSend) {
+                // Collect batches out on the network, mapped by endpoint
+                OwnedShardBatchMap ownedPendingBatches;
+                OwnedShardBatchMap::MapType& pendingBatches = ownedPendingBatches.mutableMap();
 
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
+                //
+                // Construct the requests.
+                //
 
-                    {
-                        OperationSessionInfo sessionInfo;
+                std::vector<AsyncRequestsSender::Request> requests;
 
-                        if (opCtx->getLogicalSessionId()) {
-                            sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
-                        }
+                // Get as many batches as we can at once
+                for (auto& childBatch : childBatches) {
+                    TargetedWriteBatch* const nextBatch = childBatch.second;
 
-                        sessionInfo.setTxnNumber(opCtx->getTxnNumber());
-                        sessionInfo.serialize(&requestBuilder);
-                    }
+                    // If the batch is nullptr, we sent it previously, so skip
+                    if (!nextBatch)
+                        continue;
 
-                    return requestBuilder.obj();
-                }();
+                    // If we already have a batch for this shard, wait until the next time
+                    const auto& targetShardId = nextBatch->getEndpoint().shardName;
 
-                LOG(4) << "Sending write batch to " << targetShardId << ": " << redact(request);
+                    if (pendingBatches.count(targetShardId))
+                        continue;
 
-                requests.emplace_back(targetShardId, request);
+                    stats->noteTargetedShard(targetShardId);
 
-                // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
-                // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
-                // so this should be pretty efficient without moving stuff around.
-                childBatch.second = nullptr;
+                    const auto request = buildBatchRequestBSON(opCtx, batchOp, *nextBatch);
 
-                // Recv-side is responsible for cleaning up the nextBatch when used
-                pendingBatches.emplace(targetShardId, nextBatch);
-            }
-
-            MultiStatementTransactionRequestsSender ars(
-                opCtx,
-                Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                clientRequest.getNS().db().toString(),
-                requests,
-                kPrimaryOnlyReadPreference,
-                opCtx->getTxnNumber() ? Shard::RetryPolicy::kIdempotent
-                                      : Shard::RetryPolicy::kNoRetry);
-            numSent += pendingBatches.size();
+                    LOG(4) << "Sending write batch to " << targetShardId << ": "
+                           << redact(request);
 
-            //
-            // Receive the responses.
-            //
+                    requests.emplace_back(targetShardId, request);
 
-            while (!ars.done()) {
-                // Block until a response is available.
-                auto response = ars.next();
-
-                // Get the TargetedWriteBatch to find where to put the response
-                dassert(pendingBatches.find(response.shardId) != pendingBatches.end());
-                TargetedWriteBatch* batch = pendingBatches.find(response.shardId)->second;
-
-                // First check if we were able to target a shard host.
-                if (!response.shardHostAndPort) {
-                    invariant(!response.swResponse.isOK());
-
-                    // Record a resolve failure
-                    batchOp.noteBatchError(*batch,
-                                           errorFromStatus(response.swResponse.getStatus()));
-
-                    // TODO: It may be necessary to refresh the cache if stale, or maybe just cancel
-                    // and retarget the batch
-                    LOG(4) << "Unable to send write batch to " << batch->getEndpoint().shardName
-                           << causedBy(response.swResponse.getStatus());
-
-                    // We're done with this batch. Clean up when we can't resolve a host.
-                    auto it = childBatches.find(batch->getEndpoint().shardName);
-                    invariant(it != childBatches.end());
-                    delete it->second;
-                    it->second = nullptr;
-                    continue;
-                }
+                    // Indicate we're done by setting the batch to nullptr. We'll only get
+                    // duplicate hostEndpoints if we have broadcast and non-broadcast endpoints
+                    // for the same host, so this should be pretty efficient without moving stuff
+                    // around.
+                    childBatch.second = nullptr;
 
-                const auto shardHost(std::move(*response.shardHostAndPort));
-
-                // Then check if we successfully got a response.
-                Status responseStatus = response.swResponse.getStatus();
-                BatchedCommandResponse batchedCommandResponse;
-                if (responseStatus.isOK()) {
-                    std::string errMsg;
-                    if (!batchedCommandResponse.parseBSON(response.swResponse.getValue().data,
-                                                          &errMsg) ||
-                        !batchedCommandResponse.isValid(&errMsg)) {
-                        responseStatus = {ErrorCodes::FailedToParse, errMsg};
-                    }
+                    // Recv-side is responsible for cleaning up the nextBatch when used
+                    pendingBatches.emplace(targetShardId, nextBatch);
                 }
 
-                if (responseStatus.isOK()) {
-                    TrackedErrors trackedErrors;
-                    trackedErrors.startTracking(ErrorCodes::StaleShardVersion);
-                    trackedErrors.startTracking(ErrorCodes::CannotImplicitlyCreateCollection);
-
-                    LOG(4) << "Write results received from " << shardHost.toString() << ": "
-                           << redact(batchedCommandResponse.toString());
-
-                    // If we are in a transaction, we must fail the whole batch.
-                    if (TransactionRouter::get(opCtx)) {
-                        // Note: this returns a bad status if any part of the batch failed.
-                        auto batchStatus = batchedCommandResponse.toStatus();
-                        if (!batchStatus.isOK()) {
-                            batchOp.forgetTargetedBatchesOnTransactionAbortingError();
-                            uassertStatusOK(batchStatus.withContext(
-                                str::stream() << "Encountered error from " << shardHost.toString()
-                                              << " during a transaction"));
-                        }
-                    }
-
-                    // Dispatch was ok, note response
-                    batchOp.noteBatchResponse(*batch, batchedCommandResponse, &trackedErrors);
-
-                    // Note if anything was stale
-                    const auto& staleErrors =
-                        trackedErrors.getErrors(ErrorCodes::StaleShardVersion);
-                    if (!staleErrors.empty()) {
-                        noteStaleResponses(staleErrors, &targeter);
-                        ++stats->numStaleBatches;
-                    }
-
-                    const auto& cannotImplicitlyCreateErrors =
-                        trackedErrors.getErrors(ErrorCodes::CannotImplicitlyCreateCollection);
-                    if (!cannotImplicitlyCreateErrors.empty()) {
-                        // This forces the chunk manager to reload so we can attach the correct
-                        // version on retry and make sure we route to the correct shard.
-                        targeter.noteCouldNotTarget();
-                    }
-
-                    // Remember that we successfully wrote to this shard
-                    // NOTE: This will record lastOps for shards where we actually didn't update
-                    // or delete any documents, which preserves old behavior but is conservative
-                    stats->noteWriteAt(shardHost,
-                                       batchedCommandResponse.isLastOpSet()
-                                           ? batchedCommandResponse.getLastOp()
-                                           : repl::OpTime(),
-                                       batchedCommandResponse.isElectionIdSet()
-                                           ? batchedCommandResponse.getElectionId()
-                                           : OID());
-                } else {
-                    // Error occurred dispatching, note it
-                    const Status status = responseStatus.withContext(
-                        str::stream() << "Write results unavailable from " << shardHost);
-
-                    batchOp.noteBatchError(*batch, errorFromStatus(status));
-
-                    LOG(4) << "Unable to receive write results from " << shardHost
-                           << causedBy(redact(status));
+                MultiStatementTransactionRequestsSender ars(
+                    opCtx,
+                    Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                    clientRequest.getNS().db().toString(),
+                    requests,
+                    kPrimaryOnlyReadPreference,
+                    opCtx->getTxnNumber() ? Shard::RetryPolicy::kIdempotent
+                                          : Shard::RetryPolicy::kNoRetry);
+                numSent += pendingBatches.size();
+
+                //
+                // Receive the responses.
+                //
+
+                while (!ars.done()) {
+                    // Block until a response is available.
+                    auto response = ars.next();
+
+                    // Get the TargetedWriteBatch to find where to put the response
+                    dassert(pendingBatches.find(response.shardId) != pendingBatches.end());
+                    TargetedWriteBatch* batch = pendingBatches.find(response.shardId)->second;
+
+                    noteShardResponse(opCtx, targeter, batchOp, response, *batch, stats);
                 }
             }
         }
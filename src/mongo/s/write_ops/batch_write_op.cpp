@@ -683,22 +683,38 @@ void BatchWriteOp::forgetTargetedBatchesOnTransactionAbortingError() {
     _targeted.clear();
 }
 
-bool BatchWriteOp::isFinished() {
+void BatchWriteOp::_stageFinishedOps() {
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
-    const bool orderedOps = _clientRequest.getWriteCommandBase().getOrdered();
-    for (size_t i = 0; i < numWriteOps; ++i) {
-        WriteOp& writeOp = _writeOps[i];
+    while (_nStagedOps < numWriteOps) {
+        WriteOp& writeOp = _writeOps[_nStagedOps];
         if (writeOp.getWriteState() < WriteOpState_Completed)
-            return false;
-        else if (orderedOps && writeOp.getWriteState() == WriteOpState_Error)
-            return true;
+            break;
+
+        if (writeOp.getWriteState() == WriteOpState_Error) {
+            auto error = stdx::make_unique<WriteErrorDetail>();
+            writeOp.getOpError().cloneTo(error.get());
+            _stagedErrDetails.push_back(std::move(error));
+            ++_nStagedErrOps;
+        }
+
+        ++_nStagedOps;
     }
+}
+
+bool BatchWriteOp::isFinished() {
+    _stageFinishedOps();
+
+    if (_nStagedOps == _clientRequest.sizeWriteOps())
+        return true;
 
-    return true;
+    // An ordered batch is finished as soon as any write op has failed; the write ops after it
+    // will never be dispatched.
+    return _clientRequest.getWriteCommandBase().getOrdered() && _nStagedErrOps > 0;
 }
 
 void BatchWriteOp::buildClientResponse(BatchedCommandResponse* batchResp) {
     dassert(isFinished());
+    _stageFinishedOps();
 
     // Result is OK
     batchResp->setStatus(Status::OK());
@@ -710,38 +726,20 @@ void BatchWriteOp::buildClientResponse(BatchedCommandResponse* batchResp) {
     }
 
     //
-    // Find all the errors in the batch
+    // Attach the per-item errors, staged earlier as the responses were noted.
     //
 
-    vector<WriteOp*> errOps;
-
-    const size_t numWriteOps = _clientRequest.sizeWriteOps();
-    for (size_t i = 0; i < numWriteOps; ++i) {
-        WriteOp& writeOp = _writeOps[i];
-
-        if (writeOp.getWriteState() == WriteOpState_Error) {
-            errOps.push_back(&writeOp);
-        }
-    }
-
-    //
-    // Build the per-item errors.
-    //
-
-    if (!errOps.empty()) {
-        for (vector<WriteOp*>::iterator it = errOps.begin(); it != errOps.end(); ++it) {
-            WriteOp& writeOp = **it;
-            WriteErrorDetail* error = new WriteErrorDetail();
-            writeOp.getOpError().cloneTo(error);
-            batchResp->addToErrDetails(error);
-        }
+    const size_t numErrOps = _nStagedErrOps;
+    for (auto& error : _stagedErrDetails) {
+        batchResp->addToErrDetails(error.release());
     }
+    _stagedErrDetails.clear();
 
     // Only return a write concern error if everything succeeded (unordered or ordered)
     // OR if something succeeded and we're unordered
     const bool orderedOps = _clientRequest.getWriteCommandBase().getOrdered();
     const bool reportWCError =
-        errOps.empty() || (!orderedOps && errOps.size() < _clientRequest.sizeWriteOps());
+        numErrOps == 0 || (!orderedOps && numErrOps < _clientRequest.sizeWriteOps());
     if (!_wcErrors.empty() && reportWCError) {
         WriteConcernErrorDetail* error = new WriteConcernErrorDetail;
 
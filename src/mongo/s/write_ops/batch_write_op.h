@@ -185,7 +185,9 @@ public:
     bool isFinished();
 
     /**
-     * Fills a batch response to send back to the client.
+     * Fills a batch response to send back to the client. The response is staged incrementally as
+     * write ops reach a final state, so this only assembles the already-staged pieces rather
+     * than re-examining every write op.
      */
     void buildClientResponse(BatchedCommandResponse* batchResp);
 
@@ -201,6 +203,14 @@ private:
      */
     void _incBatchStats(const BatchedCommandResponse& response);
 
+    /**
+     * Advances '_nStagedOps' over write ops which have reached a final state since the last call
+     * and stages the error details of any failed ones. Completed and Error states are final, so
+     * staged results can never be invalidated; retryable errors leave the op in the Ready state
+     * and are not staged.
+     */
+    void _stageFinishedOps();
+
     /**
      * Helper function to cancel all the write ops of targeted batches in a map.
      */
@@ -227,6 +237,15 @@ private:
     // Upserted ids for the whole write batch
     std::vector<std::unique_ptr<BatchedUpsertDetail>> _upsertedIds;
 
+    // Number of leading write ops which have reached a final state and whose results have been
+    // staged for the client response
+    size_t _nStagedOps{0};
+
+    // Per-item errors staged as write ops reach a final state, in write op order. The count is
+    // tracked separately since buildClientResponse() hands the staged errors to the response.
+    std::vector<std::unique_ptr<WriteErrorDetail>> _stagedErrDetails;
+    size_t _nStagedErrOps{0};
+
     // Stats for the entire batch op
     int _numInserted{0};
     int _numUpserted{0};
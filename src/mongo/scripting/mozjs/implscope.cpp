@@ -48,7 +48,9 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/scopeguard.h"
 
 #if !defined(__has_feature)
@@ -606,6 +608,51 @@ BSONObj MozJSImplScope::getObject(const char* field) {
     return _runSafely([&] { return ObjectWrapper(_context, _global).getObject(field); });
 }
 
+namespace {
+
+/**
+ * Process-wide cache of XDR-encoded function bytecode, keyed by normalized source. Scopes are
+ * discarded and recreated constantly under mapReduce and $where, and compiled functions cannot
+ * outlive their scope, but the encoded bytecode can: a hit here turns function creation into a
+ * decode instead of a parse and compile. XDR output is specific to this build of SpiderMonkey,
+ * so the cache never crosses a process boundary. Entries are immutable once stored.
+ */
+class CompiledFunctionCache {
+    MONGO_DISALLOW_COPYING(CompiledFunctionCache);
+
+public:
+    CompiledFunctionCache() = default;
+
+    static CompiledFunctionCache* get() {
+        static CompiledFunctionCache* cache = new CompiledFunctionCache();
+        return cache;
+    }
+
+    std::shared_ptr<const std::vector<char>> lookup(const std::string& source) {
+        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        auto it = _cache.find(source);
+        if (it == _cache.end()) {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    void store(const std::string& source, std::shared_ptr<const std::vector<char>> bytecode) {
+        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        _cache.add(source, std::move(bytecode));
+    }
+
+private:
+    // Workloads that benefit reuse a small, fixed set of functions; generated one-off sources
+    // simply age out.
+    static const size_t kMaxEntries = 100;
+
+    SimpleMutex _mutex;
+    LRUCache<std::string, std::shared_ptr<const std::vector<char>>> _cache{kMaxEntries};
+};
+
+}  // namespace
+
 void MozJSImplScope::newFunction(StringData raw, JS::MutableHandleValue out) {
     _runSafely([&] { _MozJSCreateFunction(raw, std::move(out)); });
 }
@@ -614,6 +661,18 @@ void MozJSImplScope::_MozJSCreateFunction(StringData raw, JS::MutableHandleValue
     std::string code = str::stream()
         << "(" << parseJSFunctionOrExpression(_context, StringData(raw)) << ")";
 
+    // A bytecode cache hit skips parsing and compiling the source entirely.
+    if (auto bytecode = CompiledFunctionCache::get()->lookup(code)) {
+        JS::RootedObject funobj(
+            _context, JS_DecodeInterpretedFunction(_context, bytecode->data(), bytecode->size()));
+        if (funobj) {
+            fun.setObject(*funobj);
+            return;
+        }
+        // A failed decode falls through to a fresh compile.
+        JS_ClearPendingException(_context);
+    }
+
     JS::CompileOptions co(_context);
     setCompileOptions(&co);
 
@@ -621,6 +680,19 @@ void MozJSImplScope::_MozJSCreateFunction(StringData raw, JS::MutableHandleValue
     uassert(10232,
             "not a function",
             fun.isObject() && JS_ObjectIsFunction(_context, fun.toObjectOrNull()));
+
+    // Encode the compiled function so other scopes (and later incarnations of this one) can
+    // reuse it. Not every function is encodable; failures just mean no caching.
+    JS::RootedObject funobj(_context, fun.toObjectOrNull());
+    uint32_t length = 0;
+    if (void* data = JS_EncodeInterpretedFunction(_context, funobj, &length)) {
+        auto bytecode = std::make_shared<std::vector<char>>(
+            static_cast<const char*>(data), static_cast<const char*>(data) + length);
+        JS_free(_context, data);
+        CompiledFunctionCache::get()->store(code, std::move(bytecode));
+    } else {
+        JS_ClearPendingException(_context);
+    }
 }
 
 BSONObj MozJSImplScope::callThreadArgs(const BSONObj& args) {
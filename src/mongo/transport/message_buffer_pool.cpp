@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_buffer_pool.h"
+
+#include <vector>
+
+namespace mongo {
+namespace transport {
+namespace {
+
+// Size classes are the powers of two from 1KB through 256KB, which covers the typical wire
+// message and receive chunk sizes. The smallest class keeps tiny messages (e.g. isMaster on
+// monitoring connections) from fragmenting the pool into many single-purpose buffers.
+constexpr size_t kMinRecycledSize = 1024;
+constexpr size_t kMaxRecycledSize = 256 * 1024;
+constexpr int kNumSizeClasses = 9;  // log2(kMaxRecycledSize / kMinRecycledSize) + 1
+
+// Per-class free list bound. With nine classes this caps a thread's pool at a few MB, which is
+// insignificant next to the connection buffers themselves.
+constexpr size_t kMaxBuffersPerClass = 16;
+
+struct FreeLists {
+    std::vector<SharedBuffer> classes[kNumSizeClasses];
+};
+
+thread_local FreeLists localFreeLists;
+
+// Returns the size class index for 'bytes', or -1 when the size is not poolable. A buffer is
+// only poolable if 'bytes' is exactly a class size, so that recycle() never mistakes a
+// same-sized foreign allocation's capacity for a different class.
+int sizeClassFor(size_t bytes) {
+    if (bytes < kMinRecycledSize || bytes > kMaxRecycledSize) {
+        return -1;
+    }
+
+    size_t classSize = kMinRecycledSize;
+    for (int i = 0; i < kNumSizeClasses; i++, classSize *= 2) {
+        if (bytes == classSize) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the smallest class size that can hold 'bytes'. Callers must ensure that 'bytes' is no
+// larger than kMaxRecycledSize.
+size_t roundUpToClassSize(size_t bytes) {
+    size_t classSize = kMinRecycledSize;
+    while (classSize < bytes) {
+        classSize *= 2;
+    }
+    return classSize;
+}
+
+}  // namespace
+
+SharedBuffer MessageBufferPool::acquire(size_t bytes) {
+    if (bytes > kMaxRecycledSize) {
+        return SharedBuffer::allocate(bytes);
+    }
+
+    const size_t classSize = roundUpToClassSize(bytes);
+    auto& freeList = localFreeLists.classes[sizeClassFor(classSize)];
+    if (!freeList.empty()) {
+        SharedBuffer buffer = std::move(freeList.back());
+        freeList.pop_back();
+        return buffer;
+    }
+
+    // Allocate the whole class size rather than 'bytes', so the buffer is recyclable once it
+    // comes back.
+    return SharedBuffer::allocate(classSize);
+}
+
+void MessageBufferPool::recycle(SharedBuffer buffer) {
+    if (!buffer || buffer.isShared()) {
+        return;
+    }
+
+    const int sizeClass = sizeClassFor(buffer.capacity());
+    if (sizeClass < 0) {
+        return;
+    }
+
+    auto& freeList = localFreeLists.classes[sizeClass];
+    if (freeList.size() < kMaxBuffersPerClass) {
+        freeList.push_back(std::move(buffer));
+    }
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,67 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * A size-classed recycling pool for the SharedBuffers backing Messages. At high message rates
+ * the transport layer allocates and frees a buffer per inbound message, and the allocator cost
+ * of exactly that churn shows up in profiles; recycling the buffers removes it.
+ *
+ * The free lists are thread local, so acquire and recycle never take a lock. A buffer released
+ * on a thread seeds that thread's pool, which keeps buffers local to the reactor thread (and
+ * thus to its NUMA node when threads are pinned) once the pools warm up.
+ *
+ * Buffers larger than the biggest size class are not pooled and fall through to the allocator,
+ * so oversized messages cannot pin large allocations in the free lists.
+ */
+class MessageBufferPool {
+public:
+    /**
+     * Returns a buffer with capacity of at least 'bytes', reusing a recycled buffer of the
+     * matching size class when one is available.
+     */
+    static SharedBuffer acquire(size_t bytes);
+
+    /**
+     * Offers 'buffer' to the calling thread's pool. Buffers that are still shared, were not
+     * acquired from the pool, or belong to a size class whose free list is full are simply
+     * freed as usual.
+     */
+    static void recycle(SharedBuffer buffer);
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_buffer_pool.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+TEST(MessageBufferPool, AcquireRoundsUpToSizeClass) {
+    auto buffer = MessageBufferPool::acquire(100);
+    ASSERT_TRUE(buffer);
+    ASSERT_GTE(buffer.capacity(), 100u);
+}
+
+TEST(MessageBufferPool, RecycledBufferIsReusedOnSameThread) {
+    auto buffer = MessageBufferPool::acquire(4096);
+    auto* ptr = buffer.get();
+    MessageBufferPool::recycle(std::move(buffer));
+
+    auto reused = MessageBufferPool::acquire(4096);
+    ASSERT_EQ(ptr, reused.get());
+}
+
+TEST(MessageBufferPool, SharedBufferIsNotRecycled) {
+    auto buffer = MessageBufferPool::acquire(4096);
+    auto* ptr = buffer.get();
+    auto secondRef = buffer;
+    MessageBufferPool::recycle(std::move(buffer));
+
+    // 'secondRef' still owns the buffer, so the pool must not have taken it.
+    auto fresh = MessageBufferPool::acquire(4096);
+    ASSERT_NE(ptr, fresh.get());
+}
+
+TEST(MessageBufferPool, OversizedBuffersBypassThePool) {
+    const size_t oversized = 64 * 1024 * 1024;
+    auto buffer = MessageBufferPool::acquire(oversized);
+    ASSERT_EQ(oversized, buffer.capacity());
+    MessageBufferPool::recycle(std::move(buffer));
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
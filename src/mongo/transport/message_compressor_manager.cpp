@@ -36,14 +36,27 @@
 #include "mongo/base/data_type_endian.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/rpc/message.h"
+#include "mongo/transport/message_buffer_pool.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
+
+MONGO_EXPORT_SERVER_PARAMETER(adaptiveMessageCompressionMinSavingsPct, int, 0);
+
 namespace {
 
+// The adaptive compression policy measures the achieved savings over windows of this many
+// uncompressed bytes.
+constexpr int64_t kAdaptiveWindowBytes = 1 << 20;
+
+// Once compression has been suspended on a connection, it is retried after this many bytes
+// have been sent uncompressed, in case the traffic mix has changed.
+constexpr int64_t kAdaptiveProbeIntervalBytes = 32 << 20;
+
 // TODO(JBR): This should be changed so it 's closer to the MSGHEADER View/ConstView classes
 // than this little struct.
 struct CompressionHeader {
@@ -102,6 +115,11 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
+    if (!_shouldCompress(msg.dataSize())) {
+        LOG(3) << "Skipping compression of outbound message on poorly compressing connection";
+        return {msg};
+    }
+
     LOG(3) << "Compressing message with " << compressor->getName();
 
     auto inputHeader = msg.header();
@@ -117,7 +135,7 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
-    auto outputMessageBuffer = SharedBuffer::allocate(bufferSize);
+    auto outputMessageBuffer = transport::MessageBufferPool::acquire(bufferSize);
 
     MsgData::View outMessage(outputMessageBuffer.get());
     outMessage.setId(inputHeader.getId());
@@ -137,9 +155,55 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     auto realCompressedSize = sws.getValue();
     outMessage.setLen(realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize);
 
+    _recordCompression(inputHeader.dataLen(), realCompressedSize);
+
     return {Message(outputMessageBuffer)};
 }
 
+bool MessageCompressorManager::_shouldCompress(size_t dataSize) {
+    if (adaptiveMessageCompressionMinSavingsPct.load() <= 0) {
+        // The adaptive policy is disabled; always compress.
+        return true;
+    }
+
+    if (!_compressionSuspended)
+        return true;
+
+    _uncompressedBytesSent += dataSize;
+    if (_uncompressedBytesSent < kAdaptiveProbeIntervalBytes)
+        return false;
+
+    // Start compressing again and measure a fresh window to see whether the traffic has become
+    // compressible.
+    LOG(2) << "Re-enabling message compression to probe compressibility of this connection";
+    _compressionSuspended = false;
+    _uncompressedBytesSent = 0;
+    _windowBytesIn = 0;
+    _windowBytesOut = 0;
+    return true;
+}
+
+void MessageCompressorManager::_recordCompression(int64_t bytesIn, int64_t bytesOut) {
+    const auto minSavingsPct = adaptiveMessageCompressionMinSavingsPct.load();
+    if (minSavingsPct <= 0)
+        return;
+
+    _windowBytesIn += bytesIn;
+    _windowBytesOut += bytesOut;
+    if (_windowBytesIn < kAdaptiveWindowBytes)
+        return;
+
+    const auto savingsPct = 100 - (_windowBytesOut * 100 / _windowBytesIn);
+    if (savingsPct < minSavingsPct) {
+        LOG(1) << "Message compression saved only " << savingsPct << "% over the last "
+               << _windowBytesIn << " bytes; suspending compression on this connection";
+        _compressionSuspended = true;
+        _uncompressedBytesSent = 0;
+    }
+    _windowBytesIn = 0;
+    _windowBytesOut = 0;
+}
+
 StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& msg,
                                                                 MessageCompressorId* compressorId) {
     auto inputHeader = msg.header();
@@ -161,13 +225,20 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     LOG(3) << "Decompressing message with " << compressor->getName();
 
+    if (compressionHeader.uncompressedSize < 0) {
+        return {ErrorCodes::BadValue, "Decompressed message would have negative size"};
+    }
+
+    // Allocate one buffer sized for the final message, pre-write the MSGHDR, and decompress
+    // directly into the remainder. The decompressed buffer is the backing store for all
+    // downstream views of the message (e.g. OpMsg::parse), so no second copy is made.
     size_t bufferSize = compressionHeader.uncompressedSize + MsgData::MsgDataHeaderSize;
     if (bufferSize > MaxMessageSizeBytes) {
         return {ErrorCodes::BadValue,
                 "Decompressed message would be larger than maximum message size"};
     }
 
-    auto outputMessageBuffer = SharedBuffer::allocate(bufferSize);
+    auto outputMessageBuffer = transport::MessageBufferPool::acquire(bufferSize);
     MsgData::View outMessage(outputMessageBuffer.get());
     outMessage.setId(inputHeader.getId());
     outMessage.setResponseToMsgId(inputHeader.getResponseToMsgId());
@@ -42,6 +42,15 @@ class BSONObjBuilder;
 class Message;
 class MessageCompressorRegistry;
 
+/*
+ * The minimum percentage of bytes that compressing outbound messages must save, measured over a
+ * rolling window of traffic, for compression to remain enabled on a connection. Connections whose
+ * traffic compresses worse than this (e.g. already-compressed payload fields) stop compressing
+ * outbound messages and periodically re-probe. Zero disables the adaptive policy, so outbound
+ * messages are always compressed once compression has been negotiated.
+ */
+extern AtomicInt32 adaptiveMessageCompressionMinSavingsPct;
+
 class MessageCompressorManager {
     MONGO_DISALLOW_COPYING(MessageCompressorManager);
 
@@ -126,8 +135,24 @@ public:
     static MessageCompressorManager& forSession(const transport::SessionHandle& session);
 
 private:
+    /*
+     * The adaptive compression policy. _shouldCompress() is consulted before compressing an
+     * outbound message, and _recordCompression() is fed the observed input/output sizes after a
+     * successful compression. These calls are not synchronized; messages on a session are
+     * compressed one at a time.
+     */
+    bool _shouldCompress(size_t dataSize);
+    void _recordCompression(int64_t bytesIn, int64_t bytesOut);
+
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+
+    // State for the adaptive compression policy. While suspended, outbound messages are sent
+    // uncompressed and _uncompressedBytesSent counts up to the re-probe interval.
+    int64_t _windowBytesIn = 0;
+    int64_t _windowBytesOut = 0;
+    int64_t _uncompressedBytesSent = 0;
+    bool _compressionSuspended = false;
 };
 
 }  // namespace mongo
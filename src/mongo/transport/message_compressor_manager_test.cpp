@@ -40,6 +40,7 @@
 #include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 #include <string>
 #include <vector>
@@ -129,6 +130,13 @@ void checkFidelity(const Message& msg, std::unique_ptr<MessageCompressorBase> co
     ASSERT_EQ(decompressedMsgView.getLen(), originalView.getLen());
 
     ASSERT_EQ(memcmp(decompressedMsgView.data(), originalView.data(), originalView.dataLen()), 0);
+
+    // The decompressed message must be backed by a single buffer with the header written in
+    // place, so downstream parsing can take zero-copy views of it. The buffer was allocated
+    // from the size declared in the compression header, which must match the real message.
+    ASSERT_EQ(static_cast<const void*>(decompressedMsg.buf()),
+              static_cast<const void*>(decompressedMsgView.view2ptr()));
+    ASSERT_EQ(decompressedMsg.sharedBuffer().capacity(), static_cast<size_t>(originalView.getLen()));
 }
 
 void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
@@ -218,6 +226,47 @@ TEST(MessageCompressorManager, FullNormalCompression) {
     clientManager.clientFinish(serverObj);
 }
 
+TEST(MessageCompressorManager, AdaptivePolicySuspendsAndReprobes) {
+    adaptiveMessageCompressionMinSavingsPct.store(5);
+    const auto guard = MakeGuard([] { adaptiveMessageCompressionMinSavingsPct.store(0); });
+
+    auto registry = buildRegistry();
+    MessageCompressorManager manager(&registry);
+
+    BSONObjBuilder serverOutput;
+    manager.serverNegotiate(BSON("isMaster" << 1 << "compression" << BSON_ARRAY("noop")),
+                            &serverOutput);
+    checkNegotiationResult(serverOutput.done(), {"noop"});
+
+    // Build a message large enough that a single compression fills a policy window. The noop
+    // compressor achieves exactly 0% savings, which is below the threshold set above.
+    const size_t dataSize = 2 * 1024 * 1024;
+    auto buf = SharedBuffer::allocate(MsgData::MsgDataHeaderSize + dataSize);
+    MsgData::View testView(buf.get());
+    testView.setId(123456);
+    testView.setResponseToMsgId(654321);
+    testView.setOperation(dbQuery);
+    testView.setLen(MsgData::MsgDataHeaderSize + dataSize);
+    memset(testView.data(), 'a', dataSize);
+    Message msg(buf);
+
+    // The first message is compressed while the policy observes its first window.
+    auto compressed = assertOk(manager.compressMessage(msg));
+    ASSERT_EQ(compressed.operation(), dbCompressed);
+
+    // The window showed no savings, so the next message goes out uncompressed.
+    compressed = assertOk(manager.compressMessage(msg));
+    ASSERT_EQ(compressed.operation(), dbQuery);
+
+    // After enough uncompressed traffic, the policy probes by compressing again.
+    bool reprobed = false;
+    for (int i = 0; i < 64 && !reprobed; i++) {
+        compressed = assertOk(manager.compressMessage(msg));
+        reprobed = (compressed.operation() == dbCompressed);
+    }
+    ASSERT_TRUE(reprobed);
+}
+
 TEST(NoopMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
     checkFidelity(testMessage, stdx::make_unique<NoopMessageCompressor>());
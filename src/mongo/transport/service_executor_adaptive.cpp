@@ -32,6 +32,7 @@
 
 #include "mongo/transport/service_executor_adaptive.h"
 
+#include <algorithm>
 #include <array>
 #include <random>
 
@@ -153,16 +154,28 @@ thread_local ServiceExecutorAdaptive::ThreadState* ServiceExecutorAdaptive::_loc
     nullptr;
 
 ServiceExecutorAdaptive::ServiceExecutorAdaptive(ServiceContext* ctx, ReactorHandle reactor)
-    : ServiceExecutorAdaptive(
-          ctx, std::move(reactor), stdx::make_unique<ServerParameterOptions>()) {}
+    : ServiceExecutorAdaptive(ctx, std::vector<ReactorHandle>{std::move(reactor)}) {}
 
 ServiceExecutorAdaptive::ServiceExecutorAdaptive(ServiceContext* ctx,
                                                  ReactorHandle reactor,
                                                  std::unique_ptr<Options> config)
-    : _reactorHandle(reactor),
+    : ServiceExecutorAdaptive(
+          ctx, std::vector<ReactorHandle>{std::move(reactor)}, std::move(config)) {}
+
+ServiceExecutorAdaptive::ServiceExecutorAdaptive(ServiceContext* ctx,
+                                                 std::vector<ReactorHandle> reactors)
+    : ServiceExecutorAdaptive(
+          ctx, std::move(reactors), stdx::make_unique<ServerParameterOptions>()) {}
+
+ServiceExecutorAdaptive::ServiceExecutorAdaptive(ServiceContext* ctx,
+                                                 std::vector<ReactorHandle> reactors,
+                                                 std::unique_ptr<Options> config)
+    : _reactors(std::move(reactors)),
       _config(std::move(config)),
       _tickSource(ctx->getTickSource()),
-      _lastScheduleTimer(_tickSource) {}
+      _lastScheduleTimer(_tickSource) {
+    invariant(!_reactors.empty());
+}
 
 ServiceExecutorAdaptive::~ServiceExecutorAdaptive() {
     invariant(!_isRunning.load());
@@ -189,7 +202,9 @@ Status ServiceExecutorAdaptive::shutdown(Milliseconds timeout) {
     _controllerThread.join();
 
     stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
-    _reactorHandle->stop();
+    for (auto& reactor : _reactors) {
+        reactor->stop();
+    }
     bool result =
         _deathCondition.wait_for(lk, timeout.toSystemDuration(), [&] { return _threads.empty(); });
 
@@ -244,6 +259,18 @@ Status ServiceExecutorAdaptive::schedule(ServiceExecutorAdaptive::Task task,
         }
     };
 
+    // Tasks scheduled from a worker thread stay on that worker's reactor shard. A session's
+    // network completions fire on the shard its socket was bound to at accept time, so this
+    // keeps each session's task chain on one shard. Tasks scheduled from non-worker threads
+    // (e.g. session startup) are dealt round-robin; the session migrates to its own shard on
+    // its first network operation.
+    Reactor* reactor;
+    if (_localThreadState) {
+        reactor = _localThreadState->reactor.get();
+    } else {
+        reactor = _reactors[_nextReactor.fetchAndAdd(1) % _reactors.size()].get();
+    }
+
     // Dispatching a task on the io_context will run the task immediately, and may run it
     // on the current thread (if the current thread is running the io_context right now).
     //
@@ -253,9 +280,9 @@ Status ServiceExecutorAdaptive::schedule(ServiceExecutorAdaptive::Task task,
     // can be called immediately and recursively.
     if ((flags & kMayRecurse) &&
         (_localThreadState->recursionDepth + 1 < _config->recursionLimit())) {
-        _reactorHandle->schedule(Reactor::kDispatch, std::move(wrappedTask));
+        reactor->schedule(Reactor::kDispatch, std::move(wrappedTask));
     } else {
-        _reactorHandle->schedule(Reactor::kPost, std::move(wrappedTask));
+        reactor->schedule(Reactor::kPost, std::move(wrappedTask));
     }
 
     _lastScheduleTimer.reset();
@@ -458,9 +485,38 @@ void ServiceExecutorAdaptive::_controllerThreadRoutine() {
     }
 }
 
+/*
+ * Picks the reactor shard a new worker thread should service. Threads started to satisfy the
+ * reserved minimum are dealt round-robin so that every shard keeps at least one worker. An asio
+ * run queue cannot be stolen from by threads running a different io_context, so when the pool is
+ * stuck or starved the new thread instead goes to the shard with the fewest workers - the shard
+ * most likely to be falling behind.
+ */
+size_t ServiceExecutorAdaptive::_nextShardId(ThreadCreationReason reason,
+                                             const stdx::unique_lock<stdx::mutex>& lk) {
+    if (_reactors.size() == 1) {
+        return 0;
+    }
+
+    if (reason == ThreadCreationReason::kReserveMinimum) {
+        return _nextReactor.fetchAndAdd(1) % _reactors.size();
+    }
+
+    std::vector<int> workersPerShard(_reactors.size(), 0);
+    for (auto& thread : _threads) {
+        workersPerShard[thread.shardId]++;
+    }
+
+    return std::distance(workersPerShard.begin(),
+                         std::min_element(workersPerShard.begin(), workersPerShard.end()));
+}
+
 void ServiceExecutorAdaptive::_startWorkerThread(ThreadCreationReason reason) {
     stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
+    auto shardId = _nextShardId(reason, lk);
     auto it = _threads.emplace(_threads.begin(), _tickSource);
+    it->shardId = shardId;
+    it->reactor = _reactors[shardId];
     auto num = _threads.size();
 
     _threadsPending.addAndFetch(1);
@@ -590,7 +646,7 @@ void ServiceExecutorAdaptive::_workerThreadRoutine(
         // If we're still "pending" only try to run one task, that way the controller will
         // know that it's okay to start adding threads to avoid starvation again.
         state->running.markRunning();
-        _reactorHandle->runFor(runTime);
+        state->reactor->runFor(runTime);
 
         auto spentRunning = state->running.markStopped();
 
@@ -48,6 +48,12 @@ namespace transport {
  * This is an ASIO-based adaptive ServiceExecutor. It guarantees that threads will not become stuck
  * or deadlocked longer that its configured timeout and that idle threads will terminate themselves
  * if they spend more than its configure idle threshold idle.
+ *
+ * The executor may be given several reactors (see transportLayerASIOIngressReactorShards), in
+ * which case each worker thread services exactly one of them. Since a session's network
+ * completions fire on the reactor its socket was bound to at accept time, and tasks scheduled
+ * from a worker thread stay on that worker's reactor, each session's entire task chain runs on
+ * one shard.
  */
 class ServiceExecutorAdaptive : public ServiceExecutor {
 public:
@@ -85,6 +91,10 @@ public:
     explicit ServiceExecutorAdaptive(ServiceContext* ctx,
                                      ReactorHandle reactor,
                                      std::unique_ptr<Options> config);
+    explicit ServiceExecutorAdaptive(ServiceContext* ctx, std::vector<ReactorHandle> reactors);
+    explicit ServiceExecutorAdaptive(ServiceContext* ctx,
+                                     std::vector<ReactorHandle> reactors,
+                                     std::unique_ptr<Options> config);
 
     ServiceExecutorAdaptive(ServiceExecutorAdaptive&&) = default;
     ServiceExecutorAdaptive& operator=(ServiceExecutorAdaptive&&) = default;
@@ -188,6 +198,10 @@ private:
         MetricsArray threadMetrics;
         std::int64_t markIdleCounter = 0;
         int recursionDepth = 0;
+
+        // The reactor shard this thread services, fixed at thread creation.
+        size_t shardId = 0;
+        ReactorHandle reactor;
     };
 
     using ThreadList = stdx::list<ThreadState>;
@@ -205,7 +219,13 @@ private:
     TickSource::Tick _getThreadTimerTotal(ThreadTimer which,
                                           const stdx::unique_lock<stdx::mutex>& lk) const;
 
-    ReactorHandle _reactorHandle;
+    size_t _nextShardId(ThreadCreationReason reason, const stdx::unique_lock<stdx::mutex>& lk);
+
+    std::vector<ReactorHandle> _reactors;
+
+    // Deals round-robin, both worker threads started to satisfy the reserved minimum and tasks
+    // scheduled from non-worker threads.
+    AtomicWord<unsigned> _nextReactor{0};
 
     std::unique_ptr<Options> _config;
 
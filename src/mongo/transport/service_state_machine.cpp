@@ -39,6 +39,7 @@
 #include "mongo/rpc/message.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/transport/message_buffer_pool.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/transport/service_executor_task_names.h"
@@ -298,6 +299,13 @@ const transport::SessionHandle& ServiceStateMachine::_session() const {
     return _sessionHandle;
 }
 
+void ServiceStateMachine::_releaseInMessage() {
+    auto buffer = _inMessage.sharedBuffer();
+    _inMessage.reset();
+    // The recycle is a no-op if something downstream still holds a reference to the buffer.
+    transport::MessageBufferPool::recycle(std::move(buffer));
+}
+
 void ServiceStateMachine::_sourceMessage(ThreadGuard guard) {
     invariant(_inMessage.empty());
     invariant(_state.load() == State::Source);
@@ -344,6 +352,82 @@ void ServiceStateMachine::_sinkMessage(ThreadGuard guard, Message toSink) {
     sinkMsgImpl().getAsync([this](Status status) { _sinkCallback(std::move(status)); });
 }
 
+void ServiceStateMachine::_sinkAndSourceMessage(ThreadGuard guard, Message toSink) {
+    invariant(_transportMode == transport::Mode::kAsynchronous);
+    invariant(_state.load() == State::Process);
+    _state.store(State::SinkWait);
+    _releaseInMessage();
+    _pipelineJoinPending.store(2);
+    guard.release();
+
+    _session()->asyncSinkMessage(std::move(toSink)).getAsync([this](Status status) {
+        if (!status.isOK()) {
+            // Unblock the concurrent read so the join can complete promptly.
+            _session()->cancelAsyncOperations();
+        }
+        _pipelinedSinkStatus = std::move(status);
+        _pipelineJoinCallback();
+    });
+
+    _session()->asyncSourceMessage().getAsync([this](StatusWith<Message> msg) {
+        if (msg.isOK()) {
+            _pipelinedMessage = std::move(msg.getValue());
+        } else {
+            // Unblock the concurrent write so the join can complete promptly.
+            _session()->cancelAsyncOperations();
+        }
+        _pipelinedSourceStatus = msg.getStatus();
+        _pipelineJoinCallback();
+    });
+}
+
+void ServiceStateMachine::_pipelineJoinCallback() {
+    // Whichever of the overlapped sink and source finishes last continues the state machine; the
+    // first to finish only records its result above.
+    if (_pipelineJoinPending.subtractAndFetch(1) > 0) {
+        return;
+    }
+
+    ThreadGuard guard(this);
+
+    dassert(state() == State::SinkWait);
+    auto remote = _session()->remote();
+
+    if (!_pipelinedSinkStatus.isOK()) {
+        log() << "Error sending response to client: " << _pipelinedSinkStatus
+              << ". Ending connection from " << remote
+              << " (connection id: " << _session()->id() << ")";
+        _state.store(State::EndSession);
+        return _runNextInGuard(std::move(guard));
+    }
+
+    const auto& sourceStatus = _pipelinedSourceStatus;
+    if (sourceStatus.isOK()) {
+        _inMessage = std::move(_pipelinedMessage);
+        invariant(!_inMessage.empty());
+        _state.store(State::Process);
+        return _scheduleNextWithGuard(std::move(guard),
+                                      ServiceExecutor::kMayRecurse,
+                                      transport::ServiceExecutorTaskName::kSSMProcessMessage);
+    } else if (ErrorCodes::isInterruption(sourceStatus.code()) ||
+               ErrorCodes::isNetworkError(sourceStatus.code())) {
+        LOG(2) << "Session from " << remote
+               << " encountered a network error during SourceMessage: " << sourceStatus;
+        _state.store(State::EndSession);
+    } else if (sourceStatus == TransportLayer::TicketSessionClosedStatus) {
+        // Our session may have been closed internally.
+        LOG(2) << "Session from " << remote << " was closed internally during SourceMessage";
+        _state.store(State::EndSession);
+    } else {
+        log() << "Error receiving request from client: " << sourceStatus
+              << ". Ending connection from " << remote
+              << " (connection id: " << _session()->id() << ")";
+        _state.store(State::EndSession);
+    }
+
+    _runNextInGuard(std::move(guard));
+}
+
 void ServiceStateMachine::_sourceCallback(Status status) {
     // The first thing to do is create a ThreadGuard which will take ownership of the SSM in this
     // thread.
@@ -428,6 +512,8 @@ void ServiceStateMachine::_processMessage(ThreadGuard guard) {
         MessageCompressorId compressorId;
         auto swm = compressorMgr.decompressMessage(_inMessage, &compressorId);
         uassertStatusOK(swm.getStatus());
+        // The compressed on-wire message is no longer needed; let the pool reuse its buffer.
+        _releaseInMessage();
         _inMessage = swm.getValue();
         _compressorId = compressorId;
     }
@@ -470,11 +556,21 @@ void ServiceStateMachine::_processMessage(ThreadGuard guard) {
             uassertStatusOK(swm.getStatus());
             toSink = swm.getValue();
         }
-        _sinkMessage(std::move(guard), std::move(toSink));
+
+        // In asynchronous mode the next request can be read while this response is being sunk,
+        // so that a client which pipelines requests on the connection overlaps its network
+        // transfers with our processing. Exhaust streams synthesize the next request locally, so
+        // there is nothing to read ahead for.
+        if (_transportMode == transport::Mode::kAsynchronous && !_inExhaust &&
+            _session()->supportsOverlappingIO()) {
+            _sinkAndSourceMessage(std::move(guard), std::move(toSink));
+        } else {
+            _sinkMessage(std::move(guard), std::move(toSink));
+        }
 
     } else {
         _state.store(State::Source);
-        _inMessage.reset();
+        _releaseInMessage();
         return _scheduleNextWithGuard(std::move(guard),
                                       ServiceExecutor::kDeferredTask,
                                       transport::ServiceExecutorTaskName::kSSMSourceMessage);
@@ -606,7 +702,7 @@ void ServiceStateMachine::_terminateAndLogIfError(Status status) {
 void ServiceStateMachine::_cleanupSession(ThreadGuard guard) {
     _state.store(State::Ended);
 
-    _inMessage.reset();
+    _releaseInMessage();
 
     // By ignoring the return value of Client::releaseCurrent() we destroy the session.
     // _dbClient is now nullptr and _dbClientPtr is invalid and should never be accessed.
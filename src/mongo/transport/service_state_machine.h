@@ -214,6 +214,22 @@ private:
     void _sourceMessage(ThreadGuard guard);
     void _sinkMessage(ThreadGuard guard, Message toSink);
 
+    /*
+     * Sinks the response while concurrently sourcing the next request from the TransportLayer, so
+     * that a client which pipelines requests on one connection does not pay a full network round
+     * trip between operations. Only used in asynchronous mode on sessions which support a
+     * concurrent read and write. The state machine stays in SinkWait until both operations have
+     * completed; _pipelineJoinCallback() runs the join.
+     */
+    void _sinkAndSourceMessage(ThreadGuard guard, Message toSink);
+    void _pipelineJoinCallback();
+
+    /*
+     * Drops '_inMessage' and offers its buffer to the MessageBufferPool, so the next sourced
+     * message on this thread can reuse it instead of allocating.
+     */
+    void _releaseInMessage();
+
     /*
      * Releases all the resources associated with the session and call the cleanupHook.
      */
@@ -237,6 +253,14 @@ private:
     boost::optional<MessageCompressorId> _compressorId;
     Message _inMessage;
 
+    // State for the overlapped sink/source performed by _sinkAndSourceMessage(). The callback
+    // which brings _pipelineJoinPending to zero may read the other fields; until then they are
+    // owned by the callback which wrote them.
+    AtomicWord<int> _pipelineJoinPending{0};
+    Message _pipelinedMessage;
+    Status _pipelinedSourceStatus = Status::OK();
+    Status _pipelinedSinkStatus = Status::OK();
+
     AtomicWord<Ownership> _owned{Ownership::kUnowned};
 #if MONGO_CONFIG_DEBUG_BUILD
     AtomicWord<stdx::thread::id> _owningThread;
@@ -116,6 +116,15 @@ public:
     virtual Future<void> asyncSinkMessage(Message message,
                                           const transport::BatonHandle& handle = nullptr) = 0;
 
+    /**
+     * Returns true if this session supports one outstanding asyncSourceMessage concurrently with
+     * one outstanding asyncSinkMessage. Callers of sessions which return false must never have
+     * both in flight at the same time.
+     */
+    virtual bool supportsOverlappingIO() const {
+        return false;
+    }
+
     /**
      * Cancel any outstanding async operations. There is no way to cancel synchronous calls.
      * Futures will finish with an ErrorCodes::CallbackCancelled error if they haven't already
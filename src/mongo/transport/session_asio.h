@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 
 #include "mongo/base/system_error.h"
@@ -35,7 +36,9 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
+#include "mongo/transport/message_buffer_pool.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -72,6 +75,10 @@ Future<void> futurize(const std::error_code& ec) {
 
 using GenericSocket = asio::generic::stream_protocol::socket;
 
+// How long an offloaded ingress TLS handshake may block one of the handshake pool's threads
+// before the socket timeout fails it. Bounds the damage a stalled client can do to the pool.
+constexpr auto kSSLHandshakeOffloadTimeout = Seconds{60};
+
 class TransportLayerASIO::ASIOSession final : public Session {
     MONGO_DISALLOW_COPYING(ASIOSession);
 
@@ -159,6 +166,15 @@ public:
             });
     }
 
+    bool supportsOverlappingIO() const override {
+#ifdef MONGO_CONFIG_SSL
+        // asio's ssl::stream does not support a concurrent read and write from different threads.
+        return !_sslSocket;
+#else
+        return true;
+#endif
+    }
+
     void cancelAsyncOperations(const transport::BatonHandle& baton = nullptr) override {
         LOG(3) << "Cancelling outstanding I/O operations on connection to " << _remote;
         if (baton) {
@@ -344,44 +360,103 @@ private:
     Future<Message> sourceMessageImpl(const transport::BatonHandle& baton = nullptr) {
         static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
-        auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-        auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
-            .then([ headerBuffer = std::move(headerBuffer), this, baton ]() mutable {
-                if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
-                    return sendHTTPResponse(baton);
-                }
+        // If the previous message arrived with trailing data, the next header (and possibly the
+        // whole next message) may already be sitting in the receive buffer.
+        if (_receiveEnd - _receiveBegin >= kHeaderSize) {
+            return sourceMessageFromReceiveBuffer(baton);
+        }
 
-                const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-                if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                    StringBuilder sb;
-                    sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                    const auto str = sb.str();
-                    LOG(0) << str;
+        if (!_receiveBuffer) {
+            _receiveBuffer = MessageBufferPool::acquire(kReceiveChunkSize);
+        }
 
-                    return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
-                }
+        // Compact any partial leftover to the front of the buffer so the header ends up
+        // contiguous.
+        const auto leftover = _receiveEnd - _receiveBegin;
+        if (_receiveBegin > 0) {
+            memmove(_receiveBuffer.get(), _receiveBuffer.get() + _receiveBegin, leftover);
+            _receiveBegin = 0;
+            _receiveEnd = leftover;
+        }
 
-                if (msgLen == kHeaderSize) {
-                    // This probably isn't a real case since all (current) messages have bodies.
-                    if (_isIngressSession) {
-                        networkCounter.hitPhysicalIn(msgLen);
-                    }
-                    return Future<Message>::makeReady(Message(std::move(headerBuffer)));
-                }
+        // Before the first message has established whether this connection is SSL, HTTP or plain
+        // wire protocol, the detection logic in read() must see exactly one header's worth of
+        // bytes. Reads through an SSL socket are buffered by the SSL layer already, so reading
+        // ahead only pays off on plain sockets.
+        const bool mayReadAhead = [&] {
+#ifdef MONGO_CONFIG_SSL
+            return _ranHandshake && !_sslSocket;
+#else
+            return true;
+#endif
+        }();
+
+        if (!mayReadAhead) {
+            invariant(leftover == 0);
+            return read(asio::buffer(_receiveBuffer.get(), kHeaderSize), baton)
+                .then([this, baton] {
+                    _receiveEnd = kHeaderSize;
+                    return sourceMessageFromReceiveBuffer(baton);
+                });
+        }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
-                memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
+        // Read at least the rest of the header, but claim as much as the kernel already has
+        // buffered, so that a batch of small messages (or a header and its body) arriving together
+        // costs a single recv call instead of one pair per message.
+        asio::mutable_buffer freeSpace(_receiveBuffer.get() + _receiveEnd,
+                                       kReceiveChunkSize - _receiveEnd);
+        return opportunisticReadAtLeast(_socket, freeSpace, kHeaderSize - leftover, baton)
+            .then([this, baton](size_t bytesRead) {
+                _receiveEnd += bytesRead;
+                return sourceMessageFromReceiveBuffer(baton);
+            });
+    }
 
-                MsgData::View msgView(buffer.get());
-                return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
-                    .then([ this, buffer = std::move(buffer), msgLen ]() mutable {
-                        if (_isIngressSession) {
-                            networkCounter.hitPhysicalIn(msgLen);
-                        }
-                        return Message(std::move(buffer));
-                    });
+    /**
+     * Assembles a Message from the receive buffer, which must hold at least a full header. Any
+     * part of the body which has not been received yet is read straight into the message's own
+     * buffer.
+     */
+    Future<Message> sourceMessageFromReceiveBuffer(const transport::BatonHandle& baton) {
+        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+        const auto available = _receiveEnd - _receiveBegin;
+        invariant(available >= kHeaderSize);
+        const char* headerPtr = _receiveBuffer.get() + _receiveBegin;
+
+        if (checkForHTTPRequest(asio::buffer(headerPtr, kHeaderSize))) {
+            return sendHTTPResponse(baton);
+        }
+
+        const auto msgLen = size_t(MSGHEADER::ConstView(headerPtr).getMessageLength());
+        if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+            StringBuilder sb;
+            sb << "recv(): message msgLen " << msgLen << " is invalid. "
+               << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+            const auto str = sb.str();
+            LOG(0) << str;
+
+            return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+        }
+
+        auto buffer = MessageBufferPool::acquire(msgLen);
+        const auto toCopy = std::min(available, msgLen);
+        memcpy(buffer.get(), headerPtr, toCopy);
+        _receiveBegin += toCopy;
+
+        if (toCopy == msgLen) {
+            if (_isIngressSession) {
+                networkCounter.hitPhysicalIn(msgLen);
+            }
+            return Future<Message>::makeReady(Message(std::move(buffer)));
+        }
+
+        return read(asio::buffer(buffer.get() + toCopy, msgLen - toCopy), baton)
+            .then([ this, buffer = std::move(buffer), msgLen ]() mutable {
+                if (_isIngressSession) {
+                    networkCounter.hitPhysicalIn(msgLen);
+                }
+                return Message(std::move(buffer));
             });
     }
 
@@ -481,6 +556,58 @@ private:
         }
     }
 
+    /**
+     * Like opportunisticRead, but completes as soon as at least 'atLeast' bytes have arrived,
+     * claiming up to the full size of 'buffer' if the kernel has more data ready. Returns the
+     * number of bytes read.
+     */
+    template <typename Stream>
+    Future<size_t> opportunisticReadAtLeast(Stream& stream,
+                                            const asio::mutable_buffer& buffer,
+                                            size_t atLeast,
+                                            const transport::BatonHandle& baton = nullptr) {
+        std::error_code ec;
+        size_t size;
+
+        if (MONGO_FAIL_POINT(transportLayerASIOshortOpportunisticReadWrite) &&
+            _blockingMode == Async) {
+            asio::mutable_buffer localBuffer = buffer;
+
+            if (buffer.size()) {
+                localBuffer = asio::mutable_buffer(buffer.data(), 1);
+            }
+
+            size = asio::read(stream, localBuffer, ec);
+            if (!ec && atLeast > 1) {
+                ec = asio::error::would_block;
+            }
+        } else {
+            size = asio::read(stream, buffer, asio::transfer_at_least(atLeast), ec);
+        }
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            // Fewer than 'atLeast' bytes were ready, so retry for the remainder. Whatever was read
+            // already counts towards the result.
+            asio::mutable_buffer asyncBuffer = buffer + size;
+            const auto stillNeeded = atLeast - size;
+
+            if (baton) {
+                return baton->addSession(*this, Baton::Type::In)
+                    .then([&stream, asyncBuffer, stillNeeded, baton, size, this] {
+                        return opportunisticReadAtLeast(stream, asyncBuffer, stillNeeded, baton)
+                            .then([size](size_t more) { return size + more; });
+                    });
+            }
+
+            return asio::async_read(
+                       stream, asyncBuffer, asio::transfer_at_least(stillNeeded), UseFuture{})
+                .then([size](size_t more) { return size + more; });
+        } else {
+            return futurize(ec, size);
+        }
+    }
+
     /**
      * moreToSend checks the ssl socket after an opportunisticWrite.  If there are still bytes to
      * send, we manually send them off the underlying socket.  Then we hook that up with a future
@@ -600,15 +727,46 @@ private:
             }
 
             _sslSocket.emplace(std::move(_socket), *_tl->_ingressSSLContext, "");
-            auto doHandshake = [&] {
+            auto doHandshake = [&]() -> Future<size_t> {
                 if (_blockingMode == Sync) {
                     std::error_code ec;
                     _sslSocket->handshake(asio::ssl::stream_base::server, buffer, ec);
                     return futurize(ec, asio::buffer_size(buffer));
-                } else {
-                    return _sslSocket->async_handshake(
-                        asio::ssl::stream_base::server, buffer, UseFuture{});
                 }
+
+                // If the transport layer has a handshake offload pool, run the handshake in
+                // blocking mode on one of its threads instead of asynchronously on the reactor.
+                // The handshake is the most CPU-intensive thing a reactor thread can be asked to
+                // do, and a storm of reconnecting clients running it inline stalls IO for every
+                // established session sharing the reactor. The certificate validation in the
+                // continuation below runs on the pool thread too, for the same reason.
+                if (_tl->_sslHandshakePool) {
+                    auto pf = makePromiseFuture<size_t>();
+                    auto promise = std::make_shared<Promise<size_t>>(std::move(pf.promise));
+                    auto scheduleStatus = _tl->_sslHandshakePool->schedule(
+                        [ this, anchor = shared_from_this(), buffer, promise ]() mutable {
+                            promise->setWith([&]() -> size_t {
+                                // The session is in async mode, so no caller has configured a
+                                // socket timeout (ensureAsync invariants that). Apply our own
+                                // for the blocking handshake and clear it again afterwards.
+                                setTimeout(Milliseconds{kSSLHandshakeOffloadTimeout});
+                                ensureSync();
+                                std::error_code ec;
+                                _sslSocket->handshake(asio::ssl::stream_base::server, buffer, ec);
+                                setTimeout(boost::none);
+                                ensureAsync();
+                                uassertStatusOK(errorCodeToStatus(ec));
+                                return asio::buffer_size(buffer);
+                            });
+                        });
+                    if (scheduleStatus.isOK()) {
+                        return std::move(pf.future);
+                    }
+                    // The pool has shut down; fall through to the reactor as if it were absent.
+                }
+
+                return _sslSocket->async_handshake(
+                    asio::ssl::stream_base::server, buffer, UseFuture{});
             };
             return doHandshake().then([this](size_t size) {
                 auto& sslPeerInfo = SSLPeerInfo::forSession(shared_from_this());
@@ -709,6 +867,15 @@ private:
     bool _ranHandshake = false;
 #endif
 
+    // A small per-session chunk which receives data directly off the socket, so that several
+    // small messages (or a header and its body) arriving together can be claimed with a single
+    // recv call. Bytes in [_receiveBegin, _receiveEnd) have been received off the wire but not
+    // yet consumed by sourceMessage. Allocated lazily on the first read.
+    static constexpr size_t kReceiveChunkSize = 4 * 1024;
+    SharedBuffer _receiveBuffer;
+    size_t _receiveBegin = 0;
+    size_t _receiveEnd = 0;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
@@ -32,6 +32,8 @@
 
 #include "mongo/transport/transport_layer_asio.h"
 
+#include <algorithm>
+
 #include <asio.hpp>
 #include <asio/system_timer.hpp>
 #include <boost/algorithm/string.hpp>
@@ -40,14 +42,17 @@
 
 #include "mongo/base/system_error.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/net/sockaddr.h"
 #include "mongo/util/net/ssl_manager.h"
 #include "mongo/util/net/ssl_options.h"
+#include "mongo/util/processinfo.h"
 
 #ifdef MONGO_CONFIG_SSL
 #include "mongo/util/net/ssl.hpp"
@@ -64,6 +69,22 @@ namespace transport {
 
 MONGO_FAIL_POINT_DEFINE(transportLayerASIOasyncConnectTimesOut);
 
+namespace {
+// The number of reactors the ingress sockets are sharded over. With the default of 1 all
+// ingress traffic runs on a single reactor, which is correct for the synchronous service
+// executor. With the adaptive service executor on many-core machines, setting this to the
+// number of cores gives each core its own run queue and epoll set and keeps each session's
+// work on one shard. Values are clamped to [1, number of cores].
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIOIngressReactorShards, int, 1);
+
+// The maximum number of threads dedicated to running ingress TLS handshakes off the
+// reactors. With the default of 0 handshakes for asynchronous sessions run inline on the
+// ingress reactors, where a reconnect storm of CPU-heavy handshakes can stall traffic on
+// established connections. Sessions served by the synchronous service executor already
+// handshake on their own thread and are unaffected by this parameter.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIOTLSHandshakeOffloadThreads, int, 0);
+}  // namespace
+
 class ASIOReactorTimer final : public ReactorTimer {
 public:
     explicit ASIOReactorTimer(asio::io_context& ctx)
@@ -224,8 +245,7 @@ TransportLayerASIO::Options::Options(const ServerGlobalParams* params)
 
 TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
                                        ServiceEntryPoint* sep)
-    : _ingressReactor(std::make_shared<ASIOReactor>()),
-      _egressReactor(std::make_shared<ASIOReactor>()),
+    : _egressReactor(std::make_shared<ASIOReactor>()),
       _acceptorReactor(std::make_shared<ASIOReactor>()),
 #ifdef MONGO_CONFIG_SSL
       _ingressSSLContext(nullptr),
@@ -233,6 +253,19 @@ TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
 #endif
       _sep(sep),
       _listenerOptions(opts) {
+    const auto maxShards = static_cast<int>(ProcessInfo::getNumAvailableCores());
+    auto numShards = transportLayerASIOIngressReactorShards.load();
+    if (numShards < 1 || numShards > maxShards) {
+        const auto clamped = std::min(std::max(numShards, 1), maxShards);
+        warning() << "transportLayerASIOIngressReactorShards must be between 1 and " << maxShards
+                  << ", using " << clamped;
+        numShards = clamped;
+    }
+
+    _ingressReactors.reserve(numShards);
+    for (auto i = 0; i < numShards; i++) {
+        _ingressReactors.push_back(std::make_shared<ASIOReactor>());
+    }
 }
 
 TransportLayerASIO::~TransportLayerASIO() = default;
@@ -734,6 +767,16 @@ Status TransportLayerASIO::setup() {
         if (!status.isOK()) {
             return status;
         }
+
+        const auto offloadThreads = transportLayerASIOTLSHandshakeOffloadThreads.load();
+        if (offloadThreads > 0) {
+            ThreadPool::Options options;
+            options.poolName = "TLSHandshake";
+            options.minThreads = 0;
+            options.maxThreads = static_cast<size_t>(offloadThreads);
+            _sslHandshakePool = stdx::make_unique<ThreadPool>(std::move(options));
+            _sslHandshakePool->startup();
+        }
     }
 
     if (_listenerOptions.isEgress() && sslManager) {
@@ -811,12 +854,21 @@ void TransportLayerASIO::shutdown() {
         _acceptorReactor->stop();
         _listenerThread.join();
     }
+
+#ifdef MONGO_CONFIG_SSL
+    // Refuse new offloaded handshakes and wait for any in flight to finish; their sessions
+    // will be torn down along with the rest of the ingress traffic.
+    if (_sslHandshakePool) {
+        _sslHandshakePool->shutdown();
+        _sslHandshakePool->join();
+    }
+#endif
 }
 
 ReactorHandle TransportLayerASIO::getReactor(WhichReactor which) {
     switch (which) {
         case TransportLayer::kIngress:
-            return _ingressReactor;
+            return _ingressReactors.front();
         case TransportLayer::kEgress:
             return _egressReactor;
         case TransportLayer::kNewReactor:
@@ -826,6 +878,10 @@ ReactorHandle TransportLayerASIO::getReactor(WhichReactor which) {
     MONGO_UNREACHABLE;
 }
 
+std::vector<ReactorHandle> TransportLayerASIO::getIngressReactors() {
+    return std::vector<ReactorHandle>(_ingressReactors.begin(), _ingressReactors.end());
+}
+
 void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
     auto acceptCb = [this, &acceptor](const std::error_code& ec, GenericSocket peerSocket) mutable {
         if (!_running.load())
@@ -849,7 +905,11 @@ void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
         _acceptConnection(acceptor);
     };
 
-    acceptor.async_accept(*_ingressReactor, std::move(acceptCb));
+    // The peer socket is constructed on one of the ingress reactor shards, which pins the
+    // session's networking to that shard for its lifetime.
+    auto& ingressReactor =
+        _ingressReactors[_nextIngressReactor.fetchAndAdd(1) % _ingressReactors.size()];
+    acceptor.async_accept(*ingressReactor, std::move(acceptCb));
 }
 
 #ifdef MONGO_CONFIG_SSL
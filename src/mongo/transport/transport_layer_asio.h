@@ -30,6 +30,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/config.h"
@@ -64,6 +65,7 @@ namespace mongo {
 
 class ServiceContext;
 class ServiceEntryPoint;
+class ThreadPool;
 
 namespace transport {
 
@@ -126,6 +128,14 @@ public:
 
     ReactorHandle getReactor(WhichReactor which) final;
 
+    /**
+     * Returns all of the ingress reactor shards. There is more than one shard only if
+     * transportLayerASIOIngressReactorShards is set; each accepted session is bound to one
+     * shard for its lifetime, so callers that service ingress traffic (the adaptive service
+     * executor) must run all of them.
+     */
+    std::vector<ReactorHandle> getIngressReactors();
+
     Status start() final;
 
     void shutdown() final;
@@ -158,11 +168,16 @@ private:
 
     stdx::mutex _mutex;
 
-    // There are three reactors that are used by TransportLayerASIO. The _ingressReactor contains
-    // all the accepted sockets and all ingress networking activity. The _acceptorReactor contains
-    // all the sockets in _acceptors.  The _egressReactor contains egress connections.
+    // There are three kinds of reactors that are used by TransportLayerASIO. The
+    // _ingressReactors contain all the accepted sockets and all ingress networking activity;
+    // there is normally one of them, but transportLayerASIOIngressReactorShards can shard the
+    // ingress sockets over several reactors (one per core, say) so that the worker threads of
+    // the adaptive service executor do not all contend on a single run queue and epoll set.
+    // Sockets are dealt to a shard round-robin at accept time and stay there for the life of
+    // the session. The _acceptorReactor contains all the sockets in _acceptors. The
+    // _egressReactor contains egress connections.
     //
-    // TransportLayerASIO should never call run() on the _ingressReactor.
+    // TransportLayerASIO should never call run() on the _ingressReactors.
     // In synchronous mode, this will cause a massive performance degradation due to
     // unnecessary wakeups on the asio thread for sockets we don't intend to interact
     // with asynchronously. The additional IO context avoids registering those sockets
@@ -180,13 +195,23 @@ private:
     // state that is associated with the reactors), so that we destroy any existing acceptors or
     // other reactor associated state before we drop the refcount on the reactor, which may destroy
     // it.
-    std::shared_ptr<ASIOReactor> _ingressReactor;
+    std::vector<std::shared_ptr<ASIOReactor>> _ingressReactors;
     std::shared_ptr<ASIOReactor> _egressReactor;
     std::shared_ptr<ASIOReactor> _acceptorReactor;
 
+    // Deals accepted sockets to the _ingressReactors round-robin. Only advanced by accept
+    // callbacks on the _acceptorReactor, but atomic to be safe against multiple acceptors.
+    AtomicWord<unsigned> _nextIngressReactor{0};
+
 #ifdef MONGO_CONFIG_SSL
     std::unique_ptr<asio::ssl::context> _ingressSSLContext;
     std::unique_ptr<asio::ssl::context> _egressSSLContext;
+
+    // Runs ingress TLS handshakes for asynchronous sessions so that the CPU cost of a
+    // reconnect storm does not stall established-connection traffic on the ingress
+    // reactors. Only created when transportLayerASIOTLSHandshakeOffloadThreads is
+    // positive; when absent, handshakes run inline on the reactors as before.
+    std::unique_ptr<ThreadPool> _sslHandshakePool;
 #endif
 
     std::vector<std::pair<SockAddr, GenericAcceptor>> _acceptors;
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/allocation_accounting.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+namespace allocation_accounting {
+namespace {
+
+thread_local Subsystem currentSubsystem = Subsystem::kNone;
+
+struct Counters {
+    AtomicInt64 bytes;
+    AtomicInt64 allocations;
+};
+
+Counters counters[static_cast<size_t>(Subsystem::kNumSubsystems)];
+
+// Indexed by Subsystem; kNone has no entry in the report.
+const char* const kSubsystemNames[] = {
+    "none", "planCache", "cursors", "sessions", "aggregation",
+};
+
+}  // namespace
+
+ScopedSubsystemTag::ScopedSubsystemTag(Subsystem subsystem) : _previous(currentSubsystem) {
+    currentSubsystem = subsystem;
+}
+
+ScopedSubsystemTag::~ScopedSubsystemTag() {
+    currentSubsystem = _previous;
+}
+
+void recordAllocation(size_t size) {
+    const Subsystem tag = currentSubsystem;
+    if (tag == Subsystem::kNone) {
+        return;
+    }
+    Counters& c = counters[static_cast<size_t>(tag)];
+    c.bytes.addAndFetch(size);
+    c.allocations.addAndFetch(1);
+}
+
+void appendStats(BSONObjBuilder* builder) {
+    for (size_t i = 1; i < static_cast<size_t>(Subsystem::kNumSubsystems); i++) {
+        BSONObjBuilder sub(builder->subobjStart(kSubsystemNames[i]));
+        sub.appendNumber("bytes", counters[i].bytes.load());
+        sub.appendNumber("allocations", counters[i].allocations.load());
+        sub.doneFast();
+    }
+}
+
+}  // namespace allocation_accounting
+}  // namespace mongo
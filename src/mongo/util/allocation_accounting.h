@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/base/disallow_copying.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+namespace allocation_accounting {
+
+/**
+ * Subsystems that allocations can be attributed to. kNone allocations are not counted.
+ */
+enum class Subsystem : int {
+    kNone = 0,
+    kPlanCache,
+    kCursors,
+    kSessions,
+    kAggregation,
+
+    kNumSubsystems  // Must be last.
+};
+
+/**
+ * Attributes the allocations made by the current thread to 'subsystem' for the guard's
+ * lifetime. Nests: the previous tag is restored on destruction.
+ *
+ * Counting happens in the allocator's new hook, so a tag costs two thread-local stores and is
+ * cheap enough to place around any cache-populating or state-building code path. The counters
+ * are cumulative allocated bytes, not live bytes: frees are not attributed (a free may happen
+ * on a different thread, under a different tag, than the allocation it pairs with). Cumulative
+ * growth rates are what narrow down which subsystem is behind RSS growth.
+ *
+ * Only effective when the server runs with tcmalloc; with other allocators the counters stay
+ * zero.
+ */
+class ScopedSubsystemTag {
+    MONGO_DISALLOW_COPYING(ScopedSubsystemTag);
+
+public:
+    explicit ScopedSubsystemTag(Subsystem subsystem);
+    ~ScopedSubsystemTag();
+
+private:
+    Subsystem _previous;
+};
+
+/**
+ * Charges an allocation of 'size' bytes to the current thread's tag, if any. Called from the
+ * allocator's new hook; must not allocate.
+ */
+void recordAllocation(size_t size);
+
+/**
+ * Appends the per-subsystem counters: {<subsystem>: {bytes: ..., allocations: ...}, ...}.
+ */
+void appendStats(BSONObjBuilder* builder);
+
+}  // namespace allocation_accounting
+}  // namespace mongo
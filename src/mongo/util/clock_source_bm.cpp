@@ -34,6 +34,7 @@
 #include "mongo/util/fast_clock_source_factory.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/system_clock_source.h"
+#include "mongo/util/tsc_clock_source.h"
 
 namespace mongo {
 namespace {
@@ -41,7 +42,8 @@ namespace {
 /**
  * Benchmark calls to the now() method of a clock source. With an argument of 0,
  * tests the system clock source, and with larger values, uses the FastClockSource
- * with a clock resolution of the specified number of milliseconds.
+ * with a clock resolution of the specified number of milliseconds. An argument of
+ * -1 tests the TSC clock source, where the host CPU supports it.
  *
  * All threads executing the benchmark use the same instance of the clock source,
  * to allow benchmarking to identify synchronization costs inside the now() method.
@@ -53,8 +55,14 @@ void BM_ClockNow(benchmark::State& state) {
             clock = FastClockSourceFactory::create(Milliseconds{state.range(0)});
         } else if (state.range(0) == 0) {
             clock = std::make_unique<SystemClockSource>();
+        } else if (state.range(0) == -1) {
+            clock = TSCClockSource::makeIfSupported();
+            if (!clock) {
+                state.SkipWithError("no invariant TSC on this host");
+                return;
+            }
         } else {
-            state.SkipWithError("poll period must be non-negative");
+            state.SkipWithError("poll period must be non-negative or -1");
             return;
         }
     }
@@ -71,6 +79,7 @@ void BM_ClockNow(benchmark::State& state) {
 BENCHMARK(BM_ClockNow)
     ->ThreadRange(1, ProcessInfo::getNumAvailableCores())
     ->ArgName("poll period")
+    ->Arg(-1)
     ->Arg(0)
     ->Arg(1)
     ->Arg(10);
@@ -91,6 +91,11 @@ private:
 
 #else
 
+/**
+ * An adaptive lock for very short critical sections: on contention acquirers spin with
+ * bounded exponential backoff, then yield, and finally sleep between attempts, so a
+ * contended lock degrades gracefully rather than burning a core indefinitely.
+ */
 class SpinLock {
     MONGO_DISALLOW_COPYING(SpinLock);
 
@@ -215,7 +215,53 @@ Status ThreadPool::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
-    _workAvailable.notify_one();
+    // No thread needs waking unless one is idle; busy threads re-check _pendingTasks under the
+    // mutex before they wait on _workAvailable, so they cannot miss this task.
+    if (_numIdleThreads > 0) {
+        _workAvailable.notify_one();
+    }
+    return Status::OK();
+}
+
+Status ThreadPool::scheduleBatch(std::vector<Task> tasks) {
+    if (tasks.empty()) {
+        return Status::OK();
+    }
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    switch (_state) {
+        case joinRequired:
+        case joining:
+        case shutdownComplete:
+            return Status(ErrorCodes::ShutdownInProgress,
+                          str::stream() << "Shutdown of thread pool " << _options.poolName
+                                        << " in progress");
+        case preStart:
+        case running:
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+    for (auto& task : tasks) {
+        _pendingTasks.emplace_back(std::move(task));
+    }
+    if (_state == preStart) {
+        return Status::OK();
+    }
+    for (size_t i = 0; i < tasks.size() && _numIdleThreads < _pendingTasks.size(); ++i) {
+        _startWorkerThread_inlock();
+    }
+    if (_numIdleThreads <= _pendingTasks.size()) {
+        _lastFullUtilizationDate = Date_t::now();
+    }
+    // Signal once for the whole burst rather than once per task. As in schedule(), only idle
+    // threads need waking; busy threads re-check _pendingTasks under the mutex before waiting.
+    if (_numIdleThreads > 0) {
+        if (tasks.size() > 1) {
+            _workAvailable.notify_all();
+        } else {
+            _workAvailable.notify_one();
+        }
+    }
     return Status::OK();
 }
 
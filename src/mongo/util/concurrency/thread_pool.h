@@ -118,6 +118,7 @@ public:
     void shutdown() override;
     void join() override;
     Status schedule(Task task) override;
+    Status scheduleBatch(std::vector<Task> tasks) override;
 
     /**
      * Blocks the caller until there are no pending tasks on this pool.
@@ -28,13 +28,14 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
 #include "mongo/stdx/functional.h"
 
 namespace mongo {
 
-class Status;
-
 /**
  * Interface for a thread pool.
  */
@@ -83,6 +84,24 @@ public:
      */
     virtual Status schedule(Task task) = 0;
 
+    /**
+     * Schedules a burst of tasks to run in the thread pool.
+     *
+     * Equivalent to calling schedule() on each task in order, but implementations may enqueue
+     * the whole burst under one lock acquisition and wake worker threads once, rather than
+     * paying that cost per task. Stops at the first failure and returns its status; the tasks
+     * after it are not scheduled.
+     */
+    virtual Status scheduleBatch(std::vector<Task> tasks) {
+        for (auto& task : tasks) {
+            auto status = schedule(std::move(task));
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
 protected:
     ThreadPoolInterface() = default;
 };
@@ -177,6 +177,45 @@ TEST_F(ThreadPoolTest, MaxPoolSize20MinPoolSize15) {
         << "Failed to reap excess threads after " << durationCount<Milliseconds>(reapTime) << "ms";
 }
 
+TEST_F(ThreadPoolTest, ScheduleBatchRunsAllTasks) {
+    ThreadPool::Options options;
+    options.minThreads = 0;
+    options.maxThreads = 4;
+    auto& pool = makePool(options);
+
+    // A batch scheduled before startup() is queued and runs once the pool starts.
+    std::vector<ThreadPool::Task> preStartBatch;
+    for (size_t i = 0U; i < 5U; ++i) {
+        preStartBatch.emplace_back([this] { blockingWork(); });
+    }
+    ASSERT_OK(pool.scheduleBatch(std::move(preStartBatch)));
+    ASSERT_EQUALS(5U, pool.getStats().numPendingTasks);
+
+    pool.startup();
+    stdx::unique_lock<stdx::mutex> lk(mutex);
+    while (count1 < 4U) {
+        cv1.wait(lk);
+    }
+    ASSERT_EQ(4U, pool.getStats().numThreads);
+    flag2 = true;
+    cv2.notify_all();
+    while (count1 < 5U) {
+        cv1.wait(lk);
+    }
+    lk.unlock();
+    pool.waitForIdle();
+
+    // An empty batch is a no-op.
+    ASSERT_OK(pool.scheduleBatch({}));
+
+    pool.shutdown();
+    pool.join();
+    std::vector<ThreadPool::Task> postShutdownBatch;
+    postShutdownBatch.emplace_back([] {});
+    ASSERT_EQUALS(ErrorCodes::ShutdownInProgress,
+                  pool.scheduleBatch(std::move(postShutdownBatch)));
+}
+
 DEATH_TEST(ThreadPoolTest, MaxThreadsTooFewDies, "but the maximum must be at least 1") {
     ThreadPool::Options options;
     options.maxThreads = 0;
@@ -35,6 +35,7 @@
 
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -68,61 +69,62 @@ void tsFromDate(const Date_t& deadline, struct timespec& ts) {
 }
 }  // namespace
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
+TicketHolder::TicketHolder(int num, int reservedForInternal)
+    : _outof(num), _reservedForInternal(reservedForInternal) {
+    invariant(reservedForInternal >= 0 && reservedForInternal <= num);
     check(sem_init(&_sem, 0, num));
+    if (_reservedForInternal > 0) {
+        check(sem_init(&_userSem, 0, num - _reservedForInternal));
+    }
 }
 
 TicketHolder::~TicketHolder() {
     check(sem_destroy(&_sem));
+    if (_reservedForInternal > 0) {
+        check(sem_destroy(&_userSem));
+    }
 }
 
-bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
+bool TicketHolder::tryAcquire(Lane lane) {
+    if (lane == Lane::kUser && _reservedForInternal > 0) {
+        if (!_tryAcquireSem(&_userSem)) {
             return false;
-        if (errno != EINTR)
-            failWithErrno(errno);
+        }
+        if (!_tryAcquireSem(&_sem)) {
+            check(sem_post(&_userSem));
+            return false;
+        }
+        return true;
     }
-    return true;
+    return _tryAcquireSem(&_sem);
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, Lane lane) {
+    waitForTicketUntil(opCtx, Date_t::max(), lane);
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until, Lane lane) {
+    if (lane == Lane::kUser && _reservedForInternal > 0) {
+        if (!_waitForSemUntil(&_userSem, opCtx, until)) {
+            return false;
         }
-
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
+        // If the total pool cannot be acquired, give the user-lane ticket back, including when
+        // the wait is interrupted and throws.
+        auto returnUserTicket = MakeGuard([&] { check(sem_post(&_userSem)); });
+        if (!_waitForSemUntil(&_sem, opCtx, until)) {
+            return false;
+        }
+        returnUserTicket.Dismiss();
+        return true;
     }
-    return true;
+    return _waitForSemUntil(&_sem, opCtx, until);
 }
 
-void TicketHolder::release() {
+void TicketHolder::release(Lane lane) {
     check(sem_post(&_sem));
+    if (lane == Lane::kUser && _reservedForInternal > 0) {
+        check(sem_post(&_userSem));
+    }
 }
 
 Status TicketHolder::resize(int newSize) {
@@ -138,6 +140,13 @@ Status TicketHolder::resize(int newSize) {
                                     << "; given "
                                     << newSize);
 
+    if (newSize <= _reservedForInternal)
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Size must exceed the " << _reservedForInternal
+                                    << " tickets reserved for internal operations; given "
+                                    << newSize);
+
+    // Release and acquire through the user lane so both semaphores stay consistent.
     while (_outof.load() < newSize) {
         release();
         _outof.fetchAndAdd(1);
@@ -166,40 +175,84 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
+bool TicketHolder::_tryAcquireSem(sem_t* sem) {
+    while (0 != sem_trywait(sem)) {
+        if (errno == EAGAIN)
+            return false;
+        if (errno != EINTR)
+            failWithErrno(errno);
+    }
+    return true;
+}
+
+bool TicketHolder::_waitForSemUntil(sem_t* sem, OperationContext* opCtx, Date_t until) {
+    const Milliseconds intervalMs(500);
+    struct timespec ts;
+
+    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
+    // timed wait on an interval to periodically check for interrupts.
+    // The wait period interval is the smaller of the default interval and the provided
+    // deadline.
+    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
+    tsFromDate(deadline, ts);
+
+    while (0 != sem_timedwait(sem, &ts)) {
+        if (errno == ETIMEDOUT) {
+            // If we reached the deadline without being interrupted, we have completely timed out.
+            if (deadline == until)
+                return false;
+
+            deadline = std::min(until, Date_t::now() + intervalMs);
+            tsFromDate(deadline, ts);
+        } else if (errno != EINTR) {
+            failWithErrno(errno);
+        }
+
+        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
+        // It is possible to unset 'errno' after a call to checkForInterrupt().
+        if (opCtx)
+            opCtx->checkForInterrupt();
+    }
+    return true;
+}
+
 #else
 
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
+TicketHolder::TicketHolder(int num, int reservedForInternal)
+    : _outof(num), _num(num), _reservedForInternal(reservedForInternal) {
+    invariant(reservedForInternal >= 0 && reservedForInternal <= num);
+}
 
 TicketHolder::~TicketHolder() = default;
 
-bool TicketHolder::tryAcquire() {
+bool TicketHolder::tryAcquire(Lane lane) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    return _tryAcquire();
+    return _tryAcquire(lane);
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
+void TicketHolder::waitForTicket(OperationContext* opCtx, Lane lane) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
 
     if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
+        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [&] { return _tryAcquire(lane); });
     } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+        _newTicket.wait(lk, [&] { return _tryAcquire(lane); });
     }
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until, Lane lane) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
 
     if (opCtx) {
         return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
+            _newTicket, lk, until, [&] { return _tryAcquire(lane); });
     } else {
         return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+            lk, until.toSystemTimePoint(), [&] { return _tryAcquire(lane); });
     }
 }
 
-void TicketHolder::release() {
+void TicketHolder::release(Lane lane) {
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
         _num++;
@@ -210,6 +263,12 @@ void TicketHolder::release() {
 Status TicketHolder::resize(int newSize) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
+    if (newSize <= _reservedForInternal)
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Size must exceed the " << _reservedForInternal
+                                    << " tickets reserved for internal operations; given "
+                                    << newSize);
+
     int used = _outof.load() - _num;
     if (used > newSize) {
         std::stringstream ss;
@@ -241,8 +300,10 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
+bool TicketHolder::_tryAcquire(Lane lane) {
+    // User-lane acquirers may not take the tickets reserved for internal operations.
+    const int reservedFloor = (lane == Lane::kUser) ? _reservedForInternal : 0;
+    if (_num <= reservedFloor) {
         if (_num < 0) {
             std::cerr << "DISASTER! in TicketHolder" << std::endl;
         }
@@ -252,4 +313,4 @@ bool TicketHolder::_tryAcquire() {
     return true;
 }
 #endif
-}
+}  // namespace mongo
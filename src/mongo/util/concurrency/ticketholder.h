@@ -43,17 +43,29 @@ class TicketHolder {
     MONGO_DISALLOW_COPYING(TicketHolder);
 
 public:
-    explicit TicketHolder(int num);
+    /**
+     * The admission lane an acquirer belongs to. Acquirers in the kInternal lane (replication
+     * and other internal operations whose progress the user workload depends on) may consume
+     * the tickets reserved at construction, so under saturation they do not queue behind user
+     * operations. A ticket must be released to the same lane it was acquired from.
+     */
+    enum class Lane { kUser, kInternal };
+
+    /**
+     * Creates a holder handing out 'num' tickets, of which 'reservedForInternal' may only be
+     * claimed by acquirers in the kInternal lane.
+     */
+    explicit TicketHolder(int num, int reservedForInternal = 0);
     ~TicketHolder();
 
-    bool tryAcquire();
+    bool tryAcquire(Lane lane = Lane::kUser);
 
     /**
      * Attempts to acquire a ticket. Blocks until a ticket is acquired or the OperationContext
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, Lane lane = Lane::kUser);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -65,11 +77,11 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx, Date_t until, Lane lane = Lane::kUser);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
-    void release();
+    void release(Lane lane = Lane::kUser);
 
     Status resize(int newSize);
 
@@ -81,19 +93,28 @@ public:
 
 private:
 #if defined(__linux__)
+    bool _tryAcquireSem(sem_t* sem);
+    bool _waitForSemUntil(sem_t* sem, OperationContext* opCtx, Date_t until);
+
+    // Every ticket is represented in _sem. When tickets are reserved for the internal lane,
+    // user-lane acquirers must additionally pass _userSem, which holds num - reserved tickets,
+    // so the last reserved tickets can only ever be claimed by internal operations.
     mutable sem_t _sem;
+    mutable sem_t _userSem;  // Only initialized when _reservedForInternal > 0.
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicInt32 _outof;
     stdx::mutex _resizeMutex;
 #else
-    bool _tryAcquire();
+    bool _tryAcquire(Lane lane);
 
     AtomicInt32 _outof;
     int _num;
     stdx::mutex _mutex;
     stdx::condition_variable _newTicket;
 #endif
+
+    const int _reservedForInternal;
 };
 
 class ScopedTicket {
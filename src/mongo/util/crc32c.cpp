@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/crc32c.h"
+
+#include <cstring>
+
+#include "mongo/platform/endian.h"
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#elif defined(__x86_64__) || defined(_M_X64)
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace mongo {
+namespace {
+
+// All implementations below take and return the running CRC state with the standard inversion
+// already applied; the public crc32c() does the initial and final inversions.
+using Crc32cImpl = uint32_t (*)(uint32_t, const char*, size_t);
+
+// Slicing-by-8 lookup tables for the Castagnoli polynomial, generated on first use rather than
+// pasted in as 8kB of hex constants.
+struct Crc32cTables {
+    Crc32cTables() {
+        for (int i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int j = 0; j < 8; ++j) {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78u : 0);
+            }
+            byByte[0][i] = crc;
+        }
+        for (int i = 0; i < 256; ++i) {
+            uint32_t crc = byByte[0][i];
+            for (int slice = 1; slice < 8; ++slice) {
+                crc = byByte[0][crc & 0xff] ^ (crc >> 8);
+                byByte[slice][i] = crc;
+            }
+        }
+    }
+
+    uint32_t byByte[8][256];
+};
+
+const Crc32cTables& crcTables() {
+    static const Crc32cTables tables{};
+    return tables;
+}
+
+uint32_t crc32cSoftware(uint32_t crc, const char* data, size_t length) {
+    const auto& table = crcTables().byByte;
+
+    // Consume bytes until the cursor is 8-byte aligned, then process one word per iteration.
+    while (length > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = table[0][(crc ^ static_cast<uint8_t>(*data++)) & 0xff] ^ (crc >> 8);
+        --length;
+    }
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        word = endian::littleToNative(word) ^ crc;
+        crc = table[7][word & 0xff] ^ table[6][(word >> 8) & 0xff] ^
+            table[5][(word >> 16) & 0xff] ^ table[4][(word >> 24) & 0xff] ^
+            table[3][(word >> 32) & 0xff] ^ table[2][(word >> 40) & 0xff] ^
+            table[1][(word >> 48) & 0xff] ^ table[0][(word >> 56) & 0xff];
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = table[0][(crc ^ static_cast<uint8_t>(*data++)) & 0xff] ^ (crc >> 8);
+        --length;
+    }
+    return crc;
+}
+
+#if defined(__ARM_FEATURE_CRC32)
+
+// The whole binary already requires the CRC32 extension when this is defined, so there is no
+// runtime feature check to do.
+uint32_t crc32cHardware(uint32_t crc, const char* data, size_t length) {
+    while (length > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = __crc32cb(crc, static_cast<uint8_t>(*data++));
+        --length;
+    }
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = __crc32cb(crc, static_cast<uint8_t>(*data++));
+        --length;
+    }
+    return crc;
+}
+
+bool haveHardwareCrc32c() {
+    return true;
+}
+
+#elif defined(__x86_64__) || defined(_M_X64)
+
+#ifndef _MSC_VER
+// The TU is not compiled with -msse4.2 (the baseline target predates it), so the intrinsics
+// must be enabled per-function and only called after the cpuid check below.
+__attribute__((target("sse4.2")))
+#endif
+uint32_t crc32cHardware(uint32_t crc, const char* data, size_t length) {
+    while (length > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data++));
+        --length;
+    }
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data++));
+        --length;
+    }
+    return crc;
+}
+
+bool haveHardwareCrc32c() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return info[2] & (1 << 20);  // SSE4.2 feature bit.
+#else
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+#else
+
+uint32_t crc32cHardware(uint32_t crc, const char* data, size_t length) {
+    return crc32cSoftware(crc, data, length);
+}
+
+bool haveHardwareCrc32c() {
+    return false;
+}
+
+#endif
+
+const Crc32cImpl globalCrc32cImpl = haveHardwareCrc32c() ? crc32cHardware : crc32cSoftware;
+
+}  // namespace
+
+uint32_t crc32c(const void* data, size_t length) {
+    return ~globalCrc32cImpl(~uint32_t{0}, static_cast<const char*>(data), length);
+}
+
+uint32_t crc32c(uint32_t crc, const void* data, size_t length) {
+    return ~globalCrc32cImpl(~crc, static_cast<const char*>(data), length);
+}
+
+}  // namespace mongo
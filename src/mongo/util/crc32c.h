@@ -0,0 +1,53 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mongo {
+
+/**
+ * Returns the CRC-32C (Castagnoli polynomial, as used by the OP_MSG wire protocol, iSCSI and
+ * others) of "length" bytes starting at "data".
+ *
+ * Dispatches at startup to the SSE4.2 or ARMv8 CRC instructions when the CPU has them, and
+ * otherwise to a table-driven software implementation, so callers may use this on hot paths
+ * without their own feature checks.
+ */
+uint32_t crc32c(const void* data, size_t length);
+
+/**
+ * Continues a CRC-32C over data arriving in pieces: passing the result of checksumming one chunk
+ * as 'crc' for the next yields the same value as a single call over the concatenated bytes. Start
+ * from 0 (the CRC of the empty string) for the first chunk.
+ */
+uint32_t crc32c(uint32_t crc, const void* data, size_t length);
+
+}  // namespace mongo
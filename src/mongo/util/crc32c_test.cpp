@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cstring>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/crc32c.h"
+
+namespace mongo {
+namespace {
+
+// Standard CRC-32C test vectors, from RFC 3720 appendix B.4.
+TEST(Crc32c, KnownVectors) {
+    ASSERT_EQUALS(0u, crc32c("", 0));
+    ASSERT_EQUALS(0xE3069283u, crc32c("123456789", 9));
+
+    unsigned char buf[32];
+    memset(buf, 0, sizeof(buf));
+    ASSERT_EQUALS(0x8A9136AAu, crc32c(buf, sizeof(buf)));
+
+    memset(buf, 0xff, sizeof(buf));
+    ASSERT_EQUALS(0x62A8AB43u, crc32c(buf, sizeof(buf)));
+
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = static_cast<unsigned char>(i);
+    }
+    ASSERT_EQUALS(0x46DD794Eu, crc32c(buf, sizeof(buf)));
+}
+
+// The word-at-a-time loops have byte-at-a-time pre- and post-ambles; make sure every
+// alignment and length remainder produces the same answer.
+TEST(Crc32c, MisalignedInput) {
+    char buf[64];
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t length = 1; length <= 9; ++length) {
+            memcpy(buf + offset, "123456789", length);
+            char aligned[16] = {};
+            memcpy(aligned, "123456789", length);
+            ASSERT_EQUALS(crc32c(aligned, length), crc32c(buf + offset, length))
+                << "offset " << offset << " length " << length;
+        }
+    }
+}
+
+TEST(Crc32c, IncrementalMatchesOneShot) {
+    const char data[] = "123456789";
+    for (size_t split = 0; split <= 9; ++split) {
+        uint32_t crc = crc32c(data, split);
+        crc = crc32c(crc, data + split, 9 - split);
+        ASSERT_EQUALS(0xE3069283u, crc) << "split " << split;
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -135,6 +135,27 @@ TEST(DecorableTest, SimpleDecoration) {
     ASSERT_EQ(4, numDestructedAs);
 }
 
+TEST(DecorableTest, TriviallyConstructibleDecorationsAreZeroInitialized) {
+    // Decorations with trivial default constructors register no constructor function and rely
+    // on the container zero initializing its buffer instead.
+    struct Pod {
+        int x;
+        long long y;
+        void* p;
+    };
+    DecorationRegistry<MyDecorable> registry;
+    const auto pod = registry.declareDecoration<Pod>();
+    const auto a = registry.declareDecoration<A>();  // Interleave a non-trivial decoration.
+    const auto i = registry.declareDecoration<int>();
+
+    DecorationContainer<MyDecorable> decorable(nullptr, &registry);
+    ASSERT_EQ(0, decorable.getDecoration(pod).x);
+    ASSERT_EQ(0LL, decorable.getDecoration(pod).y);
+    ASSERT(decorable.getDecoration(pod).p == nullptr);
+    ASSERT_EQ(0, decorable.getDecoration(a).value);
+    ASSERT_EQ(0, decorable.getDecoration(i));
+}
+
 #ifndef __s390x__
 // TODO(SERVER-34872) Re-enable this test, when we know that s390x will have correct exception
 // unwind handling.
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <type_traits>
@@ -61,6 +62,12 @@ public:
      * Declares a decoration of type T, constructed with T's default constructor, and
      * returns a descriptor for accessing that decoration.
      *
+     * Decorations with a trivial default constructor or destructor register no constructor or
+     * destructor function at all: value initialization of such types is equivalent to the zero
+     * initialization that construct() performs on the whole buffer in one pass, which keeps
+     * construction of heavily decorated types (such as OperationContext) from making one
+     * indirect call per decoration.
+     *
      * NOTE: T's destructor must not throw exceptions.
      */
     template <typename T>
@@ -70,7 +77,10 @@ public:
         return
             typename DecorationContainer<DecoratedType>::template DecorationDescriptorWithType<T>(
                 std::move(declareDecoration(
-                    sizeof(T), std::alignment_of<T>::value, &constructAt<T>, &destroyAt<T>)));
+                    sizeof(T),
+                    std::alignment_of<T>::value,
+                    std::is_trivially_default_constructible<T>::value ? nullptr : &constructAt<T>,
+                    std::is_trivially_destructible<T>::value ? nullptr : &destroyAt<T>)));
     }
 
     size_t getDecorationBufferSizeBytes() const {
@@ -84,6 +94,16 @@ public:
      * Called by the DecorationContainer constructor. Do not call directly.
      */
     void construct(DecorationContainer<DecoratedType>* const container) const {
+        // Zero the whole decoration area in a single pass. This value initializes every
+        // decoration with a trivial default constructor, which therefore registered no
+        // constructor function below. The first sizeof(void*) bytes of the buffer hold the
+        // container's back link and must be preserved.
+        std::memset(container->getDecoration(
+                        typename DecorationContainer<DecoratedType>::DecorationDescriptor(
+                            sizeof(void*))),
+                    0,
+                    _totalSizeBytes - sizeof(void*));
+
         using std::cbegin;
 
         auto iter = cbegin(_decorationInfo);
@@ -93,8 +113,9 @@ public:
             std::for_each(std::make_reverse_iterator(iter),
                           crend(this->_decorationInfo),
                           [&](auto&& decoration) {
-                              decoration.destructor(
-                                  container->getDecoration(decoration.descriptor));
+                              if (decoration.destructor)
+                                  decoration.destructor(
+                                      container->getDecoration(decoration.descriptor));
                           });
         };
 
@@ -103,7 +124,8 @@ public:
         using std::cend;
 
         for (; iter != cend(_decorationInfo); ++iter) {
-            iter->constructor(container->getDecoration(iter->descriptor));
+            if (iter->constructor)
+                iter->constructor(container->getDecoration(iter->descriptor));
         }
 
         cleanup.Dismiss();
@@ -116,7 +138,8 @@ public:
      */
     void destroy(DecorationContainer<DecoratedType>* const container) const noexcept try {
         for (auto& decoration : _decorationInfo) {
-            decoration.destructor(container->getDecoration(decoration.descriptor));
+            if (decoration.destructor)
+                decoration.destructor(container->getDecoration(decoration.descriptor));
         }
     } catch (...) {
         std::terminate();
@@ -162,7 +185,8 @@ private:
 
     /**
      * Declares a decoration with given "constructor" and "destructor" functions,
-     * of "sizeBytes" bytes.
+     * of "sizeBytes" bytes. Either function may be null, meaning the zero initialization
+     * performed by construct() suffices for the decoration, or that it needs no destruction.
      *
      * NOTE: "destructor" must not throw exceptions.
      */
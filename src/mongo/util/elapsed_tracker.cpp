@@ -32,10 +32,42 @@
 
 #include "mongo/util/elapsed_tracker.h"
 
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/clock_source.h"
+#include "mongo/util/concurrency/thread_name.h"
 
 namespace mongo {
 
+namespace {
+
+// How often the shared epoch advances. Between two ticks, intervalHasElapsed() can rule out the
+// time-based trigger with one relaxed load and an integer compare, instead of reading the
+// clock; the trade-off is that the time trigger may fire up to one tick late.
+const Milliseconds kEpochTickInterval{10};
+
+// Monotonically increasing epoch shared by all ElapsedTrackers, published by the ticker thread.
+AtomicInt64 globalEpoch{1};
+
+// Returns the current epoch, starting the ticker thread on first use. The thread is detached
+// and intentionally never stopped; it dies with the process.
+int64_t currentEpoch() {
+    static const auto started = [] {
+        stdx::thread([] {
+            setThreadName("ElapsedTrackerEpoch");
+            while (true) {
+                sleepFor(kEpochTickInterval);
+                globalEpoch.fetchAndAdd(1);
+            }
+        }).detach();
+        return true;
+    }();
+    (void)started;
+    return globalEpoch.load();
+}
+
+}  // namespace
+
 ElapsedTracker::ElapsedTracker(ClockSource* cs,
                                int32_t hitsBetweenMarks,
                                Milliseconds msBetweenMarks)
@@ -43,15 +75,25 @@ ElapsedTracker::ElapsedTracker(ClockSource* cs,
       _hitsBetweenMarks(hitsBetweenMarks),
       _msBetweenMarks(msBetweenMarks),
       _pings(0),
-      _last(cs->now()) {}
+      _last(cs->now()),
+      _lastEpoch(currentEpoch()) {}
 
 bool ElapsedTracker::intervalHasElapsed() {
     if (++_pings >= _hitsBetweenMarks) {
         _pings = 0;
         _last = _clock->now();
+        _lastEpoch = currentEpoch();
         return true;
     }
 
+    // Fast path: while the shared epoch has not advanced since we last consulted the clock,
+    // less than one tick has passed and the time-based trigger cannot have fired yet.
+    const int64_t epoch = currentEpoch();
+    if (epoch == _lastEpoch) {
+        return false;
+    }
+    _lastEpoch = epoch;
+
     const auto now = _clock->now();
     if (now - _last > _msBetweenMarks) {
         _pings = 0;
@@ -65,6 +107,7 @@ bool ElapsedTracker::intervalHasElapsed() {
 void ElapsedTracker::resetLastTime() {
     _pings = 0;
     _last = _clock->now();
+    _lastEpoch = currentEpoch();
 }
 
 }  // namespace mongo
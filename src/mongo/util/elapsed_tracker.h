@@ -59,6 +59,10 @@ private:
     int32_t _pings;
 
     Date_t _last;
+
+    // The shared epoch value observed the last time the clock was consulted. While the epoch is
+    // unchanged, intervalHasElapsed() skips the clock read entirely.
+    int64_t _lastEpoch;
 };
 
 }  // namespace mongo
@@ -0,0 +1,226 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/tsc_clock_source.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MONGO_HAVE_RDTSC 1
+
+/**
+ * Returns true if the processor advertises an invariant time stamp counter (CPUID leaf
+ * 0x80000007, EDX bit 8): one that ticks at a constant rate independent of frequency scaling
+ * and power states, which is what makes the counter usable as a time base.
+ */
+bool hasInvariantTsc() {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+        return false;
+    }
+    __cpuid(regs, 0x80000007);
+    return regs[3] & (1 << 8);
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return edx & (1u << 8);
+#endif
+}
+
+uint64_t readTsc() {
+    return __rdtsc();
+}
+
+#endif  // x86
+
+// Length of the interval the constructor measures the counter frequency over. Long enough that
+// scheduling jitter around the system clock reads stays well under a part per thousand.
+const Milliseconds kInitialCalibrationPeriod{10};
+
+}  // namespace
+
+std::unique_ptr<ClockSource> TSCClockSource::makeIfSupported() {
+#ifdef MONGO_HAVE_RDTSC
+    if (!hasInvariantTsc()) {
+        return nullptr;
+    }
+    std::unique_ptr<TSCClockSource> source(new TSCClockSource());
+    if (source->_ticksPerSecond.load() == 0) {
+        return nullptr;  // The counter did not advance; it cannot serve as a time base.
+    }
+    return std::move(source);
+#else
+    return nullptr;
+#endif
+}
+
+#ifdef MONGO_HAVE_RDTSC
+
+TSCClockSource::TSCClockSource() {
+    const long long microsBefore = curTimeMicros64();
+    const uint64_t ticksBefore = readTsc();
+    sleepmillis(durationCount<Milliseconds>(kInitialCalibrationPeriod));
+    const long long microsAfter = curTimeMicros64();
+    const uint64_t ticksAfter = readTsc();
+
+    _initialMicros = microsAfter;
+    _initialTicks = ticksAfter;
+    _anchorMicros.store(microsAfter);
+    _anchorTicks.store(ticksAfter);
+    _ticksPerSecond.store((ticksAfter - ticksBefore) * 1000 * 1000 /
+                          (microsAfter - microsBefore));
+}
+
+Milliseconds TSCClockSource::getPrecision() {
+    return Milliseconds(1);
+}
+
+Date_t TSCClockSource::now() {
+    const uint64_t ticks = readTsc();
+
+    long long anchorMicros;
+    uint64_t anchorTicks;
+    uint64_t ticksPerSecond;
+    bool recalibrated = false;
+    for (;;) {
+        uint32_t generation;
+        do {
+            generation = _generation.load();
+            anchorMicros = _anchorMicros.loadRelaxed();
+            anchorTicks = _anchorTicks.loadRelaxed();
+            ticksPerSecond = _ticksPerSecond.loadRelaxed();
+        } while (generation % 2 != 0 || _generation.load() != generation);
+
+        // Refresh the anchor about once a second so conversion error cannot accumulate and
+        // system clock adjustments are picked up. The signed comparison tolerates a reading
+        // slightly older than an anchor just taken on another core.
+        if (!recalibrated &&
+            static_cast<int64_t>(ticks - anchorTicks) >
+                static_cast<int64_t>(ticksPerSecond)) {
+            _recalibrate(ticks);
+            recalibrated = true;
+            continue;
+        }
+        break;
+    }
+
+    long long micros =
+        anchorMicros + static_cast<int64_t>(ticks - anchorTicks) * 1000 * 1000 /
+            static_cast<int64_t>(ticksPerSecond);
+
+    // Recalibration may pull the anchor slightly backwards relative to what this clock has
+    // already handed out; never let time run backwards.
+    long long prev = _lastNowMicros.loadRelaxed();
+    while (micros > prev) {
+        const long long seen = _lastNowMicros.compareAndSwap(prev, micros);
+        if (seen == prev) {
+            break;
+        }
+        prev = seen;
+    }
+    if (micros < prev) {
+        micros = prev;
+    }
+    return Date_t::fromMillisSinceEpoch(micros / 1000);
+}
+
+void TSCClockSource::_recalibrate(uint64_t nowTicks) {
+    stdx::unique_lock<stdx::mutex> lk(_calibrationMutex, stdx::try_to_lock);
+    if (!lk.owns_lock()) {
+        return;  // Another thread is recalibrating; keep converting with the stale snapshot.
+    }
+    if (static_cast<int64_t>(nowTicks - _anchorTicks.loadRelaxed()) <=
+        static_cast<int64_t>(_ticksPerSecond.loadRelaxed())) {
+        return;  // Lost the race to a recalibration that already refreshed the anchor.
+    }
+
+    const long long nowMicros = curTimeMicros64();
+    const uint64_t ticks = readTsc();
+
+    // Refine the frequency estimate over the whole baseline since construction; the longer the
+    // baseline, the smaller the relative error of the endpoints. If the estimate moves by more
+    // than 1% the system clock must have stepped (NTP, manual change), so restart the baseline
+    // at the new anchor instead of folding the step into the frequency.
+    uint64_t ticksPerSecond = _ticksPerSecond.loadRelaxed();
+    const long long baselineMicros = nowMicros - _initialMicros;
+    if (baselineMicros > 0) {
+        const uint64_t refined = static_cast<uint64_t>(
+            static_cast<double>(ticks - _initialTicks) * (1000 * 1000) / baselineMicros);
+        if (refined > ticksPerSecond + ticksPerSecond / 100 ||
+            refined + ticksPerSecond / 100 < ticksPerSecond) {
+            _initialMicros = nowMicros;
+            _initialTicks = ticks;
+        } else {
+            ticksPerSecond = refined;
+        }
+    }
+
+    _generation.fetchAndAdd(1);  // Odd: snapshot unstable.
+    _anchorMicros.store(nowMicros);
+    _anchorTicks.store(ticks);
+    _ticksPerSecond.store(ticksPerSecond);
+    _generation.fetchAndAdd(1);  // Even again: snapshot stable.
+}
+
+#else  // !MONGO_HAVE_RDTSC
+
+TSCClockSource::TSCClockSource() {}
+
+Milliseconds TSCClockSource::getPrecision() {
+    return Milliseconds(1);
+}
+
+Date_t TSCClockSource::now() {
+    MONGO_UNREACHABLE;  // makeIfSupported() never constructs this off x86.
+}
+
+void TSCClockSource::_recalibrate(uint64_t nowTicks) {
+    MONGO_UNREACHABLE;
+}
+
+#endif  // MONGO_HAVE_RDTSC
+
+}  // namespace mongo
@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/clock_source.h"
+
+namespace mongo {
+
+/**
+ * Clock source that derives wall clock time from the CPU time stamp counter.
+ *
+ * Reading the counter is roughly an order of magnitude cheaper than a system clock call, so
+ * this suits the precise clock reads that pepper the operation path (CurOp timing, logging).
+ * Counter readings are converted to wall time with a calibration against the system clock
+ * that is refreshed about once a second, which bounds drift and absorbs NTP adjustments.
+ *
+ * Only usable where the CPU advertises an invariant time stamp counter, one that ticks at a
+ * constant rate regardless of power state; construct through makeIfSupported().
+ */
+class TSCClockSource final : public ClockSource {
+public:
+    /**
+     * Returns a counter-backed clock source, or nullptr if the processor does not provide an
+     * invariant time stamp counter (including all non-x86 platforms).
+     */
+    static std::unique_ptr<ClockSource> makeIfSupported();
+
+    Milliseconds getPrecision() override;
+    Date_t now() override;
+
+private:
+    TSCClockSource();
+
+    void _recalibrate(uint64_t nowTicks);
+
+    // Calibration snapshot: wall time at the anchor point, the counter reading taken with it,
+    // and the measured counter frequency. Readers validate _generation (even and unchanged =
+    // stable snapshot) around relaxed loads of the other three; _calibrationMutex serializes
+    // writers.
+    AtomicUInt32 _generation{0};
+    AtomicInt64 _anchorMicros{0};
+    AtomicUInt64 _anchorTicks{0};
+    AtomicUInt64 _ticksPerSecond{0};
+
+    stdx::mutex _calibrationMutex;
+
+    // The first calibration point, kept so recalibration can refine the frequency estimate
+    // over an ever-longer baseline. Only accessed under _calibrationMutex.
+    long long _initialMicros = 0;
+    uint64_t _initialTicks = 0;
+
+    // Most recently returned time, used to keep now() monotonic across recalibrations.
+    AtomicInt64 _lastNowMicros{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,67 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/system_clock_source.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/tsc_clock_source.h"
+
+namespace mongo {
+namespace {
+
+// These tests pass vacuously on hosts without an invariant time stamp counter, where
+// makeIfSupported() returns nullptr and the server falls back to the system clock.
+
+TEST(TSCClockSourceTest, TracksSystemClock) {
+    auto clock = TSCClockSource::makeIfSupported();
+    if (!clock) {
+        return;
+    }
+    auto systemNow = SystemClockSource::get()->now();
+    auto tscNow = clock->now();
+    auto skew = (tscNow > systemNow) ? (tscNow - systemNow) : (systemNow - tscNow);
+    ASSERT_LESS_THAN(skew, Seconds(1));
+}
+
+TEST(TSCClockSourceTest, NeverRunsBackwards) {
+    auto clock = TSCClockSource::makeIfSupported();
+    if (!clock) {
+        return;
+    }
+    auto last = clock->now();
+    for (int i = 0; i < 100000; i++) {
+        auto next = clock->now();
+        ASSERT_GREATER_THAN_OR_EQUALS(next, last);
+        last = next;
+    }
+}
+
+}  // namespace
+}  // namespace mongo